@@ -42,1501 +42,8881 @@
 #endif
 
 
+/* Source: SimpleTypes/simple_types.h */
+#ifndef SIMPLE_TYPES_H
+
+#include <stdint.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(SIMPLE_TYPES_NO_SIMD)
+    #define _TYPES_X86_SIMD 1
+    #include <immintrin.h>
+#endif
+
+#ifdef SBIG_THREADS
+    #ifdef _WIN32
+        #include <windows.h>
+    #else
+        #include <pthread.h>
+    #endif
+#endif
+
+// --- Allocation Hooks ---
+// Every allocation the library makes goes through these. Define QOL_MALLOC,
+// QOL_REALLOC and QOL_FREE (QOL_CALLOC is optional) before including to use
+// another heap, or define QOL_USE_ALLOC to route them through qol_malloc below,
+// which serves them from the calling thread's qol_alloc. The other modules only
+// fall back to libc, so with QOL_USE_ALLOC include this header first (and list
+// SimpleTypes first when amalgamating with build.sh).
+#if defined(QOL_USE_ALLOC) && !defined(QOL_MALLOC)
+    static inline void* qol_malloc(size_t size);
+    static inline void* qol_realloc(void* ptr, size_t size);
+    static inline void qol_free(void* ptr);
+    #define QOL_ALLOC_ROUTED 1
+    #define QOL_MALLOC(n) qol_malloc(n)
+    #define QOL_REALLOC(p, n) qol_realloc(p, n)
+    #define QOL_FREE(p) qol_free(p)
+#endif
+#ifndef QOL_MALLOC
+    #define QOL_MALLOC(n) malloc(n)
+    #define QOL_REALLOC(p, n) realloc(p, n)
+    #define QOL_FREE(p) free(p)
+    #ifndef QOL_CALLOC
+        #define QOL_CALLOC(count, n) calloc(count, n)
+    #endif
+#endif
+#ifndef QOL_CALLOC
+    #define QOL_CALLOC(count, n) _qol_calloc(count, n)
+#endif
+static inline void* _qol_calloc(size_t count, size_t size) {
+    if (size && count > (size_t)-1 / size) return NULL;
+    void* p = QOL_MALLOC(count * size);
+    if (p) memset(p, 0, count * size);
+    return p;
+}
+
+// --- Base Types ---
+typedef uint8_t u8;   typedef uint16_t u16; typedef uint32_t u32; typedef uint64_t u64;
+typedef int8_t s8;    typedef int16_t s16;  typedef int32_t s32;  typedef int64_t s64;
+
+// --- Structural Definitions ---
+#define DEF_STRUCTS(BITS, LIMBS) \
+    typedef struct { u32 limbs[LIMBS]; } suint##BITS; \
+    typedef struct { s32 limbs[LIMBS]; } sint##BITS; \
+    typedef struct { suint##BITS mantissa; s32 exponent; s32 sign; } sfloat##BITS;
+
+DEF_STRUCTS(32, 1)    DEF_STRUCTS(64, 2)    DEF_STRUCTS(128, 4)
+DEF_STRUCTS(256, 8)   DEF_STRUCTS(512, 16)  DEF_STRUCTS(1024, 32)
+DEF_STRUCTS(2048, 64) DEF_STRUCTS(4096, 128) DEF_STRUCTS(8192, 256)
+DEF_STRUCTS(12288, 384)
+
+// --- Internal Helpers ---
+static inline void _internal_raw_hex(u32* limbs, int count) {
+    printf("0x");
+    int started = 0;
+    for (int i = count - 1; i >= 0; i--) {
+        if (limbs[i] != 0 || started || i == 0) {
+            if (started) printf("%08X", limbs[i]);
+            else printf("%X", limbs[i]);
+            started = 1;
+        }
+    }
+}
+
+// Writes the decimal form of limbs into out (NUL-terminated), optionally with
+// thousands separators. Peels nine digits per pass over the limbs.
+// Returns the length, or 0 if cap is too small.
+static inline size_t _internal_dec_str(const u32* limbs, int count, char* out, size_t cap, int commas) {
+    u32 temp[count];
+    memcpy(temp, limbs, count * sizeof(u32));
+    int len = count;
+    while (len > 0 && temp[len - 1] == 0) len--;
+    char digits[count * 14 + 2];
+    size_t pos = 0;
+    int digit_count = 0;
+    do {
+        u64 remainder = 0;
+        for (int i = len - 1; i >= 0; i--) {
+            u64 val = (remainder << 32) | temp[i];
+            temp[i] = (u32)(val / 1000000000u);
+            remainder = val % 1000000000u;
+        }
+        while (len > 0 && temp[len - 1] == 0) len--;
+        // Inner chunks keep their leading zeros; the last one stops at its top digit.
+        for (int d = 0; d < 9; d++) {
+            if (len == 0 && remainder == 0 && d > 0) break;
+            if (commas && digit_count > 0 && digit_count % 3 == 0) digits[pos++] = ',';
+            digits[pos++] = (char)('0' + remainder % 10);
+            remainder /= 10;
+            digit_count++;
+        }
+    } while (len > 0);
+    if (pos + 1 > cap) { if (cap) out[0] = '\0'; return 0; }
+    for (size_t i = 0; i < pos; i++) out[i] = digits[pos - 1 - i];
+    out[pos] = '\0';
+    return pos;
+}
+
+static inline void _internal_dec_ascii(u32* limbs, int count) {
+    char digits[count * 14 + 2];
+    _internal_dec_str(limbs, count, digits, sizeof(digits), 1);
+    fputs(digits, stdout);
+}
+
+// limbs = limbs * scale + add. Returns 0 on overflow.
+static inline int _internal_muladd(u32* limbs, int count, u32 scale, u32 add) {
+    u64 carry = add;
+    for (int i = 0; i < count; i++) {
+        u64 cur = (u64)limbs[i] * scale + carry;
+        limbs[i] = (u32)cur;
+        carry = cur >> 32;
+    }
+    return carry == 0;
+}
+
+// Parses decimal digits into limbs, nine at a time; ',' and '_' separators
+// are skipped. Returns 0 on an empty or invalid string or when the value overflows.
+static inline int _internal_dec_parse(u32* limbs, int count, const char* s) {
+    memset(limbs, 0, count * sizeof(u32));
+    u32 chunk = 0, scale = 1;
+    int any = 0;
+    for (;; s++) {
+        char c = *s;
+        if (c == ',' || c == '_') continue;
+        if (c < '0' || c > '9') { if (c) return 0; break; }
+        chunk = chunk * 10 + (u32)(c - '0');
+        scale *= 10;
+        any = 1;
+        if (scale == 1000000000u) {
+            if (!_internal_muladd(limbs, count, scale, chunk)) return 0;
+            chunk = 0; scale = 1;
+        }
+    }
+    if (scale > 1 && !_internal_muladd(limbs, count, scale, chunk)) return 0;
+    return any;
+}
+
+// --- Shift Operations ---
+#define DEF_SHIFT(BITS, COUNT) \
+    static inline void suint##BITS##_shl(suint##BITS *v, int shift) { \
+        if (shift <= 0) return; \
+        int limb_shift = shift / 32; \
+        int bit_shift = shift % 32; \
+        if (limb_shift >= COUNT) { memset(v->limbs, 0, sizeof(v->limbs)); return; } \
+        for (int i = COUNT - 1; i >= 0; i--) { \
+            if (i >= limb_shift) { \
+                v->limbs[i] = v->limbs[i - limb_shift] << bit_shift; \
+                if (bit_shift > 0 && i - limb_shift - 1 >= 0) \
+                    v->limbs[i] |= v->limbs[i - limb_shift - 1] >> (32 - bit_shift); \
+            } else v->limbs[i] = 0; \
+        } \
+    }
+
+DEF_SHIFT(32, 1)    DEF_SHIFT(64, 2)    DEF_SHIFT(128, 4)
+DEF_SHIFT(256, 8)   DEF_SHIFT(512, 16)  DEF_SHIFT(1024, 32)
+DEF_SHIFT(2048, 64) DEF_SHIFT(4096, 128) DEF_SHIFT(8192, 256)
+DEF_SHIFT(12288, 384)
+
+// --- Modulo (Remainder) ---
+// This implements res = a % b using a limb-by-limb approach.
+// Note: This is a basic implementation. For high-performance 12288-bit 
+// division, one would typically use Knuth's Algorithm D.
+#define DEF_MOD(BITS, COUNT) \
+    static inline void suint##BITS##_mod(suint##BITS *res, suint##BITS a, suint##BITS b) { \
+        suint##BITS rem = {0}; \
+        /* Check for division by zero */ \
+        int is_zero = 1; \
+        for(int i = 0; i < COUNT; i++) if(b.limbs[i] != 0) is_zero = 0; \
+        if (is_zero) { *res = rem; return; } \
+        \
+        for (int i = BITS - 1; i >= 0; i--) { \
+            /* Shift remainder left by 1 */ \
+            u32 carry = 0; \
+            for (int j = 0; j < COUNT; j++) { \
+                u32 next_carry = rem.limbs[j] >> 31; \
+                rem.limbs[j] = (rem.limbs[j] << 1) | carry; \
+                carry = next_carry; \
+            } \
+            /* Bring down the next bit from 'a' */ \
+            int limb_idx = i / 32; \
+            int bit_idx = i % 32; \
+            if ((a.limbs[limb_idx] >> bit_idx) & 1) { \
+                rem.limbs[0] |= 1; \
+            } \
+            /* If rem >= b, then rem = rem - b */ \
+            int greater_equal = 1; \
+            for (int j = COUNT - 1; j >= 0; j--) { \
+                if (rem.limbs[j] < b.limbs[j]) { greater_equal = 0; break; } \
+                if (rem.limbs[j] > b.limbs[j]) { greater_equal = 1; break; } \
+            } \
+            if (greater_equal) { \
+                u64 borrow = 0; \
+                for (int j = 0; j < COUNT; j++) { \
+                    u64 sub = (u64)rem.limbs[j] - b.limbs[j] - borrow; \
+                    rem.limbs[j] = (u32)sub; \
+                    borrow = (sub >> 63) & 1; \
+                } \
+            } \
+        } \
+        *res = rem; \
+    }
+
+// Generate Modulo functions for all bit sizes
+DEF_MOD(32, 1)      DEF_MOD(64, 2)      DEF_MOD(128, 4)
+DEF_MOD(256, 8)     DEF_MOD(512, 16)    DEF_MOD(1024, 32)
+DEF_MOD(2048, 64)   DEF_MOD(4096, 128)  DEF_MOD(8192, 256)
+DEF_MOD(12288, 384)
+
+// --- Printers ---
+#define DEF_PRINTERS(BITS, COUNT) \
+    static inline void _nf_u##BITS(suint##BITS v) { _internal_raw_hex(v.limbs, COUNT); } \
+    static inline void _f_u##BITS(suint##BITS v)  { _internal_dec_ascii(v.limbs, COUNT); } \
+    static inline void _nf_s##BITS(sint##BITS v)  { printf("(S)"); _internal_raw_hex((u32*)v.limbs, COUNT); } \
+    static inline void _f_s##BITS(sint##BITS v)   { if(v.limbs[COUNT-1] < 0) printf("-"); _internal_dec_ascii((u32*)v.limbs, COUNT); } \
+    static inline void _nf_flt##BITS(sfloat##BITS v) { if (v.sign) printf("-"); _internal_raw_hex(v.mantissa.limbs, COUNT); printf(" E%d", v.exponent); } \
+    static inline void _f_flt##BITS(sfloat##BITS v)  { if (v.sign) printf("-"); _internal_dec_ascii(v.mantissa.limbs, COUNT); printf(" * 2^%d", v.exponent); }
+
+DEF_PRINTERS(32, 1)    DEF_PRINTERS(64, 2)    DEF_PRINTERS(128, 4)
+DEF_PRINTERS(256, 8)   DEF_PRINTERS(512, 16)  DEF_PRINTERS(1024, 32)
+DEF_PRINTERS(2048, 64) DEF_PRINTERS(4096, 128) DEF_PRINTERS(8192, 256)
+DEF_PRINTERS(12288, 384)
+
+#define slibnfprint(val) _Generic((val), \
+    suint32: _nf_u32, suint64: _nf_u64, suint128: _nf_u128, suint256: _nf_u256, suint512: _nf_u512, \
+    suint1024: _nf_u1024, suint2048: _nf_u2048, suint4096: _nf_u4096, suint8192: _nf_u8192, suint12288: _nf_u12288, \
+    sint32: _nf_s32, sint64: _nf_s64, sint128: _nf_s128, sint256: _nf_s256, sint512: _nf_s512, \
+    sint1024: _nf_s1024, sint2048: _nf_s2048, sint4096: _nf_s4096, sint8192: _nf_s8192, sint12288: _nf_s12288, \
+    sfloat32: _nf_flt32, sfloat64: _nf_flt64, sfloat128: _nf_flt128, sfloat256: _nf_flt256, sfloat512: _nf_flt512, \
+    sfloat1024: _nf_flt1024, sfloat2048: _nf_flt2048, sfloat4096: _nf_flt4096, sfloat8192: _nf_flt8192, sfloat12288: _nf_flt12288, \
+    sbig: _nf_big \
+)(val)
+
+#define slibprint(val) _Generic((val), \
+    suint32: _f_u32, suint64: _f_u64, suint128: _f_u128, suint256: _f_u256, suint512: _f_u512, \
+    suint1024: _f_u1024, suint2048: _f_u2048, suint4096: _f_u4096, suint8192: _f_u8192, suint12288: _f_u12288, \
+    sint32: _f_s32, sint64: _f_s64, sint128: _f_s128, sint256: _f_s256, sint512: _f_s512, \
+    sint1024: _f_s1024, sint2048: _f_s2048, sint4096: _f_s4096, sint8192: _f_s8192, sint12288: _f_s12288, \
+    sfloat32: _f_flt32, sfloat64: _f_flt64, sfloat128: _f_flt128, sfloat256: _f_flt256, sfloat512: _f_flt512, \
+    sfloat1024: _f_flt1024, sfloat2048: _f_flt2048, sfloat4096: _f_flt4096, sfloat8192: _f_flt8192, sfloat12288: _f_flt12288, \
+    sbig: _f_big \
+)(val)
+
+// --- Decimal Conversion ---
+#define DEF_DEC(BITS, COUNT) \
+    /* Plain digits, no separators. Returns the length, or 0 if cap is too small. */ \
+    static inline size_t suint##BITS##_to_dec(suint##BITS v, char* out, size_t cap) { return _internal_dec_str(v.limbs, COUNT, out, cap, 0); } \
+    /* Returns 0 (res untouched) on invalid input or overflow. */ \
+    static inline int suint##BITS##_from_dec(suint##BITS *res, const char* s) { \
+        suint##BITS tmp; \
+        if (!_internal_dec_parse(tmp.limbs, COUNT, s)) return 0; \
+        *res = tmp; return 1; \
+    }
+
+DEF_DEC(32, 1)    DEF_DEC(64, 2)    DEF_DEC(128, 4)
+DEF_DEC(256, 8)   DEF_DEC(512, 16)  DEF_DEC(1024, 32)
+DEF_DEC(2048, 64) DEF_DEC(4096, 128) DEF_DEC(8192, 256)
+DEF_DEC(12288, 384)
+
+// --- Addition ---
+#define DEF_ADD(BITS, COUNT) \
+    static inline u32 suint##BITS##_add(suint##BITS *res, suint##BITS a, suint##BITS b) { \
+        u64 carry = 0; \
+        for (int i = 0; i < COUNT; i++) { \
+            u64 sum = (u64)a.limbs[i] + b.limbs[i] + carry; \
+            res->limbs[i] = (u32)sum; \
+            carry = sum >> 32; \
+        } \
+        return (u32)carry; \
+    }
+
+// --- Multiplication ---
+#define DEF_MUL(BITS, COUNT) \
+    static inline void suint##BITS##_mul(suint##BITS *res, suint##BITS a, suint##BITS b) { \
+        suint##BITS out = {0}; \
+        for (int i = 0; i < COUNT; i++) { \
+            if (a.limbs[i] == 0) continue; \
+            u64 carry = 0; \
+            for (int j = 0; i + j < COUNT; j++) { \
+                u64 cur = out.limbs[i + j] + (u64)a.limbs[i] * b.limbs[j] + carry; \
+                out.limbs[i + j] = (u32)cur; \
+                carry = cur >> 32; \
+            } \
+        } \
+        *res = out; \
+    }
+
+// --- Comparison ---
+// Returns -1, 0 or 1.
+#define DEF_CMP(BITS, COUNT) \
+    static inline int suint##BITS##_cmp(suint##BITS a, suint##BITS b) { \
+        for (int i = COUNT - 1; i >= 0; i--) \
+            if (a.limbs[i] != b.limbs[i]) return a.limbs[i] < b.limbs[i] ? -1 : 1; \
+        return 0; \
+    }
+
+DEF_ADD(32, 1)    DEF_ADD(64, 2)    DEF_ADD(128, 4)
+DEF_ADD(256, 8)   DEF_ADD(512, 16)  DEF_ADD(1024, 32)
+DEF_ADD(2048, 64) DEF_ADD(4096, 128) DEF_ADD(8192, 256)
+DEF_ADD(12288, 384)
+
+DEF_MUL(32, 1)    DEF_MUL(64, 2)    DEF_MUL(128, 4)
+DEF_MUL(256, 8)   DEF_MUL(512, 16)  DEF_MUL(1024, 32)
+DEF_MUL(2048, 64) DEF_MUL(4096, 128) DEF_MUL(8192, 256)
+DEF_MUL(12288, 384)
+
+DEF_CMP(32, 1)    DEF_CMP(64, 2)    DEF_CMP(128, 4)
+DEF_CMP(256, 8)   DEF_CMP(512, 16)  DEF_CMP(1024, 32)
+DEF_CMP(2048, 64) DEF_CMP(4096, 128) DEF_CMP(8192, 256)
+DEF_CMP(12288, 384)
+// Power function: res = base ^ exp
+static inline void suint12288_pow(suint12288 *res, u32 base_val, u32 exp) {
+    suint12288 b = {0}; b.limbs[0] = base_val;
+    suint12288 result = {0}; result.limbs[0] = 1;
+    
+    for (u32 i = 0; i < exp; i++) {
+        suint12288_mul(&result, result, b);
+    }
+    *res = result;
+}
+
+// Tetration: base ^^ height
+static inline void suint12288_tetrate(suint12288 *res, u32 base, u32 height) {
+    if (height == 0) { res->limbs[0] = 1; return; }
+    if (height == 1) { res->limbs[0] = base; return; }
+    
+    // Starting with base^^2
+    suint12288 current_val;
+    suint12288_pow(&current_val, base, base);
+    
+    for (u32 i = 2; i < height; i++) {
+        // This is the "Horrid" part. We use the previous result 
+        // as the exponent for the next layer.
+        // NOTE: We only take the first limb as the exponent here 
+        // because suint12288_pow expects a u32 exponent.
+        suint12288_pow(&current_val, base, current_val.limbs[0]);
+    }
+    *res = current_val;
+}
+
+// --- Allocators ---
+// qol_alloc is the allocator interface shared by the library: sbig takes one for
+// its limbs, and qol_alloc_use makes one the target of QOL_MALLOC when built
+// with QOL_USE_ALLOC. qol_arena bump-allocates and frees everything at once;
+// qol_pool recycles fixed-size objects. Neither locks: keep one per thread.
+typedef struct {
+    void* (*alloc)(void* ctx, size_t size);
+    void* (*resize)(void* ctx, void* ptr, size_t old_size, size_t new_size);
+    void  (*release)(void* ctx, void* ptr, size_t size);
+    void* ctx;
+} qol_alloc;
+
+#if defined(_MSC_VER)
+    #define _TYPES_TLS __declspec(thread)
+#else
+    #define _TYPES_TLS __thread
+#endif
+
+// Backing memory for arenas and pools. Calls the hooks unless they lead back to
+// qol_malloc, which could land in the very arena asking for a block.
+#ifdef QOL_ALLOC_ROUTED
+    #define _QOL_SYS_MALLOC(n) malloc(n)
+    #define _QOL_SYS_REALLOC(p, n) realloc(p, n)
+    #define _QOL_SYS_FREE(p) free(p)
+#else
+    #define _QOL_SYS_MALLOC(n) QOL_MALLOC(n)
+    #define _QOL_SYS_REALLOC(p, n) QOL_REALLOC(p, n)
+    #define _QOL_SYS_FREE(p) QOL_FREE(p)
+#endif
+
+#define _QOL_ALIGN(n) (((n) + 15) & ~(size_t)15)
+
+static inline void* _qol_heap_alloc(void* ctx, size_t size) { (void)ctx; return _QOL_SYS_MALLOC(size); }
+static inline void* _qol_heap_resize(void* ctx, void* ptr, size_t old_size, size_t new_size) { (void)ctx; (void)old_size; return _QOL_SYS_REALLOC(ptr, new_size); }
+static inline void _qol_heap_release(void* ctx, void* ptr, size_t size) { (void)ctx; (void)size; _QOL_SYS_FREE(ptr); }
+static const qol_alloc qol_heap = { _qol_heap_alloc, _qol_heap_resize, _qol_heap_release, NULL };
+
+// --- Bump Arena ---
+typedef struct _qol_arena_block {
+    struct _qol_arena_block* next;
+    size_t size, used;
+    size_t pad;   // Keeps data 16-byte aligned.
+    unsigned char data[];
+} _qol_arena_block;
+
+typedef struct {
+    _qol_arena_block* head;
+    _qol_arena_block* cur;
+    size_t block_size;
+    qol_alloc al;   // Pass &arena.al to qol_alloc_use or sbig_init; the arena must not move.
+} qol_arena;
+
+static inline void* arena_alloc(qol_arena* a, size_t size) {
+    _qol_arena_block* c = a->cur;
+    size = _QOL_ALIGN(size);
+    if (c && c->size - c->used >= size) {
+        void* p = c->data + c->used;
+        c->used += size;
+        return p;
+    }
+    while (c && c->next) {
+        c = a->cur = c->next;
+        c->used = 0;
+        if (c->size >= size) { c->used = size; return c->data; }
+    }
+    size_t bsize = size > a->block_size ? size : a->block_size;
+    _qol_arena_block* blk = (_qol_arena_block*)_QOL_SYS_MALLOC(sizeof(_qol_arena_block) + bsize);
+    if (!blk) return NULL;
+    blk->size = bsize; blk->used = size; blk->next = NULL;
+    if (c) { blk->next = c->next; c->next = blk; }
+    else a->head = blk;
+    a->cur = blk;
+    return blk->data;
+}
+
+static inline void* _qol_arena_alloc(void* ctx, size_t size) { return arena_alloc((qol_arena*)ctx, size); }
+
+static inline void* _qol_arena_resize(void* ctx, void* ptr, size_t old_size, size_t new_size) {
+    qol_arena* a = (qol_arena*)ctx;
+    if (!ptr) return arena_alloc(a, new_size);
+    old_size = _QOL_ALIGN(old_size);
+    _qol_arena_block* c = a->cur;
+    // Grow in place when ptr is the most recent allocation of the current block.
+    if (c && (unsigned char*)ptr + old_size == c->data + c->used &&
+        c->used - old_size + _QOL_ALIGN(new_size) <= c->size) {
+        c->used = c->used - old_size + _QOL_ALIGN(new_size);
+        return ptr;
+    }
+    void* p = arena_alloc(a, new_size);
+    if (p) memcpy(p, ptr, old_size < new_size ? old_size : new_size);
+    return p;
+}
+
+// Only the most recent allocation is given back (stack-like temporaries);
+// everything else comes back on arena_reset.
+static inline void _qol_arena_release(void* ctx, void* ptr, size_t size) {
+    qol_arena* a = (qol_arena*)ctx;
+    _qol_arena_block* c = a->cur;
+    size = _QOL_ALIGN(size);
+    if (c && (unsigned char*)ptr + size == c->data + c->used) c->used -= size;
+}
+
+static inline void arena_init(qol_arena* a, size_t block_size) {
+    a->head = a->cur = NULL;
+    a->block_size = block_size ? block_size : 65536;
+    a->al.alloc = _qol_arena_alloc;
+    a->al.resize = _qol_arena_resize;
+    a->al.release = _qol_arena_release;
+    a->al.ctx = a;
+}
+
+// Drops every allocation at once, e.g. at the end of a request. Blocks are kept.
+static inline void arena_reset(qol_arena* a) {
+    if (a->head) a->head->used = 0;
+    a->cur = a->head;
+}
+
+// Bytes handed out since the last reset, including alignment padding.
+static inline size_t arena_used(const qol_arena* a) {
+    size_t n = 0;
+    for (_qol_arena_block* b = a->head; b; b = b->next) {
+        n += b->used;
+        if (b == a->cur) break;
+    }
+    return n;
+}
+
+static inline void arena_free(qol_arena* a) {
+    _qol_arena_block* b = a->head;
+    while (b) { _qol_arena_block* n = b->next; _QOL_SYS_FREE(b); b = n; }
+    a->head = a->cur = NULL;
+}
+
+// --- Object Pool ---
+// Fixed-size objects carved from chunks and recycled through a free list.
+// As a qol_alloc, larger requests fall through to the heap.
+typedef struct _qol_pool_chunk {
+    struct _qol_pool_chunk* next;
+    size_t pad;   // Keeps objects 16-byte aligned.
+} _qol_pool_chunk;
+
+typedef struct {
+    size_t size;        // Object size, rounded up to 16.
+    size_t per_chunk;
+    void* free_list;
+    unsigned char *fresh, *fresh_end;   // Untouched tail of the newest chunk.
+    _qol_pool_chunk* chunks;
+    qol_alloc al;       // Pass &pool.al to qol_alloc_use; the pool must not move.
+} qol_pool;
+
+static inline void* pool_get(qol_pool* p) {
+    void* obj = p->free_list;
+    if (obj) { p->free_list = *(void**)obj; return obj; }
+    if (p->fresh == p->fresh_end) {
+        _qol_pool_chunk* c = (_qol_pool_chunk*)_QOL_SYS_MALLOC(sizeof(_qol_pool_chunk) + p->per_chunk * p->size);
+        if (!c) return NULL;
+        c->next = p->chunks; p->chunks = c;
+        p->fresh = (unsigned char*)(c + 1);
+        p->fresh_end = p->fresh + p->per_chunk * p->size;
+    }
+    obj = p->fresh;
+    p->fresh += p->size;
+    return obj;
+}
+
+static inline void pool_put(qol_pool* p, void* obj) {
+    if (!obj) return;
+    *(void**)obj = p->free_list;
+    p->free_list = obj;
+}
+
+static inline void* _qol_pool_alloc(void* ctx, size_t size) {
+    qol_pool* p = (qol_pool*)ctx;
+    return size <= p->size ? pool_get(p) : _QOL_SYS_MALLOC(size);
+}
+
+static inline void _qol_pool_release(void* ctx, void* ptr, size_t size) {
+    qol_pool* p = (qol_pool*)ctx;
+    if (size <= p->size) pool_put(p, ptr); else _QOL_SYS_FREE(ptr);
+}
+
+static inline void* _qol_pool_resize(void* ctx, void* ptr, size_t old_size, size_t new_size) {
+    qol_pool* p = (qol_pool*)ctx;
+    if (!ptr) return _qol_pool_alloc(ctx, new_size);
+    if (old_size > p->size && new_size > p->size) return _QOL_SYS_REALLOC(ptr, new_size);
+    if (old_size <= p->size && new_size <= p->size) return ptr;
+    void* n = _qol_pool_alloc(ctx, new_size);
+    if (!n) return NULL;
+    memcpy(n, ptr, old_size < new_size ? old_size : new_size);
+    _qol_pool_release(ctx, ptr, old_size);
+    return n;
+}
+
+// per_chunk of 0 picks about 64 KB worth of objects.
+static inline void pool_init(qol_pool* p, size_t object_size, size_t per_chunk) {
+    p->size = _QOL_ALIGN(object_size ? object_size : 1);
+    p->per_chunk = per_chunk ? per_chunk : (65536 / p->size ? 65536 / p->size : 1);
+    p->free_list = NULL;
+    p->fresh = p->fresh_end = NULL;
+    p->chunks = NULL;
+    p->al.alloc = _qol_pool_alloc;
+    p->al.resize = _qol_pool_resize;
+    p->al.release = _qol_pool_release;
+    p->al.ctx = p;
+}
+
+// Frees every chunk; objects still out become invalid.
+static inline void pool_free(qol_pool* p) {
+    _qol_pool_chunk* c = p->chunks;
+    while (c) { _qol_pool_chunk* n = c->next; _QOL_SYS_FREE(c); c = n; }
+    p->chunks = NULL; p->free_list = NULL;
+    p->fresh = p->fresh_end = NULL;
+}
+
+// --- Scoped Allocation ---
+// qol_malloc serves from the calling thread's current allocator (the heap until
+// qol_alloc_use). Each block records its owner, so qol_free and qol_realloc
+// return it there even after the scope has ended. Arenas and pools do not lock:
+// their blocks must be freed on the thread that owns them. The current allocator
+// is per thread and, being static, per translation unit.
+static _TYPES_TLS const qol_alloc* _qol_current;
+
+typedef struct { const qol_alloc* al; size_t size; } _qol_tag;
+#define _QOL_TAG_SIZE _QOL_ALIGN(sizeof(_qol_tag))
+
+// Makes al (NULL for the heap) current on this thread; returns the previous one.
+static inline const qol_alloc* qol_alloc_use(const qol_alloc* al) {
+    const qol_alloc* prev = _qol_current;
+    _qol_current = al;
+    return prev;
+}
+
+static inline void* qol_malloc(size_t size) {
+    const qol_alloc* al = _qol_current;
+    if (size > (size_t)-1 - _QOL_TAG_SIZE) return NULL;
+    _qol_tag* t = (_qol_tag*)(al ? al->alloc(al->ctx, size + _QOL_TAG_SIZE) : malloc(size + _QOL_TAG_SIZE));
+    if (!t) return NULL;
+    t->al = al; t->size = size;
+    return (unsigned char*)t + _QOL_TAG_SIZE;
+}
+
+static inline void qol_free(void* ptr) {
+    if (!ptr) return;
+    _qol_tag* t = (_qol_tag*)(void*)((unsigned char*)ptr - _QOL_TAG_SIZE);
+    if (t->al) t->al->release(t->al->ctx, t, t->size + _QOL_TAG_SIZE);
+    else free(t);
+}
+
+// Stays with the allocator that made ptr, whichever is current now.
+static inline void* qol_realloc(void* ptr, size_t size) {
+    if (!ptr) return qol_malloc(size);
+    if (size > (size_t)-1 - _QOL_TAG_SIZE) return NULL;
+    _qol_tag* t = (_qol_tag*)(void*)((unsigned char*)ptr - _QOL_TAG_SIZE);
+    const qol_alloc* al = t->al;
+    t = (_qol_tag*)(al ? al->resize(al->ctx, t, t->size + _QOL_TAG_SIZE, size + _QOL_TAG_SIZE)
+                       : realloc(t, size + _QOL_TAG_SIZE));
+    if (!t) return NULL;
+    t->size = size;
+    return (unsigned char*)t + _QOL_TAG_SIZE;
+}
+
+// --- Dynamic Big Integers (sbig) ---
+// Unsigned integer whose limb storage grows as needed. Storage comes from an
+// sbig_allocator, so temporaries can be bump-allocated from an sbig_arena.
+typedef qol_alloc sbig_allocator;
+
+typedef struct {
+    u32* limbs;
+    int len;   // Significant limbs; 0 means the value is zero.
+    int cap;
+    const sbig_allocator* al;
+} sbig;
+
+// sbig's names for the shared heap and arena (see Allocators above).
+#define sbig_heap qol_heap
+typedef qol_arena sbig_arena;
+
+static inline void sbig_arena_init(sbig_arena* a, size_t block_size) { arena_init(a, block_size); }
+// Drops every allocation at once; blocks are kept for reuse.
+static inline void sbig_arena_reset(sbig_arena* a) { arena_reset(a); }
+static inline void sbig_arena_free(sbig_arena* a) { arena_free(a); }
+
+// --- sbig Core ---
+static inline void sbig_init(sbig* v, const sbig_allocator* al) {
+    v->limbs = NULL; v->len = 0; v->cap = 0;
+    v->al = al ? al : &sbig_heap;
+}
+
+static inline void sbig_free(sbig* v) {
+    if (v->limbs) v->al->release(v->al->ctx, v->limbs, (size_t)v->cap * sizeof(u32));
+    v->limbs = NULL; v->len = 0; v->cap = 0;
+}
+
+static inline int _sbig_reserve(sbig* v, int n) {
+    if (n <= v->cap) return 1;
+    int cap = v->cap ? v->cap : 4;
+    while (cap < n) cap = cap > INT_MAX / 2 ? n : cap * 2;
+    u32* p = v->limbs
+        ? (u32*)v->al->resize(v->al->ctx, v->limbs, (size_t)v->cap * sizeof(u32), (size_t)cap * sizeof(u32))
+        : (u32*)v->al->alloc(v->al->ctx, (size_t)cap * sizeof(u32));
+    if (!p) return 0;
+    v->limbs = p; v->cap = cap;
+    return 1;
+}
+
+static inline void _sbig_trim(sbig* v) { while (v->len > 0 && v->limbs[v->len - 1] == 0) v->len--; }
+
+// Replaces dst's storage with tmp's. Both must share an allocator.
+static inline void _sbig_adopt(sbig* dst, sbig* tmp) {
+    sbig_free(dst);
+    *dst = *tmp;
+    tmp->limbs = NULL; tmp->len = tmp->cap = 0;
+}
+
+static inline int sbig_is_zero(const sbig* v) { return v->len == 0; }
+
+static inline int sbig_set_u64(sbig* v, u64 x) {
+    if (!_sbig_reserve(v, 2)) return 0;
+    v->limbs[0] = (u32)x; v->limbs[1] = (u32)(x >> 32);
+    v->len = 2; _sbig_trim(v);
+    return 1;
+}
+
+static inline int sbig_copy(sbig* dst, const sbig* src) {
+    if (dst == src) return 1;
+    if (!_sbig_reserve(dst, src->len)) return 0;
+    if (src->len) memcpy(dst->limbs, src->limbs, (size_t)src->len * sizeof(u32));
+    dst->len = src->len;
+    return 1;
+}
+
+static inline int _sbig_cmp_raw(const u32* a, int an, const u32* b, int bn) {
+    if (an != bn) return an < bn ? -1 : 1;
+    for (int i = an - 1; i >= 0; i--)
+        if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+    return 0;
+}
+
+static inline int sbig_cmp(const sbig* a, const sbig* b) { return _sbig_cmp_raw(a->limbs, a->len, b->limbs, b->len); }
+
+// --- sbig Arithmetic ---
+// All functions allow res to alias an operand and return 1 on success, 0 on allocation failure.
+static inline int sbig_add(sbig* res, const sbig* a, const sbig* b) {
+    int n = a->len > b->len ? a->len : b->len;
+    if (!_sbig_reserve(res, n + 1)) return 0;
+    u64 carry = 0;
+    for (int i = 0; i < n; i++) {
+        u64 sum = (u64)(i < a->len ? a->limbs[i] : 0) + (i < b->len ? b->limbs[i] : 0) + carry;
+        res->limbs[i] = (u32)sum;
+        carry = sum >> 32;
+    }
+    res->limbs[n] = (u32)carry;
+    res->len = n + 1; _sbig_trim(res);
+    return 1;
+}
+
+// res = |a - b|. Returns 0 normally, 1 if b > a (borrow), -1 on allocation failure.
+static inline int sbig_sub(sbig* res, const sbig* a, const sbig* b) {
+    int borrowed = 0;
+    if (sbig_cmp(a, b) < 0) { const sbig* t = a; a = b; b = t; borrowed = 1; }
+    if (!_sbig_reserve(res, a->len)) return -1;
+    u64 borrow = 0;
+    for (int i = 0; i < a->len; i++) {
+        u64 sub = (u64)a->limbs[i] - (i < b->len ? b->limbs[i] : 0) - borrow;
+        res->limbs[i] = (u32)sub;
+        borrow = (sub >> 63) & 1;
+    }
+    res->len = a->len; _sbig_trim(res);
+    return borrowed;
+}
+
+// out[0 .. an+bn) = a * b. out must be zeroed and must not overlap a or b.
+static inline void _sbig_mul_raw(u32* out, const u32* a, int an, const u32* b, int bn) {
+    for (int i = 0; i < an; i++) {
+        if (a[i] == 0) continue;
+        u64 carry = 0;
+        for (int j = 0; j < bn; j++) {
+            u64 cur = out[i + j] + (u64)a[i] * b[j] + carry;
+            out[i + j] = (u32)cur;
+            carry = cur >> 32;
+        }
+        out[i + bn] = (u32)carry;
+    }
+}
+
+// --- Parallel Helper ---
+// Splits [0, n) across sbig_set_threads() workers when built with -DSBIG_THREADS.
+typedef void (*_sbig_range_fn)(void* ctx, int lo, int hi);
+
+#ifdef SBIG_THREADS
+static int _sbig_threads = 1;
+static inline void sbig_set_threads(int n) { _sbig_threads = n < 1 ? 1 : (n > 64 ? 64 : n); }
+
+typedef struct { _sbig_range_fn fn; void* ctx; int lo, hi; } _sbig_job;
+
+#ifdef _WIN32
+static DWORD WINAPI _sbig_job_entry(LPVOID p) {
+#else
+static void* _sbig_job_entry(void* p) {
+#endif
+    _sbig_job* j = (_sbig_job*)p;
+    j->fn(j->ctx, j->lo, j->hi);
+    return 0;
+}
+#endif
+
+// Only ranges of at least min_n items are split. A worker that cannot be
+// started has its chunk run on the calling thread instead.
+static inline void _sbig_parallel_for(_sbig_range_fn fn, void* ctx, int n, int min_n) {
+#ifdef SBIG_THREADS
+    int t = _sbig_threads;
+    if (t > 1 && n >= min_n) {
+        _sbig_job jobs[64];
+        int started[64] = {0};
+    #ifdef _WIN32
+        HANDLE th[64];
+    #else
+        pthread_t th[64];
+    #endif
+        int chunk = (n + t - 1) / t, spawned = 0;
+        for (int i = 1; i < t && i * chunk < n; i++, spawned++) {
+            jobs[i].fn = fn; jobs[i].ctx = ctx;
+            jobs[i].lo = i * chunk; jobs[i].hi = (i + 1) * chunk < n ? (i + 1) * chunk : n;
+    #ifdef _WIN32
+            started[i] = (th[i] = CreateThread(NULL, 0, _sbig_job_entry, &jobs[i], 0, NULL)) != NULL;
+    #else
+            started[i] = pthread_create(&th[i], NULL, _sbig_job_entry, &jobs[i]) == 0;
+    #endif
+            if (!started[i]) fn(ctx, jobs[i].lo, jobs[i].hi);
+        }
+        fn(ctx, 0, chunk < n ? chunk : n);
+        for (int i = 1; i <= spawned; i++) {
+            if (!started[i]) continue;
+    #ifdef _WIN32
+            WaitForSingleObject(th[i], INFINITE); CloseHandle(th[i]);
+    #else
+            pthread_join(th[i], NULL);
+    #endif
+        }
+        return;
+    }
+#endif
+    (void)min_n;
+    fn(ctx, 0, n);
+}
+
+// Power-of-two number of slices a transform of length n is cut into: one per
+// worker, or 1 when it is too small to be worth threads.
+static inline int _sbig_slices(int n) {
+    int p = 1;
+#ifdef SBIG_THREADS
+    if (n >= 8192) while (p * 2 <= _sbig_threads && p * 2 <= n / 2) p *= 2;
+#else
+    (void)n;
+#endif
+    return p;
+}
+
+// --- Number-Theoretic Transform ---
+// Three NTT-friendly primes; their product (~2^86) bounds each convolution
+// coefficient (min(an, bn) * 2^64), so 32-bit limbs are transformed directly.
+#ifndef SBIG_KARATSUBA_CUTOFF
+#define SBIG_KARATSUBA_CUTOFF 48
+#endif
+#if SBIG_KARATSUBA_CUTOFF < 4
+    #error "SBIG_KARATSUBA_CUTOFF must be at least 4: Karatsuba recurses on (n + 1) / 2 + 1 limbs"
+#endif
+#ifndef SBIG_NTT_CUTOFF
+#define SBIG_NTT_CUTOFF 3072
+#endif
+#define _NTT_P1 998244353u
+#define _NTT_P2 167772161u
+#define _NTT_P3 469762049u
+#define _NTT_MAX_LEN (1 << 22)
+
+static inline u32 _ntt_pow(u64 b, u64 e, u32 p) {
+    u64 r = 1; b %= p;
+    while (e) { if (e & 1) r = r * b % p; b = b * b % p; e >>= 1; }
+    return (u32)r;
+}
+
+static inline void _ntt_bitrev(u32* a, int n) {
+    for (int i = 1, j = 0; i < n; i++) {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) { u32 t = a[i]; a[i] = a[j]; a[j] = t; }
+    }
+}
+
+typedef struct { u32* a; u32* b; const u32* w; int half; } _ntt_ctx;
+
+// Per-prime kernels so every "% P" is by a compile-time constant.
+#define DEF_NTT(ID, P, G) \
+    /* w[half + j] = (primitive 2*half-th root)^j for every level. */ \
+    static inline void _ntt_roots_##ID(u32* w, int n) { \
+        for (int half = 1; half < n; half <<= 1) { \
+            u64 step = _ntt_pow(G, (P - 1) / (2 * (u64)half), P), cur = 1; \
+            for (int j = 0; j < half; j++) { w[half + j] = (u32)cur; cur = cur * step % P; } \
+        } \
+    } \
+    static inline void _ntt_level_##ID(void* c, int lo, int hi) { \
+        _ntt_ctx* x = (_ntt_ctx*)c; \
+        u32* a = x->a; const u32* w = x->w + x->half; int half = x->half; \
+        int blk = lo / half, j = lo % half; \
+        for (int k = lo; k < hi; k++) { \
+            int i = blk * 2 * half + j; \
+            u32 u = a[i], v = (u32)((u64)a[i + half] * w[j] % P); \
+            a[i] = u + v >= P ? u + v - P : u + v; \
+            a[i + half] = u >= v ? u - v : u + P - v; \
+            if (++j == half) { j = 0; blk++; } \
+        } \
+    } \
+    /* Every level whose butterflies stay inside one slice of x->half elements. */ \
+    static inline void _ntt_slices_##ID(void* c, int lo, int hi) { \
+        _ntt_ctx* x = (_ntt_ctx*)c; \
+        for (int s = lo; s < hi; s++) { \
+            for (int half = 1; half < x->half; half <<= 1) { \
+                _ntt_ctx y = { x->a + (size_t)s * x->half, NULL, x->w, half }; \
+                _ntt_level_##ID(&y, 0, x->half / 2); \
+            } \
+        } \
+    } \
+    static inline void _ntt_pointwise_##ID(void* c, int lo, int hi) { \
+        _ntt_ctx* x = (_ntt_ctx*)c; \
+        for (int i = lo; i < hi; i++) x->a[i] = (u32)((u64)x->a[i] * x->b[i] % P); \
+    } \
+    static inline void _ntt_##ID(u32* a, const u32* w, int n, int invert) { \
+        /* One parallel pass for the levels local to a slice, then one per level above. */ \
+        int slices = _sbig_slices(n); \
+        _ntt_ctx local = { a, NULL, w, n / slices }; \
+        _ntt_bitrev(a, n); \
+        _sbig_parallel_for(_ntt_slices_##ID, &local, slices, 2); \
+        for (int half = n / slices; half < n; half <<= 1) { \
+            _ntt_ctx x = { a, NULL, w, half }; \
+            _sbig_parallel_for(_ntt_level_##ID, &x, n / 2, 8192); \
+        } \
+        if (invert) { \
+            /* Inverse = forward transform with indices 1..n-1 reversed, scaled by 1/n. */ \
+            for (int i = 1, j = n - 1; i < j; i++, j--) { u32 t = a[i]; a[i] = a[j]; a[j] = t; } \
+            u64 ninv = _ntt_pow((u64)n, P - 2, P); \
+            for (int i = 0; i < n; i++) a[i] = (u32)(a[i] * ninv % P); \
+        } \
+    } \
+    /* fa = (a * b) mod P as a cyclic convolution of length n. fb and w are scratch. */ \
+    static inline void _ntt_conv_##ID(u32* fa, u32* fb, u32* w, const u32* a, int an, const u32* b, int bn, int n) { \
+        for (int i = 0; i < n; i++) fa[i] = i < an ? a[i] % P : 0; \
+        for (int i = 0; i < n; i++) fb[i] = i < bn ? b[i] % P : 0; \
+        _ntt_roots_##ID(w, n); \
+        _ntt_##ID(fa, w, n, 0); \
+        _ntt_##ID(fb, w, n, 0); \
+        _ntt_ctx x = { fa, fb, w, 0 }; \
+        _sbig_parallel_for(_ntt_pointwise_##ID, &x, n, 8192); \
+        _ntt_##ID(fa, w, n, 1); \
+    }
+
+DEF_NTT(1, _NTT_P1, 3)
+DEF_NTT(2, _NTT_P2, 3)
+DEF_NTT(3, _NTT_P3, 3)
+
+// out[0 .. an+bn) = a * b via three-prime NTT and Garner CRT.
+// Returns 0 (out untouched) if the operands exceed the transform limits or memory runs out.
+static inline int _sbig_mul_ntt(u32* out, const u32* a, int an, const u32* b, int bn, const sbig_allocator* al) {
+    int need = an + bn, n = 1;
+    while (n < need) n <<= 1;
+    if (n > _NTT_MAX_LEN || (an < bn ? an : bn) > _NTT_MAX_LEN / 2) return 0;
+    size_t bytes = (size_t)n * 5 * sizeof(u32);
+    u32* buf = (u32*)al->alloc(al->ctx, bytes);
+    if (!buf) return 0;
+    u32 *r1 = buf, *r2 = buf + n, *r3 = buf + 2 * (size_t)n, *fb = buf + 3 * (size_t)n, *w = buf + 4 * (size_t)n;
+    _ntt_conv_1(r1, fb, w, a, an, b, bn, n);
+    _ntt_conv_2(r2, fb, w, a, an, b, bn, n);
+    _ntt_conv_3(r3, fb, w, a, an, b, bn, n);
+
+    const u64 p1 = _NTT_P1, p2 = _NTT_P2, p3 = _NTT_P3, p12 = p1 * p2;
+    const u64 inv_p1 = _ntt_pow(p1, p2 - 2, _NTT_P2);
+    const u64 inv_p12 = _ntt_pow(p12 % p3, p3 - 2, _NTT_P3);
+    u64 carry = 0;
+    for (int i = 0; i < need; i++) {
+        // Garner: x = r1 + p1*t2 + p1*p2*t3, assembled as three 32-bit words.
+        u64 t2 = (r2[i] + p2 - r1[i] % p2) % p2 * inv_p1 % p2;
+        u64 lo = r1[i] + p1 * t2;
+        u64 t3 = (r3[i] + p3 - lo % p3) % p3 * inv_p12 % p3;
+        u64 b_lo = (p12 & 0xFFFFFFFFu) * t3, b_hi = (p12 >> 32) * t3;
+        u64 s0 = (lo & 0xFFFFFFFFu) + (b_lo & 0xFFFFFFFFu);
+        u64 s1 = (lo >> 32) + (b_lo >> 32) + (b_hi & 0xFFFFFFFFu) + (s0 >> 32);
+        u64 w2 = (b_hi >> 32) + (s1 >> 32);
+        u64 sum = (s0 & 0xFFFFFFFFu) + (carry & 0xFFFFFFFFu);
+        out[i] = (u32)sum;
+        carry = (carry >> 32) + (sum >> 32) + (s1 & 0xFFFFFFFFu) + (w2 << 32);
+    }
+    al->release(al->ctx, buf, bytes);
+    return 1;
+}
+
+// --- Karatsuba ---
+#define _SBIG_KARA_SCRATCH(n) (4 * (size_t)(n) + 512)
+
+// out[0 .. 2n) = a * b for equal-length operands.
+static inline void _sbig_mul_karatsuba(u32* out, const u32* a, const u32* b, int n, u32* scratch) {
+    if (n < SBIG_KARATSUBA_CUTOFF) {
+        memset(out, 0, 2 * (size_t)n * sizeof(u32));
+        _sbig_mul_raw(out, a, n, b, n);
+        return;
+    }
+    int l = (n + 1) / 2, h = n - l;
+    u32 *sa = scratch, *sb = sa + l + 1, *z1 = sb + l + 1, *next = z1 + 2 * (l + 1);
+    _sbig_mul_karatsuba(out, a, b, l, next);                 // z0 = a0*b0
+    _sbig_mul_karatsuba(out + 2 * l, a + l, b + l, h, next); // z2 = a1*b1
+    u64 ca = 0, cb = 0;
+    for (int i = 0; i < l; i++) {
+        ca += (u64)a[i] + (i < h ? a[l + i] : 0); sa[i] = (u32)ca; ca >>= 32;
+        cb += (u64)b[i] + (i < h ? b[l + i] : 0); sb[i] = (u32)cb; cb >>= 32;
+    }
+    sa[l] = (u32)ca; sb[l] = (u32)cb;
+    _sbig_mul_karatsuba(z1, sa, sb, l + 1, next);            // (a0+a1)(b0+b1)
+    // z1 -= z0 + z2
+    s64 br = 0;
+    for (int i = 0; i < 2 * (l + 1); i++) {
+        s64 t = (s64)z1[i] - (i < 2 * l ? out[i] : 0) - (i < 2 * h ? out[2 * l + i] : 0) + br;
+        z1[i] = (u32)t;
+        br = t >> 32;
+    }
+    // out += z1 << (32 * l); the middle term always fits below 2n limbs.
+    u64 c = 0;
+    int zn = 2 * (l + 1) < 2 * n - l ? 2 * (l + 1) : 2 * n - l;
+    for (int i = 0; i < zn || (c && l + i < 2 * n); i++) {
+        c += (u64)out[l + i] + (i < zn ? z1[i] : 0);
+        out[l + i] = (u32)c;
+        c >>= 32;
+    }
+}
+
+// out[0 .. an+bn) = a * b, picking schoolbook, Karatsuba or NTT from operand size.
+// out must be zeroed and must not overlap a or b.
+static inline void _sbig_mul_any(u32* out, const u32* a, int an, const u32* b, int bn, const sbig_allocator* al) {
+    if (an < bn) { const u32* t = a; a = b; b = t; int tn = an; an = bn; bn = tn; }
+    if (bn < SBIG_KARATSUBA_CUTOFF) { _sbig_mul_raw(out, a, an, b, bn); return; }
+    if (bn >= SBIG_NTT_CUTOFF && _sbig_mul_ntt(out, a, an, b, bn, al)) return;
+    size_t bytes = (_SBIG_KARA_SCRATCH(bn) + 2 * (size_t)bn) * sizeof(u32);
+    u32* scratch = (u32*)al->alloc(al->ctx, bytes);
+    if (!scratch) { _sbig_mul_raw(out, a, an, b, bn); return; }
+    u32* prod = scratch + _SBIG_KARA_SCRATCH(bn);
+    // Unbalanced operands: multiply bn-sized slices of a and accumulate.
+    for (int off = 0; off < an; off += bn) {
+        int len = an - off < bn ? an - off : bn;
+        if (len == bn) _sbig_mul_karatsuba(prod, a + off, b, bn, scratch);
+        else { memset(prod, 0, (size_t)(len + bn) * sizeof(u32)); _sbig_mul_any(prod, b, bn, a + off, len, al); }
+        u64 c = 0;
+        for (int i = 0; i < len + bn || (c && off + i < an + bn); i++) {
+            c += (u64)out[off + i] + (i < len + bn ? prod[i] : 0);
+            out[off + i] = (u32)c;
+            c >>= 32;
+        }
+    }
+    al->release(al->ctx, scratch, bytes);
+}
+
+static inline int sbig_mul(sbig* res, const sbig* a, const sbig* b) {
+    if (a->len == 0 || b->len == 0) { res->len = 0; return 1; }
+    if (a->len < 0 || b->len < 0 || (size_t)a->len + (size_t)b->len > (size_t)INT_MAX) return 0;
+    sbig tmp; sbig_init(&tmp, res->al);
+    if (!_sbig_reserve(&tmp, a->len + b->len)) return 0;
+    memset(tmp.limbs, 0, ((size_t)a->len + (size_t)b->len) * sizeof(u32));
+    _sbig_mul_any(tmp.limbs, a->limbs, a->len, b->limbs, b->len, res->al);
+    tmp.len = a->len + b->len; _sbig_trim(&tmp);
+    _sbig_adopt(res, &tmp);
+    return 1;
+}
+
+// Knuth Algorithm D on raw limbs: q[an - n + 1] = a / b, r[n] = a % b.
+// Needs an >= n >= 2 and b[n - 1] != 0; un[an + 1] and vn[n] are scratch. q may be NULL.
+static inline void _sbig_divmod_raw(u32* q, u32* r, const u32* a, int an, const u32* b, int n, u32* un, u32* vn) {
+    int m = an - n;
+    // Normalize so the divisor's top bit is set.
+    int s = __builtin_clz(b[n - 1]);
+    for (int i = n - 1; i > 0; i--)
+        vn[i] = (b[i] << s) | (s ? b[i - 1] >> (32 - s) : 0);
+    vn[0] = b[0] << s;
+    un[an] = s ? a[an - 1] >> (32 - s) : 0;
+    for (int i = an - 1; i > 0; i--)
+        un[i] = (a[i] << s) | (s ? a[i - 1] >> (32 - s) : 0);
+    un[0] = a[0] << s;
+
+    for (int j = m; j >= 0; j--) {
+        u64 num = ((u64)un[j + n] << 32) | un[j + n - 1];
+        u64 qhat = num / vn[n - 1], rhat = num % vn[n - 1];
+        while (qhat >> 32 || qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2])) {
+            qhat--; rhat += vn[n - 1];
+            if (rhat >> 32) break;
+        }
+        // Multiply and subtract.
+        s64 k = 0, t;
+        for (int i = 0; i < n; i++) {
+            u64 p = qhat * vn[i];
+            t = (s64)un[i + j] - k - (s64)(p & 0xFFFFFFFFu);
+            un[i + j] = (u32)t;
+            k = (s64)(p >> 32) - (t >> 32);
+        }
+        t = (s64)un[j + n] - k;
+        un[j + n] = (u32)t;
+        // Add back when qhat was one too large.
+        if (t < 0) {
+            qhat--;
+            u64 c = 0;
+            for (int i = 0; i < n; i++) {
+                u64 sum = (u64)un[i + j] + vn[i] + c;
+                un[i + j] = (u32)sum;
+                c = sum >> 32;
+            }
+            un[j + n] += (u32)c;
+        }
+        if (q) q[j] = (u32)qhat;
+    }
+    for (int i = 0; i < n; i++)
+        r[i] = (un[i] >> s) | (s ? un[i + 1] << (32 - s) : 0);
+}
+
+// q = a / b, r = a % b (Knuth Algorithm D). Either output may be NULL.
+// Returns 0 on division by zero or allocation failure.
+static inline int sbig_divmod(sbig* q, sbig* r, const sbig* a, const sbig* b) {
+    if (b->len == 0) return 0;
+    const sbig_allocator* al = q ? q->al : (r ? r->al : a->al);
+    sbig qt, rt; sbig_init(&qt, q ? q->al : al); sbig_init(&rt, r ? r->al : al);
+    int n = b->len, m = a->len - b->len, ok = 0;
+
+    if (m < 0) {
+        if (!sbig_copy(&rt, a)) goto done;
+    } else if (n == 1) {
+        if (!_sbig_reserve(&qt, a->len) || !_sbig_reserve(&rt, 1)) goto done;
+        u64 rem = 0, d = b->limbs[0];
+        for (int i = a->len - 1; i >= 0; i--) {
+            u64 cur = (rem << 32) | a->limbs[i];
+            qt.limbs[i] = (u32)(cur / d);
+            rem = cur % d;
+        }
+        qt.len = a->len; _sbig_trim(&qt);
+        rt.limbs[0] = (u32)rem; rt.len = 1; _sbig_trim(&rt);
+    } else {
+        size_t un_bytes = (size_t)(a->len + 1) * sizeof(u32), vn_bytes = (size_t)n * sizeof(u32);
+        u32* un = (u32*)al->alloc(al->ctx, un_bytes);
+        u32* vn = un ? (u32*)al->alloc(al->ctx, vn_bytes) : NULL;
+        if (!vn || !_sbig_reserve(&qt, m + 1) || !_sbig_reserve(&rt, n)) {
+            if (vn) al->release(al->ctx, vn, vn_bytes);
+            if (un) al->release(al->ctx, un, un_bytes);
+            goto done;
+        }
+        _sbig_divmod_raw(qt.limbs, rt.limbs, a->limbs, a->len, b->limbs, n, un, vn);
+        qt.len = m + 1; _sbig_trim(&qt);
+        rt.len = n; _sbig_trim(&rt);
+        al->release(al->ctx, vn, vn_bytes);
+        al->release(al->ctx, un, un_bytes);
+    }
+    ok = 1;
+    if (r) _sbig_adopt(r, &rt);
+    if (q) _sbig_adopt(q, &qt);
+done:
+    sbig_free(&qt); sbig_free(&rt);
+    return ok;
+}
+
+// res = base ^ exp by square-and-multiply.
+static inline int sbig_pow(sbig* res, const sbig* base, u64 exp) {
+    sbig acc, sq; sbig_init(&acc, res->al); sbig_init(&sq, res->al);
+    int ok = sbig_set_u64(&acc, 1) && sbig_copy(&sq, base);
+    while (ok && exp) {
+        if (exp & 1) ok = sbig_mul(&acc, &acc, &sq);
+        exp >>= 1;
+        if (ok && exp) ok = sbig_mul(&sq, &sq, &sq);
+    }
+    if (ok) _sbig_adopt(res, &acc);
+    sbig_free(&sq); sbig_free(&acc);
+    return ok;
+}
+
+// --- sbig Printing ---
+// Returns QOL_MALLOC'd plain decimal digits. Caller must QOL_FREE.
+static inline char* sbig_to_dec(const sbig* v) {
+    int n = v->len;
+    u32* t = (u32*)QOL_MALLOC((size_t)(n ? n : 1) * sizeof(u32));
+    // Each limb holds at most 9.64 decimal digits; peel 9 at a time.
+    char* out = (char*)QOL_MALLOC((size_t)n * 10 + 2);
+    if (!t || !out) { QOL_FREE(t); QOL_FREE(out); return NULL; }
+    if (n) memcpy(t, v->limbs, (size_t)n * sizeof(u32));
+    int pos = 0;
+    while (n > 0) {
+        u64 rem = 0;
+        for (int i = n - 1; i >= 0; i--) {
+            u64 cur = (rem << 32) | t[i];
+            t[i] = (u32)(cur / 1000000000u);
+            rem = cur % 1000000000u;
+        }
+        while (n > 0 && t[n - 1] == 0) n--;
+        for (int d = 0; d < 9 && (n > 0 || rem); d++) { out[pos++] = (char)('0' + rem % 10); rem /= 10; }
+    }
+    if (pos == 0) out[pos++] = '0';
+    for (int i = 0; i < pos / 2; i++) { char c = out[i]; out[i] = out[pos - 1 - i]; out[pos - 1 - i] = c; }
+    out[pos] = '\0';
+    QOL_FREE(t);
+    return out;
+}
+
+static inline void _nf_big(sbig v) {
+    if (v.len == 0) { printf("0x0"); return; }
+    _internal_raw_hex(v.limbs, v.len);
+}
+
+static inline void _f_big(sbig v) {
+    char* d = sbig_to_dec(&v);
+    if (!d) return;
+    int len = (int)strlen(d);
+    for (int i = 0; i < len; i++) {
+        putchar(d[i]);
+        if ((len - 1 - i) % 3 == 0 && i != len - 1) putchar(',');
+    }
+    QOL_FREE(d);
+}
+
+static inline void sbig_print(const sbig* v) { _f_big(*v); }
+
+// --- Fixed-Width Conversions ---
+#define DEF_BIG_CONV(BITS, COUNT) \
+    static inline int sbig_from_suint##BITS(sbig *res, suint##BITS v) { \
+        if (!_sbig_reserve(res, COUNT)) return 0; \
+        memcpy(res->limbs, v.limbs, sizeof(v.limbs)); \
+        res->len = COUNT; _sbig_trim(res); \
+        return 1; \
+    } \
+    /* Returns 1 if the value fit, 0 if it was truncated to BITS. */ \
+    static inline int sbig_to_suint##BITS(suint##BITS *res, const sbig *v) { \
+        int n = v->len < COUNT ? v->len : COUNT; \
+        memset(res->limbs, 0, sizeof(res->limbs)); \
+        if (n) memcpy(res->limbs, v->limbs, (size_t)n * sizeof(u32)); \
+        return v->len <= COUNT; \
+    }
+
+DEF_BIG_CONV(32, 1)    DEF_BIG_CONV(64, 2)    DEF_BIG_CONV(128, 4)
+DEF_BIG_CONV(256, 8)   DEF_BIG_CONV(512, 16)  DEF_BIG_CONV(1024, 32)
+DEF_BIG_CONV(2048, 64) DEF_BIG_CONV(4096, 128) DEF_BIG_CONV(8192, 256)
+DEF_BIG_CONV(12288, 384)
+
+// --- Widening Multiplication ---
+// res = a * b without truncation (2 * BITS result bits).
+#define DEF_MUL_FULL(BITS, COUNT) \
+    static inline int suint##BITS##_mul_full(sbig *res, suint##BITS a, suint##BITS b) { \
+        sbig x = { a.limbs, COUNT, COUNT, res->al }, y = { b.limbs, COUNT, COUNT, res->al }; \
+        _sbig_trim(&x); _sbig_trim(&y); \
+        return sbig_mul(res, &x, &y); \
+    }
+
+DEF_MUL_FULL(32, 1)    DEF_MUL_FULL(64, 2)    DEF_MUL_FULL(128, 4)
+DEF_MUL_FULL(256, 8)   DEF_MUL_FULL(512, 16)  DEF_MUL_FULL(1024, 32)
+DEF_MUL_FULL(2048, 64) DEF_MUL_FULL(4096, 128) DEF_MUL_FULL(8192, 256)
+DEF_MUL_FULL(12288, 384)
+
+// --- Batch Arithmetic (Struct-of-Arrays) ---
+// limb[k][i] is limb k of element i, so each limb row is a contiguous vector.
+// Kernels pick AVX-512, AVX2 or scalar code at runtime; carries out of the
+// top limb are dropped (results wrap mod 2^BITS, like suintBITS_mul).
+
+// 0 = scalar, 1 = AVX2, 2 = AVX-512.
+static int _types_simd = -1;
+
+static inline int types_simd_level() {
+    if (_types_simd < 0) {
+        _types_simd = 0;
+#ifdef _TYPES_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) _types_simd = 1;
+        if (__builtin_cpu_supports("avx512f")) _types_simd = 2;
+#endif
+    }
+    return _types_simd;
+}
+
+// Caps the dispatch level (e.g. 0 to force the scalar kernels).
+static inline void types_simd_limit(int level) {
+    int hw = (_types_simd = -1, types_simd_level());
+    _types_simd = level < hw ? level : hw;
+}
+
+#define DEF_BATCH(BITS, COUNT) \
+    typedef struct { u32* limb[COUNT]; size_t n; } suint##BITS##_soa; \
+    \
+    static inline int suint##BITS##_soa_alloc(suint##BITS##_soa *s, size_t n) { \
+        u32* base = (u32*)QOL_CALLOC(n ? n * COUNT : 1, sizeof(u32)); \
+        if (!base) return 0; \
+        for (int k = 0; k < COUNT; k++) s->limb[k] = base + (size_t)k * n; \
+        s->n = n; \
+        return 1; \
+    } \
+    static inline void suint##BITS##_soa_free(suint##BITS##_soa *s) { QOL_FREE(s->limb[0]); memset(s, 0, sizeof(*s)); } \
+    static inline void suint##BITS##_soa_set(suint##BITS##_soa *s, size_t i, suint##BITS v) { \
+        for (int k = 0; k < COUNT; k++) s->limb[k][i] = v.limbs[k]; \
+    } \
+    static inline suint##BITS suint##BITS##_soa_get(const suint##BITS##_soa *s, size_t i) { \
+        suint##BITS v; \
+        for (int k = 0; k < COUNT; k++) v.limbs[k] = s->limb[k][i]; \
+        return v; \
+    } \
+    \
+    /* Row-by-row over 64-element blocks so each limb row streams contiguously. */ \
+    static inline void _suint##BITS##_add_many_scalar(suint##BITS##_soa *out, const suint##BITS##_soa *a, const suint##BITS##_soa *b, size_t lo, size_t n) { \
+        u32 carry[64]; \
+        for (size_t i = lo; i < n; i += 64) { \
+            size_t m = n - i < 64 ? n - i : 64; \
+            memset(carry, 0, sizeof(carry)); \
+            for (int k = 0; k < COUNT; k++) { \
+                const u32 *x = a->limb[k] + i, *y = b->limb[k] + i; \
+                u32 *o = out->limb[k] + i; \
+                for (size_t j = 0; j < m; j++) { \
+                    u64 sum = (u64)x[j] + y[j] + carry[j]; \
+                    o[j] = (u32)sum; \
+                    carry[j] = (u32)(sum >> 32); \
+                } \
+            } \
+        } \
+    } \
+    static inline void _suint##BITS##_cmp_many_scalar(int *out, const suint##BITS##_soa *a, const suint##BITS##_soa *b, size_t lo, size_t n) { \
+        out += lo; \
+        for (size_t i = lo; i < n; i++, out++) { \
+            int k = COUNT - 1; \
+            while (k > 0 && a->limb[k][i] == b->limb[k][i]) k--; \
+            *out = (a->limb[k][i] > b->limb[k][i]) - (a->limb[k][i] < b->limb[k][i]); \
+        } \
+    } \
+    static inline void _suint##BITS##_mul_many_scalar(suint##BITS##_soa *out, const suint##BITS##_soa *a, const suint##BITS##_soa *b, size_t lo, size_t n) { \
+        for (size_t i = lo; i < n; i++) { \
+            u32 r[COUNT] = {0}, bl[COUNT]; \
+            for (int k = 0; k < COUNT; k++) bl[k] = b->limb[k][i]; \
+            for (int x = 0; x < COUNT; x++) { \
+                u64 carry = 0, ax = a->limb[x][i]; \
+                for (int y = 0; x + y < COUNT; y++) { \
+                    u64 cur = r[x + y] + ax * bl[y] + carry; \
+                    r[x + y] = (u32)cur; \
+                    carry = cur >> 32; \
+                } \
+            } \
+            for (int k = 0; k < COUNT; k++) out->limb[k][i] = r[k]; \
+        } \
+    }
+
+#ifdef _TYPES_X86_SIMD
+#define DEF_BATCH_SIMD(BITS, COUNT) \
+    __attribute__((target("avx2"))) \
+    static void _suint##BITS##_add_many_avx2(suint##BITS##_soa *out, const suint##BITS##_soa *a, const suint##BITS##_soa *b, size_t n) { \
+        const __m256i sign = _mm256_set1_epi32((int)0x80000000); \
+        size_t i = 0; \
+        for (; i + 8 <= n; i += 8) { \
+            __m256i carry = _mm256_setzero_si256(); /* 0 or all-ones per lane */ \
+            for (int k = 0; k < COUNT; k++) { \
+                __m256i x = _mm256_loadu_si256((const __m256i*)(a->limb[k] + i)); \
+                __m256i y = _mm256_loadu_si256((const __m256i*)(b->limb[k] + i)); \
+                __m256i s = _mm256_add_epi32(x, y); \
+                __m256i s2 = _mm256_sub_epi32(s, carry); \
+                __m256i c1 = _mm256_cmpgt_epi32(_mm256_xor_si256(x, sign), _mm256_xor_si256(s, sign)); \
+                __m256i c2 = _mm256_cmpgt_epi32(_mm256_xor_si256(s, sign), _mm256_xor_si256(s2, sign)); \
+                carry = _mm256_or_si256(c1, c2); \
+                _mm256_storeu_si256((__m256i*)(out->limb[k] + i), s2); \
+            } \
+        } \
+        _suint##BITS##_add_many_scalar(out, a, b, i, n); \
+    } \
+    __attribute__((target("avx2"))) \
+    static void _suint##BITS##_cmp_many_avx2(int *out, const suint##BITS##_soa *a, const suint##BITS##_soa *b, size_t n) { \
+        const __m256i sign = _mm256_set1_epi32((int)0x80000000); \
+        size_t i = 0; \
+        for (; i + 8 <= n; i += 8) { \
+            __m256i res = _mm256_setzero_si256(); \
+            for (int k = COUNT - 1; k >= 0; k--) { \
+                __m256i x = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(a->limb[k] + i)), sign); \
+                __m256i y = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(b->limb[k] + i)), sign); \
+                __m256i v = _mm256_sub_epi32(_mm256_cmpgt_epi32(y, x), _mm256_cmpgt_epi32(x, y)); \
+                __m256i open = _mm256_cmpeq_epi32(res, _mm256_setzero_si256()); \
+                res = _mm256_or_si256(res, _mm256_and_si256(open, v)); \
+                if (!_mm256_movemask_epi8(_mm256_cmpeq_epi32(res, _mm256_setzero_si256()))) break; \
+            } \
+            _mm256_storeu_si256((__m256i*)(out + i), res); \
+        } \
+        _suint##BITS##_cmp_many_scalar(out, a, b, i, n); \
+    } \
+    /* 4 elements per pass in 64-bit lanes; column sums keep low and high product halves apart. */ \
+    __attribute__((target("avx2"))) \
+    static void _suint##BITS##_mul_many_avx2(suint##BITS##_soa *out, const suint##BITS##_soa *a, const suint##BITS##_soa *b, size_t n) { \
+        const __m256i lo32 = _mm256_set1_epi64x(0xFFFFFFFF); \
+        const __m256i pack = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6); \
+        size_t i = 0; \
+        for (; i + 4 <= n; i += 4) { \
+            __m256i A[COUNT], B[COUNT], carry = _mm256_setzero_si256(); \
+            for (int k = 0; k < COUNT; k++) { \
+                A[k] = _mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i*)(a->limb[k] + i))); \
+                B[k] = _mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i*)(b->limb[k] + i))); \
+            } \
+            for (int c = 0; c < COUNT; c++) { \
+                __m256i lo = carry, hi = _mm256_setzero_si256(); \
+                for (int j = 0; j <= c; j++) { \
+                    __m256i p = _mm256_mul_epu32(A[j], B[c - j]); \
+                    lo = _mm256_add_epi64(lo, _mm256_and_si256(p, lo32)); \
+                    hi = _mm256_add_epi64(hi, _mm256_srli_epi64(p, 32)); \
+                } \
+                __m256i packed = _mm256_permutevar8x32_epi32(lo, pack); \
+                _mm_storeu_si128((__m128i*)(out->limb[c] + i), _mm256_castsi256_si128(packed)); \
+                carry = _mm256_add_epi64(_mm256_srli_epi64(lo, 32), hi); \
+            } \
+        } \
+        _suint##BITS##_mul_many_scalar(out, a, b, i, n); \
+    } \
+    __attribute__((target("avx512f"))) \
+    static void _suint##BITS##_add_many_avx512(suint##BITS##_soa *out, const suint##BITS##_soa *a, const suint##BITS##_soa *b, size_t n) { \
+        const __m512i one = _mm512_set1_epi32(1); \
+        size_t i = 0; \
+        for (; i + 16 <= n; i += 16) { \
+            __mmask16 carry = 0; \
+            for (int k = 0; k < COUNT; k++) { \
+                __m512i x = _mm512_loadu_si512(a->limb[k] + i); \
+                __m512i s = _mm512_add_epi32(x, _mm512_loadu_si512(b->limb[k] + i)); \
+                __mmask16 c1 = _mm512_cmplt_epu32_mask(s, x); \
+                s = _mm512_mask_add_epi32(s, carry, s, one); \
+                carry = c1 | (carry & _mm512_cmpeq_epi32_mask(s, _mm512_setzero_si512())); \
+                _mm512_storeu_si512(out->limb[k] + i, s); \
+            } \
+        } \
+        _suint##BITS##_add_many_scalar(out, a, b, i, n); \
+    } \
+    __attribute__((target("avx512f"))) \
+    static void _suint##BITS##_cmp_many_avx512(int *out, const suint##BITS##_soa *a, const suint##BITS##_soa *b, size_t n) { \
+        const __m512i one = _mm512_set1_epi32(1), neg = _mm512_set1_epi32(-1); \
+        size_t i = 0; \
+        for (; i + 16 <= n; i += 16) { \
+            __m512i res = _mm512_setzero_si512(); \
+            __mmask16 open = 0xFFFF; \
+            for (int k = COUNT - 1; k >= 0 && open; k--) { \
+                __m512i x = _mm512_loadu_si512(a->limb[k] + i), y = _mm512_loadu_si512(b->limb[k] + i); \
+                __mmask16 lt = _mm512_mask_cmplt_epu32_mask(open, x, y), gt = _mm512_mask_cmpgt_epu32_mask(open, x, y); \
+                res = _mm512_mask_mov_epi32(_mm512_mask_mov_epi32(res, lt, neg), gt, one); \
+                open &= (__mmask16)~(lt | gt); \
+            } \
+            _mm512_storeu_si512(out + i, res); \
+        } \
+        _suint##BITS##_cmp_many_scalar(out, a, b, i, n); \
+    } \
+    __attribute__((target("avx512f"))) \
+    static void _suint##BITS##_mul_many_avx512(suint##BITS##_soa *out, const suint##BITS##_soa *a, const suint##BITS##_soa *b, size_t n) { \
+        const __m512i lo32 = _mm512_set1_epi64(0xFFFFFFFF); \
+        size_t i = 0; \
+        for (; i + 8 <= n; i += 8) { \
+            __m512i A[COUNT], B[COUNT], carry = _mm512_setzero_si512(); \
+            for (int k = 0; k < COUNT; k++) { \
+                A[k] = _mm512_cvtepu32_epi64(_mm256_loadu_si256((const __m256i*)(a->limb[k] + i))); \
+                B[k] = _mm512_cvtepu32_epi64(_mm256_loadu_si256((const __m256i*)(b->limb[k] + i))); \
+            } \
+            for (int c = 0; c < COUNT; c++) { \
+                __m512i lo = carry, hi = _mm512_setzero_si512(); \
+                for (int j = 0; j <= c; j++) { \
+                    __m512i p = _mm512_mul_epu32(A[j], B[c - j]); \
+                    lo = _mm512_add_epi64(lo, _mm512_and_si512(p, lo32)); \
+                    hi = _mm512_add_epi64(hi, _mm512_srli_epi64(p, 32)); \
+                } \
+                _mm256_storeu_si256((__m256i*)(out->limb[c] + i), _mm512_cvtepi64_epi32(lo)); \
+                carry = _mm512_add_epi64(_mm512_srli_epi64(lo, 32), hi); \
+            } \
+        } \
+        _suint##BITS##_mul_many_scalar(out, a, b, i, n); \
+    }
+
+#define _BATCH_CALL(BITS, OP, ...) { \
+        int _lvl = types_simd_level(); \
+        if (_lvl >= 2) _suint##BITS##_##OP##_avx512(__VA_ARGS__, n); \
+        else if (_lvl == 1) _suint##BITS##_##OP##_avx2(__VA_ARGS__, n); \
+        else _suint##BITS##_##OP##_scalar(__VA_ARGS__, 0, n); \
+    }
+#else
+#define DEF_BATCH_SIMD(BITS, COUNT)
+#define _BATCH_CALL(BITS, OP, ...) { _suint##BITS##_##OP##_scalar(__VA_ARGS__, 0, n); }
+#endif
+
+#define DEF_BATCH_API(BITS, COUNT) \
+    /* out[i] = a[i] + b[i] for i < n. out may alias a or b. */ \
+    static inline void suint##BITS##_add_many(suint##BITS##_soa *out, const suint##BITS##_soa *a, const suint##BITS##_soa *b, size_t n) \
+        _BATCH_CALL(BITS, add_many, out, a, b) \
+    /* out[i] = -1, 0 or 1 as a[i] <, ==, > b[i]. */ \
+    static inline void suint##BITS##_cmp_many(int *out, const suint##BITS##_soa *a, const suint##BITS##_soa *b, size_t n) \
+        _BATCH_CALL(BITS, cmp_many, out, a, b) \
+    /* out[i] = a[i] * b[i] (low BITS bits). out may alias a or b. */ \
+    static inline void suint##BITS##_mul_many(suint##BITS##_soa *out, const suint##BITS##_soa *a, const suint##BITS##_soa *b, size_t n) \
+        _BATCH_CALL(BITS, mul_many, out, a, b)
+
+DEF_BATCH(256, 8)   DEF_BATCH_SIMD(256, 8)   DEF_BATCH_API(256, 8)
+DEF_BATCH(512, 16)  DEF_BATCH_SIMD(512, 16)  DEF_BATCH_API(512, 16)
+
+// --- Float Engine ---
+// sfloatBITS = (-1)^sign * mantissa * 2^exponent. Normalized values keep the
+// mantissa's top bit set (zero is all-zero). Results round to nearest, ties
+// to even. The generic helpers below work on a view of n limbs so Newton
+// iterations can run one limb wider than the target type. Working buffers come
+// from a tmp array the DEF_FLOAT wrappers size with a constant COUNT:
+// _SF_TMP(n) limbs for the basic operations, _SF_TMP_WIDE(n) for div and sqrt.
+typedef struct { u32* m; s64 e; int s; int n; } _sf_t;
+
+#define _SF_KARA(n) ((n) < SBIG_KARATSUBA_CUTOFF ? 0 : _SBIG_KARA_SCRATCH(n))
+#define _SF_TMP(n) (6 * (size_t)(n) + 8 + _SF_KARA(n))
+#define _SF_TMP_WIDE(n) (19 * (size_t)(n) + 28 + _SF_KARA((n) + 1))
+
+static inline int _sf_bitlen(const u32* a, int n) {
+    for (int i = n - 1; i >= 0; i--)
+        if (a[i]) return i * 32 + 32 - __builtin_clz(a[i]);
+    return 0;
+}
+
+static inline int _sf_bit(const u32* a, int n, s64 bit) {
+    return (bit >= 0 && bit / 32 < n) ? (a[bit / 32] >> (bit % 32)) & 1 : 0;
+}
+
+// Any of bits [0, bit) set?
+static inline int _sf_any_below(const u32* a, int n, s64 bit) {
+    s64 limbs = bit / 32;
+    for (s64 i = 0; i < limbs && i < n; i++) if (a[i]) return 1;
+    if (bit % 32 && limbs < n) return (a[limbs] & ((1u << (bit % 32)) - 1)) != 0;
+    return 0;
+}
+
+// out[count] = a[n] >> s. Safe in place.
+static inline void _sf_shr(u32* out, int count, const u32* a, int n, s64 s) {
+    s64 ls = s / 32; int bs = (int)(s % 32);
+    for (int i = 0; i < count; i++) {
+        s64 j = i + ls;
+        u32 lo = j < n ? a[j] : 0, hi = j + 1 < n ? a[j + 1] : 0;
+        out[i] = bs ? (lo >> bs) | (hi << (32 - bs)) : lo;
+    }
+}
+
+// out[count] = a[n] << s. Safe in place.
+static inline void _sf_shl(u32* out, int count, const u32* a, int n, s64 s) {
+    s64 ls = s / 32; int bs = (int)(s % 32);
+    for (int i = count - 1; i >= 0; i--) {
+        s64 j = i - ls;
+        u32 cur = (j >= 0 && j < n) ? a[j] : 0, prev = (j - 1 >= 0 && j - 1 < n) ? a[j - 1] : 0;
+        out[i] = bs ? (cur << bs) | (prev >> (32 - bs)) : cur;
+    }
+}
+
+static inline int _sf_cmp_n(const u32* a, const u32* b, int n) {
+    for (int i = n - 1; i >= 0; i--) if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+    return 0;
+}
+
+static inline u32 _sf_add_n(u32* a, const u32* b, int n) {
+    u64 c = 0;
+    for (int i = 0; i < n; i++) { c += (u64)a[i] + b[i]; a[i] = (u32)c; c >>= 32; }
+    return (u32)c;
+}
+
+static inline u32 _sf_sub_n(u32* a, const u32* b, int n) {
+    u64 br = 0;
+    for (int i = 0; i < n; i++) { u64 d = (u64)a[i] - b[i] - br; a[i] = (u32)d; br = (d >> 63) & 1; }
+    return (u32)br;
+}
+
+static inline void _sf_zero(_sf_t* v) { memset(v->m, 0, (size_t)v->n * sizeof(u32)); v->e = 0; v->s = 0; }
+
+static inline void _sf_copy(_sf_t* dst, const _sf_t* src) {
+    if (dst->m != src->m) memcpy(dst->m, src->m, (size_t)dst->n * sizeof(u32));
+    dst->e = src->e; dst->s = src->s;
+}
+
+static inline void _sf_normalize(_sf_t* v) {
+    int len = _sf_bitlen(v->m, v->n);
+    if (!len) { v->e = 0; v->s = 0; return; }
+    int sh = 32 * v->n - len;
+    if (sh) { _sf_shl(v->m, v->n, v->m, v->n, sh); v->e -= sh; }
+}
+
+// r = ext[len] * 2^e rounded to r->n limbs; sticky marks nonzero bits below ext.
+static inline void _sf_pack(_sf_t* r, const u32* ext, int len, s64 e, int sticky) {
+    int bits = _sf_bitlen(ext, len), n = r->n;
+    if (!bits) { _sf_zero(r); return; }
+    s64 shift = (s64)bits - 32 * n;
+    if (shift <= 0) { _sf_shl(r->m, n, ext, len, -shift); r->e = e + shift; return; }
+    _sf_shr(r->m, n, ext, len, shift);
+    int round = _sf_bit(ext, len, shift - 1);
+    sticky |= _sf_any_below(ext, len, shift - 1);
+    if (round && (sticky || (r->m[0] & 1))) {
+        int i = 0;
+        while (i < n && ++r->m[i] == 0) i++;
+        if (i == n) { r->m[n - 1] = 0x80000000u; shift++; }
+    }
+    r->e = e + shift;
+}
+
+// Copies src into a wider (or equal) view, keeping the value.
+static inline void _sf_widen(_sf_t* dst, const _sf_t* src) {
+    int pad = dst->n - src->n;
+    memset(dst->m, 0, (size_t)pad * sizeof(u32));
+    memcpy(dst->m + pad, src->m, (size_t)src->n * sizeof(u32));
+    dst->e = src->e - 32 * (s64)pad; dst->s = src->s;
+}
+
+static inline void _sf_from_double(_sf_t* r, double d) {
+    u64 bits; memcpy(&bits, &d, sizeof(bits));
+    int ex = (int)((bits >> 52) & 0x7FF);
+    u64 man = bits & ((1ull << 52) - 1);
+    if (ex == 0x7FF || (ex == 0 && man == 0)) { _sf_zero(r); return; } // Inf/NaN are not representable.
+    if (ex == 0) ex = 1; else man |= 1ull << 52;
+    u32 ext[2] = { (u32)man, (u32)(man >> 32) };
+    _sf_pack(r, ext, 2, (s64)ex - 1075, 0);
+    r->s = (int)(bits >> 63);
+}
+
+static inline void _sf_add(_sf_t* r, const _sf_t* a, const _sf_t* b, int negate_b, u32* tmp);
+
+// Splits a long double into up to three exact double parts, scaled into double range.
+static inline void _sf_from_ldouble(_sf_t* r, long double x, u32* tmp) {
+    if (x != x || x - x != 0 || x == 0) { _sf_zero(r); return; }
+    s64 scale = 0;
+    while (x > 0x1p1000L || x < -0x1p1000L) { x *= 0x1p-1000L; scale += 1000; }
+    while (x < 0x1p-900L && x > -0x1p-900L) { x *= 0x1p900L; scale -= 900; }
+    int n = r->n;
+    _sf_t part = { tmp, 0, 0, n };
+    _sf_zero(r);
+    for (int i = 0; i < 3 && x != 0; i++) {
+        double d = (double)x;
+        x -= d;
+        _sf_from_double(&part, d);
+        _sf_add(r, r, &part, 0, tmp + n);
+    }
+    if (r->m[n - 1]) r->e += scale;
+}
+
+static inline double _sf_pow2(int k) { u64 bits = (u64)(k + 1023) << 52; double d; memcpy(&d, &bits, sizeof(d)); return d; }
+
+static inline double _sf_to_double(const _sf_t* v, u32* m) {
+    int n = v->n;
+    _sf_t x = { m, v->e, v->s, n };
+    memcpy(m, v->m, (size_t)n * sizeof(u32));
+    _sf_normalize(&x);
+    if (!m[n - 1]) return 0.0;
+    u64 top = (u64)m[n - 1] << 32 | (n > 1 ? m[n - 2] : 0);
+    int sticky = n > 2 && _sf_any_below(m, n, 32 * (s64)n - 64);
+    s64 E = x.e + 32 * (s64)n - 64 + 63 + 1023;   // Biased exponent of top's leading bit.
+    u64 sign = (u64)x.s << 63, bits;
+    if (E >= 2047) bits = sign | 0x7FF0000000000000ull;
+    else {
+        int shift = E >= 1 ? 11 : (int)(12 - E);   // Subnormals drop extra bits.
+        if (shift > 64) return x.s ? -0.0 : 0.0;
+        u64 mant = shift == 64 ? 0 : top >> shift;
+        u64 rem = shift == 64 ? top : top & ((1ull << shift) - 1), half = 1ull << (shift - 1);
+        if (rem > half || (rem == half && (sticky || (mant & 1)))) mant++;
+        if (E >= 1) {
+            if (mant >> 53) { mant >>= 1; E++; }
+            bits = E >= 2047 ? sign | 0x7FF0000000000000ull : sign | (u64)E << 52 | (mant & ((1ull << 52) - 1));
+        } else bits = sign | mant;   // Carry into bit 52 yields the smallest normal.
+    }
+    double d; memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
+static inline long double _sf_to_ldouble(const _sf_t* v, u32* m) {
+    int n = v->n;
+    _sf_t x = { m, v->e, v->s, n };
+    memcpy(m, v->m, (size_t)n * sizeof(u32));
+    _sf_normalize(&x);
+    if (!m[n - 1]) return 0.0L;
+    u64 top = (u64)m[n - 1] << 32 | (n > 1 ? m[n - 2] : 0);
+    if (n > 2 && _sf_any_below(m, n, 32 * (s64)n - 64)) top |= 1;
+    long double r = (long double)top;
+    s64 e = x.e + 32 * (s64)n - 64;
+    while (e > 0) { int k = e > 1000 ? 1000 : (int)e; r *= _sf_pow2(k); e -= k; if (r - r != 0) break; }
+    while (e < 0) { int k = e < -1000 ? -1000 : (int)e; r *= _sf_pow2(k); e -= k; if (r == 0) break; }
+    return x.s ? -r : r;
+}
+
+static inline int _sf_cmp(const _sf_t* a, const _sf_t* b, u32* tmp) {
+    int n = a->n;
+    u32 *am = tmp, *bm = tmp + n;
+    _sf_t x = { am, a->e, a->s, n }, y = { bm, b->e, b->s, n };
+    memcpy(am, a->m, (size_t)n * sizeof(u32)); memcpy(bm, b->m, (size_t)n * sizeof(u32));
+    _sf_normalize(&x); _sf_normalize(&y);
+    int xz = !am[n - 1], yz = !bm[n - 1];
+    if (xz && yz) return 0;
+    if (xz) return y.s ? 1 : -1;
+    if (yz) return x.s ? -1 : 1;
+    if (x.s != y.s) return x.s ? -1 : 1;
+    int mag = x.e != y.e ? (x.e < y.e ? -1 : 1) : _sf_cmp_n(am, bm, n);
+    return x.s ? -mag : mag;
+}
+
+// r = a + b (or a - b). 64 guard bits plus a sticky bit give exact rounding.
+static inline void _sf_add(_sf_t* r, const _sf_t* a, const _sf_t* b, int negate_b, u32* tmp) {
+    int n = r->n;
+    s64 P = 32 * (s64)n;
+    u32 *am = tmp, *bm = am + n;
+    _sf_t x = { am, a->e, a->s, n }, y = { bm, b->e, b->s ^ negate_b, n };
+    memcpy(am, a->m, (size_t)n * sizeof(u32)); memcpy(bm, b->m, (size_t)n * sizeof(u32));
+    _sf_normalize(&x); _sf_normalize(&y);
+    if (!bm[n - 1]) { _sf_copy(r, &x); return; }
+    if (!am[n - 1]) { _sf_copy(r, &y); return; }
+    if (y.e > x.e || (y.e == x.e && _sf_cmp_n(bm, am, n) > 0)) { _sf_t t = x; x = y; y = t; }
+
+    int L = n + 3;
+    u32 *ext = bm + n, *yy = ext + L, *sh = yy + L;
+    ext[0] = ext[1] = 0; memcpy(ext + 2, x.m, (size_t)n * sizeof(u32)); ext[L - 1] = 0;
+    sh[0] = sh[1] = 0; memcpy(sh + 2, y.m, (size_t)n * sizeof(u32));
+    s64 d = x.e - y.e;
+    int sticky;
+    if (d >= P + 64) { memset(yy, 0, (size_t)L * sizeof(u32)); sticky = 1; }
+    else { _sf_shr(yy, L, sh, n + 2, d); sticky = _sf_any_below(sh, n + 2, d); }
+    yy[0] |= (u32)sticky;
+    if (x.s == y.s) _sf_add_n(ext, yy, L); else _sf_sub_n(ext, yy, L);
+    int sign = x.s;
+    _sf_pack(r, ext, L, x.e - 64, 0);
+    r->s = r->m[n - 1] ? sign : 0;
+}
+
+// The product goes through Karatsuba directly so its scratch stays in tmp.
+static inline void _sf_mul(_sf_t* r, const _sf_t* a, const _sf_t* b, u32* tmp) {
+    int n = r->n;
+    u32 *am = tmp, *bm = am + n, *prod = bm + n;
+    _sf_t x = { am, a->e, a->s, n }, y = { bm, b->e, b->s, n };
+    memcpy(am, a->m, (size_t)n * sizeof(u32)); memcpy(bm, b->m, (size_t)n * sizeof(u32));
+    _sf_normalize(&x); _sf_normalize(&y);
+    if (!am[n - 1] || !bm[n - 1]) { _sf_zero(r); return; }
+    _sbig_mul_karatsuba(prod, am, bm, n, prod + 2 * n);
+    _sf_pack(r, prod, 2 * n, x.e + y.e, 0);
+    r->s = x.s ^ y.s;
+}
+
+// Double-precision seed for 1/sqrt(m), m in [0.5, 2), without libm.
+static inline double _sf_rsqrt_seed(double m) {
+    double y = 1.0 / m < 1.0 ? 0.85 : 1.2;
+    for (int i = 0; i < 6; i++) y = y * (1.5 - 0.5 * m * y * y);
+    return y;
+}
+
+// Top 64 mantissa bits of a normalized view as a double in [0.5, 1).
+static inline double _sf_top_unit(const _sf_t* v) {
+    int n = v->n;
+    u64 top = (u64)v->m[n - 1] << 32 | (n > 1 ? v->m[n - 2] : 0);
+    return (double)top * 0x1p-64;
+}
+
+// r = a / b. Newton reciprocal at n+1 limbs, then an exact integer fix-up so the
+// quotient is correctly rounded. Returns 0 on division by zero.
+static inline int _sf_div(_sf_t* r, const _sf_t* a, const _sf_t* b, u32* tmp) {
+    int n = r->n, w = n + 1;
+    s64 P = 32 * (s64)n;
+    u32 *A = tmp, *B = A + n;
+    _sf_t xa = { A, a->e, a->s, n }, xb = { B, b->e, b->s, n };
+    memcpy(A, a->m, (size_t)n * sizeof(u32)); memcpy(B, b->m, (size_t)n * sizeof(u32));
+    _sf_normalize(&xa); _sf_normalize(&xb);
+    if (!B[n - 1]) return 0;
+    if (!A[n - 1]) { _sf_zero(r); return 1; }
+
+    // x ~ 1/B for the integer B; each step x += x * (1 - B*x) doubles the correct bits.
+    u32 *bm = B + n, *xm = bm + w, *tm = xm + w, *om = tm + w, *am = om + w, *wk = am + w;
+    _sf_t bw = { bm, 0, 0, w }, x = { xm, 0, 0, w }, t = { tm, 0, 0, w }, one = { om, 0, 0, w }, aw = { am, 0, 0, w };
+    _sf_t B0 = { B, 0, 0, n }, A0 = { A, 0, 0, n };
+    _sf_widen(&bw, &B0); _sf_widen(&aw, &A0);
+    _sf_from_double(&one, 1.0);
+    _sf_from_double(&x, 1.0 / _sf_top_unit(&B0));
+    x.e -= P;
+    for (s64 bits = 48; bits < 32 * (s64)w; bits *= 2) {
+        _sf_mul(&t, &bw, &x, wk);
+        _sf_add(&t, &one, &t, 1, wk);
+        _sf_mul(&t, &x, &t, wk);
+        _sf_add(&x, &x, &t, 0, wk);
+    }
+    _sf_mul(&t, &aw, &x, wk);   // t ~ A / B
+
+    // Q = floor(A * 2^(P+1) / B): take the estimate, then fix it up exactly.
+    // The Newton buffers are done with, so the fix-up reuses wk.
+    int L = 2 * n + 2;
+    size_t LB = (size_t)L * sizeof(u32);
+    u32 *Q = wk, *T = Q + L, *U = T + L, *R = U + L, *Bx = R + L, *one_l = Bx + L;
+    s64 sh = t.e + P + 1;
+    if (sh >= 0) _sf_shl(Q, L, tm, w, sh); else _sf_shr(Q, L, tm, w, -sh);
+    _sf_shl(U, L, A, n, P + 1);
+    memset(Bx, 0, LB); memcpy(Bx, B, (size_t)n * sizeof(u32));
+    _sbig_mul_karatsuba(T, Q, Bx, n + 1, one_l + L);   // Fills all L = 2(n+1) limbs.
+    memset(one_l, 0, LB); one_l[0] = 1;
+    while (_sf_cmp_n(T, U, L) > 0) { _sf_sub_n(T, Bx, L); _sf_sub_n(Q, one_l, L); }
+    for (;;) {
+        memcpy(R, U, LB); _sf_sub_n(R, T, L);
+        if (_sf_cmp_n(R, Bx, L) < 0) break;
+        _sf_add_n(T, Bx, L); _sf_add_n(Q, one_l, L);
+    }
+    int sticky = _sf_bitlen(R, L) != 0;
+    _sf_pack(r, Q, n + 1, xa.e - xb.e - (P + 1), sticky);
+    r->s = xa.s ^ xb.s;
+    return 1;
+}
+
+// r = sqrt(a). Newton inverse square root at n+1 limbs, then an exact integer
+// fix-up. Returns 0 for negative input.
+static inline int _sf_sqrt(_sf_t* r, const _sf_t* a, u32* tmp) {
+    int n = r->n, w = n + 1;
+    s64 P = 32 * (s64)n;
+    u32* A = tmp;
+    _sf_t xa = { A, a->e, a->s, n };
+    memcpy(A, a->m, (size_t)n * sizeof(u32));
+    _sf_normalize(&xa);
+    if (!A[n - 1]) { _sf_zero(r); return 1; }
+    if (xa.s) return 0;
+
+    // N = A * 2^k with k >= P + 2 and (e - k) even, so sqrt(a) = sqrt(N) * 2^((e - k) / 2).
+    s64 k = P + 2 + ((xa.e - (P + 2)) & 1);
+    u32 *nm = A + n, *ym = nm + w, *tm = ym + w, *th = tm + w, *wk = th + w;
+    _sf_t xn = { nm, 0, 0, w }, y = { ym, 0, 0, w }, t = { tm, 0, 0, w }, three = { th, 0, 0, w };
+    _sf_t A0 = { A, k, 0, n };
+    _sf_widen(&xn, &A0);
+    _sf_from_double(&three, 3.0);
+    double m = _sf_top_unit(&A0);
+    s64 E = P + k;                      // N ~ m * 2^E
+    if (E & 1) { m *= 2; E--; }
+    _sf_from_double(&y, _sf_rsqrt_seed(m));
+    y.e -= E / 2;
+    for (s64 bits = 48; bits < 32 * (s64)w; bits *= 2) {
+        _sf_mul(&t, &y, &y, wk);
+        _sf_mul(&t, &xn, &t, wk);
+        _sf_add(&t, &three, &t, 1, wk);
+        _sf_mul(&y, &y, &t, wk);
+        y.e--;
+    }
+    _sf_mul(&t, &xn, &y, wk);   // t ~ sqrt(N)
+
+    int L = 2 * n + 4;
+    size_t LB = (size_t)L * sizeof(u32);
+    u32 *S = wk, *T = S + L, *Nn = T + L, *D = Nn + L, *G = D + L, *one_l = G + L;
+    if (t.e >= 0) _sf_shl(S, L, tm, w, t.e); else _sf_shr(S, L, tm, w, -t.e);
+    _sf_shl(Nn, L, A, n, k);
+    memset(T, 0, LB);
+    _sbig_mul_karatsuba(T, S, S, n + 1, one_l + L);
+    memset(one_l, 0, LB); one_l[0] = 1;
+    // While S^2 > N: S^2 -= 2S - 1, S--.
+    while (_sf_cmp_n(T, Nn, L) > 0) {
+        _sf_shl(G, L, S, L, 1); _sf_sub_n(G, one_l, L);
+        _sf_sub_n(T, G, L); _sf_sub_n(S, one_l, L);
+    }
+    // While (S+1)^2 <= N: S^2 += 2S + 1, S++.
+    for (;;) {
+        _sf_shl(G, L, S, L, 1); _sf_add_n(G, one_l, L);
+        memcpy(D, Nn, LB); _sf_sub_n(D, T, L);
+        if (_sf_cmp_n(D, G, L) < 0) break;
+        _sf_add_n(T, G, L); _sf_add_n(S, one_l, L);
+    }
+    int sticky = _sf_cmp_n(T, Nn, L) != 0;
+    _sf_pack(r, S, n + 1, (xa.e - k) / 2, sticky);
+    r->s = 0;
+    return 1;
+}
+
+#define _SF_VIEW(v, COUNT) { (v).mantissa.limbs, (v).exponent, (v).sign, COUNT }
+
+// Writes a view's exponent and sign back. The stored exponent is an s32: results
+// at or above 2^(INT32_MAX + 32n) saturate to the largest finite value, and ones
+// with an exponent below INT32_MIN shift right into range, flushing to zero.
+static inline void _sf_store(s32* exponent, s32* sign, _sf_t* v) {
+    if (!_sf_bitlen(v->m, v->n)) v->e = v->s = 0;
+    else if (v->e > INT32_MAX) { memset(v->m, 0xFF, (size_t)v->n * sizeof(u32)); v->e = INT32_MAX; }
+    else if (v->e < INT32_MIN) {
+        _sf_shr(v->m, v->n, v->m, v->n, (s64)INT32_MIN - v->e);
+        v->e = INT32_MIN;
+        if (!_sf_bitlen(v->m, v->n)) v->e = v->s = 0;
+    }
+    *exponent = (s32)v->e; *sign = v->s;
+}
+#define _SF_STORE(dst, view) _sf_store(&(dst)->exponent, &(dst)->sign, &(view))
+
+#define DEF_FLOAT(BITS, COUNT) \
+    static inline void sfloat##BITS##_normalize(sfloat##BITS *v) { \
+        _sf_t x = _SF_VIEW(*v, COUNT); _sf_normalize(&x); _SF_STORE(v, x); \
+    } \
+    static inline sfloat##BITS sfloat##BITS##_from_double(double d) { \
+        sfloat##BITS r = {0}; _sf_t x = _SF_VIEW(r, COUNT); _sf_from_double(&x, d); _SF_STORE(&r, x); return r; \
+    } \
+    static inline sfloat##BITS sfloat##BITS##_from_ldouble(long double d) { \
+        sfloat##BITS r = {0}; _sf_t x = _SF_VIEW(r, COUNT); u32 tmp[_SF_TMP(COUNT)]; \
+        _sf_from_ldouble(&x, d, tmp); _SF_STORE(&r, x); return r; \
+    } \
+    static inline double sfloat##BITS##_to_double(sfloat##BITS v) { \
+        _sf_t x = _SF_VIEW(v, COUNT); u32 tmp[COUNT]; return _sf_to_double(&x, tmp); \
+    } \
+    static inline long double sfloat##BITS##_to_ldouble(sfloat##BITS v) { \
+        _sf_t x = _SF_VIEW(v, COUNT); u32 tmp[COUNT]; return _sf_to_ldouble(&x, tmp); \
+    } \
+    static inline int sfloat##BITS##_cmp(sfloat##BITS a, sfloat##BITS b) { \
+        _sf_t x = _SF_VIEW(a, COUNT), y = _SF_VIEW(b, COUNT); u32 tmp[2 * COUNT]; return _sf_cmp(&x, &y, tmp); \
+    } \
+    static inline void sfloat##BITS##_add(sfloat##BITS *res, sfloat##BITS a, sfloat##BITS b) { \
+        _sf_t x = _SF_VIEW(a, COUNT), y = _SF_VIEW(b, COUNT), r = _SF_VIEW(*res, COUNT); \
+        u32 tmp[_SF_TMP(COUNT)]; _sf_add(&r, &x, &y, 0, tmp); _SF_STORE(res, r); \
+    } \
+    static inline void sfloat##BITS##_sub(sfloat##BITS *res, sfloat##BITS a, sfloat##BITS b) { \
+        _sf_t x = _SF_VIEW(a, COUNT), y = _SF_VIEW(b, COUNT), r = _SF_VIEW(*res, COUNT); \
+        u32 tmp[_SF_TMP(COUNT)]; _sf_add(&r, &x, &y, 1, tmp); _SF_STORE(res, r); \
+    } \
+    static inline void sfloat##BITS##_mul(sfloat##BITS *res, sfloat##BITS a, sfloat##BITS b) { \
+        _sf_t x = _SF_VIEW(a, COUNT), y = _SF_VIEW(b, COUNT), r = _SF_VIEW(*res, COUNT); \
+        u32 tmp[_SF_TMP(COUNT)]; _sf_mul(&r, &x, &y, tmp); _SF_STORE(res, r); \
+    } \
+    /* Returns 0 on division by zero (res untouched). */ \
+    static inline int sfloat##BITS##_div(sfloat##BITS *res, sfloat##BITS a, sfloat##BITS b) { \
+        _sf_t x = _SF_VIEW(a, COUNT), y = _SF_VIEW(b, COUNT), r = _SF_VIEW(*res, COUNT); \
+        u32 tmp[_SF_TMP_WIDE(COUNT)]; \
+        if (!_sf_div(&r, &x, &y, tmp)) return 0; \
+        _SF_STORE(res, r); return 1; \
+    } \
+    /* Returns 0 for negative input (res untouched). */ \
+    static inline int sfloat##BITS##_sqrt(sfloat##BITS *res, sfloat##BITS a) { \
+        _sf_t x = _SF_VIEW(a, COUNT), r = _SF_VIEW(*res, COUNT); \
+        u32 tmp[_SF_TMP_WIDE(COUNT)]; \
+        if (!_sf_sqrt(&r, &x, tmp)) return 0; \
+        _SF_STORE(res, r); return 1; \
+    }
+
+DEF_FLOAT(32, 1)    DEF_FLOAT(64, 2)    DEF_FLOAT(128, 4)
+DEF_FLOAT(256, 8)   DEF_FLOAT(512, 16)  DEF_FLOAT(1024, 32)
+DEF_FLOAT(2048, 64) DEF_FLOAT(4096, 128) DEF_FLOAT(8192, 256)
+DEF_FLOAT(12288, 384)
+
+// --- GCD & Modular Inverse ---
+// The limb helpers take the width so each DEF_GCD wrapper inlines them with a
+// constant COUNT. Lengths are tracked so shrinking remainders get cheaper.
+static inline int _gcd_len(const u32* a, int n) { while (n > 0 && !a[n - 1]) n--; return n; }
+
+static inline s64 _gcd_ctz(const u32* a, int n) {
+    for (int i = 0; i < n; i++) if (a[i]) return (s64)i * 32 + __builtin_ctz(a[i]);
+    return 0;
+}
+
+static inline int _gcd_cmp(const u32* a, int al, const u32* b, int bl) {
+    if (al != bl) return al < bl ? -1 : 1;
+    return _sf_cmp_n(a, b, al);
+}
+
+// a[al] -= b[bl], requires a >= b.
+static inline void _gcd_sub(u32* a, int al, const u32* b, int bl) {
+    u64 br = 0;
+    for (int i = 0; i < al; i++) {
+        u64 d = (u64)a[i] - (i < bl ? b[i] : 0) - br;
+        a[i] = (u32)d; br = (d >> 63) & 1;
+        if (i >= bl && !br) break;
+    }
+}
+
+static inline u64 _gcd_u64(u64 x, u64 y) {   // Both odd.
+    while (x != y) {
+        if (x > y) { x -= y; x >>= __builtin_ctzll(x); }
+        else { y -= x; y >>= __builtin_ctzll(y); }
+    }
+    return x;
+}
+
+// Binary GCD (Stein): strip the common twos, then subtract and shift.
+// Once both values fit in 64 bits the loop finishes in registers.
+static inline void _gcd_binary(u32* r, const u32* a, const u32* b, int n) {
+    u32 ub[n], vb[n];
+    u32 *u = ub, *v = vb;
+    memcpy(ub, a, (size_t)n * sizeof(u32)); memcpy(vb, b, (size_t)n * sizeof(u32));
+    int ul = _gcd_len(u, n), vl = _gcd_len(v, n);
+    if (!ul || !vl) { memcpy(r, ul ? a : b, (size_t)n * sizeof(u32)); return; }
+    s64 zu = _gcd_ctz(u, ul), zv = _gcd_ctz(v, vl), k = zu < zv ? zu : zv;
+    _sf_shr(u, ul, u, ul, zu); ul = _gcd_len(u, ul);
+    _sf_shr(v, vl, v, vl, zv); vl = _gcd_len(v, vl);
+    for (;;) {
+        if (ul <= 2 && vl <= 2) {
+            u64 x = _gcd_u64((u64)(ul > 1 ? u[1] : 0) << 32 | u[0], (u64)(vl > 1 ? v[1] : 0) << 32 | v[0]);
+            u[0] = (u32)x; ul = 1;
+            if (n > 1) { u[1] = (u32)(x >> 32); ul = 2; }
+            break;
+        }
+        int c = _gcd_cmp(u, ul, v, vl);
+        if (c == 0) break;
+        if (c < 0) { u32* t = u; u = v; v = t; int tl = ul; ul = vl; vl = tl; }
+        _gcd_sub(u, ul, v, vl);
+        ul = _gcd_len(u, ul);
+        _sf_shr(u, ul, u, ul, _gcd_ctz(u, ul));
+        ul = _gcd_len(u, ul);
+    }
+    memset(r, 0, (size_t)n * sizeof(u32));
+    memcpy(r, u, (size_t)ul * sizeof(u32));
+    _sf_shl(r, n, r, n, k);
+}
+
+// out[n] = A * a + B * b for a Lehmer cofactor pair of opposite signs; the caller
+// knows the result is non-negative and fits. With add set, out = |A| a + |B| b.
+static inline void _gcd_lincomb(u32* out, const u32* a, s64 A, const u32* b, s64 B, int n, int add) {
+    u64 ma = A < 0 ? 0 - (u64)A : (u64)A, mb = B < 0 ? 0 - (u64)B : (u64)B;
+    u32 fa[2] = { (u32)ma, (u32)(ma >> 32) }, fb[2] = { (u32)mb, (u32)(mb >> 32) };
+    u32 x[n + 2], y[n + 2];
+    memset(x, 0, sizeof(x)); memset(y, 0, sizeof(y));
+    _sbig_mul_raw(x, a, n, fa, 2);
+    _sbig_mul_raw(y, b, n, fb, 2);
+    if (add) _sf_add_n(x, y, n);
+    else if (B <= 0) _sf_sub_n(x, y, n);
+    else { _sf_sub_n(y, x, n); memcpy(x, y, (size_t)n * sizeof(u32)); }
+    memcpy(out, x, (size_t)n * sizeof(u32));
+}
+
+// q[n], r[n] = a / b, a % b for b != 0, with stack scratch.
+static inline void _gcd_divmod(u32* q, u32* r, const u32* a, const u32* b, int n) {
+    int al = _gcd_len(a, n), bl = _gcd_len(b, n);
+    if (q) memset(q, 0, (size_t)n * sizeof(u32));
+    if (al < bl) { memmove(r, a, (size_t)n * sizeof(u32)); return; }
+    if (bl == 1) {
+        u64 rem = 0, d = b[0];
+        for (int i = al - 1; i >= 0; i--) {
+            u64 cur = (rem << 32) | a[i];
+            if (q) q[i] = (u32)(cur / d);
+            rem = cur % d;
+        }
+        memset(r, 0, (size_t)n * sizeof(u32)); r[0] = (u32)rem;
+        return;
+    }
+    u32 un[al + 1], vn[bl], rr[bl];
+    _sbig_divmod_raw(q, rr, a, al, b, bl, un, vn);
+    memset(r, 0, (size_t)n * sizeof(u32));
+    memcpy(r, rr, (size_t)bl * sizeof(u32));
+}
+
+// Top 62 bits of r0 and the matching bits of r1 (same shift).
+static inline void _gcd_lead(const u32* r0, const u32* r1, int len, u64* x, u64* y) {
+    s64 bits = _sf_bitlen(r0, len), sh = bits > 62 ? bits - 62 : 0;
+    u32 t[2];
+    _sf_shr(t, 2, r0, len, sh); *x = (u64)t[1] << 32 | t[0];
+    _sf_shr(t, 2, r1, len, sh); *y = (u64)t[1] << 32 | t[0];
+}
+
+// Lehmer's GCD on r0 >= r1 (both n limbs, overwritten); r0 ends as the gcd.
+// When t0/t1 are given they hold cofactor magnitudes: t_next = t_prev + q * t_cur.
+// Returns the number of Euclid steps taken, whose parity fixes the cofactor signs.
+static inline s64 _gcd_lehmer(u32* r0, u32* r1, u32* t0, u32* t1, int n) {
+    u32 na[n], nb[n];
+    s64 steps = 0;
+    int len = _gcd_len(r0, n);
+    while (_gcd_len(r1, len)) {
+        u64 x, y;
+        _gcd_lead(r0, r1, len, &x, &y);
+        // Knuth's Algorithm L: run Euclid on the leading bits while the
+        // quotient is the same for both ends of the uncertainty interval.
+        s64 A = 1, B = 0, C = 0, D = 1, k = 0, sx = (s64)x, sy = (s64)y;
+        while (sy + C > 0 && sy + D > 0) {
+            s64 q = (sx + A) / (sy + C);
+            if (q != (sx + B) / (sy + D)) break;
+            s64 T = A - q * C; A = C; C = T;
+            T = B - q * D; B = D; D = T;
+            T = sx - q * sy; sx = sy; sy = T;
+            k++;
+        }
+        if (B == 0) {
+            // No usable digit: take one full division step.
+            u32 q[n];
+            _gcd_divmod(t0 ? q : NULL, na, r0, r1, n);
+            memcpy(r0, r1, (size_t)n * sizeof(u32));
+            memcpy(r1, na, (size_t)n * sizeof(u32));
+            if (t0) {
+                u32 p[2 * n];
+                memset(p, 0, sizeof(p));
+                int ql = _gcd_len(q, n), tl = _gcd_len(t1, n);
+                if (ql && tl) _sbig_mul_raw(p, q, ql, t1, tl);
+                _sf_add_n(p, t0, n);
+                memcpy(t0, t1, (size_t)n * sizeof(u32));
+                memcpy(t1, p, (size_t)n * sizeof(u32));
+            }
+            steps++;
+        } else {
+            _gcd_lincomb(na, r0, A, r1, B, len, 0);
+            _gcd_lincomb(nb, r0, C, r1, D, len, 0);
+            memcpy(r0, na, (size_t)len * sizeof(u32));
+            memcpy(r1, nb, (size_t)len * sizeof(u32));
+            if (t0) {
+                _gcd_lincomb(na, t0, A, t1, B, n, 1);
+                _gcd_lincomb(nb, t0, C, t1, D, n, 1);
+                memcpy(t0, na, (size_t)n * sizeof(u32));
+                memcpy(t1, nb, (size_t)n * sizeof(u32));
+            }
+            steps += k;
+        }
+        len = _gcd_len(r0, len);
+    }
+    return steps;
+}
+
+static inline void _gcd_lehmer_gcd(u32* r, const u32* a, const u32* b, int n) {
+    u32 r0[n], r1[n];
+    int swap = _gcd_cmp(a, n, b, n) < 0;
+    memcpy(r0, swap ? b : a, (size_t)n * sizeof(u32));
+    memcpy(r1, swap ? a : b, (size_t)n * sizeof(u32));
+    _gcd_lehmer(r0, r1, NULL, NULL, n);
+    memcpy(r, r0, (size_t)n * sizeof(u32));
+}
+
+// r = a^-1 mod m. Extended Lehmer on (m, a mod m) tracking only a's cofactor.
+static inline int _gcd_modinv(u32* r, const u32* a, const u32* m, int n) {
+    int ml = _gcd_len(m, n);
+    if (!ml) return 0;
+    if (ml == 1 && m[0] == 1) { memset(r, 0, (size_t)n * sizeof(u32)); return 1; }
+    u32 r0[n], r1[n], t0[n], t1[n];
+    memcpy(r0, m, (size_t)n * sizeof(u32));
+    _gcd_divmod(NULL, r1, a, m, n);
+    memset(t0, 0, sizeof(t0)); memset(t1, 0, sizeof(t1)); t1[0] = 1;
+    // r0 has index 0 (cofactor 0), r1 index 1 (cofactor +1); signs alternate from there.
+    s64 steps = _gcd_lehmer(r0, r1, t0, t1, n);
+    if (_gcd_len(r0, n) != 1 || r0[0] != 1) return 0;
+    // The gcd sits at index `steps`; odd indices carry positive cofactors.
+    if (steps & 1) memcpy(r, t0, (size_t)n * sizeof(u32));
+    else { memcpy(r, m, (size_t)n * sizeof(u32)); _sf_sub_n(r, t0, n); }
+    return 1;
+}
+
+#define DEF_GCD(BITS, COUNT) \
+    static inline void suint##BITS##_gcd_binary(suint##BITS *res, suint##BITS a, suint##BITS b) { _gcd_binary(res->limbs, a.limbs, b.limbs, COUNT); } \
+    static inline void suint##BITS##_gcd(suint##BITS *res, suint##BITS a, suint##BITS b) { _gcd_lehmer_gcd(res->limbs, a.limbs, b.limbs, COUNT); } \
+    /* Returns 0 (res untouched) when gcd(a, m) != 1 or m == 0. */ \
+    static inline int suint##BITS##_modinv(suint##BITS *res, suint##BITS a, suint##BITS m) { return _gcd_modinv(res->limbs, a.limbs, m.limbs, COUNT); }
+
+DEF_GCD(32, 1)    DEF_GCD(64, 2)    DEF_GCD(128, 4)
+DEF_GCD(256, 8)   DEF_GCD(512, 16)  DEF_GCD(1024, 32)
+DEF_GCD(2048, 64) DEF_GCD(4096, 128) DEF_GCD(8192, 256)
+DEF_GCD(12288, 384)
+
+// --- Hash Map (Swiss Table) ---
+// DEF_MAP(NAME, K, V, HASH, EQ) defines NAME, an open-addressing map from K to
+// V. HASH(key) returns a u64 and EQ(a, b) is nonzero for equal keys. Each slot
+// has a control byte: EMPTY, DELETED, or 7 bits of the key's hash. A probe
+// compares 16 control bytes at once and reads keys only on a hash match. The
+// first 16 control bytes are mirrored after the last, so a group can start at
+// any slot. Tables have a power-of-two capacity and grow at 7/8 load.
+
+#define MAP_EMPTY   ((s8)-128)
+#define MAP_DELETED ((s8)-2)
+#define MAP_GROUP   16
+
+#if defined(_TYPES_X86_SIMD) && defined(__SSE2__)
+    #define _MAP_SSE2 1
+#endif
+
+// Bit i is set when g[i] == h.
+static inline u32 _map_match(const s8* g, s8 h) {
+#ifdef _MAP_SSE2
+    return (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)g), _mm_set1_epi8(h)));
+#else
+    u32 m = 0;
+    for (int i = 0; i < MAP_GROUP; i++) m |= (u32)(g[i] == h) << i;
+    return m;
+#endif
+}
+
+// EMPTY or DELETED: the only control values with the sign bit set.
+static inline u32 _map_match_free(const s8* g) {
+#ifdef _MAP_SSE2
+    return (u32)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)g));
+#else
+    u32 m = 0;
+    for (int i = 0; i < MAP_GROUP; i++) m |= (u32)(g[i] < 0) << i;
+    return m;
+#endif
+}
+
+static inline size_t _map_max_load(size_t cap) { return cap - cap / 8; }
+
+// Smallest capacity that holds n entries without growing.
+static inline size_t _map_cap_for(size_t n) {
+    size_t cap = MAP_GROUP;
+    while (_map_max_load(cap) < n) cap *= 2;
+    return cap;
+}
+
+// Key hashes. Integers go through the murmur3 finalizer so that keys sharing
+// low bits (pointers, multiples of 2^k) still spread over slots and control bytes.
+static inline u64 map_hash_u64(u64 k) {
+    k ^= k >> 33; k *= 0xFF51AFD7ED558CCDULL;
+    k ^= k >> 33; k *= 0xC4CEB9FE1A85EC53ULL;
+    return k ^ (k >> 33);
+}
+
+static inline int map_eq_u64(u64 a, u64 b) { return a == b; }
+
+static inline u64 _map_mix(u64 a, u64 b) {
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef unsigned __int128 _map_u128;
+    _map_u128 r = (_map_u128)a * b;
+    return (u64)r ^ (u64)(r >> 64);
+#else
+    u64 ll = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF), lh = (a & 0xFFFFFFFF) * (b >> 32);
+    u64 hl = (a >> 32) * (b & 0xFFFFFFFF), hh = (a >> 32) * (b >> 32);
+    u64 mid = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+    return ((ll & 0xFFFFFFFF) | (mid << 32)) ^ (hh + (lh >> 32) + (hl >> 32) + (mid >> 32));
+#endif
+}
+
+static inline u64 _map_r64(const u8* p) { u64 v; memcpy(&v, p, 8); return v; }
+static inline u64 _map_r32(const u8* p) { u32 v; memcpy(&v, p, 4); return v; }
+
+// Byte strings, 16 bytes per multiply (wyhash-style).
+static inline u64 map_hash_bytes(const void* data, size_t n) {
+    const u8* p = (const u8*)data;
+    const u64 s0 = 0xA0761D6478BD642FULL, s1 = 0xE7037ED1A0B428DBULL;
+    u64 h = s0, a, b;
+    if (n <= 16) {
+        if (n >= 4) {
+            size_t q = (n >> 3) << 2;
+            a = _map_r32(p) << 32 | _map_r32(p + q);
+            b = _map_r32(p + n - 4) << 32 | _map_r32(p + n - 4 - q);
+        } else if (n) {
+            a = (u64)p[0] << 16 | (u64)p[n >> 1] << 8 | p[n - 1];
+            b = 0;
+        } else a = b = 0;
+    } else {
+        size_t i = n;
+        for (; i > 16; i -= 16, p += 16) h = _map_mix(_map_r64(p) ^ s1, _map_r64(p + 8) ^ h);
+        a = _map_r64(p + i - 16);
+        b = _map_r64(p + i - 8);
+    }
+    return _map_mix(s1 ^ n, _map_mix(a ^ s1, b ^ h));
+}
+
+static inline u64 map_hash_str(const char* s) { return map_hash_bytes(s, strlen(s)); }
+static inline int map_eq_str(const char* a, const char* b) { return strcmp(a, b) == 0; }
+
+#define DEF_MAP(NAME, K, V, HASH, EQ) \
+    typedef struct { K key; V val; } NAME##_entry; \
+    typedef struct { \
+        s8* ctrl;             /* cap + MAP_GROUP control bytes, then the slots, in one allocation */ \
+        NAME##_entry* slots; \
+        size_t cap, len; \
+        size_t growth_left;   /* EMPTY slots that may still be filled before a rehash */ \
+    } NAME; \
+    \
+    static inline void NAME##_init(NAME* m) { memset(m, 0, sizeof(*m)); } \
+    static inline void NAME##_free(NAME* m) { QOL_FREE(m->ctrl); memset(m, 0, sizeof(*m)); } \
+    static inline void NAME##_clear(NAME* m) { \
+        if (!m->cap) return; \
+        memset(m->ctrl, MAP_EMPTY, m->cap + MAP_GROUP); \
+        m->len = 0; \
+        m->growth_left = _map_max_load(m->cap); \
+    } \
+    static inline void _##NAME##_set_ctrl(NAME* m, size_t i, s8 c) { \
+        m->ctrl[i] = c; \
+        if (i < MAP_GROUP) m->ctrl[m->cap + i] = c; \
+    } \
+    /* Slot index of key, or (size_t)-1. Probes groups at triangular offsets until one has an EMPTY. */ \
+    static inline size_t _##NAME##_find(const NAME* m, K key, u64 h) { \
+        if (!m->cap) return (size_t)-1; \
+        size_t mask = m->cap - 1, pos = (size_t)(h >> 7) & mask, step = 0; \
+        for (;;) { \
+            const s8* g = m->ctrl + pos; \
+            for (u32 hit = _map_match(g, (s8)(h & 0x7F)); hit; hit &= hit - 1) { \
+                size_t i = (pos + (size_t)__builtin_ctz(hit)) & mask; \
+                if (EQ(m->slots[i].key, key)) return i; \
+            } \
+            if (_map_match(g, MAP_EMPTY)) return (size_t)-1; \
+            step += MAP_GROUP; \
+            pos = (pos + step) & mask; \
+        } \
+    } \
+    static inline size_t _##NAME##_free_slot(const NAME* m, u64 h) { \
+        size_t mask = m->cap - 1, pos = (size_t)(h >> 7) & mask, step = 0; \
+        for (;;) { \
+            u32 f = _map_match_free(m->ctrl + pos); \
+            if (f) return (pos + (size_t)__builtin_ctz(f)) & mask; \
+            step += MAP_GROUP; \
+            pos = (pos + step) & mask; \
+        } \
+    } \
+    /* Moves every entry into a fresh table of cap slots, dropping tombstones. */ \
+    static inline int _##NAME##_rehash(NAME* m, size_t cap) { \
+        NAME t; \
+        size_t ctrl_bytes = _QOL_ALIGN(cap + MAP_GROUP); \
+        u8* mem = (u8*)QOL_MALLOC(ctrl_bytes + cap * sizeof(NAME##_entry)); \
+        if (!mem) return 0; \
+        t.ctrl = (s8*)mem; \
+        t.slots = (NAME##_entry*)(mem + ctrl_bytes); \
+        t.cap = cap; \
+        t.len = m->len; \
+        t.growth_left = _map_max_load(cap) - m->len; \
+        memset(t.ctrl, MAP_EMPTY, cap + MAP_GROUP); \
+        for (size_t g = 0; g < m->cap; g += MAP_GROUP) { \
+            for (u32 full = ~_map_match_free(m->ctrl + g) & 0xFFFF; full; full &= full - 1) { \
+                size_t i = g + (size_t)__builtin_ctz(full); \
+                u64 h = HASH(m->slots[i].key); \
+                size_t j = _##NAME##_free_slot(&t, h); \
+                _##NAME##_set_ctrl(&t, j, (s8)(h & 0x7F)); \
+                t.slots[j] = m->slots[i]; \
+            } \
+        } \
+        QOL_FREE(m->ctrl); \
+        *m = t; \
+        return 1; \
+    } \
+    /* Makes room for n entries in total. Returns 0 on allocation failure. */ \
+    static inline int NAME##_reserve(NAME* m, size_t n) { \
+        size_t cap = _map_cap_for(n); \
+        return cap <= m->cap || _##NAME##_rehash(m, cap); \
+    } \
+    static inline V* NAME##_get(const NAME* m, K key) { \
+        size_t i = _##NAME##_find(m, key, HASH(key)); \
+        return i == (size_t)-1 ? NULL : &m->slots[i].val; \
+    } \
+    static inline int NAME##_has(const NAME* m, K key) { return _##NAME##_find(m, key, HASH(key)) != (size_t)-1; } \
+    /* Value slot for key, adding the key if absent (its value is then uninitialized and *inserted = 1). */ \
+    /* NULL on allocation failure. */ \
+    static inline V* NAME##_emplace(NAME* m, K key, int* inserted) { \
+        u64 h = HASH(key); \
+        size_t i = _##NAME##_find(m, key, h); \
+        if (inserted) *inserted = 0; \
+        if (i != (size_t)-1) return &m->slots[i].val; \
+        if (!m->growth_left) { \
+            /* Full of live entries: double. Mostly tombstones: rebuild at the same size. */ \
+            size_t cap = m->cap ? m->cap : MAP_GROUP; \
+            if (m->len >= _map_max_load(cap) / 2) cap *= 2; \
+            if (!_##NAME##_rehash(m, cap)) return NULL; \
+        } \
+        i = _##NAME##_free_slot(m, h); \
+        if (m->ctrl[i] == MAP_EMPTY) m->growth_left--; \
+        _##NAME##_set_ctrl(m, i, (s8)(h & 0x7F)); \
+        m->slots[i].key = key; \
+        m->len++; \
+        if (inserted) *inserted = 1; \
+        return &m->slots[i].val; \
+    } \
+    /* Inserts or overwrites. Returns 0 on allocation failure. */ \
+    static inline int NAME##_put(NAME* m, K key, V val) { \
+        V* v = NAME##_emplace(m, key, NULL); \
+        if (!v) return 0; \
+        *v = val; \
+        return 1; \
+    } \
+    /* Returns 1 if key was present. A slot that no probe can have passed over */ \
+    /* (an EMPTY within 16 slots on both sides) becomes EMPTY again, not DELETED. */ \
+    static inline int NAME##_erase(NAME* m, K key) { \
+        size_t i = _##NAME##_find(m, key, HASH(key)); \
+        if (i == (size_t)-1) return 0; \
+        u32 before = _map_match(m->ctrl + ((i - MAP_GROUP) & (m->cap - 1)), MAP_EMPTY); \
+        u32 after = _map_match(m->ctrl + i, MAP_EMPTY); \
+        if (before && after && (__builtin_clz(before) - 16) + __builtin_ctz(after) < MAP_GROUP) { \
+            _##NAME##_set_ctrl(m, i, MAP_EMPTY); \
+            m->growth_left++; \
+        } else _##NAME##_set_ctrl(m, i, MAP_DELETED); \
+        m->len--; \
+        return 1; \
+    } \
+    /* Iteration: size_t it = 0; NAME##_entry* e; while ((e = NAME##_next(&m, &it))) ... */ \
+    /* Erasing during iteration is fine; inserting may rehash and invalidate it. */ \
+    static inline NAME##_entry* NAME##_next(NAME* m, size_t* it) { \
+        for (size_t i = *it; i < m->cap; i += MAP_GROUP) { \
+            u32 full = ~_map_match_free(m->ctrl + i) & 0xFFFF; \
+            if (m->cap - i < MAP_GROUP) full &= (1u << (m->cap - i)) - 1; \
+            if (full) { \
+                i += (size_t)__builtin_ctz(full); \
+                *it = i + 1; \
+                return &m->slots[i]; \
+            } \
+        } \
+        *it = m->cap; \
+        return NULL; \
+    }
+
+// Integer keys, and NUL-terminated string keys. String keys are stored as
+// pointers, not copied: they must stay valid while they are in the map.
+#define DEF_MAP_U64(NAME, V) DEF_MAP(NAME, u64, V, map_hash_u64, map_eq_u64)
+#define DEF_MAP_STR(NAME, V) DEF_MAP(NAME, const char*, V, map_hash_str, map_eq_str)
+
+// --- Sorting & Search ---
+// DEF_SORT(NAME, T, LESS) defines NAME_sort, a pattern-defeating quicksort
+// (pdqsort) with LESS(a, b) inlined instead of called through a pointer, plus
+// branchless binary searches and a parallel sample sort. DEF_RADIX and
+// DEF_RADIX_STR add radix sorts for integer and string keys.
+
+#ifndef SORT_INSERTION
+#define SORT_INSERTION 24        // Ranges below this are insertion sorted.
+#endif
+#ifndef SORT_NINTHER
+#define SORT_NINTHER 128         // Ranges above this take a median of medians as pivot.
+#endif
+#ifndef SORT_PARALLEL_MIN
+#define SORT_PARALLEL_MIN 65536  // Smaller arrays are not worth spawning threads for.
+#endif
+#define SORT_BLOCK 64            // Elements classified per side before swapping.
+#define SORT_OVERSAMPLE 32       // Samples per bucket when choosing splitters.
+
+#if defined(__GNUC__)
+    #define _SORT_PREFETCH(p) __builtin_prefetch(p)
+#else
+    #define _SORT_PREFETCH(p) ((void)0)
+#endif
+
+#ifdef SBIG_THREADS
+    #define _SORT_THREADED 1
+#else
+    #define _SORT_THREADED 0
+#endif
+
+// Runs fn(ctx, j, j + 1) for each j < jobs (at most 64), one thread per job
+// when built with -DSBIG_THREADS.
+static inline void _sort_jobs(_sbig_range_fn fn, void* ctx, int jobs) {
+#ifdef SBIG_THREADS
+    _sbig_job job[64];
+    int started[64] = {0};
+    #ifdef _WIN32
+    HANDLE th[64];
+    #else
+    pthread_t th[64];
+    #endif
+    for (int i = 1; i < jobs; i++) {
+        job[i].fn = fn; job[i].ctx = ctx; job[i].lo = i; job[i].hi = i + 1;
+    #ifdef _WIN32
+        started[i] = (th[i] = CreateThread(NULL, 0, _sbig_job_entry, &job[i], 0, NULL)) != NULL;
+    #else
+        started[i] = pthread_create(&th[i], NULL, _sbig_job_entry, &job[i]) == 0;
+    #endif
+        if (!started[i]) fn(ctx, i, i + 1);
+    }
+    fn(ctx, 0, 1);
+    for (int i = 1; i < jobs; i++) {
+        if (!started[i]) continue;
+    #ifdef _WIN32
+        WaitForSingleObject(th[i], INFINITE); CloseHandle(th[i]);
+    #else
+        pthread_join(th[i], NULL);
+    #endif
+    }
+#else
+    fn(ctx, 0, jobs);
+#endif
+}
+
+#define DEF_SORT(NAME, T, LESS) \
+    /* Insertion sorts. The unguarded one relies on an element before a that is */ \
+    /* not greater than any in [a, a + n), which pdqsort guarantees off the left edge. */ \
+    static inline void _##NAME##_insertion(T* a, size_t n) { \
+        for (size_t i = 1; i < n; i++) { \
+            if (!LESS(a[i], a[i - 1])) continue; \
+            T tmp = a[i]; \
+            size_t j = i; \
+            do { a[j] = a[j - 1]; j--; } while (j > 0 && LESS(tmp, a[j - 1])); \
+            a[j] = tmp; \
+        } \
+    } \
+    static inline void _##NAME##_insertion_unguarded(T* a, size_t n) { \
+        for (size_t i = 1; i < n; i++) { \
+            if (!LESS(a[i], a[i - 1])) continue; \
+            T tmp = a[i]; \
+            T* p = a + i; \
+            do { *p = p[-1]; p--; } while (LESS(tmp, p[-1])); \
+            *p = tmp; \
+        } \
+    } \
+    /* Gives up (returns 0) after moving more than 8 elements. */ \
+    static inline int _##NAME##_insertion_partial(T* a, size_t n) { \
+        size_t moved = 0; \
+        for (size_t i = 1; i < n; i++) { \
+            if (moved > 8) return 0; \
+            if (!LESS(a[i], a[i - 1])) continue; \
+            T tmp = a[i]; \
+            size_t j = i; \
+            do { a[j] = a[j - 1]; j--; } while (j > 0 && LESS(tmp, a[j - 1])); \
+            a[j] = tmp; \
+            moved += i - j; \
+        } \
+        return 1; \
+    } \
+    static inline void _##NAME##_swap(T* x, T* y) { T t = *x; *x = *y; *y = t; } \
+    static inline void _##NAME##_sort2(T* x, T* y) { if (LESS(*y, *x)) _##NAME##_swap(x, y); } \
+    static inline void _##NAME##_sort3(T* x, T* y, T* z) { \
+        _##NAME##_sort2(x, y); _##NAME##_sort2(y, z); _##NAME##_sort2(x, y); \
+    } \
+    static inline void _##NAME##_sift(T* a, size_t i, size_t n) { \
+        T v = a[i]; \
+        for (size_t c; (c = 2 * i + 1) < n; i = c) { \
+            if (c + 1 < n && LESS(a[c], a[c + 1])) c++; \
+            if (!LESS(v, a[c])) break; \
+            a[i] = a[c]; \
+        } \
+        a[i] = v; \
+    } \
+    static inline void _##NAME##_heapsort(T* a, size_t n) { \
+        for (size_t i = n / 2; i-- > 0;) _##NAME##_sift(a, i, n); \
+        for (size_t i = n; i-- > 1;) { _##NAME##_swap(a, a + i); _##NAME##_sift(a, 0, i); } \
+    } \
+    /* Elements equal to the pivot a[0] go left; returns the pivot's final index. */ \
+    /* Used when the pivot equals the element before the range, so it cannot recur. */ \
+    static inline size_t _##NAME##_partition_left(T* a, size_t n) { \
+        T pivot = a[0]; \
+        T* first = a; T* last = a + n; \
+        while (LESS(pivot, *--last)); \
+        if (last + 1 == a + n) while (first < last && !LESS(pivot, *++first)); \
+        else while (!LESS(pivot, *++first)); \
+        while (first < last) { \
+            _##NAME##_swap(first, last); \
+            while (LESS(pivot, *--last)); \
+            while (!LESS(pivot, *++first)); \
+        } \
+        a[0] = *last; \
+        *last = pivot; \
+        return (size_t)(last - a); \
+    } \
+    /* Elements less than the pivot a[0] go left. Out-of-place elements are found */ \
+    /* a block at a time into offset buffers with no data-dependent branch, then */ \
+    /* swapped in pairs. Sets *sorted when no element had to move. */ \
+    static inline size_t _##NAME##_partition_right(T* a, size_t n, int* sorted) { \
+        T pivot = a[0]; \
+        T* first = a; T* last = a + n; \
+        while (LESS(*++first, pivot)); \
+        if (first - 1 == a) while (first < last && !LESS(*--last, pivot)); \
+        else while (!LESS(*--last, pivot)); \
+        *sorted = first >= last; \
+        if (!*sorted) { \
+            unsigned char off_l[SORT_BLOCK], off_r[SORT_BLOCK]; \
+            T* base_l; T* base_r; \
+            size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0; \
+            _##NAME##_swap(first, last); \
+            first++; \
+            base_l = first; base_r = last; \
+            while (first < last) { \
+                size_t unknown = (size_t)(last - first); \
+                size_t split_l = num_l == 0 ? (num_r == 0 ? unknown / 2 : unknown) : 0; \
+                size_t split_r = num_r == 0 ? unknown - split_l : 0; \
+                if (split_l > SORT_BLOCK) split_l = SORT_BLOCK; \
+                if (split_r > SORT_BLOCK) split_r = SORT_BLOCK; \
+                for (size_t i = 0; i < split_l; i++) { \
+                    off_l[num_l] = (unsigned char)i; \
+                    num_l += !LESS(*first, pivot); \
+                    first++; \
+                } \
+                for (size_t i = 0; i < split_r;) { \
+                    off_r[num_r] = (unsigned char)++i; \
+                    num_r += LESS(*--last, pivot); \
+                } \
+                size_t num = num_l < num_r ? num_l : num_r; \
+                if (num) { \
+                    /* A cycle through both sides moves each element once instead of swapping. */ \
+                    T* l = base_l + off_l[start_l]; \
+                    T* r = base_r - off_r[start_r]; \
+                    T tmp = *l; \
+                    *l = *r; \
+                    for (size_t i = 1; i < num; i++) { \
+                        l = base_l + off_l[start_l + i]; *r = *l; \
+                        r = base_r - off_r[start_r + i]; *l = *r; \
+                    } \
+                    *r = tmp; \
+                } \
+                num_l -= num; num_r -= num; \
+                start_l += num; start_r += num; \
+                if (num_l == 0) { start_l = 0; base_l = first; } \
+                if (num_r == 0) { start_r = 0; base_r = last; } \
+            } \
+            if (num_l) { \
+                while (num_l--) _##NAME##_swap(base_l + off_l[start_l + num_l], --last); \
+                first = last; \
+            } \
+            if (num_r) { \
+                while (num_r--) { _##NAME##_swap(base_r - off_r[start_r + num_r], first); first++; } \
+            } \
+        } \
+        T* pos = first - 1; \
+        a[0] = *pos; \
+        *pos = pivot; \
+        return (size_t)(pos - a); \
+    } \
+    static inline void _##NAME##_pdq(T* a, size_t n, int bad_allowed, int leftmost) { \
+        for (;;) { \
+            if (n < SORT_INSERTION) { \
+                if (leftmost) _##NAME##_insertion(a, n); \
+                else _##NAME##_insertion_unguarded(a, n); \
+                return; \
+            } \
+            size_t h = n / 2; \
+            if (n > SORT_NINTHER) { \
+                _##NAME##_sort3(a, a + h, a + n - 1); \
+                _##NAME##_sort3(a + 1, a + h - 1, a + n - 2); \
+                _##NAME##_sort3(a + 2, a + h + 1, a + n - 3); \
+                _##NAME##_sort3(a + h - 1, a + h, a + h + 1); \
+                _##NAME##_swap(a, a + h); \
+            } else _##NAME##_sort3(a + h, a, a + n - 1); \
+            /* Pivot equal to the element before the range: everything equal to it */ \
+            /* is in place, so skip past the run instead of recursing on it. */ \
+            if (!leftmost && !LESS(a[-1], a[0])) { \
+                size_t p = _##NAME##_partition_left(a, n) + 1; \
+                a += p; n -= p; \
+                continue; \
+            } \
+            int sorted; \
+            size_t p = _##NAME##_partition_right(a, n, &sorted); \
+            size_t ln = p, rn = n - p - 1; \
+            if (ln < n / 8 || rn < n / 8) { \
+                /* Bad split: fall back to heapsort after log2(n) of them, */ \
+                /* otherwise break up the pattern that caused it. */ \
+                if (--bad_allowed == 0) { _##NAME##_heapsort(a, n); return; } \
+                T* piv = a + p; \
+                if (ln >= SORT_INSERTION) { \
+                    _##NAME##_swap(a, a + ln / 4); \
+                    _##NAME##_swap(piv - 1, piv - ln / 4); \
+                    if (ln > SORT_NINTHER) { \
+                        _##NAME##_swap(a + 1, a + ln / 4 + 1); \
+                        _##NAME##_swap(a + 2, a + ln / 4 + 2); \
+                        _##NAME##_swap(piv - 2, piv - (ln / 4 + 1)); \
+                        _##NAME##_swap(piv - 3, piv - (ln / 4 + 2)); \
+                    } \
+                } \
+                if (rn >= SORT_INSERTION) { \
+                    _##NAME##_swap(piv + 1, piv + 1 + rn / 4); \
+                    _##NAME##_swap(a + n - 1, a + n - rn / 4); \
+                    if (rn > SORT_NINTHER) { \
+                        _##NAME##_swap(piv + 2, piv + 2 + rn / 4); \
+                        _##NAME##_swap(piv + 3, piv + 3 + rn / 4); \
+                        _##NAME##_swap(a + n - 2, a + n - (1 + rn / 4)); \
+                        _##NAME##_swap(a + n - 3, a + n - (2 + rn / 4)); \
+                    } \
+                } \
+            } else if (sorted && _##NAME##_insertion_partial(a, ln) && \
+                       _##NAME##_insertion_partial(a + p + 1, rn)) return; \
+            _##NAME##_pdq(a, ln, bad_allowed, leftmost); \
+            a += p + 1; n = rn; \
+            leftmost = 0; \
+        } \
+    } \
+    /* Unstable, O(n log n) worst case, linear on sorted or reversed input. */ \
+    static inline void NAME##_sort(T* a, size_t n) { \
+        int bad = 1; \
+        for (size_t m = n; m > 1; m >>= 1) bad++; \
+        _##NAME##_pdq(a, n, bad, 1); \
+    } \
+    /* First index whose element is not less than key (n if none). a must be sorted. */ \
+    /* The loop has no data-dependent branch; both possible next probes are prefetched. */ \
+    static inline size_t NAME##_lower_bound(T const* a, size_t n, T key) { \
+        if (n == 0) return 0; \
+        T const* base = a; \
+        while (n > 1) { \
+            size_t half = n / 2; \
+            _SORT_PREFETCH(base + half / 2); \
+            _SORT_PREFETCH(base + half + half / 2); \
+            base = LESS(base[half], key) ? base + half : base; \
+            n -= half; \
+        } \
+        return (size_t)(base - a) + (size_t)LESS(*base, key); \
+    } \
+    /* First index whose element is greater than key (n if none). */ \
+    static inline size_t NAME##_upper_bound(T const* a, size_t n, T key) { \
+        if (n == 0) return 0; \
+        T const* base = a; \
+        while (n > 1) { \
+            size_t half = n / 2; \
+            _SORT_PREFETCH(base + half / 2); \
+            _SORT_PREFETCH(base + half + half / 2); \
+            base = LESS(key, base[half]) ? base : base + half; \
+            n -= half; \
+        } \
+        return (size_t)(base - a) + (size_t)!LESS(key, *base); \
+    } \
+    /* Parallel sample sort: splitters from an oversampled, sorted sample cut the */ \
+    /* array into one bucket per thread; threads count, scatter, then sort their bucket. */ \
+    typedef struct { \
+        T* a; T* tmp; \
+        size_t n; \
+        int p; \
+        T* split; \
+        unsigned char* bucket; \
+        size_t* pos;   /* [job * p + bucket]: counts, then scatter positions. */ \
+        size_t* start; /* p + 1 bucket boundaries. */ \
+    } _##NAME##_ss; \
+    static inline void _##NAME##_ss_count(void* ctx, int job, int job_end) { \
+        _##NAME##_ss* s = (_##NAME##_ss*)ctx; \
+        for (; job < job_end; job++) { \
+            size_t lo = s->n * (size_t)job / (size_t)s->p, hi = s->n * (size_t)(job + 1) / (size_t)s->p; \
+            size_t* cnt = s->pos + (size_t)job * (size_t)s->p; \
+            for (size_t i = lo; i < hi; i++) { \
+                size_t b = NAME##_upper_bound(s->split, (size_t)s->p - 1, s->a[i]); \
+                s->bucket[i] = (unsigned char)b; \
+                cnt[b]++; \
+            } \
+        } \
+    } \
+    static inline void _##NAME##_ss_scatter(void* ctx, int job, int job_end) { \
+        _##NAME##_ss* s = (_##NAME##_ss*)ctx; \
+        for (; job < job_end; job++) { \
+            size_t lo = s->n * (size_t)job / (size_t)s->p, hi = s->n * (size_t)(job + 1) / (size_t)s->p; \
+            size_t* pos = s->pos + (size_t)job * (size_t)s->p; \
+            for (size_t i = lo; i < hi; i++) s->tmp[pos[s->bucket[i]]++] = s->a[i]; \
+        } \
+    } \
+    static inline void _##NAME##_ss_sort(void* ctx, int job, int job_end) { \
+        _##NAME##_ss* s = (_##NAME##_ss*)ctx; \
+        for (; job < job_end; job++) { \
+            size_t lo = s->start[job], len = s->start[job + 1] - lo; \
+            NAME##_sort(s->tmp + lo, len); \
+            memcpy(s->a + lo, s->tmp + lo, len * sizeof(T)); \
+        } \
+    } \
+    /* Sorts on up to threads threads (at most 64) with -DSBIG_THREADS; otherwise, */ \
+    /* for small arrays, or if scratch memory cannot be had, same as NAME##_sort. */ \
+    static inline void NAME##_sort_parallel(T* a, size_t n, int threads) { \
+        _##NAME##_ss s; \
+        int p = threads > 64 ? 64 : threads; \
+        if (!_SORT_THREADED || p < 2 || n < SORT_PARALLEL_MIN) { NAME##_sort(a, n); return; } \
+        size_t per = SORT_OVERSAMPLE, k = per * (size_t)p; \
+        s.a = a; s.n = n; s.p = p; \
+        s.tmp = (T*)QOL_MALLOC(n * sizeof(T)); \
+        s.split = (T*)QOL_MALLOC(k * sizeof(T)); \
+        s.bucket = (unsigned char*)QOL_MALLOC(n); \
+        s.pos = (size_t*)QOL_CALLOC((size_t)p * (size_t)p, sizeof(size_t)); \
+        s.start = (size_t*)QOL_MALLOC(((size_t)p + 1) * sizeof(size_t)); \
+        if (!s.tmp || !s.split || !s.bucket || !s.pos || !s.start) { \
+            QOL_FREE(s.tmp); QOL_FREE(s.split); QOL_FREE(s.bucket); QOL_FREE(s.pos); QOL_FREE(s.start); \
+            NAME##_sort(a, n); \
+            return; \
+        } \
+        for (size_t i = 0; i < k; i++) s.split[i] = a[(i * 2 + 1) * (n / (2 * k))]; \
+        NAME##_sort(s.split, k); \
+        for (int i = 1; i < p; i++) s.split[i - 1] = s.split[(size_t)i * per]; \
+        _sort_jobs(_##NAME##_ss_count, &s, p); \
+        size_t at = 0; \
+        for (int b = 0; b < p; b++) { \
+            s.start[b] = at; \
+            for (int j = 0; j < p; j++) { \
+                size_t c = s.pos[(size_t)j * (size_t)p + (size_t)b]; \
+                s.pos[(size_t)j * (size_t)p + (size_t)b] = at; \
+                at += c; \
+            } \
+        } \
+        s.start[p] = at; \
+        _sort_jobs(_##NAME##_ss_scatter, &s, p); \
+        _sort_jobs(_##NAME##_ss_sort, &s, p); \
+        QOL_FREE(s.tmp); QOL_FREE(s.split); QOL_FREE(s.bucket); QOL_FREE(s.pos); QOL_FREE(s.start); \
+    }
+
+#define DEF_RADIX(NAME, T, KEY) \
+    /* Stable LSD radix sort on the unsigned integer KEY(x), one byte per pass. */ \
+    /* Byte histograms come from a single read, and passes where every key has */ \
+    /* the same byte are skipped. Returns 0 if the scratch buffer cannot be had. */ \
+    static inline int NAME##_radix_sort(T* a, size_t n) { \
+        enum { _BYTES = sizeof(KEY(a[0])) }; \
+        if (n < SORT_INSERTION) { \
+            for (size_t i = 1; i < n; i++) { \
+                T tmp = a[i]; \
+                size_t j = i; \
+                while (j > 0 && KEY(tmp) < KEY(a[j - 1])) { a[j] = a[j - 1]; j--; } \
+                a[j] = tmp; \
+            } \
+            return 1; \
+        } \
+        size_t cnt[_BYTES][256]; \
+        memset(cnt, 0, sizeof(cnt)); \
+        for (size_t i = 0; i < n; i++) { \
+            u64 k = (u64)KEY(a[i]); \
+            for (int b = 0; b < _BYTES; b++) cnt[b][(k >> (8 * b)) & 255]++; \
+        } \
+        T* tmp = (T*)QOL_MALLOC(n * sizeof(T)); \
+        if (!tmp) return 0; \
+        T* src = a; T* dst = tmp; \
+        for (int b = 0; b < _BYTES; b++) { \
+            size_t* c = cnt[b]; \
+            if (c[((u64)KEY(src[0]) >> (8 * b)) & 255] == n) continue; \
+            size_t at = 0; \
+            for (int d = 0; d < 256; d++) { size_t t = c[d]; c[d] = at; at += t; } \
+            for (size_t i = 0; i < n; i++) dst[c[((u64)KEY(src[i]) >> (8 * b)) & 255]++] = src[i]; \
+            T* t = src; src = dst; dst = t; \
+        } \
+        if (src != a) memcpy(a, src, n * sizeof(T)); \
+        QOL_FREE(tmp); \
+        return 1; \
+    }
+
+#define DEF_RADIX_STR(NAME, T, STR) \
+    /* MSD radix sort on the NUL-terminated string STR(x), byte order as strcmp. */ \
+    /* Each level buckets by the byte at depth d; a level where all strings share */ \
+    /* the byte just moves on, so long common prefixes do not recurse. */ \
+    static inline void _##NAME##_msd(T* a, T* tmp, unsigned char* bytes, size_t n, size_t d) { \
+        while (n >= SORT_INSERTION) { \
+            size_t cnt[256] = {0}, end[256], at = 0; \
+            int big = 0; \
+            for (size_t i = 0; i < n; i++) cnt[bytes[i] = (unsigned char)STR(a[i])[d]]++; \
+            if (cnt[bytes[0]] == n) { \
+                if (bytes[0] == 0) return; \
+                d++; \
+                continue; \
+            } \
+            for (int c = 0; c < 256; c++) { \
+                end[c] = at; at += cnt[c]; \
+                if (cnt[c] > cnt[big]) big = c; \
+            } \
+            for (size_t i = 0; i < n; i++) tmp[end[bytes[i]]++] = a[i]; \
+            memcpy(a, tmp, n * sizeof(T)); \
+            /* Bucket 0 holds the finished strings. Recursing on all but the biggest */ \
+            /* bucket and looping on that one keeps the depth under log2(n). */ \
+            for (int c = 1; c < 256; c++) \
+                if (c != big && cnt[c] > 1) _##NAME##_msd(a + end[c] - cnt[c], tmp, bytes, cnt[c], d + 1); \
+            if (big == 0) return; \
+            a += end[big] - cnt[big]; \
+            n = cnt[big]; \
+            d++; \
+        } \
+        for (size_t i = 1; i < n; i++) { \
+            T v = a[i]; \
+            size_t j = i; \
+            while (j > 0 && strcmp(STR(v) + d, STR(a[j - 1]) + d) < 0) { a[j] = a[j - 1]; j--; } \
+            a[j] = v; \
+        } \
+    } \
+    /* Stable. Returns 0 if the scratch buffers cannot be had. */ \
+    static inline int NAME##_radix_sort(T* a, size_t n) { \
+        if (n < 2) return 1; \
+        T* tmp = (T*)QOL_MALLOC(n * sizeof(T)); \
+        unsigned char* bytes = (unsigned char*)QOL_MALLOC(n); \
+        if (!tmp || !bytes) { QOL_FREE(tmp); QOL_FREE(bytes); return 0; } \
+        _##NAME##_msd(a, tmp, bytes, n, 0); \
+        QOL_FREE(tmp); QOL_FREE(bytes); \
+        return 1; \
+    }
+
+// Ready-made comparisons for numbers and NUL-terminated strings.
+#define SORT_LESS_NUM(a, b) ((a) < (b))
+#define SORT_LESS_STR(a, b) (strcmp((a), (b)) < 0)
+#define SORT_KEY_SELF(x) (x)
+#define SORT_STR_SELF(x) (x)
+#define DEF_SORT_NUM(NAME, T) DEF_SORT(NAME, T, SORT_LESS_NUM)
+#define DEF_SORT_STR(NAME) DEF_SORT(NAME, const char*, SORT_LESS_STR)
+
+#endif
+
+
 /* Source: SimpleFS/simple_fs.h */
 #ifndef SIMPLE_FS_H
 
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+/* --- Platform Paths & Directory Headers --- */
+#ifdef _WIN32
+    #include <windows.h>
+    #include <direct.h>
+    #define PATH_SEP '\\'
+    #define ALT_SEP '/'
+    #define mkdir(path, mode) _mkdir(path)
+#else
+    #include <sys/stat.h>
+    #include <dirent.h>
+    #include <unistd.h>
+    #define PATH_SEP '/'
+    #define ALT_SEP '\\'
+#endif
+
+/* --- SIMD Dispatch --- */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__) && !defined(SIMPLE_FS_NO_SIMD)
+    #include <immintrin.h>
+    #define _FS_X86_SIMD 1
+#endif
+
+/* --- Allocation Hooks --- */
+// libc defaults; QOL_MALLOC / QOL_REALLOC / QOL_FREE and QOL_USE_ALLOC are
+// documented in simple_types.h, which must come first to route through qol_malloc.
+#if defined(QOL_USE_ALLOC) && !defined(QOL_MALLOC)
+    #error "QOL_USE_ALLOC: include simple_types.h before this header (qol_malloc lives there)"
+#endif
+#ifndef QOL_MALLOC
+    #define QOL_MALLOC(n) malloc(n)
+    #define QOL_REALLOC(p, n) realloc(p, n)
+    #define QOL_FREE(p) free(p)
+#endif
+
+/* --- Internal Path Normalizer --- */
+static inline void _fs_normalize(char* path) {
+    if (!path) return;
+    for (int i = 0; path[i]; i++) {
+        if (path[i] == ALT_SEP) path[i] = PATH_SEP;
+    }
+}
+
+/* --- Core Functions --- */
+
+static inline int char_to_int(const void *ptr, int len) {
+    uint32_t hash = 2166136261u;
+    const unsigned char *p = (const unsigned char *)ptr;
+    for (int i = 0; i < len; i++) {
+        hash ^= p[i];
+        hash *= 16777619u;
+    }
+    return (int)hash;
+}
+
+static inline float char_to_float(const void *ptr, int len) {
+    unsigned int seed = (unsigned int)char_to_int(ptr, len);
+    return (float)seed / (float)0xFFFFFFFF;
+}
+
+/* --- Wide Hashing --- */
+// qhash64 / qhash128: seeded, non-cryptographic hashes over 8-byte words.
+// Up to QHASH_SHORT bytes use a wyhash-style multiply-fold chain; longer input
+// is cut into 64-byte stripes feeding 8 independent lanes (XXH3-style), which
+// the SSE2 / AVX2 kernels process 2 or 4 lanes at a time. Every path produces
+// the same value, and so does the streaming qol_hasher.
+
+#define QHASH_SHORT 256
+#define _QH_P32 0x9E3779B1u
+#define _QH_P1 0x9E3779B185EBCA87ULL
+#define _QH_P2 0xC2B2AE3D27D4EB4FULL
+
+typedef struct { uint64_t lo, hi; } qol_hash128;
+
+// Key material for the long path: 16 stripe keys at 8-byte steps, the scramble key at 128.
+static const unsigned char _qh_secret[192] = {
+    0x3a, 0x43, 0x40, 0x86, 0xcf, 0xee, 0x91, 0x84, 0x14, 0x86, 0xcc, 0x6c, 0x15, 0x2c, 0x54, 0xee,
+    0x3d, 0x57, 0x71, 0x11, 0x29, 0xa7, 0xfa, 0x85, 0xce, 0x7f, 0xf0, 0x9c, 0x14, 0x0a, 0x4c, 0x7b,
+    0xcf, 0x8b, 0x45, 0x50, 0x1b, 0x8f, 0x11, 0xdc, 0x11, 0x2c, 0x72, 0x03, 0x8f, 0x29, 0x99, 0x5c,
+    0x85, 0xf5, 0xd9, 0x25, 0x60, 0x0b, 0x7a, 0x82, 0xce, 0xa5, 0xfe, 0x25, 0xd5, 0x11, 0x9f, 0x9a,
+    0xce, 0xcd, 0x6c, 0x47, 0x08, 0x26, 0x0e, 0x58, 0xdd, 0x24, 0x0b, 0xe1, 0x39, 0x3f, 0x9a, 0x91,
+    0xdb, 0x6e, 0xa9, 0x0c, 0x86, 0xec, 0xf9, 0xfa, 0xb9, 0x84, 0xc0, 0x7d, 0x7a, 0xd4, 0x2c, 0x1f,
+    0x12, 0xee, 0x09, 0x55, 0x80, 0x3d, 0x77, 0xeb, 0x06, 0xc0, 0xfe, 0x2d, 0x57, 0xed, 0x61, 0xec,
+    0x72, 0x3d, 0x7d, 0xa1, 0x8e, 0x87, 0x6f, 0xe9, 0xe6, 0xc4, 0xc0, 0x8b, 0x75, 0xb9, 0x23, 0x28,
+    0xe0, 0x20, 0x31, 0xef, 0x4b, 0xb4, 0x81, 0xc8, 0xc3, 0x7d, 0x11, 0x6d, 0xad, 0x9b, 0x03, 0xd8,
+    0x6d, 0x60, 0x5b, 0x0e, 0xdd, 0x0b, 0xb1, 0x78, 0xac, 0x6e, 0x72, 0x44, 0x96, 0x49, 0xcd, 0x3f,
+    0x48, 0x76, 0xe2, 0x0a, 0x88, 0x6c, 0xbb, 0x20, 0xea, 0xdb, 0x82, 0xf8, 0x0e, 0xe0, 0xb0, 0xee,
+    0xa9, 0x81, 0x0f, 0x16, 0x4f, 0x7e, 0x69, 0xac, 0xce, 0xa3, 0x9e, 0x5a, 0x00, 0xb7, 0xca, 0xb7,
+};
+
+static const uint64_t _qh_wy[4] = { 0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL, 0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL };
+
+// Little-endian reads, so hashes match across platforms.
+static inline uint64_t _qh_r64(const unsigned char* p) {
+    uint64_t v; memcpy(&v, p, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+static inline uint64_t _qh_r32(const unsigned char* p) {
+    uint32_t v; memcpy(&v, p, 4);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap32(v);
+#endif
+    return v;
+}
+
+// Full 64x64 -> 128-bit product: *a gets the low half, *b the high half.
+static inline void _qh_mum(uint64_t* a, uint64_t* b) {
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef unsigned __int128 _qh_u128;
+    _qh_u128 r = (_qh_u128)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    *a = _umul128(*a, *b, b);
+#else
+    uint64_t ll = (*a & 0xFFFFFFFF) * (*b & 0xFFFFFFFF), lh = (*a & 0xFFFFFFFF) * (*b >> 32);
+    uint64_t hl = (*a >> 32) * (*b & 0xFFFFFFFF), hh = (*a >> 32) * (*b >> 32);
+    uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+    *a = (ll & 0xFFFFFFFF) | (mid << 32);
+    *b = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif
+}
+
+// The product folded to 64 bits.
+static inline uint64_t _qh_mix(uint64_t a, uint64_t b) { _qh_mum(&a, &b); return a ^ b; }
+
+// n <= QHASH_SHORT: three 16-byte chains over 48-byte blocks, then the tail.
+static inline uint64_t _qh_short(const unsigned char* p, size_t n, uint64_t seed) {
+    const uint64_t* s = _qh_wy;
+    uint64_t a, b;
+    seed ^= _qh_mix(seed ^ s[0], s[1]);
+    if (n <= 16) {
+        if (n >= 4) {
+            size_t q = (n >> 3) << 2;
+            a = _qh_r32(p) << 32 | _qh_r32(p + q);
+            b = _qh_r32(p + n - 4) << 32 | _qh_r32(p + n - 4 - q);
+        } else if (n) {
+            a = (uint64_t)p[0] << 16 | (uint64_t)p[n >> 1] << 8 | p[n - 1];
+            b = 0;
+        } else a = b = 0;
+    } else {
+        size_t i = n;
+        if (i > 48) {
+            uint64_t s1 = seed, s2 = seed;
+            do {
+                seed = _qh_mix(_qh_r64(p) ^ s[1], _qh_r64(p + 8) ^ seed);
+                s1 = _qh_mix(_qh_r64(p + 16) ^ s[2], _qh_r64(p + 24) ^ s1);
+                s2 = _qh_mix(_qh_r64(p + 32) ^ s[3], _qh_r64(p + 40) ^ s2);
+                p += 48; i -= 48;
+            } while (i > 48);
+            seed ^= s1 ^ s2;
+        }
+        for (; i > 16; i -= 16, p += 16) seed = _qh_mix(_qh_r64(p) ^ s[1], _qh_r64(p + 8) ^ seed);
+        a = _qh_r64(p + i - 16);
+        b = _qh_r64(p + i - 8);
+    }
+    a ^= s[1];
+    b ^= seed;
+    _qh_mum(&a, &b);
+    return _qh_mix(a ^ s[0] ^ n, b ^ s[1]);
+}
+
+// One 64-byte stripe: lane i gains lo32(d ^ k) * hi32(d ^ k), its neighbour gains d.
+static inline void _qh_stripe(uint64_t* acc, const unsigned char* p, const unsigned char* key) {
+    for (int i = 0; i < 8; i++) {
+        uint64_t d = _qh_r64(p + 8 * i), x = d ^ _qh_r64(key + 8 * i);
+        acc[i ^ 1] += d;
+        acc[i] += (x & 0xFFFFFFFF) * (x >> 32);
+    }
+}
+
+static inline void _qh_scramble(uint64_t* acc, const unsigned char* key) {
+    for (int i = 0; i < 8; i++) {
+        uint64_t a = acc[i];
+        a ^= a >> 47;
+        acc[i] = (a ^ _qh_r64(key + 8 * i)) * _QH_P32;
+    }
+}
+
+// Every 16 stripes the lanes are scrambled; *count is the global stripe index.
+static inline void _qh_consume_scalar(uint64_t* acc, const unsigned char* p, size_t n, uint64_t* count, const unsigned char* sec) {
+    for (uint64_t s = *count, end = s + n; s < end; s++, p += 64) {
+        _qh_stripe(acc, p, sec + 8 * (s & 15));
+        if ((s & 15) == 15) _qh_scramble(acc, sec + 128);
+    }
+    *count += n;
+}
+
+#ifdef _FS_X86_SIMD
+static inline __m128i _qh_sse2_mul32(__m128i a, __m128i prime) {
+    return _mm_add_epi64(_mm_mul_epu32(a, prime), _mm_slli_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), prime), 32));
+}
+
+static inline void _qh_consume_sse2(uint64_t* acc, const unsigned char* p, size_t n, uint64_t* count, const unsigned char* sec) {
+    __m128i a[4];
+    const __m128i prime = _mm_set1_epi32((int)_QH_P32);
+    for (int j = 0; j < 4; j++) a[j] = _mm_loadu_si128((const __m128i*)(acc + 2 * j));
+    for (uint64_t s = *count, end = s + n; s < end; s++, p += 64) {
+        const unsigned char* k = sec + 8 * (s & 15);
+        for (int j = 0; j < 4; j++) {
+            __m128i d = _mm_loadu_si128((const __m128i*)(p + 16 * j));
+            __m128i x = _mm_xor_si128(d, _mm_loadu_si128((const __m128i*)(k + 16 * j)));
+            __m128i prod = _mm_mul_epu32(x, _mm_srli_epi64(x, 32));
+            a[j] = _mm_add_epi64(a[j], _mm_add_epi64(prod, _mm_shuffle_epi32(d, 0x4E)));
+        }
+        if ((s & 15) == 15) {
+            for (int j = 0; j < 4; j++) {
+                __m128i v = _mm_xor_si128(a[j], _mm_srli_epi64(a[j], 47));
+                v = _mm_xor_si128(v, _mm_loadu_si128((const __m128i*)(sec + 128 + 16 * j)));
+                a[j] = _qh_sse2_mul32(v, prime);
+            }
+        }
+    }
+    for (int j = 0; j < 4; j++) _mm_storeu_si128((__m128i*)(acc + 2 * j), a[j]);
+    *count += n;
+}
+
+__attribute__((target("avx2")))
+static inline void _qh_consume_avx2(uint64_t* acc, const unsigned char* p, size_t n, uint64_t* count, const unsigned char* sec) {
+    __m256i a[2];
+    const __m256i prime = _mm256_set1_epi32((int)_QH_P32);
+    for (int j = 0; j < 2; j++) a[j] = _mm256_loadu_si256((const __m256i*)(acc + 4 * j));
+    for (uint64_t s = *count, end = s + n; s < end; s++, p += 64) {
+        const unsigned char* k = sec + 8 * (s & 15);
+        for (int j = 0; j < 2; j++) {
+            __m256i d = _mm256_loadu_si256((const __m256i*)(p + 32 * j));
+            __m256i x = _mm256_xor_si256(d, _mm256_loadu_si256((const __m256i*)(k + 32 * j)));
+            __m256i prod = _mm256_mul_epu32(x, _mm256_srli_epi64(x, 32));
+            a[j] = _mm256_add_epi64(a[j], _mm256_add_epi64(prod, _mm256_shuffle_epi32(d, 0x4E)));
+        }
+        if ((s & 15) == 15) {
+            for (int j = 0; j < 2; j++) {
+                __m256i v = _mm256_xor_si256(a[j], _mm256_srli_epi64(a[j], 47));
+                v = _mm256_xor_si256(v, _mm256_loadu_si256((const __m256i*)(sec + 128 + 32 * j)));
+                a[j] = _mm256_add_epi64(_mm256_mul_epu32(v, prime), _mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(v, 32), prime), 32));
+            }
+        }
+    }
+    for (int j = 0; j < 2; j++) _mm256_storeu_si256((__m256i*)(acc + 4 * j), a[j]);
+    *count += n;
+}
+#endif
+
+// 0 = scalar, 1 = SSE2, 2 = AVX2. qhash_simd_limit caps it (for testing and benchmarks).
+static int _qh_simd = -1;
+
+static inline int qhash_simd_level() {
+    if (_qh_simd < 0) {
+        _qh_simd = 0;
+#ifdef _FS_X86_SIMD
+        _qh_simd = 1;
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) _qh_simd = 2;
+#endif
+    }
+    return _qh_simd;
+}
+
+static inline void qhash_simd_limit(int level) { if (qhash_simd_level() > level) _qh_simd = level; }
+
+static inline void _qh_consume(uint64_t* acc, const unsigned char* p, size_t n, uint64_t* count, const unsigned char* sec) {
+#ifdef _FS_X86_SIMD
+    int level = qhash_simd_level();
+    if (level >= 2) { _qh_consume_avx2(acc, p, n, count, sec); return; }
+    if (level == 1) { _qh_consume_sse2(acc, p, n, count, sec); return; }
+#endif
+    _qh_consume_scalar(acc, p, n, count, sec);
+}
+
+static inline void _qh_acc_init(uint64_t* acc) {
+    static const uint64_t init[8] = { 0xC2B2AE3DULL, _QH_P1, _QH_P2, 0x165667B19E3779F9ULL,
+                                      0x85EBCA77C2B2AE63ULL, 0x85EBCA77ULL, 0x27D4EB2F165667C5ULL, _QH_P32 };
+    memcpy(acc, init, sizeof(init));
+}
+
+// Seeded key: even words + seed, odd words - seed.
+static inline void _qh_seed_secret(unsigned char* out, uint64_t seed) {
+    for (int i = 0; i < 24; i++) {
+        uint64_t w = _qh_r64(_qh_secret + 8 * i) + (i & 1 ? 0 - seed : seed);
+        for (int b = 0; b < 8; b++) out[8 * i + b] = (unsigned char)(w >> (8 * b));
+    }
+}
+
+static inline uint64_t _qh_merge(const uint64_t* acc, const unsigned char* key, uint64_t h) {
+    for (int i = 0; i < 4; i++) h += _qh_mix(acc[2 * i] ^ _qh_r64(key + 16 * i), acc[2 * i + 1] ^ _qh_r64(key + 16 * i + 8));
+    h ^= h >> 37;
+    h *= 0x165667919E3779F9ULL;
+    return h ^ (h >> 32);
+}
+
+// Final stripe (the last 64 bytes, overlapping earlier ones) and the merge into 64 or 128 bits.
+static inline qol_hash128 _qh_long_final(uint64_t* acc, const unsigned char* last, uint64_t total, const unsigned char* sec, int wide) {
+    qol_hash128 r;
+    _qh_stripe(acc, last, sec + 192 - 64 - 7);
+    r.lo = _qh_merge(acc, sec + 11, total * _QH_P1);
+    r.hi = wide ? _qh_merge(acc, sec + 192 - 64 - 11, ~(total * _QH_P2)) : 0;
+    return r;
+}
+
+static inline qol_hash128 _qh_long(const unsigned char* p, size_t n, uint64_t seed, int wide) {
+    unsigned char seeded[192];
+    const unsigned char* sec = _qh_secret;
+    uint64_t acc[8], count = 0;
+    if (seed) { _qh_seed_secret(seeded, seed); sec = seeded; }
+    _qh_acc_init(acc);
+    _qh_consume(acc, p, (n - 1) / 64, &count, sec);
+    return _qh_long_final(acc, p + n - 64, n, sec, wide);
+}
+
+static inline uint64_t qhash64(const void* data, size_t n, uint64_t seed) {
+    const unsigned char* p = (const unsigned char*)data;
+    return n <= QHASH_SHORT ? _qh_short(p, n, seed) : _qh_long(p, n, seed, 0).lo;
+}
+
+static inline qol_hash128 qhash128(const void* data, size_t n, uint64_t seed) {
+    const unsigned char* p = (const unsigned char*)data;
+    if (n > QHASH_SHORT) return _qh_long(p, n, seed, 1);
+    qol_hash128 r;
+    r.lo = _qh_short(p, n, seed);
+    r.hi = _qh_short(p, n, seed ^ _QH_P2);
+    return r;
+}
+
+// Streaming: qhash_update in pieces of any size gives the same value as one qhash64 / qhash128 call.
+typedef struct {
+    uint64_t acc[8];
+    uint64_t count;                 // stripes consumed
+    uint64_t total;                 // bytes seen
+    uint64_t seed;
+    size_t buf_len;
+    unsigned char buf[QHASH_SHORT];
+    unsigned char prev[64];         // last 64 consumed bytes, for a short final stripe
+    unsigned char secret[192];
+} qol_hasher;
+
+static inline void qhash_init(qol_hasher* h, uint64_t seed) {
+    _qh_acc_init(h->acc);
+    h->count = h->total = 0;
+    h->seed = seed;
+    h->buf_len = 0;
+    if (seed) _qh_seed_secret(h->secret, seed);
+    else memcpy(h->secret, _qh_secret, sizeof(h->secret));
+}
+
+// Stripes are consumed only once more input follows them, so the final stripe is always left in buf.
+static inline void qhash_update(qol_hasher* h, const void* data, size_t n) {
+    const unsigned char* p = (const unsigned char*)data;
+    h->total += n;
+    if (n <= QHASH_SHORT && h->buf_len + n <= QHASH_SHORT) {
+        if (n) memcpy(h->buf + h->buf_len, p, n);
+        h->buf_len += n;
+        return;
+    }
+    if (h->buf_len) {
+        size_t fill = QHASH_SHORT - h->buf_len;
+        memcpy(h->buf + h->buf_len, p, fill);
+        p += fill; n -= fill;
+        _qh_consume(h->acc, h->buf, QHASH_SHORT / 64, &h->count, h->secret);
+        memcpy(h->prev, h->buf + QHASH_SHORT - 64, 64);
+    }
+    if (n > QHASH_SHORT) {
+        size_t bulk = (n - 1) / QHASH_SHORT * QHASH_SHORT;
+        _qh_consume(h->acc, p, bulk / 64, &h->count, h->secret);
+        memcpy(h->prev, p + bulk - 64, 64);
+        p += bulk; n -= bulk;
+    }
+    memcpy(h->buf, p, n);
+    h->buf_len = n;
+}
+
+static inline qol_hash128 _qh_digest(const qol_hasher* h, int wide) {
+    if (h->total <= QHASH_SHORT) {
+        qol_hash128 r;
+        r.lo = _qh_short(h->buf, h->buf_len, h->seed);
+        r.hi = wide ? _qh_short(h->buf, h->buf_len, h->seed ^ _QH_P2) : 0;
+        return r;
+    }
+    uint64_t acc[8], count = h->count;
+    unsigned char last[64];
+    memcpy(acc, h->acc, sizeof(acc));
+    _qh_consume(acc, h->buf, (h->buf_len - 1) / 64, &count, h->secret);
+    if (h->buf_len >= 64) memcpy(last, h->buf + h->buf_len - 64, 64);
+    else {
+        memcpy(last, h->prev + h->buf_len, 64 - h->buf_len);
+        memcpy(last + 64 - h->buf_len, h->buf, h->buf_len);
+    }
+    return _qh_long_final(acc, last, h->total, h->secret, wide);
+}
+
+// Digests do not modify the state: more data can be added afterwards.
+static inline uint64_t qhash_digest64(const qol_hasher* h) { return _qh_digest(h, 0).lo; }
+static inline qol_hash128 qhash_digest128(const qol_hasher* h) { return _qh_digest(h, 1); }
+
+static inline long fs_size(const char* filename) {
+    char clean_path[256]; strncpy(clean_path, filename, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
+    FILE* f = fopen(clean_path, "rb");
+    if (!f) return -1;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fclose(f);
+    return size;
+}
+
+static inline char* fs_read(const char* filename) {
+    char clean_path[256]; strncpy(clean_path, filename, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
+    FILE* f = fopen(clean_path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char* buffer = (char*)QOL_MALLOC(size + 1);
+    if (!buffer) { fclose(f); return NULL; }
+    fread(buffer, 1, size, f);
+    buffer[size] = 0;
+    fclose(f);
+    return buffer;
+}
+
+static inline int fs_write(const char* filename, const char* data) {
+    char clean_path[256]; strncpy(clean_path, filename, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
+    FILE* f = fopen(clean_path, "wb");
+    if (!f) return 0;
+    fprintf(f, "%s", data);
+    fclose(f);
+    return 1;
+}
+
+static inline int fs_append(const char* filename, const char* data) {
+    char clean_path[256]; strncpy(clean_path, filename, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
+    FILE* f = fopen(clean_path, "ab");
+    if (!f) return 0;
+    fprintf(f, "%s", data);
+    fclose(f);
+    return 1;
+}
+
+static inline int fs_delete(const char* filename) {
+    char clean_path[256]; strncpy(clean_path, filename, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
+    return remove(clean_path) == 0;
+}
+
+static inline int fs_exists(const char* filename) {
+    char clean_path[256]; strncpy(clean_path, filename, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
+    FILE* f = fopen(clean_path, "r");
+    if (f) { fclose(f); return 1; }
+    return 0;
+}
+
+/* --- Directory Functions --- */
+
+static inline int fs_mkdir(const char* path) {
+    if (!path) return 0;
+    char clean_path[256]; strncpy(clean_path, path, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
+    return mkdir(clean_path, 0777) == 0;
+}
+
+static inline int fs_dirremove(const char* path) {
+    if (!path) return 0;
+    char clean_path[256]; strncpy(clean_path, path, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
+#ifdef _WIN32
+    WIN32_FIND_DATAA findData;
+    char search_path[280];
+    sprintf(search_path, "%s\\*", clean_path);
+    HANDLE hFind = FindFirstFileA(search_path, &findData);
+    if (hFind == INVALID_HANDLE_VALUE) return 0;
+    do {
+        if (strcmp(findData.cFileName, ".") != 0 && strcmp(findData.cFileName, "..") != 0) {
+            char full_path[512];
+            sprintf(full_path, "%s\\%s", clean_path, findData.cFileName);
+            if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) fs_dirremove(full_path);
+            else DeleteFileA(full_path);
+        }
+    } while (FindNextFileA(hFind, &findData));
+    FindClose(hFind);
+    return RemoveDirectoryA(clean_path) != 0;
+#else
+    DIR* d = opendir(clean_path);
+    if (!d) return 0;
+    struct dirent* p;
+    while ((p = readdir(d))) {
+        if (!strcmp(p->d_name, ".") || !strcmp(p->d_name, "..")) continue;
+        char full_path[512];
+        snprintf(full_path, sizeof(full_path), "%s/%s", clean_path, p->d_name);
+        struct stat statbuf;
+        if (!stat(full_path, &statbuf)) {
+            if (S_ISDIR(statbuf.st_mode)) fs_dirremove(full_path);
+            else unlink(full_path);
+        }
+    }
+    closedir(d);
+    return rmdir(clean_path) == 0;
+#endif
+}
+
+/**
+ * Returns a piped string "name:type|name:type". 
+ * CALLER MUST FREE RESULT.
+ */
+static inline char* fs_listdir(const char* path) {
+    if (!path) return NULL;
+    char clean_path[256]; strncpy(clean_path, path, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
+
+    size_t cap = 1024;
+    char* result = (char*)QOL_MALLOC(cap);
+    if (!result) return NULL;
+    result[0] = '\0';
+
+#ifdef _WIN32
+    WIN32_FIND_DATAA findData;
+    char search_path[280];
+    sprintf(search_path, "%s\\*", clean_path);
+    HANDLE hFind = FindFirstFileA(search_path, &findData);
+    if (hFind != INVALID_HANDLE_VALUE) {
+        do {
+            if (strcmp(findData.cFileName, ".") != 0 && strcmp(findData.cFileName, "..") != 0) {
+                int is_dir = (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY);
+                size_t needed = strlen(result) + strlen(findData.cFileName) + 10;
+                if (needed >= cap) { cap *= 2; result = (char*)QOL_REALLOC(result, cap); }
+                if (result[0] != '\0') strcat(result, "|");
+                strcat(result, findData.cFileName);
+                strcat(result, is_dir ? ":dir" : ":file");
+            }
+        } while (FindNextFileA(hFind, &findData));
+        FindClose(hFind);
+    }
+#else
+    DIR* d = opendir(clean_path);
+    if (d) {
+        struct dirent* p;
+        while ((p = readdir(d))) {
+            if (!strcmp(p->d_name, ".") || !strcmp(p->d_name, "..")) continue;
+            char full_path[512];
+            snprintf(full_path, sizeof(full_path), "%s/%s", clean_path, p->d_name);
+            struct stat st;
+            int is_dir = (stat(full_path, &st) == 0 && S_ISDIR(st.st_mode));
+            size_t needed = strlen(result) + strlen(p->d_name) + 10;
+            if (needed >= cap) { cap *= 2; result = (char*)QOL_REALLOC(result, cap); }
+            if (result[0] != '\0') strcat(result, "|");
+            strcat(result, p->d_name);
+            strcat(result, is_dir ? ":dir" : ":file");
+        }
+        closedir(d);
+    }
+#endif
+    return result;
+}
+
+/* --- Utility Functions --- */
+
+static inline int fs_count(const char* data, char target) {
+    int count = 0;
+    for (int i = 0; data[i]; i++) if (data[i] == target) count++;
+    return count;
+}
+
+static inline char* fs_getline(char* data, int line_num) {
+    static char line_buf[512];
+    char* cur = data;
+    for (int i = 0; i < line_num; i++) {
+        cur = strchr(cur, '\n');
+        if (!cur) return NULL;
+        cur++;
+    }
+    char* next = strchr(cur, '\n');
+    int len = next ? (int)(next - cur) : (int)strlen(cur);
+    if (len > 511) len = 511;
+    strncpy(line_buf, cur, len);
+    line_buf[len] = 0;
+    return line_buf;
+}
+
+static inline char* fs_readto(const char* filename, int endbyte) {
+    char clean_path[256]; strncpy(clean_path, filename, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
+    FILE* f = fopen(clean_path, "rb");
+    if (!f) return NULL;
+    char* buffer = (char*)QOL_MALLOC(endbyte + 1);
+    if (!buffer) { fclose(f); return NULL; }
+    int bytesRead = (int)fread(buffer, 1, endbyte, f);
+    buffer[bytesRead] = 0;
+    fclose(f);
+    return buffer;
+}
+
+static inline char* fs_readamount(const char* filename, int startbyte, int endbyte) {
+    char clean_path[256]; strncpy(clean_path, filename, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
+    FILE* f = fopen(clean_path, "rb");
+    if (!f) return NULL;
+    fseek(f, startbyte, SEEK_SET);
+    int amount = endbyte - startbyte;
+    if (amount <= 0) { fclose(f); return NULL; }
+    char* buffer = (char*)QOL_MALLOC(amount + 1);
+    if (!buffer) { fclose(f); return NULL; }
+    int bytesRead = (int)fread(buffer, 1, amount, f);
+    buffer[bytesRead] = 0;
+    fclose(f);
+    return buffer;
+}
+
+// Streams a file through qhash64 without loading it whole. Returns 1 on success, 0 if it cannot be read.
+static inline int fs_hash(const char* filename, uint64_t seed, uint64_t* out) {
+    char clean_path[256]; strncpy(clean_path, filename, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
+    FILE* f = fopen(clean_path, "rb");
+    if (!f) return 0;
+    qol_hasher h;
+    unsigned char chunk[16384];
+    size_t got;
+    qhash_init(&h, seed);
+    while ((got = fread(chunk, 1, sizeof(chunk), f)) > 0) qhash_update(&h, chunk, got);
+    int ok = !ferror(f);
+    fclose(f);
+    if (ok) *out = qhash_digest64(&h);
+    return ok;
+}
+
+/* --- Fast Compression (LZ4 Format) --- */
+// qlz_compress / qlz_decompress read and write LZ4 blocks: greedy matching over
+// a hash table of 4-byte sequences, with the search skipping ahead faster the
+// longer it goes without a match. Frames follow the LZ4 frame format, so files
+// from fs_write_compressed open with `lz4 -d` and lz4's output decodes here.
+
+#define QLZ_ERROR ((size_t)-1)
+#define QLZ_BLOCK 65536              // Frame block size written by the encoder.
+#define QLZ_MAX_INPUT 0x7E000000     // Largest input for one raw block.
+#ifndef QLZ_TABLE_LOG
+#define QLZ_TABLE_LOG 12             // 4096-entry match table (16 KB).
+#endif
+#define _QLZ_MINMATCH 4
+#define _QLZ_LAST_LITERALS 5         // A block ends with at least this many literals...
+#define _QLZ_MFLIMIT 12              // ...and its last match starts this far from the end.
+#define _QLZ_MAX_DIST 65535
+#define _QLZ_MAGIC 0x184D2204u
+#define _QLZ_SKIP_MAGIC 0x184D2A50u  // 16 values: 0x184D2A50-5F.
+
+static inline uint32_t _qlz_r32(const unsigned char* p) { uint32_t v; memcpy(&v, p, 4); return v; }
+static inline uint64_t _qlz_r64(const unsigned char* p) { uint64_t v; memcpy(&v, p, 8); return v; }
+static inline uint32_t _qlz_le32(const unsigned char* p) { return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24; }
+static inline void _qlz_put32(unsigned char* p, uint32_t v) { p[0] = (unsigned char)v; p[1] = (unsigned char)(v >> 8); p[2] = (unsigned char)(v >> 16); p[3] = (unsigned char)(v >> 24); }
+
+// XXH32, which the frame format uses for its header and content checksums.
+typedef struct { uint32_t v[4]; uint64_t total; unsigned char mem[16]; size_t mem_len; } _qlz_xxh;
+#define _QLZ_X1 0x9E3779B1u
+#define _QLZ_X2 0x85EBCA77u
+#define _QLZ_X3 0xC2B2AE3Du
+#define _QLZ_X4 0x27D4EB2Fu
+#define _QLZ_X5 0x165667B1u
+static inline uint32_t _qlz_rotl(uint32_t x, int r) { return (x << r) | (x >> (32 - r)); }
+static inline uint32_t _qlz_round(uint32_t acc, uint32_t in) { return _qlz_rotl(acc + in * _QLZ_X2, 13) * _QLZ_X1; }
+
+static inline void _qlz_xxh_init(_qlz_xxh* h) {
+    h->v[0] = _QLZ_X1 + _QLZ_X2; h->v[1] = _QLZ_X2; h->v[2] = 0; h->v[3] = 0u - _QLZ_X1;
+    h->total = 0; h->mem_len = 0;
+}
+
+static inline void _qlz_xxh_update(_qlz_xxh* h, const void* data, size_t n) {
+    const unsigned char* p = (const unsigned char*)data;
+    h->total += n;
+    if (h->mem_len + n < 16) { memcpy(h->mem + h->mem_len, p, n); h->mem_len += n; return; }
+    if (h->mem_len) {
+        size_t fill = 16 - h->mem_len;
+        memcpy(h->mem + h->mem_len, p, fill);
+        for (int i = 0; i < 4; i++) h->v[i] = _qlz_round(h->v[i], _qlz_le32(h->mem + 4 * i));
+        p += fill; n -= fill; h->mem_len = 0;
+    }
+    uint32_t v0 = h->v[0], v1 = h->v[1], v2 = h->v[2], v3 = h->v[3];
+    for (; n >= 16; p += 16, n -= 16) {
+        v0 = _qlz_round(v0, _qlz_le32(p)); v1 = _qlz_round(v1, _qlz_le32(p + 4));
+        v2 = _qlz_round(v2, _qlz_le32(p + 8)); v3 = _qlz_round(v3, _qlz_le32(p + 12));
+    }
+    h->v[0] = v0; h->v[1] = v1; h->v[2] = v2; h->v[3] = v3;
+    memcpy(h->mem, p, n); h->mem_len = n;
+}
+
+static inline uint32_t _qlz_xxh_digest(const _qlz_xxh* h) {
+    uint32_t acc = h->total >= 16
+        ? _qlz_rotl(h->v[0], 1) + _qlz_rotl(h->v[1], 7) + _qlz_rotl(h->v[2], 12) + _qlz_rotl(h->v[3], 18)
+        : h->v[2] + _QLZ_X5;
+    const unsigned char* p = h->mem;
+    size_t n = h->mem_len;
+    acc += (uint32_t)h->total;
+    for (; n >= 4; p += 4, n -= 4) acc = _qlz_rotl(acc + _qlz_le32(p) * _QLZ_X3, 17) * _QLZ_X4;
+    for (; n; p++, n--) acc = _qlz_rotl(acc + *p * _QLZ_X5, 11) * _QLZ_X1;
+    acc ^= acc >> 15; acc *= _QLZ_X2;
+    acc ^= acc >> 13; acc *= _QLZ_X3;
+    return acc ^ (acc >> 16);
+}
+
+static inline uint32_t _qlz_xxh32(const void* data, size_t n) {
+    _qlz_xxh h;
+    _qlz_xxh_init(&h);
+    _qlz_xxh_update(&h, data, n);
+    return _qlz_xxh_digest(&h);
+}
+
+// Hash of the 5 bytes at p (4 on 32-bit targets).
+static inline uint32_t _qlz_hash(const unsigned char* p) {
+    if (sizeof(void*) == 8) return (uint32_t)(((_qlz_r64(p) << 24) * 889523592379ULL) >> (64 - QLZ_TABLE_LOG));
+    return (_qlz_r32(p) * 2654435761u) >> (32 - QLZ_TABLE_LOG);
+}
+
+// Length of the common prefix of p and m, reading no further than limit.
+static inline size_t _qlz_count(const unsigned char* p, const unsigned char* m, const unsigned char* limit) {
+    const unsigned char* start = p;
+    while (p + 8 <= limit) {
+        uint64_t diff = _qlz_r64(p) ^ _qlz_r64(m);
+        if (diff) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            return (size_t)(p - start) + (size_t)(__builtin_clzll(diff) >> 3);
+#else
+            return (size_t)(p - start) + (size_t)(__builtin_ctzll(diff) >> 3);
+#endif
+        }
+        p += 8; m += 8;
+    }
+    while (p < limit && *p == *m) { p++; m++; }
+    return (size_t)(p - start);
+}
+
+static inline unsigned char* _qlz_put_len(unsigned char* op, size_t len) {
+    for (; len >= 255; len -= 255) *op++ = 255;
+    *op++ = (unsigned char)len;
+    return op;
+}
+
+// Worst case for qlz_compress: incompressible input plus one length byte per 255 literals.
+static inline size_t qlz_compress_bound(size_t n) { return n > QLZ_MAX_INPUT ? 0 : n + n / 255 + 16; }
+
+// Compresses src[0..n) into one LZ4 block. Returns its size, or 0 if it does not
+// fit in cap bytes (always fits in qlz_compress_bound(n)) or n > QLZ_MAX_INPUT.
+static inline size_t qlz_compress(void* dst, size_t cap, const void* src, size_t n) {
+    const unsigned char* base = (const unsigned char*)src;
+    const unsigned char* ip = base;
+    const unsigned char* anchor = base;
+    const unsigned char* iend = base + n;
+    unsigned char* op = (unsigned char*)dst;
+    unsigned char* oend = op + cap;
+    uint32_t table[1 << QLZ_TABLE_LOG];
+    if (n > QLZ_MAX_INPUT || cap == 0) return 0;
+    if (n >= _QLZ_MFLIMIT + 1) {
+        const unsigned char* mflimit = iend - _QLZ_MFLIMIT;
+        const unsigned char* match_limit = iend - _QLZ_LAST_LITERALS;
+        uint32_t fwd_h;
+        memset(table, 0, sizeof(table));
+        table[_qlz_hash(ip)] = 0;
+        fwd_h = _qlz_hash(++ip);
+        for (;;) {
+            const unsigned char* match;
+            unsigned char* token;
+            // Look for a 4-byte match, stepping further after every 64 misses.
+            {
+                const unsigned char* fwd = ip;
+                unsigned step = 1, searches = 1u << 6;
+                do {
+                    uint32_t h = fwd_h;
+                    ip = fwd;
+                    fwd += step;
+                    step = searches++ >> 6;
+                    if (fwd > mflimit) goto last_literals;
+                    match = base + table[h];
+                    fwd_h = _qlz_hash(fwd);
+                    table[h] = (uint32_t)(ip - base);
+                } while (match + _QLZ_MAX_DIST < ip || _qlz_r32(match) != _qlz_r32(ip));
+            }
+            while (ip > anchor && match > base && ip[-1] == match[-1]) { ip--; match--; }
+            {
+                size_t lit = (size_t)(ip - anchor);
+                token = op++;
+                if ((size_t)(oend - op) < lit + lit / 255 + 2 + 1 + _QLZ_LAST_LITERALS) return 0;
+                if (lit >= 15) { *token = 15 << 4; op = _qlz_put_len(op, lit - 15); }
+                else *token = (unsigned char)(lit << 4);
+                if ((size_t)(oend - op) >= lit + 8) {
+                    unsigned char* d = op;
+                    const unsigned char* s = anchor;
+                    do { memcpy(d, s, 8); d += 8; s += 8; } while (d < op + lit);
+                } else memcpy(op, anchor, lit);
+                op += lit;
+            }
+            for (;;) {
+                size_t len;
+                op[0] = (unsigned char)(ip - match); op[1] = (unsigned char)((ip - match) >> 8);
+                op += 2;
+                len = _qlz_count(ip + _QLZ_MINMATCH, match + _QLZ_MINMATCH, match_limit);
+                ip += _QLZ_MINMATCH + len;
+                // Length bytes, then room for the next token and the last literals.
+                if ((size_t)(oend - op) < (len + 240) / 255 + 1 + _QLZ_LAST_LITERALS) return 0;
+                if (len >= 15) { *token += 15; op = _qlz_put_len(op, len - 15); }
+                else *token += (unsigned char)len;
+                anchor = ip;
+                if (ip > mflimit) goto last_literals;
+                table[_qlz_hash(ip - 2)] = (uint32_t)(ip - 2 - base);
+                // A match right away continues with an empty literal run.
+                {
+                    uint32_t h = _qlz_hash(ip);
+                    match = base + table[h];
+                    table[h] = (uint32_t)(ip - base);
+                }
+                if (match + _QLZ_MAX_DIST < ip || _qlz_r32(match) != _qlz_r32(ip)) break;
+                if ((size_t)(oend - op) < 1 + 2 + 1 + _QLZ_LAST_LITERALS) return 0;   // Token, offset, then the tail.
+                token = op++;
+                *token = 0;
+            }
+            fwd_h = _qlz_hash(++ip);
+        }
+    }
+last_literals:
+    {
+        size_t lit = (size_t)(iend - anchor);
+        if ((size_t)(oend - op) < 1 + lit + (lit + 255 - 15) / 255) return 0;
+        if (lit >= 15) { *op++ = 15 << 4; op = _qlz_put_len(op, lit - 15); }
+        else *op++ = (unsigned char)(lit << 4);
+        memcpy(op, anchor, lit);
+        op += lit;
+    }
+    return (size_t)(op - (unsigned char*)dst);
+}
+
+// Decodes the block src[0..n) to out, which may follow earlier output starting
+// at low (matches can reach back into it). Returns bytes written, or QLZ_ERROR
+// on malformed input or if the output would pass oend.
+static inline size_t _qlz_decode(unsigned char* low, unsigned char* out, unsigned char* oend, const unsigned char* ip, size_t n) {
+    const unsigned char* iend = ip + n;
+    unsigned char* op = out;
+    if (n == 0) return QLZ_ERROR;
+    for (;;) {
+        if (ip >= iend) return QLZ_ERROR;   // A block must end with literals.
+        unsigned token = *ip++;
+        size_t lit = token >> 4, len;
+        const unsigned char* match;
+        size_t offset;
+        // Common case: short literal run and room to copy 16 bytes regardless.
+        if (lit < 15 && iend - ip >= 16 && oend - op >= 32) {
+            memcpy(op, ip, 16);
+            op += lit; ip += lit;
+            // Short match that does not overlap its copy: fixed-size moves, no loop.
+            len = token & 15;
+            offset = (size_t)ip[0] | (size_t)ip[1] << 8;
+            if (len < 15 && offset >= 8 && offset <= (size_t)(op - low)) {
+                match = op - offset;
+                memcpy(op, match, 8);
+                memcpy(op + 8, match + 8, 8);
+                memcpy(op + 16, match + 16, 2);
+                op += len + _QLZ_MINMATCH;
+                ip += 2;
+                continue;
+            }
+            op -= lit; ip -= lit;
+        } else {
+            if (lit == 15) {
+                unsigned s;
+                do {
+                    if (ip >= iend) return QLZ_ERROR;
+                    s = *ip++;
+                    lit += s;
+                } while (s == 255);
+            }
+            if (lit > (size_t)(iend - ip) || lit > (size_t)(oend - op)) return QLZ_ERROR;
+            if (iend - ip >= (ptrdiff_t)lit + 16 && oend - op >= (ptrdiff_t)lit + 16) {
+                unsigned char* d = op;
+                const unsigned char* s = ip;
+                do { memcpy(d, s, 16); d += 16; s += 16; } while (d < op + lit);
+            } else memmove(op, ip, lit);
+        }
+        op += lit; ip += lit;
+        if (ip == iend) break;   // The last sequence is literals only.
+        if (iend - ip < 2) return QLZ_ERROR;
+        offset = (size_t)ip[0] | (size_t)ip[1] << 8;
+        ip += 2;
+        if (offset == 0 || offset > (size_t)(op - low)) return QLZ_ERROR;
+        match = op - offset;
+        len = token & 15;
+        if (len == 15) {
+            unsigned s;
+            do {
+                if (ip >= iend) return QLZ_ERROR;
+                s = *ip++;
+                len += s;
+            } while (s == 255);
+        }
+        len += _QLZ_MINMATCH;
+        if (len > (size_t)(oend - op)) return QLZ_ERROR;
+        if (offset >= 16 && (size_t)(oend - op) >= len + 16) {
+            unsigned char* d = op;
+            do { memcpy(d, match, 16); d += 16; match += 16; } while (d < op + len);
+        } else if (offset >= 8 && (size_t)(oend - op) >= len + 8) {
+            unsigned char* d = op;
+            do { memcpy(d, match, 8); d += 8; match += 8; } while (d < op + len);
+        } else {
+            // Overlapping: the copied span doubles each step, since what was
+            // just written repeats the pattern.
+            size_t done = 0;
+            while (done < len) {
+                size_t c = offset + done < len - done ? offset + done : len - done;
+                memcpy(op + done, match, c);
+                done += c;
+            }
+        }
+        op += len;
+    }
+    return (size_t)(op - out);
+}
+
+// Decodes one LZ4 block into dst. Returns its size, or QLZ_ERROR if the block is
+// malformed or would not fit in cap bytes. Never reads or writes out of bounds.
+static inline size_t qlz_decompress(void* dst, size_t cap, const void* src, size_t n) {
+    return _qlz_decode((unsigned char*)dst, (unsigned char*)dst, (unsigned char*)dst + cap, (const unsigned char*)src, n);
+}
+
+/* --- LZ4 Frames --- */
+// Magic, descriptor (flags, block size, optional content size), header checksum,
+// then blocks of up to QLZ_BLOCK bytes (compressed, or stored when that is
+// smaller), an end mark and an XXH32 of the content. Frames can be concatenated,
+// e.g. by fs_append_compressed; readers decode them back to back.
+
+#define _QLZ_F_INDEP 0x20
+#define _QLZ_F_BLOCK_SUM 0x10
+#define _QLZ_F_SIZE 0x08
+#define _QLZ_F_SUM 0x04
+#define _QLZ_F_DICT 0x01
+
+typedef struct { int flags; size_t block_max; uint64_t content_size; size_t len; } _qlz_frame;
+
+// Writes a frame header; content_size 0 leaves the size out.
+static inline size_t _qlz_put_header(unsigned char* p, uint64_t content_size) {
+    size_t n = 6;
+    _qlz_put32(p, _QLZ_MAGIC);
+    p[4] = 0x40 | _QLZ_F_INDEP | _QLZ_F_SUM | (content_size ? _QLZ_F_SIZE : 0);
+    p[5] = 4 << 4;   // 64 KB blocks.
+    if (content_size) {
+        _qlz_put32(p + 6, (uint32_t)content_size);
+        _qlz_put32(p + 10, (uint32_t)(content_size >> 32));
+        n += 8;
+    }
+    p[n] = (unsigned char)(_qlz_xxh32(p + 4, n - 4) >> 8);
+    return n + 1;
+}
+
+// Parses a frame header. Returns its length, 0 if more bytes are needed, or QLZ_ERROR.
+static inline size_t _qlz_get_header(const unsigned char* p, size_t n, _qlz_frame* f) {
+    size_t len = 7;
+    if (n < 7) return 0;
+    if (_qlz_le32(p) != _QLZ_MAGIC) return QLZ_ERROR;
+    f->flags = p[4];
+    if ((f->flags & 0xC2) != 0x40 || (p[5] & 0x8F) || (p[5] >> 4) < 4) return QLZ_ERROR;
+    if (f->flags & _QLZ_F_DICT) return QLZ_ERROR;   // Dictionaries are not supported.
+    f->block_max = (size_t)1 << (8 + 2 * (p[5] >> 4));
+    len += f->flags & _QLZ_F_SIZE ? 8 : 0;
+    if (n < len) return 0;
+    f->content_size = 0;
+    if (f->flags & _QLZ_F_SIZE) f->content_size = _qlz_le32(p + 6) | (uint64_t)_qlz_le32(p + 10) << 32;
+    if (p[len - 1] != (unsigned char)(_qlz_xxh32(p + 4, len - 5) >> 8)) return QLZ_ERROR;
+    f->len = len;
+    return len;
+}
+
+// Writes one block of 1..QLZ_BLOCK bytes: compressed if that saves space.
+static inline size_t _qlz_put_block(unsigned char* p, const unsigned char* src, size_t n) {
+    size_t c = qlz_compress(p + 4, n - 1, src, n);
+    if (c) { _qlz_put32(p, (uint32_t)c); return c + 4; }
+    _qlz_put32(p, (uint32_t)n | 0x80000000u);
+    memcpy(p + 4, src, n);
+    return n + 4;
+}
+
+// Room needed by qlz_frame_compress.
+static inline size_t qlz_frame_bound(size_t n) { return n + 4 * (n / QLZ_BLOCK + 1) + 23; }
+
+// Compresses src[0..n) into one frame that records the content size. Returns
+// its size, or 0 if cap is below qlz_frame_bound(n).
+static inline size_t qlz_frame_compress(void* dst, size_t cap, const void* src, size_t n) {
+    unsigned char* op = (unsigned char*)dst;
+    const unsigned char* p = (const unsigned char*)src;
+    if (cap < qlz_frame_bound(n)) return 0;
+    op += _qlz_put_header(op, n);
+    for (size_t at = 0; at < n; at += QLZ_BLOCK)
+        op += _qlz_put_block(op, p + at, n - at < QLZ_BLOCK ? n - at : QLZ_BLOCK);
+    _qlz_put32(op, 0);
+    _qlz_put32(op + 4, _qlz_xxh32(src, n));
+    return (size_t)(op + 8 - (unsigned char*)dst);
+}
+
+// Total decoded size of the frames in src[0..n) if every nonempty one records
+// it, else QLZ_ERROR. Walks block headers only.
+static inline size_t qlz_frame_content_size(const void* src, size_t n) {
+    const unsigned char* p = (const unsigned char*)src;
+    const unsigned char* end = p + n;
+    uint64_t total = 0;
+    while (p < end) {
+        _qlz_frame f;
+        if (end - p >= 8 && (_qlz_le32(p) & 0xFFFFFFF0u) == _QLZ_SKIP_MAGIC) {
+            uint32_t skip = _qlz_le32(p + 4);
+            if ((size_t)(end - p - 8) < skip) return QLZ_ERROR;
+            p += 8 + skip;
+            continue;
+        }
+        size_t h = _qlz_get_header(p, (size_t)(end - p), &f);
+        if (h == 0 || h == QLZ_ERROR) return QLZ_ERROR;
+        p += h;
+        for (;;) {
+            uint32_t b;
+            if (end - p < 4) return QLZ_ERROR;
+            b = _qlz_le32(p) & 0x7FFFFFFFu;
+            p += 4;
+            if (!b) break;
+            if (!(f.flags & _QLZ_F_SIZE)) return QLZ_ERROR;   // Only an empty frame may leave it out.
+            b += f.flags & _QLZ_F_BLOCK_SUM ? 4 : 0;
+            if ((size_t)(end - p) < b) return QLZ_ERROR;
+            p += b;
+        }
+        p += f.flags & _QLZ_F_SUM ? 4 : 0;
+        if (p > end) return QLZ_ERROR;
+        total += f.content_size;
+    }
+    return total > (uint64_t)(QLZ_ERROR - 1) ? QLZ_ERROR : (size_t)total;
+}
+
+// Decodes every frame in src[0..n) into dst. Returns the decoded size, or
+// QLZ_ERROR if the input is malformed, fails a checksum or exceeds cap.
+static inline size_t qlz_frame_decompress(void* dst, size_t cap, const void* src, size_t n) {
+    const unsigned char* p = (const unsigned char*)src;
+    const unsigned char* end = p + n;
+    unsigned char* out = (unsigned char*)dst;
+    unsigned char* oend = out + cap;
+    unsigned char* op = out;
+    while (p < end) {
+        _qlz_frame f;
+        unsigned char* frame_start = op;
+        if (end - p >= 8 && (_qlz_le32(p) & 0xFFFFFFF0u) == _QLZ_SKIP_MAGIC) {
+            uint32_t skip = _qlz_le32(p + 4);
+            if ((size_t)(end - p - 8) < skip) return QLZ_ERROR;
+            p += 8 + skip;
+            continue;
+        }
+        size_t h = _qlz_get_header(p, (size_t)(end - p), &f);
+        _qlz_xxh xxh;
+        if (h == 0 || h == QLZ_ERROR) return QLZ_ERROR;
+        p += h;
+        _qlz_xxh_init(&xxh);
+        for (;;) {
+            uint32_t raw, b;
+            size_t got;
+            if (end - p < 4) return QLZ_ERROR;
+            raw = _qlz_le32(p);
+            b = raw & 0x7FFFFFFFu;
+            p += 4;
+            if (!b) break;
+            if (b > f.block_max || (size_t)(end - p) < b + (f.flags & _QLZ_F_BLOCK_SUM ? 4 : 0)) return QLZ_ERROR;
+            if ((f.flags & _QLZ_F_BLOCK_SUM) && _qlz_le32(p + b) != _qlz_xxh32(p, b)) return QLZ_ERROR;
+            if (raw & 0x80000000u) {
+                if (b > (size_t)(oend - op)) return QLZ_ERROR;
+                memcpy(op, p, b);
+                got = b;
+            } else {
+                unsigned char* lim = (size_t)(oend - op) > f.block_max ? op + f.block_max : oend;
+                got = _qlz_decode(f.flags & _QLZ_F_INDEP ? op : frame_start, op, lim, p, b);
+                if (got == QLZ_ERROR) return QLZ_ERROR;
+            }
+            // Checksum each block while it is still in cache.
+            if (f.flags & _QLZ_F_SUM) _qlz_xxh_update(&xxh, op, got);
+            op += got;
+            p += b + (f.flags & _QLZ_F_BLOCK_SUM ? 4 : 0);
+        }
+        if ((f.flags & _QLZ_F_SIZE) && (uint64_t)(op - frame_start) != f.content_size) return QLZ_ERROR;
+        if (f.flags & _QLZ_F_SUM) {
+            if (end - p < 4 || _qlz_le32(p) != _qlz_xxh_digest(&xxh)) return QLZ_ERROR;
+            p += 4;
+        }
+    }
+    return (size_t)(op - out);
+}
+
+// Streaming encoder: input of any chunk sizes is cut into QLZ_BLOCK blocks.
+typedef struct {
+    unsigned char buf[QLZ_BLOCK];
+    size_t len;
+    int started;
+    uint64_t content_size, total;
+    _qlz_xxh xxh;
+} qlz_enc;
+
+// content_size is written to the header when nonzero; the input must then add up to it.
+static inline void qlz_enc_init(qlz_enc* e, uint64_t content_size) {
+    e->len = 0;
+    e->started = 0;
+    e->content_size = content_size;
+    e->total = 0;
+    _qlz_xxh_init(&e->xxh);
+}
+
+// Room qlz_enc_update needs for n input bytes; qlz_enc_bound(0) suffices for qlz_enc_final.
+static inline size_t qlz_enc_bound(size_t n) { return (n / QLZ_BLOCK + 1) * (QLZ_BLOCK + 4) + 23; }
+
+// Returns bytes written to dst: the header on the first call, then each block completed.
+static inline size_t qlz_enc_update(qlz_enc* e, void* dst, const void* src, size_t n) {
+    unsigned char* op = (unsigned char*)dst;
+    const unsigned char* p = (const unsigned char*)src;
+    if (!e->started) { op += _qlz_put_header(op, e->content_size); e->started = 1; }
+    _qlz_xxh_update(&e->xxh, p, n);
+    e->total += n;
+    if (e->len) {
+        size_t fill = QLZ_BLOCK - e->len < n ? QLZ_BLOCK - e->len : n;
+        memcpy(e->buf + e->len, p, fill);
+        e->len += fill; p += fill; n -= fill;
+        if (e->len < QLZ_BLOCK) return (size_t)(op - (unsigned char*)dst);
+        op += _qlz_put_block(op, e->buf, QLZ_BLOCK);
+        e->len = 0;
+    }
+    for (; n >= QLZ_BLOCK; p += QLZ_BLOCK, n -= QLZ_BLOCK) op += _qlz_put_block(op, p, QLZ_BLOCK);
+    memcpy(e->buf, p, n);
+    e->len = n;
+    return (size_t)(op - (unsigned char*)dst);
+}
+
+// Flushes the last block and ends the frame. Returns bytes written, or
+// QLZ_ERROR if a declared content size was not met.
+static inline size_t qlz_enc_final(qlz_enc* e, void* dst) {
+    unsigned char* op = (unsigned char*)dst;
+    if (e->content_size && e->total != e->content_size) return QLZ_ERROR;
+    if (!e->started) { op += _qlz_put_header(op, e->content_size); e->started = 1; }
+    if (e->len) op += _qlz_put_block(op, e->buf, e->len);
+    e->len = 0;
+    _qlz_put32(op, 0);
+    _qlz_put32(op + 4, _qlz_xxh_digest(&e->xxh));
+    return (size_t)(op + 8 - (unsigned char*)dst);
+}
+
+// Streaming decoder for frames in any chunk sizes, including lz4's linked
+// blocks and block checksums. Buffers come from QOL_MALLOC; see qlz_dec_free.
+typedef struct {
+    int stage;
+    _qlz_frame f;
+    unsigned char hdr[19];
+    size_t have, need;
+    uint32_t block;                  // Current block header.
+    unsigned char* in;               // Block being gathered.
+    unsigned char* out;              // 64 KB history (linked blocks), then the decoded block.
+    size_t in_cap, out_cap, out_pos, out_end;
+    uint64_t produced, skip;
+    _qlz_xxh xxh;
+} qlz_dec;
+
+enum { _QLZ_MAGIC_S, _QLZ_HEADER_S, _QLZ_BLOCK_S, _QLZ_DATA_S, _QLZ_SUM_S, _QLZ_SKIP_LEN_S, _QLZ_SKIP_S, _QLZ_END_S };
+
+static inline void qlz_dec_init(qlz_dec* d) {
+    memset(d, 0, sizeof(*d));
+    d->need = 4;
+}
+
+static inline void qlz_dec_free(qlz_dec* d) {
+    QOL_FREE(d->in);
+    QOL_FREE(d->out);
+    d->in = d->out = NULL;
+    d->in_cap = d->out_cap = 0;
+}
+
+// Moves up to *dst_n decoded bytes to dst and consumes up to *src_n bytes of
+// src; both are updated to the amounts used. Returns 1 at the end of a frame
+// (call again with the rest of the input for a following frame), 0 when it
+// needs more input or output room, and -1 on corrupt input.
+static inline int qlz_dec_update(qlz_dec* d, void* dst, size_t* dst_n, const void* src, size_t* src_n) {
+    const unsigned char* p = (const unsigned char*)src;
+    const unsigned char* end = p + *src_n;
+    unsigned char* op = (unsigned char*)dst;
+    unsigned char* oend = op + *dst_n;
+    int status = 0;
+    for (;;) {
+        // Hand out decoded bytes before decoding more.
+        if (d->out_pos < d->out_end) {
+            size_t c = d->out_end - d->out_pos < (size_t)(oend - op) ? d->out_end - d->out_pos : (size_t)(oend - op);
+            memcpy(op, d->out + d->out_pos, c);
+            op += c; d->out_pos += c;
+            if (d->out_pos < d->out_end) break;
+        }
+        if (d->stage == _QLZ_END_S) {
+            d->stage = _QLZ_MAGIC_S; d->need = 4; d->have = 0;
+            status = 1;
+            break;
+        }
+        if (d->stage == _QLZ_SKIP_S) {
+            size_t c = (uint64_t)(end - p) < d->skip ? (size_t)(end - p) : (size_t)d->skip;
+            p += c; d->skip -= c;
+            if (d->skip) break;
+            d->stage = _QLZ_END_S;
+            continue;
+        }
+        if (d->stage == _QLZ_DATA_S) {
+            size_t b = d->block & 0x7FFFFFFFu, total = b + (d->f.flags & _QLZ_F_BLOCK_SUM ? 4 : 0);
+            const unsigned char* blk;
+            size_t got, at;
+            // Whole independent block at hand and room for it: decode in place.
+            if (d->have == 0 && (size_t)(end - p) >= total && (d->f.flags & _QLZ_F_INDEP) &&
+                !(d->block & 0x80000000u) && (size_t)(oend - op) >= d->f.block_max) {
+                if ((d->f.flags & _QLZ_F_BLOCK_SUM) && _qlz_le32(p + b) != _qlz_xxh32(p, b)) return -1;
+                got = _qlz_decode(op, op, op + d->f.block_max, p, b);
+                if (got == QLZ_ERROR) return -1;
+                _qlz_xxh_update(&d->xxh, op, got);
+                d->produced += got;
+                op += got; p += total;
+                d->stage = _QLZ_BLOCK_S; d->need = 4; d->have = 0;
+                continue;
+            }
+            if (d->have == 0 && (size_t)(end - p) >= total) blk = p;
+            else {
+                size_t c = total - d->have < (size_t)(end - p) ? total - d->have : (size_t)(end - p);
+                memcpy(d->in + d->have, p, c);
+                d->have += c; p += c;
+                if (d->have < total) break;
+                blk = d->in;
+            }
+            if ((d->f.flags & _QLZ_F_BLOCK_SUM) && _qlz_le32(blk + b) != _qlz_xxh32(blk, b)) return -1;
+            // Linked blocks keep the last 64 KB of output in front as history.
+            at = 0;
+            if (!(d->f.flags & _QLZ_F_INDEP)) {
+                at = d->out_end;
+                if (at > 65536) { memmove(d->out, d->out + at - 65536, 65536); at = 65536; }
+            }
+            if (d->block & 0x80000000u) { memcpy(d->out + at, blk, b); got = b; }
+            else {
+                got = _qlz_decode(d->out, d->out + at, d->out + at + d->f.block_max, blk, b);
+                if (got == QLZ_ERROR) return -1;
+            }
+            _qlz_xxh_update(&d->xxh, d->out + at, got);
+            d->produced += got;
+            d->out_pos = at; d->out_end = at + got;
+            if (blk == p) p += total;
+            d->stage = _QLZ_BLOCK_S; d->need = 4; d->have = 0;
+            continue;
+        }
+        // Fixed-size fields gather into hdr.
+        {
+            size_t c = d->need - d->have < (size_t)(end - p) ? d->need - d->have : (size_t)(end - p);
+            memcpy(d->hdr + d->have, p, c);
+            d->have += c; p += c;
+            if (d->have < d->need) break;
+        }
+        if (d->stage == _QLZ_MAGIC_S) {
+            uint32_t m = _qlz_le32(d->hdr);
+            if ((m & 0xFFFFFFF0u) == _QLZ_SKIP_MAGIC) { d->stage = _QLZ_SKIP_LEN_S; d->need = 8; continue; }
+            if (m != _QLZ_MAGIC) return -1;
+            d->stage = _QLZ_HEADER_S; d->need = 7;
+        } else if (d->stage == _QLZ_SKIP_LEN_S) {
+            d->skip = _qlz_le32(d->hdr + 4);
+            d->stage = _QLZ_SKIP_S;
+        } else if (d->stage == _QLZ_HEADER_S) {
+            size_t h = _qlz_get_header(d->hdr, d->have, &d->f);
+            if (h == QLZ_ERROR) return -1;
+            if (h == 0) { d->need = 15; continue; }
+            {
+                size_t in_cap = d->f.block_max + 4;
+                size_t out_cap = d->f.block_max + (d->f.flags & _QLZ_F_INDEP ? 0 : 65536);
+                if (in_cap > d->in_cap || out_cap > d->out_cap) {
+                    qlz_dec_free(d);
+                    d->in = (unsigned char*)QOL_MALLOC(in_cap);
+                    d->out = (unsigned char*)QOL_MALLOC(out_cap);
+                    if (!d->in || !d->out) { qlz_dec_free(d); return -1; }
+                    d->in_cap = in_cap;
+                    d->out_cap = out_cap;
+                }
+            }
+            d->out_pos = d->out_end = 0;
+            d->produced = 0;
+            _qlz_xxh_init(&d->xxh);
+            d->stage = _QLZ_BLOCK_S; d->need = 4; d->have = 0;
+        } else if (d->stage == _QLZ_BLOCK_S) {
+            d->block = _qlz_le32(d->hdr);
+            d->have = 0;
+            if (d->block == 0) {
+                if (d->f.flags & _QLZ_F_SIZE && d->produced != d->f.content_size) return -1;
+                if (d->f.flags & _QLZ_F_SUM) { d->stage = _QLZ_SUM_S; d->need = 4; }
+                else d->stage = _QLZ_END_S;
+            } else {
+                if ((d->block & 0x7FFFFFFFu) > d->f.block_max) return -1;
+                d->stage = _QLZ_DATA_S;
+            }
+        } else if (d->stage == _QLZ_SUM_S) {
+            if (_qlz_le32(d->hdr) != _qlz_xxh_digest(&d->xxh)) return -1;
+            d->stage = _QLZ_END_S;
+        }
+    }
+    *dst_n = (size_t)(op - (unsigned char*)dst);
+    *src_n -= (size_t)(end - p);
+    return status;
+}
+
+static inline int _fs_put_frame(const char* filename, const char* mode, const void* data, size_t n) {
+    char clean_path[256]; strncpy(clean_path, filename, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
+    FILE* f = fopen(clean_path, mode);
+    if (!f) return 0;
+    qlz_enc* e = (qlz_enc*)QOL_MALLOC(sizeof(qlz_enc));
+    size_t cap = qlz_enc_bound(QLZ_BLOCK);
+    unsigned char* out = (unsigned char*)QOL_MALLOC(cap);
+    const unsigned char* p = (const unsigned char*)data;
+    int ok = e && out;
+    if (ok) {
+        qlz_enc_init(e, n);
+        // Whole blocks at a time keep memory flat however large data is.
+        for (size_t at = 0; ok && at < n; at += QLZ_BLOCK) {
+            size_t got = qlz_enc_update(e, out, p + at, n - at < QLZ_BLOCK ? n - at : QLZ_BLOCK);
+            ok = fwrite(out, 1, got, f) == got;
+        }
+        if (ok) {
+            size_t got = qlz_enc_final(e, out);
+            ok = fwrite(out, 1, got, f) == got;
+        }
+    }
+    QOL_FREE(out);
+    QOL_FREE(e);
+    if (fclose(f) != 0) ok = 0;
+    return ok;
+}
+
+// Writes data as an LZ4 frame, replacing the file. Returns 1 on success.
+static inline int fs_write_compressed(const char* filename, const void* data, size_t n) {
+    return _fs_put_frame(filename, "wb", data, n);
+}
+
+// Appends data as one more frame; fs_read_compressed returns all of them joined.
+static inline int fs_append_compressed(const char* filename, const void* data, size_t n) {
+    return _fs_put_frame(filename, "ab", data, n);
+}
+
+// Reads a file of LZ4 frames (ours or lz4's). Returns the decoded bytes plus a
+// trailing NUL, to be freed by the caller, and stores the length in *out_len if
+// given. NULL if the file is missing or corrupt.
+static inline char* fs_read_compressed(const char* filename, size_t* out_len) {
+    char clean_path[256]; strncpy(clean_path, filename, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
+    FILE* f = fopen(clean_path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    unsigned char* src = size >= 0 ? (unsigned char*)QOL_MALLOC((size_t)size + 1) : NULL;
+    if (!src || fread(src, 1, (size_t)size, f) != (size_t)size) { QOL_FREE(src); fclose(f); return NULL; }
+    fclose(f);
+    char* out = NULL;
+    size_t len = qlz_frame_content_size(src, (size_t)size);
+    if (len != QLZ_ERROR) {
+        // Every frame records its size: decode in one pass straight into the result.
+        out = (char*)QOL_MALLOC(len + 1);
+        if (out && qlz_frame_decompress(out, len, src, (size_t)size) != len) { QOL_FREE(out); out = NULL; }
+    } else {
+        // Otherwise stream, doubling the output as needed.
+        qlz_dec d;
+        size_t cap = (size_t)size * 3 + 256, in_at = 0;
+        int status = 1;
+        qlz_dec_init(&d);
+        out = (char*)QOL_MALLOC(cap + 1);
+        len = 0;
+        while (out) {
+            size_t dst_n = cap - len, src_n = (size_t)size - in_at;
+            status = qlz_dec_update(&d, out + len, &dst_n, src + in_at, &src_n);
+            len += dst_n; in_at += src_n;
+            if (status < 0) break;
+            if (in_at == (size_t)size && (status == 1 || (dst_n == 0 && src_n == 0))) break;
+            if (len == cap) {
+                char* grown = (char*)QOL_REALLOC(out, cap * 2 + 1);
+                if (!grown) { QOL_FREE(out); out = NULL; break; }
+                out = grown;
+                cap *= 2;
+            }
+        }
+        // Input that ends mid-frame is truncated.
+        if (out && (status != 1 || in_at != (size_t)size)) { QOL_FREE(out); out = NULL; }
+        qlz_dec_free(&d);
+    }
+    QOL_FREE(src);
+    if (!out) return NULL;
+    out[len] = 0;
+    if (out_len) *out_len = len;
+    return out;
+}
+
+#endif
+
+
+/* Source: SimpleHTTP/simple_http.h */
+#ifndef SIMPLE_HTTP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* --- Platform Detection & Cross-Platform Sleep --- */
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    #include <windows.h>
+    #pragma comment(lib, "ws2_32.lib")
+    typedef SOCKET http_fd;
+    #define usleep(us) Sleep((us)/1000)
+    #define sleep(s) Sleep((s)*1000)
+#else
+    #include <unistd.h>
+    #include <arpa/inet.h>
+    #include <sys/socket.h>
+    #include <netdb.h>
+    #include <fcntl.h>
+    typedef int http_fd;
+    #define INVALID_SOCKET -1
+#endif
+#if defined(_WIN32) && defined(HTTP_SSL)
+/* * FIX: MSYS2/UCRT Linker Compatibility 
+ * Provides the vsnprintf symbol expected by some OpenSSL static builds
+ * when using vanilla MinGW cross-compilers.
+ */
+#include <stdarg.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+int __cdecl __imp__vsnprintf(char *buffer, size_t count, const char *format, va_list argptr) {
+    return vsnprintf(buffer, count, format, argptr);
+}
+#ifdef __cplusplus
+}
+#endif
+#endif
+/* --- Modular SSL (Server Termination) --- */
+#ifdef HTTP_SSL
+    #include <openssl/ssl.h>
+    #include <openssl/err.h>
+    static SSL_CTX* _http_ssl_srv_ctx = NULL;
+    static int _is_https_srv = 0;
+#endif
+
+/* --- Modular libcurl (Client Support) --- */
+#ifdef HTTP_CURL
+    #include <curl/curl.h>
+    static size_t _curl_write_cb(void *ptr, size_t size, size_t nmemb, void *userdata) {
+        size_t total = size * nmemb;
+        strncat((char*)userdata, (char*)ptr, total);
+        return total;
+    }
+#endif
+
+#ifndef MAX_HTTP_BUF
+#endif
+
+typedef struct {
+    char method[10];
+    char path[256];
+    int client_fd;
+    int active;
+    int verbose;
+#ifdef HTTP_SSL
+    SSL* ssl_handle;
+#endif
+} HttpState;
+
+static HttpState _http_req = {0};
+static http_fd _http_server_fd = INVALID_SOCKET;
+static char _http_buffer[MAX_HTTP_BUF];
+
+/* --- Internal Init --- */
+static inline void _http_init_net() {
+#ifdef _WIN32
+    static int init = 0; if(!init) { WSADATA wsa; WSAStartup(MAKEWORD(2, 2), &wsa); init=1; }
+#endif
+}
+
+/* --- [NEW] The libcurl Client --- */
+static inline char* http_request(const char* url) {
+    memset(_http_buffer, 0, MAX_HTTP_BUF);
+#ifdef HTTP_CURL
+    CURL *curl = curl_easy_init();
+    if(curl) {
+        curl_easy_setopt(curl, CURLOPT_URL, url);
+        curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, _curl_write_cb);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, _http_buffer);
+        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L); // Optional
+        curl_easy_perform(curl);
+        curl_easy_cleanup(curl);
+        return _http_buffer;
+    }
+    return "Error: Curl Init Failed";
+#else
+    return "Error: Define HTTP_CURL to use client functions.";
+#endif
+}
+
+/* --- [NEW] SSL Server Termination --- */
+static inline void http_host_ssl(int port, const char* cert, const char* key) {
+#ifdef HTTP_SSL
+    _http_init_net();
+    SSL_library_init();
+    _http_ssl_srv_ctx = SSL_CTX_new(TLS_server_method());
+    if (SSL_CTX_use_certificate_chain_file(_http_ssl_srv_ctx, cert) <= 0 ||
+        SSL_CTX_use_PrivateKey_file(_http_ssl_srv_ctx, key, SSL_FILETYPE_PEM) <= 0) return;
+    _is_https_srv = 1;
+    _http_server_fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr = {.sin_family = AF_INET, .sin_addr.s_addr = INADDR_ANY, .sin_port = htons(port)};
+    bind(_http_server_fd, (struct sockaddr*)&addr, sizeof(addr));
+    listen(_http_server_fd, 10);
+#endif
+}
+
+/* --- Standard Server Logic --- */
+static inline void http_host(int port) {
+    _http_init_net();
+    _http_server_fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr = {.sin_family = AF_INET, .sin_addr.s_addr = INADDR_ANY, .sin_port = htons(port)};
+    bind(_http_server_fd, (struct sockaddr*)&addr, sizeof(addr));
+    listen(_http_server_fd, 10);
+}
+
+static inline int http_reqready() {
+    if (_http_req.active) return 1;
+    struct sockaddr_in caddr;
+    socklen_t clen = sizeof(caddr);
+    int c_fd = accept(_http_server_fd, (struct sockaddr*)&caddr, &clen);
+    if (c_fd >= 0) {
+        _http_req.client_fd = c_fd;
+#ifdef HTTP_SSL
+        if (_is_https_srv) {
+            _http_req.ssl_handle = SSL_new(_http_ssl_srv_ctx);
+            SSL_set_fd(_http_req.ssl_handle, c_fd);
+            SSL_accept(_http_req.ssl_handle);
+            SSL_read(_http_req.ssl_handle, _http_buffer, MAX_HTTP_BUF-1);
+        } else {
+#endif
+            recv(c_fd, _http_buffer, MAX_HTTP_BUF-1, 0);
+#ifdef HTTP_SSL
+        }
+#endif
+        sscanf(_http_buffer, "%s %s", _http_req.method, _http_req.path);
+        _http_req.active = 1;
+        return 1;
+    }
+    return 0;
+}
+
+static inline void http_reply(const char* html) {
+    char h[512];
+    sprintf(h, "HTTP/1.1 200 OK\r\nContent-Type: text/html\r\nContent-Length: %d\r\n\r\n", (int)strlen(html));
+#ifdef HTTP_SSL
+    if (_http_req.ssl_handle) {
+        SSL_write(_http_req.ssl_handle, h, (int)strlen(h));
+        SSL_write(_http_req.ssl_handle, html, (int)strlen(html));
+        SSL_free(_http_req.ssl_handle);
+        _http_req.ssl_handle = NULL;
+    } else {
+#endif
+        send(_http_req.client_fd, h, (int)strlen(h), 0);
+        send(_http_req.client_fd, html, (int)strlen(html), 0);
+#ifdef HTTP_SSL
+    }
+#endif
+#ifdef _WIN32
+    closesocket(_http_req.client_fd);
+#else
+    close(_http_req.client_fd);
+#endif
+    _http_req.active = 0;
+}
+
+static inline int http_is(const char* p) { return (_http_req.active && strcmp(_http_req.path, p) == 0); }
+
+static inline char* http_param(const char* key) {
+    static char v[256];
+    char s[256]; sprintf(s, "%s=", key);
+    char* st = strstr(_http_buffer, s);
+    if (!st) return NULL;
+    st += strlen(s);
+    char* e = strpbrk(st, " &\r\n");
+    int len = e ? (int)(e - st) : (int)strlen(st);
+    if (len >= 256) len = 255;
+    strncpy(v, st, len); v[len] = 0;
+    return v;
+}
+
+#endif
+
+
+/* Source: SimpleNet/simple_net.h */
+#ifndef SIMPLE_NET_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* --- Platform Shims & Headers --- */
+#ifdef _WIN32
+#define _WIN32_WINNT 0x0600
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <process.h>
+#pragma comment(lib, "ws2_32.lib")
+typedef SOCKET net_fd;
+typedef int socklen_t;
+typedef CRITICAL_SECTION net_mutex;
+#define net_mutex_init(m) InitializeCriticalSection(m)
+#define net_lock(m)      EnterCriticalSection(m)
+#define net_unlock(m)    LeaveCriticalSection(m)
+#define net_close closesocket
+#define net_errno WSAGetLastError()
+#ifndef MSG_DONTWAIT
+#define MSG_DONTWAIT 0
+#endif
+#else
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <pthread.h>
+typedef int net_fd;
+typedef pthread_mutex_t net_mutex;
+#define net_mutex_init(m) pthread_mutex_init(m, NULL)
+#define net_lock(m)      pthread_mutex_lock(m)
+#define net_unlock(m)    pthread_mutex_unlock(m)
+#define net_close close
+#define net_errno errno
+#define INVALID_SOCKET -1
+#endif
+
+/* --- Definitions --- */
+#define UDP 0
+#define TCP 1
+#define MAX_IDS 150
+#define MAX_NET_BUF 65536
+
+typedef struct {
+    char host[128];
+    int port;
+} ClientInfo;
+
+typedef struct {
+    char* data;
+    char host[128];
+    int port;
+} Packet;
+
+/* --- Internal State --- */
+static net_mutex _net_global_lock;
+static net_fd _net_fds[MAX_IDS];
+static int _net_types[MAX_IDS];
+static int _net_active[MAX_IDS];
+static ClientInfo _last_client[MAX_IDS];
+
+/* --- Initialization --- */
+static inline void net_init() {
+    static int init = 0;
+    if (init) return;
+
+    net_mutex_init(&_net_global_lock);
+    net_lock(&_net_global_lock);
+
+    for(int i = 0; i < MAX_IDS; i++) {
+        _net_fds[i] = (net_fd)-1;
+        _net_types[i] = 0;
+        _net_active[i] = 0;
+    }
+
+    #ifdef _WIN32
+    WSADATA wsa;
+    WSAStartup(MAKEWORD(2, 2), &wsa);
+    #endif
+
+    init = 1;
+    net_unlock(&_net_global_lock);
+}
+
+/* --- Core Functions --- */
+
+static inline void closesocket_id(int id) {
+    if (id >= 0 && id < MAX_IDS) {
+        net_lock(&_net_global_lock);
+        if (_net_fds[id] != (net_fd)-1) {
+            net_close(_net_fds[id]);
+            _net_fds[id] = (net_fd)-1;
+            _net_active[id] = 0;
+        }
+        net_unlock(&_net_global_lock);
+    }
+}
+
+static inline int isconnected(int id) {
+    int connected = 0;
+    if (id < 0 || id >= MAX_IDS) return 0;
+
+    net_lock(&_net_global_lock);
+    if (_net_fds[id] == (net_fd)-1) {
+        net_unlock(&_net_global_lock);
+        return 0;
+    }
+    if (_net_types[id] == UDP || _net_active[id] == 0) {
+        net_unlock(&_net_global_lock);
+        return 1;
+    }
+
+    char temp;
+    int res = recv(_net_fds[id], &temp, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (res == 0) connected = 0;
+    else if (res < 0) {
+        #ifdef _WIN32
+        connected = (net_errno == WSAEWOULDBLOCK);
+        #else
+        connected = (errno == EAGAIN || errno == EWOULDBLOCK);
+        #endif
+    } else {
+        connected = 1;
+    }
+
+    net_unlock(&_net_global_lock);
+    return connected;
+}
+
+static inline int opensocket(char* interface, int port, int id, int type) {
+    net_init();
+    if (id < 0 || id >= MAX_IDS) return 0;
+    closesocket_id(id);
+
+    int sock_type = (type == TCP) ? SOCK_STREAM : SOCK_DGRAM;
+    net_fd fd = socket(AF_INET, sock_type, 0);
+    if (fd == (net_fd)-1) return 0;
+
+    #ifdef _WIN32
+    unsigned long m = 1; ioctlsocket(fd, FIONBIO, &m);
+    #else
+    fcntl(fd, F_SETFL, O_NONBLOCK);
+    #endif
+
+    int opt = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, (const char*)&opt, sizeof(opt));
+
+    struct sockaddr_in addr = {0};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = (interface == NULL) ? INADDR_ANY : inet_addr(interface);
+
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        if (type == TCP || port != 0) { net_close(fd); return 0; }
+    }
+
+    if (type == TCP && port != 0) listen(fd, 5);
+
+    net_lock(&_net_global_lock);
+    _net_fds[id] = fd;
+    _net_types[id] = type;
+    _net_active[id] = 0;
+    net_unlock(&_net_global_lock);
+    return 1;
+}
+
+static inline int openudp(char* interface, int port, int id) { return opensocket(interface, port, id, UDP); }
+static inline int opentcp(char* interface, int port, int id) { return opensocket(interface, port, id, TCP); }
+
+static inline int connecttcp(int id, char* host, int port) {
+    net_init();
+    if (id < 0 || id >= MAX_IDS) return 0;
+    closesocket_id(id);
+
+    net_fd fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd == (net_fd)-1) return 0;
+
+    struct hostent *he = gethostbyname(host);
+    if (!he) { net_close(fd); return 0; }
+
+    struct sockaddr_in addr = {0};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    memcpy(&addr.sin_addr.s_addr, he->h_addr, he->h_length);
+
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        #ifdef _WIN32
+        if (net_errno != WSAEWOULDBLOCK) { net_close(fd); return 0; }
+        #else
+        if (errno != EINPROGRESS) { net_close(fd); return 0; }
+        #endif
+    }
+
+    #ifdef _WIN32
+    unsigned long m = 1; ioctlsocket(fd, FIONBIO, &m);
+    #else
+    fcntl(fd, F_SETFL, O_NONBLOCK);
+    #endif
+
+    net_lock(&_net_global_lock);
+    _net_fds[id] = fd;
+    _net_types[id] = TCP;
+    _net_active[id] = 1;
+    net_unlock(&_net_global_lock);
+    return 1;
+}
+
+static inline int senddata(int id, char* host, int port, char* data) {
+    net_init();
+    if (id < 0 || id >= MAX_IDS) return 0;
+
+    net_lock(&_net_global_lock);
+    if (_net_fds[id] == (net_fd)-1) {
+        net_unlock(&_net_global_lock);
+        if (!openudp("0.0.0.0", 0, id)) return 0;
+        net_lock(&_net_global_lock);
+    }
+
+    struct hostent *he = gethostbyname(host);
+    if (!he) { net_unlock(&_net_global_lock); return 0; }
+
+    struct sockaddr_in dest = {0};
+    dest.sin_family = AF_INET;
+    dest.sin_port = htons(port);
+    memcpy(&dest.sin_addr.s_addr, he->h_addr, he->h_length);
+
+    int res = -1;
+    if (_net_types[id] == TCP) {
+        res = send(_net_fds[id], data, (int)strlen(data), 0);
+    } else {
+        res = sendto(_net_fds[id], data, (int)strlen(data), 0, (struct sockaddr*)&dest, sizeof(dest));
+    }
+    net_unlock(&_net_global_lock);
+    return (res >= 0);
+}
+
+/* Updated for thread safety: Pass in a buffer to avoid shared state corruption */
+static inline int receivefrom_safe(int id, char* out_buf, int out_size) {
+    if (id < 0 || id >= MAX_IDS || out_buf == NULL) return -1;
+
+    net_lock(&_net_global_lock);
+    net_fd fd = _net_fds[id];
+    if (fd == (net_fd)-1) { net_unlock(&_net_global_lock); return -1; }
+
+    int bytes = -1;
+    if (_net_types[id] == TCP) {
+        if (_net_active[id] == 1) {
+            bytes = recv(fd, out_buf, out_size - 1, 0);
+        } else {
+            struct sockaddr_in caddr;
+            socklen_t clen = sizeof(caddr);
+            net_fd n_fd = accept(fd, (struct sockaddr*)&caddr, &clen);
+            if (n_fd != (net_fd)-1) {
+                #ifdef _WIN32
+                unsigned long m = 1; ioctlsocket(n_fd, FIONBIO, &m);
+                #else
+                fcntl(n_fd, F_SETFL, O_NONBLOCK);
+                #endif
+                net_close(_net_fds[id]);
+                _net_fds[id] = n_fd;
+                _net_active[id] = 1;
+                strcpy(_last_client[id].host, inet_ntoa(caddr.sin_addr));
+                _last_client[id].port = ntohs(caddr.sin_port);
+                bytes = recv(_net_fds[id], out_buf, out_size - 1, 0);
+            }
+        }
+    } else {
+        struct sockaddr_in src;
+        socklen_t src_len = sizeof(src);
+        bytes = recvfrom(fd, out_buf, out_size - 1, 0, (struct sockaddr*)&src, &src_len);
+        if (bytes > 0) {
+            strcpy(_last_client[id].host, inet_ntoa(src.sin_addr));
+            _last_client[id].port = ntohs(src.sin_port);
+        }
+    }
+
+    if (bytes > 0) out_buf[bytes] = 0;
+    net_unlock(&_net_global_lock);
+    return bytes;
+}
+
+static inline ClientInfo getclientinfo(int id) {
+    ClientInfo info = {"", 0};
+    if (id >= 0 && id < MAX_IDS) {
+        net_lock(&_net_global_lock);
+        info = _last_client[id];
+        net_unlock(&_net_global_lock);
+    }
+    return info;
+}
+
+#endif
+
+
+/* Source: SimpleParse/qol_sv.h */
+#ifndef QOL_SV_H
+
+#include <stddef.h>
+
+// A non-owning slice: ptr need not be NUL-terminated and nothing is freed.
+// Shared by simple_parse.h and simple_tools.h (which has the sv_ functions).
+typedef struct { const char* ptr; size_t len; } qol_sv;
+
+#endif
+
+
+/* Source: SimpleParse/simple_parse.h */
+#ifndef SIMPLE_PARSE_H
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdarg.h>
+
+typedef struct {
+    int byte;
+    int lbyte;
+    int line;
+    char fullstr[256];
+    char str[256];
+    char con[256];
+    void* conparsed[64];
+} Parsed;
+
+#ifndef QOL_H   // QOL.h carries qol_sv.h already.
+    #include "qol_sv.h"
+#endif
+
+/* --- Allocation Hooks --- */
+// libc defaults; QOL_MALLOC / QOL_REALLOC / QOL_FREE and QOL_USE_ALLOC are
+// documented in simple_types.h, which must come first to route through qol_malloc.
+#if defined(QOL_USE_ALLOC) && !defined(QOL_MALLOC)
+    #error "QOL_USE_ALLOC: include simple_types.h before this header (qol_malloc lives there)"
+#endif
+#ifndef QOL_MALLOC
+    #define QOL_MALLOC(n) malloc(n)
+    #define QOL_REALLOC(p, n) realloc(p, n)
+    #define QOL_FREE(p) free(p)
+#endif
+
+/* --- Memory Cleanup --- */
+
+static inline void freeconparsed(Parsed* p) {
+    if (!p) return;
+    for (int i = 0; i < 64; i++) {
+        if (p->conparsed[i] != NULL) {
+            QOL_FREE(p->conparsed[i]);
+            p->conparsed[i] = NULL;
+        }
+    }
+}
+
+/* --- Internal Helpers --- */
+
+static inline int _sp_count_lines(const char* start, const char* end) {
+    int lines = 1;
+    for (const char* p = start; p < end; p++) if (*p == '\n') lines++;
+    return lines;
+}
+
+static inline const char* _sp_get_line_ptr(const char* haystack, int line_num) {
+    if (line_num <= 1) return haystack;
+    const char* p = haystack;
+    int current_line = 1;
+    while (*p) {
+        if (*p == '\n') {
+            current_line++;
+            if (current_line == line_num) return p + 1;
+        }
+        p++;
+    }
+    return NULL;
+}
+
+static inline const char* _sp_find_line_start(const char* haystack, const char* pos) {
+    const char* p = pos;
+    while (p > haystack && *(p - 1) != '\n') p--;
+    return p;
+}
+
+static inline void _sp_tokenize_content(Parsed* p) {
+    char temp[256];
+    strncpy(temp, p->con, 255);
+    char* saveptr;
+    char* token = strtok_r(temp, ",", &saveptr);
+    int i = 0;
+    while (token && i < 64) {
+        while (*token == ' ') token++;
+        if (*token == '"') {
+            char* end = strrchr(token, '"');
+            if (end) *end = '\0';
+            size_t n = strlen(token + 1) + 1;
+            char* str = (char*)QOL_MALLOC(n);
+            if (str) memcpy(str, token + 1, n);
+            p->conparsed[i] = str;
+        } else {
+            int* val = (int*)QOL_MALLOC(sizeof(int));
+            *val = atoi(token);
+            p->conparsed[i] = val;
+        }
+        token = strtok_r(NULL, ",", &saveptr);
+        i++;
+    }
+}
+
+/* --- Core Parsing Logic --- */
+
+static inline int parse(const char* haystack, const char* needle) {
+    return (haystack && needle && strstr(haystack, needle) != NULL);
+}
+
+static inline int parseex(const char* input, const char* format, ...) {
+    if (!input || !format) return 0;
+    va_list args;
+    va_start(args, format);
+    int items = vsscanf(input, format, args);
+    va_end(args);
+    return items;
+}
+
+static inline Parsed advparse(const char* haystack, const char* needle) {
+    Parsed p = { -1, -1, -1, {0}, {0}, {0}, {0} };
+    if (!haystack || !needle) return p;
+    const char* pos = strstr(haystack, needle);
+    if (pos) {
+        p.byte = (int)(pos - haystack);
+        p.line = _sp_count_lines(haystack, pos);
+        p.lbyte = (int)(pos - _sp_find_line_start(haystack, pos));
+        strncpy(p.fullstr, needle, 255);
+    }
+    return p;
+}
+
+static inline Parsed parsecon(const char* haystack, const char* pattern) {
+    Parsed p = { -1, -1, -1, {0}, {0}, {0}, {0} };
+    char fmt[256]; strncpy(fmt, pattern, 255);
+    char* split = strstr(fmt, "%%");
+    if (!split) return p;
+    *split = '\0';
+    char* prefix = fmt; char* suffix = split + 2;
+
+    const char* start_ptr = strstr(haystack, prefix);
+    if (!start_ptr) return p;
+
+    const char* val_start = start_ptr + strlen(prefix);
+    const char* end_ptr = strstr(val_start, suffix);
+    if (!end_ptr) return p;
+
+    p.byte = (int)(start_ptr - haystack);
+    p.line = _sp_count_lines(haystack, start_ptr);
+    p.lbyte = (int)(start_ptr - _sp_find_line_start(haystack, start_ptr));
+
+    int full_len = (int)((end_ptr + strlen(suffix)) - start_ptr);
+    if (full_len > 255) full_len = 255;
+    strncpy(p.fullstr, start_ptr, full_len); p.fullstr[full_len] = '\0';
+    snprintf(p.str, 255, "%s%s", prefix, suffix);
+
+    int con_len = (int)(end_ptr - val_start);
+    if (con_len > 255) con_len = 255;
+    strncpy(p.con, val_start, con_len); p.con[con_len] = '\0';
+
+    _sp_tokenize_content(&p);
+    return p;
+}
+
+/* --- Line Logic --- */
+
+static inline int parseline(const char* haystack, int line_num, char* dest, int max_len) {
+    const char* line_ptr = _sp_get_line_ptr(haystack, line_num);
+    if (!line_ptr) return 0;
+    int i = 0;
+    while (line_ptr[i] && line_ptr[i] != '\n' && line_ptr[i] != '\r' && i < max_len - 1) {
+        dest[i] = line_ptr[i];
+        i++;
+    }
+    dest[i] = '\0';
+    return 1;
+}
+
+static inline Parsed parselineadv(const char* haystack, int line_num) {
+    Parsed p = { -1, 0, line_num, {0}, {0}, {0}, {0} };
+    const char* line_start = _sp_get_line_ptr(haystack, line_num);
+    if (!line_start) return p;
+
+    p.byte = (int)(line_start - haystack);
+    parseline(haystack, line_num, p.fullstr, 256);
+
+    char *open_paren = strchr(p.fullstr, '(');
+    char *close_paren = strrchr(p.fullstr, ')');
+
+    if (open_paren && close_paren && close_paren > open_paren) {
+        int prefix_len = (int)(open_paren - p.fullstr);
+        strncpy(p.str, p.fullstr, prefix_len);
+        p.str[prefix_len] = '\0';
+        strcat(p.str, "()");
+        
+        int con_len = (int)(close_paren - (open_paren + 1));
+        if (con_len > 0) {
+            strncpy(p.con, open_paren + 1, (con_len > 255) ? 255 : con_len);
+            p.con[(con_len > 255) ? 255 : con_len] = '\0';
+            _sp_tokenize_content(&p);
+        }
+    } else {
+        strncpy(p.str, p.fullstr, 255);
+    }
+    return p;
+}
+
+static inline Parsed parselinecon(const char* haystack, int line_num, const char* pattern) {
+    const char* line_ptr = _sp_get_line_ptr(haystack, line_num);
+    if (!line_ptr) { Parsed empty = {-1,-1,-1}; return empty; }
+    Parsed p = parsecon(line_ptr, pattern);
+    if (p.byte != -1) {
+        p.lbyte = p.byte; 
+        p.byte += (int)(line_ptr - haystack); 
+        p.line = line_num;
+    }
+    return p;
+}
+
+/* --- View Logic --- */
+
+// These read an explicit-length buffer and return slices of it: no copies,
+// no allocations, no 256-byte limits. A view with ptr == NULL means not found.
+
+static inline const char* _sp_find(const char* hay, size_t n, const char* needle, size_t nlen) {
+    if (!nlen) return hay;
+    while (n >= nlen) {
+        const char* p = (const char*)memchr(hay, needle[0], n - nlen + 1);
+        if (!p) return NULL;
+        if (memcmp(p, needle, nlen) == 0) return p;
+        n -= (size_t)(p + 1 - hay);
+        hay = p + 1;
+    }
+    return NULL;
+}
+
+// Line line_num (1-based) of text, without its "\n" or "\r\n". An empty view has no lines.
+static inline qol_sv parseline_sv(qol_sv text, int line_num) {
+    qol_sv out = { NULL, 0 };
+    if (!text.ptr || !text.len) return out;
+    const char *p = text.ptr, *end = text.ptr + text.len;
+    for (int line = 1; line < line_num; line++) {
+        p = (const char*)memchr(p, '\n', (size_t)(end - p));
+        if (!p) return out;
+        p++;
+    }
+    const char* eol = (const char*)memchr(p, '\n', (size_t)(end - p));
+    if (!eol) eol = end;
+    if (eol > p && eol[-1] == '\r') eol--;
+    out.ptr = p; out.len = (size_t)(eol - p);
+    return out;
+}
+
+// The content between the two halves of a "prefix%%suffix" pattern, like parsecon's .con.
+static inline qol_sv parsecon_sv(qol_sv text, const char* pattern) {
+    qol_sv out = { NULL, 0 };
+    const char* split = strstr(pattern, "%%");
+    if (!split || !text.ptr || !text.len) return out;
+    const char* suffix = split + 2;
+    size_t plen = (size_t)(split - pattern), slen = strlen(suffix);
+    const char* start = _sp_find(text.ptr, text.len, pattern, plen);
+    if (!start) return out;
+    const char* val = start + plen;
+    const char* stop = _sp_find(val, (size_t)(text.ptr + text.len - val), suffix, slen);
+    if (!stop) return out;
+    out.ptr = val; out.len = (size_t)(stop - val);
+    return out;
+}
+
+// Splits an argument list like parsecon's .con on commas outside quotes. Spaces
+// around each argument are dropped and quoted arguments lose their quotes.
+// Returns the number of arguments found (at most max are stored).
+static inline int parseargs_sv(qol_sv con, qol_sv* args, int max) {
+    const char *p = con.ptr, *end = con.ptr + con.len;
+    int n = 0;
+    if (!p) return 0;
+    while (p <= end) {
+        const char* q = p;
+        int quoted = 0;
+        while (q < end && (quoted || *q != ',')) { if (*q == '"') quoted = !quoted; q++; }
+        const char *a = p, *b = q;
+        while (a < b && (*a == ' ' || *a == '\t')) a++;
+        while (b > a && (b[-1] == ' ' || b[-1] == '\t')) b--;
+        if (b - a >= 2 && *a == '"' && b[-1] == '"') { a++; b--; }
+        if (a < b || q < end || n > 0) {
+            if (n < max) { args[n].ptr = a; args[n].len = (size_t)(b - a); }
+            n++;
+        }
+        p = q + 1;
+    }
+    return n;
+}
+
+#endif
+
+
+/* Source: SimpleThreads/simple_threads.h */
+#ifndef SIMPLE_THREADS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32) || defined(_WIN64)
+    #include <windows.h>
+    typedef HANDLE native_t;
+#else
+    #define _GNU_SOURCE
+    #include <pthread.h>
+    #include <unistd.h>
+    typedef pthread_t native_t;
+#endif
+
+/* --- Allocation Hooks --- */
+// libc defaults; QOL_MALLOC / QOL_REALLOC / QOL_FREE and QOL_USE_ALLOC are
+// documented in simple_types.h, which must come first to route through qol_malloc.
+#if defined(QOL_USE_ALLOC) && !defined(QOL_MALLOC)
+    #error "QOL_USE_ALLOC: include simple_types.h before this header (qol_malloc lives there)"
+#endif
+#ifndef QOL_MALLOC
+    #define QOL_MALLOC(n) malloc(n)
+    #define QOL_REALLOC(p, n) realloc(p, n)
+    #define QOL_FREE(p) free(p)
+#endif
+
+#define MAX_THREADS 256
+static native_t _st_pool[MAX_THREADS] = {0};
+static void* _st_results[MAX_THREADS] = {0};
+
+typedef struct {
+    void* user_fn;
+    char* args_str;
+    int id;
+    int type; 
+    int arg_count; 
+} _st_pkt;
+
+// The spawn packet and its argument copy stay on the C heap: the caller's
+// allocator may be an arena or pool, and the worker thread frees them.
+static char* _st_strdup(const char* s) {
+    if (!s) return NULL;
+    size_t len = strlen(s) + 1;
+    char* d = malloc(len);
+    if (d) memcpy(d, s, len);
+    return d;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI _st_entry(LPVOID p) {
+#else
+static void* _st_entry(void* p) {
+#endif
+    _st_pkt* pkt = (_st_pkt*)p;
+    int i[4] = {0};
+    char s_buf[256] = {0};
+
+    if (pkt->args_str && pkt->args_str[0] == '\"') {
+        sscanf(pkt->args_str, "\"%[^\"]\"", s_buf);
+    } else if (pkt->args_str) {
+        sscanf(pkt->args_str, "%d, %d, %d, %d", &i[0], &i[1], &i[2], &i[3]);
+    }
+
+    if (pkt->type == 1) {
+        int r = 0;
+        if (pkt->arg_count == 0) r = ((int (*)())pkt->user_fn)();
+        else if (pkt->arg_count == 1) r = ((int (*)(int))pkt->user_fn)(i[0]);
+        else r = ((int (*)(int, int))pkt->user_fn)(i[0], i[1]);
+        int* b = QOL_MALLOC(sizeof(int)); *b = r; _st_results[pkt->id] = b;
+    } else {
+        void* r = NULL;
+        if (pkt->arg_count == 0) r = ((void* (*)())pkt->user_fn)();
+        else if (pkt->args_str && pkt->args_str[0] == '\"') r = ((void* (*)(char*))pkt->user_fn)(s_buf);
+        else if (pkt->arg_count == 1) r = ((void* (*)(int))pkt->user_fn)(i[0]);
+        else r = ((void* (*)(int, int))pkt->user_fn)(i[0], i[1]);
+        _st_results[pkt->id] = r;
+    }
+    free(pkt->args_str); free(pkt); return 0;
+}
+
+static inline void _st_spawn(void* fn, char* args, int id, int type, int count) {
+    if (id < 0 || id >= MAX_THREADS) return;
+    _st_pkt* p = malloc(sizeof(_st_pkt));
+    if (!p) return;
+    p->user_fn = fn; p->args_str = _st_strdup(args);
+    p->id = id; p->type = type; p->arg_count = count;
+#ifdef _WIN32
+    _st_pool[id] = CreateThread(NULL, 0, _st_entry, p, 0, NULL);
+#else
+    pthread_create(&_st_pool[id], NULL, _st_entry, p);
+#endif
+}
+
+#define spawnthread(fn, args, id) { \
+    int cnt = 0; \
+    if (strlen(args) > 0) { cnt = 1; for(int _j=0; args[_j]; _j++) if(args[_j]==',') cnt++; } \
+    _st_spawn(fn, args, id, _Generic((fn), \
+        int (*)(): 1, int (*)(int): 1, int (*)(int,int): 1, \
+        int (*)(int,int,int): 1, int (*)(int,int,int,int): 1, \
+        default: 0), cnt); \
+}
+
+static inline int isrunning(int id) {
+    if (id < 0 || id >= MAX_THREADS || !_st_pool[id]) return 0;
+#ifdef _WIN32
+    return WaitForSingleObject(_st_pool[id], 0) == WAIT_TIMEOUT;
+#else
+    return pthread_kill(_st_pool[id], 0) == 0;
+#endif
+}
+
+static inline void* getreturn(int id) {
+    if (id < 0 || id >= MAX_THREADS || !_st_pool[id]) return NULL;
+#ifdef _WIN32
+    WaitForSingleObject(_st_pool[id], INFINITE); CloseHandle(_st_pool[id]);
+#else
+    pthread_join(_st_pool[id], NULL);
+#endif
+    _st_pool[id] = 0; return _st_results[id];
+}
+
+static inline void secondsleep(float s) { 
+#ifdef _WIN32
+    Sleep((int)(s * 1000));
+#else
+    usleep((int)(s * 1000000));
+#endif
+}
+
+static inline void killthread(int id) {
+    if (id >= 0 && id < MAX_THREADS && _st_pool[id]) {
+#ifdef _WIN32
+        TerminateThread(_st_pool[id], 0); CloseHandle(_st_pool[id]);
+#else
+        pthread_cancel(_st_pool[id]);
+#endif
+        _st_pool[id] = 0;
+    }
+}
+
+static inline void bombthreads() { for(int i=0; i<MAX_THREADS; i++) killthread(i); }
+
+#endif
+
+
+/* Source: SimpleTools/simple_tools.h */
+#ifndef SIMPLE_TOOLS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <time.h>
+#include <limits.h>
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__GNUC__) && defined(__SSE2__) && !defined(SIMPLE_TOOLS_NO_SIMD)
+    #define _TOOLS_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(SIMPLE_TOOLS_NO_SIMD)
+    #define _TOOLS_X86_SIMD 1
+    #include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) && defined(__ARM_NEON) && !defined(SIMPLE_TOOLS_NO_SIMD)
+    #define _TOOLS_NEON 1
+    #include <arm_neon.h>
+#endif
+
+/* --- Cross-Platform Compatibility --- */
+
+#ifdef _WIN32
+    #include <windows.h>
+    #include <io.h>
+    #define usleep(us) Sleep((us)/1000)
+    #define sleep(s) Sleep((s)*1000)
+#else
+    #include <unistd.h>
+    #include <pthread.h>
+    #include <sched.h>
+    // localtime_r, clock_gettime and nanosleep are used when <time.h> exposes
+    // them, as glibc, musl and the BSDs do by default. Strict ISO modes such as
+    // -std=c11 hide them; build with -D_DEFAULT_SOURCE (QOL.h sets _GNU_SOURCE)
+    // or get localtime, timespec_get and a yielding qlog writer instead.
+    #ifdef CLOCK_MONOTONIC
+        #define _TOOLS_POSIX_TIME 1
+    #endif
+#endif
+
+/* --- Allocation Hooks --- */
+// libc defaults; QOL_MALLOC / QOL_REALLOC / QOL_FREE and QOL_USE_ALLOC are
+// documented in simple_types.h, which must come first to route through qol_malloc.
+#if defined(QOL_USE_ALLOC) && !defined(QOL_MALLOC)
+    #error "QOL_USE_ALLOC: include simple_types.h before this header (qol_malloc lives there)"
+#endif
+#ifndef QOL_MALLOC
+    #define QOL_MALLOC(n) malloc(n)
+    #define QOL_REALLOC(p, n) realloc(p, n)
+    #define QOL_FREE(p) free(p)
+#endif
+
+#ifndef MAX_HTTP_BUF
+#endif
+
+/* --- String Builder --- */
+
+typedef struct { char* data; size_t len; size_t cap; } qol_sb;
+
+// Makes room for extra bytes plus the NUL. Grows by doubling; returns 0 on allocation failure.
+static inline int sb_reserve(qol_sb* sb, size_t extra) {
+    size_t need = sb->len + extra + 1;
+    if (need <= sb->cap) return 1;
+    size_t cap = sb->cap ? sb->cap : 64;
+    while (cap < need) cap *= 2;
+    char* p = (char*)QOL_REALLOC(sb->data, cap);
+    if (!p) return 0;
+    sb->data = p; sb->cap = cap;
+    return 1;
+}
+
+static inline int sb_append_n(qol_sb* sb, const char* s, size_t n) {
+    if (!sb_reserve(sb, n)) return 0;
+    memcpy(sb->data + sb->len, s, n);
+    sb->len += n;
+    sb->data[sb->len] = '\0';
+    return 1;
+}
+
+static inline int sb_append(qol_sb* sb, const char* s) { return sb_append_n(sb, s, strlen(s)); }
+
+static inline int sb_appendc(qol_sb* sb, char c) {
+    if (sb->len + 2 > sb->cap && !sb_reserve(sb, 1)) return 0;
+    sb->data[sb->len++] = c;
+    sb->data[sb->len] = '\0';
+    return 1;
+}
+
+// Formats straight into the spare capacity (at least 64 bytes); only when that is
+// too small does it grow to the exact size vsnprintf reported and format again.
+static inline int sb_vappendf(qol_sb* sb, const char* fmt, va_list args) {
+    if (!sb_reserve(sb, 64)) return 0;
+    va_list again;
+    va_copy(again, args);
+    size_t room = sb->cap - sb->len;
+    int n = vsnprintf(sb->data + sb->len, room, fmt, args);
+    if (n < 0) { va_end(again); return 0; }
+    if ((size_t)n >= room) {
+        if (!sb_reserve(sb, (size_t)n)) { va_end(again); return 0; }
+        vsnprintf(sb->data + sb->len, (size_t)n + 1, fmt, again);
+    }
+    va_end(again);
+    sb->len += (size_t)n;
+    return 1;
+}
+
+static inline int sb_appendf(qol_sb* sb, const char* fmt, ...) {
+    va_list args; va_start(args, fmt);
+    int ok = sb_vappendf(sb, fmt, args);
+    va_end(args);
+    return ok;
+}
+
+// Empties the builder but keeps its buffer for reuse.
+static inline void sb_reset(qol_sb* sb) { sb->len = 0; if (sb->data) sb->data[0] = '\0'; }
+
+static inline void sb_free(qol_sb* sb) { QOL_FREE(sb->data); sb->data = NULL; sb->len = sb->cap = 0; }
+
+/* --- Hex Dump --- */
+
+// Zero-initialized options give the defaults: 16 bytes per line, an extra gap
+// every 8, offset and ASCII columns on.
+typedef struct {
+    int width;      // bytes per line, 1..256 (0 = 16)
+    int group;      // extra space after every group bytes (0 = 8, >= width for none)
+    int no_offset;  // drop the offset column
+    int no_ascii;   // drop the |ascii| column
+    size_t base;    // offset printed for the first byte
+} qol_hex_opts;
+
+// "00" .. "ff", indexed by byte * 2.
+static const char _hex_pairs[] =
+    "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+    "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+    "404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f"
+    "606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+    "808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f"
+    "a0a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+    "c0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+    "e0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+// Formats one line of n <= width bytes and returns its length. A short last
+// line is padded so its ASCII column lines up with the lines above.
+static inline size_t _hex_line(char* out, const unsigned char* p, size_t n, size_t off, int width, int group, int wide_off, const qol_hex_opts* o) {
+    char* w = out;
+    if (!o->no_offset) {
+        for (int shift = wide_off ? 60 : 28; shift >= 0; shift -= 4) *w++ = "0123456789abcdef"[(off >> shift) & 15];
+        *w++ = ' '; *w++ = ' ';
+    }
+    for (int i = 0; i < width; i++) {
+        if ((size_t)i < n) { memcpy(w, _hex_pairs + p[i] * 2, 2); w[2] = ' '; }
+        else { w[0] = w[1] = w[2] = ' '; }
+        w += 3;
+        if ((i + 1) % group == 0 && i + 1 < width) *w++ = ' ';
+    }
+    if (!o->no_ascii) {
+        *w++ = ' '; *w++ = '|';
+        for (size_t i = 0; i < n; i++) *w++ = (p[i] >= 0x20 && p[i] < 0x7f) ? (char)p[i] : '.';
+        *w++ = '|';
+    } else {
+        while (w > out && w[-1] == ' ') w--;
+    }
+    *w++ = '\n';
+    return (size_t)(w - out);
+}
+
+// Formats whole lines into an 8 KB stack chunk and hands each full chunk to
+// emit, so a sink sees a few large writes instead of one per byte.
+static inline void _hexdump_run(const void* ptr, size_t n, const qol_hex_opts* opts,
+                                void (*emit)(void* ctx, const char* s, size_t len), void* ctx) {
+    qol_hex_opts o;
+    if (opts) o = *opts; else memset(&o, 0, sizeof(o));
+    int width = o.width > 0 && o.width <= 256 ? o.width : 16;
+    int group = o.group > 0 ? o.group : 8;
+    int wide_off = sizeof(size_t) > 4 && (o.base + n) > 0xFFFFFFFFu;
+    size_t max_line = 20 + (size_t)width * 5 + 4;
+    char chunk[8192];
+    size_t used = 0;
+    const unsigned char* p = (const unsigned char*)ptr;
+    for (size_t i = 0; i < n; i += (size_t)width) {
+        size_t take = n - i < (size_t)width ? n - i : (size_t)width;
+        used += _hex_line(chunk + used, p + i, take, o.base + i, width, group, wide_off, &o);
+        if (used + max_line > sizeof(chunk)) { emit(ctx, chunk, used); used = 0; }
+    }
+    if (used) emit(ctx, chunk, used);
+}
+
+static inline void _hex_emit_file(void* ctx, const char* s, size_t len) { fwrite(s, 1, len, (FILE*)ctx); }
+
+static inline void _hex_emit_fd(void* ctx, const char* s, size_t len) {
+    int fd = *(int*)ctx;
+    while (len) {
+#ifdef _WIN32
+        int w = _write(fd, s, (unsigned)len);
+#else
+        ssize_t w = write(fd, s, len);
+#endif
+        if (w <= 0) return;
+        s += w; len -= (size_t)w;
+    }
+}
+
+static inline void _hex_emit_sb(void* ctx, const char* s, size_t len) { sb_append_n((qol_sb*)ctx, s, len); }
+
+// opts may be NULL for the defaults.
+static inline void hexdump_file(FILE* f, const void* ptr, size_t n, const qol_hex_opts* opts) { _hexdump_run(ptr, n, opts, _hex_emit_file, f); }
+static inline void hexdump_fd(int fd, const void* ptr, size_t n, const qol_hex_opts* opts) { _hexdump_run(ptr, n, opts, _hex_emit_fd, &fd); }
+static inline void sb_hexdump(qol_sb* sb, const void* ptr, size_t n, const qol_hex_opts* opts) { _hexdump_run(ptr, n, opts, _hex_emit_sb, sb); }
+
+static inline void hexdmp(void* ptr, int buflen) { if (buflen > 0) hexdump_file(stdout, ptr, (size_t)buflen, NULL); }
+
+/* --- Search & Replace Engine --- */
+
+// Finds needle in hay[0..hay_len). The SSE2 path compares the needle's first and
+// last bytes at 16 positions per step and only calls memcmp where both match.
+static inline const char* _str_find(const char* hay, size_t hay_len, const char* needle, size_t nlen) {
+    if (nlen == 0 || hay_len < nlen) return NULL;
+    if (nlen == 1) return (const char*)memchr(hay, needle[0], hay_len);
+#ifdef _TOOLS_SSE2
+    const __m128i first = _mm_set1_epi8(needle[0]), last = _mm_set1_epi8(needle[nlen - 1]);
+    size_t i = 0;
+    for (; i + nlen - 1 + 16 <= hay_len; i += 16) {
+        __m128i bf = _mm_loadu_si128((const __m128i*)(hay + i));
+        __m128i bl = _mm_loadu_si128((const __m128i*)(hay + i + nlen - 1));
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(bf, first), _mm_cmpeq_epi8(bl, last)));
+        while (mask) {
+            unsigned bit = (unsigned)__builtin_ctz(mask);
+            if (memcmp(hay + i + bit + 1, needle + 1, nlen - 2) == 0) return hay + i + bit;
+            mask &= mask - 1;
+        }
+    }
+    hay += i; hay_len -= i;
+#endif
+    while (hay_len >= nlen) {
+        const char* p = (const char*)memchr(hay, needle[0], hay_len - nlen + 1);
+        if (!p) return NULL;
+        if (memcmp(p + 1, needle + 1, nlen - 1) == 0) return p;
+        hay_len -= (size_t)(p + 1 - hay);
+        hay = p + 1;
+    }
+    return NULL;
+}
+
+// Counts bytes equal to c, 16 at a time on SSE2. Matches are summed per byte lane
+// (at most 255 blocks at a time) and folded with psadbw, which avoids a popcount
+// call on targets built without -mpopcnt.
+static inline size_t _str_count_byte(const char* s, size_t len, char c) {
+    size_t count = 0, i = 0;
+#ifdef _TOOLS_SSE2
+    const __m128i v = _mm_set1_epi8(c), zero = _mm_setzero_si128();
+    while (i + 16 <= len) {
+        size_t blocks = (len - i) / 16;
+        if (blocks > 255) blocks = 255;
+        __m128i acc = zero;
+        for (size_t b = 0; b < blocks; b++, i += 16)
+            acc = _mm_sub_epi8(acc, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(s + i)), v));
+        __m128i sums = _mm_sad_epu8(acc, zero);
+        count += (size_t)_mm_cvtsi128_si32(sums) + (size_t)_mm_cvtsi128_si32(_mm_srli_si128(sums, 8));
+    }
+#endif
+    for (; i < len; i++) count += s[i] == c;
+    return count;
+}
+
+// Pass 1: exact output length when occurrences start_idx..end_idx (1-based) are replaced.
+static inline size_t _str_replace_size(const char* src, size_t src_len, const char* find, size_t find_len,
+                                       size_t replace_len, int start_idx, int end_idx) {
+    size_t hits = 0;
+    if (find_len == 1) {
+        size_t total = _str_count_byte(src, src_len, find[0]);
+        size_t first = start_idx > 1 ? (size_t)start_idx : 1, last = end_idx < 0 ? 0 : (size_t)end_idx;
+        if (last > total) last = total;
+        hits = last >= first ? last - first + 1 : 0;
+    } else {
+        const char* p = src;
+        const char* end = src + src_len;
+        for (int n = 1; n <= end_idx; n++) {
+            const char* pos = _str_find(p, (size_t)(end - p), find, find_len);
+            if (!pos) break;
+            if (n >= start_idx) hits++;
+            p = pos + find_len;
+        }
+    }
+    return src_len - hits * find_len + hits * replace_len;
+}
+
+// Room needed before writing: exact when the replacement is longer than the match,
+// otherwise src_len, so shrinking replacements skip the counting pass.
+static inline size_t _str_replace_bound(const char* src, size_t src_len, const char* find, size_t find_len,
+                                        size_t replace_len, int start_idx, int end_idx) {
+    if (replace_len <= find_len) return src_len;
+    return _str_replace_size(src, src_len, find, find_len, replace_len, start_idx, end_idx);
+}
+
+// Pass 2: writes the result and its NUL into dst and returns the length.
+static inline size_t _str_replace_write(char* dst, const char* src, size_t src_len, const char* find, size_t find_len,
+                                        const char* replace, size_t replace_len, int start_idx, int end_idx) {
+    char* out = dst;
+    const char* p = src;
+    const char* end = src + src_len;
+    for (int n = 1; n <= end_idx; n++) {
+        const char* pos = _str_find(p, (size_t)(end - p), find, find_len);
+        if (!pos) break;
+        size_t keep = (size_t)(pos - p) + (n >= start_idx ? 0 : find_len);
+        memcpy(out, p, keep); out += keep;
+        if (n >= start_idx) { memcpy(out, replace, replace_len); out += replace_len; }
+        p = pos + find_len;
+    }
+    memcpy(out, p, (size_t)(end - p));
+    out += end - p;
+    *out = '\0';
+    return (size_t)(out - dst);
+}
+
+// The engine behind every str_replace_* call: one allocation at the exact size.
+// A shrinking replacement allocates src_len and is trimmed afterwards only when
+// the slack is large, since realloc on a big block can cost more than a pass.
+static inline char* _str_replace_logic(const char* src, const char* find, const char* replace, int start_idx, int end_idx) {
+    if (!src || !find || !replace) return NULL;
+    size_t src_len = strlen(src), find_len = strlen(find), replace_len = strlen(replace);
+    if (find_len == 0) end_idx = 0;
+    size_t bound = _str_replace_bound(src, src_len, find, find_len, replace_len, start_idx, end_idx);
+    char* result = (char*)QOL_MALLOC(bound + 1);
+    if (!result) return NULL;
+    size_t len = _str_replace_write(result, src, src_len, find, find_len, replace, replace_len, start_idx, end_idx);
+    if (bound - len > 4096 && bound - len > bound / 8) {
+        char* trimmed = (char*)QOL_REALLOC(result, len + 1);
+        if (trimmed) result = trimmed;
+    }
+    return result;
+}
+
+// Caller-buffer form. Returns the full result length; dst is only written when
+// cap > that length, so a too-small buffer can be retried at the returned size + 1.
+static inline size_t _str_replace_buf(char* dst, size_t cap, const char* src, const char* find, const char* replace, int start_idx, int end_idx) {
+    if (!src || !find || !replace) return 0;
+    size_t src_len = strlen(src), find_len = strlen(find), replace_len = strlen(replace);
+    if (find_len == 0) end_idx = 0;
+    size_t bound = _str_replace_bound(src, src_len, find, find_len, replace_len, start_idx, end_idx);
+    if (dst && bound < cap) return _str_replace_write(dst, src, src_len, find, find_len, replace, replace_len, start_idx, end_idx);
+    size_t len = replace_len <= find_len ? _str_replace_size(src, src_len, find, find_len, replace_len, start_idx, end_idx) : bound;
+    if (dst && len < cap) _str_replace_write(dst, src, src_len, find, find_len, replace, replace_len, start_idx, end_idx);
+    else if (dst && cap) dst[0] = '\0';
+    return len;
+}
+
+// Builder form: appends the result to sb. Returns 0 on allocation failure.
+static inline int _str_replace_sb(qol_sb* sb, const char* src, const char* find, const char* replace, int start_idx, int end_idx) {
+    if (!src || !find || !replace) return 0;
+    size_t src_len = strlen(src), find_len = strlen(find), replace_len = strlen(replace);
+    if (find_len == 0) end_idx = 0;
+    if (!sb_reserve(sb, _str_replace_bound(src, src_len, find, find_len, replace_len, start_idx, end_idx))) return 0;
+    sb->len += _str_replace_write(sb->data + sb->len, src, src_len, find, find_len, replace, replace_len, start_idx, end_idx);
+    return 1;
+}
 
-/* --- Platform Paths & Directory Headers --- */
-#ifdef _WIN32
-    #include <windows.h>
-    #include <direct.h>
-    #define PATH_SEP '\\'
-    #define ALT_SEP '/'
-    #define mkdir(path, mode) _mkdir(path)
-#else
-    #include <sys/stat.h>
-    #include <dirent.h>
-    #include <unistd.h>
-    #define PATH_SEP '/'
-    #define ALT_SEP '\\'
+/* --- String Replacement API --- */
+
+static inline char* str_replace_first(const char* s, const char* f, const char* r) { return _str_replace_logic(s, f, r, 1, 1); }
+static inline char* str_replace_all(const char* s, const char* f, const char* r)   { return _str_replace_logic(s, f, r, 1, INT_MAX); }
+static inline char* str_replace_nth(const char* s, const char* f, const char* r, int n) { return _str_replace_logic(s, f, r, n, n); }
+static inline char* str_replace_count(const char* s, const char* f, const char* r, int c) { return _str_replace_logic(s, f, r, 1, c); }
+static inline char* str_replace_range(const char* s, const char* f, const char* r, int s_idx, int e_idx) { return _str_replace_logic(s, f, r, s_idx, e_idx); }
+
+static inline size_t str_replace_all_buf(char* dst, size_t cap, const char* s, const char* f, const char* r) { return _str_replace_buf(dst, cap, s, f, r, 1, INT_MAX); }
+static inline size_t str_replace_range_buf(char* dst, size_t cap, const char* s, const char* f, const char* r, int s_idx, int e_idx) { return _str_replace_buf(dst, cap, s, f, r, s_idx, e_idx); }
+static inline int sb_replace_all(qol_sb* sb, const char* s, const char* f, const char* r) { return _str_replace_sb(sb, s, f, r, 1, INT_MAX); }
+static inline int sb_replace_range(qol_sb* sb, const char* s, const char* f, const char* r, int s_idx, int e_idx) { return _str_replace_sb(sb, s, f, r, s_idx, e_idx); }
+
+/* --- Multi-Pattern Replace (Aho-Corasick) --- */
+
+typedef struct { const char* find; const char* replace; } qol_repl;
+
+// A compiled set of find/replace pairs. Build once with ac_build and reuse it
+// for any number of inputs; it keeps its own copies of the replacements.
+// Each state is one row of table: [depth, match, next...], where next holds row
+// offsets so a step is a single add and load.
+typedef struct {
+    unsigned short cls[256]; // byte -> transition column; 0 for bytes in no pattern
+    int stride, nstates, npairs;
+    int* table;
+    size_t* find_len;
+    size_t* rep_len;
+    char** rep;
+} qol_ac;
+
+static inline void ac_free(qol_ac* ac) {
+    if (!ac) return;
+    QOL_FREE(ac->table); QOL_FREE(ac->find_len); QOL_FREE(ac->rep_len); QOL_FREE(ac->rep);
+    QOL_FREE(ac);
+}
+
+// Builds the automaton. Empty find strings are ignored and, for duplicates,
+// the first pair wins. Returns NULL on allocation failure.
+static inline qol_ac* ac_build(const qol_repl* pairs, int n) {
+    if (!pairs || n < 0) return NULL;
+    qol_ac* ac = (qol_ac*)QOL_MALLOC(sizeof(qol_ac));
+    if (!ac) return NULL;
+    memset(ac, 0, sizeof(*ac));
+    size_t total = 1, blob = 0;
+    int nc = 1;
+    for (int i = 0; i < n; i++) {
+        const unsigned char* f = (const unsigned char*)pairs[i].find;
+        for (; *f; f++, total++) if (!ac->cls[*f]) ac->cls[*f] = (unsigned short)nc++;
+        blob += strlen(pairs[i].replace) + 1;
+    }
+    ac->stride = nc + 2; ac->npairs = n;
+
+    ac->table = (int*)QOL_MALLOC(total * ac->stride * sizeof(int));
+    ac->find_len = (size_t*)QOL_MALLOC((n + 1) * sizeof(size_t));
+    ac->rep_len = (size_t*)QOL_MALLOC((n + 1) * sizeof(size_t));
+    ac->rep = (char**)QOL_MALLOC((n + 1) * sizeof(char*) + blob);
+    int* fail = (int*)QOL_MALLOC(total * 2 * sizeof(int));
+    if (!ac->table || !ac->find_len || !ac->rep_len || !ac->rep || !fail) { QOL_FREE(fail); ac_free(ac); return NULL; }
+    int* queue = fail + total;
+    int stride = ac->stride, *t = ac->table;
+
+    // Trie first, in state numbers, with -1 marking the edges the BFS fills in.
+    memset(t, -1, total * stride * sizeof(int));
+    ac->nstates = 1; t[0] = 0;
+    char* store = (char*)(ac->rep + n + 1);
+    for (int i = 0; i < n; i++) {
+        const unsigned char* f = (const unsigned char*)pairs[i].find;
+        int s = 0;
+        for (; *f; f++) {
+            int* edge = &t[s * stride + 2 + ac->cls[*f]];
+            if (*edge < 0) {
+                *edge = ac->nstates;
+                t[ac->nstates++ * stride] = t[s * stride] + 1;
+            }
+            s = *edge;
+        }
+        ac->find_len[i] = (size_t)t[s * stride];
+        ac->rep_len[i] = strlen(pairs[i].replace);
+        ac->rep[i] = store;
+        memcpy(store, pairs[i].replace, ac->rep_len[i] + 1);
+        store += ac->rep_len[i] + 1;
+        if (s && t[s * stride + 1] < 0) t[s * stride + 1] = i;
+    }
+
+    // BFS in depth order: a missing edge borrows the fail state's edge, and the
+    // match inherits the fail state's, so scanning never walks a suffix chain.
+    int head = 0, tail = 0;
+    for (int c = 2; c < stride; c++) {
+        if (t[c] <= 0) t[c] = 0;
+        else { fail[t[c]] = 0; queue[tail++] = t[c]; }
+    }
+    while (head < tail) {
+        int s = queue[head++], *row = t + s * stride, *frow = t + fail[s] * stride;
+        if (row[1] < 0) row[1] = frow[1];
+        for (int c = 2; c < stride; c++) {
+            if (row[c] < 0) row[c] = frow[c];
+            else { fail[row[c]] = frow[c]; queue[tail++] = row[c]; }
+        }
+    }
+    for (int i = 0; i < ac->nstates; i++)
+        for (int c = 2; c < stride; c++) t[i * stride + c] *= stride;
+    QOL_FREE(fail);
+    return ac;
+}
+
+// One pass over src with leftmost-longest semantics: of all matches the one that
+// starts first wins, ties go to the longest, and scanning resumes after it.
+// A match is committed once the automaton's live prefix starts past it, since
+// no longer match from the same start can still appear.
+static inline int _ac_run(const qol_ac* ac, qol_sb* sb, const char* src, size_t len) {
+    const int* t = ac->table;
+    const unsigned short* cls = ac->cls;
+    size_t i = 0, done = 0;
+    if (!sb_reserve(sb, len)) return 0;
+    for (;;) {
+        // No match pending: step until some pattern ends.
+        int state = 0, p = -1;
+        while (i < len) {
+            state = t[state + 2 + cls[(unsigned char)src[i++]]];
+            if ((p = t[state + 1]) >= 0) break;
+        }
+        if (p < 0) break;
+
+        // Pending match: keep extending while a longer or earlier one is still possible.
+        int cand = p;
+        size_t cand_start = i - ac->find_len[p];
+        while (i < len) {
+            state = t[state + 2 + cls[(unsigned char)src[i++]]];
+            if ((p = t[state + 1]) >= 0 && i - ac->find_len[p] <= cand_start) { cand = p; cand_start = i - ac->find_len[p]; }
+            if ((size_t)t[state] < i - cand_start) break;
+        }
+
+        size_t gap = cand_start - done, rl = ac->rep_len[cand];
+        if (!sb_reserve(sb, gap + rl)) return 0;
+        memcpy(sb->data + sb->len, src + done, gap);
+        memcpy(sb->data + sb->len + gap, ac->rep[cand], rl);
+        sb->len += gap + rl;
+        done = i = cand_start + ac->find_len[cand];
+    }
+    return sb_append_n(sb, src + done, len - done);
+}
+
+// Replaces every match of the compiled pairs in one pass. Caller frees.
+static inline char* ac_replace(const qol_ac* ac, const char* src) {
+    if (!ac || !src) return NULL;
+    qol_sb sb = {0};
+    if (!_ac_run(ac, &sb, src, strlen(src))) { sb_free(&sb); return NULL; }
+    return sb.data;
+}
+
+static inline int sb_ac_replace(qol_sb* sb, const qol_ac* ac, const char* src) {
+    return ac && src ? _ac_run(ac, sb, src, strlen(src)) : 0;
+}
+
+// One-shot form: builds, runs and frees an automaton. When the same pairs are
+// applied to many inputs, keep an ac_build result instead.
+static inline char* str_replace_many(const char* src, const qol_repl* pairs, int n) {
+    qol_ac* ac = ac_build(pairs, n);
+    char* result = ac_replace(ac, src);
+    ac_free(ac);
+    return result;
+}
+
+/* --- ASCII Kernels --- */
+
+// Case, digit and whitespace tests are ASCII / C-locale only: bytes >= 0x80
+// are never changed or classified, whatever setlocale says.
+
+// 0 = scalar, 1 = SSE2 or NEON, 2 = AVX2.
+static int _tools_simd = -1;
+
+static inline int tools_simd_level() {
+    if (_tools_simd < 0) {
+        _tools_simd = 0;
+#if defined(_TOOLS_SSE2) || defined(_TOOLS_NEON)
+        _tools_simd = 1;
 #endif
+#ifdef _TOOLS_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) _tools_simd = 2;
+#endif
+    }
+    return _tools_simd;
+}
 
-/* --- Internal Path Normalizer --- */
-static inline void _fs_normalize(char* path) {
-    if (!path) return;
-    for (int i = 0; path[i]; i++) {
-        if (path[i] == ALT_SEP) path[i] = PATH_SEP;
+// Caps the dispatch level (e.g. 0 to force the scalar kernels).
+static inline void tools_simd_limit(int level) {
+    int hw = (_tools_simd = -1, tools_simd_level());
+    _tools_simd = level < hw ? level : hw;
+}
+
+static inline int _ascii_is_digit(unsigned char c) { return (unsigned)(c - '0') < 10; }
+static inline int _ascii_is_space(unsigned char c) { return c == ' ' || (unsigned)(c - 9) < 5; }
+
+// SWAR: 0x80 in each byte of x that lies in [lo, lo + span), for lo + span <= 128.
+// Works on the low 7 bits so no add carries into the next byte.
+static inline unsigned long long _ascii_swar_in_range(unsigned long long x, unsigned char lo, unsigned char span) {
+    const unsigned long long ones = 0x0101010101010101ULL, high = ones * 0x80;
+    unsigned long long h = x & ~high;
+    return (h + ones * (unsigned char)(128 - lo)) & ~(h + ones * (unsigned char)(128 - lo - span)) & ~x & high;
+}
+
+// Flips bit 5 of every byte in [lo, lo + 26): 'A' lowers, 'a' uppers.
+static inline void _ascii_flip_scalar(char* s, size_t n, char lo) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        unsigned long long x;
+        memcpy(&x, s + i, 8);
+        x ^= _ascii_swar_in_range(x, (unsigned char)lo, 26) >> 2;
+        memcpy(s + i, &x, 8);
+    }
+    for (; i < n; i++) {
+        unsigned char c = (unsigned char)s[i];
+        s[i] = (char)(c ^ (((unsigned)(c - (unsigned char)lo) < 26) << 5));
     }
 }
 
-/* --- Core Functions --- */
+#ifdef _TOOLS_SSE2
+// Byte mask of x in [lo, lo + span): bias so lo lands on -128, then one signed compare.
+static inline __m128i _sse2_in_range(__m128i x, char lo, int span) {
+    return _mm_cmplt_epi8(_mm_add_epi8(x, _mm_set1_epi8((char)(128 - lo))), _mm_set1_epi8((char)(span - 128)));
+}
 
-static inline int char_to_int(const void *ptr, int len) {
-    uint32_t hash = 2166136261u;
-    const unsigned char *p = (const unsigned char *)ptr;
-    for (int i = 0; i < len; i++) {
-        hash ^= p[i];
-        hash *= 16777619u;
+static inline unsigned _sse2_space_mask(const char* p) {
+    __m128i x = _mm_loadu_si128((const __m128i*)p);
+    return (unsigned)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(' ')), _sse2_in_range(x, 9, 5)));
+}
+
+static inline size_t _ascii_flip_sse2(char* s, size_t n, char lo) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(s + i));
+        x = _mm_xor_si128(x, _mm_and_si128(_sse2_in_range(x, lo, 26), _mm_set1_epi8(0x20)));
+        _mm_storeu_si128((__m128i*)(s + i), x);
     }
-    return (int)hash;
+    return i;
 }
 
-static inline float char_to_float(const void *ptr, int len) {
-    unsigned int seed = (unsigned int)char_to_int(ptr, len);
-    return (float)seed / (float)0xFFFFFFFF;
+static inline size_t _ascii_digits_sse2(const char* s, size_t n) {
+    for (size_t i = 0; i + 16 <= n; i += 16) {
+        unsigned ok = (unsigned)_mm_movemask_epi8(_sse2_in_range(_mm_loadu_si128((const __m128i*)(s + i)), '0', 10));
+        if (ok != 0xFFFF) return i + (size_t)__builtin_ctz(~ok);
+    }
+    return n & ~(size_t)15;
 }
+#endif
 
-static inline long fs_size(const char* filename) {
-    char clean_path[256]; strncpy(clean_path, filename, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
-    FILE* f = fopen(clean_path, "rb");
-    if (!f) return -1;
-    fseek(f, 0, SEEK_END);
-    long size = ftell(f);
-    fclose(f);
-    return size;
+#ifdef _TOOLS_X86_SIMD
+__attribute__((target("avx2")))
+static inline __m256i _avx2_in_range(__m256i x, char lo, int span) {
+    return _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(span - 128)), _mm256_add_epi8(x, _mm256_set1_epi8((char)(128 - lo))));
 }
 
-static inline char* fs_read(const char* filename) {
-    char clean_path[256]; strncpy(clean_path, filename, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
-    FILE* f = fopen(clean_path, "rb");
-    if (!f) return NULL;
-    fseek(f, 0, SEEK_END);
-    long size = ftell(f);
-    fseek(f, 0, SEEK_SET);
-    char* buffer = (char*)malloc(size + 1);
-    if (!buffer) { fclose(f); return NULL; }
-    fread(buffer, 1, size, f);
-    buffer[size] = 0;
-    fclose(f);
-    return buffer;
+__attribute__((target("avx2")))
+static inline size_t _ascii_flip_avx2(char* s, size_t n, char lo) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(s + i));
+        x = _mm256_xor_si256(x, _mm256_and_si256(_avx2_in_range(x, lo, 26), _mm256_set1_epi8(0x20)));
+        _mm256_storeu_si256((__m256i*)(s + i), x);
+    }
+    return i;
 }
 
-static inline int fs_write(const char* filename, const char* data) {
-    char clean_path[256]; strncpy(clean_path, filename, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
-    FILE* f = fopen(clean_path, "wb");
-    if (!f) return 0;
-    fprintf(f, "%s", data);
-    fclose(f);
-    return 1;
+__attribute__((target("avx2")))
+static inline size_t _ascii_digits_avx2(const char* s, size_t n) {
+    for (size_t i = 0; i + 32 <= n; i += 32) {
+        unsigned ok = (unsigned)_mm256_movemask_epi8(_avx2_in_range(_mm256_loadu_si256((const __m256i*)(s + i)), '0', 10));
+        if (ok != 0xFFFFFFFFu) return i + (size_t)__builtin_ctz(~ok);
+    }
+    return n & ~(size_t)31;
 }
+#endif
 
-static inline int fs_append(const char* filename, const char* data) {
-    char clean_path[256]; strncpy(clean_path, filename, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
-    FILE* f = fopen(clean_path, "ab");
-    if (!f) return 0;
-    fprintf(f, "%s", data);
-    fclose(f);
-    return 1;
+#ifdef _TOOLS_NEON
+// NEON has no movemask; narrowing each byte to a nibble gives a 64-bit mask
+// with 4 bits per byte, so bit positions divide by 4.
+static inline uint64_t _neon_mask(uint8x16_t m) {
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0);
 }
 
-static inline int fs_delete(const char* filename) {
-    char clean_path[256]; strncpy(clean_path, filename, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
-    return remove(clean_path) == 0;
+static inline uint8x16_t _neon_in_range(uint8x16_t x, char lo, int span) {
+    return vcltq_u8(vsubq_u8(x, vdupq_n_u8((unsigned char)lo)), vdupq_n_u8((unsigned char)span));
 }
 
-static inline int fs_exists(const char* filename) {
-    char clean_path[256]; strncpy(clean_path, filename, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
-    FILE* f = fopen(clean_path, "r");
-    if (f) { fclose(f); return 1; }
-    return 0;
+static inline uint64_t _neon_space_mask(const char* p) {
+    uint8x16_t x = vld1q_u8((const uint8_t*)p);
+    return _neon_mask(vorrq_u8(vceqq_u8(x, vdupq_n_u8(' ')), _neon_in_range(x, 9, 5)));
 }
 
-/* --- Directory Functions --- */
+static inline size_t _ascii_flip_neon(char* s, size_t n, char lo) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t x = vld1q_u8((const uint8_t*)(s + i));
+        x = veorq_u8(x, vandq_u8(_neon_in_range(x, lo, 26), vdupq_n_u8(0x20)));
+        vst1q_u8((uint8_t*)(s + i), x);
+    }
+    return i;
+}
 
-static inline int fs_mkdir(const char* path) {
-    if (!path) return 0;
-    char clean_path[256]; strncpy(clean_path, path, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
-    return mkdir(clean_path, 0777) == 0;
+static inline size_t _ascii_digits_neon(const char* s, size_t n) {
+    for (size_t i = 0; i + 16 <= n; i += 16) {
+        uint64_t ok = _neon_mask(_neon_in_range(vld1q_u8((const uint8_t*)(s + i)), '0', 10));
+        if (~ok) return i + (size_t)(__builtin_ctzll(~ok) >> 2);
+    }
+    return n & ~(size_t)15;
 }
+#endif
 
-static inline int fs_dirremove(const char* path) {
-    if (!path) return 0;
-    char clean_path[256]; strncpy(clean_path, path, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
-#ifdef _WIN32
-    WIN32_FIND_DATAA findData;
-    char search_path[280];
-    sprintf(search_path, "%s\\*", clean_path);
-    HANDLE hFind = FindFirstFileA(search_path, &findData);
-    if (hFind == INVALID_HANDLE_VALUE) return 0;
-    do {
-        if (strcmp(findData.cFileName, ".") != 0 && strcmp(findData.cFileName, "..") != 0) {
-            char full_path[512];
-            sprintf(full_path, "%s\\%s", clean_path, findData.cFileName);
-            if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) fs_dirremove(full_path);
-            else DeleteFileA(full_path);
+static inline void _ascii_flip(char* s, size_t n, char lo) {
+    size_t i = 0;
+    int level = tools_simd_level();
+#ifdef _TOOLS_X86_SIMD
+    if (level >= 2) i = _ascii_flip_avx2(s, n, lo);
+#endif
+#ifdef _TOOLS_SSE2
+    if (level >= 1) i += _ascii_flip_sse2(s + i, n - i, lo);
+#endif
+#ifdef _TOOLS_NEON
+    if (level >= 1) i += _ascii_flip_neon(s + i, n - i, lo);
+#endif
+    (void)level;
+    _ascii_flip_scalar(s + i, n - i, lo);
+}
+
+// Number of leading bytes of s[0..n) that are digits.
+static inline size_t _ascii_digits(const char* s, size_t n) {
+    size_t i = 0;
+    int level = tools_simd_level();
+#ifdef _TOOLS_X86_SIMD
+    if (level >= 2) { i = _ascii_digits_avx2(s, n); if (i < (n & ~(size_t)31)) return i; }
+#endif
+#ifdef _TOOLS_SSE2
+    if (level >= 1) { size_t rest = n - i, k = _ascii_digits_sse2(s + i, rest); i += k; if (k < (rest & ~(size_t)15)) return i; }
+#endif
+#ifdef _TOOLS_NEON
+    if (level >= 1) { size_t rest = n - i, k = _ascii_digits_neon(s + i, rest); i += k; if (k < (rest & ~(size_t)15)) return i; }
+#endif
+    (void)level;
+    for (; i + 8 <= n; i += 8) {
+        unsigned long long x;
+        memcpy(&x, s + i, 8);
+        if (_ascii_swar_in_range(x, '0', 10) != 0x8080808080808080ULL) break;
+    }
+    while (i < n && _ascii_is_digit((unsigned char)s[i])) i++;
+    return i;
+}
+
+// Leading / trailing whitespace counts. Runs are usually short, so 16-byte
+// blocks are enough and AVX2 is not worth the dispatch.
+static inline size_t _ascii_lspace(const char* s, size_t n) {
+    size_t i = 0;
+#if defined(_TOOLS_SSE2)
+    if (tools_simd_level() >= 1)
+        for (; i + 16 <= n; i += 16) {
+            unsigned sp = _sse2_space_mask(s + i);
+            if (sp != 0xFFFF) return i + (size_t)__builtin_ctz(~sp);
         }
-    } while (FindNextFileA(hFind, &findData));
-    FindClose(hFind);
-    return RemoveDirectoryA(clean_path) != 0;
-#else
-    DIR* d = opendir(clean_path);
-    if (!d) return 0;
-    struct dirent* p;
-    while ((p = readdir(d))) {
-        if (!strcmp(p->d_name, ".") || !strcmp(p->d_name, "..")) continue;
-        char full_path[512];
-        snprintf(full_path, sizeof(full_path), "%s/%s", clean_path, p->d_name);
-        struct stat statbuf;
-        if (!stat(full_path, &statbuf)) {
-            if (S_ISDIR(statbuf.st_mode)) fs_dirremove(full_path);
-            else unlink(full_path);
+#elif defined(_TOOLS_NEON)
+    if (tools_simd_level() >= 1)
+        for (; i + 16 <= n; i += 16) {
+            uint64_t sp = _neon_space_mask(s + i);
+            if (~sp) return i + (size_t)(__builtin_ctzll(~sp) >> 2);
+        }
+#endif
+    while (i < n && _ascii_is_space((unsigned char)s[i])) i++;
+    return i;
+}
+
+static inline size_t _ascii_rspace(const char* s, size_t n) {
+    size_t end = n;
+#if defined(_TOOLS_SSE2)
+    if (tools_simd_level() >= 1)
+        for (; end >= 16; end -= 16) {
+            unsigned rest = ~_sse2_space_mask(s + end - 16) & 0xFFFF;
+            if (rest) return n - (end - 16 + 32 - (size_t)__builtin_clz(rest));
+        }
+#elif defined(_TOOLS_NEON)
+    if (tools_simd_level() >= 1)
+        for (; end >= 16; end -= 16) {
+            uint64_t rest = ~_neon_space_mask(s + end - 16);
+            if (rest) return n - (end - 16 + (size_t)((64 - __builtin_clzll(rest)) >> 2));
+        }
+#endif
+    while (end > 0 && _ascii_is_space((unsigned char)s[end - 1])) end--;
+    return n - end;
+}
+
+/* --- String Search & Logic --- */
+
+static inline int str_starts(const char* s, const char* prefix) {
+    if (!s || !prefix) return 0;
+    return strncmp(s, prefix, strlen(prefix)) == 0;
+}
+
+static inline int str_ends(const char* s, const char* suffix) {
+    if (!s || !suffix) return 0;
+    size_t slen = strlen(s);
+    size_t flen = strlen(suffix);
+    return slen >= flen && strcmp(s + slen - flen, suffix) == 0;
+}
+
+static inline int str_contains(const char* s, const char* find) {
+    return (s && find) ? strstr(s, find) != NULL : 0;
+}
+
+static inline int str_is_numeric_n(const char* s, size_t n) { return s && n && _ascii_digits(s, n) == n; }
+static inline int str_is_numeric(const char* s) { return s && str_is_numeric_n(s, strlen(s)); }
+
+/* --- String Formatting & Case --- */
+
+static inline void str_lower_n(char* s, size_t n) { _ascii_flip(s, n, 'A'); }
+static inline void str_upper_n(char* s, size_t n) { _ascii_flip(s, n, 'a'); }
+static inline void str_lower(char* s) { str_lower_n(s, strlen(s)); }
+static inline void str_upper(char* s) { str_upper_n(s, strlen(s)); }
+
+// Explicit-length trim: returns the first non-space byte and stores the trimmed
+// length in *len. Nothing is written, so s need not be NUL-terminated.
+static inline char* str_trim_n(char* s, size_t* len) {
+    size_t lead = _ascii_lspace(s, *len);
+    *len -= lead;
+    *len -= _ascii_rspace(s + lead, *len);
+    return s + lead;
+}
+
+static inline char* str_trim(char* s) {
+    size_t len = strlen(s);
+    s = str_trim_n(s, &len);
+    s[len] = '\0';
+    return s;
+}
+
+static inline char* str_format(const char* fmt, ...) {
+    qol_sb sb = {0};
+    va_list args; va_start(args, fmt);
+    int ok = sb_vappendf(&sb, fmt, args);
+    va_end(args);
+    if (!ok) { sb_free(&sb); return NULL; }
+    return sb.data;
+}
+
+/* --- String Views --- */
+
+// qol_sv itself lives in SimpleParse/qol_sv.h so both modules share one type.
+#ifndef QOL_H
+    #include "../SimpleParse/qol_sv.h"
+#endif
+
+#define SV_NPOS ((size_t)-1)
+#define SV(lit) sv_n(lit, sizeof(lit) - 1) // string literals only: length at compile time
+#define SV_FMT "%.*s"
+#define SV_ARG(v) (int)(v).len, (v).ptr
+
+static inline qol_sv sv_n(const char* p, size_t n) { qol_sv v; v.ptr = p; v.len = n; return v; }
+static inline qol_sv sv_from(const char* s) { return sv_n(s, s ? strlen(s) : 0); }
+
+// Clamped to the view: out-of-range starts give an empty view at the end.
+static inline qol_sv sv_sub(qol_sv s, size_t start, size_t len) {
+    if (start > s.len) start = s.len;
+    if (len > s.len - start) len = s.len - start;
+    return sv_n(s.ptr + start, len);
+}
+
+static inline int sv_eq(qol_sv a, qol_sv b) { return a.len == b.len && (a.len == 0 || memcmp(a.ptr, b.ptr, a.len) == 0); }
+static inline int sv_starts(qol_sv s, qol_sv prefix) { return !prefix.len || (s.len >= prefix.len && memcmp(s.ptr, prefix.ptr, prefix.len) == 0); }
+static inline int sv_ends(qol_sv s, qol_sv suffix) { return !suffix.len || (s.len >= suffix.len && memcmp(s.ptr + s.len - suffix.len, suffix.ptr, suffix.len) == 0); }
+
+// Offset of the first match, or SV_NPOS. An empty needle matches at 0.
+static inline size_t sv_find(qol_sv s, qol_sv needle) {
+    if (!needle.len) return 0;
+    const char* p = _str_find(s.ptr, s.len, needle.ptr, needle.len);
+    return p ? (size_t)(p - s.ptr) : SV_NPOS;
+}
+
+static inline size_t sv_find_byte(qol_sv s, char c) {
+    const char* p = s.len ? (const char*)memchr(s.ptr, c, s.len) : NULL;
+    return p ? (size_t)(p - s.ptr) : SV_NPOS;
+}
+
+static inline size_t sv_rfind_byte(qol_sv s, char c) {
+    for (size_t i = s.len; i-- > 0;) if (s.ptr[i] == c) return i;
+    return SV_NPOS;
+}
+
+static inline int sv_contains(qol_sv s, qol_sv needle) { return sv_find(s, needle) != SV_NPOS; }
+
+// Non-overlapping matches, i.e. how many replacements str_replace_all would make.
+static inline size_t sv_count(qol_sv s, qol_sv needle) {
+    if (!needle.len || needle.len > s.len) return 0;
+    if (needle.len == 1) return _str_count_byte(s.ptr, s.len, needle.ptr[0]);
+    size_t n = 0;
+    const char *p = s.ptr, *end = s.ptr + s.len;
+    while ((p = _str_find(p, (size_t)(end - p), needle.ptr, needle.len))) { n++; p += needle.len; }
+    return n;
+}
+
+static inline qol_sv sv_ltrim(qol_sv s) { size_t k = _ascii_lspace(s.ptr, s.len); return sv_n(s.ptr + k, s.len - k); }
+static inline qol_sv sv_rtrim(qol_sv s) { return sv_n(s.ptr, s.len - _ascii_rspace(s.ptr, s.len)); }
+static inline qol_sv sv_trim(qol_sv s) { return sv_rtrim(sv_ltrim(s)); }
+
+// Splits s at the first delim: *before / *after get the two sides (either may
+// be NULL). Returns 0 and leaves them untouched if delim does not occur.
+static inline int sv_cut(qol_sv s, qol_sv delim, qol_sv* before, qol_sv* after) {
+    size_t at = sv_find(s, delim);
+    if (at == SV_NPOS || !delim.len) return 0;
+    if (before) *before = sv_n(s.ptr, at);
+    if (after) *after = sv_n(s.ptr + at + delim.len, s.len - at - delim.len);
+    return 1;
+}
+
+// Tokenizer: stores the next field of *rest in *tok and advances *rest past the
+// delimiter. Returns 0 once the input is used up. Adjacent delimiters give
+// empty fields, and "a,b," yields "a", "b", "".
+//
+//   qol_sv rest = sv_from(csv), f;
+//   while (sv_split_next(&rest, SV(","), &f)) printf(SV_FMT "\n", SV_ARG(f));
+static inline int sv_split_next(qol_sv* rest, qol_sv delim, qol_sv* tok) {
+    if (!rest->ptr) return 0;
+    if (!sv_cut(*rest, delim, tok, rest)) {
+        *tok = *rest;
+        rest->ptr = NULL; rest->len = 0;
+    }
+    return 1;
+}
+
+// Owned, NUL-terminated copy for when a view has to outlive its buffer.
+static inline char* sv_dup(qol_sv s) {
+    char* p = (char*)QOL_MALLOC(s.len + 1);
+    if (!p) return NULL;
+    if (s.len) memcpy(p, s.ptr, s.len);
+    p[s.len] = '\0';
+    return p;
+}
+
+static inline int sb_append_sv(qol_sb* sb, qol_sv s) { return sb_append_n(sb, s.ptr, s.len); }
+
+/* --- URL Codec --- */
+
+// Hex digit value of each byte, 255 for non-hex.
+static const unsigned char _url_hexval[256] = {
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,0,1,2,3,4,5,6,7,8,9,255,255,255,255,255,255,
+    255,10,11,12,13,14,15,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,10,11,12,13,14,15,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+};
+
+// RFC 3986 unreserved bytes: A-Z a-z 0-9 - _ . ~
+static const unsigned char _url_safe[256] = {
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,0,1,1,1,1,1,1,1,1,1,1,0,0,0,0,0,0,
+    0,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0,0,0,0,1,
+    0,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0,0,0,1,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+};
+
+typedef struct { char* key; size_t key_len; char* val; size_t val_len; } qol_url_pair;
+
+// Length of the prefix of s[0..n) that contains no '%' or '+'.
+static inline size_t _url_plain_prefix(const char* s, size_t n) {
+    size_t i = 0;
+#ifdef _TOOLS_SSE2
+    const __m128i pct = _mm_set1_epi8('%'), plus = _mm_set1_epi8('+');
+    for (; i + 16 <= n; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(s + i));
+        unsigned m = (unsigned)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(x, pct), _mm_cmpeq_epi8(x, plus)));
+        if (m) return i + (size_t)__builtin_ctz(m);
+    }
+#endif
+    while (i < n && s[i] != '%' && s[i] != '+') i++;
+    return i;
+}
+
+// Decodes src[0..n) into dst and returns the decoded length; no NUL is written.
+// "+" becomes a space and malformed escapes are copied as-is. dst may equal src
+// (the output never outgrows the input), which makes this an in-place decoder.
+static inline size_t url_decode_n(char* dst, const char* src, size_t n) {
+    size_t i = 0, o = 0;
+    while (i < n) {
+        unsigned char c = (unsigned char)src[i];
+        if (c == '%' && i + 2 < n) {
+            unsigned hi = _url_hexval[(unsigned char)src[i + 1]], lo = _url_hexval[(unsigned char)src[i + 2]];
+            if ((hi | lo) < 16) { dst[o++] = (char)(hi << 4 | lo); i += 3; continue; }
         }
+        if (c == '+') { dst[o++] = ' '; i++; continue; }
+        // A plain run (a malformed '%' counts as its first byte). Short runs
+        // are copied inline; dst never runs ahead of src, so forward copy is safe.
+        size_t run = 1 + _url_plain_prefix(src + i + 1, n - i - 1);
+        if (dst + o != src + i) {
+            if (run < 16) for (size_t k = 0; k < run; k++) dst[o + k] = src[i + k];
+            else memmove(dst + o, src + i, run);
+        }
+        i += run; o += run;
     }
-    closedir(d);
-    return rmdir(clean_path) == 0;
-#endif
+    return o;
 }
 
-/**
- * Returns a piped string "name:type|name:type". 
- * CALLER MUST FREE RESULT.
- */
-static inline char* fs_listdir(const char* path) {
-    if (!path) return NULL;
-    char clean_path[256]; strncpy(clean_path, path, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
+// In-place decode of a NUL-terminated string. Returns the new length.
+static inline size_t url_decode_inplace(char* s) {
+    size_t len = url_decode_n(s, s, strlen(s));
+    s[len] = '\0';
+    return len;
+}
 
-    size_t cap = 1024;
-    char* result = (char*)malloc(cap);
-    if (!result) return NULL;
-    result[0] = '\0';
+static inline char* str_url_decode(const char* src) {
+    if (!src) return NULL;
+    size_t n = strlen(src);
+    char* res = (char*)QOL_MALLOC(n + 1);
+    if (!res) return NULL;
+    res[url_decode_n(res, src, n)] = '\0';
+    return res;
+}
 
-#ifdef _WIN32
-    WIN32_FIND_DATAA findData;
-    char search_path[280];
-    sprintf(search_path, "%s\\*", clean_path);
-    HANDLE hFind = FindFirstFileA(search_path, &findData);
-    if (hFind != INVALID_HANDLE_VALUE) {
-        do {
-            if (strcmp(findData.cFileName, ".") != 0 && strcmp(findData.cFileName, "..") != 0) {
-                int is_dir = (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY);
-                size_t needed = strlen(result) + strlen(findData.cFileName) + 10;
-                if (needed >= cap) { cap *= 2; result = (char*)realloc(result, cap); }
-                if (result[0] != '\0') strcat(result, "|");
-                strcat(result, findData.cFileName);
-                strcat(result, is_dir ? ":dir" : ":file");
-            }
-        } while (FindNextFileA(hFind, &findData));
-        FindClose(hFind);
-    }
-#else
-    DIR* d = opendir(clean_path);
-    if (d) {
-        struct dirent* p;
-        while ((p = readdir(d))) {
-            if (!strcmp(p->d_name, ".") || !strcmp(p->d_name, "..")) continue;
-            char full_path[512];
-            snprintf(full_path, sizeof(full_path), "%s/%s", clean_path, p->d_name);
-            struct stat st;
-            int is_dir = (stat(full_path, &st) == 0 && S_ISDIR(st.st_mode));
-            size_t needed = strlen(result) + strlen(p->d_name) + 10;
-            if (needed >= cap) { cap *= 2; result = (char*)realloc(result, cap); }
-            if (result[0] != '\0') strcat(result, "|");
-            strcat(result, p->d_name);
-            strcat(result, is_dir ? ":dir" : ":file");
-        }
-        closedir(d);
+// Percent-encodes everything outside the RFC 3986 unreserved set (spaces
+// become "+" when form is set). Returns the full encoded length; dst is only
+// written, with a NUL, when cap > that length.
+static inline size_t url_encode_n(char* dst, size_t cap, const char* src, size_t n, int form) {
+    static const char hex[] = "0123456789ABCDEF";
+    size_t len = n;
+    for (size_t i = 0; i < n; i++) len += _url_safe[(unsigned char)src[i]] ? 0 : (form && src[i] == ' ') ? 0 : 2;
+    if (!dst || len >= cap) { if (dst && cap) dst[0] = '\0'; return len; }
+    char* w = dst;
+    for (size_t i = 0; i < n; i++) {
+        unsigned char c = (unsigned char)src[i];
+        if (_url_safe[c]) *w++ = (char)c;
+        else if (form && c == ' ') *w++ = '+';
+        else { w[0] = '%'; w[1] = hex[c >> 4]; w[2] = hex[c & 15]; w += 3; }
     }
-#endif
-    return result;
+    *w = '\0';
+    return len;
 }
 
-/* --- Utility Functions --- */
+static inline char* str_url_encode(const char* src) {
+    if (!src) return NULL;
+    size_t n = strlen(src), len = url_encode_n(NULL, 0, src, n, 0);
+    char* res = (char*)QOL_MALLOC(len + 1);
+    if (!res) return NULL;
+    url_encode_n(res, len + 1, src, n, 0);
+    return res;
+}
 
-static inline int fs_count(const char* data, char target) {
+static inline int sb_url_encode(qol_sb* sb, const char* src, size_t n, int form) {
+    size_t len = url_encode_n(NULL, 0, src, n, form);
+    if (!sb_reserve(sb, len)) return 0;
+    url_encode_n(sb->data + sb->len, len + 1, src, n, form);
+    sb->len += len;
+    return 1;
+}
+
+// Splits a query string ("a=1&b=x%20y", a leading '?' and a trailing "#frag"
+// are skipped) into at most max pairs in one pass. Keys and values are decoded
+// in place and NUL-terminated, so query is modified and the pairs point into
+// it. A key without '=' gets an empty value. Returns the number of pairs.
+static inline int url_query_parse(char* query, qol_url_pair* out, int max) {
+    if (!query) return 0;
+    char* p = query + (*query == '?');
+    char* end = p + strcspn(p, "#");
     int count = 0;
-    for (int i = 0; data[i]; i++) if (data[i] == target) count++;
+    while (p < end && count < max) {
+        char* amp = (char*)memchr(p, '&', (size_t)(end - p));
+        char* stop = amp ? amp : end;
+        if (stop > p) {
+            char* eq = (char*)memchr(p, '=', (size_t)(stop - p));
+            char* kend = eq ? eq : stop;
+            qol_url_pair* pr = &out[count++];
+            pr->key = p;
+            pr->key_len = url_decode_n(p, p, (size_t)(kend - p));
+            pr->val = eq ? eq + 1 : kend;
+            pr->val_len = eq ? url_decode_n(eq + 1, eq + 1, (size_t)(stop - eq - 1)) : 0;
+            pr->key[pr->key_len] = '\0';
+            pr->val[pr->val_len] = '\0';
+        }
+        p = stop + 1;
+    }
     return count;
 }
 
-static inline char* fs_getline(char* data, int line_num) {
-    static char line_buf[512];
-    char* cur = data;
-    for (int i = 0; i < line_num; i++) {
-        cur = strchr(cur, '\n');
-        if (!cur) return NULL;
-        cur++;
-    }
-    char* next = strchr(cur, '\n');
-    int len = next ? (int)(next - cur) : (int)strlen(cur);
-    if (len > 511) len = 511;
-    strncpy(line_buf, cur, len);
-    line_buf[len] = 0;
-    return line_buf;
+/* --- Base64 & Hex Codecs --- */
+
+#define CODEC_ERROR ((size_t)-1)
+
+static const char _b64_std[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char _b64_url[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+// Sextet for each byte of either alphabet. '+' and '/' also carry 0x80, '-' and
+// '_' carry 0x40, and invalid bytes are 255 (both), so one table serves both
+// alphabets: a byte is rejected when it has the other alphabet's bit.
+static const unsigned char _b64_val[256] = {
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 190, 255, 126, 255, 191,
+    52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 255, 255, 255, 255, 255, 255,
+    255, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 255, 255, 255, 255, 127,
+    255, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255
+};
+
+// Encoded size: padded to a multiple of 4 for the standard alphabet, unpadded for URL-safe.
+static inline size_t b64_encoded_len(size_t n, int url) { return url ? n / 3 * 4 + (n % 3 ? n % 3 + 1 : 0) : (n + 2) / 3 * 4; }
+
+// Upper bound on decoded size for n input characters.
+static inline size_t b64_decoded_max(size_t n) { return (n + 3) / 4 * 3; }
+
+#ifdef _TOOLS_X86_SIMD
+// SSSE3 is not part of the x86-64 baseline, so it is checked separately; AVX2 implies it.
+static inline int _tools_ssse3() { return tools_simd_level() >= 1 && __builtin_cpu_supports("ssse3"); }
+
+// Base64 kernels after Muła and Lemire ("Faster Base64 Encoding and Decoding
+// using AVX2 Instructions"): pshufb splits 12 bytes into 16 sextets, a second
+// pshufb turns sextets into offsets for the alphabet, and decoding validates
+// with two nibble lookups before packing with two multiply-adds.
+__attribute__((target("ssse3")))
+static inline __m128i _b64_enc_ssse3_block(__m128i in, __m128i shift_lut) {
+    in = _mm_shuffle_epi8(in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+    __m128i t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+    __m128i idx = _mm_or_si128(t0, t1);
+    // 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12: the slot holding that range's offset.
+    __m128i slot = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+    slot = _mm_or_si128(slot, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), idx), _mm_set1_epi8(13)));
+    return _mm_add_epi8(_mm_shuffle_epi8(shift_lut, slot), idx);
 }
 
-static inline char* fs_readto(const char* filename, int endbyte) {
-    char clean_path[256]; strncpy(clean_path, filename, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
-    FILE* f = fopen(clean_path, "rb");
-    if (!f) return NULL;
-    char* buffer = (char*)malloc(endbyte + 1);
-    if (!buffer) { fclose(f); return NULL; }
-    int bytesRead = (int)fread(buffer, 1, endbyte, f);
-    buffer[bytesRead] = 0;
-    fclose(f);
-    return buffer;
+__attribute__((target("ssse3")))
+static inline size_t _b64_enc_ssse3(char* dst, const unsigned char* src, size_t n, int url) {
+    const __m128i lut = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                      '0' - 52, '0' - 52, '0' - 52, (char)((url ? '-' : '+') - 62), (char)((url ? '_' : '/') - 63), 'A', 0, 0);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 12, dst += 16)
+        _mm_storeu_si128((__m128i*)dst, _b64_enc_ssse3_block(_mm_loadu_si128((const __m128i*)(src + i)), lut));
+    return i;
 }
 
-static inline char* fs_readamount(const char* filename, int startbyte, int endbyte) {
-    char clean_path[256]; strncpy(clean_path, filename, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
-    FILE* f = fopen(clean_path, "rb");
-    if (!f) return NULL;
-    fseek(f, startbyte, SEEK_SET);
-    int amount = endbyte - startbyte;
-    if (amount <= 0) { fclose(f); return NULL; }
-    char* buffer = (char*)malloc(amount + 1);
-    if (!buffer) { fclose(f); return NULL; }
-    int bytesRead = (int)fread(buffer, 1, amount, f);
-    buffer[bytesRead] = 0;
-    fclose(f);
-    return buffer;
+__attribute__((target("avx2")))
+static inline size_t _b64_enc_avx2(char* dst, const unsigned char* src, size_t n, int url) {
+    const __m128i lut128 = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                         '0' - 52, '0' - 52, '0' - 52, (char)((url ? '-' : '+') - 62), (char)((url ? '_' : '/') - 63), 'A', 0, 0);
+    const __m256i lut = _mm256_broadcastsi128_si256(lut128);
+    const __m256i shuf = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                          1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    size_t i = 0;
+    for (; i + 28 <= n; i += 24, dst += 32) {
+        // Two overlapping 16-byte loads put 12 input bytes at the bottom of each lane.
+        __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(src + i))),
+                                             _mm_loadu_si128((const __m128i*)(src + i + 12)), 1);
+        in = _mm256_shuffle_epi8(in, shuf);
+        __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+        __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+        __m256i idx = _mm256_or_si256(t0, t1);
+        __m256i slot = _mm256_subs_epu8(idx, _mm256_set1_epi8(51));
+        slot = _mm256_or_si256(slot, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), idx), _mm256_set1_epi8(13)));
+        _mm256_storeu_si256((__m256i*)dst, _mm256_add_epi8(_mm256_shuffle_epi8(lut, slot), idx));
+    }
+    return i;
+}
+
+// Decode LUTs: lo/hi classify each byte by its nibbles (any common bit = not in
+// the standard alphabet); roll is the offset to add, indexed by the high nibble
+// (minus one for '/').
+#define _B64_DEC_LUTS \
+    0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A
+#define _B64_DEC_LUTH \
+    0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10
+#define _B64_DEC_ROLL \
+    0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0
+
+// Returns the number of input bytes consumed (a multiple of 16); stops early at
+// the first block holding anything but alphabet characters.
+__attribute__((target("ssse3")))
+static inline size_t _b64_dec_ssse3(unsigned char* dst, const char* src, size_t n, int url) {
+    const __m128i lut_lo = _mm_setr_epi8(_B64_DEC_LUTS), lut_hi = _mm_setr_epi8(_B64_DEC_LUTH), lut_roll = _mm_setr_epi8(_B64_DEC_ROLL);
+    const __m128i m2f = _mm_set1_epi8(0x2F);
+    size_t i = 0;
+    for (; i + 24 <= n; i += 16, dst += 12) {
+        __m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+        if (url) {
+            // '-' and '_' become '+' and '/'; a real '+' or '/' is an error.
+            __m128i minus = _mm_cmpeq_epi8(s, _mm_set1_epi8('-')), under = _mm_cmpeq_epi8(s, _mm_set1_epi8('_'));
+            if (_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(s, _mm_set1_epi8('+')), _mm_cmpeq_epi8(s, _mm_set1_epi8('/'))))) break;
+            s = _mm_add_epi8(s, _mm_or_si128(_mm_and_si128(minus, _mm_set1_epi8('+' - '-')), _mm_and_si128(under, _mm_set1_epi8('/' - '_'))));
+        }
+        __m128i hi_nib = _mm_and_si128(_mm_srli_epi32(s, 4), m2f);
+        __m128i bad = _mm_and_si128(_mm_shuffle_epi8(lut_lo, _mm_and_si128(s, m2f)), _mm_shuffle_epi8(lut_hi, hi_nib));
+        if (_mm_movemask_epi8(_mm_cmpgt_epi8(bad, _mm_setzero_si128()))) break;
+        s = _mm_add_epi8(s, _mm_shuffle_epi8(lut_roll, _mm_add_epi8(_mm_cmpeq_epi8(s, m2f), hi_nib)));
+        s = _mm_madd_epi16(_mm_maddubs_epi16(s, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+        s = _mm_shuffle_epi8(s, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        _mm_storeu_si128((__m128i*)dst, s);
+    }
+    return i;
 }
 
+__attribute__((target("avx2")))
+static inline size_t _b64_dec_avx2(unsigned char* dst, const char* src, size_t n, int url) {
+    const __m256i lut_lo = _mm256_setr_epi8(_B64_DEC_LUTS, _B64_DEC_LUTS), lut_hi = _mm256_setr_epi8(_B64_DEC_LUTH, _B64_DEC_LUTH);
+    const __m256i lut_roll = _mm256_setr_epi8(_B64_DEC_ROLL, _B64_DEC_ROLL), m2f = _mm256_set1_epi8(0x2F);
+    const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                          2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    size_t i = 0;
+    for (; i + 48 <= n; i += 32, dst += 24) {
+        __m256i s = _mm256_loadu_si256((const __m256i*)(src + i));
+        if (url) {
+            __m256i minus = _mm256_cmpeq_epi8(s, _mm256_set1_epi8('-')), under = _mm256_cmpeq_epi8(s, _mm256_set1_epi8('_'));
+            if (_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(s, _mm256_set1_epi8('+')), _mm256_cmpeq_epi8(s, _mm256_set1_epi8('/'))))) break;
+            s = _mm256_add_epi8(s, _mm256_or_si256(_mm256_and_si256(minus, _mm256_set1_epi8('+' - '-')), _mm256_and_si256(under, _mm256_set1_epi8('/' - '_'))));
+        }
+        __m256i hi_nib = _mm256_and_si256(_mm256_srli_epi32(s, 4), m2f);
+        if (!_mm256_testz_si256(_mm256_shuffle_epi8(lut_lo, _mm256_and_si256(s, m2f)), _mm256_shuffle_epi8(lut_hi, hi_nib))) break;
+        s = _mm256_add_epi8(s, _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(_mm256_cmpeq_epi8(s, m2f), hi_nib)));
+        s = _mm256_madd_epi16(_mm256_maddubs_epi16(s, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000));
+        s = _mm256_shuffle_epi8(s, pack);
+        _mm256_storeu_si256((__m256i*)dst, _mm256_permutevar8x32_epi32(s, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7)));
+    }
+    return i;
+}
 #endif
 
+// Encodes n bytes; returns the number of characters written (no NUL).
+static inline size_t _b64_enc_run(char* dst, const unsigned char* src, size_t n, int url) {
+    const char* a = url ? _b64_url : _b64_std;
+    char* d = dst;
+    size_t i = 0;
+#ifdef _TOOLS_X86_SIMD
+    if (tools_simd_level() >= 2) i = _b64_enc_avx2(d, src, n, url);
+    else if (_tools_ssse3()) i = _b64_enc_ssse3(d, src, n, url);
+    d += i / 3 * 4;
+#endif
+    for (; i + 3 <= n; i += 3, d += 4) {
+        unsigned v = (unsigned)src[i] << 16 | (unsigned)src[i + 1] << 8 | src[i + 2];
+        d[0] = a[v >> 18]; d[1] = a[v >> 12 & 63]; d[2] = a[v >> 6 & 63]; d[3] = a[v & 63];
+    }
+    if (i < n) {
+        unsigned v = (unsigned)src[i] << 16 | (i + 1 < n ? (unsigned)src[i + 1] << 8 : 0);
+        *d++ = a[v >> 18]; *d++ = a[v >> 12 & 63];
+        if (i + 1 < n) *d++ = a[v >> 6 & 63];
+        else if (!url) *d++ = '=';
+        if (!url) *d++ = '=';
+    }
+    return (size_t)(d - dst);
+}
 
-/* Source: SimpleHTTP/simple_http.h */
-#ifndef SIMPLE_HTTP_H
+// Decodes n characters, a multiple of 4, with no padding. Returns bytes written or CODEC_ERROR.
+static inline size_t _b64_dec_quads(unsigned char* dst, const char* src, size_t n, int url) {
+    const unsigned reject = url ? 0x80 : 0x40;
+    unsigned char* d = dst;
+    size_t i = 0;
+#ifdef _TOOLS_X86_SIMD
+    if (tools_simd_level() >= 2) i = _b64_dec_avx2(d, src, n, url);
+    if (_tools_ssse3()) i += _b64_dec_ssse3(d + i / 4 * 3, src + i, n - i, url);
+    d += i / 4 * 3;
+#endif
+    for (; i < n; i += 4, d += 3) {
+        unsigned a = _b64_val[(unsigned char)src[i]], b = _b64_val[(unsigned char)src[i + 1]];
+        unsigned c = _b64_val[(unsigned char)src[i + 2]], e = _b64_val[(unsigned char)src[i + 3]];
+        if ((a | b | c | e) & reject) return CODEC_ERROR;
+        unsigned v = (a & 63) << 18 | (b & 63) << 12 | (c & 63) << 6 | (e & 63);
+        d[0] = (unsigned char)(v >> 16); d[1] = (unsigned char)(v >> 8); d[2] = (unsigned char)v;
+    }
+    return (size_t)(d - dst);
+}
 
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
+// Final group of 2 or 3 characters (padding already removed).
+static inline size_t _b64_dec_tail(unsigned char* dst, const char* src, size_t n, int url) {
+    const unsigned reject = url ? 0x80 : 0x40;
+    unsigned a = _b64_val[(unsigned char)src[0]], b = _b64_val[(unsigned char)src[1]];
+    unsigned c = n > 2 ? _b64_val[(unsigned char)src[2]] : 0;
+    if (n < 2 || ((a | b | c) & reject)) return CODEC_ERROR;
+    unsigned v = (a & 63) << 18 | (b & 63) << 12 | (c & 63) << 6;
+    dst[0] = (unsigned char)(v >> 16);
+    if (n > 2) dst[1] = (unsigned char)(v >> 8);
+    return n - 1;
+}
 
-/* --- Platform Detection & Cross-Platform Sleep --- */
-#ifdef _WIN32
-    #include <winsock2.h>
-    #include <ws2tcpip.h>
-    #include <windows.h>
-    #pragma comment(lib, "ws2_32.lib")
-    typedef SOCKET http_fd;
-    #define usleep(us) Sleep((us)/1000)
-    #define sleep(s) Sleep((s)*1000)
-#else
-    #include <unistd.h>
-    #include <arpa/inet.h>
-    #include <sys/socket.h>
-    #include <netdb.h>
-    #include <fcntl.h>
-    typedef int http_fd;
-    #define INVALID_SOCKET -1
-#endif
-#if defined(_WIN32) && defined(HTTP_SSL)
-/* * FIX: MSYS2/UCRT Linker Compatibility 
- * Provides the vsnprintf symbol expected by some OpenSSL static builds
- * when using vanilla MinGW cross-compilers.
- */
-#include <stdarg.h>
-#ifdef __cplusplus
-extern "C" {
-#endif
-int __cdecl __imp__vsnprintf(char *buffer, size_t count, const char *format, va_list argptr) {
-    return vsnprintf(buffer, count, format, argptr);
+// Writes the encoding of src[0..n) and a NUL into dst (b64_encoded_len + 1 bytes).
+// url selects the URL-safe alphabet (- and _) without padding.
+static inline size_t b64_encode(char* dst, const void* src, size_t n, int url) {
+    size_t len = _b64_enc_run(dst, (const unsigned char*)src, n, url);
+    dst[len] = '\0';
+    return len;
 }
-#ifdef __cplusplus
+
+// Decodes n characters into dst (b64_decoded_max(n) bytes). Padding is optional
+// in both alphabets. Returns the byte count, or CODEC_ERROR on a character
+// outside the alphabet, misplaced '=' or an impossible length.
+static inline size_t b64_decode(void* dst, const char* src, size_t n, int url) {
+    size_t body = n;
+    if (body && src[body - 1] == '=') body--;
+    if (body && src[body - 1] == '=') body--;
+    if ((body != n && n % 4) || body % 4 == 1) return CODEC_ERROR;
+    size_t full = body & ~(size_t)3;
+    size_t out = _b64_dec_quads((unsigned char*)dst, src, full, url);
+    if (out == CODEC_ERROR || full == body) return out;
+    size_t tail = _b64_dec_tail((unsigned char*)dst + out, src + full, body - full, url);
+    return tail == CODEC_ERROR ? tail : out + tail;
 }
-#endif
-#endif
-/* --- Modular SSL (Server Termination) --- */
-#ifdef HTTP_SSL
-    #include <openssl/ssl.h>
-    #include <openssl/err.h>
-    static SSL_CTX* _http_ssl_srv_ctx = NULL;
-    static int _is_https_srv = 0;
-#endif
 
-/* --- Modular libcurl (Client Support) --- */
-#ifdef HTTP_CURL
-    #include <curl/curl.h>
-    static size_t _curl_write_cb(void *ptr, size_t size, size_t nmemb, void *userdata) {
-        size_t total = size * nmemb;
-        strncat((char*)userdata, (char*)ptr, total);
-        return total;
-    }
-#endif
+static inline char* str_b64_encode(const void* src, size_t n, int url) {
+    char* out = (char*)QOL_MALLOC(b64_encoded_len(n, url) + 1);
+    if (out) b64_encode(out, src, n, url);
+    return out;
+}
 
-#ifndef MAX_HTTP_BUF
-#endif
+static inline int sb_b64_encode(qol_sb* sb, const void* src, size_t n, int url) {
+    if (!sb_reserve(sb, b64_encoded_len(n, url))) return 0;
+    sb->len += b64_encode(sb->data + sb->len, src, n, url);
+    return 1;
+}
 
-typedef struct {
-    char method[10];
-    char path[256];
-    int client_fd;
-    int active;
-    int verbose;
-#ifdef HTTP_SSL
-    SSL* ssl_handle;
-#endif
-} HttpState;
+// Streaming: feed any chunk sizes; up to 2 input bytes (encode) or 3 characters
+// (decode) are carried between calls.
+typedef struct { unsigned char carry[4]; int n; int url; int done; } qol_b64_stream;
+
+static inline void b64_stream_init(qol_b64_stream* st, int url) { memset(st, 0, sizeof(*st)); st->url = url; }
+
+// dst must hold b64_encoded_len(n + 2, 0) bytes. Returns characters written.
+static inline size_t b64_encode_update(qol_b64_stream* st, char* dst, const void* src, size_t n) {
+    const unsigned char* s = (const unsigned char*)src;
+    size_t out = 0;
+    if (st->n) {
+        while (st->n < 3 && n) { st->carry[st->n++] = *s++; n--; }
+        if (st->n < 3) return 0;
+        out = _b64_enc_run(dst, st->carry, 3, st->url);
+        st->n = 0;
+    }
+    size_t whole = n / 3 * 3;
+    out += _b64_enc_run(dst + out, s, whole, st->url);
+    for (size_t i = whole; i < n; i++) st->carry[st->n++] = s[i];
+    return out;
+}
 
-static HttpState _http_req = {0};
-static http_fd _http_server_fd = INVALID_SOCKET;
-static char _http_buffer[MAX_HTTP_BUF];
+// Flushes the last 1-2 bytes (with padding for the standard alphabet) and a NUL.
+static inline size_t b64_encode_final(qol_b64_stream* st, char* dst) {
+    size_t out = _b64_enc_run(dst, st->carry, (size_t)st->n, st->url);
+    dst[out] = '\0';
+    st->n = 0;
+    return out;
+}
 
-/* --- Internal Init --- */
-static inline void _http_init_net() {
-#ifdef _WIN32
-    static int init = 0; if(!init) { WSADATA wsa; WSAStartup(MAKEWORD(2, 2), &wsa); init=1; }
-#endif
+// Decodes one complete group that may end in padding.
+static inline size_t _b64_dec_group(qol_b64_stream* st, unsigned char* dst, const char* g) {
+    if (g[3] != '=') return _b64_dec_quads(dst, g, 4, st->url);
+    st->done = 1;
+    return _b64_dec_tail(dst, g, g[2] == '=' ? 2 : 3, st->url);
 }
 
-/* --- [NEW] The libcurl Client --- */
-static inline char* http_request(const char* url) {
-    memset(_http_buffer, 0, MAX_HTTP_BUF);
-#ifdef HTTP_CURL
-    CURL *curl = curl_easy_init();
-    if(curl) {
-        curl_easy_setopt(curl, CURLOPT_URL, url);
-        curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, _curl_write_cb);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, _http_buffer);
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L); // Optional
-        curl_easy_perform(curl);
-        curl_easy_cleanup(curl);
-        return _http_buffer;
+// dst must hold b64_decoded_max(n + 3) bytes. Returns bytes written or CODEC_ERROR.
+static inline size_t b64_decode_update(qol_b64_stream* st, void* dst, const char* src, size_t n) {
+    unsigned char* d = (unsigned char*)dst;
+    size_t out = 0, r;
+    if (n && st->done) return CODEC_ERROR;
+    if (st->n) {
+        while (st->n < 4 && n) { st->carry[st->n++] = (unsigned char)*src++; n--; }
+        if (st->n < 4) return 0;
+        st->n = 0;
+        if ((r = _b64_dec_group(st, d, (const char*)st->carry)) == CODEC_ERROR) return r;
+        out = r;
+        if (n && st->done) return CODEC_ERROR;
     }
-    return "Error: Curl Init Failed";
-#else
-    return "Error: Define HTTP_CURL to use client functions.";
-#endif
+    size_t whole = n & ~(size_t)3;
+    if (whole) {
+        size_t body = src[whole - 1] == '=' ? whole - 4 : whole;
+        if ((r = _b64_dec_quads(d + out, src, body, st->url)) == CODEC_ERROR) return r;
+        out += r;
+        if (body != whole) {
+            if ((r = _b64_dec_group(st, d + out, src + body)) == CODEC_ERROR || n != whole) return CODEC_ERROR;
+            out += r;
+        }
+    }
+    for (size_t i = whole; i < n; i++) st->carry[st->n++] = (unsigned char)src[i];
+    return out;
 }
 
-/* --- [NEW] SSL Server Termination --- */
-static inline void http_host_ssl(int port, const char* cert, const char* key) {
-#ifdef HTTP_SSL
-    _http_init_net();
-    SSL_library_init();
-    _http_ssl_srv_ctx = SSL_CTX_new(TLS_server_method());
-    if (SSL_CTX_use_certificate_chain_file(_http_ssl_srv_ctx, cert) <= 0 ||
-        SSL_CTX_use_PrivateKey_file(_http_ssl_srv_ctx, key, SSL_FILETYPE_PEM) <= 0) return;
-    _is_https_srv = 1;
-    _http_server_fd = socket(AF_INET, SOCK_STREAM, 0);
-    struct sockaddr_in addr = {.sin_family = AF_INET, .sin_addr.s_addr = INADDR_ANY, .sin_port = htons(port)};
-    bind(_http_server_fd, (struct sockaddr*)&addr, sizeof(addr));
-    listen(_http_server_fd, 10);
-#endif
+// Decodes an unpadded final group of 2-3 characters, if any.
+static inline size_t b64_decode_final(qol_b64_stream* st, void* dst) {
+    size_t n = (size_t)st->n;
+    st->n = 0;
+    return n ? _b64_dec_tail((unsigned char*)dst, (const char*)st->carry, n, st->url) : 0;
 }
 
-/* --- Standard Server Logic --- */
-static inline void http_host(int port) {
-    _http_init_net();
-    _http_server_fd = socket(AF_INET, SOCK_STREAM, 0);
-    struct sockaddr_in addr = {.sin_family = AF_INET, .sin_addr.s_addr = INADDR_ANY, .sin_port = htons(port)};
-    bind(_http_server_fd, (struct sockaddr*)&addr, sizeof(addr));
-    listen(_http_server_fd, 10);
+#ifdef _TOOLS_SSE2
+// Nibbles to '0'-'9' / 'a'-'f'.
+static inline __m128i _hex_sse2_chars(__m128i nib) {
+    return _mm_add_epi8(nib, _mm_add_epi8(_mm_set1_epi8('0'), _mm_and_si128(_mm_cmpgt_epi8(nib, _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10))));
 }
 
-static inline int http_reqready() {
-    if (_http_req.active) return 1;
-    struct sockaddr_in caddr;
-    socklen_t clen = sizeof(caddr);
-    int c_fd = accept(_http_server_fd, (struct sockaddr*)&caddr, &clen);
-    if (c_fd >= 0) {
-        _http_req.client_fd = c_fd;
-#ifdef HTTP_SSL
-        if (_is_https_srv) {
-            _http_req.ssl_handle = SSL_new(_http_ssl_srv_ctx);
-            SSL_set_fd(_http_req.ssl_handle, c_fd);
-            SSL_accept(_http_req.ssl_handle);
-            SSL_read(_http_req.ssl_handle, _http_buffer, MAX_HTTP_BUF-1);
-        } else {
+// Hex characters to nibbles; *bad collects lanes that are not hex digits.
+static inline __m128i _hex_sse2_nibbles(__m128i c, __m128i* bad) {
+    __m128i lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+    __m128i digit = _sse2_in_range(c, '0', 10), alpha = _sse2_in_range(lower, 'a', 6);
+    *bad = _mm_or_si128(*bad, _mm_andnot_si128(_mm_or_si128(digit, alpha), _mm_set1_epi8(-1)));
+    return _mm_or_si128(_mm_and_si128(digit, _mm_sub_epi8(c, _mm_set1_epi8('0'))),
+                        _mm_and_si128(alpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+}
+
+// Pairs of nibbles (first one high) in each 16-bit lane to bytes.
+static inline __m128i _hex_sse2_pack(__m128i a, __m128i b) {
+    const __m128i low = _mm_set1_epi16(0x00FF);
+    a = _mm_and_si128(_mm_or_si128(_mm_slli_epi16(a, 4), _mm_srli_epi16(a, 8)), low);
+    b = _mm_and_si128(_mm_or_si128(_mm_slli_epi16(b, 4), _mm_srli_epi16(b, 8)), low);
+    return _mm_packus_epi16(a, b);
+}
 #endif
-            recv(c_fd, _http_buffer, MAX_HTTP_BUF-1, 0);
-#ifdef HTTP_SSL
+
+#ifdef _TOOLS_X86_SIMD
+__attribute__((target("avx2")))
+static inline size_t _hex_enc_avx2(char* dst, const unsigned char* src, size_t n) {
+    const __m256i m = _mm256_set1_epi8(0x0F), nine = _mm256_set1_epi8(9);
+    const __m256i zero = _mm256_set1_epi8('0'), gap = _mm256_set1_epi8('a' - '0' - 10);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), m), lo = _mm256_and_si256(v, m);
+        hi = _mm256_add_epi8(hi, _mm256_add_epi8(zero, _mm256_and_si256(_mm256_cmpgt_epi8(hi, nine), gap)));
+        lo = _mm256_add_epi8(lo, _mm256_add_epi8(zero, _mm256_and_si256(_mm256_cmpgt_epi8(lo, nine), gap)));
+        __m256i a = _mm256_unpacklo_epi8(hi, lo), b = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256((__m256i*)(dst + 2 * i), _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256((__m256i*)(dst + 2 * i + 32), _mm256_permute2x128_si256(a, b, 0x31));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static inline size_t _hex_dec_avx2(unsigned char* dst, const char* src, size_t n) {
+    const __m256i low = _mm256_set1_epi16(0x00FF);
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m256i nib[2], bad = _mm256_setzero_si256();
+        for (int k = 0; k < 2; k++) {
+            __m256i c = _mm256_loadu_si256((const __m256i*)(src + i + 32 * k));
+            __m256i lower = _mm256_or_si256(c, _mm256_set1_epi8(0x20));
+            __m256i digit = _avx2_in_range(c, '0', 10), alpha = _avx2_in_range(lower, 'a', 6);
+            bad = _mm256_or_si256(bad, _mm256_andnot_si256(_mm256_or_si256(digit, alpha), _mm256_set1_epi8(-1)));
+            __m256i v = _mm256_or_si256(_mm256_and_si256(digit, _mm256_sub_epi8(c, _mm256_set1_epi8('0'))),
+                                        _mm256_and_si256(alpha, _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10))));
+            nib[k] = _mm256_and_si256(_mm256_or_si256(_mm256_slli_epi16(v, 4), _mm256_srli_epi16(v, 8)), low);
         }
+        if (_mm256_movemask_epi8(bad)) break;
+        // packus works per lane; restore byte order with a 64-bit permute.
+        __m256i out = _mm256_permute4x64_epi64(_mm256_packus_epi16(nib[0], nib[1]), 0xD8);
+        _mm256_storeu_si256((__m256i*)(dst + i / 2), out);
+    }
+    return i;
+}
 #endif
-        sscanf(_http_buffer, "%s %s", _http_req.method, _http_req.path);
-        _http_req.active = 1;
-        return 1;
+
+// Writes 2n lowercase hex digits and a NUL into dst. Returns 2n.
+static inline size_t hex_encode(char* dst, const void* src, size_t n) {
+    const unsigned char* s = (const unsigned char*)src;
+    size_t i = 0;
+#ifdef _TOOLS_X86_SIMD
+    if (tools_simd_level() >= 2) i = _hex_enc_avx2(dst, s, n);
+#endif
+#ifdef _TOOLS_SSE2
+    if (tools_simd_level() >= 1 && n >= 16) {
+        for (; i <= n - 16; i += 16) {
+            __m128i v = _mm_loadu_si128((const __m128i*)(s + i));
+            __m128i hi = _hex_sse2_chars(_mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0F)));
+            __m128i lo = _hex_sse2_chars(_mm_and_si128(v, _mm_set1_epi8(0x0F)));
+            _mm_storeu_si128((__m128i*)(dst + 2 * i), _mm_unpacklo_epi8(hi, lo));
+            _mm_storeu_si128((__m128i*)(dst + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+        }
     }
-    return 0;
+#endif
+    for (; i < n; i++) memcpy(dst + 2 * i, _hex_pairs + 2 * s[i], 2);
+    dst[2 * n] = '\0';
+    return 2 * n;
 }
 
-static inline void http_reply(const char* html) {
-    char h[512];
-    sprintf(h, "HTTP/1.1 200 OK\r\nContent-Type: text/html\r\nContent-Length: %d\r\n\r\n", (int)strlen(html));
-#ifdef HTTP_SSL
-    if (_http_req.ssl_handle) {
-        SSL_write(_http_req.ssl_handle, h, (int)strlen(h));
-        SSL_write(_http_req.ssl_handle, html, (int)strlen(html));
-        SSL_free(_http_req.ssl_handle);
-        _http_req.ssl_handle = NULL;
-    } else {
+// Decodes n hex digits (either case) into n / 2 bytes. Returns the byte count,
+// or CODEC_ERROR for an odd length or a non-hex character.
+static inline size_t hex_decode(void* dst, const char* src, size_t n) {
+    unsigned char* d = (unsigned char*)dst;
+    if (n % 2) return CODEC_ERROR;
+    size_t i = 0;
+#ifdef _TOOLS_X86_SIMD
+    if (tools_simd_level() >= 2) i = _hex_dec_avx2(d, src, n);
 #endif
-        send(_http_req.client_fd, h, (int)strlen(h), 0);
-        send(_http_req.client_fd, html, (int)strlen(html), 0);
-#ifdef HTTP_SSL
+#ifdef _TOOLS_SSE2
+    if (tools_simd_level() >= 1 && n >= 32) {
+        for (; i <= n - 32; i += 32) {
+            __m128i bad = _mm_setzero_si128();
+            __m128i a = _hex_sse2_nibbles(_mm_loadu_si128((const __m128i*)(src + i)), &bad);
+            __m128i b = _hex_sse2_nibbles(_mm_loadu_si128((const __m128i*)(src + i + 16)), &bad);
+            if (_mm_movemask_epi8(bad)) return CODEC_ERROR;
+            _mm_storeu_si128((__m128i*)(d + i / 2), _hex_sse2_pack(a, b));
+        }
     }
 #endif
-#ifdef _WIN32
-    closesocket(_http_req.client_fd);
+    for (; i < n; i += 2) {
+        unsigned hi = _url_hexval[(unsigned char)src[i]], lo = _url_hexval[(unsigned char)src[i + 1]];
+        if ((hi | lo) > 15) return CODEC_ERROR;
+        d[i / 2] = (unsigned char)(hi << 4 | lo);
+    }
+    return n / 2;
+}
+
+/* --- Time Tools --- */
+
+#if defined(_MSC_VER)
+    #define _TOOLS_TLS __declspec(thread)
 #else
-    close(_http_req.client_fd);
+    #define _TOOLS_TLS __thread
 #endif
-    _http_req.active = 0;
-}
 
-static inline int http_is(const char* p) { return (_http_req.active && strcmp(_http_req.path, p) == 0); }
+#define TIME_NOW_LEN 20 // "YYYY-MM-DD HH:MM:SS" plus the NUL
 
-static inline char* http_param(const char* key) {
-    static char v[256];
-    char s[256]; sprintf(s, "%s=", key);
-    char* st = strstr(_http_buffer, s);
-    if (!st) return NULL;
-    st += strlen(s);
-    char* e = strpbrk(st, " &\r\n");
-    int len = e ? (int)(e - st) : (int)strlen(st);
-    if (len >= 256) len = 255;
-    strncpy(v, st, len); v[len] = 0;
-    return v;
-}
+// Each thread keeps the last second it formatted, so a log line only pays for
+// time() and a 20-byte copy; localtime runs at most once per second per thread.
+typedef struct { time_t sec; char text[TIME_NOW_LEN]; } _time_cache;
 
+// Formats sec as local "YYYY-MM-DD HH:MM:SS" into p (TIME_NOW_LEN bytes).
+static inline void _time_format(time_t sec, char* p) {
+    struct tm t;
+#if defined(_WIN32)
+    localtime_s(&t, &sec);
+#elif defined(_TOOLS_POSIX_TIME)
+    localtime_r(&sec, &t);
+#else
+    struct tm* lt = localtime(&sec);
+    memset(&t, 0, sizeof(t));
+    if (lt) t = *lt;
 #endif
+    int v[6] = { t.tm_year + 1900, t.tm_mon + 1, t.tm_mday, t.tm_hour, t.tm_min, t.tm_sec };
+    p[0] = (char)('0' + v[0] / 1000 % 10); p[1] = (char)('0' + v[0] / 100 % 10);
+    p[2] = (char)('0' + v[0] / 10 % 10);   p[3] = (char)('0' + v[0] % 10);
+    for (int i = 1; i < 6; i++) {
+        p[1 + i * 3] = i == 3 ? ' ' : i < 3 ? '-' : ':';
+        p[2 + i * 3] = (char)('0' + v[i] / 10);
+        p[3 + i * 3] = (char)('0' + v[i] % 10);
+    }
+    p[19] = '\0';
+}
 
+static inline const _time_cache* _time_refresh() {
+    static _TOOLS_TLS _time_cache cache = { (time_t)-1, { 0 } };
+    time_t now = time(NULL);
+    if (now != cache.sec) {
+        _time_format(now, cache.text);
+        cache.sec = now;
+    }
+    return &cache;
+}
 
-/* Source: SimpleNet/simple_net.h */
-#ifndef SIMPLE_NET_H
+// Copies the local time as "YYYY-MM-DD HH:MM:SS" into buf (TIME_NOW_LEN bytes).
+static inline char* time_now_r(char* buf) {
+    memcpy(buf, _time_refresh()->text, TIME_NOW_LEN);
+    return buf;
+}
 
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
+// Same text, in a buffer owned by the calling thread (valid until its next call).
+static inline char* time_now() {
+    static _TOOLS_TLS char buf[TIME_NOW_LEN];
+    return time_now_r(buf);
+}
 
-/* --- Platform Shims & Headers --- */
+static inline long time_unix() { return (long)time(NULL); }
+
+// Monotonic nanoseconds for measuring intervals; unrelated to wall-clock time.
+static inline unsigned long long time_mono_ns() {
 #ifdef _WIN32
-#define _WIN32_WINNT 0x0600
-#include <winsock2.h>
-#include <ws2tcpip.h>
-#include <process.h>
-#pragma comment(lib, "ws2_32.lib")
-typedef SOCKET net_fd;
-typedef int socklen_t;
-typedef CRITICAL_SECTION net_mutex;
-#define net_mutex_init(m) InitializeCriticalSection(m)
-#define net_lock(m)      EnterCriticalSection(m)
-#define net_unlock(m)    LeaveCriticalSection(m)
-#define net_close closesocket
-#define net_errno WSAGetLastError()
-#ifndef MSG_DONTWAIT
-#define MSG_DONTWAIT 0
-#endif
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+    if (!freq.QuadPart) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (unsigned long long)(now.QuadPart / freq.QuadPart) * 1000000000ULL +
+           (unsigned long long)(now.QuadPart % freq.QuadPart) * 1000000000ULL / (unsigned long long)freq.QuadPart;
+#elif defined(_TOOLS_POSIX_TIME)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
 #else
-#include <unistd.h>
-#include <arpa/inet.h>
-#include <sys/socket.h>
-#include <netdb.h>
-#include <fcntl.h>
-#include <errno.h>
-#include <pthread.h>
-typedef int net_fd;
-typedef pthread_mutex_t net_mutex;
-#define net_mutex_init(m) pthread_mutex_init(m, NULL)
-#define net_lock(m)      pthread_mutex_lock(m)
-#define net_unlock(m)    pthread_mutex_unlock(m)
-#define net_close close
-#define net_errno errno
-#define INVALID_SOCKET -1
+    struct timespec ts;   // Wall clock: may step, but keeps strict ISO builds working.
+    timespec_get(&ts, TIME_UTC);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
 #endif
+}
 
-/* --- Definitions --- */
-#define UDP 0
-#define TCP 1
-#define MAX_IDS 150
-#define MAX_NET_BUF 65536
-
-typedef struct {
-    char host[128];
-    int port;
-} ClientInfo;
-
-typedef struct {
-    char* data;
-    char host[128];
-    int port;
-} Packet;
-
-/* --- Internal State --- */
-static net_mutex _net_global_lock;
-static net_fd _net_fds[MAX_IDS];
-static int _net_types[MAX_IDS];
-static int _net_active[MAX_IDS];
-static ClientInfo _last_client[MAX_IDS];
+// Raw cycle counter for micro-measurements: the TSC on x86 (constant rate, not
+// core clock), the virtual counter on AArch64, time_mono_ns elsewhere. Only
+// differences on the same machine are meaningful.
+static inline unsigned long long time_cycles() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    return __builtin_ia32_rdtsc();
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return __rdtsc();
+#elif defined(__GNUC__) && defined(__aarch64__)
+    unsigned long long v;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#else
+    return time_mono_ns();
+#endif
+}
 
-/* --- Initialization --- */
-static inline void net_init() {
-    static int init = 0;
-    if (init) return;
+/* --- String Interning --- */
 
-    net_mutex_init(&_net_global_lock);
-    net_lock(&_net_global_lock);
+#ifdef _WIN32
+    typedef SRWLOCK _tools_mutex;
+    #define _tools_mutex_init(m)    InitializeSRWLock(m)
+    #define _tools_mutex_destroy(m) ((void)(m))
+    #define _tools_lock(m)          AcquireSRWLockExclusive(m)
+    #define _tools_unlock(m)        ReleaseSRWLockExclusive(m)
+#else
+    typedef pthread_mutex_t _tools_mutex;
+    #define _tools_mutex_init(m)    pthread_mutex_init(m, NULL)
+    #define _tools_mutex_destroy(m) pthread_mutex_destroy(m)
+    #define _tools_lock(m)          pthread_mutex_lock(m)
+    #define _tools_unlock(m)        pthread_mutex_unlock(m)
+#endif
 
-    for(int i = 0; i < MAX_IDS; i++) {
-        _net_fds[i] = (net_fd)-1;
-        _net_types[i] = 0;
-        _net_active[i] = 0;
-    }
+#if defined(_MSC_VER) && !defined(__clang__)
+    #define _tools_load_ptr(p)     InterlockedCompareExchangePointer((void* volatile*)(p), NULL, NULL)
+    #define _tools_store_ptr(p, v) InterlockedExchangePointer((void* volatile*)(p), (void*)(v))
+#else
+    #define _tools_load_ptr(p)     __atomic_load_n(p, __ATOMIC_ACQUIRE)
+    #define _tools_store_ptr(p, v) __atomic_store_n(p, v, __ATOMIC_RELEASE)
+#endif
 
-    #ifdef _WIN32
-    WSADATA wsa;
-    WSAStartup(MAKEWORD(2, 2), &wsa);
-    #endif
+#define INTERN_BLOCK 65536
 
-    init = 1;
-    net_unlock(&_net_global_lock);
-}
+// Interned strings live in arena blocks and are never moved or freed before
+// intern_free, so the returned pointers are stable handles: two strings are
+// equal exactly when their pointers are. Each string is preceded by its atom
+// and length, which is what intern_atom_of / intern_len read.
+typedef struct _intern_block { struct _intern_block* next; size_t used, cap; } _intern_block;
 
-/* --- Core Functions --- */
+// Slots are written once: hash first, then str with a release store, so lookups
+// run without the lock. A grown table replaces the old one, which stays readable
+// (chained through prev) until intern_free.
+typedef struct { const char* str; unsigned long long hash; } _intern_slot;
+typedef struct _intern_table { struct _intern_table* prev; size_t mask; } _intern_table;
+#define _INTERN_SLOTS(t) ((_intern_slot*)(void*)((t) + 1))
 
-static inline void closesocket_id(int id) {
-    if (id >= 0 && id < MAX_IDS) {
-        net_lock(&_net_global_lock);
-        if (_net_fds[id] != (net_fd)-1) {
-            net_close(_net_fds[id]);
-            _net_fds[id] = (net_fd)-1;
-            _net_active[id] = 0;
+typedef struct {
+    _tools_mutex lock;    // serializes inserts
+    _intern_table* table;
+    unsigned count;
+    const char** strs;    // strs[atom - 1], guarded by lock
+    unsigned strs_cap;
+    _intern_block* blocks;
+} qol_intern;
+
+static inline unsigned long long _intern_hash(const char* s, size_t n) {
+    const unsigned long long k = 0x9E3779B97F4A7C15ULL;
+    unsigned long long h = n * k, w = 0;
+    unsigned lo, hi;
+    if (n >= 8) {
+        const char* end = s + n - 8;
+        for (; s < end; s += 8) {
+            memcpy(&w, s, 8);
+            h = (h ^ w) * k;
+            h ^= h >> 29;
         }
-        net_unlock(&_net_global_lock);
+        memcpy(&w, end, 8); // overlaps the last full word instead of a byte loop
+    } else if (n >= 4) {
+        memcpy(&lo, s, 4); memcpy(&hi, s + n - 4, 4);
+        w = (unsigned long long)hi << 32 | lo;
+    } else if (n) {
+        w = (unsigned char)s[0] | (unsigned)(unsigned char)s[n / 2] << 8 | (unsigned)(unsigned char)s[n - 1] << 16;
     }
+    h = (h ^ w) * k;
+    h ^= h >> 32; h *= 0xD6E8FEB86659FD93ULL; h ^= h >> 32;
+    return h;
 }
 
-static inline int isconnected(int id) {
-    int connected = 0;
-    if (id < 0 || id >= MAX_IDS) return 0;
+static inline const unsigned* _intern_hdr(const char* p) { return (const unsigned*)(const void*)p - 2; }
 
-    net_lock(&_net_global_lock);
-    if (_net_fds[id] == (net_fd)-1) {
-        net_unlock(&_net_global_lock);
-        return 0;
-    }
-    if (_net_types[id] == UDP || _net_active[id] == 0) {
-        net_unlock(&_net_global_lock);
-        return 1;
-    }
+// Atom of an interned pointer; 0 for NULL.
+static inline unsigned intern_atom_of(const char* p) { return p ? _intern_hdr(p)[0] : 0; }
 
-    char temp;
-    int res = recv(_net_fds[id], &temp, 1, MSG_PEEK | MSG_DONTWAIT);
-    if (res == 0) connected = 0;
-    else if (res < 0) {
-        #ifdef _WIN32
-        connected = (net_errno == WSAEWOULDBLOCK);
-        #else
-        connected = (errno == EAGAIN || errno == EWOULDBLOCK);
-        #endif
-    } else {
-        connected = 1;
-    }
+// Length of an interned string without scanning it.
+static inline size_t intern_len(const char* p) { return p ? _intern_hdr(p)[1] : 0; }
 
-    net_unlock(&_net_global_lock);
-    return connected;
+static inline _intern_table* _intern_table_new(size_t cap, _intern_table* prev) {
+    size_t bytes = sizeof(_intern_table) + cap * sizeof(_intern_slot);
+    _intern_table* t = (_intern_table*)QOL_MALLOC(bytes);
+    if (t) { memset(t, 0, bytes); t->prev = prev; t->mask = cap - 1; }
+    return t;
 }
 
-static inline int opensocket(char* interface, int port, int id, int type) {
-    net_init();
-    if (id < 0 || id >= MAX_IDS) return 0;
-    closesocket_id(id);
-
-    int sock_type = (type == TCP) ? SOCK_STREAM : SOCK_DGRAM;
-    net_fd fd = socket(AF_INET, sock_type, 0);
-    if (fd == (net_fd)-1) return 0;
-
-    #ifdef _WIN32
-    unsigned long m = 1; ioctlsocket(fd, FIONBIO, &m);
-    #else
-    fcntl(fd, F_SETFL, O_NONBLOCK);
-    #endif
-
-    int opt = 1;
-    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, (const char*)&opt, sizeof(opt));
+static inline int intern_init(qol_intern* in) {
+    memset(in, 0, sizeof(*in));
+    in->table = _intern_table_new(256, NULL);
+    if (!in->table) return 0;
+    _tools_mutex_init(&in->lock);
+    return 1;
+}
 
-    struct sockaddr_in addr = {0};
-    addr.sin_family = AF_INET;
-    addr.sin_port = htons(port);
-    addr.sin_addr.s_addr = (interface == NULL) ? INADDR_ANY : inet_addr(interface);
+static inline void intern_free(qol_intern* in) {
+    _intern_block* b = in->blocks;
+    while (b) { _intern_block* next = b->next; QOL_FREE(b); b = next; }
+    _intern_table* t = in->table;
+    while (t) { _intern_table* prev = t->prev; QOL_FREE(t); t = prev; }
+    QOL_FREE((void*)in->strs);
+    _tools_mutex_destroy(&in->lock);
+    memset(in, 0, sizeof(*in));
+}
 
-    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
-        if (type == TCP || port != 0) { net_close(fd); return 0; }
+// Returns the slot holding s, or the empty slot where it would go; *found gets
+// the string seen there (NULL for the empty slot).
+static inline _intern_slot* _intern_probe(_intern_table* t, const char* s, size_t n, unsigned long long h, const char** found) {
+    _intern_slot* slots = _INTERN_SLOTS(t);
+    for (size_t i = (size_t)h & t->mask;; i = (i + 1) & t->mask) {
+        const char* p = (const char*)_tools_load_ptr(&slots[i].str);
+        if (!p || (slots[i].hash == h && _intern_hdr(p)[1] == n && memcmp(p, s, n) == 0)) {
+            *found = p;
+            return &slots[i];
+        }
     }
+}
 
-    if (type == TCP && port != 0) listen(fd, 5);
+// Copies s into the arena with its [atom, len] header. Caller holds the lock.
+static inline char* _intern_store(qol_intern* in, const char* s, size_t n, unsigned atom) {
+    size_t need = (2 * sizeof(unsigned) + n + 1 + 7) & ~(size_t)7;
+    _intern_block* b = in->blocks;
+    if (!b || b->cap - b->used < need) {
+        size_t cap = need > INTERN_BLOCK / 4 ? need : INTERN_BLOCK;
+        _intern_block* nb = (_intern_block*)QOL_MALLOC(sizeof(_intern_block) + cap);
+        if (!nb) return NULL;
+        nb->used = 0; nb->cap = cap;
+        // A dedicated block for a long string goes behind the current one so the
+        // current block keeps filling.
+        if (b && cap != INTERN_BLOCK) { nb->next = b->next; b->next = nb; }
+        else { nb->next = b; in->blocks = nb; }
+        b = nb;
+    }
+    unsigned* hdr = (unsigned*)(void*)((char*)(b + 1) + b->used);
+    b->used += need;
+    hdr[0] = atom; hdr[1] = (unsigned)n;
+    char* p = (char*)(hdr + 2);
+    memcpy(p, s, n);
+    p[n] = '\0';
+    return p;
+}
 
-    net_lock(&_net_global_lock);
-    _net_fds[id] = fd;
-    _net_types[id] = type;
-    _net_active[id] = 0;
-    net_unlock(&_net_global_lock);
+// Rehashes into a table twice the size and publishes it. Caller holds the lock.
+static inline int _intern_grow(qol_intern* in) {
+    _intern_table* old = in->table;
+    _intern_table* t = _intern_table_new((old->mask + 1) * 2, old);
+    if (!t) return 0;
+    _intern_slot *from = _INTERN_SLOTS(old), *to = _INTERN_SLOTS(t);
+    for (size_t i = 0; i <= old->mask; i++) {
+        if (!from[i].str) continue;
+        size_t j = (size_t)from[i].hash & t->mask;
+        while (to[j].str) j = (j + 1) & t->mask;
+        to[j] = from[i];
+    }
+    _tools_store_ptr(&in->table, t);
     return 1;
 }
 
-static inline int openudp(char* interface, int port, int id) { return opensocket(interface, port, id, UDP); }
-static inline int opentcp(char* interface, int port, int id) { return opensocket(interface, port, id, TCP); }
-
-static inline int connecttcp(int id, char* host, int port) {
-    net_init();
-    if (id < 0 || id >= MAX_IDS) return 0;
-    closesocket_id(id);
-
-    net_fd fd = socket(AF_INET, SOCK_STREAM, 0);
-    if (fd == (net_fd)-1) return 0;
-
-    struct hostent *he = gethostbyname(host);
-    if (!he) { net_close(fd); return 0; }
+// Returns the pooled copy of s[0..n), adding it on first sight. NULL on allocation failure.
+static inline const char* intern_n(qol_intern* in, const char* s, size_t n) {
+    if (n > UINT_MAX / 2) return NULL;
+    unsigned long long h = _intern_hash(s, n);
+    const char* p;
+    _intern_slot* sl = _intern_probe((_intern_table*)_tools_load_ptr(&in->table), s, n, h, &p);
+    if (p) return p;
+
+    _tools_lock(&in->lock);
+    sl = _intern_probe(in->table, s, n, h, &p); // the table may have grown, or another thread added s
+    if (p) goto done;
+    if ((size_t)(in->count + 1) * 4 > (in->table->mask + 1) * 3) {
+        if (!_intern_grow(in)) goto done;
+        sl = _intern_probe(in->table, s, n, h, &p);
+    }
+    if (in->count == in->strs_cap) {
+        unsigned cap = in->strs_cap ? in->strs_cap * 2 : 256;
+        const char** strs = (const char**)QOL_REALLOC((void*)in->strs, cap * sizeof(*strs));
+        if (!strs) goto done;
+        in->strs = strs; in->strs_cap = cap;
+    }
+    p = _intern_store(in, s, n, in->count + 1);
+    if (p) {
+        in->strs[in->count++] = p;
+        sl->hash = h;
+        _tools_store_ptr(&sl->str, p);
+    }
+done:
+    _tools_unlock(&in->lock);
+    return p;
+}
 
-    struct sockaddr_in addr = {0};
-    addr.sin_family = AF_INET;
-    addr.sin_port = htons(port);
-    memcpy(&addr.sin_addr.s_addr, he->h_addr, he->h_length);
+static inline const char* intern(qol_intern* in, const char* s) { return intern_n(in, s, strlen(s)); }
 
-    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
-        #ifdef _WIN32
-        if (net_errno != WSAEWOULDBLOCK) { net_close(fd); return 0; }
-        #else
-        if (errno != EINPROGRESS) { net_close(fd); return 0; }
-        #endif
-    }
+// Looks s up without adding it; NULL if it was never interned. Use this for
+// untrusted input (request paths, header names) so it cannot grow the pool.
+static inline const char* intern_find_n(qol_intern* in, const char* s, size_t n) {
+    const char* p = NULL;
+    if (n <= UINT_MAX / 2) _intern_probe((_intern_table*)_tools_load_ptr(&in->table), s, n, _intern_hash(s, n), &p);
+    return p;
+}
 
-    #ifdef _WIN32
-    unsigned long m = 1; ioctlsocket(fd, FIONBIO, &m);
-    #else
-    fcntl(fd, F_SETFL, O_NONBLOCK);
-    #endif
+static inline const char* intern_find(qol_intern* in, const char* s) { return intern_find_n(in, s, strlen(s)); }
 
-    net_lock(&_net_global_lock);
-    _net_fds[id] = fd;
-    _net_types[id] = TCP;
-    _net_active[id] = 1;
-    net_unlock(&_net_global_lock);
-    return 1;
+// Integer handles: atoms are dense, start at 1, and 0 means failure / not found.
+static inline unsigned intern_atom_n(qol_intern* in, const char* s, size_t n) { return intern_atom_of(intern_n(in, s, n)); }
+static inline unsigned intern_atom(qol_intern* in, const char* s) { return intern_atom_of(intern(in, s)); }
+
+// String for an atom, or NULL if the atom is unknown.
+static inline const char* intern_str(qol_intern* in, unsigned atom) {
+    _tools_lock(&in->lock);
+    const char* p = atom && atom <= in->count ? in->strs[atom - 1] : NULL;
+    _tools_unlock(&in->lock);
+    return p;
 }
 
-static inline int senddata(int id, char* host, int port, char* data) {
-    net_init();
-    if (id < 0 || id >= MAX_IDS) return 0;
+static inline unsigned intern_count(qol_intern* in) {
+    _tools_lock(&in->lock);
+    unsigned n = in->count;
+    _tools_unlock(&in->lock);
+    return n;
+}
 
-    net_lock(&_net_global_lock);
-    if (_net_fds[id] == (net_fd)-1) {
-        net_unlock(&_net_global_lock);
-        if (!openudp("0.0.0.0", 0, id)) return 0;
-        net_lock(&_net_global_lock);
-    }
+/* --- Number Formatting & Parsing --- */
 
-    struct hostent *he = gethostbyname(host);
-    if (!he) { net_unlock(&_net_global_lock); return 0; }
+// Slow paths stay out of line so the fast paths inline small.
+#if defined(__GNUC__)
+    #define _TOOLS_COLD __attribute__((noinline, cold))
+#else
+    #define _TOOLS_COLD
+#endif
 
-    struct sockaddr_in dest = {0};
-    dest.sin_family = AF_INET;
-    dest.sin_port = htons(port);
-    memcpy(&dest.sin_addr.s_addr, he->h_addr, he->h_length);
+#define FMT_INT_MAX 21    // "-9223372036854775808" plus the NUL
+#define FMT_DOUBLE_MAX 32 // longest fmt_double output is 25 bytes plus the NUL
+
+static const char _dec_pairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static inline int _fmt_u64_len(unsigned long long v) {
+    int n = 1;
+    for (;;) {
+        if (v < 10) return n;
+        if (v < 100) return n + 1;
+        if (v < 1000) return n + 2;
+        if (v < 10000) return n + 3;
+        v /= 10000; n += 4;
+    }
+}
 
-    int res = -1;
-    if (_net_types[id] == TCP) {
-        res = send(_net_fds[id], data, (int)strlen(data), 0);
-    } else {
-        res = sendto(_net_fds[id], data, (int)strlen(data), 0, (struct sockaddr*)&dest, sizeof(dest));
+// Writes v and a NUL into dst (FMT_INT_MAX bytes) and returns the length.
+// Digits are produced two at a time from the end.
+static inline size_t fmt_u64(char* dst, unsigned long long v) {
+    int n = _fmt_u64_len(v);
+    char* p = dst + n;
+    *p = '\0';
+    while (v >= 100) {
+        unsigned r = (unsigned)(v % 100);
+        v /= 100;
+        p -= 2; memcpy(p, _dec_pairs + 2 * r, 2);
     }
-    net_unlock(&_net_global_lock);
-    return (res >= 0);
+    if (v >= 10) { p -= 2; memcpy(p, _dec_pairs + 2 * v, 2); }
+    else *--p = (char)('0' + v);
+    return (size_t)n;
 }
 
-/* Updated for thread safety: Pass in a buffer to avoid shared state corruption */
-static inline int receivefrom_safe(int id, char* out_buf, int out_size) {
-    if (id < 0 || id >= MAX_IDS || out_buf == NULL) return -1;
+static inline size_t fmt_i64(char* dst, long long v) {
+    if (v >= 0) return fmt_u64(dst, (unsigned long long)v);
+    *dst = '-';
+    return 1 + fmt_u64(dst + 1, 0ULL - (unsigned long long)v);
+}
 
-    net_lock(&_net_global_lock);
-    net_fd fd = _net_fds[id];
-    if (fd == (net_fd)-1) { net_unlock(&_net_global_lock); return -1; }
+// floor(2^128-normalized mantissa) of 10^q for q = -348..347, as { high, low }.
+// The binary exponent of row q is (217706 * q >> 16) - 127.
+#define _FMT_POW10_MIN -348
+#define _FMT_POW10_MAX 347
+static const unsigned long long _fmt_pow10[][2] = {
+    { 0xFA8FD5A0081C0288ULL, 0x1732C869CD60E453ULL }, { 0x9C99E58405118195ULL, 0x0E7FBD42205C8EB4ULL },
+    { 0xC3C05EE50655E1FAULL, 0x521FAC92A873B261ULL }, { 0xF4B0769E47EB5A78ULL, 0xE6A797B752909EF9ULL },
+    { 0x98EE4A22ECF3188BULL, 0x9028BED2939A635CULL }, { 0xBF29DCABA82FDEAEULL, 0x7432EE873880FC33ULL },
+    { 0xEEF453D6923BD65AULL, 0x113FAA2906A13B3FULL }, { 0x9558B4661B6565F8ULL, 0x4AC7CA59A424C507ULL },
+    { 0xBAAEE17FA23EBF76ULL, 0x5D79BCF00D2DF649ULL }, { 0xE95A99DF8ACE6F53ULL, 0xF4D82C2C107973DCULL },
+    { 0x91D8A02BB6C10594ULL, 0x79071B9B8A4BE869ULL }, { 0xB64EC836A47146F9ULL, 0x9748E2826CDEE284ULL },
+    { 0xE3E27A444D8D98B7ULL, 0xFD1B1B2308169B25ULL }, { 0x8E6D8C6AB0787F72ULL, 0xFE30F0F5E50E20F7ULL },
+    { 0xB208EF855C969F4FULL, 0xBDBD2D335E51A935ULL }, { 0xDE8B2B66B3BC4723ULL, 0xAD2C788035E61382ULL },
+    { 0x8B16FB203055AC76ULL, 0x4C3BCB5021AFCC31ULL }, { 0xADDCB9E83C6B1793ULL, 0xDF4ABE242A1BBF3DULL },
+    { 0xD953E8624B85DD78ULL, 0xD71D6DAD34A2AF0DULL }, { 0x87D4713D6F33AA6BULL, 0x8672648C40E5AD68ULL },
+    { 0xA9C98D8CCB009506ULL, 0x680EFDAF511F18C2ULL }, { 0xD43BF0EFFDC0BA48ULL, 0x0212BD1B2566DEF2ULL },
+    { 0x84A57695FE98746DULL, 0x014BB630F7604B57ULL }, { 0xA5CED43B7E3E9188ULL, 0x419EA3BD35385E2DULL },
+    { 0xCF42894A5DCE35EAULL, 0x52064CAC828675B9ULL }, { 0x818995CE7AA0E1B2ULL, 0x7343EFEBD1940993ULL },
+    { 0xA1EBFB4219491A1FULL, 0x1014EBE6C5F90BF8ULL }, { 0xCA66FA129F9B60A6ULL, 0xD41A26E077774EF6ULL },
+    { 0xFD00B897478238D0ULL, 0x8920B098955522B4ULL }, { 0x9E20735E8CB16382ULL, 0x55B46E5F5D5535B0ULL },
+    { 0xC5A890362FDDBC62ULL, 0xEB2189F734AA831DULL }, { 0xF712B443BBD52B7BULL, 0xA5E9EC7501D523E4ULL },
+    { 0x9A6BB0AA55653B2DULL, 0x47B233C92125366EULL }, { 0xC1069CD4EABE89F8ULL, 0x999EC0BB696E840AULL },
+    { 0xF148440A256E2C76ULL, 0xC00670EA43CA250DULL }, { 0x96CD2A865764DBCAULL, 0x380406926A5E5728ULL },
+    { 0xBC807527ED3E12BCULL, 0xC605083704F5ECF2ULL }, { 0xEBA09271E88D976BULL, 0xF7864A44C633682EULL },
+    { 0x93445B8731587EA3ULL, 0x7AB3EE6AFBE0211DULL }, { 0xB8157268FDAE9E4CULL, 0x5960EA05BAD82964ULL },
+    { 0xE61ACF033D1A45DFULL, 0x6FB92487298E33BDULL }, { 0x8FD0C16206306BABULL, 0xA5D3B6D479F8E056ULL },
+    { 0xB3C4F1BA87BC8696ULL, 0x8F48A4899877186CULL }, { 0xE0B62E2929ABA83CULL, 0x331ACDABFE94DE87ULL },
+    { 0x8C71DCD9BA0B4925ULL, 0x9FF0C08B7F1D0B14ULL }, { 0xAF8E5410288E1B6FULL, 0x07ECF0AE5EE44DD9ULL },
+    { 0xDB71E91432B1A24AULL, 0xC9E82CD9F69D6150ULL }, { 0x892731AC9FAF056EULL, 0xBE311C083A225CD2ULL },
+    { 0xAB70FE17C79AC6CAULL, 0x6DBD630A48AAF406ULL }, { 0xD64D3D9DB981787DULL, 0x092CBBCCDAD5B108ULL },
+    { 0x85F0468293F0EB4EULL, 0x25BBF56008C58EA5ULL }, { 0xA76C582338ED2621ULL, 0xAF2AF2B80AF6F24EULL },
+    { 0xD1476E2C07286FAAULL, 0x1AF5AF660DB4AEE1ULL }, { 0x82CCA4DB847945CAULL, 0x50D98D9FC890ED4DULL },
+    { 0xA37FCE126597973CULL, 0xE50FF107BAB528A0ULL }, { 0xCC5FC196FEFD7D0CULL, 0x1E53ED49A96272C8ULL },
+    { 0xFF77B1FCBEBCDC4FULL, 0x25E8E89C13BB0F7AULL }, { 0x9FAACF3DF73609B1ULL, 0x77B191618C54E9ACULL },
+    { 0xC795830D75038C1DULL, 0xD59DF5B9EF6A2417ULL }, { 0xF97AE3D0D2446F25ULL, 0x4B0573286B44AD1DULL },
+    { 0x9BECCE62836AC577ULL, 0x4EE367F9430AEC32ULL }, { 0xC2E801FB244576D5ULL, 0x229C41F793CDA73FULL },
+    { 0xF3A20279ED56D48AULL, 0x6B43527578C1110FULL }, { 0x9845418C345644D6ULL, 0x830A13896B78AAA9ULL },
+    { 0xBE5691EF416BD60CULL, 0x23CC986BC656D553ULL }, { 0xEDEC366B11C6CB8FULL, 0x2CBFBE86B7EC8AA8ULL },
+    { 0x94B3A202EB1C3F39ULL, 0x7BF7D71432F3D6A9ULL }, { 0xB9E08A83A5E34F07ULL, 0xDAF5CCD93FB0CC53ULL },
+    { 0xE858AD248F5C22C9ULL, 0xD1B3400F8F9CFF68ULL }, { 0x91376C36D99995BEULL, 0x23100809B9C21FA1ULL },
+    { 0xB58547448FFFFB2DULL, 0xABD40A0C2832A78AULL }, { 0xE2E69915B3FFF9F9ULL, 0x16C90C8F323F516CULL },
+    { 0x8DD01FAD907FFC3BULL, 0xAE3DA7D97F6792E3ULL }, { 0xB1442798F49FFB4AULL, 0x99CD11CFDF41779CULL },
+    { 0xDD95317F31C7FA1DULL, 0x40405643D711D583ULL }, { 0x8A7D3EEF7F1CFC52ULL, 0x482835EA666B2572ULL },
+    { 0xAD1C8EAB5EE43B66ULL, 0xDA3243650005EECFULL }, { 0xD863B256369D4A40ULL, 0x90BED43E40076A82ULL },
+    { 0x873E4F75E2224E68ULL, 0x5A7744A6E804A291ULL }, { 0xA90DE3535AAAE202ULL, 0x711515D0A205CB36ULL },
+    { 0xD3515C2831559A83ULL, 0x0D5A5B44CA873E03ULL }, { 0x8412D9991ED58091ULL, 0xE858790AFE9486C2ULL },
+    { 0xA5178FFF668AE0B6ULL, 0x626E974DBE39A872ULL }, { 0xCE5D73FF402D98E3ULL, 0xFB0A3D212DC8128FULL },
+    { 0x80FA687F881C7F8EULL, 0x7CE66634BC9D0B99ULL }, { 0xA139029F6A239F72ULL, 0x1C1FFFC1EBC44E80ULL },
+    { 0xC987434744AC874EULL, 0xA327FFB266B56220ULL }, { 0xFBE9141915D7A922ULL, 0x4BF1FF9F0062BAA8ULL },
+    { 0x9D71AC8FADA6C9B5ULL, 0x6F773FC3603DB4A9ULL }, { 0xC4CE17B399107C22ULL, 0xCB550FB4384D21D3ULL },
+    { 0xF6019DA07F549B2BULL, 0x7E2A53A146606A48ULL }, { 0x99C102844F94E0FBULL, 0x2EDA7444CBFC426DULL },
+    { 0xC0314325637A1939ULL, 0xFA911155FEFB5308ULL }, { 0xF03D93EEBC589F88ULL, 0x793555AB7EBA27CAULL },
+    { 0x96267C7535B763B5ULL, 0x4BC1558B2F3458DEULL }, { 0xBBB01B9283253CA2ULL, 0x9EB1AAEDFB016F16ULL },
+    { 0xEA9C227723EE8BCBULL, 0x465E15A979C1CADCULL }, { 0x92A1958A7675175FULL, 0x0BFACD89EC191EC9ULL },
+    { 0xB749FAED14125D36ULL, 0xCEF980EC671F667BULL }, { 0xE51C79A85916F484ULL, 0x82B7E12780E7401AULL },
+    { 0x8F31CC0937AE58D2ULL, 0xD1B2ECB8B0908810ULL }, { 0xB2FE3F0B8599EF07ULL, 0x861FA7E6DCB4AA15ULL },
+    { 0xDFBDCECE67006AC9ULL, 0x67A791E093E1D49AULL }, { 0x8BD6A141006042BDULL, 0xE0C8BB2C5C6D24E0ULL },
+    { 0xAECC49914078536DULL, 0x58FAE9F773886E18ULL }, { 0xDA7F5BF590966848ULL, 0xAF39A475506A899EULL },
+    { 0x888F99797A5E012DULL, 0x6D8406C952429603ULL }, { 0xAAB37FD7D8F58178ULL, 0xC8E5087BA6D33B83ULL },
+    { 0xD5605FCDCF32E1D6ULL, 0xFB1E4A9A90880A64ULL }, { 0x855C3BE0A17FCD26ULL, 0x5CF2EEA09A55067FULL },
+    { 0xA6B34AD8C9DFC06FULL, 0xF42FAA48C0EA481EULL }, { 0xD0601D8EFC57B08BULL, 0xF13B94DAF124DA26ULL },
+    { 0x823C12795DB6CE57ULL, 0x76C53D08D6B70858ULL }, { 0xA2CB1717B52481EDULL, 0x54768C4B0C64CA6EULL },
+    { 0xCB7DDCDDA26DA268ULL, 0xA9942F5DCF7DFD09ULL }, { 0xFE5D54150B090B02ULL, 0xD3F93B35435D7C4CULL },
+    { 0x9EFA548D26E5A6E1ULL, 0xC47BC5014A1A6DAFULL }, { 0xC6B8E9B0709F109AULL, 0x359AB6419CA1091BULL },
+    { 0xF867241C8CC6D4C0ULL, 0xC30163D203C94B62ULL }, { 0x9B407691D7FC44F8ULL, 0x79E0DE63425DCF1DULL },
+    { 0xC21094364DFB5636ULL, 0x985915FC12F542E4ULL }, { 0xF294B943E17A2BC4ULL, 0x3E6F5B7B17B2939DULL },
+    { 0x979CF3CA6CEC5B5AULL, 0xA705992CEECF9C42ULL }, { 0xBD8430BD08277231ULL, 0x50C6FF782A838353ULL },
+    { 0xECE53CEC4A314EBDULL, 0xA4F8BF5635246428ULL }, { 0x940F4613AE5ED136ULL, 0x871B7795E136BE99ULL },
+    { 0xB913179899F68584ULL, 0x28E2557B59846E3FULL }, { 0xE757DD7EC07426E5ULL, 0x331AEADA2FE589CFULL },
+    { 0x9096EA6F3848984FULL, 0x3FF0D2C85DEF7621ULL }, { 0xB4BCA50B065ABE63ULL, 0x0FED077A756B53A9ULL },
+    { 0xE1EBCE4DC7F16DFBULL, 0xD3E8495912C62894ULL }, { 0x8D3360F09CF6E4BDULL, 0x64712DD7ABBBD95CULL },
+    { 0xB080392CC4349DECULL, 0xBD8D794D96AACFB3ULL }, { 0xDCA04777F541C567ULL, 0xECF0D7A0FC5583A0ULL },
+    { 0x89E42CAAF9491B60ULL, 0xF41686C49DB57244ULL }, { 0xAC5D37D5B79B6239ULL, 0x311C2875C522CED5ULL },
+    { 0xD77485CB25823AC7ULL, 0x7D633293366B828BULL }, { 0x86A8D39EF77164BCULL, 0xAE5DFF9C02033197ULL },
+    { 0xA8530886B54DBDEBULL, 0xD9F57F830283FDFCULL }, { 0xD267CAA862A12D66ULL, 0xD072DF63C324FD7BULL },
+    { 0x8380DEA93DA4BC60ULL, 0x4247CB9E59F71E6DULL }, { 0xA46116538D0DEB78ULL, 0x52D9BE85F074E608ULL },
+    { 0xCD795BE870516656ULL, 0x67902E276C921F8BULL }, { 0x806BD9714632DFF6ULL, 0x00BA1CD8A3DB53B6ULL },
+    { 0xA086CFCD97BF97F3ULL, 0x80E8A40ECCD228A4ULL }, { 0xC8A883C0FDAF7DF0ULL, 0x6122CD128006B2CDULL },
+    { 0xFAD2A4B13D1B5D6CULL, 0x796B805720085F81ULL }, { 0x9CC3A6EEC6311A63ULL, 0xCBE3303674053BB0ULL },
+    { 0xC3F490AA77BD60FCULL, 0xBEDBFC4411068A9CULL }, { 0xF4F1B4D515ACB93BULL, 0xEE92FB5515482D44ULL },
+    { 0x991711052D8BF3C5ULL, 0x751BDD152D4D1C4AULL }, { 0xBF5CD54678EEF0B6ULL, 0xD262D45A78A0635DULL },
+    { 0xEF340A98172AACE4ULL, 0x86FB897116C87C34ULL }, { 0x9580869F0E7AAC0EULL, 0xD45D35E6AE3D4DA0ULL },
+    { 0xBAE0A846D2195712ULL, 0x8974836059CCA109ULL }, { 0xE998D258869FACD7ULL, 0x2BD1A438703FC94BULL },
+    { 0x91FF83775423CC06ULL, 0x7B6306A34627DDCFULL }, { 0xB67F6455292CBF08ULL, 0x1A3BC84C17B1D542ULL },
+    { 0xE41F3D6A7377EECAULL, 0x20CABA5F1D9E4A93ULL }, { 0x8E938662882AF53EULL, 0x547EB47B7282EE9CULL },
+    { 0xB23867FB2A35B28DULL, 0xE99E619A4F23AA43ULL }, { 0xDEC681F9F4C31F31ULL, 0x6405FA00E2EC94D4ULL },
+    { 0x8B3C113C38F9F37EULL, 0xDE83BC408DD3DD04ULL }, { 0xAE0B158B4738705EULL, 0x9624AB50B148D445ULL },
+    { 0xD98DDAEE19068C76ULL, 0x3BADD624DD9B0957ULL }, { 0x87F8A8D4CFA417C9ULL, 0xE54CA5D70A80E5D6ULL },
+    { 0xA9F6D30A038D1DBCULL, 0x5E9FCF4CCD211F4CULL }, { 0xD47487CC8470652BULL, 0x7647C3200069671FULL },
+    { 0x84C8D4DFD2C63F3BULL, 0x29ECD9F40041E073ULL }, { 0xA5FB0A17C777CF09ULL, 0xF468107100525890ULL },
+    { 0xCF79CC9DB955C2CCULL, 0x7182148D4066EEB4ULL }, { 0x81AC1FE293D599BFULL, 0xC6F14CD848405530ULL },
+    { 0xA21727DB38CB002FULL, 0xB8ADA00E5A506A7CULL }, { 0xCA9CF1D206FDC03BULL, 0xA6D90811F0E4851CULL },
+    { 0xFD442E4688BD304AULL, 0x908F4A166D1DA663ULL }, { 0x9E4A9CEC15763E2EULL, 0x9A598E4E043287FEULL },
+    { 0xC5DD44271AD3CDBAULL, 0x40EFF1E1853F29FDULL }, { 0xF7549530E188C128ULL, 0xD12BEE59E68EF47CULL },
+    { 0x9A94DD3E8CF578B9ULL, 0x82BB74F8301958CEULL }, { 0xC13A148E3032D6E7ULL, 0xE36A52363C1FAF01ULL },
+    { 0xF18899B1BC3F8CA1ULL, 0xDC44E6C3CB279AC1ULL }, { 0x96F5600F15A7B7E5ULL, 0x29AB103A5EF8C0B9ULL },
+    { 0xBCB2B812DB11A5DEULL, 0x7415D448F6B6F0E7ULL }, { 0xEBDF661791D60F56ULL, 0x111B495B3464AD21ULL },
+    { 0x936B9FCEBB25C995ULL, 0xCAB10DD900BEEC34ULL }, { 0xB84687C269EF3BFBULL, 0x3D5D514F40EEA742ULL },
+    { 0xE65829B3046B0AFAULL, 0x0CB4A5A3112A5112ULL }, { 0x8FF71A0FE2C2E6DCULL, 0x47F0E785EABA72ABULL },
+    { 0xB3F4E093DB73A093ULL, 0x59ED216765690F56ULL }, { 0xE0F218B8D25088B8ULL, 0x306869C13EC3532CULL },
+    { 0x8C974F7383725573ULL, 0x1E414218C73A13FBULL }, { 0xAFBD2350644EEACFULL, 0xE5D1929EF90898FAULL },
+    { 0xDBAC6C247D62A583ULL, 0xDF45F746B74ABF39ULL }, { 0x894BC396CE5DA772ULL, 0x6B8BBA8C328EB783ULL },
+    { 0xAB9EB47C81F5114FULL, 0x066EA92F3F326564ULL }, { 0xD686619BA27255A2ULL, 0xC80A537B0EFEFEBDULL },
+    { 0x8613FD0145877585ULL, 0xBD06742CE95F5F36ULL }, { 0xA798FC4196E952E7ULL, 0x2C48113823B73704ULL },
+    { 0xD17F3B51FCA3A7A0ULL, 0xF75A15862CA504C5ULL }, { 0x82EF85133DE648C4ULL, 0x9A984D73DBE722FBULL },
+    { 0xA3AB66580D5FDAF5ULL, 0xC13E60D0D2E0EBBAULL }, { 0xCC963FEE10B7D1B3ULL, 0x318DF905079926A8ULL },
+    { 0xFFBBCFE994E5C61FULL, 0xFDF17746497F7052ULL }, { 0x9FD561F1FD0F9BD3ULL, 0xFEB6EA8BEDEFA633ULL },
+    { 0xC7CABA6E7C5382C8ULL, 0xFE64A52EE96B8FC0ULL }, { 0xF9BD690A1B68637BULL, 0x3DFDCE7AA3C673B0ULL },
+    { 0x9C1661A651213E2DULL, 0x06BEA10CA65C084EULL }, { 0xC31BFA0FE5698DB8ULL, 0x486E494FCFF30A62ULL },
+    { 0xF3E2F893DEC3F126ULL, 0x5A89DBA3C3EFCCFAULL }, { 0x986DDB5C6B3A76B7ULL, 0xF89629465A75E01CULL },
+    { 0xBE89523386091465ULL, 0xF6BBB397F1135823ULL }, { 0xEE2BA6C0678B597FULL, 0x746AA07DED582E2CULL },
+    { 0x94DB483840B717EFULL, 0xA8C2A44EB4571CDCULL }, { 0xBA121A4650E4DDEBULL, 0x92F34D62616CE413ULL },
+    { 0xE896A0D7E51E1566ULL, 0x77B020BAF9C81D17ULL }, { 0x915E2486EF32CD60ULL, 0x0ACE1474DC1D122EULL },
+    { 0xB5B5ADA8AAFF80B8ULL, 0x0D819992132456BAULL }, { 0xE3231912D5BF60E6ULL, 0x10E1FFF697ED6C69ULL },
+    { 0x8DF5EFABC5979C8FULL, 0xCA8D3FFA1EF463C1ULL }, { 0xB1736B96B6FD83B3ULL, 0xBD308FF8A6B17CB2ULL },
+    { 0xDDD0467C64BCE4A0ULL, 0xAC7CB3F6D05DDBDEULL }, { 0x8AA22C0DBEF60EE4ULL, 0x6BCDF07A423AA96BULL },
+    { 0xAD4AB7112EB3929DULL, 0x86C16C98D2C953C6ULL }, { 0xD89D64D57A607744ULL, 0xE871C7BF077BA8B7ULL },
+    { 0x87625F056C7C4A8BULL, 0x11471CD764AD4972ULL }, { 0xA93AF6C6C79B5D2DULL, 0xD598E40D3DD89BCFULL },
+    { 0xD389B47879823479ULL, 0x4AFF1D108D4EC2C3ULL }, { 0x843610CB4BF160CBULL, 0xCEDF722A585139BAULL },
+    { 0xA54394FE1EEDB8FEULL, 0xC2974EB4EE658828ULL }, { 0xCE947A3DA6A9273EULL, 0x733D226229FEEA32ULL },
+    { 0x811CCC668829B887ULL, 0x0806357D5A3F525FULL }, { 0xA163FF802A3426A8ULL, 0xCA07C2DCB0CF26F7ULL },
+    { 0xC9BCFF6034C13052ULL, 0xFC89B393DD02F0B5ULL }, { 0xFC2C3F3841F17C67ULL, 0xBBAC2078D443ACE2ULL },
+    { 0x9D9BA7832936EDC0ULL, 0xD54B944B84AA4C0DULL }, { 0xC5029163F384A931ULL, 0x0A9E795E65D4DF11ULL },
+    { 0xF64335BCF065D37DULL, 0x4D4617B5FF4A16D5ULL }, { 0x99EA0196163FA42EULL, 0x504BCED1BF8E4E45ULL },
+    { 0xC06481FB9BCF8D39ULL, 0xE45EC2862F71E1D6ULL }, { 0xF07DA27A82C37088ULL, 0x5D767327BB4E5A4CULL },
+    { 0x964E858C91BA2655ULL, 0x3A6A07F8D510F86FULL }, { 0xBBE226EFB628AFEAULL, 0x890489F70A55368BULL },
+    { 0xEADAB0ABA3B2DBE5ULL, 0x2B45AC74CCEA842EULL }, { 0x92C8AE6B464FC96FULL, 0x3B0B8BC90012929DULL },
+    { 0xB77ADA0617E3BBCBULL, 0x09CE6EBB40173744ULL }, { 0xE55990879DDCAABDULL, 0xCC420A6A101D0515ULL },
+    { 0x8F57FA54C2A9EAB6ULL, 0x9FA946824A12232DULL }, { 0xB32DF8E9F3546564ULL, 0x47939822DC96ABF9ULL },
+    { 0xDFF9772470297EBDULL, 0x59787E2B93BC56F7ULL }, { 0x8BFBEA76C619EF36ULL, 0x57EB4EDB3C55B65AULL },
+    { 0xAEFAE51477A06B03ULL, 0xEDE622920B6B23F1ULL }, { 0xDAB99E59958885C4ULL, 0xE95FAB368E45ECEDULL },
+    { 0x88B402F7FD75539BULL, 0x11DBCB0218EBB414ULL }, { 0xAAE103B5FCD2A881ULL, 0xD652BDC29F26A119ULL },
+    { 0xD59944A37C0752A2ULL, 0x4BE76D3346F0495FULL }, { 0x857FCAE62D8493A5ULL, 0x6F70A4400C562DDBULL },
+    { 0xA6DFBD9FB8E5B88EULL, 0xCB4CCD500F6BB952ULL }, { 0xD097AD07A71F26B2ULL, 0x7E2000A41346A7A7ULL },
+    { 0x825ECC24C873782FULL, 0x8ED400668C0C28C8ULL }, { 0xA2F67F2DFA90563BULL, 0x728900802F0F32FAULL },
+    { 0xCBB41EF979346BCAULL, 0x4F2B40A03AD2FFB9ULL }, { 0xFEA126B7D78186BCULL, 0xE2F610C84987BFA8ULL },
+    { 0x9F24B832E6B0F436ULL, 0x0DD9CA7D2DF4D7C9ULL }, { 0xC6EDE63FA05D3143ULL, 0x91503D1C79720DBBULL },
+    { 0xF8A95FCF88747D94ULL, 0x75A44C6397CE912AULL }, { 0x9B69DBE1B548CE7CULL, 0xC986AFBE3EE11ABAULL },
+    { 0xC24452DA229B021BULL, 0xFBE85BADCE996168ULL }, { 0xF2D56790AB41C2A2ULL, 0xFAE27299423FB9C3ULL },
+    { 0x97C560BA6B0919A5ULL, 0xDCCD879FC967D41AULL }, { 0xBDB6B8E905CB600FULL, 0x5400E987BBC1C920ULL },
+    { 0xED246723473E3813ULL, 0x290123E9AAB23B68ULL }, { 0x9436C0760C86E30BULL, 0xF9A0B6720AAF6521ULL },
+    { 0xB94470938FA89BCEULL, 0xF808E40E8D5B3E69ULL }, { 0xE7958CB87392C2C2ULL, 0xB60B1D1230B20E04ULL },
+    { 0x90BD77F3483BB9B9ULL, 0xB1C6F22B5E6F48C2ULL }, { 0xB4ECD5F01A4AA828ULL, 0x1E38AEB6360B1AF3ULL },
+    { 0xE2280B6C20DD5232ULL, 0x25C6DA63C38DE1B0ULL }, { 0x8D590723948A535FULL, 0x579C487E5A38AD0EULL },
+    { 0xB0AF48EC79ACE837ULL, 0x2D835A9DF0C6D851ULL }, { 0xDCDB1B2798182244ULL, 0xF8E431456CF88E65ULL },
+    { 0x8A08F0F8BF0F156BULL, 0x1B8E9ECB641B58FFULL }, { 0xAC8B2D36EED2DAC5ULL, 0xE272467E3D222F3FULL },
+    { 0xD7ADF884AA879177ULL, 0x5B0ED81DCC6ABB0FULL }, { 0x86CCBB52EA94BAEAULL, 0x98E947129FC2B4E9ULL },
+    { 0xA87FEA27A539E9A5ULL, 0x3F2398D747B36224ULL }, { 0xD29FE4B18E88640EULL, 0x8EEC7F0D19A03AADULL },
+    { 0x83A3EEEEF9153E89ULL, 0x1953CF68300424ACULL }, { 0xA48CEAAAB75A8E2BULL, 0x5FA8C3423C052DD7ULL },
+    { 0xCDB02555653131B6ULL, 0x3792F412CB06794DULL }, { 0x808E17555F3EBF11ULL, 0xE2BBD88BBEE40BD0ULL },
+    { 0xA0B19D2AB70E6ED6ULL, 0x5B6ACEAEAE9D0EC4ULL }, { 0xC8DE047564D20A8BULL, 0xF245825A5A445275ULL },
+    { 0xFB158592BE068D2EULL, 0xEED6E2F0F0D56712ULL }, { 0x9CED737BB6C4183DULL, 0x55464DD69685606BULL },
+    { 0xC428D05AA4751E4CULL, 0xAA97E14C3C26B886ULL }, { 0xF53304714D9265DFULL, 0xD53DD99F4B3066A8ULL },
+    { 0x993FE2C6D07B7FABULL, 0xE546A8038EFE4029ULL }, { 0xBF8FDB78849A5F96ULL, 0xDE98520472BDD033ULL },
+    { 0xEF73D256A5C0F77CULL, 0x963E66858F6D4440ULL }, { 0x95A8637627989AADULL, 0xDDE7001379A44AA8ULL },
+    { 0xBB127C53B17EC159ULL, 0x5560C018580D5D52ULL }, { 0xE9D71B689DDE71AFULL, 0xAAB8F01E6E10B4A6ULL },
+    { 0x9226712162AB070DULL, 0xCAB3961304CA70E8ULL }, { 0xB6B00D69BB55C8D1ULL, 0x3D607B97C5FD0D22ULL },
+    { 0xE45C10C42A2B3B05ULL, 0x8CB89A7DB77C506AULL }, { 0x8EB98A7A9A5B04E3ULL, 0x77F3608E92ADB242ULL },
+    { 0xB267ED1940F1C61CULL, 0x55F038B237591ED3ULL }, { 0xDF01E85F912E37A3ULL, 0x6B6C46DEC52F6688ULL },
+    { 0x8B61313BBABCE2C6ULL, 0x2323AC4B3B3DA015ULL }, { 0xAE397D8AA96C1B77ULL, 0xABEC975E0A0D081AULL },
+    { 0xD9C7DCED53C72255ULL, 0x96E7BD358C904A21ULL }, { 0x881CEA14545C7575ULL, 0x7E50D64177DA2E54ULL },
+    { 0xAA242499697392D2ULL, 0xDDE50BD1D5D0B9E9ULL }, { 0xD4AD2DBFC3D07787ULL, 0x955E4EC64B44E864ULL },
+    { 0x84EC3C97DA624AB4ULL, 0xBD5AF13BEF0B113EULL }, { 0xA6274BBDD0FADD61ULL, 0xECB1AD8AEACDD58EULL },
+    { 0xCFB11EAD453994BAULL, 0x67DE18EDA5814AF2ULL }, { 0x81CEB32C4B43FCF4ULL, 0x80EACF948770CED7ULL },
+    { 0xA2425FF75E14FC31ULL, 0xA1258379A94D028DULL }, { 0xCAD2F7F5359A3B3EULL, 0x096EE45813A04330ULL },
+    { 0xFD87B5F28300CA0DULL, 0x8BCA9D6E188853FCULL }, { 0x9E74D1B791E07E48ULL, 0x775EA264CF55347DULL },
+    { 0xC612062576589DDAULL, 0x95364AFE032A819DULL }, { 0xF79687AED3EEC551ULL, 0x3A83DDBD83F52204ULL },
+    { 0x9ABE14CD44753B52ULL, 0xC4926A9672793542ULL }, { 0xC16D9A0095928A27ULL, 0x75B7053C0F178293ULL },
+    { 0xF1C90080BAF72CB1ULL, 0x5324C68B12DD6338ULL }, { 0x971DA05074DA7BEEULL, 0xD3F6FC16EBCA5E03ULL },
+    { 0xBCE5086492111AEAULL, 0x88F4BB1CA6BCF584ULL }, { 0xEC1E4A7DB69561A5ULL, 0x2B31E9E3D06C32E5ULL },
+    { 0x9392EE8E921D5D07ULL, 0x3AFF322E62439FCFULL }, { 0xB877AA3236A4B449ULL, 0x09BEFEB9FAD487C2ULL },
+    { 0xE69594BEC44DE15BULL, 0x4C2EBE687989A9B3ULL }, { 0x901D7CF73AB0ACD9ULL, 0x0F9D37014BF60A10ULL },
+    { 0xB424DC35095CD80FULL, 0x538484C19EF38C94ULL }, { 0xE12E13424BB40E13ULL, 0x2865A5F206B06FB9ULL },
+    { 0x8CBCCC096F5088CBULL, 0xF93F87B7442E45D3ULL }, { 0xAFEBFF0BCB24AAFEULL, 0xF78F69A51539D748ULL },
+    { 0xDBE6FECEBDEDD5BEULL, 0xB573440E5A884D1BULL }, { 0x89705F4136B4A597ULL, 0x31680A88F8953030ULL },
+    { 0xABCC77118461CEFCULL, 0xFDC20D2B36BA7C3DULL }, { 0xD6BF94D5E57A42BCULL, 0x3D32907604691B4CULL },
+    { 0x8637BD05AF6C69B5ULL, 0xA63F9A49C2C1B10FULL }, { 0xA7C5AC471B478423ULL, 0x0FCF80DC33721D53ULL },
+    { 0xD1B71758E219652BULL, 0xD3C36113404EA4A8ULL }, { 0x83126E978D4FDF3BULL, 0x645A1CAC083126E9ULL },
+    { 0xA3D70A3D70A3D70AULL, 0x3D70A3D70A3D70A3ULL }, { 0xCCCCCCCCCCCCCCCCULL, 0xCCCCCCCCCCCCCCCCULL },
+    { 0x8000000000000000ULL, 0x0000000000000000ULL }, { 0xA000000000000000ULL, 0x0000000000000000ULL },
+    { 0xC800000000000000ULL, 0x0000000000000000ULL }, { 0xFA00000000000000ULL, 0x0000000000000000ULL },
+    { 0x9C40000000000000ULL, 0x0000000000000000ULL }, { 0xC350000000000000ULL, 0x0000000000000000ULL },
+    { 0xF424000000000000ULL, 0x0000000000000000ULL }, { 0x9896800000000000ULL, 0x0000000000000000ULL },
+    { 0xBEBC200000000000ULL, 0x0000000000000000ULL }, { 0xEE6B280000000000ULL, 0x0000000000000000ULL },
+    { 0x9502F90000000000ULL, 0x0000000000000000ULL }, { 0xBA43B74000000000ULL, 0x0000000000000000ULL },
+    { 0xE8D4A51000000000ULL, 0x0000000000000000ULL }, { 0x9184E72A00000000ULL, 0x0000000000000000ULL },
+    { 0xB5E620F480000000ULL, 0x0000000000000000ULL }, { 0xE35FA931A0000000ULL, 0x0000000000000000ULL },
+    { 0x8E1BC9BF04000000ULL, 0x0000000000000000ULL }, { 0xB1A2BC2EC5000000ULL, 0x0000000000000000ULL },
+    { 0xDE0B6B3A76400000ULL, 0x0000000000000000ULL }, { 0x8AC7230489E80000ULL, 0x0000000000000000ULL },
+    { 0xAD78EBC5AC620000ULL, 0x0000000000000000ULL }, { 0xD8D726B7177A8000ULL, 0x0000000000000000ULL },
+    { 0x878678326EAC9000ULL, 0x0000000000000000ULL }, { 0xA968163F0A57B400ULL, 0x0000000000000000ULL },
+    { 0xD3C21BCECCEDA100ULL, 0x0000000000000000ULL }, { 0x84595161401484A0ULL, 0x0000000000000000ULL },
+    { 0xA56FA5B99019A5C8ULL, 0x0000000000000000ULL }, { 0xCECB8F27F4200F3AULL, 0x0000000000000000ULL },
+    { 0x813F3978F8940984ULL, 0x4000000000000000ULL }, { 0xA18F07D736B90BE5ULL, 0x5000000000000000ULL },
+    { 0xC9F2C9CD04674EDEULL, 0xA400000000000000ULL }, { 0xFC6F7C4045812296ULL, 0x4D00000000000000ULL },
+    { 0x9DC5ADA82B70B59DULL, 0xF020000000000000ULL }, { 0xC5371912364CE305ULL, 0x6C28000000000000ULL },
+    { 0xF684DF56C3E01BC6ULL, 0xC732000000000000ULL }, { 0x9A130B963A6C115CULL, 0x3C7F400000000000ULL },
+    { 0xC097CE7BC90715B3ULL, 0x4B9F100000000000ULL }, { 0xF0BDC21ABB48DB20ULL, 0x1E86D40000000000ULL },
+    { 0x96769950B50D88F4ULL, 0x1314448000000000ULL }, { 0xBC143FA4E250EB31ULL, 0x17D955A000000000ULL },
+    { 0xEB194F8E1AE525FDULL, 0x5DCFAB0800000000ULL }, { 0x92EFD1B8D0CF37BEULL, 0x5AA1CAE500000000ULL },
+    { 0xB7ABC627050305ADULL, 0xF14A3D9E40000000ULL }, { 0xE596B7B0C643C719ULL, 0x6D9CCD05D0000000ULL },
+    { 0x8F7E32CE7BEA5C6FULL, 0xE4820023A2000000ULL }, { 0xB35DBF821AE4F38BULL, 0xDDA2802C8A800000ULL },
+    { 0xE0352F62A19E306EULL, 0xD50B2037AD200000ULL }, { 0x8C213D9DA502DE45ULL, 0x4526F422CC340000ULL },
+    { 0xAF298D050E4395D6ULL, 0x9670B12B7F410000ULL }, { 0xDAF3F04651D47B4CULL, 0x3C0CDD765F114000ULL },
+    { 0x88D8762BF324CD0FULL, 0xA5880A69FB6AC800ULL }, { 0xAB0E93B6EFEE0053ULL, 0x8EEA0D047A457A00ULL },
+    { 0xD5D238A4ABE98068ULL, 0x72A4904598D6D880ULL }, { 0x85A36366EB71F041ULL, 0x47A6DA2B7F864750ULL },
+    { 0xA70C3C40A64E6C51ULL, 0x999090B65F67D924ULL }, { 0xD0CF4B50CFE20765ULL, 0xFFF4B4E3F741CF6DULL },
+    { 0x82818F1281ED449FULL, 0xBFF8F10E7A8921A4ULL }, { 0xA321F2D7226895C7ULL, 0xAFF72D52192B6A0DULL },
+    { 0xCBEA6F8CEB02BB39ULL, 0x9BF4F8A69F764490ULL }, { 0xFEE50B7025C36A08ULL, 0x02F236D04753D5B4ULL },
+    { 0x9F4F2726179A2245ULL, 0x01D762422C946590ULL }, { 0xC722F0EF9D80AAD6ULL, 0x424D3AD2B7B97EF5ULL },
+    { 0xF8EBAD2B84E0D58BULL, 0xD2E0898765A7DEB2ULL }, { 0x9B934C3B330C8577ULL, 0x63CC55F49F88EB2FULL },
+    { 0xC2781F49FFCFA6D5ULL, 0x3CBF6B71C76B25FBULL }, { 0xF316271C7FC3908AULL, 0x8BEF464E3945EF7AULL },
+    { 0x97EDD871CFDA3A56ULL, 0x97758BF0E3CBB5ACULL }, { 0xBDE94E8E43D0C8ECULL, 0x3D52EEED1CBEA317ULL },
+    { 0xED63A231D4C4FB27ULL, 0x4CA7AAA863EE4BDDULL }, { 0x945E455F24FB1CF8ULL, 0x8FE8CAA93E74EF6AULL },
+    { 0xB975D6B6EE39E436ULL, 0xB3E2FD538E122B44ULL }, { 0xE7D34C64A9C85D44ULL, 0x60DBBCA87196B616ULL },
+    { 0x90E40FBEEA1D3A4AULL, 0xBC8955E946FE31CDULL }, { 0xB51D13AEA4A488DDULL, 0x6BABAB6398BDBE41ULL },
+    { 0xE264589A4DCDAB14ULL, 0xC696963C7EED2DD1ULL }, { 0x8D7EB76070A08AECULL, 0xFC1E1DE5CF543CA2ULL },
+    { 0xB0DE65388CC8ADA8ULL, 0x3B25A55F43294BCBULL }, { 0xDD15FE86AFFAD912ULL, 0x49EF0EB713F39EBEULL },
+    { 0x8A2DBF142DFCC7ABULL, 0x6E3569326C784337ULL }, { 0xACB92ED9397BF996ULL, 0x49C2C37F07965404ULL },
+    { 0xD7E77A8F87DAF7FBULL, 0xDC33745EC97BE906ULL }, { 0x86F0AC99B4E8DAFDULL, 0x69A028BB3DED71A3ULL },
+    { 0xA8ACD7C0222311BCULL, 0xC40832EA0D68CE0CULL }, { 0xD2D80DB02AABD62BULL, 0xF50A3FA490C30190ULL },
+    { 0x83C7088E1AAB65DBULL, 0x792667C6DA79E0FAULL }, { 0xA4B8CAB1A1563F52ULL, 0x577001B891185938ULL },
+    { 0xCDE6FD5E09ABCF26ULL, 0xED4C0226B55E6F86ULL }, { 0x80B05E5AC60B6178ULL, 0x544F8158315B05B4ULL },
+    { 0xA0DC75F1778E39D6ULL, 0x696361AE3DB1C721ULL }, { 0xC913936DD571C84CULL, 0x03BC3A19CD1E38E9ULL },
+    { 0xFB5878494ACE3A5FULL, 0x04AB48A04065C723ULL }, { 0x9D174B2DCEC0E47BULL, 0x62EB0D64283F9C76ULL },
+    { 0xC45D1DF942711D9AULL, 0x3BA5D0BD324F8394ULL }, { 0xF5746577930D6500ULL, 0xCA8F44EC7EE36479ULL },
+    { 0x9968BF6ABBE85F20ULL, 0x7E998B13CF4E1ECBULL }, { 0xBFC2EF456AE276E8ULL, 0x9E3FEDD8C321A67EULL },
+    { 0xEFB3AB16C59B14A2ULL, 0xC5CFE94EF3EA101EULL }, { 0x95D04AEE3B80ECE5ULL, 0xBBA1F1D158724A12ULL },
+    { 0xBB445DA9CA61281FULL, 0x2A8A6E45AE8EDC97ULL }, { 0xEA1575143CF97226ULL, 0xF52D09D71A3293BDULL },
+    { 0x924D692CA61BE758ULL, 0x593C2626705F9C56ULL }, { 0xB6E0C377CFA2E12EULL, 0x6F8B2FB00C77836CULL },
+    { 0xE498F455C38B997AULL, 0x0B6DFB9C0F956447ULL }, { 0x8EDF98B59A373FECULL, 0x4724BD4189BD5EACULL },
+    { 0xB2977EE300C50FE7ULL, 0x58EDEC91EC2CB657ULL }, { 0xDF3D5E9BC0F653E1ULL, 0x2F2967B66737E3EDULL },
+    { 0x8B865B215899F46CULL, 0xBD79E0D20082EE74ULL }, { 0xAE67F1E9AEC07187ULL, 0xECD8590680A3AA11ULL },
+    { 0xDA01EE641A708DE9ULL, 0xE80E6F4820CC9495ULL }, { 0x884134FE908658B2ULL, 0x3109058D147FDCDDULL },
+    { 0xAA51823E34A7EEDEULL, 0xBD4B46F0599FD415ULL }, { 0xD4E5E2CDC1D1EA96ULL, 0x6C9E18AC7007C91AULL },
+    { 0x850FADC09923329EULL, 0x03E2CF6BC604DDB0ULL }, { 0xA6539930BF6BFF45ULL, 0x84DB8346B786151CULL },
+    { 0xCFE87F7CEF46FF16ULL, 0xE612641865679A63ULL }, { 0x81F14FAE158C5F6EULL, 0x4FCB7E8F3F60C07EULL },
+    { 0xA26DA3999AEF7749ULL, 0xE3BE5E330F38F09DULL }, { 0xCB090C8001AB551CULL, 0x5CADF5BFD3072CC5ULL },
+    { 0xFDCB4FA002162A63ULL, 0x73D9732FC7C8F7F6ULL }, { 0x9E9F11C4014DDA7EULL, 0x2867E7FDDCDD9AFAULL },
+    { 0xC646D63501A1511DULL, 0xB281E1FD541501B8ULL }, { 0xF7D88BC24209A565ULL, 0x1F225A7CA91A4226ULL },
+    { 0x9AE757596946075FULL, 0x3375788DE9B06958ULL }, { 0xC1A12D2FC3978937ULL, 0x0052D6B1641C83AEULL },
+    { 0xF209787BB47D6B84ULL, 0xC0678C5DBD23A49AULL }, { 0x9745EB4D50CE6332ULL, 0xF840B7BA963646E0ULL },
+    { 0xBD176620A501FBFFULL, 0xB650E5A93BC3D898ULL }, { 0xEC5D3FA8CE427AFFULL, 0xA3E51F138AB4CEBEULL },
+    { 0x93BA47C980E98CDFULL, 0xC66F336C36B10137ULL }, { 0xB8A8D9BBE123F017ULL, 0xB80B0047445D4184ULL },
+    { 0xE6D3102AD96CEC1DULL, 0xA60DC059157491E5ULL }, { 0x9043EA1AC7E41392ULL, 0x87C89837AD68DB2FULL },
+    { 0xB454E4A179DD1877ULL, 0x29BABE4598C311FBULL }, { 0xE16A1DC9D8545E94ULL, 0xF4296DD6FEF3D67AULL },
+    { 0x8CE2529E2734BB1DULL, 0x1899E4A65F58660CULL }, { 0xB01AE745B101E9E4ULL, 0x5EC05DCFF72E7F8FULL },
+    { 0xDC21A1171D42645DULL, 0x76707543F4FA1F73ULL }, { 0x899504AE72497EBAULL, 0x6A06494A791C53A8ULL },
+    { 0xABFA45DA0EDBDE69ULL, 0x0487DB9D17636892ULL }, { 0xD6F8D7509292D603ULL, 0x45A9D2845D3C42B6ULL },
+    { 0x865B86925B9BC5C2ULL, 0x0B8A2392BA45A9B2ULL }, { 0xA7F26836F282B732ULL, 0x8E6CAC7768D7141EULL },
+    { 0xD1EF0244AF2364FFULL, 0x3207D795430CD926ULL }, { 0x8335616AED761F1FULL, 0x7F44E6BD49E807B8ULL },
+    { 0xA402B9C5A8D3A6E7ULL, 0x5F16206C9C6209A6ULL }, { 0xCD036837130890A1ULL, 0x36DBA887C37A8C0FULL },
+    { 0x802221226BE55A64ULL, 0xC2494954DA2C9789ULL }, { 0xA02AA96B06DEB0FDULL, 0xF2DB9BAA10B7BD6CULL },
+    { 0xC83553C5C8965D3DULL, 0x6F92829494E5ACC7ULL }, { 0xFA42A8B73ABBF48CULL, 0xCB772339BA1F17F9ULL },
+    { 0x9C69A97284B578D7ULL, 0xFF2A760414536EFBULL }, { 0xC38413CF25E2D70DULL, 0xFEF5138519684ABAULL },
+    { 0xF46518C2EF5B8CD1ULL, 0x7EB258665FC25D69ULL }, { 0x98BF2F79D5993802ULL, 0xEF2F773FFBD97A61ULL },
+    { 0xBEEEFB584AFF8603ULL, 0xAAFB550FFACFD8FAULL }, { 0xEEAABA2E5DBF6784ULL, 0x95BA2A53F983CF38ULL },
+    { 0x952AB45CFA97A0B2ULL, 0xDD945A747BF26183ULL }, { 0xBA756174393D88DFULL, 0x94F971119AEEF9E4ULL },
+    { 0xE912B9D1478CEB17ULL, 0x7A37CD5601AAB85DULL }, { 0x91ABB422CCB812EEULL, 0xAC62E055C10AB33AULL },
+    { 0xB616A12B7FE617AAULL, 0x577B986B314D6009ULL }, { 0xE39C49765FDF9D94ULL, 0xED5A7E85FDA0B80BULL },
+    { 0x8E41ADE9FBEBC27DULL, 0x14588F13BE847307ULL }, { 0xB1D219647AE6B31CULL, 0x596EB2D8AE258FC8ULL },
+    { 0xDE469FBD99A05FE3ULL, 0x6FCA5F8ED9AEF3BBULL }, { 0x8AEC23D680043BEEULL, 0x25DE7BB9480D5854ULL },
+    { 0xADA72CCC20054AE9ULL, 0xAF561AA79A10AE6AULL }, { 0xD910F7FF28069DA4ULL, 0x1B2BA1518094DA04ULL },
+    { 0x87AA9AFF79042286ULL, 0x90FB44D2F05D0842ULL }, { 0xA99541BF57452B28ULL, 0x353A1607AC744A53ULL },
+    { 0xD3FA922F2D1675F2ULL, 0x42889B8997915CE8ULL }, { 0x847C9B5D7C2E09B7ULL, 0x69956135FEBADA11ULL },
+    { 0xA59BC234DB398C25ULL, 0x43FAB9837E699095ULL }, { 0xCF02B2C21207EF2EULL, 0x94F967E45E03F4BBULL },
+    { 0x8161AFB94B44F57DULL, 0x1D1BE0EEBAC278F5ULL }, { 0xA1BA1BA79E1632DCULL, 0x6462D92A69731732ULL },
+    { 0xCA28A291859BBF93ULL, 0x7D7B8F7503CFDCFEULL }, { 0xFCB2CB35E702AF78ULL, 0x5CDA735244C3D43EULL },
+    { 0x9DEFBF01B061ADABULL, 0x3A0888136AFA64A7ULL }, { 0xC56BAEC21C7A1916ULL, 0x088AAA1845B8FDD0ULL },
+    { 0xF6C69A72A3989F5BULL, 0x8AAD549E57273D45ULL }, { 0x9A3C2087A63F6399ULL, 0x36AC54E2F678864BULL },
+    { 0xC0CB28A98FCF3C7FULL, 0x84576A1BB416A7DDULL }, { 0xF0FDF2D3F3C30B9FULL, 0x656D44A2A11C51D5ULL },
+    { 0x969EB7C47859E743ULL, 0x9F644AE5A4B1B325ULL }, { 0xBC4665B596706114ULL, 0x873D5D9F0DDE1FEEULL },
+    { 0xEB57FF22FC0C7959ULL, 0xA90CB506D155A7EAULL }, { 0x9316FF75DD87CBD8ULL, 0x09A7F12442D588F2ULL },
+    { 0xB7DCBF5354E9BECEULL, 0x0C11ED6D538AEB2FULL }, { 0xE5D3EF282A242E81ULL, 0x8F1668C8A86DA5FAULL },
+    { 0x8FA475791A569D10ULL, 0xF96E017D694487BCULL }, { 0xB38D92D760EC4455ULL, 0x37C981DCC395A9ACULL },
+    { 0xE070F78D3927556AULL, 0x85BBE253F47B1417ULL }, { 0x8C469AB843B89562ULL, 0x93956D7478CCEC8EULL },
+    { 0xAF58416654A6BABBULL, 0x387AC8D1970027B2ULL }, { 0xDB2E51BFE9D0696AULL, 0x06997B05FCC0319EULL },
+    { 0x88FCF317F22241E2ULL, 0x441FECE3BDF81F03ULL }, { 0xAB3C2FDDEEAAD25AULL, 0xD527E81CAD7626C3ULL },
+    { 0xD60B3BD56A5586F1ULL, 0x8A71E223D8D3B074ULL }, { 0x85C7056562757456ULL, 0xF6872D5667844E49ULL },
+    { 0xA738C6BEBB12D16CULL, 0xB428F8AC016561DBULL }, { 0xD106F86E69D785C7ULL, 0xE13336D701BEBA52ULL },
+    { 0x82A45B450226B39CULL, 0xECC0024661173473ULL }, { 0xA34D721642B06084ULL, 0x27F002D7F95D0190ULL },
+    { 0xCC20CE9BD35C78A5ULL, 0x31EC038DF7B441F4ULL }, { 0xFF290242C83396CEULL, 0x7E67047175A15271ULL },
+    { 0x9F79A169BD203E41ULL, 0x0F0062C6E984D386ULL }, { 0xC75809C42C684DD1ULL, 0x52C07B78A3E60868ULL },
+    { 0xF92E0C3537826145ULL, 0xA7709A56CCDF8A82ULL }, { 0x9BBCC7A142B17CCBULL, 0x88A66076400BB691ULL },
+    { 0xC2ABF989935DDBFEULL, 0x6ACFF893D00EA435ULL }, { 0xF356F7EBF83552FEULL, 0x0583F6B8C4124D43ULL },
+    { 0x98165AF37B2153DEULL, 0xC3727A337A8B704AULL }, { 0xBE1BF1B059E9A8D6ULL, 0x744F18C0592E4C5CULL },
+    { 0xEDA2EE1C7064130CULL, 0x1162DEF06F79DF73ULL }, { 0x9485D4D1C63E8BE7ULL, 0x8ADDCB5645AC2BA8ULL },
+    { 0xB9A74A0637CE2EE1ULL, 0x6D953E2BD7173692ULL }, { 0xE8111C87C5C1BA99ULL, 0xC8FA8DB6CCDD0437ULL },
+    { 0x910AB1D4DB9914A0ULL, 0x1D9C9892400A22A2ULL }, { 0xB54D5E4A127F59C8ULL, 0x2503BEB6D00CAB4BULL },
+    { 0xE2A0B5DC971F303AULL, 0x2E44AE64840FD61DULL }, { 0x8DA471A9DE737E24ULL, 0x5CEAECFED289E5D2ULL },
+    { 0xB10D8E1456105DADULL, 0x7425A83E872C5F47ULL }, { 0xDD50F1996B947518ULL, 0xD12F124E28F77719ULL },
+    { 0x8A5296FFE33CC92FULL, 0x82BD6B70D99AAA6FULL }, { 0xACE73CBFDC0BFB7BULL, 0x636CC64D1001550BULL },
+    { 0xD8210BEFD30EFA5AULL, 0x3C47F7E05401AA4EULL }, { 0x8714A775E3E95C78ULL, 0x65ACFAEC34810A71ULL },
+    { 0xA8D9D1535CE3B396ULL, 0x7F1839A741A14D0DULL }, { 0xD31045A8341CA07CULL, 0x1EDE48111209A050ULL },
+    { 0x83EA2B892091E44DULL, 0x934AED0AAB460432ULL }, { 0xA4E4B66B68B65D60ULL, 0xF81DA84D5617853FULL },
+    { 0xCE1DE40642E3F4B9ULL, 0x36251260AB9D668EULL }, { 0x80D2AE83E9CE78F3ULL, 0xC1D72B7C6B426019ULL },
+    { 0xA1075A24E4421730ULL, 0xB24CF65B8612F81FULL }, { 0xC94930AE1D529CFCULL, 0xDEE033F26797B627ULL },
+    { 0xFB9B7CD9A4A7443CULL, 0x169840EF017DA3B1ULL }, { 0x9D412E0806E88AA5ULL, 0x8E1F289560EE864EULL },
+    { 0xC491798A08A2AD4EULL, 0xF1A6F2BAB92A27E2ULL }, { 0xF5B5D7EC8ACB58A2ULL, 0xAE10AF696774B1DBULL },
+    { 0x9991A6F3D6BF1765ULL, 0xACCA6DA1E0A8EF29ULL }, { 0xBFF610B0CC6EDD3FULL, 0x17FD090A58D32AF3ULL },
+    { 0xEFF394DCFF8A948EULL, 0xDDFC4B4CEF07F5B0ULL }, { 0x95F83D0A1FB69CD9ULL, 0x4ABDAF101564F98EULL },
+    { 0xBB764C4CA7A4440FULL, 0x9D6D1AD41ABE37F1ULL }, { 0xEA53DF5FD18D5513ULL, 0x84C86189216DC5EDULL },
+    { 0x92746B9BE2F8552CULL, 0x32FD3CF5B4E49BB4ULL }, { 0xB7118682DBB66A77ULL, 0x3FBC8C33221DC2A1ULL },
+    { 0xE4D5E82392A40515ULL, 0x0FABAF3FEAA5334AULL }, { 0x8F05B1163BA6832DULL, 0x29CB4D87F2A7400EULL },
+    { 0xB2C71D5BCA9023F8ULL, 0x743E20E9EF511012ULL }, { 0xDF78E4B2BD342CF6ULL, 0x914DA9246B255416ULL },
+    { 0x8BAB8EEFB6409C1AULL, 0x1AD089B6C2F7548EULL }, { 0xAE9672ABA3D0C320ULL, 0xA184AC2473B529B1ULL },
+    { 0xDA3C0F568CC4F3E8ULL, 0xC9E5D72D90A2741EULL }, { 0x8865899617FB1871ULL, 0x7E2FA67C7A658892ULL },
+    { 0xAA7EEBFB9DF9DE8DULL, 0xDDBB901B98FEEAB7ULL }, { 0xD51EA6FA85785631ULL, 0x552A74227F3EA565ULL },
+    { 0x8533285C936B35DEULL, 0xD53A88958F87275FULL }, { 0xA67FF273B8460356ULL, 0x8A892ABAF368F137ULL },
+    { 0xD01FEF10A657842CULL, 0x2D2B7569B0432D85ULL }, { 0x8213F56A67F6B29BULL, 0x9C3B29620E29FC73ULL },
+    { 0xA298F2C501F45F42ULL, 0x8349F3BA91B47B8FULL }, { 0xCB3F2F7642717713ULL, 0x241C70A936219A73ULL },
+    { 0xFE0EFB53D30DD4D7ULL, 0xED238CD383AA0110ULL }, { 0x9EC95D1463E8A506ULL, 0xF4363804324A40AAULL },
+    { 0xC67BB4597CE2CE48ULL, 0xB143C6053EDCD0D5ULL }, { 0xF81AA16FDC1B81DAULL, 0xDD94B7868E94050AULL },
+    { 0x9B10A4E5E9913128ULL, 0xCA7CF2B4191C8326ULL }, { 0xC1D4CE1F63F57D72ULL, 0xFD1C2F611F63A3F0ULL },
+    { 0xF24A01A73CF2DCCFULL, 0xBC633B39673C8CECULL }, { 0x976E41088617CA01ULL, 0xD5BE0503E085D813ULL },
+    { 0xBD49D14AA79DBC82ULL, 0x4B2D8644D8A74E18ULL }, { 0xEC9C459D51852BA2ULL, 0xDDF8E7D60ED1219EULL },
+    { 0x93E1AB8252F33B45ULL, 0xCABB90E5C942B503ULL }, { 0xB8DA1662E7B00A17ULL, 0x3D6A751F3B936243ULL },
+    { 0xE7109BFBA19C0C9DULL, 0x0CC512670A783AD4ULL }, { 0x906A617D450187E2ULL, 0x27FB2B80668B24C5ULL },
+    { 0xB484F9DC9641E9DAULL, 0xB1F9F660802DEDF6ULL }, { 0xE1A63853BBD26451ULL, 0x5E7873F8A0396973ULL },
+    { 0x8D07E33455637EB2ULL, 0xDB0B487B6423E1E8ULL }, { 0xB049DC016ABC5E5FULL, 0x91CE1A9A3D2CDA62ULL },
+    { 0xDC5C5301C56B75F7ULL, 0x7641A140CC7810FBULL }, { 0x89B9B3E11B6329BAULL, 0xA9E904C87FCB0A9DULL },
+    { 0xAC2820D9623BF429ULL, 0x546345FA9FBDCD44ULL }, { 0xD732290FBACAF133ULL, 0xA97C177947AD4095ULL },
+    { 0x867F59A9D4BED6C0ULL, 0x49ED8EABCCCC485DULL }, { 0xA81F301449EE8C70ULL, 0x5C68F256BFFF5A74ULL },
+    { 0xD226FC195C6A2F8CULL, 0x73832EEC6FFF3111ULL }, { 0x83585D8FD9C25DB7ULL, 0xC831FD53C5FF7EABULL },
+    { 0xA42E74F3D032F525ULL, 0xBA3E7CA8B77F5E55ULL }, { 0xCD3A1230C43FB26FULL, 0x28CE1BD2E55F35EBULL },
+    { 0x80444B5E7AA7CF85ULL, 0x7980D163CF5B81B3ULL }, { 0xA0555E361951C366ULL, 0xD7E105BCC332621FULL },
+    { 0xC86AB5C39FA63440ULL, 0x8DD9472BF3FEFAA7ULL }, { 0xFA856334878FC150ULL, 0xB14F98F6F0FEB951ULL },
+    { 0x9C935E00D4B9D8D2ULL, 0x6ED1BF9A569F33D3ULL }, { 0xC3B8358109E84F07ULL, 0x0A862F80EC4700C8ULL },
+    { 0xF4A642E14C6262C8ULL, 0xCD27BB612758C0FAULL }, { 0x98E7E9CCCFBD7DBDULL, 0x8038D51CB897789CULL },
+    { 0xBF21E44003ACDD2CULL, 0xE0470A63E6BD56C3ULL }, { 0xEEEA5D5004981478ULL, 0x1858CCFCE06CAC74ULL },
+    { 0x95527A5202DF0CCBULL, 0x0F37801E0C43EBC8ULL }, { 0xBAA718E68396CFFDULL, 0xD30560258F54E6BAULL },
+    { 0xE950DF20247C83FDULL, 0x47C6B82EF32A2069ULL }, { 0x91D28B7416CDD27EULL, 0x4CDC331D57FA5441ULL },
+    { 0xB6472E511C81471DULL, 0xE0133FE4ADF8E952ULL }, { 0xE3D8F9E563A198E5ULL, 0x58180FDDD97723A6ULL },
+    { 0x8E679C2F5E44FF8FULL, 0x570F09EAA7EA7648ULL }, { 0xB201833B35D63F73ULL, 0x2CD2CC6551E513DAULL },
+    { 0xDE81E40A034BCF4FULL, 0xF8077F7EA65E58D1ULL }, { 0x8B112E86420F6191ULL, 0xFB04AFAF27FAF782ULL },
+    { 0xADD57A27D29339F6ULL, 0x79C5DB9AF1F9B563ULL }, { 0xD94AD8B1C7380874ULL, 0x18375281AE7822BCULL },
+    { 0x87CEC76F1C830548ULL, 0x8F2293910D0B15B5ULL }, { 0xA9C2794AE3A3C69AULL, 0xB2EB3875504DDB22ULL },
+    { 0xD433179D9C8CB841ULL, 0x5FA60692A46151EBULL }, { 0x849FEEC281D7F328ULL, 0xDBC7C41BA6BCD333ULL },
+    { 0xA5C7EA73224DEFF3ULL, 0x12B9B522906C0800ULL }, { 0xCF39E50FEAE16BEFULL, 0xD768226B34870A00ULL },
+    { 0x81842F29F2CCE375ULL, 0xE6A1158300D46640ULL }, { 0xA1E53AF46F801C53ULL, 0x60495AE3C1097FD0ULL },
+    { 0xCA5E89B18B602368ULL, 0x385BB19CB14BDFC4ULL }, { 0xFCF62C1DEE382C42ULL, 0x46729E03DD9ED7B5ULL },
+    { 0x9E19DB92B4E31BA9ULL, 0x6C07A2C26A8346D1ULL }, { 0xC5A05277621BE293ULL, 0xC7098B7305241885ULL },
+    { 0xF70867153AA2DB38ULL, 0xB8CBEE4FC66D1EA7ULL }, { 0x9A65406D44A5C903ULL, 0x737F74F1DC043328ULL },
+    { 0xC0FE908895CF3B44ULL, 0x505F522E53053FF2ULL }, { 0xF13E34AABB430A15ULL, 0x647726B9E7C68FEFULL },
+    { 0x96C6E0EAB509E64DULL, 0x5ECA783430DC19F5ULL }, { 0xBC789925624C5FE0ULL, 0xB67D16413D132072ULL },
+    { 0xEB96BF6EBADF77D8ULL, 0xE41C5BD18C57E88FULL }, { 0x933E37A534CBAAE7ULL, 0x8E91B962F7B6F159ULL },
+    { 0xB80DC58E81FE95A1ULL, 0x723627BBB5A4ADB0ULL }, { 0xE61136F2227E3B09ULL, 0xCEC3B1AAA30DD91CULL },
+    { 0x8FCAC257558EE4E6ULL, 0x213A4F0AA5E8A7B1ULL }, { 0xB3BD72ED2AF29E1FULL, 0xA988E2CD4F62D19DULL },
+    { 0xE0ACCFA875AF45A7ULL, 0x93EB1B80A33B8605ULL }, { 0x8C6C01C9498D8B88ULL, 0xBC72F130660533C3ULL },
+    { 0xAF87023B9BF0EE6AULL, 0xEB8FAD7C7F8680B4ULL }, { 0xDB68C2CA82ED2A05ULL, 0xA67398DB9F6820E1ULL },
+    { 0x892179BE91D43A43ULL, 0x88083F8943A1148CULL }, { 0xAB69D82E364948D4ULL, 0x6A0A4F6B948959B0ULL },
+    { 0xD6444E39C3DB9B09ULL, 0x848CE34679ABB01CULL }, { 0x85EAB0E41A6940E5ULL, 0xF2D80E0C0C0B4E11ULL },
+    { 0xA7655D1D2103911FULL, 0x6F8E118F0F0E2195ULL }, { 0xD13EB46469447567ULL, 0x4B7195F2D2D1A9FBULL }
+};
+
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 _fmt_u128;
+#endif
 
-    int bytes = -1;
-    if (_net_types[id] == TCP) {
-        if (_net_active[id] == 1) {
-            bytes = recv(fd, out_buf, out_size - 1, 0);
-        } else {
-            struct sockaddr_in caddr;
-            socklen_t clen = sizeof(caddr);
-            net_fd n_fd = accept(fd, (struct sockaddr*)&caddr, &clen);
-            if (n_fd != (net_fd)-1) {
-                #ifdef _WIN32
-                unsigned long m = 1; ioctlsocket(n_fd, FIONBIO, &m);
-                #else
-                fcntl(n_fd, F_SETFL, O_NONBLOCK);
-                #endif
-                net_close(_net_fds[id]);
-                _net_fds[id] = n_fd;
-                _net_active[id] = 1;
-                strcpy(_last_client[id].host, inet_ntoa(caddr.sin_addr));
-                _last_client[id].port = ntohs(caddr.sin_port);
-                bytes = recv(_net_fds[id], out_buf, out_size - 1, 0);
-            }
+// High 64 bits of a * b; the low half goes to *lo.
+static inline unsigned long long _fmt_mul128(unsigned long long a, unsigned long long b, unsigned long long* lo) {
+#if defined(__SIZEOF_INT128__)
+    _fmt_u128 p = (_fmt_u128)a * b;
+    *lo = (unsigned long long)p;
+    return (unsigned long long)(p >> 64);
+#else
+    unsigned long long al = a & 0xFFFFFFFFULL, ah = a >> 32, bl = b & 0xFFFFFFFFULL, bh = b >> 32;
+    unsigned long long ll = al * bl, lh = al * bh, hl = ah * bl, hh = ah * bh;
+    unsigned long long mid = (ll >> 32) + (lh & 0xFFFFFFFFULL) + (hl & 0xFFFFFFFFULL);
+    *lo = (mid << 32) | (ll & 0xFFFFFFFFULL);
+    return hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif
+}
+
+static inline int _fmt_clz64(unsigned long long v) {
+#if defined(__GNUC__)
+    return __builtin_clzll(v);
+#else
+    int n = 0;
+    while (!(v & 0x8000000000000000ULL)) { v <<= 1; n++; }
+    return n;
+#endif
+}
+
+// Grisu3 (Loitsch, "Printing Floating-Point Numbers Quickly and Accurately"):
+// the digits of the upper boundary are generated in 64-bit fixed point and
+// trimmed while they stay inside the rounding interval. Returns 0 for the
+// ~0.5% of inputs it cannot prove shortest and closest.
+static inline int _fmt_round_weed(char* digits, int len, unsigned long long dist_high, unsigned long long unsafe,
+                                  unsigned long long rest, unsigned long long ten_kappa, unsigned long long unit) {
+    unsigned long long small_dist = dist_high - unit, big_dist = dist_high + unit;
+    while (rest < small_dist && unsafe - rest >= ten_kappa &&
+           (rest + ten_kappa < small_dist || small_dist - rest >= rest + ten_kappa - small_dist)) {
+        digits[len - 1]--;
+        rest += ten_kappa;
+    }
+    if (rest < big_dist && unsafe - rest >= ten_kappa &&
+        (rest + ten_kappa < big_dist || big_dist - rest > rest + ten_kappa - big_dist))
+        return 0;
+    return 2 * unit <= rest && rest <= unsafe - 4 * unit;
+}
+
+static inline int _fmt_grisu3(unsigned long long f, int e, int lower_closer, char* digits, int* len, int* dec_exp) {
+    // Boundaries m+ and m-, and w itself, all normalized to the exponent of m+.
+    unsigned long long mp = (f << 1) + 1, mm;
+    int shift = _fmt_clz64(mp), ew = e - 1 - shift;
+    mp <<= shift;
+    mm = lower_closer ? (f << 2) - 1 : (f << 1) - 1;
+    mm <<= shift - lower_closer;
+    unsigned long long w = f << (shift + 1);
+
+    // Pick 10^q that brings the product exponent into [-60, -32].
+    int q = ((-61 - ew) * 78913) >> 18;
+    while (((217706 * q) >> 16) - 63 + ew + 64 < -60) q++;
+    while (((217706 * q) >> 16) - 63 + ew + 64 > -32) q--;
+    const unsigned long long* c = _fmt_pow10[q - _FMT_POW10_MIN];
+    unsigned long long cf = c[0] + (c[1] >> 63), lo;
+    int one_e = -(((217706 * q) >> 16) - 63 + ew + 64);
+    unsigned long long W = _fmt_mul128(w, cf, &lo);   W += lo >> 63;
+    unsigned long long high = _fmt_mul128(mp, cf, &lo); high += lo >> 63;
+    unsigned long long low = _fmt_mul128(mm, cf, &lo); low += lo >> 63;
+
+    unsigned long long unit = 1, too_high = high + unit, unsafe = too_high - (low - unit);
+    unsigned long long one = 1ULL << one_e, frac = too_high & (one - 1);
+    unsigned ints = (unsigned)(too_high >> one_e), div = 1;
+    int kappa = 1;
+    while (div <= ints / 10) { div *= 10; kappa++; }
+    int n = 0;
+    while (kappa > 0) {
+        digits[n++] = (char)('0' + ints / div);
+        ints %= div;
+        kappa--;
+        unsigned long long rest = ((unsigned long long)ints << one_e) + frac;
+        if (rest < unsafe) {
+            *len = n; *dec_exp = kappa - q;
+            return _fmt_round_weed(digits, n, too_high - W, unsafe, rest, (unsigned long long)div << one_e, unit);
         }
-    } else {
-        struct sockaddr_in src;
-        socklen_t src_len = sizeof(src);
-        bytes = recvfrom(fd, out_buf, out_size - 1, 0, (struct sockaddr*)&src, &src_len);
-        if (bytes > 0) {
-            strcpy(_last_client[id].host, inet_ntoa(src.sin_addr));
-            _last_client[id].port = ntohs(src.sin_port);
+        div /= 10;
+    }
+    for (;;) {
+        frac *= 10; unit *= 10; unsafe *= 10;
+        digits[n++] = (char)('0' + (frac >> one_e));
+        frac &= one - 1;
+        kappa--;
+        if (frac < unsafe) {
+            *len = n; *dec_exp = kappa - q;
+            return _fmt_round_weed(digits, n, (too_high - W) * unit, unsafe, frac, one, unit);
         }
     }
+}
 
-    if (bytes > 0) out_buf[bytes] = 0;
-    net_unlock(&_net_global_lock);
-    return bytes;
+// Fallback for Grisu3 failures: the first precision that round-trips through
+// printf/strtod is the shortest, and printf rounds it correctly. Grisu's digit
+// count is a lower bound (its interval contains the exact one), so the search
+// starts there.
+_TOOLS_COLD static void _fmt_shortest_slow(double v, char* digits, int* len, int* dec_exp) {
+    char tmp[40];
+    for (int prec = *len > 0 && *len <= 17 ? *len : 1; prec <= 17; prec++) {
+        snprintf(tmp, sizeof(tmp), "%.*e", prec - 1, v);
+        if (prec < 17 && strtod(tmp, NULL) != v) continue;
+        int n = 0;
+        const char* p = tmp;
+        for (; *p && *p != 'e'; p++) if (*p >= '0' && *p <= '9') digits[n++] = *p;
+        while (n > 1 && digits[n - 1] == '0') n--;
+        *len = n;
+        *dec_exp = atoi(p + 1) - (n - 1);
+        return;
+    }
 }
 
-static inline ClientInfo getclientinfo(int id) {
-    ClientInfo info = {"", 0};
-    if (id >= 0 && id < MAX_IDS) {
-        net_lock(&_net_global_lock);
-        info = _last_client[id];
-        net_unlock(&_net_global_lock);
+// Shortest round-trip form: "0.1", "1e+21", "5e-324". Plain notation for
+// 1e-6 <= |v| < 1e21, otherwise d.ddde+XX, as JavaScript prints numbers.
+// NaN and infinities come out as "nan", "inf", "-inf". Writes a NUL into dst
+// (FMT_DOUBLE_MAX bytes) and returns the length.
+static inline size_t fmt_double(char* dst, double v) {
+    unsigned long long bits;
+    memcpy(&bits, &v, 8);
+    char* p = dst;
+    if (bits >> 63) *p++ = '-';
+    unsigned long long f = bits & 0xFFFFFFFFFFFFFULL;
+    int be = (int)(bits >> 52 & 0x7FF);
+    if (be == 0x7FF) {
+        if (f) { memcpy(dst, "nan", 4); return 3; }
+        memcpy(p, "inf", 4); return (size_t)(p - dst) + 3;
     }
-    return info;
+    if (!be && !f) { memcpy(p, "0", 2); return (size_t)(p - dst) + 1; }
+
+    char digits[20];
+    int len = 0, k = 0;
+    int e = be ? be - 1075 : -1074;
+    if (be) f |= 1ULL << 52;
+    if (!_fmt_grisu3(f, e, f == 1ULL << 52 && be > 1, digits, &len, &k))
+        _fmt_shortest_slow(bits >> 63 ? -v : v, digits, &len, &k);
+
+    int point = len + k; // digits are d1..dlen * 10^k; point is where the '.' goes
+    if (k >= 0 && point <= 21) {
+        memcpy(p, digits, (size_t)len); p += len;
+        memset(p, '0', (size_t)k); p += k;
+    } else if (point > 0 && point <= 21) {
+        memcpy(p, digits, (size_t)point); p += point;
+        *p++ = '.';
+        memcpy(p, digits + point, (size_t)(len - point)); p += len - point;
+    } else if (point > -6 && point <= 0) {
+        *p++ = '0'; *p++ = '.';
+        memset(p, '0', (size_t)-point); p += -point;
+        memcpy(p, digits, (size_t)len); p += len;
+    } else {
+        int x = point - 1;
+        *p++ = digits[0];
+        if (len > 1) { *p++ = '.'; memcpy(p, digits + 1, (size_t)(len - 1)); p += len - 1; }
+        *p++ = 'e'; *p++ = x < 0 ? '-' : '+';
+        if (x < 0) x = -x;
+        if (x >= 100) { *p++ = (char)('0' + x / 100); x %= 100; memcpy(p, _dec_pairs + 2 * x, 2); p += 2; }
+        else if (x >= 10) { memcpy(p, _dec_pairs + 2 * x, 2); p += 2; }
+        else *p++ = (char)('0' + x);
+    }
+    *p = '\0';
+    return (size_t)(p - dst);
 }
 
-#endif
+static inline int sb_append_u64(qol_sb* sb, unsigned long long v) {
+    if (!sb_reserve(sb, FMT_INT_MAX)) return 0;
+    sb->len += fmt_u64(sb->data + sb->len, v);
+    return 1;
+}
 
+static inline int sb_append_i64(qol_sb* sb, long long v) {
+    if (!sb_reserve(sb, FMT_INT_MAX)) return 0;
+    sb->len += fmt_i64(sb->data + sb->len, v);
+    return 1;
+}
 
-/* Source: SimpleParse/simple_parse.h */
-#ifndef SIMPLE_PARSE_H
+static inline int sb_append_double(qol_sb* sb, double v) {
+    if (!sb_reserve(sb, FMT_DOUBLE_MAX)) return 0;
+    sb->len += fmt_double(sb->data + sb->len, v);
+    return 1;
+}
 
-#include <stdio.h>
-#include <string.h>
-#include <stdlib.h>
-#include <stdarg.h>
+// True when all 8 bytes are ASCII digits.
+static inline int _parse_is_8digits(unsigned long long x) {
+    return ((x & 0xF0F0F0F0F0F0F0F0ULL) | (((x + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+}
 
-typedef struct {
-    int byte;
-    int lbyte;
-    int line;
-    char fullstr[256];
-    char str[256];
-    char con[256];
-    void* conparsed[64];
-} Parsed;
+// Eight ASCII digits (first digit in the lowest byte) to their value with three multiplies.
+static inline unsigned _parse_8digits(unsigned long long x) {
+    x -= 0x3030303030303030ULL;
+    x = (x * 10) + (x >> 8);
+    x = (((x & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+         (((x >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+    return (unsigned)x;
+}
 
-/* --- Memory Cleanup --- */
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ || defined(_WIN32)
+    #define _PARSE_SWAR 1
+#endif
 
-static inline void freeconparsed(Parsed* p) {
-    if (!p) return;
-    for (int i = 0; i < 64; i++) {
-        if (p->conparsed[i] != NULL) {
-            free(p->conparsed[i]);
-            p->conparsed[i] = NULL;
-        }
+// Reads up to max digits of s[*i..n) into *v; returns how many were read.
+static inline int _parse_digits(const char* s, size_t n, size_t* i, unsigned long long* v, int max) {
+    int count = 0;
+#ifdef _PARSE_SWAR
+    unsigned long long x;
+    while (count + 8 <= max && *i + 8 <= n) {
+        memcpy(&x, s + *i, 8);
+        if (!_parse_is_8digits(x)) break;
+        *v = *v * 100000000ULL + _parse_8digits(x);
+        *i += 8; count += 8;
     }
+#endif
+    while (count < max && *i < n && (unsigned)(s[*i] - '0') < 10) { *v = *v * 10 + (unsigned)(s[*i] - '0'); (*i)++; count++; }
+    return count;
 }
 
-/* --- Internal Helpers --- */
+// Parses decimal digits at the start of s[0..n) into *out. Returns the number of
+// bytes consumed, or 0 if there are no digits or the value overflows.
+static inline size_t parse_u64(const char* s, size_t n, unsigned long long* out) {
+    unsigned long long v = 0;
+    size_t i = 0;
+    while (i < n && s[i] == '0') i++;   // Leading zeros do not count toward the 19-digit cap.
+    _parse_digits(s, n, &i, &v, 19);
+    if (!i) return 0;
+    if (i < n && (unsigned)(s[i] - '0') < 10) {
+        unsigned d = (unsigned)(s[i] - '0');
+        if (v > (~0ULL - d) / 10 || (i + 1 < n && (unsigned)(s[i + 1] - '0') < 10)) return 0;
+        v = v * 10 + d; i++;
+    }
+    *out = v;
+    return i;
+}
 
-static inline int _sp_count_lines(const char* start, const char* end) {
-    int lines = 1;
-    for (const char* p = start; p < end; p++) if (*p == '\n') lines++;
-    return lines;
+// Optional sign, then digits. Returns bytes consumed, 0 on no digits or overflow.
+static inline size_t parse_i64(const char* s, size_t n, long long* out) {
+    size_t sign = n && (s[0] == '-' || s[0] == '+');
+    unsigned long long v;
+    size_t used = parse_u64(s + sign, n - sign, &v);
+    if (!used) return 0;
+    if (s[0] == '-') {
+        if (v > 0x8000000000000000ULL) return 0;
+        *out = (long long)(0ULL - v);
+    } else {
+        if (v > 0x7FFFFFFFFFFFFFFFULL) return 0;
+        *out = (long long)v;
+    }
+    return sign + used;
 }
 
-static inline const char* _sp_get_line_ptr(const char* haystack, int line_num) {
-    if (line_num <= 1) return haystack;
-    const char* p = haystack;
-    int current_line = 1;
-    while (*p) {
-        if (*p == '\n') {
-            current_line++;
-            if (current_line == line_num) return p + 1;
-        }
-        p++;
+// Eisel-Lemire (as in Go's strconv): w * 10^q from one or two 64x128-bit
+// products. Returns 0 when the result is ambiguous or out of normal range.
+static inline int _parse_eisel_lemire(unsigned long long w, int q, int neg, double* out) {
+    int clz = _fmt_clz64(w);
+    w <<= clz;
+    unsigned long long exp2 = (unsigned long long)(((217706 * q) >> 16) + 64 + 1023 - clz);
+    const unsigned long long* t = _fmt_pow10[q - _FMT_POW10_MIN];
+    unsigned long long lo, hi = _fmt_mul128(w, t[0], &lo);
+    if ((hi & 0x1FF) == 0x1FF && lo + w < w) {
+        unsigned long long ylo, yhi = _fmt_mul128(w, t[1], &ylo);
+        unsigned long long mlo = lo + yhi, mhi = hi + (mlo < lo);
+        if ((mhi & 0x1FF) == 0x1FF && mlo + 1 == 0 && ylo + w < w) return 0;
+        hi = mhi; lo = mlo;
     }
-    return NULL;
+    unsigned long long msb = hi >> 63, mant = hi >> (msb + 9);
+    exp2 -= 1 ^ msb;
+    if (lo == 0 && (hi & 0x1FF) == 0 && (mant & 3) == 1) return 0; // exactly halfway
+    mant += mant & 1;
+    mant >>= 1;
+    if (mant >> 53) { mant >>= 1; exp2++; }
+    if (exp2 - 1 >= 0x7FF - 1) return 0; // subnormal or overflow
+    unsigned long long bits = exp2 << 52 | (mant & 0xFFFFFFFFFFFFFULL) | (unsigned long long)neg << 63;
+    memcpy(out, &bits, 8);
+    return 1;
 }
 
-static inline const char* _sp_find_line_start(const char* haystack, const char* pos) {
-    const char* p = pos;
-    while (p > haystack && *(p - 1) != '\n') p--;
-    return p;
+// strtod on a private NUL-terminated copy, since s may not be terminated.
+_TOOLS_COLD static double _parse_double_slow(const char* s, size_t n) {
+    char tmp[128];
+    char* buf = n < sizeof(tmp) ? tmp : (char*)QOL_MALLOC(n + 1);
+    if (!buf) return 0.0;
+    memcpy(buf, s, n);
+    buf[n] = '\0';
+    double v = strtod(buf, NULL);
+    if (buf != tmp) QOL_FREE(buf);
+    return v;
 }
 
-static inline void _sp_tokenize_content(Parsed* p) {
-    char temp[256];
-    strncpy(temp, p->con, 255);
-    char* saveptr;
-    char* token = strtok_r(temp, ",", &saveptr);
-    int i = 0;
-    while (token && i < 64) {
-        while (*token == ' ') token++;
-        if (*token == '"') {
-            char* end = strrchr(token, '"');
-            if (end) *end = '\0';
-            p->conparsed[i] = strdup(token + 1);
-        } else {
-            int* val = malloc(sizeof(int));
-            *val = atoi(token);
-            p->conparsed[i] = val;
+// Parses [+-]digits[.digits][(e|E)[+-]digits] at the start of s[0..n) into
+// *out. Returns the number of bytes consumed, or 0 if there is no number.
+// Up to 19 significant digits are converted directly (Clinger's exact path,
+// then Eisel-Lemire); longer inputs and the rare ambiguous cases use strtod.
+static inline size_t parse_double(const char* s, size_t n, double* out) {
+    static const double p10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+    size_t i = 0;
+    int neg = n && s[0] == '-';
+    if (n && (s[0] == '-' || s[0] == '+')) i++;
+    size_t start = i;
+
+    // Significand: w holds the first 19 significant digits, value = w * 10^q.
+    unsigned long long w = 0;
+    int sig, q = 0, exact = 1;
+    while (i < n && s[i] == '0') i++;
+    sig = _parse_digits(s, n, &i, &w, 19);
+    for (; i < n && (unsigned)(s[i] - '0') < 10; i++) { q++; exact &= s[i] == '0'; }
+    int has_digits = i > start;
+    if (i < n && s[i] == '.') {
+        size_t frac = ++i;
+        if (!sig) while (i < n && s[i] == '0') i++;
+        sig += _parse_digits(s, n, &i, &w, 19 - sig);
+        q -= (int)(i - frac);
+        for (; i < n && (unsigned)(s[i] - '0') < 10; i++) exact &= s[i] == '0';
+        has_digits |= i > frac;
+    }
+    if (!has_digits) return 0;
+
+    if (i < n && (s[i] == 'e' || s[i] == 'E')) {
+        size_t j = i + 1;
+        int eneg = j < n && s[j] == '-', x = 0;
+        if (j < n && (s[j] == '-' || s[j] == '+')) j++;
+        if (j < n && (unsigned)(s[j] - '0') < 10) {
+            for (; j < n && (unsigned)(s[j] - '0') < 10; j++) if (x < 100000) x = x * 10 + (s[j] - '0');
+            q += eneg ? -x : x;
+            i = j;
         }
-        token = strtok_r(NULL, ",", &saveptr);
-        i++;
     }
+
+    double v;
+    if (!exact) v = _parse_double_slow(s, i);
+    else if (!w) v = neg ? -0.0 : 0.0;
+    else if (w <= 9007199254740992ULL && q >= -22 && q <= 22) {
+        v = (double)w;
+        v = q < 0 ? v / p10[-q] : v * p10[q];
+        if (neg) v = -v;
+    }
+    else if (q < _FMT_POW10_MIN) v = neg ? -0.0 : 0.0;
+    else if (q > 308) { unsigned long long inf = 0x7FF0000000000000ULL | (unsigned long long)neg << 63; memcpy(&v, &inf, 8); }
+    else if (!_parse_eisel_lemire(w, q, neg, &v)) v = _parse_double_slow(s, i);
+    *out = v;
+    return i;
 }
 
-/* --- Core Parsing Logic --- */
+/* --- Random Numbers --- */
+// Not for keys or tokens: these generators are fast and statistically strong,
+// but predictable from their output.
+//   qol_rng     xoshiro256++: 256-bit state, period 2^256 - 1, jumps for parallel streams.
+//   qol_pcg32   PCG-XSH-RR: 128-bit state, 32-bit output, 2^63 selectable streams.
+//   qol_rng8    eight interleaved xoshiro256++ lanes for SIMD bulk fills.
 
-static inline int parse(const char* haystack, const char* needle) {
-    return (haystack && needle && strstr(haystack, needle) != NULL);
-}
+typedef struct { unsigned long long s[4]; } qol_rng;
+typedef struct { unsigned long long state, inc; } qol_pcg32;
 
-static inline int parseex(const char* input, const char* format, ...) {
-    if (!input || !format) return 0;
-    va_list args;
-    va_start(args, format);
-    int items = vsscanf(input, format, args);
-    va_end(args);
-    return items;
-}
+static inline unsigned long long _rng_rotl(unsigned long long x, int k) { return (x << k) | (x >> (64 - k)); }
 
-static inline Parsed advparse(const char* haystack, const char* needle) {
-    Parsed p = { -1, -1, -1, {0}, {0}, {0}, {0} };
-    if (!haystack || !needle) return p;
-    const char* pos = strstr(haystack, needle);
-    if (pos) {
-        p.byte = (int)(pos - haystack);
-        p.line = _sp_count_lines(haystack, pos);
-        p.lbyte = (int)(pos - _sp_find_line_start(haystack, pos));
-        strncpy(p.fullstr, needle, 255);
-    }
-    return p;
+// splitmix64: spreads one seed word over a whole state (and never yields all-zero xoshiro state in practice).
+static inline unsigned long long _rng_splitmix(unsigned long long* x) {
+    unsigned long long z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
 }
 
-static inline Parsed parsecon(const char* haystack, const char* pattern) {
-    Parsed p = { -1, -1, -1, {0}, {0}, {0}, {0} };
-    char fmt[256]; strncpy(fmt, pattern, 255);
-    char* split = strstr(fmt, "%%");
-    if (!split) return p;
-    *split = '\0';
-    char* prefix = fmt; char* suffix = split + 2;
-
-    const char* start_ptr = strstr(haystack, prefix);
-    if (!start_ptr) return p;
+static inline void rng_seed(qol_rng* r, unsigned long long seed) {
+    for (int i = 0; i < 4; i++) r->s[i] = _rng_splitmix(&seed);
+}
 
-    const char* val_start = start_ptr + strlen(prefix);
-    const char* end_ptr = strstr(val_start, suffix);
-    if (!end_ptr) return p;
+static inline unsigned long long rng_next(qol_rng* r) {
+    unsigned long long* s = r->s;
+    unsigned long long out = _rng_rotl(s[0] + s[3], 23) + s[0], t = s[1] << 17;
+    s[2] ^= s[0]; s[3] ^= s[1]; s[1] ^= s[2]; s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = _rng_rotl(s[3], 45);
+    return out;
+}
 
-    p.byte = (int)(start_ptr - haystack);
-    p.line = _sp_count_lines(haystack, start_ptr);
-    p.lbyte = (int)(start_ptr - _sp_find_line_start(haystack, start_ptr));
+static inline void _rng_jump_by(qol_rng* r, const unsigned long long* poly) {
+    unsigned long long acc[4] = { 0, 0, 0, 0 };
+    for (int w = 0; w < 4; w++)
+        for (int b = 0; b < 64; b++) {
+            if (poly[w] >> b & 1) for (int i = 0; i < 4; i++) acc[i] ^= r->s[i];
+            rng_next(r);
+        }
+    memcpy(r->s, acc, sizeof(acc));
+}
 
-    int full_len = (int)((end_ptr + strlen(suffix)) - start_ptr);
-    if (full_len > 255) full_len = 255;
-    strncpy(p.fullstr, start_ptr, full_len); p.fullstr[full_len] = '\0';
-    snprintf(p.str, 255, "%s%s", prefix, suffix);
+// Advances 2^128 steps: seed once, then jump after handing a copy to each thread
+// for up to 2^128 non-overlapping streams of 2^128 values.
+static inline void rng_jump(qol_rng* r) {
+    static const unsigned long long poly[4] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+    _rng_jump_by(r, poly);
+}
 
-    int con_len = (int)(end_ptr - val_start);
-    if (con_len > 255) con_len = 255;
-    strncpy(p.con, val_start, con_len); p.con[con_len] = '\0';
+// Advances 2^192 steps, for a second level of streams (e.g. per machine, then rng_jump per thread).
+static inline void rng_long_jump(qol_rng* r) {
+    static const unsigned long long poly[4] = { 0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL, 0x77710069854ee241ULL, 0x39109bb02acbe635ULL };
+    _rng_jump_by(r, poly);
+}
 
-    _sp_tokenize_content(&p);
-    return p;
+// Uniform in [0, n) with no modulo bias (Lemire): one multiply, and a division
+// only in the rare case that the low half lands in the biased zone. n = 0 returns 0.
+static inline unsigned long long rng_below(qol_rng* r, unsigned long long n) {
+    unsigned long long lo, hi = _fmt_mul128(rng_next(r), n, &lo);
+    if (lo < n) {
+        unsigned long long t = (0 - n) % n;
+        while (lo < t) hi = _fmt_mul128(rng_next(r), n, &lo);
+    }
+    return hi;
 }
 
-/* --- Line Logic --- */
+// Uniform in [lo, hi], inclusive; the full long long range works.
+static inline long long rng_range(qol_rng* r, long long lo, long long hi) {
+    unsigned long long span = (unsigned long long)hi - (unsigned long long)lo + 1;
+    unsigned long long off = span ? rng_below(r, span) : rng_next(r);
+    return (long long)((unsigned long long)lo + off);
+}
 
-static inline int parseline(const char* haystack, int line_num, char* dest, int max_len) {
-    const char* line_ptr = _sp_get_line_ptr(haystack, line_num);
-    if (!line_ptr) return 0;
-    int i = 0;
-    while (line_ptr[i] && line_ptr[i] != '\n' && line_ptr[i] != '\r' && i < max_len - 1) {
-        dest[i] = line_ptr[i];
-        i++;
+// [0, 1) from the top 53 bits: every value is a multiple of 2^-53.
+static inline double rng_double(qol_rng* r) { return (double)(rng_next(r) >> 11) * (1.0 / 9007199254740992.0); }
+static inline float rng_float(qol_rng* r) { return (float)(rng_next(r) >> 40) * (1.0f / 16777216.0f); }
+
+// The calling thread's generator, seeded on first use from the clock and the
+// thread's own address, so threads never share a sequence.
+static inline qol_rng* rng_local() {
+    static _TOOLS_TLS qol_rng state;
+    static _TOOLS_TLS int seeded = 0;
+    if (!seeded) {
+        unsigned long long mix = time_mono_ns() ^ time_cycles() ^ ((unsigned long long)(size_t)&state * 0x9E3779B97F4A7C15ULL);
+        rng_seed(&state, mix);
+        seeded = 1;
     }
-    dest[i] = '\0';
-    return 1;
+    return &state;
 }
 
-static inline Parsed parselineadv(const char* haystack, int line_num) {
-    Parsed p = { -1, 0, line_num, {0}, {0}, {0}, {0} };
-    const char* line_start = _sp_get_line_ptr(haystack, line_num);
-    if (!line_start) return p;
+/* PCG32 */
+
+#define _PCG_MULT 6364136223846793005ULL
 
-    p.byte = (int)(line_start - haystack);
-    parseline(haystack, line_num, p.fullstr, 256);
+static inline unsigned int pcg32_next(qol_pcg32* p) {
+    unsigned long long old = p->state;
+    p->state = old * _PCG_MULT + p->inc;
+    unsigned int xs = (unsigned int)(((old >> 18) ^ old) >> 27), rot = (unsigned int)(old >> 59);
+    return (xs >> rot) | (xs << ((0u - rot) & 31));
+}
 
-    char *open_paren = strchr(p.fullstr, '(');
-    char *close_paren = strrchr(p.fullstr, ')');
+// Generators with the same seed but different streams produce unrelated sequences.
+static inline void pcg32_seed(qol_pcg32* p, unsigned long long seed, unsigned long long stream) {
+    p->state = 0;
+    p->inc = (stream << 1) | 1;
+    pcg32_next(p);
+    p->state += seed;
+    pcg32_next(p);
+}
 
-    if (open_paren && close_paren && close_paren > open_paren) {
-        int prefix_len = (int)(open_paren - p.fullstr);
-        strncpy(p.str, p.fullstr, prefix_len);
-        p.str[prefix_len] = '\0';
-        strcat(p.str, "()");
-        
-        int con_len = (int)(close_paren - (open_paren + 1));
-        if (con_len > 0) {
-            strncpy(p.con, open_paren + 1, (con_len > 255) ? 255 : con_len);
-            p.con[(con_len > 255) ? 255 : con_len] = '\0';
-            _sp_tokenize_content(&p);
-        }
-    } else {
-        strncpy(p.str, p.fullstr, 255);
+// Skips delta outputs in O(log delta) (delta may also be "negative" to step back).
+static inline void pcg32_advance(qol_pcg32* p, unsigned long long delta) {
+    unsigned long long mult = _PCG_MULT, plus = p->inc, acc_mult = 1, acc_plus = 0;
+    for (; delta; delta >>= 1) {
+        if (delta & 1) { acc_mult *= mult; acc_plus = acc_plus * mult + plus; }
+        plus = (mult + 1) * plus;
+        mult *= mult;
     }
-    return p;
+    p->state = acc_mult * p->state + acc_plus;
 }
 
-static inline Parsed parselinecon(const char* haystack, int line_num, const char* pattern) {
-    const char* line_ptr = _sp_get_line_ptr(haystack, line_num);
-    if (!line_ptr) { Parsed empty = {-1,-1,-1}; return empty; }
-    Parsed p = parsecon(line_ptr, pattern);
-    if (p.byte != -1) {
-        p.lbyte = p.byte; 
-        p.byte += (int)(line_ptr - haystack); 
-        p.line = line_num;
+static inline unsigned int pcg32_below(qol_pcg32* p, unsigned int n) {
+    unsigned long long m = (unsigned long long)pcg32_next(p) * n;
+    if ((unsigned int)m < n) {
+        unsigned int t = (0u - n) % n;
+        while ((unsigned int)m < t) m = (unsigned long long)pcg32_next(p) * n;
     }
-    return p;
+    return (unsigned int)(m >> 32);
 }
 
-#endif
+static inline float pcg32_float(qol_pcg32* p) { return (float)(pcg32_next(p) >> 8) * (1.0f / 16777216.0f); }
 
+/* Bulk generation */
 
-/* Source: SimpleThreads/simple_threads.h */
-#ifndef SIMPLE_THREADS_H
+// Eight xoshiro256++ lanes, each rng_jump'ed from the previous one, stored by
+// word: s[w][lane]. Fills write lane 0..7 values in turn, so the output is the
+// same on every dispatch level; the tail of a fill that is not a multiple of 8
+// discards the rest of its last round.
+#define RNG8_LANES 8
 
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
+typedef struct { unsigned long long s[4][RNG8_LANES]; } qol_rng8;
 
-#if defined(_WIN32) || defined(_WIN64)
-    #include <windows.h>
-    typedef HANDLE native_t;
-#else
-    #define _GNU_SOURCE
-    #include <pthread.h>
-    #include <unistd.h>
-    typedef pthread_t native_t;
-#endif
+static inline void rng8_init(qol_rng8* g, const qol_rng* src) {
+    qol_rng r = *src;
+    for (int k = 0; k < RNG8_LANES; k++) {
+        for (int w = 0; w < 4; w++) g->s[w][k] = r.s[w];
+        rng_jump(&r);
+    }
+}
 
-#define MAX_THREADS 256
-static native_t _st_pool[MAX_THREADS] = {0};
-static void* _st_results[MAX_THREADS] = {0};
+static inline void rng8_seed(qol_rng8* g, unsigned long long seed) {
+    qol_rng r;
+    rng_seed(&r, seed);
+    rng8_init(g, &r);
+}
 
-typedef struct {
-    void* user_fn;
-    char* args_str;
-    int id;
-    int type; 
-    int arg_count; 
-} _st_pkt;
+// One round: 8 outputs, for the tail of a fill.
+static inline void _rng8_round(qol_rng8* g, unsigned long long* out) {
+    for (int k = 0; k < RNG8_LANES; k++) {
+        unsigned long long s0 = g->s[0][k], s1 = g->s[1][k], s2 = g->s[2][k], s3 = g->s[3][k];
+        out[k] = _rng_rotl(s0 + s3, 23) + s0;
+        unsigned long long t = s1 << 17;
+        s2 ^= s0; s3 ^= s1; s1 ^= s2; s0 ^= s3;
+        s2 ^= t;
+        g->s[0][k] = s0; g->s[1][k] = s1; g->s[2][k] = s2; g->s[3][k] = _rng_rotl(s3, 45);
+    }
+}
 
-static char* _st_strdup(const char* s) {
-    if (!s) return NULL;
-    size_t len = strlen(s) + 1;
-    char* d = malloc(len);
-    if (d) memcpy(d, s, len);
-    return d;
+// 1.0 + 52 random mantissa bits, minus 1: [0, 1) in steps of 2^-52, with no int-to-float conversion.
+static inline double _rng_bits_to_double(unsigned long long x) {
+    double d;
+    x = (x >> 12) | 0x3FF0000000000000ULL;
+    memcpy(&d, &x, sizeof(d));
+    return d - 1.0;
 }
 
-#ifdef _WIN32
-static DWORD WINAPI _st_entry(LPVOID p) {
-#else
-static void* _st_entry(void* p) {
+#ifdef _TOOLS_X86_SIMD
+// One xoshiro256++ step on four lanes.
+__attribute__((target("avx2")))
+static inline __m256i _rng_avx2_step(__m256i* s0, __m256i* s1, __m256i* s2, __m256i* s3) {
+    __m256i sum = _mm256_add_epi64(*s0, *s3);
+    __m256i out = _mm256_add_epi64(_mm256_or_si256(_mm256_slli_epi64(sum, 23), _mm256_srli_epi64(sum, 41)), *s0);
+    __m256i t = _mm256_slli_epi64(*s1, 17);
+    *s2 = _mm256_xor_si256(*s2, *s0);
+    *s3 = _mm256_xor_si256(*s3, *s1);
+    *s1 = _mm256_xor_si256(*s1, *s2);
+    *s0 = _mm256_xor_si256(*s0, *s3);
+    *s2 = _mm256_xor_si256(*s2, t);
+    *s3 = _mm256_or_si256(_mm256_slli_epi64(*s3, 45), _mm256_srli_epi64(*s3, 19));
+    return out;
+}
+
+__attribute__((target("avx2")))
+static inline __m256i _rng_avx2_to_double(__m256i x) {
+    __m256d d = _mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(x, 12), _mm256_set1_epi64x(0x3FF0000000000000LL)));
+    return _mm256_castpd_si256(_mm256_sub_pd(d, _mm256_set1_pd(1.0)));
+}
+
+// Whole rounds, with both halves of the lanes kept in registers; returns the number of values written.
+__attribute__((target("avx2")))
+static inline size_t _rng8_fill_avx2(qol_rng8* g, void* out, size_t n, int as_double) {
+    __m256i a0 = _mm256_loadu_si256((const __m256i*)&g->s[0][0]), b0 = _mm256_loadu_si256((const __m256i*)&g->s[0][4]);
+    __m256i a1 = _mm256_loadu_si256((const __m256i*)&g->s[1][0]), b1 = _mm256_loadu_si256((const __m256i*)&g->s[1][4]);
+    __m256i a2 = _mm256_loadu_si256((const __m256i*)&g->s[2][0]), b2 = _mm256_loadu_si256((const __m256i*)&g->s[2][4]);
+    __m256i a3 = _mm256_loadu_si256((const __m256i*)&g->s[3][0]), b3 = _mm256_loadu_si256((const __m256i*)&g->s[3][4]);
+    __m256i* o = (__m256i*)out;
+    size_t i = 0;
+    if (as_double) {
+        for (; i + RNG8_LANES <= n; i += RNG8_LANES, o += 2) {
+            _mm256_storeu_si256(o, _rng_avx2_to_double(_rng_avx2_step(&a0, &a1, &a2, &a3)));
+            _mm256_storeu_si256(o + 1, _rng_avx2_to_double(_rng_avx2_step(&b0, &b1, &b2, &b3)));
+        }
+    } else {
+        for (; i + RNG8_LANES <= n; i += RNG8_LANES, o += 2) {
+            _mm256_storeu_si256(o, _rng_avx2_step(&a0, &a1, &a2, &a3));
+            _mm256_storeu_si256(o + 1, _rng_avx2_step(&b0, &b1, &b2, &b3));
+        }
+    }
+    _mm256_storeu_si256((__m256i*)&g->s[0][0], a0); _mm256_storeu_si256((__m256i*)&g->s[0][4], b0);
+    _mm256_storeu_si256((__m256i*)&g->s[1][0], a1); _mm256_storeu_si256((__m256i*)&g->s[1][4], b1);
+    _mm256_storeu_si256((__m256i*)&g->s[2][0], a2); _mm256_storeu_si256((__m256i*)&g->s[2][4], b2);
+    _mm256_storeu_si256((__m256i*)&g->s[3][0], a3); _mm256_storeu_si256((__m256i*)&g->s[3][4], b3);
+    return i;
+}
 #endif
-    _st_pkt* pkt = (_st_pkt*)p;
-    int i[4] = {0};
-    char s_buf[256] = {0};
 
-    if (pkt->args_str && pkt->args_str[0] == '\"') {
-        sscanf(pkt->args_str, "\"%[^\"]\"", s_buf);
-    } else if (pkt->args_str) {
-        sscanf(pkt->args_str, "%d, %d, %d, %d", &i[0], &i[1], &i[2], &i[3]);
+// Rounds are produced in blocks that stay in L1; within a block each lane
+// (or lane pair) runs all its rounds with the state in registers.
+#define _RNG8_BLOCK 32
+
+static inline void _rng8_block_scalar(qol_rng8* g, void* out, size_t rounds, int as_double) {
+    for (int k = 0; k < RNG8_LANES; k++) {
+        unsigned long long s0 = g->s[0][k], s1 = g->s[1][k], s2 = g->s[2][k], s3 = g->s[3][k];
+        for (size_t r = 0; r < rounds; r++) {
+            unsigned long long v = _rng_rotl(s0 + s3, 23) + s0, t = s1 << 17;
+            s2 ^= s0; s3 ^= s1; s1 ^= s2; s0 ^= s3;
+            s2 ^= t;
+            s3 = _rng_rotl(s3, 45);
+            if (as_double) ((double*)out)[r * RNG8_LANES + k] = _rng_bits_to_double(v);
+            else ((unsigned long long*)out)[r * RNG8_LANES + k] = v;
+        }
+        g->s[0][k] = s0; g->s[1][k] = s1; g->s[2][k] = s2; g->s[3][k] = s3;
     }
+}
 
-    if (pkt->type == 1) {
-        int r = 0;
-        if (pkt->arg_count == 0) r = ((int (*)())pkt->user_fn)();
-        else if (pkt->arg_count == 1) r = ((int (*)(int))pkt->user_fn)(i[0]);
-        else r = ((int (*)(int, int))pkt->user_fn)(i[0], i[1]);
-        int* b = malloc(sizeof(int)); *b = r; _st_results[pkt->id] = b;
-    } else {
-        void* r = NULL;
-        if (pkt->arg_count == 0) r = ((void* (*)())pkt->user_fn)();
-        else if (pkt->args_str && pkt->args_str[0] == '\"') r = ((void* (*)(char*))pkt->user_fn)(s_buf);
-        else if (pkt->arg_count == 1) r = ((void* (*)(int))pkt->user_fn)(i[0]);
-        else r = ((void* (*)(int, int))pkt->user_fn)(i[0], i[1]);
-        _st_results[pkt->id] = r;
+#ifdef _TOOLS_SSE2
+static inline void _rng8_block_sse2(qol_rng8* g, void* out, size_t rounds, int as_double) {
+    const __m128i one_exp = _mm_set1_epi64x(0x3FF0000000000000LL);
+    const __m128d one = _mm_set1_pd(1.0);
+    for (int k = 0; k < RNG8_LANES; k += 2) {
+        __m128i s0 = _mm_loadu_si128((const __m128i*)&g->s[0][k]), s1 = _mm_loadu_si128((const __m128i*)&g->s[1][k]);
+        __m128i s2 = _mm_loadu_si128((const __m128i*)&g->s[2][k]), s3 = _mm_loadu_si128((const __m128i*)&g->s[3][k]);
+        for (size_t r = 0; r < rounds; r++) {
+            __m128i sum = _mm_add_epi64(s0, s3);
+            __m128i v = _mm_add_epi64(_mm_or_si128(_mm_slli_epi64(sum, 23), _mm_srli_epi64(sum, 41)), s0);
+            __m128i t = _mm_slli_epi64(s1, 17);
+            s2 = _mm_xor_si128(s2, s0); s3 = _mm_xor_si128(s3, s1);
+            s1 = _mm_xor_si128(s1, s2); s0 = _mm_xor_si128(s0, s3);
+            s2 = _mm_xor_si128(s2, t);
+            s3 = _mm_or_si128(_mm_slli_epi64(s3, 45), _mm_srli_epi64(s3, 19));
+            if (as_double) v = _mm_castpd_si128(_mm_sub_pd(_mm_castsi128_pd(_mm_or_si128(_mm_srli_epi64(v, 12), one_exp)), one));
+            _mm_storeu_si128((__m128i*)((unsigned long long*)out + r * RNG8_LANES + k), v);
+        }
+        _mm_storeu_si128((__m128i*)&g->s[0][k], s0); _mm_storeu_si128((__m128i*)&g->s[1][k], s1);
+        _mm_storeu_si128((__m128i*)&g->s[2][k], s2); _mm_storeu_si128((__m128i*)&g->s[3][k], s3);
     }
-    free(pkt->args_str); free(pkt); return 0;
 }
+#endif
 
-static inline void _st_spawn(void* fn, char* args, int id, int type, int count) {
-    if (id < 0 || id >= MAX_THREADS) return;
-    _st_pkt* p = malloc(sizeof(_st_pkt));
-    p->user_fn = fn; p->args_str = _st_strdup(args);
-    p->id = id; p->type = type; p->arg_count = count;
-#ifdef _WIN32
-    _st_pool[id] = CreateThread(NULL, 0, _st_entry, p, 0, NULL);
-#else
-    pthread_create(&_st_pool[id], NULL, _st_entry, p);
+static inline void _rng8_fill(qol_rng8* g, void* out, size_t n, int as_double) {
+    unsigned long long v[RNG8_LANES];
+    size_t i = 0;
+    int level = tools_simd_level();
+#ifdef _TOOLS_X86_SIMD
+    if (level >= 2) i = _rng8_fill_avx2(g, out, n, as_double);
 #endif
+    while (n - i >= RNG8_LANES) {
+        size_t rounds = (n - i) / RNG8_LANES;
+        if (rounds > _RNG8_BLOCK) rounds = _RNG8_BLOCK;
+        void* dst = (unsigned long long*)out + i;
+#ifdef _TOOLS_SSE2
+        if (level >= 1) _rng8_block_sse2(g, dst, rounds, as_double);
+        else
+#endif
+        _rng8_block_scalar(g, dst, rounds, as_double);
+        i += rounds * RNG8_LANES;
+    }
+    (void)level;
+    if (i < n) {
+        _rng8_round(g, v);
+        for (int k = 0; i < n; k++, i++) {
+            if (as_double) ((double*)out)[i] = _rng_bits_to_double(v[k]);
+            else ((unsigned long long*)out)[i] = v[k];
+        }
+    }
 }
 
-#define spawnthread(fn, args, id) { \
-    int cnt = 0; \
-    if (strlen(args) > 0) { cnt = 1; for(int _j=0; args[_j]; _j++) if(args[_j]==',') cnt++; } \
-    _st_spawn(fn, args, id, _Generic((fn), \
-        int (*)(): 1, int (*)(int): 1, int (*)(int,int): 1, \
-        int (*)(int,int,int): 1, int (*)(int,int,int,int): 1, \
-        default: 0), cnt); \
+static inline void rng8_fill_u64(qol_rng8* g, unsigned long long* out, size_t n) { _rng8_fill(g, out, n, 0); }
+
+// [0, 1) with 52 random bits per value.
+static inline void rng8_fill_double(qol_rng8* g, double* out, size_t n) { _rng8_fill(g, out, n, 1); }
+
+// Any number of random bytes.
+static inline void rng8_fill_bytes(qol_rng8* g, void* out, size_t n) {
+    unsigned long long tail;
+    size_t words = n / 8;
+    if (words) {
+        if (((size_t)out & 7) == 0) rng8_fill_u64(g, (unsigned long long*)out, words);
+        else {
+            unsigned long long buf[64];
+            for (size_t done = 0; done < words; ) {
+                size_t k = words - done < 64 ? words - done : 64;
+                rng8_fill_u64(g, buf, k);
+                memcpy((char*)out + 8 * done, buf, 8 * k);
+                done += k;
+            }
+        }
+    }
+    if (n % 8) {
+        rng8_fill_u64(g, &tail, 1);
+        memcpy((char*)out + 8 * words, &tail, n % 8);
+    }
 }
 
-static inline int isrunning(int id) {
-    if (id < 0 || id >= MAX_THREADS || !_st_pool[id]) return 0;
-#ifdef _WIN32
-    return WaitForSingleObject(_st_pool[id], 0) == WAIT_TIMEOUT;
-#else
-    return pthread_kill(_st_pool[id], 0) == 0;
+/* --- JSON Writer --- */
+
+#ifndef JW_MAX_DEPTH
+#define JW_MAX_DEPTH 32
 #endif
+
+// Streaming JSON writer. Output goes to a caller buffer (jw_init, no allocation)
+// or to a qol_sb (jw_init_sb). Commas and nesting are tracked for you.
+typedef struct {
+    char* buf; size_t cap;  // caller buffer, unused with sb
+    qol_sb* sb;
+    size_t len;             // bytes produced, counted even past cap
+    int depth, error, overflow, after_key;
+    unsigned char level[JW_MAX_DEPTH + 1]; // per depth: 1 = has items, 2 = object
+} qol_jw;
+
+static inline void jw_init(qol_jw* jw, char* buf, size_t cap) {
+    memset(jw, 0, sizeof(*jw));
+    jw->buf = buf; jw->cap = cap;
 }
 
-static inline void* getreturn(int id) {
-    if (id < 0 || id >= MAX_THREADS || !_st_pool[id]) return NULL;
-#ifdef _WIN32
-    WaitForSingleObject(_st_pool[id], INFINITE); CloseHandle(_st_pool[id]);
-#else
-    pthread_join(_st_pool[id], NULL);
-#endif
-    _st_pool[id] = 0; return _st_results[id];
+static inline void jw_init_sb(qol_jw* jw, qol_sb* sb) {
+    memset(jw, 0, sizeof(*jw));
+    jw->sb = sb;
 }
 
-static inline void secondsleep(float s) { 
-#ifdef _WIN32
-    Sleep((int)(s * 1000));
-#else
-    usleep((int)(s * 1000000));
-#endif
+// Buffer mode stops writing at the first chunk that does not fit but keeps
+// counting, so jw_finish can report the size that was needed.
+static inline void _jw_put(qol_jw* jw, const char* s, size_t n) {
+    if (jw->sb) { if (!sb_append_n(jw->sb, s, n)) jw->error = 1; return; }
+    if (!jw->overflow && jw->len + n < jw->cap) memcpy(jw->buf + jw->len, s, n);
+    else jw->overflow = 1;
+    jw->len += n;
 }
 
-static inline void killthread(int id) {
-    if (id >= 0 && id < MAX_THREADS && _st_pool[id]) {
-#ifdef _WIN32
-        TerminateThread(_st_pool[id], 0); CloseHandle(_st_pool[id]);
-#else
-        pthread_cancel(_st_pool[id]);
+// Index of the first byte in s[0..n) that JSON needs escaped: '"', '\' or < 0x20.
+static inline size_t _jw_clean_prefix(const char* s, size_t n) {
+    size_t i = 0;
+#ifdef _TOOLS_SSE2
+    const __m128i quote = _mm_set1_epi8('"'), bslash = _mm_set1_epi8('\\'), ctl = _mm_set1_epi8(0x1F);
+    for (; i + 16 <= n; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(s + i));
+        __m128i bad = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, quote), _mm_cmpeq_epi8(x, bslash)),
+                                   _mm_cmpeq_epi8(_mm_min_epu8(x, ctl), x));
+        unsigned mask = (unsigned)_mm_movemask_epi8(bad);
+        if (mask) return i + (size_t)__builtin_ctz(mask);
+    }
 #endif
-        _st_pool[id] = 0;
+    for (; i < n; i++) {
+        unsigned char c = (unsigned char)s[i];
+        if (c < 0x20 || c == '"' || c == '\\') break;
     }
+    return i;
 }
 
-static inline void bombthreads() { for(int i=0; i<MAX_THREADS; i++) killthread(i); }
+// Writes s as a quoted JSON string. Clean runs are copied whole; UTF-8 passes through.
+static inline void _jw_put_str(qol_jw* jw, const char* s, size_t n) {
+    static const char hex[] = "0123456789abcdef";
+    _jw_put(jw, "\"", 1);
+    while (n) {
+        size_t run = _jw_clean_prefix(s, n);
+        if (run) _jw_put(jw, s, run);
+        if (run == n) break;
+        unsigned char c = (unsigned char)s[run];
+        char esc[6] = { '\\', (char)c, 0, 0, 0, 0 };
+        size_t elen = 2;
+        switch (c) {
+            case '"': case '\\': break;
+            case '\b': esc[1] = 'b'; break;
+            case '\f': esc[1] = 'f'; break;
+            case '\n': esc[1] = 'n'; break;
+            case '\r': esc[1] = 'r'; break;
+            case '\t': esc[1] = 't'; break;
+            default:
+                esc[1] = 'u'; esc[2] = '0'; esc[3] = '0';
+                esc[4] = hex[c >> 4]; esc[5] = hex[c & 15]; elen = 6;
+        }
+        _jw_put(jw, esc, elen);
+        s += run + 1; n -= run + 1;
+    }
+    _jw_put(jw, "\"", 1);
+}
 
-#endif
+// Comma and key bookkeeping before any value; is_key marks a jw_key call.
+static inline void _jw_sep(qol_jw* jw, int is_key) {
+    unsigned char* lv = &jw->level[jw->depth];
+    int in_obj = (*lv & 2) != 0;
+    if (jw->after_key) {
+        if (is_key) jw->error = 1;
+        jw->after_key = 0;
+        return;
+    }
+    if (in_obj != is_key) jw->error = 1;
+    if (*lv & 1) _jw_put(jw, ",", 1);
+    *lv |= 1;
+}
 
+static inline void _jw_open(qol_jw* jw, char c, unsigned char kind) {
+    _jw_sep(jw, 0);
+    if (jw->depth >= JW_MAX_DEPTH) { jw->error = 1; return; }
+    jw->level[++jw->depth] = kind;
+    _jw_put(jw, &c, 1);
+}
 
-/* Source: SimpleTools/simple_tools.h */
-#ifndef SIMPLE_TOOLS_H
+static inline void _jw_close(qol_jw* jw, char c, unsigned char kind) {
+    if (jw->depth == 0 || (jw->level[jw->depth] & 2) != kind || jw->after_key) { jw->error = 1; return; }
+    jw->depth--;
+    _jw_put(jw, &c, 1);
+}
 
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <stdarg.h>
-#include <ctype.h>
-#include <time.h>
+static inline void jw_begin_obj(qol_jw* jw) { _jw_open(jw, '{', 2); }
+static inline void jw_end_obj(qol_jw* jw)   { _jw_close(jw, '}', 2); }
+static inline void jw_begin_arr(qol_jw* jw) { _jw_open(jw, '[', 0); }
+static inline void jw_end_arr(qol_jw* jw)   { _jw_close(jw, ']', 0); }
 
-/* --- Cross-Platform Compatibility --- */
+static inline void jw_key_n(qol_jw* jw, const char* k, size_t n) {
+    _jw_sep(jw, 1);
+    _jw_put_str(jw, k, n);
+    _jw_put(jw, ":", 1);
+    jw->after_key = 1;
+}
+static inline void jw_key(qol_jw* jw, const char* k) { jw_key_n(jw, k, strlen(k)); }
 
-#ifdef _WIN32
-    #include <windows.h>
-    #define usleep(us) Sleep((us)/1000)
-    #define sleep(s) Sleep((s)*1000)
-#else
-    #include <unistd.h>
-#endif
+static inline void jw_null(qol_jw* jw) { _jw_sep(jw, 0); _jw_put(jw, "null", 4); }
+static inline void jw_bool(qol_jw* jw, int v) { _jw_sep(jw, 0); _jw_put(jw, v ? "true" : "false", v ? 4 : 5); }
 
-#ifndef MAX_HTTP_BUF
-#endif
+static inline void jw_str_n(qol_jw* jw, const char* s, size_t n) { _jw_sep(jw, 0); _jw_put_str(jw, s, n); }
+static inline void jw_str(qol_jw* jw, const char* s) { if (s) jw_str_n(jw, s, strlen(s)); else jw_null(jw); }
+
+static inline void jw_uint(qol_jw* jw, unsigned long long v) {
+    char tmp[FMT_INT_MAX];
+    size_t n = fmt_u64(tmp, v);
+    _jw_sep(jw, 0);
+    _jw_put(jw, tmp, n);
+}
 
-/* --- Internal String Engine --- */
+static inline void jw_int(qol_jw* jw, long long v) {
+    char tmp[FMT_INT_MAX];
+    size_t n = fmt_i64(tmp, v);
+    _jw_sep(jw, 0);
+    _jw_put(jw, tmp, n);
+}
 
-static inline void hexdmp(void* ptr, int buflen) {
-    unsigned char* buf = (unsigned char*)ptr;
-    for (int i = 0; i < buflen; i++) {
-        // Print the hex value of the byte
-        printf("%02x ", buf[i]);
+// NaN and infinities have no JSON form and are written as null.
+static inline void jw_double(qol_jw* jw, double v) {
+    if (v != v || v - v != 0) { jw_null(jw); return; }
+    char tmp[FMT_DOUBLE_MAX];
+    size_t n = fmt_double(tmp, v);
+    _jw_sep(jw, 0);
+    _jw_put(jw, tmp, n);
+}
 
-        // Every 16 bytes, start a new line for readability
-        if ((i + 1) % 16 == 0) printf("\n");
+// Inserts already-encoded JSON as one value.
+static inline void jw_raw(qol_jw* jw, const char* json) { _jw_sep(jw, 0); _jw_put(jw, json, strlen(json)); }
+
+// NUL-terminates and returns the document length. In buffer mode a result
+// >= cap means the buffer was too small (nothing past the last whole chunk
+// was written). Returns 0 on misuse (unbalanced, value without key) or
+// allocation failure.
+static inline size_t jw_finish(qol_jw* jw) {
+    if (jw->error || jw->depth || jw->after_key) return 0;
+    if (jw->sb) {
+        if (!sb_reserve(jw->sb, 0)) return 0;
+        jw->sb->data[jw->sb->len] = '\0';
+        return jw->sb->len;
     }
-    printf("\n");
+    if (!jw->overflow && jw->len < jw->cap) jw->buf[jw->len] = '\0';
+    else if (jw->cap) jw->buf[0] = '\0';
+    return jw->len;
 }
 
-static inline char* _str_replace_logic(const char* src, const char* find, const char* replace, int start_idx, int end_idx) {
-    if (!src || !find || !replace) return NULL;
-    size_t find_len = strlen(find);
-    size_t replace_len = strlen(replace);
-    size_t src_len = strlen(src);
-    char* result = (char*)malloc(src_len * 10 + 1); 
-    char* p_res = result;
-    const char* p_src = src;
-    int current_occurrence = 0;
-
-    while (*p_src) {
-        const char* pos = strstr(p_src, find);
-        if (pos) {
-            current_occurrence++;
-            int should_replace = (current_occurrence >= start_idx && current_occurrence <= end_idx);
-            size_t prefix_len = pos - p_src;
-            memcpy(p_res, p_src, prefix_len);
-            p_res += prefix_len;
-            if (should_replace) {
-                memcpy(p_res, replace, replace_len);
-                p_res += replace_len;
-            } else {
-                memcpy(p_res, find, find_len);
-                p_res += find_len;
-            }
-            p_src = pos + find_len;
-        } else {
-            strcpy(p_res, p_src);
-            break;
+/* --- JSON Builder --- */
+
+// Keeps its original output shape ("k":v pairs joined by ", ", floats as %.2f)
+// but escapes string values and walks fmt in place instead of strtok'ing a copy.
+static inline char* json_obj(const char* fmt, ...) {
+    qol_sb sb = {0};
+    qol_jw jw;
+    jw_init_sb(&jw, &sb);
+    sb_reserve(&sb, 2 * strlen(fmt) + 64);
+    sb_appendc(&sb, '{');
+    va_list args; va_start(args, fmt);
+    const char* p = fmt;
+    int first = 1;
+    for (;;) {
+        while (*p == ',' || *p == ' ') p++;
+        if (!*p) break;
+        const char* tok = p;
+        while (*p && *p != ',' && *p != ' ') p++;
+        const char* key = (const char*)memchr(tok, ':', (size_t)(p - tok));
+        if (!first) sb_append_n(&sb, ", ", 2);
+        first = 0;
+        if (!key) continue;
+        key++;
+        _jw_put_str(&jw, key, (size_t)(p - key));
+        sb_appendc(&sb, ':');
+        if (tok[0] == 's') {
+            const char* val = va_arg(args, const char*);
+            if (val) _jw_put_str(&jw, val, strlen(val)); else sb_append_n(&sb, "null", 4);
+        } else if (tok[0] == 'i') {
+            sb_append_i64(&sb, va_arg(args, int));
+        } else if (tok[0] == 'f') {
+            sb_appendf(&sb, "%.2f", va_arg(args, double));
+        } else if (tok[0] == 'b') {
+            sb_append(&sb, va_arg(args, int) ? "true" : "false");
         }
     }
-    return result;
+    sb_appendc(&sb, '}');
+    va_end(args);
+    return sb.data;
 }
 
-/* --- String Replacement API --- */
+/* --- Async Logger --- */
+
+// Each thread that logs gets its own single-producer ring, so a call takes no
+// lock and never touches the output: it checks the level, then copies a
+// timestamp, the call site and the raw arguments into the ring. A writer thread
+// formats the records, merges the rings in time order and hands the text to
+// write() in large batches.
+//
+// Formats must be string literals. Each call site parses its conversions once
+// and caches them; %s arguments are copied (up to QLOG_MAX_STR bytes), never
+// kept by pointer. A format the cache cannot describe (%n, %ls, more than
+// QLOG_MAX_ARGS arguments) is formatted on the calling thread instead.
+
+#define QLOG_TRACE 1
+#define QLOG_DEBUG 2
+#define QLOG_INFO  3
+#define QLOG_WARN  4
+#define QLOG_ERROR 5
+#define QLOG_FATAL 6
+#define QLOG_OFF   7
+
+// Calls below this level compile to nothing; their arguments are not evaluated.
+#ifndef QLOG_MIN_LEVEL
+#define QLOG_MIN_LEVEL QLOG_TRACE
+#endif
 
-static inline char* str_replace_first(const char* s, const char* f, const char* r) { return _str_replace_logic(s, f, r, 1, 1); }
-static inline char* str_replace_all(const char* s, const char* f, const char* r)   { return _str_replace_logic(s, f, r, 1, 999999); }
-static inline char* str_replace_nth(const char* s, const char* f, const char* r, int n) { return _str_replace_logic(s, f, r, n, n); }
-static inline char* str_replace_count(const char* s, const char* f, const char* r, int c) { return _str_replace_logic(s, f, r, 1, c); }
-static inline char* str_replace_range(const char* s, const char* f, const char* r, int s_idx, int e_idx) { return _str_replace_logic(s, f, r, s_idx, e_idx); }
+#ifndef QLOG_RING
+#define QLOG_RING (64 * 1024)  // bytes per thread, a power of two
+#endif
+#ifndef QLOG_BATCH
+#define QLOG_BATCH (64 * 1024) // formatted bytes per write() call
+#endif
+#ifndef QLOG_IDLE_US
+#define QLOG_IDLE_US 1000      // writer sleep while every ring is empty
+#endif
+#define QLOG_MAX_ARGS 16
+#define QLOG_MAX_STR 1024
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    #define _tools_load_int(p)      InterlockedCompareExchange((volatile long*)(p), 0, 0)
+    #define _tools_store_int(p, v)  InterlockedExchange((volatile long*)(p), (long)(v))
+    #define _tools_add_int(p, v)    (InterlockedExchangeAdd((volatile long*)(p), (long)(v)) + (v))
+    #define _tools_cas_int(p, e, v) (InterlockedCompareExchange((volatile long*)(p), (long)(v), (long)(e)) == (long)(e))
+    #define _tools_load_u64(p)      ((unsigned long long)InterlockedCompareExchange64((volatile long long*)(p), 0, 0))
+    #define _tools_store_u64(p, v)  InterlockedExchange64((volatile long long*)(p), (long long)(v))
+    #define _tools_add_u64(p, v)    ((unsigned long long)InterlockedExchangeAdd64((volatile long long*)(p), (long long)(v)) + (v))
+#else
+    #define _tools_load_int(p)      __atomic_load_n(p, __ATOMIC_ACQUIRE)
+    #define _tools_store_int(p, v)  __atomic_store_n(p, v, __ATOMIC_RELEASE)
+    #define _tools_add_int(p, v)    __atomic_add_fetch(p, v, __ATOMIC_ACQ_REL)
+    #define _tools_cas_int(p, e, v) __extension__ ({ int _e = (e); __atomic_compare_exchange_n(p, &_e, v, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE); })
+    #define _tools_load_u64(p)      __atomic_load_n(p, __ATOMIC_ACQUIRE)
+    #define _tools_store_u64(p, v)  __atomic_store_n(p, v, __ATOMIC_RELEASE)
+    #define _tools_add_u64(p, v)    __atomic_add_fetch(p, v, __ATOMIC_ACQ_REL)
+#endif
 
-/* --- String Search & Logic --- */
+// One step of a compiled format: lit bytes of text, then a conversion of len
+// bytes. kind: d/u/s/c written directly, f through snprintf, % a literal '%'.
+typedef struct { unsigned short lit, len; char kind, stars; } _qlog_op;
 
-static inline int str_starts(const char* s, const char* prefix) {
-    if (!s || !prefix) return 0;
-    return strncmp(s, prefix, strlen(prefix)) == 0;
-}
+// One per call site (a static inside QLOG). state: 0 new, 1 being parsed,
+// 2 compiled, 3 formatted by the caller.
+typedef struct {
+    const char* fmt;
+    int level, state, n_args, n_ops, tail;
+    char types[QLOG_MAX_ARGS]; // how each argument is read, see _qlog_type
+    short prec[QLOG_MAX_ARGS]; // %s: byte limit, -1 none, -2 from the preceding '*'
+    _qlog_op ops[QLOG_MAX_ARGS];
+} qol_log_site;
+
+// Written by its thread (head), read by the writer (tail). Freed when both the
+// thread and the logger have let go of it (refs).
+typedef struct _qlog_ring {
+    unsigned long long head, tail_seen, dropped;
+    struct _qlog_ring* thread_next; // the owning thread's list
+    const void* log;
+    char _gap[64];                  // keeps the writer's fields off the producer's cache line
+    unsigned long long tail, end, reported;
+    struct _qlog_ring* next;        // the logger's list
+    int orphaned, detached, refs;
+} _qlog_ring;
+#define _QLOG_DATA(r) ((unsigned char*)(void*)((r) + 1))
+
+// A record: this header, one 8-byte slot per argument (a %s slot holds the
+// length), then the string bytes, each NUL-terminated and padded to 8.
+typedef struct { unsigned size; const qol_log_site* site; unsigned long long stamp; } _qlog_rec;
+#define _QLOG_REC_SIZE ((sizeof(_qlog_rec) + 7) & ~(size_t)7)
+#define _QLOG_WRAP 0xFFFFFFFFu // in place of a size: the rest of the ring is unused
 
-static inline int str_ends(const char* s, const char* suffix) {
-    if (!s || !suffix) return 0;
-    size_t slen = strlen(s);
-    size_t flen = strlen(suffix);
-    return slen >= flen && strcmp(s + slen - flen, suffix) == 0;
-}
+typedef struct {
+    int level;              // runtime threshold, read by every call
+    int block;              // 1 (default): a full ring makes the caller wait; 0: drop and count
+    int running, fd;
+    _tools_mutex lock;      // guards the ring list
+    _qlog_ring* rings;
+    unsigned long long flush_req, flush_done, dropped;
+    unsigned long long cyc0, mono0, cyc_at, real_at; // writer: time_cycles() to wall clock
+    double ns_per_cyc;
+    qol_sb out;             // writer only
+    time_t tsec;
+    char ttext[TIME_NOW_LEN];
+#ifdef _WIN32
+    HANDLE thread;
+#else
+    pthread_t thread;
+#endif
+} qol_log;
 
-static inline int str_contains(const char* s, const char* find) {
-    return (s && find) ? strstr(s, find) != NULL : 0;
+static inline void _qlog_yield() {
+#ifdef _WIN32
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
 }
 
-static inline int str_is_numeric(const char* s) {
-    if (!s || *s == '\0') return 0;
-    while (*s) { if (!isdigit(*s)) return 0; s++; }
-    return 1;
+static inline void _qlog_sleep_us(unsigned us) {
+#if defined(_WIN32)
+    Sleep(us / 1000 ? us / 1000 : 1);
+#elif defined(_TOOLS_POSIX_TIME)
+    struct timespec ts = { (time_t)(us / 1000000), (long)(us % 1000000) * 1000 };
+    nanosleep(&ts, NULL);
+#else
+    (void)us; _qlog_yield();
+#endif
 }
 
-/* --- String Formatting & Case --- */
-
-static inline void str_lower(char* s) { for(; *s; ++s) *s = tolower(*s); }
-static inline void str_upper(char* s) { for(; *s; ++s) *s = toupper(*s); }
+// Wall-clock nanoseconds since 1970.
+static inline unsigned long long _qlog_clock_ns() {
+#ifdef _WIN32
+    FILETIME ft;
+    GetSystemTimePreciseAsFileTime(&ft);
+    return (((unsigned long long)ft.dwHighDateTime << 32 | ft.dwLowDateTime) - 116444736000000000ULL) * 100;
+#elif defined(_TOOLS_POSIX_TIME)
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+#else
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+#endif
+}
 
-static inline char* str_trim(char* s) {
-    char* end;
-    while(isspace((unsigned char)*s)) s++;
-    if(*s == 0) return s;
-    end = s + strlen(s) - 1;
-    while(end > s && isspace((unsigned char)*end)) end--;
-    end[1] = '\0';
-    return s;
+typedef struct { int stars, star_prec, prec, plain; char len, conv; } _qlog_spec;
+
+// Reads one conversion after its '%'; returns the character after it.
+static inline const char* _qlog_parse_spec(const char* f, _qlog_spec* sp) {
+    int decor = 0;
+    sp->stars = sp->star_prec = 0; sp->prec = -1; sp->len = 0;
+    while (*f == '-' || *f == '+' || *f == ' ' || *f == '#' || *f == '0' || *f == '\'') { f++; decor = 1; }
+    if (*f == '*') { sp->stars++; f++; decor = 1; }
+    else while (*f >= '0' && *f <= '9') { f++; decor = 1; }
+    if (*f == '.') {
+        f++; decor = 1;
+        if (*f == '*') { sp->stars++; sp->star_prec = 1; f++; }
+        else for (sp->prec = 0; *f >= '0' && *f <= '9'; f++) sp->prec = sp->prec < 100000 ? sp->prec * 10 + (*f - '0') : sp->prec;
+    }
+    if (*f == 'h') { f++; sp->len = 'h'; if (*f == 'h') { f++; sp->len = 'H'; } }
+    else if (*f == 'l') { f++; sp->len = 'l'; if (*f == 'l') { f++; sp->len = 'q'; } }
+    else if (*f == 'z' || *f == 't' || *f == 'j' || *f == 'L') sp->len = *f++;
+    sp->conv = *f;
+    if (*f) f++;
+    sp->plain = !decor && sp->len != 'h' && sp->len != 'H';
+    return f;
 }
 
-static inline char* str_format(const char* fmt, ...) {
-    char* res = (char*)malloc(MAX_HTTP_BUF);
-    va_list args; va_start(args, fmt);
-    vsprintf(res, fmt, args);
-    va_end(args);
-    return res;
+// Argument type codes: i/I int/unsigned, l/L long, q/Q long long, z size_t,
+// t ptrdiff_t, j/J intmax_t, d double, D long double, p pointer, s string.
+// 0 means the cache cannot handle the conversion.
+static inline char _qlog_type(char len, char conv) {
+    switch (conv) {
+    case 'd': case 'i':
+        return len == 'l' ? 'l' : len == 'q' ? 'q' : len == 'z' ? 'z' : len == 't' ? 't' : len == 'j' ? 'j' : len == 'L' ? 0 : 'i';
+    case 'u': case 'o': case 'x': case 'X':
+        return len == 'l' ? 'L' : len == 'q' ? 'Q' : len == 'z' ? 'z' : len == 't' ? 't' : len == 'j' ? 'J' : len == 'L' ? 0 : 'I';
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+        return len == 'L' ? 'D' : len == 0 || len == 'l' ? 'd' : 0;
+    case 'c': return len ? 0 : 'i';
+    case 's': return len ? 0 : 's';
+    case 'p': return len ? 0 : 'p';
+    }
+    return 0;
 }
 
-static inline char* str_url_decode(const char* src) {
-    if (!src) return NULL;
-    char *res = (char*)malloc(strlen(src) + 1);
-    char *p = res;
-    while (*src) {
-        if (*src == '%' && isxdigit(src[1]) && isxdigit(src[2])) {
-            char hex[3] = { src[1], src[2], 0 };
-            *p++ = (char)strtol(hex, NULL, 16);
-            src += 3;
-        } else if (*src == '+') {
-            *p++ = ' '; src++;
-        } else {
-            *p++ = *src++;
+// Compiles the format once, so the writer never scans it again.
+_TOOLS_COLD static void _qlog_parse(qol_log_site* s) {
+    if (!_tools_cas_int(&s->state, 0, 1)) {
+        while (_tools_load_int(&s->state) == 1) _qlog_yield();
+        return;
+    }
+    const char *f = s->fmt, *last = f;
+    int n = 0, ops = 0, state = 2;
+    while ((f = strchr(f, '%')) != NULL) {
+        _qlog_op* op = &s->ops[ops];
+        const char* spec = f;
+        if (ops == QLOG_MAX_ARGS || spec - last > 0xFFFF) { state = 3; break; }
+        op->lit = (unsigned short)(spec - last);
+        op->stars = 0;
+        if (f[1] == '%') { op->kind = '%'; f += 2; }
+        else {
+            _qlog_spec sp;
+            f = _qlog_parse_spec(f + 1, &sp);
+            char t = _qlog_type(sp.len, sp.conv);
+            if (!t || n + sp.stars + 1 > QLOG_MAX_ARGS || f - spec > 31) { state = 3; break; }
+            for (int k = 0; k < sp.stars; k++) { s->types[n] = 'i'; s->prec[n++] = -1; }
+            s->prec[n] = (short)(t != 's' ? -1 : sp.star_prec ? -2 : sp.prec > QLOG_MAX_STR ? QLOG_MAX_STR : sp.prec);
+            s->types[n++] = t;
+            op->stars = (char)sp.stars;
+            op->kind = !sp.plain ? 'f' : t == 's' ? 's' : sp.conv == 'd' || sp.conv == 'i' ? 'd' : sp.conv == 'u' ? 'u' : sp.conv == 'c' ? 'c' : 'f';
         }
+        op->len = (unsigned short)(f - spec);
+        ops++;
+        last = f;
     }
-    *p = '\0';
-    return res;
+    s->n_ops = ops;
+    s->tail = (int)strlen(last);
+    s->n_args = state == 2 ? n : 1;
+    _tools_store_int(&s->state, state);
 }
 
-/* --- Time Tools --- */
-
-static inline char* time_now() {
-    static char buf[32];
-    time_t now = time(NULL);
-    struct tm *t = localtime(&now);
-    strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", t);
-    return buf;
+static inline void _qlog_release(_qlog_ring* r) {
+    if (_tools_add_int(&r->refs, -1) == 0) free(r);
 }
 
-static inline long time_unix() { return (long)time(NULL); }
-
-/* --- JSON Builder --- */
+// This thread's rings, most recently used first.
+static _TOOLS_TLS _qlog_ring* _qlog_mine;
 
-static inline char* json_obj(const char* fmt, ...) {
-    char* res = (char*)malloc(8192);
-    strcpy(res, "{");
-    va_list args; va_start(args, fmt);
-    char* fmt_copy = strdup(fmt);
-    char* token = strtok(fmt_copy, ", ");
-    while (token) {
-        char type = token[0];
-        char* key = strchr(token, ':');
-        if (key) {
-            key++; strcat(res, "\""); strcat(res, key); strcat(res, "\":");
-            if (type == 's') {
-                char* val = va_arg(args, char*);
-                strcat(res, "\""); strcat(res, val); strcat(res, "\"");
-            } else if (type == 'i') {
-                sprintf(res + strlen(res), "%d", va_arg(args, int));
-            } else if (type == 'f') {
-                sprintf(res + strlen(res), "%.2f", va_arg(args, double));
-            } else if (type == 'b') {
-                strcat(res, va_arg(args, int) ? "true" : "false");
-            }
-        }
-        token = strtok(NULL, ", ");
-        if (token) strcat(res, ", ");
+// Thread exit: the writer frees each ring once it has drained it.
+static inline void _qlog_thread_exit(void* head) {
+    _qlog_ring* next;
+    for (_qlog_ring* r = (_qlog_ring*)head; r; r = next) {
+        next = r->thread_next;
+        _tools_store_int(&r->orphaned, 1);
+        _qlog_release(r);
     }
-    strcat(res, "}");
-    free(fmt_copy); va_end(args);
-    return res;
 }
 
+#ifdef _WIN32
+static DWORD _qlog_key = FLS_OUT_OF_INDEXES;
+static INIT_ONCE _qlog_once = INIT_ONCE_STATIC_INIT;
+static inline VOID WINAPI _qlog_fls_exit(PVOID head) { if (head) _qlog_thread_exit(head); }
+static inline BOOL CALLBACK _qlog_key_init(PINIT_ONCE o, PVOID a, PVOID* c) {
+    (void)o; (void)a; (void)c;
+    _qlog_key = FlsAlloc(_qlog_fls_exit);
+    return TRUE;
+}
+static inline void _qlog_set_mine(_qlog_ring* head) {
+    InitOnceExecuteOnce(&_qlog_once, _qlog_key_init, NULL, NULL);
+    _qlog_mine = head;
+    FlsSetValue(_qlog_key, head);
+}
+#else
+static pthread_key_t _qlog_key;
+static pthread_once_t _qlog_once = PTHREAD_ONCE_INIT;
+static inline void _qlog_key_init() { pthread_key_create(&_qlog_key, _qlog_thread_exit); }
+static inline void _qlog_set_mine(_qlog_ring* head) {
+    pthread_once(&_qlog_once, _qlog_key_init);
+    _qlog_mine = head;
+    pthread_setspecific(_qlog_key, head);
+}
 #endif
 
+// First call of a thread on lg: drops rings of stopped loggers and registers a new one.
+_TOOLS_COLD static _qlog_ring* _qlog_ring_slow(qol_log* lg) {
+    _qlog_ring *head = _qlog_mine, **pp = &head, *found = NULL;
+    while (*pp) {
+        _qlog_ring* r = *pp;
+        if (_tools_load_int(&r->detached)) { *pp = r->thread_next; _qlog_release(r); continue; }
+        if (r->log == lg && !found) { found = r; *pp = r->thread_next; continue; }
+        pp = &r->thread_next;
+    }
+    // Rings stay on the C heap: they outlive the calling thread's allocator scope
+    // and are released by the writer thread.
+    if (!found && (found = (_qlog_ring*)calloc(1, sizeof(_qlog_ring) + QLOG_RING)) != NULL) {
+        int ok;
+        found->log = lg;
+        found->refs = 2;
+        _tools_lock(&lg->lock);
+        ok = lg->running;
+        if (ok) { found->next = lg->rings; lg->rings = found; }
+        _tools_unlock(&lg->lock);
+        if (!ok) { free(found); found = NULL; }
+    }
+    if (found) { found->thread_next = head; head = found; }
+    _qlog_set_mine(head);
+    return found;
+}
 
-/* Source: SimpleTypes/simple_types.h */
-#ifndef SIMPLE_TYPES_H
-
-#include <stdint.h>
-#include <string.h>
-#include <stdio.h>
+static inline _qlog_ring* _qlog_ring_for(qol_log* lg) {
+    _qlog_ring* r = _qlog_mine;
+    if (r && r->log == lg && !_tools_load_int(&r->detached)) return r;
+    return _qlog_ring_slow(lg);
+}
 
-// --- Base Types ---
-typedef uint8_t u8;   typedef uint16_t u16; typedef uint32_t u32; typedef uint64_t u64;
-typedef int8_t s8;    typedef int16_t s16;  typedef int32_t s32;  typedef int64_t s64;
+// The hot path: reads the arguments the site describes and copies them into
+// the ring. Waits (or drops, without blocking) when the ring is full.
+static inline void _qlog_push(qol_log* lg, _qlog_ring* r, const qol_log_site* s, va_list ap) {
+    unsigned long long stamp = time_cycles(), a[QLOG_MAX_ARGS];
+    const char* str[QLOG_MAX_ARGS];
+    char pre[QLOG_MAX_STR + 1];
+    const char* types = s->types;
+    int n = s->n_args;
+    size_t size = _QLOG_REC_SIZE + (size_t)n * 8;
+    if (s->state == 3) {
+        int len = vsnprintf(pre, sizeof(pre), s->fmt, ap);
+        a[0] = len < 0 ? 0 : len > QLOG_MAX_STR ? QLOG_MAX_STR : (unsigned long long)len;
+        str[0] = pre;
+        types = "s";
+        size += (a[0] + 8) & ~7ULL;
+    } else {
+        for (int i = 0; i < n; i++) {
+            switch (types[i]) {
+            case 'i': a[i] = (unsigned long long)(long long)va_arg(ap, int); break;
+            case 'I': a[i] = va_arg(ap, unsigned); break;
+            case 'l': a[i] = (unsigned long long)(long long)va_arg(ap, long); break;
+            case 'L': a[i] = va_arg(ap, unsigned long); break;
+            case 'q': a[i] = (unsigned long long)va_arg(ap, long long); break;
+            case 'Q': a[i] = va_arg(ap, unsigned long long); break;
+            case 'z': a[i] = va_arg(ap, size_t); break;
+            case 't': a[i] = (unsigned long long)(long long)va_arg(ap, ptrdiff_t); break;
+            case 'j': a[i] = (unsigned long long)(long long)va_arg(ap, intmax_t); break;
+            case 'J': a[i] = (unsigned long long)va_arg(ap, uintmax_t); break;
+            case 'p': a[i] = (unsigned long long)(uintptr_t)va_arg(ap, void*); break;
+            case 'd': { double d = va_arg(ap, double); memcpy(&a[i], &d, 8); break; }
+            case 'D': { double d = (double)va_arg(ap, long double); memcpy(&a[i], &d, 8); break; }
+            case 's': {
+                const char* v = va_arg(ap, const char*);
+                size_t cap = QLOG_MAX_STR;
+                if (s->prec[i] >= 0) cap = (size_t)s->prec[i];
+                else if (s->prec[i] == -2 && i > 0 && (int)a[i - 1] >= 0 && (int)a[i - 1] < QLOG_MAX_STR) cap = (size_t)(int)a[i - 1];
+                if (!v) v = "(null)";
+                const char* end = (const char*)memchr(v, 0, cap);
+                a[i] = end ? (unsigned long long)(end - v) : cap;
+                str[i] = v;
+                size += (a[i] + 8) & ~7ULL;
+                break;
+            }
+            }
+        }
+    }
+    if (size > QLOG_RING / 2) { _tools_store_u64(&r->dropped, r->dropped + 1); return; }
+
+    unsigned long long head = r->head;
+    size_t idx = (size_t)(head & (QLOG_RING - 1));
+    size_t need = idx + size > QLOG_RING ? QLOG_RING - idx + size : size;
+    while (QLOG_RING - (head - r->tail_seen) < need) {
+        r->tail_seen = _tools_load_u64(&r->tail);
+        if (QLOG_RING - (head - r->tail_seen) >= need) break;
+        // FATAL lines always wait: the process may be about to die.
+        if ((!_tools_load_int(&lg->block) && s->level < QLOG_FATAL) || _tools_load_int(&r->detached)) {
+            _tools_store_u64(&r->dropped, r->dropped + 1);
+            return;
+        }
+        _qlog_yield();
+    }
 
-// --- Structural Definitions ---
-#define DEF_STRUCTS(BITS, LIMBS) \
-    typedef struct { u32 limbs[LIMBS]; } suint##BITS; \
-    typedef struct { s32 limbs[LIMBS]; } sint##BITS; \
-    typedef struct { suint##BITS mantissa; s32 exponent; } sfloat##BITS;
+    unsigned char* d = _QLOG_DATA(r);
+    if (need != size) { *(unsigned*)(void*)(d + idx) = _QLOG_WRAP; idx = 0; }
+    _qlog_rec* h = (_qlog_rec*)(void*)(d + idx);
+    h->size = (unsigned)size; h->site = s; h->stamp = stamp;
+    unsigned long long* slot = (unsigned long long*)(void*)(d + idx + _QLOG_REC_SIZE);
+    char* out = (char*)(slot + n);
+    for (int i = 0; i < n; i++) {
+        slot[i] = a[i];
+        if (types[i] == 's') {
+            memcpy(out, str[i], (size_t)a[i]);
+            out[a[i]] = '\0';
+            out += (a[i] + 8) & ~7ULL;
+        }
+    }
+    _tools_store_u64(&r->head, head + need);
+}
 
-DEF_STRUCTS(32, 1)    DEF_STRUCTS(64, 2)    DEF_STRUCTS(128, 4)
-DEF_STRUCTS(256, 8)   DEF_STRUCTS(512, 16)  DEF_STRUCTS(1024, 32)
-DEF_STRUCTS(2048, 64) DEF_STRUCTS(4096, 128) DEF_STRUCTS(8192, 256)
-DEF_STRUCTS(12288, 384)
+// Returns once everything logged before the call has been written.
+static inline void qlog_flush(qol_log* lg) {
+    if (!_tools_load_int(&lg->running)) return;
+    unsigned long long req = _tools_add_u64(&lg->flush_req, 1);
+    while (_tools_load_u64(&lg->flush_done) < req && _tools_load_int(&lg->running)) _qlog_yield();
+}
 
-// --- Internal Helpers ---
-static inline void _internal_raw_hex(u32* limbs, int count) {
-    printf("0x");
-    int started = 0;
-    for (int i = count - 1; i >= 0; i--) {
-        if (limbs[i] != 0 || started || i == 0) {
-            if (started) printf("%08X", limbs[i]);
-            else printf("%X", limbs[i]);
-            started = 1;
-        }
+#if defined(__GNUC__)
+__attribute__((format(printf, 3, 4)))
+#endif
+static inline void _qlog_write(qol_log* lg, qol_log_site* s, const char* fmt, ...) {
+    if (_tools_load_int(&s->state) < 2) _qlog_parse(s);
+    _qlog_ring* r = _qlog_ring_for(lg);
+    if (r) {
+        va_list ap;
+        va_start(ap, fmt);
+        _qlog_push(lg, r, s, ap);
+        va_end(ap);
     }
+    if (s->level >= QLOG_FATAL) qlog_flush(lg);
 }
 
-static inline void _internal_dec_ascii(u32* limbs, int count) {
-    u32 temp[count];
-    memcpy(temp, limbs, count * sizeof(u32));
-    char digits[5000]; 
-    int pos = 0, digit_count = 0;
-    while (1) {
-        u64 remainder = 0;
-        int all_zero = 1;
-        for (int i = count - 1; i >= 0; i--) {
-            u64 val = temp[i] + (remainder << 32);
-            temp[i] = (u32)(val / 10);
-            remainder = val % 10;
-            if (temp[i] > 0) all_zero = 0;
+// One conversion that needs printf (flags, width, precision, floats, hex...).
+_TOOLS_COLD static void _qlog_snprintf(qol_sb* out, const char* spec, int stars, const int* star,
+                                       char t, unsigned long long v, const char* sv) {
+    size_t room = 64;
+    double d;
+    memcpy(&d, &v, 8);
+    for (;;) {
+        if (!sb_reserve(out, room)) return;
+        char* b = out->data + out->len;
+        int n = 0;
+#define _QLOG_SNP(x) (stars == 0 ? snprintf(b, room + 1, spec, x) : stars == 1 ? snprintf(b, room + 1, spec, star[0], x) \
+                                 : snprintf(b, room + 1, spec, star[0], star[1], x))
+        switch (t) {
+        case 'i': n = _QLOG_SNP((int)v); break;
+        case 'I': n = _QLOG_SNP((unsigned)v); break;
+        case 'l': n = _QLOG_SNP((long)v); break;
+        case 'L': n = _QLOG_SNP((unsigned long)v); break;
+        case 'q': n = _QLOG_SNP((long long)v); break;
+        case 'Q': n = _QLOG_SNP(v); break;
+        case 'z': n = _QLOG_SNP((size_t)v); break;
+        case 't': n = _QLOG_SNP((ptrdiff_t)v); break;
+        case 'j': n = _QLOG_SNP((intmax_t)v); break;
+        case 'J': n = _QLOG_SNP((uintmax_t)v); break;
+        case 'p': n = _QLOG_SNP((void*)(uintptr_t)v); break;
+        case 'd': n = _QLOG_SNP(d); break;
+        case 'D': n = _QLOG_SNP((long double)d); break;
+        case 's': n = _QLOG_SNP(sv); break;
         }
-        if (digit_count > 0 && digit_count % 3 == 0) digits[pos++] = ',';
-        digits[pos++] = (char)('0' + remainder);
-        digit_count++;
-        if (all_zero) break;
+#undef _QLOG_SNP
+        if (n < 0) return;
+        if ((size_t)n <= room) { out->len += (size_t)n; return; }
+        room = (size_t)n;
     }
-    for (int i = pos - 1; i >= 0; i--) putchar(digits[i]);
 }
 
-// --- Shift Operations ---
-#define DEF_SHIFT(BITS, COUNT) \
-    static inline void suint##BITS##_shl(suint##BITS *v, int shift) { \
-        if (shift <= 0) return; \
-        int limb_shift = shift / 32; \
-        int bit_shift = shift % 32; \
-        if (limb_shift >= COUNT) { memset(v->limbs, 0, sizeof(v->limbs)); return; } \
-        for (int i = COUNT - 1; i >= 0; i--) { \
-            if (i >= limb_shift) { \
-                v->limbs[i] = v->limbs[i - limb_shift] << bit_shift; \
-                if (bit_shift > 0 && i - limb_shift - 1 >= 0) \
-                    v->limbs[i] |= v->limbs[i - limb_shift - 1] >> (32 - bit_shift); \
-            } else v->limbs[i] = 0; \
-        } \
+// Replays the site's compiled format over the slots of one record.
+static inline void _qlog_format(qol_sb* out, const qol_log_site* s, const unsigned long long* slot) {
+    const char* str = (const char*)(slot + s->n_args);
+    const char* f = s->fmt;
+    char spec[32];
+    int i = 0;
+    for (int k = 0; k < s->n_ops; k++) {
+        const _qlog_op* op = &s->ops[k];
+        int star[2] = { 0, 0 };
+        if (!sb_reserve(out, (size_t)op->lit + FMT_INT_MAX)) return; // the text and any number fit
+        memcpy(out->data + out->len, f, op->lit);
+        out->len += op->lit;
+        f += op->lit + op->len;
+        if (op->kind == '%') { out->data[out->len++] = '%'; continue; }
+        for (int j = 0; j < op->stars; j++) star[j] = (int)slot[i++];
+        char t = s->types[i];
+        unsigned long long v = slot[i++];
+        switch (op->kind) {
+        case 'd': out->len += fmt_i64(out->data + out->len, t == 'z' ? (long long)(ptrdiff_t)(size_t)v : (long long)v); break;
+        case 'u': out->len += fmt_u64(out->data + out->len, v); break;
+        case 'c': out->data[out->len++] = (char)v; break;
+        case 's': sb_append_n(out, str, (size_t)v); break;
+        default:
+            memcpy(spec, f - op->len, op->len);
+            spec[op->len] = '\0';
+            _qlog_snprintf(out, spec, op->stars, star, t, v, str);
+        }
+        if (t == 's') str += (v + 8) & ~7ULL;
     }
+    sb_append_n(out, f, (size_t)s->tail);
+}
 
-DEF_SHIFT(32, 1)    DEF_SHIFT(64, 2)    DEF_SHIFT(128, 4)
-DEF_SHIFT(256, 8)   DEF_SHIFT(512, 16)  DEF_SHIFT(1024, 32)
-DEF_SHIFT(2048, 64) DEF_SHIFT(4096, 128) DEF_SHIFT(8192, 256)
-DEF_SHIFT(12288, 384)
+// "YYYY-MM-DD HH:MM:SS.mmm LEVEL message\n"
+static inline void _qlog_line(qol_log* lg, const _qlog_rec* h) {
+    static const char names[] = "TRACEDEBUGINFO WARN ERRORFATAL";
+    unsigned long long ns = lg->real_at + (unsigned long long)(long long)((double)(long long)(h->stamp - lg->cyc_at) * lg->ns_per_cyc);
+    time_t sec = (time_t)(ns / 1000000000ULL);
+    unsigned ms = (unsigned)(ns / 1000000ULL % 1000);
+    char pre[32];
+    if (sec != lg->tsec) { _time_format(sec, lg->ttext); lg->tsec = sec; }
+    memcpy(pre, lg->ttext, 19);
+    pre[19] = '.';
+    pre[20] = (char)('0' + ms / 100); pre[21] = (char)('0' + ms / 10 % 10); pre[22] = (char)('0' + ms % 10);
+    pre[23] = ' ';
+    memcpy(pre + 24, names + 5 * (h->site->level - 1), 5);
+    pre[29] = ' ';
+    sb_append_n(&lg->out, pre, 30);
+    const unsigned long long* slot = (const unsigned long long*)(const void*)((const char*)h + _QLOG_REC_SIZE);
+    if (h->site->state == 3) sb_append_n(&lg->out, (const char*)(slot + 1), (size_t)slot[0]);
+    else _qlog_format(&lg->out, h->site, slot);
+    sb_appendc(&lg->out, '\n');
+}
 
-// --- Modulo (Remainder) ---
-// This implements res = a % b using a limb-by-limb approach.
-// Note: This is a basic implementation. For high-performance 12288-bit 
-// division, one would typically use Knuth's Algorithm D.
-#define DEF_MOD(BITS, COUNT) \
-    static inline void suint##BITS##_mod(suint##BITS *res, suint##BITS a, suint##BITS b) { \
-        suint##BITS rem = {0}; \
-        /* Check for division by zero */ \
-        int is_zero = 1; \
-        for(int i = 0; i < COUNT; i++) if(b.limbs[i] != 0) is_zero = 0; \
-        if (is_zero) { *res = rem; return; } \
-        \
-        for (int i = BITS - 1; i >= 0; i--) { \
-            /* Shift remainder left by 1 */ \
-            u32 carry = 0; \
-            for (int j = 0; j < COUNT; j++) { \
-                u32 next_carry = rem.limbs[j] >> 31; \
-                rem.limbs[j] = (rem.limbs[j] << 1) | carry; \
-                carry = next_carry; \
-            } \
-            /* Bring down the next bit from 'a' */ \
-            int limb_idx = i / 32; \
-            int bit_idx = i % 32; \
-            if ((a.limbs[limb_idx] >> bit_idx) & 1) { \
-                rem.limbs[0] |= 1; \
-            } \
-            /* If rem >= b, then rem = rem - b */ \
-            int greater_equal = 1; \
-            for (int j = COUNT - 1; j >= 0; j--) { \
-                if (rem.limbs[j] < b.limbs[j]) { greater_equal = 0; break; } \
-                if (rem.limbs[j] > b.limbs[j]) { greater_equal = 1; break; } \
-            } \
-            if (greater_equal) { \
-                u64 borrow = 0; \
-                for (int j = 0; j < COUNT; j++) { \
-                    u64 sub = (u64)rem.limbs[j] - b.limbs[j] - borrow; \
-                    rem.limbs[j] = (u32)sub; \
-                    borrow = (sub >> 63) & 1; \
-                } \
-            } \
-        } \
-        *res = rem; \
+static inline void _qlog_output(qol_log* lg) {
+    const char* p = lg->out.data;
+    size_t n = lg->out.len;
+    while (n) {
+#ifdef _WIN32
+        int w = _write(lg->fd, p, n > (1u << 30) ? (1u << 30) : (unsigned)n);
+#else
+        ssize_t w = write(lg->fd, p, n);
+#endif
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) break; // a failing output loses the batch rather than stalling every thread
+        p += w; n -= (size_t)w;
     }
+    lg->out.len = 0;
+}
 
-// Generate Modulo functions for all bit sizes
-DEF_MOD(32, 1)      DEF_MOD(64, 2)      DEF_MOD(128, 4)
-DEF_MOD(256, 8)     DEF_MOD(512, 16)    DEF_MOD(1024, 32)
-DEF_MOD(2048, 64)   DEF_MOD(4096, 128)  DEF_MOD(8192, 256)
-DEF_MOD(12288, 384)
-
-// --- Printers ---
-#define DEF_PRINTERS(BITS, COUNT) \
-    static inline void _nf_u##BITS(suint##BITS v) { _internal_raw_hex(v.limbs, COUNT); } \
-    static inline void _f_u##BITS(suint##BITS v)  { _internal_dec_ascii(v.limbs, COUNT); } \
-    static inline void _nf_s##BITS(sint##BITS v)  { printf("(S)"); _internal_raw_hex((u32*)v.limbs, COUNT); } \
-    static inline void _f_s##BITS(sint##BITS v)   { if(v.limbs[COUNT-1] < 0) printf("-"); _internal_dec_ascii((u32*)v.limbs, COUNT); } \
-    static inline void _nf_flt##BITS(sfloat##BITS v) { _internal_raw_hex(v.mantissa.limbs, COUNT); printf(" E%d", v.exponent); } \
-    static inline void _f_flt##BITS(sfloat##BITS v)  { _internal_dec_ascii(v.mantissa.limbs, COUNT); printf(" * 2^%d", v.exponent); }
-
-DEF_PRINTERS(32, 1)    DEF_PRINTERS(64, 2)    DEF_PRINTERS(128, 4)
-DEF_PRINTERS(256, 8)   DEF_PRINTERS(512, 16)  DEF_PRINTERS(1024, 32)
-DEF_PRINTERS(2048, 64) DEF_PRINTERS(4096, 128) DEF_PRINTERS(8192, 256)
-DEF_PRINTERS(12288, 384)
+// Skips a wrap marker; returns the next record or NULL if the ring is drained.
+static inline const _qlog_rec* _qlog_peek(_qlog_ring* r) {
+    if (r->tail == r->end) return NULL;
+    size_t idx = (size_t)(r->tail & (QLOG_RING - 1));
+    if (*(const unsigned*)(const void*)(_QLOG_DATA(r) + idx) == _QLOG_WRAP) {
+        _tools_store_u64(&r->tail, r->tail + (QLOG_RING - idx));
+        if (r->tail == r->end) return NULL;
+        idx = 0;
+    }
+    return (const _qlog_rec*)(const void*)(_QLOG_DATA(r) + idx);
+}
 
-#define slibnfprint(val) _Generic((val), \
-    suint32: _nf_u32, suint64: _nf_u64, suint128: _nf_u128, suint256: _nf_u256, suint512: _nf_u512, \
-    suint1024: _nf_u1024, suint2048: _nf_u2048, suint4096: _nf_u4096, suint8192: _nf_u8192, suint12288: _nf_u12288, \
-    sint32: _nf_s32, sint64: _nf_s64, sint128: _nf_s128, sint256: _nf_s256, sint512: _nf_s512, \
-    sint1024: _nf_s1024, sint2048: _nf_s2048, sint4096: _nf_s4096, sint8192: _nf_s8192, sint12288: _nf_s12288, \
-    sfloat32: _nf_flt32, sfloat64: _nf_flt64, sfloat128: _nf_flt128, sfloat256: _nf_flt256, sfloat512: _nf_flt512, \
-    sfloat1024: _nf_flt1024, sfloat2048: _nf_flt2048, sfloat4096: _nf_flt4096, sfloat8192: _nf_flt8192, sfloat12288: _nf_flt12288 \
-)(val)
+// Records carry time_cycles(). The rate is measured against the monotonic clock
+// over the logger's whole life (so clock steps do not skew it), and each pass
+// anchors it to the current wall-clock time.
+static inline void _qlog_calibrate(qol_log* lg) {
+    unsigned long long cyc = time_cycles(), mono = time_mono_ns();
+    if (cyc != lg->cyc0) lg->ns_per_cyc = (double)(mono - lg->mono0) / (double)(cyc - lg->cyc0);
+    lg->cyc_at = cyc;
+    lg->real_at = _qlog_clock_ns();
+}
 
-#define slibprint(val) _Generic((val), \
-    suint32: _f_u32, suint64: _f_u64, suint128: _f_u128, suint256: _f_u256, suint512: _f_u512, \
-    suint1024: _f_u1024, suint2048: _f_u2048, suint4096: _f_u4096, suint8192: _f_u8192, suint12288: _f_u12288, \
-    sint32: _f_s32, sint64: _f_s64, sint128: _f_s128, sint256: _f_s256, sint512: _f_s512, \
-    sint1024: _f_s1024, sint2048: _f_s2048, sint4096: _f_s4096, sint8192: _f_s8192, sint12288: _f_s12288, \
-    sfloat32: _f_flt32, sfloat64: _f_flt64, sfloat128: _f_flt128, sfloat256: _f_flt256, sfloat512: _f_flt512, \
-    sfloat1024: _f_flt1024, sfloat2048: _f_flt2048, sfloat4096: _f_flt4096, sfloat8192: _f_flt8192, sfloat12288: _f_flt12288 \
-)(val)
-// --- Addition ---
-#define DEF_ADD(BITS, COUNT) \
-    static inline u32 suint##BITS##_add(suint##BITS *res, suint##BITS a, suint##BITS b) { \
-        u64 carry = 0; \
-        for (int i = 0; i < COUNT; i++) { \
-            u64 sum = (u64)a.limbs[i] + b.limbs[i] + carry; \
-            res->limbs[i] = (u32)sum; \
-            carry = sum >> 32; \
-        } \
-        return (u32)carry; \
+// Formats what every ring holds right now, oldest record first across rings.
+static inline size_t _qlog_drain(qol_log* lg) {
+    size_t count = 0;
+    int orphans = 0;
+    _qlog_calibrate(lg);
+    _tools_lock(&lg->lock);
+    _qlog_ring* first = lg->rings; // rings are only added at the front, so the rest of the list is stable
+    _tools_unlock(&lg->lock);
+    for (_qlog_ring* r = first; r; r = r->next) {
+        unsigned long long dropped = _tools_load_u64(&r->dropped);
+        if (dropped != r->reported) {
+            static qol_log_site site = { "qlog: %llu messages dropped (ring full)", QLOG_WARN, 0, 0, 0, 0, { 0 }, { 0 }, { { 0, 0, 0, 0 } } };
+            unsigned long long rec[(sizeof(_qlog_rec) + 7) / 8 + 1];
+            _qlog_rec* h = (_qlog_rec*)(void*)rec;
+            if (site.state < 2) _qlog_parse(&site);
+            h->site = &site; h->stamp = time_cycles();
+            rec[_QLOG_REC_SIZE / 8] = dropped - r->reported;
+            _qlog_line(lg, h);
+            _tools_store_u64(&lg->dropped, lg->dropped + (dropped - r->reported));
+            r->reported = dropped;
+        }
+        if (_tools_load_int(&r->orphaned)) orphans = 1; // before reading head: an orphan's head is final
+        r->end = _tools_load_u64(&r->head);
     }
-
-// --- Multiplication ---
-#define DEF_MUL(BITS, COUNT) \
-    static inline void suint##BITS##_mul(suint##BITS *res, suint##BITS a, suint##BITS b) { \
-        suint##BITS out = {0}; \
-        for (int i = 0; i < COUNT; i++) { \
-            if (a.limbs[i] == 0) continue; \
-            u64 carry = 0; \
-            for (int j = 0; i + j < COUNT; j++) { \
-                u64 cur = out.limbs[i + j] + (u64)a.limbs[i] * b.limbs[j] + carry; \
-                out.limbs[i + j] = (u32)cur; \
-                carry = cur >> 32; \
-            } \
-        } \
-        *res = out; \
+    for (;;) {
+        _qlog_ring* best = NULL;
+        const _qlog_rec* bh = NULL;
+        for (_qlog_ring* r = first; r; r = r->next) {
+            const _qlog_rec* h = _qlog_peek(r);
+            if (h && (!bh || h->stamp < bh->stamp)) { best = r; bh = h; }
+        }
+        if (!best) break;
+        _qlog_line(lg, bh);
+        _tools_store_u64(&best->tail, best->tail + bh->size);
+        count++;
+        if (lg->out.len >= QLOG_BATCH) _qlog_output(lg);
     }
+    if (orphans) {
+        _tools_lock(&lg->lock);
+        for (_qlog_ring** pp = &lg->rings; *pp; ) {
+            _qlog_ring* r = *pp;
+            if (_tools_load_int(&r->orphaned) && r->tail == _tools_load_u64(&r->head)) { *pp = r->next; _qlog_release(r); }
+            else pp = &r->next;
+        }
+        _tools_unlock(&lg->lock);
+    }
+    return count;
+}
 
-DEF_ADD(12288, 384)
-DEF_MUL(12288, 384)
-// Power function: res = base ^ exp
-static inline void suint12288_pow(suint12288 *res, u32 base_val, u32 exp) {
-    suint12288 b = {0}; b.limbs[0] = base_val;
-    suint12288 result = {0}; result.limbs[0] = 1;
-    
-    for (u32 i = 0; i < exp; i++) {
-        suint12288_mul(&result, result, b);
+static inline void _qlog_loop(qol_log* lg) {
+    unsigned idle = 0;
+    _qlog_sleep_us(1000); // a millisecond of counter before the first rate estimate
+    for (;;) {
+        int stopping = !_tools_load_int(&lg->running);
+        unsigned long long req = _tools_load_u64(&lg->flush_req);
+        size_t n = _qlog_drain(lg);
+        if (lg->out.len) _qlog_output(lg);
+        _tools_store_u64(&lg->flush_done, req);
+        if (stopping) return;
+        if (n) idle = 0;
+        else if (++idle < 16) _qlog_yield();
+        else _qlog_sleep_us(QLOG_IDLE_US);
     }
-    *res = result;
 }
 
-// Tetration: base ^^ height
-static inline void suint12288_tetrate(suint12288 *res, u32 base, u32 height) {
-    if (height == 0) { res->limbs[0] = 1; return; }
-    if (height == 1) { res->limbs[0] = base; return; }
-    
-    // Starting with base^^2
-    suint12288 current_val;
-    suint12288_pow(&current_val, base, base);
-    
-    for (u32 i = 2; i < height; i++) {
-        // This is the "Horrid" part. We use the previous result 
-        // as the exponent for the next layer.
-        // NOTE: We only take the first limb as the exponent here 
-        // because suint12288_pow expects a u32 exponent.
-        suint12288_pow(&current_val, base, current_val.limbs[0]);
+#ifdef _WIN32
+static inline DWORD WINAPI _qlog_thread(LPVOID lg) { _qlog_loop((qol_log*)lg); return 0; }
+#else
+static inline void* _qlog_thread(void* lg) { _qlog_loop((qol_log*)lg); return NULL; }
+#endif
+
+// Starts the writer thread; lines go to fd (1 for stdout, or an open file).
+// Returns 0 if the thread could not be created.
+static inline int qlog_start(qol_log* lg, int fd, int level) {
+    memset(lg, 0, sizeof(*lg));
+    lg->fd = fd; lg->level = level; lg->block = 1; lg->running = 1;
+    lg->tsec = (time_t)-1;
+    lg->cyc0 = time_cycles(); lg->mono0 = time_mono_ns();
+    _tools_mutex_init(&lg->lock);
+#ifdef _WIN32
+    lg->thread = CreateThread(NULL, 0, _qlog_thread, lg, 0, NULL);
+    if (lg->thread) return 1;
+#else
+    if (pthread_create(&lg->thread, NULL, _qlog_thread, lg) == 0) return 1;
+#endif
+    _tools_mutex_destroy(&lg->lock);
+    lg->running = 0; lg->level = QLOG_OFF;
+    return 0;
+}
+
+// Writes everything still queued and joins the writer. Call it once the other
+// threads have stopped logging; later calls on lg are ignored.
+static inline void qlog_stop(qol_log* lg) {
+    if (!_tools_load_int(&lg->running)) return;
+    _tools_store_int(&lg->level, QLOG_OFF);
+    _tools_lock(&lg->lock);
+    _tools_store_int(&lg->running, 0);
+    _tools_unlock(&lg->lock);
+#ifdef _WIN32
+    WaitForSingleObject(lg->thread, INFINITE);
+    CloseHandle(lg->thread);
+#else
+    pthread_join(lg->thread, NULL);
+#endif
+    _tools_lock(&lg->lock);
+    _qlog_ring* next;
+    for (_qlog_ring* r = lg->rings; r; r = next) {
+        next = r->next;
+        _tools_store_int(&r->detached, 1);
+        _qlog_release(r);
     }
-    *res = current_val;
+    lg->rings = NULL;
+    _tools_unlock(&lg->lock);
+    _tools_mutex_destroy(&lg->lock);
+    sb_free(&lg->out);
 }
+
+static inline void qlog_set_level(qol_log* lg, int level) { _tools_store_int(&lg->level, level); }
+
+// 1: a thread whose ring is full waits for the writer (nothing is lost).
+// 0: the message is dropped and counted, and the writer reports the count.
+//    FATAL messages still wait.
+static inline void qlog_set_blocking(qol_log* lg, int block) { _tools_store_int(&lg->block, block); }
+
+// Messages dropped so far, as reported by the writer.
+static inline unsigned long long qlog_dropped(qol_log* lg) { return _tools_load_u64(&lg->dropped); }
+
+#define _QLOG_FMT(f, ...) "" f
+
+// lvl must be a constant. The format is checked like printf's by GCC and Clang.
+#define QLOG(lg, lvl, ...) do { \
+    static qol_log_site _qlog_site = { _QLOG_FMT(__VA_ARGS__, 0), lvl, 0, 0, 0, 0, { 0 }, { 0 }, { { 0, 0, 0, 0 } } }; \
+    if ((lvl) >= _tools_load_int(&(lg)->level)) _qlog_write((lg), &_qlog_site, __VA_ARGS__); \
+} while (0)
+
+#if QLOG_MIN_LEVEL <= QLOG_TRACE
+#define qlog_trace(lg, ...) QLOG(lg, QLOG_TRACE, __VA_ARGS__)
+#else
+#define qlog_trace(lg, ...) ((void)0)
+#endif
+#if QLOG_MIN_LEVEL <= QLOG_DEBUG
+#define qlog_debug(lg, ...) QLOG(lg, QLOG_DEBUG, __VA_ARGS__)
+#else
+#define qlog_debug(lg, ...) ((void)0)
+#endif
+#if QLOG_MIN_LEVEL <= QLOG_INFO
+#define qlog_info(lg, ...) QLOG(lg, QLOG_INFO, __VA_ARGS__)
+#else
+#define qlog_info(lg, ...) ((void)0)
+#endif
+#if QLOG_MIN_LEVEL <= QLOG_WARN
+#define qlog_warn(lg, ...) QLOG(lg, QLOG_WARN, __VA_ARGS__)
+#else
+#define qlog_warn(lg, ...) ((void)0)
+#endif
+#if QLOG_MIN_LEVEL <= QLOG_ERROR
+#define qlog_error(lg, ...) QLOG(lg, QLOG_ERROR, __VA_ARGS__)
+#else
+#define qlog_error(lg, ...) ((void)0)
+#endif
+// Also waits for the line to be written, so it is not lost if the process dies next.
+#define qlog_fatal(lg, ...) QLOG(lg, QLOG_FATAL, __VA_ARGS__)
+
 #endif
 
 
@@ -0,0 +1,118 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "simple_fs.h"
+
+// Build: gcc -O2 bench.c -o bench
+
+static double now_ms() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static unsigned rng_state = 0x9E3779B9;
+static unsigned rng() { rng_state ^= rng_state << 13; rng_state ^= rng_state >> 17; rng_state ^= rng_state << 5; return rng_state; }
+
+// Runs stmt until at least 200ms have passed and returns ms per call.
+#define TIME_MS(result, stmt) { \
+    int _reps = 0; double _t0 = now_ms(), _t1; \
+    do { stmt; _reps++; _t1 = now_ms(); } while (_t1 - _t0 < 200.0); \
+    result = (_t1 - _t0) / _reps; \
+}
+
+// Keys of a few bytes, as in a hash table: ns per hash.
+static void bench_hash_small() {
+    static const int sizes[] = { 4, 8, 16, 32, 64, 128, 256 };
+    enum { KEYS = 1024 };
+    unsigned char* keys = (unsigned char*)malloc(KEYS * 256);
+    for (int i = 0; i < KEYS * 256; i++) keys[i] = (unsigned char)rng();
+    volatile uint64_t sink = 0;
+    printf("[hash, ns per key]\n");
+    printf("%-10s %12s %12s\n", "bytes", "char_to_int", "qhash64");
+    for (int s = 0; s < 7; s++) {
+        int n = sizes[s];
+        double t_fnv, t_q;
+        TIME_MS(t_fnv, for (int k = 0; k < KEYS; k++) sink += (unsigned)char_to_int(keys + 256 * k, n));
+        TIME_MS(t_q, for (int k = 0; k < KEYS; k++) sink += qhash64(keys + 256 * k, (size_t)n, 0));
+        printf("%-10d %12.1f %12.1f (%.1fx)\n", n, t_fnv * 1e6 / KEYS, t_q * 1e6 / KEYS, t_fnv / t_q);
+    }
+    printf("\n");
+    (void)sink;
+    free(keys);
+}
+
+// Content hashing of a 4 MB buffer: GB/s per dispatch level, plus streaming in 4 KB pieces.
+static void bench_hash_bulk() {
+    size_t n = 4 << 20;
+    unsigned char* buf = (unsigned char*)malloc(n);
+    for (size_t i = 0; i < n; i++) buf[i] = (unsigned char)rng();
+    volatile uint64_t sink = 0;
+    double t_fnv, t_lvl[3], t_128, t_stream;
+    int level = qhash_simd_level();
+    TIME_MS(t_fnv, sink += (unsigned)char_to_int(buf, (int)n));
+    for (int l = 0; l <= level; l++) {
+        qhash_simd_limit(l);
+        TIME_MS(t_lvl[l], sink += qhash64(buf, n, 0));
+        _qh_simd = -1;
+    }
+    TIME_MS(t_128, sink += qhash128(buf, n, 0).hi);
+    TIME_MS(t_stream, {
+        qol_hasher h;
+        qhash_init(&h, 0);
+        for (size_t i = 0; i < n; i += 4096) qhash_update(&h, buf + i, 4096);
+        sink += qhash_digest64(&h);
+    });
+    static const char* names[] = { "qhash64 scalar", "qhash64 SSE2", "qhash64 AVX2" };
+    printf("[hash, GB/s on 4 MB]\n");
+    printf("%-28s %9.2f\n", "char_to_int (FNV-1a)", n / t_fnv / 1e6);
+    for (int l = 0; l <= level; l++) printf("%-28s %9.2f (%.0fx)\n", names[l], n / t_lvl[l] / 1e6, t_fnv / t_lvl[l]);
+    printf("%-28s %9.2f\n", "qhash128", n / t_128 / 1e6);
+    printf("%-28s %9.2f\n\n", "qhasher, 4 KB updates", n / t_stream / 1e6);
+    (void)sink;
+    free(buf);
+}
+
+// Text-like input (words from a small vocabulary) and random bytes: MB/s of input.
+static void bench_compress() {
+    size_t n = 4 << 20;
+    unsigned char* text = (unsigned char*)malloc(n);
+    unsigned char* noise = (unsigned char*)malloc(n);
+    unsigned char* packed = (unsigned char*)malloc(qlz_compress_bound(n));
+    unsigned char* out = (unsigned char*)malloc(n);
+    static const char* words[] = { "GET", "POST", "/index.html", "/api/v1/users", "200", "404", "OK", "user=", "session", "\n" };
+    for (size_t i = 0; i < n; ) {
+        const char* w = words[rng() % 10];
+        while (*w && i < n) text[i++] = (unsigned char)*w++;
+        if (i < n) text[i++] = ' ';
+    }
+    for (size_t i = 0; i < n; i++) noise[i] = (unsigned char)rng();
+    printf("[compression, MB/s on 4 MB]\n");
+    printf("%-8s %7s %10s %10s %10s %10s %10s\n", "input", "ratio", "compress", "decompr.", "frame c.", "frame d.", "memcpy");
+    for (int k = 0; k < 2; k++) {
+        unsigned char* src = k ? noise : text;
+        size_t len = 0, frame_len = 0;
+        double t_c, t_d, t_fc, t_fd, t_copy;
+        TIME_MS(t_c, len = 0; for (size_t at = 0; at < n; at += QLZ_BLOCK) len += qlz_compress(packed, qlz_compress_bound(QLZ_BLOCK), src + at, QLZ_BLOCK));
+        size_t block_len = qlz_compress(packed, qlz_compress_bound(n), src, n);
+        TIME_MS(t_d, qlz_decompress(out, n, packed, block_len));
+        TIME_MS(t_fc, frame_len = qlz_frame_compress(packed, qlz_frame_bound(n), src, n));
+        TIME_MS(t_fd, qlz_frame_decompress(out, n, packed, frame_len));
+        TIME_MS(t_copy, memcpy(out, src, n));
+        printf("%-8s %7.3f %10.0f %10.0f %10.0f %10.0f %10.0f\n", k ? "random" : "text", (double)len / n,
+            n / t_c / 1e3, n / t_d / 1e3, n / t_fc / 1e3, n / t_fd / 1e3, n / t_copy / 1e3);
+    }
+    printf("\n");
+    free(text); free(noise); free(packed); free(out);
+}
+
+int main() {
+    printf("================================\n");
+    printf("   SIMPLE_FS BENCHMARKS         \n");
+    printf("================================\n\n");
+    bench_hash_small();
+    bench_hash_bulk();
+    bench_compress();
+    return 0;
+}
@@ -21,6 +21,24 @@
     #define ALT_SEP '\\'
 #endif
 
+/* --- SIMD Dispatch --- */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__) && !defined(SIMPLE_FS_NO_SIMD)
+    #include <immintrin.h>
+    #define _FS_X86_SIMD 1
+#endif
+
+/* --- Allocation Hooks --- */
+// libc defaults; QOL_MALLOC / QOL_REALLOC / QOL_FREE and QOL_USE_ALLOC are
+// documented in simple_types.h, which must come first to route through qol_malloc.
+#if defined(QOL_USE_ALLOC) && !defined(QOL_MALLOC)
+    #error "QOL_USE_ALLOC: include simple_types.h before this header (qol_malloc lives there)"
+#endif
+#ifndef QOL_MALLOC
+    #define QOL_MALLOC(n) malloc(n)
+    #define QOL_REALLOC(p, n) realloc(p, n)
+    #define QOL_FREE(p) free(p)
+#endif
+
 /* --- Internal Path Normalizer --- */
 static inline void _fs_normalize(char* path) {
     if (!path) return;
@@ -46,6 +64,343 @@ static inline float char_to_float(const void *ptr, int len) {
     return (float)seed / (float)0xFFFFFFFF;
 }
 
+/* --- Wide Hashing --- */
+// qhash64 / qhash128: seeded, non-cryptographic hashes over 8-byte words.
+// Up to QHASH_SHORT bytes use a wyhash-style multiply-fold chain; longer input
+// is cut into 64-byte stripes feeding 8 independent lanes (XXH3-style), which
+// the SSE2 / AVX2 kernels process 2 or 4 lanes at a time. Every path produces
+// the same value, and so does the streaming qol_hasher.
+
+#define QHASH_SHORT 256
+#define _QH_P32 0x9E3779B1u
+#define _QH_P1 0x9E3779B185EBCA87ULL
+#define _QH_P2 0xC2B2AE3D27D4EB4FULL
+
+typedef struct { uint64_t lo, hi; } qol_hash128;
+
+// Key material for the long path: 16 stripe keys at 8-byte steps, the scramble key at 128.
+static const unsigned char _qh_secret[192] = {
+    0x3a, 0x43, 0x40, 0x86, 0xcf, 0xee, 0x91, 0x84, 0x14, 0x86, 0xcc, 0x6c, 0x15, 0x2c, 0x54, 0xee,
+    0x3d, 0x57, 0x71, 0x11, 0x29, 0xa7, 0xfa, 0x85, 0xce, 0x7f, 0xf0, 0x9c, 0x14, 0x0a, 0x4c, 0x7b,
+    0xcf, 0x8b, 0x45, 0x50, 0x1b, 0x8f, 0x11, 0xdc, 0x11, 0x2c, 0x72, 0x03, 0x8f, 0x29, 0x99, 0x5c,
+    0x85, 0xf5, 0xd9, 0x25, 0x60, 0x0b, 0x7a, 0x82, 0xce, 0xa5, 0xfe, 0x25, 0xd5, 0x11, 0x9f, 0x9a,
+    0xce, 0xcd, 0x6c, 0x47, 0x08, 0x26, 0x0e, 0x58, 0xdd, 0x24, 0x0b, 0xe1, 0x39, 0x3f, 0x9a, 0x91,
+    0xdb, 0x6e, 0xa9, 0x0c, 0x86, 0xec, 0xf9, 0xfa, 0xb9, 0x84, 0xc0, 0x7d, 0x7a, 0xd4, 0x2c, 0x1f,
+    0x12, 0xee, 0x09, 0x55, 0x80, 0x3d, 0x77, 0xeb, 0x06, 0xc0, 0xfe, 0x2d, 0x57, 0xed, 0x61, 0xec,
+    0x72, 0x3d, 0x7d, 0xa1, 0x8e, 0x87, 0x6f, 0xe9, 0xe6, 0xc4, 0xc0, 0x8b, 0x75, 0xb9, 0x23, 0x28,
+    0xe0, 0x20, 0x31, 0xef, 0x4b, 0xb4, 0x81, 0xc8, 0xc3, 0x7d, 0x11, 0x6d, 0xad, 0x9b, 0x03, 0xd8,
+    0x6d, 0x60, 0x5b, 0x0e, 0xdd, 0x0b, 0xb1, 0x78, 0xac, 0x6e, 0x72, 0x44, 0x96, 0x49, 0xcd, 0x3f,
+    0x48, 0x76, 0xe2, 0x0a, 0x88, 0x6c, 0xbb, 0x20, 0xea, 0xdb, 0x82, 0xf8, 0x0e, 0xe0, 0xb0, 0xee,
+    0xa9, 0x81, 0x0f, 0x16, 0x4f, 0x7e, 0x69, 0xac, 0xce, 0xa3, 0x9e, 0x5a, 0x00, 0xb7, 0xca, 0xb7,
+};
+
+static const uint64_t _qh_wy[4] = { 0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL, 0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL };
+
+// Little-endian reads, so hashes match across platforms.
+static inline uint64_t _qh_r64(const unsigned char* p) {
+    uint64_t v; memcpy(&v, p, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+static inline uint64_t _qh_r32(const unsigned char* p) {
+    uint32_t v; memcpy(&v, p, 4);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap32(v);
+#endif
+    return v;
+}
+
+// Full 64x64 -> 128-bit product: *a gets the low half, *b the high half.
+static inline void _qh_mum(uint64_t* a, uint64_t* b) {
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef unsigned __int128 _qh_u128;
+    _qh_u128 r = (_qh_u128)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    *a = _umul128(*a, *b, b);
+#else
+    uint64_t ll = (*a & 0xFFFFFFFF) * (*b & 0xFFFFFFFF), lh = (*a & 0xFFFFFFFF) * (*b >> 32);
+    uint64_t hl = (*a >> 32) * (*b & 0xFFFFFFFF), hh = (*a >> 32) * (*b >> 32);
+    uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+    *a = (ll & 0xFFFFFFFF) | (mid << 32);
+    *b = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif
+}
+
+// The product folded to 64 bits.
+static inline uint64_t _qh_mix(uint64_t a, uint64_t b) { _qh_mum(&a, &b); return a ^ b; }
+
+// n <= QHASH_SHORT: three 16-byte chains over 48-byte blocks, then the tail.
+static inline uint64_t _qh_short(const unsigned char* p, size_t n, uint64_t seed) {
+    const uint64_t* s = _qh_wy;
+    uint64_t a, b;
+    seed ^= _qh_mix(seed ^ s[0], s[1]);
+    if (n <= 16) {
+        if (n >= 4) {
+            size_t q = (n >> 3) << 2;
+            a = _qh_r32(p) << 32 | _qh_r32(p + q);
+            b = _qh_r32(p + n - 4) << 32 | _qh_r32(p + n - 4 - q);
+        } else if (n) {
+            a = (uint64_t)p[0] << 16 | (uint64_t)p[n >> 1] << 8 | p[n - 1];
+            b = 0;
+        } else a = b = 0;
+    } else {
+        size_t i = n;
+        if (i > 48) {
+            uint64_t s1 = seed, s2 = seed;
+            do {
+                seed = _qh_mix(_qh_r64(p) ^ s[1], _qh_r64(p + 8) ^ seed);
+                s1 = _qh_mix(_qh_r64(p + 16) ^ s[2], _qh_r64(p + 24) ^ s1);
+                s2 = _qh_mix(_qh_r64(p + 32) ^ s[3], _qh_r64(p + 40) ^ s2);
+                p += 48; i -= 48;
+            } while (i > 48);
+            seed ^= s1 ^ s2;
+        }
+        for (; i > 16; i -= 16, p += 16) seed = _qh_mix(_qh_r64(p) ^ s[1], _qh_r64(p + 8) ^ seed);
+        a = _qh_r64(p + i - 16);
+        b = _qh_r64(p + i - 8);
+    }
+    a ^= s[1];
+    b ^= seed;
+    _qh_mum(&a, &b);
+    return _qh_mix(a ^ s[0] ^ n, b ^ s[1]);
+}
+
+// One 64-byte stripe: lane i gains lo32(d ^ k) * hi32(d ^ k), its neighbour gains d.
+static inline void _qh_stripe(uint64_t* acc, const unsigned char* p, const unsigned char* key) {
+    for (int i = 0; i < 8; i++) {
+        uint64_t d = _qh_r64(p + 8 * i), x = d ^ _qh_r64(key + 8 * i);
+        acc[i ^ 1] += d;
+        acc[i] += (x & 0xFFFFFFFF) * (x >> 32);
+    }
+}
+
+static inline void _qh_scramble(uint64_t* acc, const unsigned char* key) {
+    for (int i = 0; i < 8; i++) {
+        uint64_t a = acc[i];
+        a ^= a >> 47;
+        acc[i] = (a ^ _qh_r64(key + 8 * i)) * _QH_P32;
+    }
+}
+
+// Every 16 stripes the lanes are scrambled; *count is the global stripe index.
+static inline void _qh_consume_scalar(uint64_t* acc, const unsigned char* p, size_t n, uint64_t* count, const unsigned char* sec) {
+    for (uint64_t s = *count, end = s + n; s < end; s++, p += 64) {
+        _qh_stripe(acc, p, sec + 8 * (s & 15));
+        if ((s & 15) == 15) _qh_scramble(acc, sec + 128);
+    }
+    *count += n;
+}
+
+#ifdef _FS_X86_SIMD
+static inline __m128i _qh_sse2_mul32(__m128i a, __m128i prime) {
+    return _mm_add_epi64(_mm_mul_epu32(a, prime), _mm_slli_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), prime), 32));
+}
+
+static inline void _qh_consume_sse2(uint64_t* acc, const unsigned char* p, size_t n, uint64_t* count, const unsigned char* sec) {
+    __m128i a[4];
+    const __m128i prime = _mm_set1_epi32((int)_QH_P32);
+    for (int j = 0; j < 4; j++) a[j] = _mm_loadu_si128((const __m128i*)(acc + 2 * j));
+    for (uint64_t s = *count, end = s + n; s < end; s++, p += 64) {
+        const unsigned char* k = sec + 8 * (s & 15);
+        for (int j = 0; j < 4; j++) {
+            __m128i d = _mm_loadu_si128((const __m128i*)(p + 16 * j));
+            __m128i x = _mm_xor_si128(d, _mm_loadu_si128((const __m128i*)(k + 16 * j)));
+            __m128i prod = _mm_mul_epu32(x, _mm_srli_epi64(x, 32));
+            a[j] = _mm_add_epi64(a[j], _mm_add_epi64(prod, _mm_shuffle_epi32(d, 0x4E)));
+        }
+        if ((s & 15) == 15) {
+            for (int j = 0; j < 4; j++) {
+                __m128i v = _mm_xor_si128(a[j], _mm_srli_epi64(a[j], 47));
+                v = _mm_xor_si128(v, _mm_loadu_si128((const __m128i*)(sec + 128 + 16 * j)));
+                a[j] = _qh_sse2_mul32(v, prime);
+            }
+        }
+    }
+    for (int j = 0; j < 4; j++) _mm_storeu_si128((__m128i*)(acc + 2 * j), a[j]);
+    *count += n;
+}
+
+__attribute__((target("avx2")))
+static inline void _qh_consume_avx2(uint64_t* acc, const unsigned char* p, size_t n, uint64_t* count, const unsigned char* sec) {
+    __m256i a[2];
+    const __m256i prime = _mm256_set1_epi32((int)_QH_P32);
+    for (int j = 0; j < 2; j++) a[j] = _mm256_loadu_si256((const __m256i*)(acc + 4 * j));
+    for (uint64_t s = *count, end = s + n; s < end; s++, p += 64) {
+        const unsigned char* k = sec + 8 * (s & 15);
+        for (int j = 0; j < 2; j++) {
+            __m256i d = _mm256_loadu_si256((const __m256i*)(p + 32 * j));
+            __m256i x = _mm256_xor_si256(d, _mm256_loadu_si256((const __m256i*)(k + 32 * j)));
+            __m256i prod = _mm256_mul_epu32(x, _mm256_srli_epi64(x, 32));
+            a[j] = _mm256_add_epi64(a[j], _mm256_add_epi64(prod, _mm256_shuffle_epi32(d, 0x4E)));
+        }
+        if ((s & 15) == 15) {
+            for (int j = 0; j < 2; j++) {
+                __m256i v = _mm256_xor_si256(a[j], _mm256_srli_epi64(a[j], 47));
+                v = _mm256_xor_si256(v, _mm256_loadu_si256((const __m256i*)(sec + 128 + 32 * j)));
+                a[j] = _mm256_add_epi64(_mm256_mul_epu32(v, prime), _mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(v, 32), prime), 32));
+            }
+        }
+    }
+    for (int j = 0; j < 2; j++) _mm256_storeu_si256((__m256i*)(acc + 4 * j), a[j]);
+    *count += n;
+}
+#endif
+
+// 0 = scalar, 1 = SSE2, 2 = AVX2. qhash_simd_limit caps it (for testing and benchmarks).
+static int _qh_simd = -1;
+
+static inline int qhash_simd_level() {
+    if (_qh_simd < 0) {
+        _qh_simd = 0;
+#ifdef _FS_X86_SIMD
+        _qh_simd = 1;
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) _qh_simd = 2;
+#endif
+    }
+    return _qh_simd;
+}
+
+static inline void qhash_simd_limit(int level) { if (qhash_simd_level() > level) _qh_simd = level; }
+
+static inline void _qh_consume(uint64_t* acc, const unsigned char* p, size_t n, uint64_t* count, const unsigned char* sec) {
+#ifdef _FS_X86_SIMD
+    int level = qhash_simd_level();
+    if (level >= 2) { _qh_consume_avx2(acc, p, n, count, sec); return; }
+    if (level == 1) { _qh_consume_sse2(acc, p, n, count, sec); return; }
+#endif
+    _qh_consume_scalar(acc, p, n, count, sec);
+}
+
+static inline void _qh_acc_init(uint64_t* acc) {
+    static const uint64_t init[8] = { 0xC2B2AE3DULL, _QH_P1, _QH_P2, 0x165667B19E3779F9ULL,
+                                      0x85EBCA77C2B2AE63ULL, 0x85EBCA77ULL, 0x27D4EB2F165667C5ULL, _QH_P32 };
+    memcpy(acc, init, sizeof(init));
+}
+
+// Seeded key: even words + seed, odd words - seed.
+static inline void _qh_seed_secret(unsigned char* out, uint64_t seed) {
+    for (int i = 0; i < 24; i++) {
+        uint64_t w = _qh_r64(_qh_secret + 8 * i) + (i & 1 ? 0 - seed : seed);
+        for (int b = 0; b < 8; b++) out[8 * i + b] = (unsigned char)(w >> (8 * b));
+    }
+}
+
+static inline uint64_t _qh_merge(const uint64_t* acc, const unsigned char* key, uint64_t h) {
+    for (int i = 0; i < 4; i++) h += _qh_mix(acc[2 * i] ^ _qh_r64(key + 16 * i), acc[2 * i + 1] ^ _qh_r64(key + 16 * i + 8));
+    h ^= h >> 37;
+    h *= 0x165667919E3779F9ULL;
+    return h ^ (h >> 32);
+}
+
+// Final stripe (the last 64 bytes, overlapping earlier ones) and the merge into 64 or 128 bits.
+static inline qol_hash128 _qh_long_final(uint64_t* acc, const unsigned char* last, uint64_t total, const unsigned char* sec, int wide) {
+    qol_hash128 r;
+    _qh_stripe(acc, last, sec + 192 - 64 - 7);
+    r.lo = _qh_merge(acc, sec + 11, total * _QH_P1);
+    r.hi = wide ? _qh_merge(acc, sec + 192 - 64 - 11, ~(total * _QH_P2)) : 0;
+    return r;
+}
+
+static inline qol_hash128 _qh_long(const unsigned char* p, size_t n, uint64_t seed, int wide) {
+    unsigned char seeded[192];
+    const unsigned char* sec = _qh_secret;
+    uint64_t acc[8], count = 0;
+    if (seed) { _qh_seed_secret(seeded, seed); sec = seeded; }
+    _qh_acc_init(acc);
+    _qh_consume(acc, p, (n - 1) / 64, &count, sec);
+    return _qh_long_final(acc, p + n - 64, n, sec, wide);
+}
+
+static inline uint64_t qhash64(const void* data, size_t n, uint64_t seed) {
+    const unsigned char* p = (const unsigned char*)data;
+    return n <= QHASH_SHORT ? _qh_short(p, n, seed) : _qh_long(p, n, seed, 0).lo;
+}
+
+static inline qol_hash128 qhash128(const void* data, size_t n, uint64_t seed) {
+    const unsigned char* p = (const unsigned char*)data;
+    if (n > QHASH_SHORT) return _qh_long(p, n, seed, 1);
+    qol_hash128 r;
+    r.lo = _qh_short(p, n, seed);
+    r.hi = _qh_short(p, n, seed ^ _QH_P2);
+    return r;
+}
+
+// Streaming: qhash_update in pieces of any size gives the same value as one qhash64 / qhash128 call.
+typedef struct {
+    uint64_t acc[8];
+    uint64_t count;                 // stripes consumed
+    uint64_t total;                 // bytes seen
+    uint64_t seed;
+    size_t buf_len;
+    unsigned char buf[QHASH_SHORT];
+    unsigned char prev[64];         // last 64 consumed bytes, for a short final stripe
+    unsigned char secret[192];
+} qol_hasher;
+
+static inline void qhash_init(qol_hasher* h, uint64_t seed) {
+    _qh_acc_init(h->acc);
+    h->count = h->total = 0;
+    h->seed = seed;
+    h->buf_len = 0;
+    if (seed) _qh_seed_secret(h->secret, seed);
+    else memcpy(h->secret, _qh_secret, sizeof(h->secret));
+}
+
+// Stripes are consumed only once more input follows them, so the final stripe is always left in buf.
+static inline void qhash_update(qol_hasher* h, const void* data, size_t n) {
+    const unsigned char* p = (const unsigned char*)data;
+    h->total += n;
+    if (n <= QHASH_SHORT && h->buf_len + n <= QHASH_SHORT) {
+        if (n) memcpy(h->buf + h->buf_len, p, n);
+        h->buf_len += n;
+        return;
+    }
+    if (h->buf_len) {
+        size_t fill = QHASH_SHORT - h->buf_len;
+        memcpy(h->buf + h->buf_len, p, fill);
+        p += fill; n -= fill;
+        _qh_consume(h->acc, h->buf, QHASH_SHORT / 64, &h->count, h->secret);
+        memcpy(h->prev, h->buf + QHASH_SHORT - 64, 64);
+    }
+    if (n > QHASH_SHORT) {
+        size_t bulk = (n - 1) / QHASH_SHORT * QHASH_SHORT;
+        _qh_consume(h->acc, p, bulk / 64, &h->count, h->secret);
+        memcpy(h->prev, p + bulk - 64, 64);
+        p += bulk; n -= bulk;
+    }
+    memcpy(h->buf, p, n);
+    h->buf_len = n;
+}
+
+static inline qol_hash128 _qh_digest(const qol_hasher* h, int wide) {
+    if (h->total <= QHASH_SHORT) {
+        qol_hash128 r;
+        r.lo = _qh_short(h->buf, h->buf_len, h->seed);
+        r.hi = wide ? _qh_short(h->buf, h->buf_len, h->seed ^ _QH_P2) : 0;
+        return r;
+    }
+    uint64_t acc[8], count = h->count;
+    unsigned char last[64];
+    memcpy(acc, h->acc, sizeof(acc));
+    _qh_consume(acc, h->buf, (h->buf_len - 1) / 64, &count, h->secret);
+    if (h->buf_len >= 64) memcpy(last, h->buf + h->buf_len - 64, 64);
+    else {
+        memcpy(last, h->prev + h->buf_len, 64 - h->buf_len);
+        memcpy(last + 64 - h->buf_len, h->buf, h->buf_len);
+    }
+    return _qh_long_final(acc, last, h->total, h->secret, wide);
+}
+
+// Digests do not modify the state: more data can be added afterwards.
+static inline uint64_t qhash_digest64(const qol_hasher* h) { return _qh_digest(h, 0).lo; }
+static inline qol_hash128 qhash_digest128(const qol_hasher* h) { return _qh_digest(h, 1); }
+
 static inline long fs_size(const char* filename) {
     char clean_path[256]; strncpy(clean_path, filename, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
     FILE* f = fopen(clean_path, "rb");
@@ -63,7 +418,7 @@ static inline char* fs_read(const char* filename) {
     fseek(f, 0, SEEK_END);
     long size = ftell(f);
     fseek(f, 0, SEEK_SET);
-    char* buffer = (char*)malloc(size + 1);
+    char* buffer = (char*)QOL_MALLOC(size + 1);
     if (!buffer) { fclose(f); return NULL; }
     fread(buffer, 1, size, f);
     buffer[size] = 0;
@@ -156,7 +511,7 @@ static inline char* fs_listdir(const char* path) {
     char clean_path[256]; strncpy(clean_path, path, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
 
     size_t cap = 1024;
-    char* result = (char*)malloc(cap);
+    char* result = (char*)QOL_MALLOC(cap);
     if (!result) return NULL;
     result[0] = '\0';
 
@@ -170,7 +525,7 @@ static inline char* fs_listdir(const char* path) {
             if (strcmp(findData.cFileName, ".") != 0 && strcmp(findData.cFileName, "..") != 0) {
                 int is_dir = (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY);
                 size_t needed = strlen(result) + strlen(findData.cFileName) + 10;
-                if (needed >= cap) { cap *= 2; result = (char*)realloc(result, cap); }
+                if (needed >= cap) { cap *= 2; result = (char*)QOL_REALLOC(result, cap); }
                 if (result[0] != '\0') strcat(result, "|");
                 strcat(result, findData.cFileName);
                 strcat(result, is_dir ? ":dir" : ":file");
@@ -189,7 +544,7 @@ static inline char* fs_listdir(const char* path) {
             struct stat st;
             int is_dir = (stat(full_path, &st) == 0 && S_ISDIR(st.st_mode));
             size_t needed = strlen(result) + strlen(p->d_name) + 10;
-            if (needed >= cap) { cap *= 2; result = (char*)realloc(result, cap); }
+            if (needed >= cap) { cap *= 2; result = (char*)QOL_REALLOC(result, cap); }
             if (result[0] != '\0') strcat(result, "|");
             strcat(result, p->d_name);
             strcat(result, is_dir ? ":dir" : ":file");
@@ -228,7 +583,7 @@ static inline char* fs_readto(const char* filename, int endbyte) {
     char clean_path[256]; strncpy(clean_path, filename, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
     FILE* f = fopen(clean_path, "rb");
     if (!f) return NULL;
-    char* buffer = (char*)malloc(endbyte + 1);
+    char* buffer = (char*)QOL_MALLOC(endbyte + 1);
     if (!buffer) { fclose(f); return NULL; }
     int bytesRead = (int)fread(buffer, 1, endbyte, f);
     buffer[bytesRead] = 0;
@@ -243,7 +598,7 @@ static inline char* fs_readamount(const char* filename, int startbyte, int endby
     fseek(f, startbyte, SEEK_SET);
     int amount = endbyte - startbyte;
     if (amount <= 0) { fclose(f); return NULL; }
-    char* buffer = (char*)malloc(amount + 1);
+    char* buffer = (char*)QOL_MALLOC(amount + 1);
     if (!buffer) { fclose(f); return NULL; }
     int bytesRead = (int)fread(buffer, 1, amount, f);
     buffer[bytesRead] = 0;
@@ -251,4 +606,776 @@ static inline char* fs_readamount(const char* filename, int startbyte, int endby
     return buffer;
 }
 
+// Streams a file through qhash64 without loading it whole. Returns 1 on success, 0 if it cannot be read.
+static inline int fs_hash(const char* filename, uint64_t seed, uint64_t* out) {
+    char clean_path[256]; strncpy(clean_path, filename, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
+    FILE* f = fopen(clean_path, "rb");
+    if (!f) return 0;
+    qol_hasher h;
+    unsigned char chunk[16384];
+    size_t got;
+    qhash_init(&h, seed);
+    while ((got = fread(chunk, 1, sizeof(chunk), f)) > 0) qhash_update(&h, chunk, got);
+    int ok = !ferror(f);
+    fclose(f);
+    if (ok) *out = qhash_digest64(&h);
+    return ok;
+}
+
+/* --- Fast Compression (LZ4 Format) --- */
+// qlz_compress / qlz_decompress read and write LZ4 blocks: greedy matching over
+// a hash table of 4-byte sequences, with the search skipping ahead faster the
+// longer it goes without a match. Frames follow the LZ4 frame format, so files
+// from fs_write_compressed open with `lz4 -d` and lz4's output decodes here.
+
+#define QLZ_ERROR ((size_t)-1)
+#define QLZ_BLOCK 65536              // Frame block size written by the encoder.
+#define QLZ_MAX_INPUT 0x7E000000     // Largest input for one raw block.
+#ifndef QLZ_TABLE_LOG
+#define QLZ_TABLE_LOG 12             // 4096-entry match table (16 KB).
+#endif
+#define _QLZ_MINMATCH 4
+#define _QLZ_LAST_LITERALS 5         // A block ends with at least this many literals...
+#define _QLZ_MFLIMIT 12              // ...and its last match starts this far from the end.
+#define _QLZ_MAX_DIST 65535
+#define _QLZ_MAGIC 0x184D2204u
+#define _QLZ_SKIP_MAGIC 0x184D2A50u  // 16 values: 0x184D2A50-5F.
+
+static inline uint32_t _qlz_r32(const unsigned char* p) { uint32_t v; memcpy(&v, p, 4); return v; }
+static inline uint64_t _qlz_r64(const unsigned char* p) { uint64_t v; memcpy(&v, p, 8); return v; }
+static inline uint32_t _qlz_le32(const unsigned char* p) { return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24; }
+static inline void _qlz_put32(unsigned char* p, uint32_t v) { p[0] = (unsigned char)v; p[1] = (unsigned char)(v >> 8); p[2] = (unsigned char)(v >> 16); p[3] = (unsigned char)(v >> 24); }
+
+// XXH32, which the frame format uses for its header and content checksums.
+typedef struct { uint32_t v[4]; uint64_t total; unsigned char mem[16]; size_t mem_len; } _qlz_xxh;
+#define _QLZ_X1 0x9E3779B1u
+#define _QLZ_X2 0x85EBCA77u
+#define _QLZ_X3 0xC2B2AE3Du
+#define _QLZ_X4 0x27D4EB2Fu
+#define _QLZ_X5 0x165667B1u
+static inline uint32_t _qlz_rotl(uint32_t x, int r) { return (x << r) | (x >> (32 - r)); }
+static inline uint32_t _qlz_round(uint32_t acc, uint32_t in) { return _qlz_rotl(acc + in * _QLZ_X2, 13) * _QLZ_X1; }
+
+static inline void _qlz_xxh_init(_qlz_xxh* h) {
+    h->v[0] = _QLZ_X1 + _QLZ_X2; h->v[1] = _QLZ_X2; h->v[2] = 0; h->v[3] = 0u - _QLZ_X1;
+    h->total = 0; h->mem_len = 0;
+}
+
+static inline void _qlz_xxh_update(_qlz_xxh* h, const void* data, size_t n) {
+    const unsigned char* p = (const unsigned char*)data;
+    h->total += n;
+    if (h->mem_len + n < 16) { memcpy(h->mem + h->mem_len, p, n); h->mem_len += n; return; }
+    if (h->mem_len) {
+        size_t fill = 16 - h->mem_len;
+        memcpy(h->mem + h->mem_len, p, fill);
+        for (int i = 0; i < 4; i++) h->v[i] = _qlz_round(h->v[i], _qlz_le32(h->mem + 4 * i));
+        p += fill; n -= fill; h->mem_len = 0;
+    }
+    uint32_t v0 = h->v[0], v1 = h->v[1], v2 = h->v[2], v3 = h->v[3];
+    for (; n >= 16; p += 16, n -= 16) {
+        v0 = _qlz_round(v0, _qlz_le32(p)); v1 = _qlz_round(v1, _qlz_le32(p + 4));
+        v2 = _qlz_round(v2, _qlz_le32(p + 8)); v3 = _qlz_round(v3, _qlz_le32(p + 12));
+    }
+    h->v[0] = v0; h->v[1] = v1; h->v[2] = v2; h->v[3] = v3;
+    memcpy(h->mem, p, n); h->mem_len = n;
+}
+
+static inline uint32_t _qlz_xxh_digest(const _qlz_xxh* h) {
+    uint32_t acc = h->total >= 16
+        ? _qlz_rotl(h->v[0], 1) + _qlz_rotl(h->v[1], 7) + _qlz_rotl(h->v[2], 12) + _qlz_rotl(h->v[3], 18)
+        : h->v[2] + _QLZ_X5;
+    const unsigned char* p = h->mem;
+    size_t n = h->mem_len;
+    acc += (uint32_t)h->total;
+    for (; n >= 4; p += 4, n -= 4) acc = _qlz_rotl(acc + _qlz_le32(p) * _QLZ_X3, 17) * _QLZ_X4;
+    for (; n; p++, n--) acc = _qlz_rotl(acc + *p * _QLZ_X5, 11) * _QLZ_X1;
+    acc ^= acc >> 15; acc *= _QLZ_X2;
+    acc ^= acc >> 13; acc *= _QLZ_X3;
+    return acc ^ (acc >> 16);
+}
+
+static inline uint32_t _qlz_xxh32(const void* data, size_t n) {
+    _qlz_xxh h;
+    _qlz_xxh_init(&h);
+    _qlz_xxh_update(&h, data, n);
+    return _qlz_xxh_digest(&h);
+}
+
+// Hash of the 5 bytes at p (4 on 32-bit targets).
+static inline uint32_t _qlz_hash(const unsigned char* p) {
+    if (sizeof(void*) == 8) return (uint32_t)(((_qlz_r64(p) << 24) * 889523592379ULL) >> (64 - QLZ_TABLE_LOG));
+    return (_qlz_r32(p) * 2654435761u) >> (32 - QLZ_TABLE_LOG);
+}
+
+// Length of the common prefix of p and m, reading no further than limit.
+static inline size_t _qlz_count(const unsigned char* p, const unsigned char* m, const unsigned char* limit) {
+    const unsigned char* start = p;
+    while (p + 8 <= limit) {
+        uint64_t diff = _qlz_r64(p) ^ _qlz_r64(m);
+        if (diff) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            return (size_t)(p - start) + (size_t)(__builtin_clzll(diff) >> 3);
+#else
+            return (size_t)(p - start) + (size_t)(__builtin_ctzll(diff) >> 3);
+#endif
+        }
+        p += 8; m += 8;
+    }
+    while (p < limit && *p == *m) { p++; m++; }
+    return (size_t)(p - start);
+}
+
+static inline unsigned char* _qlz_put_len(unsigned char* op, size_t len) {
+    for (; len >= 255; len -= 255) *op++ = 255;
+    *op++ = (unsigned char)len;
+    return op;
+}
+
+// Worst case for qlz_compress: incompressible input plus one length byte per 255 literals.
+static inline size_t qlz_compress_bound(size_t n) { return n > QLZ_MAX_INPUT ? 0 : n + n / 255 + 16; }
+
+// Compresses src[0..n) into one LZ4 block. Returns its size, or 0 if it does not
+// fit in cap bytes (always fits in qlz_compress_bound(n)) or n > QLZ_MAX_INPUT.
+static inline size_t qlz_compress(void* dst, size_t cap, const void* src, size_t n) {
+    const unsigned char* base = (const unsigned char*)src;
+    const unsigned char* ip = base;
+    const unsigned char* anchor = base;
+    const unsigned char* iend = base + n;
+    unsigned char* op = (unsigned char*)dst;
+    unsigned char* oend = op + cap;
+    uint32_t table[1 << QLZ_TABLE_LOG];
+    if (n > QLZ_MAX_INPUT || cap == 0) return 0;
+    if (n >= _QLZ_MFLIMIT + 1) {
+        const unsigned char* mflimit = iend - _QLZ_MFLIMIT;
+        const unsigned char* match_limit = iend - _QLZ_LAST_LITERALS;
+        uint32_t fwd_h;
+        memset(table, 0, sizeof(table));
+        table[_qlz_hash(ip)] = 0;
+        fwd_h = _qlz_hash(++ip);
+        for (;;) {
+            const unsigned char* match;
+            unsigned char* token;
+            // Look for a 4-byte match, stepping further after every 64 misses.
+            {
+                const unsigned char* fwd = ip;
+                unsigned step = 1, searches = 1u << 6;
+                do {
+                    uint32_t h = fwd_h;
+                    ip = fwd;
+                    fwd += step;
+                    step = searches++ >> 6;
+                    if (fwd > mflimit) goto last_literals;
+                    match = base + table[h];
+                    fwd_h = _qlz_hash(fwd);
+                    table[h] = (uint32_t)(ip - base);
+                } while (match + _QLZ_MAX_DIST < ip || _qlz_r32(match) != _qlz_r32(ip));
+            }
+            while (ip > anchor && match > base && ip[-1] == match[-1]) { ip--; match--; }
+            {
+                size_t lit = (size_t)(ip - anchor);
+                token = op++;
+                if ((size_t)(oend - op) < lit + lit / 255 + 2 + 1 + _QLZ_LAST_LITERALS) return 0;
+                if (lit >= 15) { *token = 15 << 4; op = _qlz_put_len(op, lit - 15); }
+                else *token = (unsigned char)(lit << 4);
+                if ((size_t)(oend - op) >= lit + 8) {
+                    unsigned char* d = op;
+                    const unsigned char* s = anchor;
+                    do { memcpy(d, s, 8); d += 8; s += 8; } while (d < op + lit);
+                } else memcpy(op, anchor, lit);
+                op += lit;
+            }
+            for (;;) {
+                size_t len;
+                op[0] = (unsigned char)(ip - match); op[1] = (unsigned char)((ip - match) >> 8);
+                op += 2;
+                len = _qlz_count(ip + _QLZ_MINMATCH, match + _QLZ_MINMATCH, match_limit);
+                ip += _QLZ_MINMATCH + len;
+                // Length bytes, then room for the next token and the last literals.
+                if ((size_t)(oend - op) < (len + 240) / 255 + 1 + _QLZ_LAST_LITERALS) return 0;
+                if (len >= 15) { *token += 15; op = _qlz_put_len(op, len - 15); }
+                else *token += (unsigned char)len;
+                anchor = ip;
+                if (ip > mflimit) goto last_literals;
+                table[_qlz_hash(ip - 2)] = (uint32_t)(ip - 2 - base);
+                // A match right away continues with an empty literal run.
+                {
+                    uint32_t h = _qlz_hash(ip);
+                    match = base + table[h];
+                    table[h] = (uint32_t)(ip - base);
+                }
+                if (match + _QLZ_MAX_DIST < ip || _qlz_r32(match) != _qlz_r32(ip)) break;
+                if ((size_t)(oend - op) < 1 + 2 + 1 + _QLZ_LAST_LITERALS) return 0;   // Token, offset, then the tail.
+                token = op++;
+                *token = 0;
+            }
+            fwd_h = _qlz_hash(++ip);
+        }
+    }
+last_literals:
+    {
+        size_t lit = (size_t)(iend - anchor);
+        if ((size_t)(oend - op) < 1 + lit + (lit + 255 - 15) / 255) return 0;
+        if (lit >= 15) { *op++ = 15 << 4; op = _qlz_put_len(op, lit - 15); }
+        else *op++ = (unsigned char)(lit << 4);
+        memcpy(op, anchor, lit);
+        op += lit;
+    }
+    return (size_t)(op - (unsigned char*)dst);
+}
+
+// Decodes the block src[0..n) to out, which may follow earlier output starting
+// at low (matches can reach back into it). Returns bytes written, or QLZ_ERROR
+// on malformed input or if the output would pass oend.
+static inline size_t _qlz_decode(unsigned char* low, unsigned char* out, unsigned char* oend, const unsigned char* ip, size_t n) {
+    const unsigned char* iend = ip + n;
+    unsigned char* op = out;
+    if (n == 0) return QLZ_ERROR;
+    for (;;) {
+        if (ip >= iend) return QLZ_ERROR;   // A block must end with literals.
+        unsigned token = *ip++;
+        size_t lit = token >> 4, len;
+        const unsigned char* match;
+        size_t offset;
+        // Common case: short literal run and room to copy 16 bytes regardless.
+        if (lit < 15 && iend - ip >= 16 && oend - op >= 32) {
+            memcpy(op, ip, 16);
+            op += lit; ip += lit;
+            // Short match that does not overlap its copy: fixed-size moves, no loop.
+            len = token & 15;
+            offset = (size_t)ip[0] | (size_t)ip[1] << 8;
+            if (len < 15 && offset >= 8 && offset <= (size_t)(op - low)) {
+                match = op - offset;
+                memcpy(op, match, 8);
+                memcpy(op + 8, match + 8, 8);
+                memcpy(op + 16, match + 16, 2);
+                op += len + _QLZ_MINMATCH;
+                ip += 2;
+                continue;
+            }
+            op -= lit; ip -= lit;
+        } else {
+            if (lit == 15) {
+                unsigned s;
+                do {
+                    if (ip >= iend) return QLZ_ERROR;
+                    s = *ip++;
+                    lit += s;
+                } while (s == 255);
+            }
+            if (lit > (size_t)(iend - ip) || lit > (size_t)(oend - op)) return QLZ_ERROR;
+            if (iend - ip >= (ptrdiff_t)lit + 16 && oend - op >= (ptrdiff_t)lit + 16) {
+                unsigned char* d = op;
+                const unsigned char* s = ip;
+                do { memcpy(d, s, 16); d += 16; s += 16; } while (d < op + lit);
+            } else memmove(op, ip, lit);
+        }
+        op += lit; ip += lit;
+        if (ip == iend) break;   // The last sequence is literals only.
+        if (iend - ip < 2) return QLZ_ERROR;
+        offset = (size_t)ip[0] | (size_t)ip[1] << 8;
+        ip += 2;
+        if (offset == 0 || offset > (size_t)(op - low)) return QLZ_ERROR;
+        match = op - offset;
+        len = token & 15;
+        if (len == 15) {
+            unsigned s;
+            do {
+                if (ip >= iend) return QLZ_ERROR;
+                s = *ip++;
+                len += s;
+            } while (s == 255);
+        }
+        len += _QLZ_MINMATCH;
+        if (len > (size_t)(oend - op)) return QLZ_ERROR;
+        if (offset >= 16 && (size_t)(oend - op) >= len + 16) {
+            unsigned char* d = op;
+            do { memcpy(d, match, 16); d += 16; match += 16; } while (d < op + len);
+        } else if (offset >= 8 && (size_t)(oend - op) >= len + 8) {
+            unsigned char* d = op;
+            do { memcpy(d, match, 8); d += 8; match += 8; } while (d < op + len);
+        } else {
+            // Overlapping: the copied span doubles each step, since what was
+            // just written repeats the pattern.
+            size_t done = 0;
+            while (done < len) {
+                size_t c = offset + done < len - done ? offset + done : len - done;
+                memcpy(op + done, match, c);
+                done += c;
+            }
+        }
+        op += len;
+    }
+    return (size_t)(op - out);
+}
+
+// Decodes one LZ4 block into dst. Returns its size, or QLZ_ERROR if the block is
+// malformed or would not fit in cap bytes. Never reads or writes out of bounds.
+static inline size_t qlz_decompress(void* dst, size_t cap, const void* src, size_t n) {
+    return _qlz_decode((unsigned char*)dst, (unsigned char*)dst, (unsigned char*)dst + cap, (const unsigned char*)src, n);
+}
+
+/* --- LZ4 Frames --- */
+// Magic, descriptor (flags, block size, optional content size), header checksum,
+// then blocks of up to QLZ_BLOCK bytes (compressed, or stored when that is
+// smaller), an end mark and an XXH32 of the content. Frames can be concatenated,
+// e.g. by fs_append_compressed; readers decode them back to back.
+
+#define _QLZ_F_INDEP 0x20
+#define _QLZ_F_BLOCK_SUM 0x10
+#define _QLZ_F_SIZE 0x08
+#define _QLZ_F_SUM 0x04
+#define _QLZ_F_DICT 0x01
+
+typedef struct { int flags; size_t block_max; uint64_t content_size; size_t len; } _qlz_frame;
+
+// Writes a frame header; content_size 0 leaves the size out.
+static inline size_t _qlz_put_header(unsigned char* p, uint64_t content_size) {
+    size_t n = 6;
+    _qlz_put32(p, _QLZ_MAGIC);
+    p[4] = 0x40 | _QLZ_F_INDEP | _QLZ_F_SUM | (content_size ? _QLZ_F_SIZE : 0);
+    p[5] = 4 << 4;   // 64 KB blocks.
+    if (content_size) {
+        _qlz_put32(p + 6, (uint32_t)content_size);
+        _qlz_put32(p + 10, (uint32_t)(content_size >> 32));
+        n += 8;
+    }
+    p[n] = (unsigned char)(_qlz_xxh32(p + 4, n - 4) >> 8);
+    return n + 1;
+}
+
+// Parses a frame header. Returns its length, 0 if more bytes are needed, or QLZ_ERROR.
+static inline size_t _qlz_get_header(const unsigned char* p, size_t n, _qlz_frame* f) {
+    size_t len = 7;
+    if (n < 7) return 0;
+    if (_qlz_le32(p) != _QLZ_MAGIC) return QLZ_ERROR;
+    f->flags = p[4];
+    if ((f->flags & 0xC2) != 0x40 || (p[5] & 0x8F) || (p[5] >> 4) < 4) return QLZ_ERROR;
+    if (f->flags & _QLZ_F_DICT) return QLZ_ERROR;   // Dictionaries are not supported.
+    f->block_max = (size_t)1 << (8 + 2 * (p[5] >> 4));
+    len += f->flags & _QLZ_F_SIZE ? 8 : 0;
+    if (n < len) return 0;
+    f->content_size = 0;
+    if (f->flags & _QLZ_F_SIZE) f->content_size = _qlz_le32(p + 6) | (uint64_t)_qlz_le32(p + 10) << 32;
+    if (p[len - 1] != (unsigned char)(_qlz_xxh32(p + 4, len - 5) >> 8)) return QLZ_ERROR;
+    f->len = len;
+    return len;
+}
+
+// Writes one block of 1..QLZ_BLOCK bytes: compressed if that saves space.
+static inline size_t _qlz_put_block(unsigned char* p, const unsigned char* src, size_t n) {
+    size_t c = qlz_compress(p + 4, n - 1, src, n);
+    if (c) { _qlz_put32(p, (uint32_t)c); return c + 4; }
+    _qlz_put32(p, (uint32_t)n | 0x80000000u);
+    memcpy(p + 4, src, n);
+    return n + 4;
+}
+
+// Room needed by qlz_frame_compress.
+static inline size_t qlz_frame_bound(size_t n) { return n + 4 * (n / QLZ_BLOCK + 1) + 23; }
+
+// Compresses src[0..n) into one frame that records the content size. Returns
+// its size, or 0 if cap is below qlz_frame_bound(n).
+static inline size_t qlz_frame_compress(void* dst, size_t cap, const void* src, size_t n) {
+    unsigned char* op = (unsigned char*)dst;
+    const unsigned char* p = (const unsigned char*)src;
+    if (cap < qlz_frame_bound(n)) return 0;
+    op += _qlz_put_header(op, n);
+    for (size_t at = 0; at < n; at += QLZ_BLOCK)
+        op += _qlz_put_block(op, p + at, n - at < QLZ_BLOCK ? n - at : QLZ_BLOCK);
+    _qlz_put32(op, 0);
+    _qlz_put32(op + 4, _qlz_xxh32(src, n));
+    return (size_t)(op + 8 - (unsigned char*)dst);
+}
+
+// Total decoded size of the frames in src[0..n) if every nonempty one records
+// it, else QLZ_ERROR. Walks block headers only.
+static inline size_t qlz_frame_content_size(const void* src, size_t n) {
+    const unsigned char* p = (const unsigned char*)src;
+    const unsigned char* end = p + n;
+    uint64_t total = 0;
+    while (p < end) {
+        _qlz_frame f;
+        if (end - p >= 8 && (_qlz_le32(p) & 0xFFFFFFF0u) == _QLZ_SKIP_MAGIC) {
+            uint32_t skip = _qlz_le32(p + 4);
+            if ((size_t)(end - p - 8) < skip) return QLZ_ERROR;
+            p += 8 + skip;
+            continue;
+        }
+        size_t h = _qlz_get_header(p, (size_t)(end - p), &f);
+        if (h == 0 || h == QLZ_ERROR) return QLZ_ERROR;
+        p += h;
+        for (;;) {
+            uint32_t b;
+            if (end - p < 4) return QLZ_ERROR;
+            b = _qlz_le32(p) & 0x7FFFFFFFu;
+            p += 4;
+            if (!b) break;
+            if (!(f.flags & _QLZ_F_SIZE)) return QLZ_ERROR;   // Only an empty frame may leave it out.
+            b += f.flags & _QLZ_F_BLOCK_SUM ? 4 : 0;
+            if ((size_t)(end - p) < b) return QLZ_ERROR;
+            p += b;
+        }
+        p += f.flags & _QLZ_F_SUM ? 4 : 0;
+        if (p > end) return QLZ_ERROR;
+        total += f.content_size;
+    }
+    return total > (uint64_t)(QLZ_ERROR - 1) ? QLZ_ERROR : (size_t)total;
+}
+
+// Decodes every frame in src[0..n) into dst. Returns the decoded size, or
+// QLZ_ERROR if the input is malformed, fails a checksum or exceeds cap.
+static inline size_t qlz_frame_decompress(void* dst, size_t cap, const void* src, size_t n) {
+    const unsigned char* p = (const unsigned char*)src;
+    const unsigned char* end = p + n;
+    unsigned char* out = (unsigned char*)dst;
+    unsigned char* oend = out + cap;
+    unsigned char* op = out;
+    while (p < end) {
+        _qlz_frame f;
+        unsigned char* frame_start = op;
+        if (end - p >= 8 && (_qlz_le32(p) & 0xFFFFFFF0u) == _QLZ_SKIP_MAGIC) {
+            uint32_t skip = _qlz_le32(p + 4);
+            if ((size_t)(end - p - 8) < skip) return QLZ_ERROR;
+            p += 8 + skip;
+            continue;
+        }
+        size_t h = _qlz_get_header(p, (size_t)(end - p), &f);
+        _qlz_xxh xxh;
+        if (h == 0 || h == QLZ_ERROR) return QLZ_ERROR;
+        p += h;
+        _qlz_xxh_init(&xxh);
+        for (;;) {
+            uint32_t raw, b;
+            size_t got;
+            if (end - p < 4) return QLZ_ERROR;
+            raw = _qlz_le32(p);
+            b = raw & 0x7FFFFFFFu;
+            p += 4;
+            if (!b) break;
+            if (b > f.block_max || (size_t)(end - p) < b + (f.flags & _QLZ_F_BLOCK_SUM ? 4 : 0)) return QLZ_ERROR;
+            if ((f.flags & _QLZ_F_BLOCK_SUM) && _qlz_le32(p + b) != _qlz_xxh32(p, b)) return QLZ_ERROR;
+            if (raw & 0x80000000u) {
+                if (b > (size_t)(oend - op)) return QLZ_ERROR;
+                memcpy(op, p, b);
+                got = b;
+            } else {
+                unsigned char* lim = (size_t)(oend - op) > f.block_max ? op + f.block_max : oend;
+                got = _qlz_decode(f.flags & _QLZ_F_INDEP ? op : frame_start, op, lim, p, b);
+                if (got == QLZ_ERROR) return QLZ_ERROR;
+            }
+            // Checksum each block while it is still in cache.
+            if (f.flags & _QLZ_F_SUM) _qlz_xxh_update(&xxh, op, got);
+            op += got;
+            p += b + (f.flags & _QLZ_F_BLOCK_SUM ? 4 : 0);
+        }
+        if ((f.flags & _QLZ_F_SIZE) && (uint64_t)(op - frame_start) != f.content_size) return QLZ_ERROR;
+        if (f.flags & _QLZ_F_SUM) {
+            if (end - p < 4 || _qlz_le32(p) != _qlz_xxh_digest(&xxh)) return QLZ_ERROR;
+            p += 4;
+        }
+    }
+    return (size_t)(op - out);
+}
+
+// Streaming encoder: input of any chunk sizes is cut into QLZ_BLOCK blocks.
+typedef struct {
+    unsigned char buf[QLZ_BLOCK];
+    size_t len;
+    int started;
+    uint64_t content_size, total;
+    _qlz_xxh xxh;
+} qlz_enc;
+
+// content_size is written to the header when nonzero; the input must then add up to it.
+static inline void qlz_enc_init(qlz_enc* e, uint64_t content_size) {
+    e->len = 0;
+    e->started = 0;
+    e->content_size = content_size;
+    e->total = 0;
+    _qlz_xxh_init(&e->xxh);
+}
+
+// Room qlz_enc_update needs for n input bytes; qlz_enc_bound(0) suffices for qlz_enc_final.
+static inline size_t qlz_enc_bound(size_t n) { return (n / QLZ_BLOCK + 1) * (QLZ_BLOCK + 4) + 23; }
+
+// Returns bytes written to dst: the header on the first call, then each block completed.
+static inline size_t qlz_enc_update(qlz_enc* e, void* dst, const void* src, size_t n) {
+    unsigned char* op = (unsigned char*)dst;
+    const unsigned char* p = (const unsigned char*)src;
+    if (!e->started) { op += _qlz_put_header(op, e->content_size); e->started = 1; }
+    _qlz_xxh_update(&e->xxh, p, n);
+    e->total += n;
+    if (e->len) {
+        size_t fill = QLZ_BLOCK - e->len < n ? QLZ_BLOCK - e->len : n;
+        memcpy(e->buf + e->len, p, fill);
+        e->len += fill; p += fill; n -= fill;
+        if (e->len < QLZ_BLOCK) return (size_t)(op - (unsigned char*)dst);
+        op += _qlz_put_block(op, e->buf, QLZ_BLOCK);
+        e->len = 0;
+    }
+    for (; n >= QLZ_BLOCK; p += QLZ_BLOCK, n -= QLZ_BLOCK) op += _qlz_put_block(op, p, QLZ_BLOCK);
+    memcpy(e->buf, p, n);
+    e->len = n;
+    return (size_t)(op - (unsigned char*)dst);
+}
+
+// Flushes the last block and ends the frame. Returns bytes written, or
+// QLZ_ERROR if a declared content size was not met.
+static inline size_t qlz_enc_final(qlz_enc* e, void* dst) {
+    unsigned char* op = (unsigned char*)dst;
+    if (e->content_size && e->total != e->content_size) return QLZ_ERROR;
+    if (!e->started) { op += _qlz_put_header(op, e->content_size); e->started = 1; }
+    if (e->len) op += _qlz_put_block(op, e->buf, e->len);
+    e->len = 0;
+    _qlz_put32(op, 0);
+    _qlz_put32(op + 4, _qlz_xxh_digest(&e->xxh));
+    return (size_t)(op + 8 - (unsigned char*)dst);
+}
+
+// Streaming decoder for frames in any chunk sizes, including lz4's linked
+// blocks and block checksums. Buffers come from QOL_MALLOC; see qlz_dec_free.
+typedef struct {
+    int stage;
+    _qlz_frame f;
+    unsigned char hdr[19];
+    size_t have, need;
+    uint32_t block;                  // Current block header.
+    unsigned char* in;               // Block being gathered.
+    unsigned char* out;              // 64 KB history (linked blocks), then the decoded block.
+    size_t in_cap, out_cap, out_pos, out_end;
+    uint64_t produced, skip;
+    _qlz_xxh xxh;
+} qlz_dec;
+
+enum { _QLZ_MAGIC_S, _QLZ_HEADER_S, _QLZ_BLOCK_S, _QLZ_DATA_S, _QLZ_SUM_S, _QLZ_SKIP_LEN_S, _QLZ_SKIP_S, _QLZ_END_S };
+
+static inline void qlz_dec_init(qlz_dec* d) {
+    memset(d, 0, sizeof(*d));
+    d->need = 4;
+}
+
+static inline void qlz_dec_free(qlz_dec* d) {
+    QOL_FREE(d->in);
+    QOL_FREE(d->out);
+    d->in = d->out = NULL;
+    d->in_cap = d->out_cap = 0;
+}
+
+// Moves up to *dst_n decoded bytes to dst and consumes up to *src_n bytes of
+// src; both are updated to the amounts used. Returns 1 at the end of a frame
+// (call again with the rest of the input for a following frame), 0 when it
+// needs more input or output room, and -1 on corrupt input.
+static inline int qlz_dec_update(qlz_dec* d, void* dst, size_t* dst_n, const void* src, size_t* src_n) {
+    const unsigned char* p = (const unsigned char*)src;
+    const unsigned char* end = p + *src_n;
+    unsigned char* op = (unsigned char*)dst;
+    unsigned char* oend = op + *dst_n;
+    int status = 0;
+    for (;;) {
+        // Hand out decoded bytes before decoding more.
+        if (d->out_pos < d->out_end) {
+            size_t c = d->out_end - d->out_pos < (size_t)(oend - op) ? d->out_end - d->out_pos : (size_t)(oend - op);
+            memcpy(op, d->out + d->out_pos, c);
+            op += c; d->out_pos += c;
+            if (d->out_pos < d->out_end) break;
+        }
+        if (d->stage == _QLZ_END_S) {
+            d->stage = _QLZ_MAGIC_S; d->need = 4; d->have = 0;
+            status = 1;
+            break;
+        }
+        if (d->stage == _QLZ_SKIP_S) {
+            size_t c = (uint64_t)(end - p) < d->skip ? (size_t)(end - p) : (size_t)d->skip;
+            p += c; d->skip -= c;
+            if (d->skip) break;
+            d->stage = _QLZ_END_S;
+            continue;
+        }
+        if (d->stage == _QLZ_DATA_S) {
+            size_t b = d->block & 0x7FFFFFFFu, total = b + (d->f.flags & _QLZ_F_BLOCK_SUM ? 4 : 0);
+            const unsigned char* blk;
+            size_t got, at;
+            // Whole independent block at hand and room for it: decode in place.
+            if (d->have == 0 && (size_t)(end - p) >= total && (d->f.flags & _QLZ_F_INDEP) &&
+                !(d->block & 0x80000000u) && (size_t)(oend - op) >= d->f.block_max) {
+                if ((d->f.flags & _QLZ_F_BLOCK_SUM) && _qlz_le32(p + b) != _qlz_xxh32(p, b)) return -1;
+                got = _qlz_decode(op, op, op + d->f.block_max, p, b);
+                if (got == QLZ_ERROR) return -1;
+                _qlz_xxh_update(&d->xxh, op, got);
+                d->produced += got;
+                op += got; p += total;
+                d->stage = _QLZ_BLOCK_S; d->need = 4; d->have = 0;
+                continue;
+            }
+            if (d->have == 0 && (size_t)(end - p) >= total) blk = p;
+            else {
+                size_t c = total - d->have < (size_t)(end - p) ? total - d->have : (size_t)(end - p);
+                memcpy(d->in + d->have, p, c);
+                d->have += c; p += c;
+                if (d->have < total) break;
+                blk = d->in;
+            }
+            if ((d->f.flags & _QLZ_F_BLOCK_SUM) && _qlz_le32(blk + b) != _qlz_xxh32(blk, b)) return -1;
+            // Linked blocks keep the last 64 KB of output in front as history.
+            at = 0;
+            if (!(d->f.flags & _QLZ_F_INDEP)) {
+                at = d->out_end;
+                if (at > 65536) { memmove(d->out, d->out + at - 65536, 65536); at = 65536; }
+            }
+            if (d->block & 0x80000000u) { memcpy(d->out + at, blk, b); got = b; }
+            else {
+                got = _qlz_decode(d->out, d->out + at, d->out + at + d->f.block_max, blk, b);
+                if (got == QLZ_ERROR) return -1;
+            }
+            _qlz_xxh_update(&d->xxh, d->out + at, got);
+            d->produced += got;
+            d->out_pos = at; d->out_end = at + got;
+            if (blk == p) p += total;
+            d->stage = _QLZ_BLOCK_S; d->need = 4; d->have = 0;
+            continue;
+        }
+        // Fixed-size fields gather into hdr.
+        {
+            size_t c = d->need - d->have < (size_t)(end - p) ? d->need - d->have : (size_t)(end - p);
+            memcpy(d->hdr + d->have, p, c);
+            d->have += c; p += c;
+            if (d->have < d->need) break;
+        }
+        if (d->stage == _QLZ_MAGIC_S) {
+            uint32_t m = _qlz_le32(d->hdr);
+            if ((m & 0xFFFFFFF0u) == _QLZ_SKIP_MAGIC) { d->stage = _QLZ_SKIP_LEN_S; d->need = 8; continue; }
+            if (m != _QLZ_MAGIC) return -1;
+            d->stage = _QLZ_HEADER_S; d->need = 7;
+        } else if (d->stage == _QLZ_SKIP_LEN_S) {
+            d->skip = _qlz_le32(d->hdr + 4);
+            d->stage = _QLZ_SKIP_S;
+        } else if (d->stage == _QLZ_HEADER_S) {
+            size_t h = _qlz_get_header(d->hdr, d->have, &d->f);
+            if (h == QLZ_ERROR) return -1;
+            if (h == 0) { d->need = 15; continue; }
+            {
+                size_t in_cap = d->f.block_max + 4;
+                size_t out_cap = d->f.block_max + (d->f.flags & _QLZ_F_INDEP ? 0 : 65536);
+                if (in_cap > d->in_cap || out_cap > d->out_cap) {
+                    qlz_dec_free(d);
+                    d->in = (unsigned char*)QOL_MALLOC(in_cap);
+                    d->out = (unsigned char*)QOL_MALLOC(out_cap);
+                    if (!d->in || !d->out) { qlz_dec_free(d); return -1; }
+                    d->in_cap = in_cap;
+                    d->out_cap = out_cap;
+                }
+            }
+            d->out_pos = d->out_end = 0;
+            d->produced = 0;
+            _qlz_xxh_init(&d->xxh);
+            d->stage = _QLZ_BLOCK_S; d->need = 4; d->have = 0;
+        } else if (d->stage == _QLZ_BLOCK_S) {
+            d->block = _qlz_le32(d->hdr);
+            d->have = 0;
+            if (d->block == 0) {
+                if (d->f.flags & _QLZ_F_SIZE && d->produced != d->f.content_size) return -1;
+                if (d->f.flags & _QLZ_F_SUM) { d->stage = _QLZ_SUM_S; d->need = 4; }
+                else d->stage = _QLZ_END_S;
+            } else {
+                if ((d->block & 0x7FFFFFFFu) > d->f.block_max) return -1;
+                d->stage = _QLZ_DATA_S;
+            }
+        } else if (d->stage == _QLZ_SUM_S) {
+            if (_qlz_le32(d->hdr) != _qlz_xxh_digest(&d->xxh)) return -1;
+            d->stage = _QLZ_END_S;
+        }
+    }
+    *dst_n = (size_t)(op - (unsigned char*)dst);
+    *src_n -= (size_t)(end - p);
+    return status;
+}
+
+static inline int _fs_put_frame(const char* filename, const char* mode, const void* data, size_t n) {
+    char clean_path[256]; strncpy(clean_path, filename, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
+    FILE* f = fopen(clean_path, mode);
+    if (!f) return 0;
+    qlz_enc* e = (qlz_enc*)QOL_MALLOC(sizeof(qlz_enc));
+    size_t cap = qlz_enc_bound(QLZ_BLOCK);
+    unsigned char* out = (unsigned char*)QOL_MALLOC(cap);
+    const unsigned char* p = (const unsigned char*)data;
+    int ok = e && out;
+    if (ok) {
+        qlz_enc_init(e, n);
+        // Whole blocks at a time keep memory flat however large data is.
+        for (size_t at = 0; ok && at < n; at += QLZ_BLOCK) {
+            size_t got = qlz_enc_update(e, out, p + at, n - at < QLZ_BLOCK ? n - at : QLZ_BLOCK);
+            ok = fwrite(out, 1, got, f) == got;
+        }
+        if (ok) {
+            size_t got = qlz_enc_final(e, out);
+            ok = fwrite(out, 1, got, f) == got;
+        }
+    }
+    QOL_FREE(out);
+    QOL_FREE(e);
+    if (fclose(f) != 0) ok = 0;
+    return ok;
+}
+
+// Writes data as an LZ4 frame, replacing the file. Returns 1 on success.
+static inline int fs_write_compressed(const char* filename, const void* data, size_t n) {
+    return _fs_put_frame(filename, "wb", data, n);
+}
+
+// Appends data as one more frame; fs_read_compressed returns all of them joined.
+static inline int fs_append_compressed(const char* filename, const void* data, size_t n) {
+    return _fs_put_frame(filename, "ab", data, n);
+}
+
+// Reads a file of LZ4 frames (ours or lz4's). Returns the decoded bytes plus a
+// trailing NUL, to be freed by the caller, and stores the length in *out_len if
+// given. NULL if the file is missing or corrupt.
+static inline char* fs_read_compressed(const char* filename, size_t* out_len) {
+    char clean_path[256]; strncpy(clean_path, filename, 255); clean_path[255] = '\0'; _fs_normalize(clean_path);
+    FILE* f = fopen(clean_path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    unsigned char* src = size >= 0 ? (unsigned char*)QOL_MALLOC((size_t)size + 1) : NULL;
+    if (!src || fread(src, 1, (size_t)size, f) != (size_t)size) { QOL_FREE(src); fclose(f); return NULL; }
+    fclose(f);
+    char* out = NULL;
+    size_t len = qlz_frame_content_size(src, (size_t)size);
+    if (len != QLZ_ERROR) {
+        // Every frame records its size: decode in one pass straight into the result.
+        out = (char*)QOL_MALLOC(len + 1);
+        if (out && qlz_frame_decompress(out, len, src, (size_t)size) != len) { QOL_FREE(out); out = NULL; }
+    } else {
+        // Otherwise stream, doubling the output as needed.
+        qlz_dec d;
+        size_t cap = (size_t)size * 3 + 256, in_at = 0;
+        int status = 1;
+        qlz_dec_init(&d);
+        out = (char*)QOL_MALLOC(cap + 1);
+        len = 0;
+        while (out) {
+            size_t dst_n = cap - len, src_n = (size_t)size - in_at;
+            status = qlz_dec_update(&d, out + len, &dst_n, src + in_at, &src_n);
+            len += dst_n; in_at += src_n;
+            if (status < 0) break;
+            if (in_at == (size_t)size && (status == 1 || (dst_n == 0 && src_n == 0))) break;
+            if (len == cap) {
+                char* grown = (char*)QOL_REALLOC(out, cap * 2 + 1);
+                if (!grown) { QOL_FREE(out); out = NULL; break; }
+                out = grown;
+                cap *= 2;
+            }
+        }
+        // Input that ends mid-frame is truncated.
+        if (out && (status != 1 || in_at != (size_t)size)) { QOL_FREE(out); out = NULL; }
+        qlz_dec_free(&d);
+    }
+    QOL_FREE(src);
+    if (!out) return NULL;
+    out[len] = 0;
+    if (out_len) *out_len = len;
+    return out;
+}
+
 #endif
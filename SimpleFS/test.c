@@ -37,7 +37,86 @@ int main() {
         printf("Error: Could not list directory.\n");
     }
 
-    // 3. Cleanup
+    // 3. Hashing: one-shot, streamed, and straight from the file
+    const char* notes = "Some text notes";
+    uint64_t file_hash = 0;
+    qol_hasher hasher;
+    qhash_init(&hasher, 0);
+    qhash_update(&hasher, notes, 5);
+    qhash_update(&hasher, notes + 5, strlen(notes) - 5);
+    fs_hash(file1, 0, &file_hash);
+    qol_hash128 wide = qhash128(notes, strlen(notes), 0);
+    printf("\nchar_to_int:  %08x\n", (unsigned)char_to_int(notes, (int)strlen(notes)));
+    printf("qhash64:      %016llx\n", (unsigned long long)qhash64(notes, strlen(notes), 0));
+    printf("streamed:     %016llx\n", (unsigned long long)qhash_digest64(&hasher));
+    printf("fs_hash:      %016llx\n", (unsigned long long)file_hash);
+    printf("seed 42:      %016llx\n", (unsigned long long)qhash64(notes, strlen(notes), 42));
+    printf("qhash128:     %016llx%016llx\n", (unsigned long long)wide.hi, (unsigned long long)wide.lo);
+
+    // A multi-KB input reaches the stripe loop and the SIMD kernels: the one-shot
+    // hash, uneven streamed chunks and every dispatch level must all agree.
+    enum { BIG = 9001 };
+    static unsigned char big[BIG];
+    uint32_t lcg = 12345;
+    for (int i = 0; i < BIG; i++) { lcg = lcg * 1103515245u + 12345u; big[i] = (unsigned char)(lcg >> 24); }
+    const size_t chunks[] = { 1, 63, 255, 1000, 4097 };
+    uint64_t want = qhash64(big, BIG, 7);
+    for (int lvl = qhash_simd_level(); lvl >= 0; lvl--) {
+        qhash_simd_limit(lvl);
+        uint64_t one_shot = qhash64(big, BIG, 7);
+        qhash_init(&hasher, 7);
+        size_t off = 0;
+        for (int c = 0; off < BIG; c = (c + 1) % 5) {
+            size_t len = BIG - off < chunks[c] ? BIG - off : chunks[c];
+            qhash_update(&hasher, big + off, len);
+            off += len;
+        }
+        uint64_t streamed = qhash_digest64(&hasher);
+        printf("%d bytes, SIMD level %d: %016llx (streamed: %s, top level: %s)\n", BIG, lvl, (unsigned long long)one_shot,
+               streamed == one_shot ? "match" : "MISMATCH", one_shot == want ? "match" : "MISMATCH");
+    }
+
+    // 4. Compression: a block round trip, then a compressed log with two frames
+    char text[2048] = "";
+    for (int i = 0; i < 40; i++) strcat(text, "GET /index.html 200 OK\n");
+    size_t text_len = strlen(text);
+    unsigned char packed[2200];
+    char unpacked[2048];
+    size_t packed_len = qlz_compress(packed, sizeof(packed), text, text_len);
+    size_t unpacked_len = qlz_decompress(unpacked, sizeof(unpacked), packed, packed_len);
+    printf("\nqlz block:    %zu -> %zu bytes, round trip %s\n", text_len, packed_len,
+        unpacked_len == text_len && memcmp(unpacked, text, text_len) == 0 ? "ok" : "FAILED");
+    const char* log_file = "test_data/access.log.lz4";
+    fs_write_compressed(log_file, text, text_len);
+    fs_append_compressed(log_file, "POST /login 302\n", 16);
+    size_t log_len = 0;
+    char* log = fs_read_compressed(log_file, &log_len);
+    printf("qlz file:     %ld bytes on disk, %zu read back, %s\n", fs_size(log_file), log_len,
+        log && log_len == text_len + 16 && strncmp(log, text, text_len) == 0 ? "ok" : "FAILED");
+    free(log);
+
+    // Tight output buffers: every cap below the bound either fits or returns 0,
+    // never writing past cap (long zero runs need many match-length bytes).
+    size_t big_n = 1 << 20;
+    unsigned char* zeros = (unsigned char*)calloc(big_n, 1);
+    unsigned char* full = (unsigned char*)malloc(qlz_compress_bound(big_n));
+    unsigned char* back = (unsigned char*)malloc(big_n);
+    size_t full_len = qlz_compress(full, qlz_compress_bound(big_n), zeros, big_n);
+    int caps_ok = full_len > 0;
+    for (size_t cap = 0; cap <= full_len + 16; cap += cap + 320 < full_len ? 97 : 1) {
+        unsigned char* tight = (unsigned char*)malloc(cap + 1);
+        size_t got = qlz_compress(tight, cap, zeros, big_n);
+        if (got ? got > cap || qlz_decompress(back, big_n, tight, got) != big_n : cap >= full_len) caps_ok = 0;
+        free(tight);
+    }
+    // A block that ends right after a match is malformed, not a reason to read on.
+    unsigned char* cut = (unsigned char*)malloc(4);
+    memcpy(cut, "\x10" "A" "\x01\x00", 4);
+    printf("qlz bounds:   cap sweep %s, truncated block %s\n", caps_ok ? "ok" : "FAILED",
+        qlz_decompress(back, 64, cut, 4) == QLZ_ERROR ? "rejected" : "ACCEPTED");
+    free(zeros); free(full); free(back); free(cut);
+
+    // 5. Cleanup
     printf("\nCleaning up everything...\n");
     if (fs_dirremove(test_dir)) {
         printf("Success: Directory tree removed.\n");
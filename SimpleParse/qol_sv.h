@@ -0,0 +1,10 @@
+#ifndef QOL_SV_H
+#define QOL_SV_H
+
+#include <stddef.h>
+
+// A non-owning slice: ptr need not be NUL-terminated and nothing is freed.
+// Shared by simple_parse.h and simple_tools.h (which has the sv_ functions).
+typedef struct { const char* ptr; size_t len; } qol_sv;
+
+#endif
@@ -16,13 +16,29 @@ typedef struct {
     void* conparsed[64];
 } Parsed;
 
+#ifndef QOL_H   // QOL.h carries qol_sv.h already.
+    #include "qol_sv.h"
+#endif
+
+/* --- Allocation Hooks --- */
+// libc defaults; QOL_MALLOC / QOL_REALLOC / QOL_FREE and QOL_USE_ALLOC are
+// documented in simple_types.h, which must come first to route through qol_malloc.
+#if defined(QOL_USE_ALLOC) && !defined(QOL_MALLOC)
+    #error "QOL_USE_ALLOC: include simple_types.h before this header (qol_malloc lives there)"
+#endif
+#ifndef QOL_MALLOC
+    #define QOL_MALLOC(n) malloc(n)
+    #define QOL_REALLOC(p, n) realloc(p, n)
+    #define QOL_FREE(p) free(p)
+#endif
+
 /* --- Memory Cleanup --- */
 
 static inline void freeconparsed(Parsed* p) {
     if (!p) return;
     for (int i = 0; i < 64; i++) {
         if (p->conparsed[i] != NULL) {
-            free(p->conparsed[i]);
+            QOL_FREE(p->conparsed[i]);
             p->conparsed[i] = NULL;
         }
     }
@@ -67,9 +83,12 @@ static inline void _sp_tokenize_content(Parsed* p) {
         if (*token == '"') {
             char* end = strrchr(token, '"');
             if (end) *end = '\0';
-            p->conparsed[i] = strdup(token + 1);
+            size_t n = strlen(token + 1) + 1;
+            char* str = (char*)QOL_MALLOC(n);
+            if (str) memcpy(str, token + 1, n);
+            p->conparsed[i] = str;
         } else {
-            int* val = malloc(sizeof(int));
+            int* val = (int*)QOL_MALLOC(sizeof(int));
             *val = atoi(token);
             p->conparsed[i] = val;
         }
@@ -193,4 +212,78 @@ static inline Parsed parselinecon(const char* haystack, int line_num, const char
     return p;
 }
 
+/* --- View Logic --- */
+
+// These read an explicit-length buffer and return slices of it: no copies,
+// no allocations, no 256-byte limits. A view with ptr == NULL means not found.
+
+static inline const char* _sp_find(const char* hay, size_t n, const char* needle, size_t nlen) {
+    if (!nlen) return hay;
+    while (n >= nlen) {
+        const char* p = (const char*)memchr(hay, needle[0], n - nlen + 1);
+        if (!p) return NULL;
+        if (memcmp(p, needle, nlen) == 0) return p;
+        n -= (size_t)(p + 1 - hay);
+        hay = p + 1;
+    }
+    return NULL;
+}
+
+// Line line_num (1-based) of text, without its "\n" or "\r\n". An empty view has no lines.
+static inline qol_sv parseline_sv(qol_sv text, int line_num) {
+    qol_sv out = { NULL, 0 };
+    if (!text.ptr || !text.len) return out;
+    const char *p = text.ptr, *end = text.ptr + text.len;
+    for (int line = 1; line < line_num; line++) {
+        p = (const char*)memchr(p, '\n', (size_t)(end - p));
+        if (!p) return out;
+        p++;
+    }
+    const char* eol = (const char*)memchr(p, '\n', (size_t)(end - p));
+    if (!eol) eol = end;
+    if (eol > p && eol[-1] == '\r') eol--;
+    out.ptr = p; out.len = (size_t)(eol - p);
+    return out;
+}
+
+// The content between the two halves of a "prefix%%suffix" pattern, like parsecon's .con.
+static inline qol_sv parsecon_sv(qol_sv text, const char* pattern) {
+    qol_sv out = { NULL, 0 };
+    const char* split = strstr(pattern, "%%");
+    if (!split || !text.ptr || !text.len) return out;
+    const char* suffix = split + 2;
+    size_t plen = (size_t)(split - pattern), slen = strlen(suffix);
+    const char* start = _sp_find(text.ptr, text.len, pattern, plen);
+    if (!start) return out;
+    const char* val = start + plen;
+    const char* stop = _sp_find(val, (size_t)(text.ptr + text.len - val), suffix, slen);
+    if (!stop) return out;
+    out.ptr = val; out.len = (size_t)(stop - val);
+    return out;
+}
+
+// Splits an argument list like parsecon's .con on commas outside quotes. Spaces
+// around each argument are dropped and quoted arguments lose their quotes.
+// Returns the number of arguments found (at most max are stored).
+static inline int parseargs_sv(qol_sv con, qol_sv* args, int max) {
+    const char *p = con.ptr, *end = con.ptr + con.len;
+    int n = 0;
+    if (!p) return 0;
+    while (p <= end) {
+        const char* q = p;
+        int quoted = 0;
+        while (q < end && (quoted || *q != ',')) { if (*q == '"') quoted = !quoted; q++; }
+        const char *a = p, *b = q;
+        while (a < b && (*a == ' ' || *a == '\t')) a++;
+        while (b > a && (b[-1] == ' ' || b[-1] == '\t')) b--;
+        if (b - a >= 2 && *a == '"' && b[-1] == '"') { a++; b--; }
+        if (a < b || q < end || n > 0) {
+            if (n < max) { args[n].ptr = a; args[n].len = (size_t)(b - a); }
+            n++;
+        }
+        p = q + 1;
+    }
+    return n;
+}
+
 #endif
@@ -55,5 +55,18 @@ int main() {
     int theint = *(int *)coolio.conparsed[0];
     char *awesomestr = (char *)coolio.conparsed[1];
     printf("Arg1: %d\nArg2: %s\n", theint, awesomestr);
+    freeconparsed(&coolio);
+
+    // 9. View variants: slices of the script, no copies
+    qol_sv text = { script, strlen(script) };
+    qol_sv line = parseline_sv(text, 4);
+    qol_sv con = parsecon_sv(line, "something(%%);");
+    qol_sv args[8];
+    int n = parseargs_sv(con, args, 8);
+    printf("\n[view variants]\n  line: \"%.*s\"\n  con:  \"%.*s\"\n", (int)line.len, line.ptr, (int)con.len, con.ptr);
+    for (int i = 0; i < n && i < 8; i++) printf("  arg%d: \"%.*s\"\n", i + 1, (int)args[i].len, args[i].ptr);
+    qol_sv none = { NULL, 0 };
+    printf("  empty view: line %s, con %s\n", parseline_sv(none, 1).ptr ? "found" : "not found",
+           parsecon_sv(none, "something(%%);").ptr ? "found" : "not found");
     return 0;
 }
@@ -15,6 +15,18 @@
     typedef pthread_t native_t;
 #endif
 
+/* --- Allocation Hooks --- */
+// libc defaults; QOL_MALLOC / QOL_REALLOC / QOL_FREE and QOL_USE_ALLOC are
+// documented in simple_types.h, which must come first to route through qol_malloc.
+#if defined(QOL_USE_ALLOC) && !defined(QOL_MALLOC)
+    #error "QOL_USE_ALLOC: include simple_types.h before this header (qol_malloc lives there)"
+#endif
+#ifndef QOL_MALLOC
+    #define QOL_MALLOC(n) malloc(n)
+    #define QOL_REALLOC(p, n) realloc(p, n)
+    #define QOL_FREE(p) free(p)
+#endif
+
 #define MAX_THREADS 256
 static native_t _st_pool[MAX_THREADS] = {0};
 static void* _st_results[MAX_THREADS] = {0};
@@ -27,6 +39,8 @@ typedef struct {
     int arg_count; 
 } _st_pkt;
 
+// The spawn packet and its argument copy stay on the C heap: the caller's
+// allocator may be an arena or pool, and the worker thread frees them.
 static char* _st_strdup(const char* s) {
     if (!s) return NULL;
     size_t len = strlen(s) + 1;
@@ -55,7 +69,7 @@ static void* _st_entry(void* p) {
         if (pkt->arg_count == 0) r = ((int (*)())pkt->user_fn)();
         else if (pkt->arg_count == 1) r = ((int (*)(int))pkt->user_fn)(i[0]);
         else r = ((int (*)(int, int))pkt->user_fn)(i[0], i[1]);
-        int* b = malloc(sizeof(int)); *b = r; _st_results[pkt->id] = b;
+        int* b = QOL_MALLOC(sizeof(int)); *b = r; _st_results[pkt->id] = b;
     } else {
         void* r = NULL;
         if (pkt->arg_count == 0) r = ((void* (*)())pkt->user_fn)();
@@ -70,6 +84,7 @@ static void* _st_entry(void* p) {
 static inline void _st_spawn(void* fn, char* args, int id, int type, int count) {
     if (id < 0 || id >= MAX_THREADS) return;
     _st_pkt* p = malloc(sizeof(_st_pkt));
+    if (!p) return;
     p->user_fn = fn; p->args_str = _st_strdup(args);
     p->id = id; p->type = type; p->arg_count = count;
 #ifdef _WIN32
@@ -0,0 +1,782 @@
+#include <stdlib.h>
+#include <string.h>
+
+// Build: gcc -O2 bench.c -o bench
+
+// Allocations made by the library and by the legacy code below are counted, so
+// benchmarks can report allocations per operation.
+static size_t bench_allocs = 0;
+static void* bench_malloc(size_t n) { bench_allocs++; return malloc(n); }
+static void* bench_calloc(size_t c, size_t n) { bench_allocs++; return calloc(c, n); }
+static void* bench_realloc(void* p, size_t n) { bench_allocs++; return realloc(p, n); }
+static char* bench_strdup(const char* s) { bench_allocs++; return strdup(s); }
+#define malloc(n) bench_malloc(n)
+#define calloc(c, n) bench_calloc(c, n)
+#define realloc(p, n) bench_realloc(p, n)
+#define strdup(s) bench_strdup(s)
+
+#include "simple_tools.h"
+
+static double now_ms() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static unsigned rng_state = 0x9E3779B9;
+static unsigned rng() { rng_state ^= rng_state << 13; rng_state ^= rng_state >> 17; rng_state ^= rng_state << 5; return rng_state; }
+
+// Runs stmt until at least 200ms have passed and returns ms per call.
+#define TIME_MS(result, stmt) { \
+    int _reps = 0; double _t0 = now_ms(), _t1; \
+    do { stmt; _reps++; _t1 = now_ms(); } while (_t1 - _t0 < 200.0); \
+    result = (_t1 - _t0) / _reps; \
+}
+
+// The previous engine: repeated strstr into a src_len * 10 buffer.
+static char* legacy_replace(const char* src, const char* find, const char* replace, int start_idx, int end_idx) {
+    size_t find_len = strlen(find), replace_len = strlen(replace), src_len = strlen(src);
+    char* result = (char*)malloc(src_len * 10 + 1);
+    char* p_res = result;
+    const char* p_src = src;
+    int current_occurrence = 0;
+    while (*p_src) {
+        const char* pos = strstr(p_src, find);
+        if (pos) {
+            current_occurrence++;
+            int should_replace = (current_occurrence >= start_idx && current_occurrence <= end_idx);
+            size_t prefix_len = pos - p_src;
+            memcpy(p_res, p_src, prefix_len); p_res += prefix_len;
+            if (should_replace) { memcpy(p_res, replace, replace_len); p_res += replace_len; }
+            else { memcpy(p_res, find, find_len); p_res += find_len; }
+            p_src = pos + find_len;
+        } else { strcpy(p_res, p_src); break; }
+    }
+    return result;
+}
+
+// Words drawn from a small vocabulary; `every` controls how often the needle appears.
+static char* make_text(size_t size, const char* needle, int every) {
+    static const char* words[] = { "lorem", "ipsum", "dolor", "sit", "amet", "<div>", "class", "value", "\n" };
+    char* s = (char*)malloc(size + 64);
+    size_t len = 0;
+    while (len < size) {
+        const char* w = (rng() % every == 0) ? needle : words[rng() % 9];
+        size_t wl = strlen(w);
+        memcpy(s + len, w, wl); len += wl;
+        s[len++] = ' ';
+    }
+    s[len] = '\0';
+    return s;
+}
+
+static void bench_replace_case(const char* label, size_t size, const char* find, const char* replace, int every) {
+    char* text = make_text(size, find, every);
+    double mb = strlen(text) / 1e6, t_old, t_new, t_buf, t_sb;
+    TIME_MS(t_old, free(legacy_replace(text, find, replace, 1, 999999)));
+    TIME_MS(t_new, free(str_replace_all(text, find, replace)));
+    size_t need = str_replace_all_buf(NULL, 0, text, find, replace);
+    char* buf = (char*)malloc(need + 1);
+    TIME_MS(t_buf, str_replace_all_buf(buf, need + 1, text, find, replace));
+    qol_sb sb = {0};
+    TIME_MS(t_sb, { sb.len = 0; sb_replace_all(&sb, text, find, replace); });
+    printf("%-28s %9.0f %9.0f (%.1fx) %9.0f %9.0f\n", label, mb / t_old * 1e3, mb / t_new * 1e3, t_old / t_new, mb / t_buf * 1e3, mb / t_sb * 1e3);
+    free(buf); sb_free(&sb); free(text);
+}
+
+static void bench_replace() {
+    printf("[str_replace_all, MB/s of input, 8 MB text]\n");
+    printf("%-28s %9s %9s %6s %9s %9s\n", "case", "legacy", "new", "", "buf", "builder");
+    bench_replace_case("sparse 6-byte needle", 8 << 20, "needle", "pin", 1000);
+    bench_replace_case("dense 3-byte needle", 8 << 20, "%20", " ", 4);
+    bench_replace_case("expanding 1-byte needle", 8 << 20, "&", "&amp;", 8);
+    bench_replace_case("no matches", 8 << 20, "zebra!", "horse", 1 << 30);
+    printf("\n");
+}
+
+// n pairs applied with one replace call each (old and current engine) vs in a single pass.
+static void bench_replace_many_case(const char* label, const qol_repl* rules, int n, const char* text) {
+    double mb = strlen(text) / 1e6, t_legacy, t_chain, t_many, t_cached;
+    TIME_MS(t_legacy, {
+        char* cur = strdup(text);
+        for (int i = 0; i < n; i++) { char* nx = legacy_replace(cur, rules[i].find, rules[i].replace, 1, 999999); free(cur); cur = nx; }
+        free(cur);
+    });
+    TIME_MS(t_chain, {
+        char* cur = strdup(text);
+        for (int i = 0; i < n; i++) { char* nx = str_replace_all(cur, rules[i].find, rules[i].replace); free(cur); cur = nx; }
+        free(cur);
+    });
+    TIME_MS(t_many, free(str_replace_many(text, rules, n)));
+    qol_ac* ac = ac_build(rules, n);
+    TIME_MS(t_cached, free(ac_replace(ac, text)));
+    ac_free(ac);
+    printf("%-28s %9.0f %9.0f %9.0f (%.1fx) %9.0f (%.1fx)\n", label, mb / t_legacy * 1e3, mb / t_chain * 1e3,
+        mb / t_many * 1e3, t_chain / t_many, mb / t_cached * 1e3, t_chain / t_cached);
+}
+
+static void bench_replace_many() {
+    static const qol_repl markup[] = {
+        {"&", "&amp;"}, {"<", "&lt;"}, {">", "&gt;"}, {"\"", "&quot;"}, {"'", "&#39;"},
+        {"javascript:", ""}, {"onerror=", "data-x="}, {"onload=", "data-y="}, {"<script", "&lt;script"},
+        {"\r\n", "\n"}, {"\t", " "}, {"%00", ""}, {"%0a", ""}, {"%0d", ""}, {"../", ""},
+        {"eval(", "(("}, {"<iframe", "&lt;iframe"}, {"needle", "pin"},
+    };
+    static const qol_repl words[] = {
+        {"lorem", "LOREM"}, {"ipsum", "IPSUM"}, {"dolor", "DOLOR"}, {"amet", "AMET"},
+        {"class", "klass"}, {"value", "val"},
+    };
+    int nm = (int)(sizeof(markup) / sizeof(markup[0])), nw = (int)(sizeof(words) / sizeof(words[0]));
+    qol_repl all[64];
+    memcpy(all, markup, sizeof(markup));
+    memcpy(all + nm, words, sizeof(words));
+    char* text = make_text(8 << 20, "needle", 100);
+
+    printf("[multi-pattern replace, MB/s of input]\n");
+    printf("%-28s %9s %9s %9s %6s %9s\n", "case", "legacy", "chained", "many", "", "cached");
+    bench_replace_many_case("18 rules, ~1 match/50 B", markup, nm, text);
+    bench_replace_many_case("24 rules, ~1 match/7 B", all, nm + nw, text);
+    free(text);
+    // Small payloads are where reusing the automaton pays off.
+    text = make_text(1024, "needle", 100);
+    bench_replace_many_case("18 rules, 1 KB payload", markup, nm, text);
+    printf("\n");
+    free(text);
+}
+
+// The previous str_format / json_obj: a 64 KB block per call, and strcat appends.
+static char* legacy_format(const char* fmt, ...) {
+    char* res = (char*)malloc(MAX_HTTP_BUF);
+    va_list args; va_start(args, fmt);
+    vsprintf(res, fmt, args);
+    va_end(args);
+    return res;
+}
+
+static char* legacy_json_obj(const char* fmt, ...) {
+    char* res = (char*)malloc(8192);
+    strcpy(res, "{");
+    va_list args; va_start(args, fmt);
+    char* fmt_copy = strdup(fmt);
+    char* token = strtok(fmt_copy, ", ");
+    while (token) {
+        char type = token[0];
+        char* key = strchr(token, ':');
+        if (key) {
+            key++; strcat(res, "\""); strcat(res, key); strcat(res, "\":");
+            if (type == 's') { strcat(res, "\""); strcat(res, va_arg(args, char*)); strcat(res, "\""); }
+            else if (type == 'i') sprintf(res + strlen(res), "%d", va_arg(args, int));
+            else if (type == 'f') sprintf(res + strlen(res), "%.2f", va_arg(args, double));
+            else if (type == 'b') strcat(res, va_arg(args, int) ? "true" : "false");
+        }
+        token = strtok(NULL, ", ");
+        if (token) strcat(res, ", ");
+    }
+    strcat(res, "}");
+    free(fmt_copy); va_end(args);
+    return res;
+}
+
+#define JSON_ARGS "s:name, i:age, f:score, b:active, s:city, i:zip", "Ted", 21, 97.5, 1, "Springfield", 12345
+
+static void bench_format() {
+    double t_old, t_new;
+    printf("[formatting, ns per call]\n");
+    printf("%-28s %9s %9s\n", "case", "legacy", "new");
+    TIME_MS(t_old, free(legacy_format("User ID: %d, name: %s", 101, "ted")));
+    TIME_MS(t_new, free(str_format("User ID: %d, name: %s", 101, "ted")));
+    printf("%-28s %9.0f %9.0f (%.1fx)\n", "str_format, short", t_old * 1e6, t_new * 1e6, t_old / t_new);
+    TIME_MS(t_old, free(legacy_json_obj(JSON_ARGS)));
+    TIME_MS(t_new, free(json_obj(JSON_ARGS)));
+    printf("%-28s %9.0f %9.0f (%.1fx)\n", "json_obj, 6 fields", t_old * 1e6, t_new * 1e6, t_old / t_new);
+    qol_sb sb = {0};
+    TIME_MS(t_new, { sb_reset(&sb); sb_appendf(&sb, "User ID: %d, name: %s", 101, "ted"); });
+    printf("%-28s %9s %9.0f\n", "sb_appendf, reused builder", "-", t_new * 1e6);
+
+    // Many appends: strcat rescans the whole string each time.
+    char* big = (char*)malloc(1 << 20);
+    TIME_MS(t_old, { big[0] = '\0'; for (int i = 0; i < 4000; i++) strcat(big, "field, "); });
+    TIME_MS(t_new, { sb_reset(&sb); for (int i = 0; i < 4000; i++) sb_append_n(&sb, "field, ", 7); });
+    printf("%-28s %9.0f %9.0f (%.0fx)\n\n", "4000 appends (us)", t_old * 1e3, t_new * 1e3, t_old / t_new);
+    free(big); sb_free(&sb);
+}
+
+static void bench_json() {
+    double t_old, t_jw, t_sb;
+    char buf[512];
+    qol_sb sb = {0};
+    qol_jw jw;
+    printf("[JSON, ns per 6-field object]\n");
+    TIME_MS(t_old, free(legacy_json_obj(JSON_ARGS)));
+    TIME_MS(t_jw, {
+        jw_init(&jw, buf, sizeof(buf));
+        jw_begin_obj(&jw);
+        jw_key(&jw, "name"); jw_str(&jw, "Ted");
+        jw_key(&jw, "age"); jw_int(&jw, 21);
+        jw_key(&jw, "score"); jw_double(&jw, 97.5);
+        jw_key(&jw, "active"); jw_bool(&jw, 1);
+        jw_key(&jw, "city"); jw_str(&jw, "Springfield");
+        jw_key(&jw, "zip"); jw_int(&jw, 12345);
+        jw_end_obj(&jw);
+        jw_finish(&jw);
+    });
+    TIME_MS(t_sb, {
+        sb_reset(&sb); jw_init_sb(&jw, &sb);
+        jw_begin_obj(&jw);
+        jw_key(&jw, "name"); jw_str(&jw, "Ted");
+        jw_key(&jw, "age"); jw_int(&jw, 21);
+        jw_key(&jw, "score"); jw_double(&jw, 97.5);
+        jw_key(&jw, "active"); jw_bool(&jw, 1);
+        jw_key(&jw, "city"); jw_str(&jw, "Springfield");
+        jw_key(&jw, "zip"); jw_int(&jw, 12345);
+        jw_end_obj(&jw);
+        jw_finish(&jw);
+    });
+    printf("%-28s %9.0f\n", "json_obj (legacy)", t_old * 1e6);
+    printf("%-28s %9.0f (%.1fx)\n", "jw, caller buffer", t_jw * 1e6, t_old / t_jw);
+    printf("%-28s %9.0f (%.1fx)\n", "jw, reused builder", t_sb * 1e6, t_old / t_sb);
+
+    // Escaping throughput on a 1 MB string with a quote or newline every ~200 bytes.
+    size_t n = 1 << 20;
+    char* text = make_text(n, "say \"hi\"\n", 30);
+    n = strlen(text);
+    TIME_MS(t_jw, { sb_reset(&sb); jw_init_sb(&jw, &sb); jw_str_n(&jw, text, n); jw_finish(&jw); });
+    printf("%-28s %9.0f MB/s\n\n", "jw_str escaping", n / t_jw / 1e3);
+    free(text); sb_free(&sb);
+}
+
+// The previous ctype-based kernels.
+static void legacy_lower(char* s) { for (; *s; ++s) *s = tolower(*s); }
+static int legacy_is_numeric(const char* s) {
+    if (!s || *s == '\0') return 0;
+    while (*s) { if (!isdigit(*s)) return 0; s++; }
+    return 1;
+}
+static char* legacy_trim(char* s) {
+    char* end;
+    while (isspace((unsigned char)*s)) s++;
+    if (*s == 0) return s;
+    end = s + strlen(s) - 1;
+    while (end > s && isspace((unsigned char)*end)) end--;
+    end[1] = '\0';
+    return s;
+}
+
+// ns per call for the legacy loop and for each dispatch level. Short inputs run
+// 1000 calls per sample so the clock read does not dominate.
+#define ASCII_REPS(stmt) { for (int _k = 0; _k < reps; _k++) { stmt; } }
+
+static void bench_ascii_case(const char* label, const char* text) {
+    size_t n = strlen(text);
+    int reps = n < 1024 ? 1000 : 1;
+    char* buf = (char*)malloc(n + 1);
+    double t[4];
+    volatile int sink = 0;
+    printf("%-24s %7zu B", label, n);
+    memcpy(buf, text, n + 1);
+    if (!strncmp(label, "lower", 5)) {
+        TIME_MS(t[0], ASCII_REPS({ legacy_lower(buf); buf[0] = 'X'; }));
+        for (int lvl = 0; lvl <= 2; lvl++) { tools_simd_limit(lvl); TIME_MS(t[lvl + 1], ASCII_REPS({ str_lower_n(buf, n); buf[0] = 'X'; })); }
+    } else if (!strncmp(label, "numeric", 7)) {
+        TIME_MS(t[0], ASCII_REPS(sink += legacy_is_numeric(buf)));
+        for (int lvl = 0; lvl <= 2; lvl++) { tools_simd_limit(lvl); TIME_MS(t[lvl + 1], ASCII_REPS(sink += str_is_numeric_n(buf, n))); }
+    } else {
+        // Trim writes a NUL, so each call restores the last byte first.
+        TIME_MS(t[0], ASCII_REPS({ buf[n - 1] = ' '; sink += legacy_trim(buf)[0]; }));
+        for (int lvl = 0; lvl <= 2; lvl++) { tools_simd_limit(lvl); TIME_MS(t[lvl + 1], ASCII_REPS({ size_t len = n; sink += str_trim_n(buf, &len)[0]; })); }
+    }
+    (void)sink;
+    for (int i = 0; i < 4; i++) printf(" %9.1f", t[i] * 1e6 / reps);
+    printf("   %5.1f GB/s\n", n * reps / (t[3] * 1e6));
+    tools_simd_limit(2);
+    free(buf);
+}
+
+static void bench_ascii() {
+    size_t big = 64 << 10;
+    char* log = make_text(big, "Content-Type", 20);
+    char* digits = (char*)malloc(big + 1);
+    for (size_t i = 0; i < big; i++) digits[i] = (char)('0' + i % 10);
+    digits[big] = '\0';
+    char* padded = (char*)malloc(big + 1);
+    memset(padded, ' ', big);
+    memcpy(padded + big / 2, "value", 5);
+    padded[big] = '\0';
+
+    printf("[ASCII kernels, ns per call]\n");
+    printf("%-24s %9s %9s %9s %9s %9s\n", "case", "size", "legacy", "scalar", "sse/neon", "avx2");
+    bench_ascii_case("lower, header name", "Content-Type");
+    bench_ascii_case("lower, 64 KB log", log);
+    bench_ascii_case("numeric, 10 digits", "1234567890");
+    bench_ascii_case("numeric, 64 KB", digits);
+    bench_ascii_case("trim, short", "  value \t");
+    bench_ascii_case("trim, 64 KB padding", padded);
+    printf("\n");
+    free(log); free(digits); free(padded);
+}
+
+// The previous hexdmp: one printf per byte.
+static void legacy_hexdmp(FILE* f, void* ptr, int buflen) {
+    unsigned char* buf = (unsigned char*)ptr;
+    for (int i = 0; i < buflen; i++) {
+        fprintf(f, "%02x ", buf[i]);
+        if ((i + 1) % 16 == 0) fprintf(f, "\n");
+    }
+    fprintf(f, "\n");
+}
+
+static void bench_hexdump() {
+    size_t n = 64 << 10;
+    unsigned char* pkt = (unsigned char*)malloc(n);
+    for (size_t i = 0; i < n; i++) pkt[i] = (unsigned char)rng();
+    FILE* devnull = fopen("/dev/null", "w");
+    qol_sb sb = {0};
+    double t_old, t_file, t_sb;
+    if (!devnull) { free(pkt); return; }
+    TIME_MS(t_old, legacy_hexdmp(devnull, pkt, (int)n));
+    TIME_MS(t_file, hexdump_file(devnull, pkt, n, NULL));
+    TIME_MS(t_sb, { sb_reset(&sb); sb_hexdump(&sb, pkt, n, NULL); });
+    printf("[hexdump, 64 KB packet, us per dump]\n");
+    printf("%-28s %9.0f\n", "legacy (hex only)", t_old * 1e3);
+    printf("%-28s %9.0f (%.0fx)\n", "hexdump_file (+offset/ascii)", t_file * 1e3, t_old / t_file);
+    printf("%-28s %9.0f (%.0fx)\n\n", "sb_hexdump", t_sb * 1e3, t_old / t_sb);
+    fclose(devnull); sb_free(&sb); free(pkt);
+}
+
+// The previous decoder: strtol on a 3-byte temporary per escape.
+static char* legacy_url_decode(const char* src) {
+    char *res = (char*)malloc(strlen(src) + 1);
+    char *p = res;
+    while (*src) {
+        if (*src == '%' && isxdigit(src[1]) && isxdigit(src[2])) {
+            char hex[3] = { src[1], src[2], 0 };
+            *p++ = (char)strtol(hex, NULL, 16);
+            src += 3;
+        } else if (*src == '+') {
+            *p++ = ' '; src++;
+        } else {
+            *p++ = *src++;
+        }
+    }
+    *p = '\0';
+    return res;
+}
+
+// http_param-style lookup: one strstr over the raw query per key.
+static int legacy_param(const char* q, const char* key, char* v) {
+    char s[64]; sprintf(s, "%s=", key);
+    const char* st = strstr(q, s);
+    if (!st) return 0;
+    st += strlen(s);
+    const char* e = strpbrk(st, " &\r\n");
+    int len = e ? (int)(e - st) : (int)strlen(st);
+    if (len >= 256) len = 255;
+    memcpy(v, st, len); v[len] = 0;
+    return 1;
+}
+
+static void bench_url() {
+    // ~70% of the bytes are escapes: UTF-8 text and reserved characters.
+    static const char* chunk = "%E4%BD%A0%E5%A5%BD+%2F%3F%26=%20ab%25";
+    size_t n = 1 << 20;
+    char* raw = (char*)malloc(n + 64);
+    size_t len = 0, cl = strlen(chunk);
+    while (len < n) { memcpy(raw + len, chunk, cl); len += cl; }
+    raw[len] = '\0';
+    double t_old, t_new, t_inplace, t_enc;
+    TIME_MS(t_old, free(legacy_url_decode(raw)));
+    TIME_MS(t_new, free(str_url_decode(raw)));
+    char* work = (char*)malloc(len + 1);
+    TIME_MS(t_inplace, { memcpy(work, raw, len); url_decode_n(work, work, len); });
+    char* plain = str_url_decode(raw);
+    size_t plen = strlen(plain), elen = url_encode_n(NULL, 0, plain, plen, 0);
+    char* enc = (char*)malloc(elen + 1);
+    TIME_MS(t_enc, url_encode_n(enc, elen + 1, plain, plen, 0));
+
+    printf("[URL codec, MB/s of encoded text, 1 MB heavily escaped]\n");
+    printf("%-28s %9.0f\n", "legacy str_url_decode", len / t_old / 1e3);
+    printf("%-28s %9.0f (%.1fx)\n", "str_url_decode", len / t_new / 1e3, t_old / t_new);
+    printf("%-28s %9.0f (%.1fx)\n", "url_decode_n in place", len / t_inplace / 1e3, t_old / t_inplace);
+    printf("%-28s %9.0f\n", "url_encode_n", elen / t_enc / 1e3);
+
+    // 12-parameter query, every value read once.
+    static const char* keys[] = { "id", "user", "q", "lang", "page", "sort", "from", "to", "tz", "fmt", "ref", "token" };
+    const char* query = "id=123&user=t%C3%A9d&q=caf%C3%A9+au+lait&lang=fr&page=2&sort=-date&from=2024-01-01"
+                        "&to=2024-12-31&tz=Europe%2FParis&fmt=json&ref=https%3A%2F%2Fx.io%2F&token=abc%2B%2F%3D";
+    char qbuf[512], v[256];
+    qol_url_pair pairs[16];
+    volatile int sink = 0;
+    TIME_MS(t_old, { for (int k = 0; k < 12; k++) { char* d; legacy_param(query, keys[k], v); d = legacy_url_decode(v); sink += d[0]; free(d); } });
+    TIME_MS(t_new, { strcpy(qbuf, query); sink += url_query_parse(qbuf, pairs, 16); });
+    printf("%-28s %9.0f ns\n", "12 params: lookup + decode", t_old * 1e6);
+    printf("%-28s %9.0f ns (%.1fx)\n\n", "12 params: url_query_parse", t_new * 1e6, t_old / t_new);
+    (void)sink;
+    free(raw); free(work); free(plain); free(enc);
+}
+
+static void bench_intern() {
+    // 4096 header names / paths drawn from 2000 distinct strings, as a parser sees them.
+    enum { DISTINCT = 2000, TOKENS = 4096, ROUTES = 24 };
+    static char names[DISTINCT][40];
+    static const char* tokens[TOKENS];
+    static size_t lens[TOKENS];
+    static char* copies[TOKENS];
+    for (int i = 0; i < DISTINCT; i++) snprintf(names[i], sizeof(names[i]), "/api/v1/resource-%d/items", i * 7919 % 100000);
+    for (int i = 0; i < TOKENS; i++) { tokens[i] = names[rng() % DISTINCT]; lens[i] = strlen(tokens[i]); }
+
+    qol_intern pool;
+    intern_init(&pool);
+    volatile size_t sink = 0;
+    double t_old, t_new;
+    TIME_MS(t_old, { for (int i = 0; i < TOKENS; i++) copies[i] = strdup(tokens[i]); for (int i = 0; i < TOKENS; i++) free(copies[i]); });
+    TIME_MS(t_new, { for (int i = 0; i < TOKENS; i++) sink += (size_t)intern_n(&pool, tokens[i], lens[i]); });
+    printf("[interning, ns per string, %d strings from %d distinct]\n", TOKENS, DISTINCT);
+    printf("%-28s %9.1f\n", "strdup + free", t_old * 1e6 / TOKENS);
+    printf("%-28s %9.1f (%.1fx)\n", "intern_n", t_new * 1e6 / TOKENS, t_old / t_new);
+
+    // Route dispatch: strcmp against each route vs one lookup and pointer compares.
+    const char* routes[ROUTES];
+    for (int r = 0; r < ROUTES; r++) routes[r] = intern(&pool, names[r * 50]);
+    TIME_MS(t_old, { for (int i = 0; i < TOKENS; i++) for (int r = 0; r < ROUTES; r++) if (strcmp(tokens[i], names[r * 50]) == 0) { sink += r; break; } });
+    TIME_MS(t_new, { for (int i = 0; i < TOKENS; i++) { const char* p = intern_find_n(&pool, tokens[i], lens[i]); for (int r = 0; r < ROUTES; r++) if (p == routes[r]) { sink += r; break; } } });
+    printf("%-28s %9.1f\n", "24 routes: strcmp chain", t_old * 1e6 / TOKENS);
+    printf("%-28s %9.1f (%.1fx)\n\n", "24 routes: intern_find + ==", t_new * 1e6 / TOKENS, t_old / t_new);
+    (void)sink;
+    intern_free(&pool);
+}
+
+// Header-style lines parsed the way char* APIs force it: copy each line so it can
+// be NUL-terminated, then trim and compare in place.
+static size_t legacy_headers(const char* text) {
+    size_t hits = 0;
+    const char* p = text;
+    while (*p) {
+        const char* eol = strchr(p, '\n');
+        size_t n = eol ? (size_t)(eol - p) : strlen(p);
+        char* line = (char*)malloc(n + 1);
+        memcpy(line, p, n); line[n] = '\0';
+        char* colon = strchr(line, ':');
+        if (colon) {
+            *colon = '\0';
+            char *key = str_trim(line), *val = str_trim(colon + 1);
+            hits += str_starts(key, "X-") + str_ends(val, ".com") + str_contains(val, "gzip");
+        }
+        free(line);
+        p += n + (eol != NULL);
+    }
+    return hits;
+}
+
+static size_t view_headers(qol_sv text) {
+    size_t hits = 0;
+    qol_sv line, key, val;
+    while (sv_split_next(&text, SV("\n"), &line)) {
+        if (!sv_cut(line, SV(":"), &key, &val)) continue;
+        key = sv_trim(key); val = sv_trim(val);
+        hits += sv_starts(key, SV("X-")) + sv_ends(val, SV(".com")) + sv_contains(val, SV("gzip"));
+    }
+    return hits;
+}
+
+static size_t legacy_count(const char* s, const char* needle) {
+    size_t n = 0, nl = strlen(needle);
+    while ((s = strstr(s, needle))) { n++; s += nl; }
+    return n;
+}
+
+static void bench_views() {
+    static const char* names[] = { "Host", "X-Request-Id", "Accept-Encoding", "Content-Type", "X-Forwarded-For", "Referer" };
+    static const char* vals[] = { "api.example.com", "7f3a9c2e", "gzip, deflate, br", "application/json", "10.0.0.1", "https://example.com" };
+    size_t cap = 1 << 20, len = 0, lines = 0;
+    char* text = (char*)malloc(cap + 128);
+    while (len < cap) { int k = (int)(rng() % 6); len += (size_t)sprintf(text + len, "%s:   %s  \r\n", names[k], vals[(k + rng() % 2) % 6]); lines++; }
+
+    volatile size_t sink = 0;
+    double t_old, t_new;
+    size_t a0 = bench_allocs; sink += legacy_headers(text); size_t allocs_old = bench_allocs - a0;
+    a0 = bench_allocs; sink += view_headers(sv_n(text, len)); size_t allocs_new = bench_allocs - a0;
+    TIME_MS(t_old, sink += legacy_headers(text));
+    TIME_MS(t_new, sink += view_headers(sv_n(text, len)));
+    printf("[string views, 1 MB of header lines: ns per line, allocations per line]\n");
+    printf("%-28s %9.1f %9.2f\n", "char*: copy, trim, compare", t_old * 1e6 / lines, (double)allocs_old / lines);
+    printf("%-28s %9.1f %9.2f (%.1fx)\n", "qol_sv: split, cut, trim", t_new * 1e6 / lines, (double)allocs_new / lines, t_old / t_new);
+
+    TIME_MS(t_old, sink += legacy_count(text, "\r\n"));
+    TIME_MS(t_new, sink += sv_count(sv_n(text, len), SV("\r\n")));
+    printf("%-28s %9.0f\n", "count \\r\\n: strstr loop, MB/s", len / t_old / 1e3);
+    printf("%-28s %9.0f (%.1fx)\n\n", "count \\r\\n: sv_count, MB/s", len / t_new / 1e3, t_old / t_new);
+    (void)sink;
+    free(text);
+}
+
+// The previous jw_double fallback: shortest of %.15g / %.16g / %.17g that round-trips.
+static int legacy_shortest(char* out, double v) {
+    int n = snprintf(out, 32, "%.15g", v);
+    if (strtod(out, NULL) != v) n = snprintf(out, 32, "%.16g", v);
+    if (strtod(out, NULL) != v) n = snprintf(out, 32, "%.17g", v);
+    return n;
+}
+
+static void bench_numbers() {
+    enum { COUNT = 4096 };
+    static unsigned long long ints[COUNT];
+    static double reals[COUNT];
+    static char itext[COUNT][FMT_INT_MAX], dtext[COUNT][FMT_DOUBLE_MAX];
+    static size_t ilen[COUNT], dlen[COUNT];
+    for (int i = 0; i < COUNT; i++) {
+        // Mixed magnitudes: ids, counters, timestamps and the odd full-width value.
+        ints[i] = ((unsigned long long)rng() << 32 | rng()) >> (rng() % 64);
+        // Half "money-like" short decimals, half full-precision doubles.
+        reals[i] = i % 2 ? (double)(rng() % 1000000) / 100.0 : (double)rng() / (double)rng() * 1e3;
+        ilen[i] = fmt_u64(itext[i], ints[i]);
+        dlen[i] = fmt_double(dtext[i], reals[i]);
+    }
+    char buf[64];
+    volatile size_t sink = 0;
+    double t_old, t_new;
+    printf("[numbers, ns per value, %d mixed values]\n", COUNT);
+    TIME_MS(t_old, for (int i = 0; i < COUNT; i++) sink += (size_t)snprintf(buf, sizeof(buf), "%llu", ints[i]));
+    TIME_MS(t_new, for (int i = 0; i < COUNT; i++) sink += fmt_u64(buf, ints[i]));
+    printf("%-28s %9.1f\n", "snprintf %llu", t_old * 1e6 / COUNT);
+    printf("%-28s %9.1f (%.1fx)\n", "fmt_u64", t_new * 1e6 / COUNT, t_old / t_new);
+    TIME_MS(t_old, for (int i = 0; i < COUNT; i++) sink += (size_t)snprintf(buf, sizeof(buf), "%.17g", reals[i]));
+    double t_short;
+    TIME_MS(t_short, for (int i = 0; i < COUNT; i++) sink += (size_t)legacy_shortest(buf, reals[i]));
+    TIME_MS(t_new, for (int i = 0; i < COUNT; i++) sink += fmt_double(buf, reals[i]));
+    printf("%-28s %9.1f\n", "snprintf %.17g", t_old * 1e6 / COUNT);
+    printf("%-28s %9.1f\n", "shortest %.15g..%.17g", t_short * 1e6 / COUNT);
+    printf("%-28s %9.1f (%.1fx, %.1fx)\n", "fmt_double (shortest)", t_new * 1e6 / COUNT, t_old / t_new, t_short / t_new);
+    TIME_MS(t_old, for (int i = 0; i < COUNT; i++) sink += strtoull(itext[i], NULL, 10));
+    TIME_MS(t_new, for (int i = 0; i < COUNT; i++) { unsigned long long v = 0; sink += parse_u64(itext[i], ilen[i], &v) + v; });
+    printf("%-28s %9.1f\n", "strtoull", t_old * 1e6 / COUNT);
+    printf("%-28s %9.1f (%.1fx)\n", "parse_u64", t_new * 1e6 / COUNT, t_old / t_new);
+    TIME_MS(t_old, for (int i = 0; i < COUNT; i++) sink += (size_t)strtod(dtext[i], NULL));
+    TIME_MS(t_new, for (int i = 0; i < COUNT; i++) { double v = 0; sink += parse_double(dtext[i], dlen[i], &v) + (size_t)v; });
+    printf("%-28s %9.1f\n", "strtod", t_old * 1e6 / COUNT);
+    printf("%-28s %9.1f (%.1fx)\n\n", "parse_double", t_new * 1e6 / COUNT, t_old / t_new);
+    (void)sink;
+}
+
+// Byte-at-a-time baselines as commonly written: strchr over the alphabet, sprintf per byte.
+static size_t naive_b64_decode(unsigned char* dst, const char* src, size_t n) {
+    static const char* a = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    unsigned acc = 0;
+    int bits = 0;
+    size_t o = 0;
+    for (size_t i = 0; i < n && src[i] != '='; i++) {
+        const char* p = strchr(a, src[i]);
+        if (!p || !src[i]) return (size_t)-1;
+        acc = acc << 6 | (unsigned)(p - a);
+        if ((bits += 6) >= 8) { bits -= 8; dst[o++] = (unsigned char)(acc >> bits); }
+    }
+    return o;
+}
+
+static void naive_hex_encode(char* dst, const unsigned char* src, size_t n) {
+    for (size_t i = 0; i < n; i++) sprintf(dst + 2 * i, "%02x", src[i]);
+}
+
+static void bench_codecs() {
+    size_t n = 1 << 20;
+    unsigned char* raw = (unsigned char*)malloc(n);
+    unsigned char* back = (unsigned char*)malloc(n + 64);
+    char* enc = (char*)malloc(2 * n + 64);
+    for (size_t i = 0; i < n; i++) raw[i] = (unsigned char)rng();
+    int level = tools_simd_level();
+    double t[2][6], t_naive_dec, t_naive_hex;
+    volatile size_t sink = 0;
+    // Row 0 is the scalar path (dispatch capped at 0), row 1 the best available kernel.
+    for (int r = 0; r < 2; r++) {
+        tools_simd_limit(r ? level : 0);
+        size_t el = b64_encoded_len(n, 0), ul = b64_encoded_len(n, 1);
+        TIME_MS(t[r][0], b64_encode(enc, raw, n, 0));
+        TIME_MS(t[r][1], sink += b64_decode(back, enc, el, 0));
+        b64_encode(enc, raw, n, 1);
+        TIME_MS(t[r][2], b64_encode(enc, raw, n, 1));
+        TIME_MS(t[r][3], sink += b64_decode(back, enc, ul, 1));
+        TIME_MS(t[r][4], hex_encode(enc, raw, n));
+        TIME_MS(t[r][5], sink += hex_decode(back, enc, 2 * n));
+    }
+    tools_simd_limit(level);
+    b64_encode(enc, raw, n, 0);
+    TIME_MS(t_naive_dec, sink += naive_b64_decode(back, enc, b64_encoded_len(n, 0)));
+    TIME_MS(t_naive_hex, naive_hex_encode(enc, raw, n));
+    (void)sink;
+
+    static const char* labels[] = { "b64 encode", "b64 decode", "b64url encode", "b64url decode", "hex encode", "hex decode" };
+    printf("[base64 / hex codecs, GB/s of binary data, 1 MB, SIMD level %d]\n", level);
+    printf("%-28s %9s %9s\n", "", "scalar", "simd");
+    for (int k = 0; k < 6; k++)
+        printf("%-28s %9.2f %9.2f (%.1fx)\n", labels[k], n / t[0][k] / 1e6, n / t[1][k] / 1e6, t[0][k] / t[1][k]);
+    printf("%-28s %9.2f (simd %.0fx)\n", "naive b64 decode (strchr)", n / t_naive_dec / 1e6, t_naive_dec / t[1][1]);
+    printf("%-28s %9.2f (simd %.0fx)\n\n", "naive hex encode (sprintf)", n / t_naive_hex / 1e6, t_naive_hex / t[1][4]);
+    free(raw); free(back); free(enc);
+}
+
+// SimpleFS's char_to_float as a random source: FNV-1a over a counter, then a divide.
+static float legacy_random_float(unsigned* counter) {
+    unsigned hash = 2166136261u;
+    const unsigned char* p = (const unsigned char*)counter;
+    (*counter)++;
+    for (int i = 0; i < 4; i++) { hash ^= p[i]; hash *= 16777619u; }
+    return (float)hash / (float)0xFFFFFFFF;
+}
+
+static void bench_random() {
+    enum { N = 1 << 16 };
+    static unsigned long long u[N];
+    static double d[N];
+    static float f[N];
+    qol_rng r;
+    qol_pcg32 p;
+    qol_rng8 g;
+    unsigned counter = 0;
+    volatile unsigned long long sink = 0;
+    double t_legacy, t_rand, t_next, t_double, t_below, t_pcg, t_pcg_below, t_local, t_fill[3], t_fill_d;
+    rng_seed(&r, 1);
+    pcg32_seed(&p, 1, 1);
+    rng8_seed(&g, 1);
+    TIME_MS(t_legacy, for (int i = 0; i < N; i++) f[i] = legacy_random_float(&counter));
+    TIME_MS(t_rand, for (int i = 0; i < N; i++) f[i] = (float)rand() / (float)RAND_MAX);
+    TIME_MS(t_next, for (int i = 0; i < N; i++) u[i] = rng_next(&r));
+    TIME_MS(t_double, for (int i = 0; i < N; i++) d[i] = rng_double(&r));
+    TIME_MS(t_below, for (int i = 0; i < N; i++) u[i] = rng_below(&r, 1000));
+    TIME_MS(t_pcg, for (int i = 0; i < N; i++) u[i] = pcg32_next(&p));
+    TIME_MS(t_pcg_below, for (int i = 0; i < N; i++) u[i] = pcg32_below(&p, 1000));
+    TIME_MS(t_local, for (int i = 0; i < N; i++) d[i] = rng_double(rng_local()));
+    int level = tools_simd_level();
+    for (int l = 0; l <= level && l < 3; l++) {
+        tools_simd_limit(l);
+        TIME_MS(t_fill[l], rng8_fill_u64(&g, u, N));
+        _tools_simd = -1;
+    }
+    TIME_MS(t_fill_d, rng8_fill_double(&g, d, N));
+    sink += u[N - 1] + (unsigned long long)d[N - 1] + (unsigned long long)f[N - 1];
+    (void)sink;
+
+    double per = 1e6 / N;
+    static const char* fills[] = { "rng8_fill_u64 scalar", "rng8_fill_u64 SSE2", "rng8_fill_u64 AVX2" };
+    printf("[random numbers, ns per value]\n");
+    printf("%-28s %9.2f\n", "char_to_float style (FNV)", t_legacy * per);
+    printf("%-28s %9.2f\n", "rand() / RAND_MAX", t_rand * per);
+    printf("%-28s %9.2f\n", "rng_next", t_next * per);
+    printf("%-28s %9.2f (%.0fx)\n", "rng_double", t_double * per, t_legacy / t_double);
+    printf("%-28s %9.2f\n", "rng_below(1000)", t_below * per);
+    printf("%-28s %9.2f\n", "rng_double(rng_local())", t_local * per);
+    printf("%-28s %9.2f\n", "pcg32_next", t_pcg * per);
+    printf("%-28s %9.2f\n", "pcg32_below(1000)", t_pcg_below * per);
+    for (int l = 0; l <= level && l < 3; l++) printf("%-28s %9.2f (%.1f GB/s)\n", fills[l], t_fill[l] * per, 8.0 * N / t_fill[l] / 1e6);
+    printf("%-28s %9.2f (%.0fx)\n\n", "rng8_fill_double", t_fill_d * per, t_legacy / t_fill_d);
+}
+
+// Log calls: the caller's cost in bursts that fit in its ring, and lines per
+// second once the writer thread is the limit. The old way (stdio or one write()
+// per line, with time_now) is timed against the same /dev/null.
+enum { LOG_BURST = 256, LOG_LINES = 200000, LOG_THREADS = 4 };
+static qol_log bench_log;
+static FILE* bench_null;
+
+static void* log_stdio_worker(void* arg) {
+    for (int i = 0; i < LOG_LINES; i++) fprintf(bench_null, "%s [INFO] request %d took %d us from %s\n", time_now(), i, i & 1023, "10.0.0.1");
+    return arg;
+}
+
+static void* log_qlog_worker(void* arg) {
+    for (int i = 0; i < LOG_LINES; i++) qlog_info(&bench_log, "request %d took %d us from %s", i, i & 1023, "10.0.0.1");
+    return arg;
+}
+
+static double log_threads(void* (*fn)(void*)) {
+    pthread_t th[LOG_THREADS];
+    double t0 = now_ms();
+    for (int i = 0; i < LOG_THREADS; i++) pthread_create(&th[i], NULL, fn, NULL);
+    for (int i = 0; i < LOG_THREADS; i++) pthread_join(th[i], NULL);
+    qlog_flush(&bench_log);
+    return now_ms() - t0;
+}
+
+static void bench_logging() {
+    char line[128];
+    double t_stdio, t_write, t_burst = 0, t_filtered, t_sustained, t_mt_stdio, t_mt_qlog;
+    int bursts = 0;
+    bench_null = fopen("/dev/null", "w");
+    int fd = fileno(bench_null);
+    qlog_start(&bench_log, fd, QLOG_INFO);
+    TIME_MS(t_stdio, for (int i = 0; i < LOG_BURST; i++)
+        fprintf(bench_null, "%s [INFO] request %d took %d us from %s\n", time_now(), i, i & 1023, "10.0.0.1"));
+    TIME_MS(t_write, for (int i = 0; i < LOG_BURST; i++) {
+        int n = snprintf(line, sizeof(line), "%s [INFO] request %d took %d us from %s\n", time_now(), i, i & 1023, "10.0.0.1");
+        if (write(fd, line, (size_t)n) < 0) break;
+    });
+    for (double t0 = now_ms(); now_ms() - t0 < 200.0; bursts++) {
+        double b0 = now_ms();
+        for (int i = 0; i < LOG_BURST; i++) qlog_info(&bench_log, "request %d took %d us from %s", i, i & 1023, "10.0.0.1");
+        t_burst += now_ms() - b0;
+        qlog_flush(&bench_log);
+    }
+    t_burst /= bursts;
+    TIME_MS(t_filtered, for (int i = 0; i < LOG_BURST; i++) qlog_debug(&bench_log, "request %d took %d us from %s", i, i & 1023, "10.0.0.1"));
+    TIME_MS(t_sustained, {
+        for (int i = 0; i < LOG_LINES; i++) qlog_info(&bench_log, "request %d took %d us from %s", i, i & 1023, "10.0.0.1");
+        qlog_flush(&bench_log);
+    });
+    t_mt_stdio = log_threads(log_stdio_worker);
+    t_mt_qlog = log_threads(log_qlog_worker);
+    qlog_stop(&bench_log);
+    fclose(bench_null);
+
+    double per = 1e6 / LOG_BURST, lines = (double)LOG_LINES * LOG_THREADS;
+    printf("[logging to /dev/null, ns per line]\n");
+    printf("%-34s %9.1f\n", "fprintf + time_now", t_stdio * per);
+    printf("%-34s %9.1f\n", "snprintf + write() per line", t_write * per);
+    printf("%-34s %9.1f (%.0fx)\n", "qlog_info, caller", t_burst * per, t_stdio / t_burst);
+    printf("%-34s %9.1f\n", "qlog_debug, filtered at runtime", t_filtered * per);
+    printf("%-34s %9.1f\n", "qlog_info, sustained (writer)", t_sustained * 1e6 / LOG_LINES);
+    printf("%-34s %9.2f M lines/s\n", "4 threads, fprintf + time_now", lines / t_mt_stdio / 1e3);
+    printf("%-34s %9.2f M lines/s\n\n", "4 threads, qlog_info", lines / t_mt_qlog / 1e3);
+}
+
+static char* legacy_time_now() {
+    static char buf[32];
+    time_t now = time(NULL);
+    struct tm *t = localtime(&now);
+    strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", t);
+    return buf;
+}
+
+static void bench_time() {
+    char buf[TIME_NOW_LEN];
+    volatile unsigned long long sink = 0;
+    double t;
+    printf("[time, ns per call, 1000 calls per sample]\n");
+    TIME_MS(t, for (int k = 0; k < 1000; k++) sink += (unsigned char)legacy_time_now()[18]);
+    printf("%-28s %9.1f\n", "legacy time_now", t * 1e3);
+    TIME_MS(t, for (int k = 0; k < 1000; k++) sink += (unsigned char)time_now_r(buf)[18]);
+    printf("%-28s %9.1f\n", "time_now_r (cached)", t * 1e3);
+    TIME_MS(t, for (int k = 0; k < 1000; k++) sink += time_mono_ns());
+    printf("%-28s %9.1f\n", "time_mono_ns", t * 1e3);
+    TIME_MS(t, for (int k = 0; k < 1000; k++) sink += time_cycles());
+    printf("%-28s %9.1f\n\n", "time_cycles", t * 1e3);
+    (void)sink;
+}
+
+int main() {
+    printf("================================\n");
+    printf("   SIMPLE_TOOLS BENCHMARKS      \n");
+    printf("================================\n\n");
+    bench_replace();
+    bench_replace_many();
+    bench_format();
+    bench_json();
+    bench_ascii();
+    bench_hexdump();
+    bench_url();
+    bench_time();
+    bench_intern();
+    bench_views();
+    bench_numbers();
+    bench_codecs();
+    bench_random();
+    bench_logging();
+    return 0;
+}
@@ -7,77 +7,751 @@
 #include <stdarg.h>
 #include <ctype.h>
 #include <time.h>
+#include <limits.h>
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__GNUC__) && defined(__SSE2__) && !defined(SIMPLE_TOOLS_NO_SIMD)
+    #define _TOOLS_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(SIMPLE_TOOLS_NO_SIMD)
+    #define _TOOLS_X86_SIMD 1
+    #include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) && defined(__ARM_NEON) && !defined(SIMPLE_TOOLS_NO_SIMD)
+    #define _TOOLS_NEON 1
+    #include <arm_neon.h>
+#endif
 
 /* --- Cross-Platform Compatibility --- */
 
 #ifdef _WIN32
     #include <windows.h>
+    #include <io.h>
     #define usleep(us) Sleep((us)/1000)
     #define sleep(s) Sleep((s)*1000)
 #else
     #include <unistd.h>
+    #include <pthread.h>
+    #include <sched.h>
+    // localtime_r, clock_gettime and nanosleep are used when <time.h> exposes
+    // them, as glibc, musl and the BSDs do by default. Strict ISO modes such as
+    // -std=c11 hide them; build with -D_DEFAULT_SOURCE (QOL.h sets _GNU_SOURCE)
+    // or get localtime, timespec_get and a yielding qlog writer instead.
+    #ifdef CLOCK_MONOTONIC
+        #define _TOOLS_POSIX_TIME 1
+    #endif
+#endif
+
+/* --- Allocation Hooks --- */
+// libc defaults; QOL_MALLOC / QOL_REALLOC / QOL_FREE and QOL_USE_ALLOC are
+// documented in simple_types.h, which must come first to route through qol_malloc.
+#if defined(QOL_USE_ALLOC) && !defined(QOL_MALLOC)
+    #error "QOL_USE_ALLOC: include simple_types.h before this header (qol_malloc lives there)"
+#endif
+#ifndef QOL_MALLOC
+    #define QOL_MALLOC(n) malloc(n)
+    #define QOL_REALLOC(p, n) realloc(p, n)
+    #define QOL_FREE(p) free(p)
 #endif
 
 #ifndef MAX_HTTP_BUF
 #define MAX_HTTP_BUF 65536
 #endif
 
-/* --- Internal String Engine --- */
+/* --- String Builder --- */
+
+typedef struct { char* data; size_t len; size_t cap; } qol_sb;
+
+// Makes room for extra bytes plus the NUL. Grows by doubling; returns 0 on allocation failure.
+static inline int sb_reserve(qol_sb* sb, size_t extra) {
+    size_t need = sb->len + extra + 1;
+    if (need <= sb->cap) return 1;
+    size_t cap = sb->cap ? sb->cap : 64;
+    while (cap < need) cap *= 2;
+    char* p = (char*)QOL_REALLOC(sb->data, cap);
+    if (!p) return 0;
+    sb->data = p; sb->cap = cap;
+    return 1;
+}
+
+static inline int sb_append_n(qol_sb* sb, const char* s, size_t n) {
+    if (!sb_reserve(sb, n)) return 0;
+    memcpy(sb->data + sb->len, s, n);
+    sb->len += n;
+    sb->data[sb->len] = '\0';
+    return 1;
+}
+
+static inline int sb_append(qol_sb* sb, const char* s) { return sb_append_n(sb, s, strlen(s)); }
+
+static inline int sb_appendc(qol_sb* sb, char c) {
+    if (sb->len + 2 > sb->cap && !sb_reserve(sb, 1)) return 0;
+    sb->data[sb->len++] = c;
+    sb->data[sb->len] = '\0';
+    return 1;
+}
+
+// Formats straight into the spare capacity (at least 64 bytes); only when that is
+// too small does it grow to the exact size vsnprintf reported and format again.
+static inline int sb_vappendf(qol_sb* sb, const char* fmt, va_list args) {
+    if (!sb_reserve(sb, 64)) return 0;
+    va_list again;
+    va_copy(again, args);
+    size_t room = sb->cap - sb->len;
+    int n = vsnprintf(sb->data + sb->len, room, fmt, args);
+    if (n < 0) { va_end(again); return 0; }
+    if ((size_t)n >= room) {
+        if (!sb_reserve(sb, (size_t)n)) { va_end(again); return 0; }
+        vsnprintf(sb->data + sb->len, (size_t)n + 1, fmt, again);
+    }
+    va_end(again);
+    sb->len += (size_t)n;
+    return 1;
+}
+
+static inline int sb_appendf(qol_sb* sb, const char* fmt, ...) {
+    va_list args; va_start(args, fmt);
+    int ok = sb_vappendf(sb, fmt, args);
+    va_end(args);
+    return ok;
+}
+
+// Empties the builder but keeps its buffer for reuse.
+static inline void sb_reset(qol_sb* sb) { sb->len = 0; if (sb->data) sb->data[0] = '\0'; }
+
+static inline void sb_free(qol_sb* sb) { QOL_FREE(sb->data); sb->data = NULL; sb->len = sb->cap = 0; }
+
+/* --- Hex Dump --- */
+
+// Zero-initialized options give the defaults: 16 bytes per line, an extra gap
+// every 8, offset and ASCII columns on.
+typedef struct {
+    int width;      // bytes per line, 1..256 (0 = 16)
+    int group;      // extra space after every group bytes (0 = 8, >= width for none)
+    int no_offset;  // drop the offset column
+    int no_ascii;   // drop the |ascii| column
+    size_t base;    // offset printed for the first byte
+} qol_hex_opts;
+
+// "00" .. "ff", indexed by byte * 2.
+static const char _hex_pairs[] =
+    "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+    "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+    "404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f"
+    "606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+    "808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f"
+    "a0a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+    "c0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+    "e0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+// Formats one line of n <= width bytes and returns its length. A short last
+// line is padded so its ASCII column lines up with the lines above.
+static inline size_t _hex_line(char* out, const unsigned char* p, size_t n, size_t off, int width, int group, int wide_off, const qol_hex_opts* o) {
+    char* w = out;
+    if (!o->no_offset) {
+        for (int shift = wide_off ? 60 : 28; shift >= 0; shift -= 4) *w++ = "0123456789abcdef"[(off >> shift) & 15];
+        *w++ = ' '; *w++ = ' ';
+    }
+    for (int i = 0; i < width; i++) {
+        if ((size_t)i < n) { memcpy(w, _hex_pairs + p[i] * 2, 2); w[2] = ' '; }
+        else { w[0] = w[1] = w[2] = ' '; }
+        w += 3;
+        if ((i + 1) % group == 0 && i + 1 < width) *w++ = ' ';
+    }
+    if (!o->no_ascii) {
+        *w++ = ' '; *w++ = '|';
+        for (size_t i = 0; i < n; i++) *w++ = (p[i] >= 0x20 && p[i] < 0x7f) ? (char)p[i] : '.';
+        *w++ = '|';
+    } else {
+        while (w > out && w[-1] == ' ') w--;
+    }
+    *w++ = '\n';
+    return (size_t)(w - out);
+}
+
+// Formats whole lines into an 8 KB stack chunk and hands each full chunk to
+// emit, so a sink sees a few large writes instead of one per byte.
+static inline void _hexdump_run(const void* ptr, size_t n, const qol_hex_opts* opts,
+                                void (*emit)(void* ctx, const char* s, size_t len), void* ctx) {
+    qol_hex_opts o;
+    if (opts) o = *opts; else memset(&o, 0, sizeof(o));
+    int width = o.width > 0 && o.width <= 256 ? o.width : 16;
+    int group = o.group > 0 ? o.group : 8;
+    int wide_off = sizeof(size_t) > 4 && (o.base + n) > 0xFFFFFFFFu;
+    size_t max_line = 20 + (size_t)width * 5 + 4;
+    char chunk[8192];
+    size_t used = 0;
+    const unsigned char* p = (const unsigned char*)ptr;
+    for (size_t i = 0; i < n; i += (size_t)width) {
+        size_t take = n - i < (size_t)width ? n - i : (size_t)width;
+        used += _hex_line(chunk + used, p + i, take, o.base + i, width, group, wide_off, &o);
+        if (used + max_line > sizeof(chunk)) { emit(ctx, chunk, used); used = 0; }
+    }
+    if (used) emit(ctx, chunk, used);
+}
+
+static inline void _hex_emit_file(void* ctx, const char* s, size_t len) { fwrite(s, 1, len, (FILE*)ctx); }
+
+static inline void _hex_emit_fd(void* ctx, const char* s, size_t len) {
+    int fd = *(int*)ctx;
+    while (len) {
+#ifdef _WIN32
+        int w = _write(fd, s, (unsigned)len);
+#else
+        ssize_t w = write(fd, s, len);
+#endif
+        if (w <= 0) return;
+        s += w; len -= (size_t)w;
+    }
+}
+
+static inline void _hex_emit_sb(void* ctx, const char* s, size_t len) { sb_append_n((qol_sb*)ctx, s, len); }
+
+// opts may be NULL for the defaults.
+static inline void hexdump_file(FILE* f, const void* ptr, size_t n, const qol_hex_opts* opts) { _hexdump_run(ptr, n, opts, _hex_emit_file, f); }
+static inline void hexdump_fd(int fd, const void* ptr, size_t n, const qol_hex_opts* opts) { _hexdump_run(ptr, n, opts, _hex_emit_fd, &fd); }
+static inline void sb_hexdump(qol_sb* sb, const void* ptr, size_t n, const qol_hex_opts* opts) { _hexdump_run(ptr, n, opts, _hex_emit_sb, sb); }
+
+static inline void hexdmp(void* ptr, int buflen) { if (buflen > 0) hexdump_file(stdout, ptr, (size_t)buflen, NULL); }
+
+/* --- Search & Replace Engine --- */
+
+// Finds needle in hay[0..hay_len). The SSE2 path compares the needle's first and
+// last bytes at 16 positions per step and only calls memcmp where both match.
+static inline const char* _str_find(const char* hay, size_t hay_len, const char* needle, size_t nlen) {
+    if (nlen == 0 || hay_len < nlen) return NULL;
+    if (nlen == 1) return (const char*)memchr(hay, needle[0], hay_len);
+#ifdef _TOOLS_SSE2
+    const __m128i first = _mm_set1_epi8(needle[0]), last = _mm_set1_epi8(needle[nlen - 1]);
+    size_t i = 0;
+    for (; i + nlen - 1 + 16 <= hay_len; i += 16) {
+        __m128i bf = _mm_loadu_si128((const __m128i*)(hay + i));
+        __m128i bl = _mm_loadu_si128((const __m128i*)(hay + i + nlen - 1));
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(bf, first), _mm_cmpeq_epi8(bl, last)));
+        while (mask) {
+            unsigned bit = (unsigned)__builtin_ctz(mask);
+            if (memcmp(hay + i + bit + 1, needle + 1, nlen - 2) == 0) return hay + i + bit;
+            mask &= mask - 1;
+        }
+    }
+    hay += i; hay_len -= i;
+#endif
+    while (hay_len >= nlen) {
+        const char* p = (const char*)memchr(hay, needle[0], hay_len - nlen + 1);
+        if (!p) return NULL;
+        if (memcmp(p + 1, needle + 1, nlen - 1) == 0) return p;
+        hay_len -= (size_t)(p + 1 - hay);
+        hay = p + 1;
+    }
+    return NULL;
+}
+
+// Counts bytes equal to c, 16 at a time on SSE2. Matches are summed per byte lane
+// (at most 255 blocks at a time) and folded with psadbw, which avoids a popcount
+// call on targets built without -mpopcnt.
+static inline size_t _str_count_byte(const char* s, size_t len, char c) {
+    size_t count = 0, i = 0;
+#ifdef _TOOLS_SSE2
+    const __m128i v = _mm_set1_epi8(c), zero = _mm_setzero_si128();
+    while (i + 16 <= len) {
+        size_t blocks = (len - i) / 16;
+        if (blocks > 255) blocks = 255;
+        __m128i acc = zero;
+        for (size_t b = 0; b < blocks; b++, i += 16)
+            acc = _mm_sub_epi8(acc, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(s + i)), v));
+        __m128i sums = _mm_sad_epu8(acc, zero);
+        count += (size_t)_mm_cvtsi128_si32(sums) + (size_t)_mm_cvtsi128_si32(_mm_srli_si128(sums, 8));
+    }
+#endif
+    for (; i < len; i++) count += s[i] == c;
+    return count;
+}
+
+// Pass 1: exact output length when occurrences start_idx..end_idx (1-based) are replaced.
+static inline size_t _str_replace_size(const char* src, size_t src_len, const char* find, size_t find_len,
+                                       size_t replace_len, int start_idx, int end_idx) {
+    size_t hits = 0;
+    if (find_len == 1) {
+        size_t total = _str_count_byte(src, src_len, find[0]);
+        size_t first = start_idx > 1 ? (size_t)start_idx : 1, last = end_idx < 0 ? 0 : (size_t)end_idx;
+        if (last > total) last = total;
+        hits = last >= first ? last - first + 1 : 0;
+    } else {
+        const char* p = src;
+        const char* end = src + src_len;
+        for (int n = 1; n <= end_idx; n++) {
+            const char* pos = _str_find(p, (size_t)(end - p), find, find_len);
+            if (!pos) break;
+            if (n >= start_idx) hits++;
+            p = pos + find_len;
+        }
+    }
+    return src_len - hits * find_len + hits * replace_len;
+}
 
-static inline void hexdmp(void* ptr, int buflen) {
-    unsigned char* buf = (unsigned char*)ptr;
-    for (int i = 0; i < buflen; i++) {
-        // Print the hex value of the byte
-        printf("%02x ", buf[i]);
+// Room needed before writing: exact when the replacement is longer than the match,
+// otherwise src_len, so shrinking replacements skip the counting pass.
+static inline size_t _str_replace_bound(const char* src, size_t src_len, const char* find, size_t find_len,
+                                        size_t replace_len, int start_idx, int end_idx) {
+    if (replace_len <= find_len) return src_len;
+    return _str_replace_size(src, src_len, find, find_len, replace_len, start_idx, end_idx);
+}
 
-        // Every 16 bytes, start a new line for readability
-        if ((i + 1) % 16 == 0) printf("\n");
+// Pass 2: writes the result and its NUL into dst and returns the length.
+static inline size_t _str_replace_write(char* dst, const char* src, size_t src_len, const char* find, size_t find_len,
+                                        const char* replace, size_t replace_len, int start_idx, int end_idx) {
+    char* out = dst;
+    const char* p = src;
+    const char* end = src + src_len;
+    for (int n = 1; n <= end_idx; n++) {
+        const char* pos = _str_find(p, (size_t)(end - p), find, find_len);
+        if (!pos) break;
+        size_t keep = (size_t)(pos - p) + (n >= start_idx ? 0 : find_len);
+        memcpy(out, p, keep); out += keep;
+        if (n >= start_idx) { memcpy(out, replace, replace_len); out += replace_len; }
+        p = pos + find_len;
     }
-    printf("\n");
+    memcpy(out, p, (size_t)(end - p));
+    out += end - p;
+    *out = '\0';
+    return (size_t)(out - dst);
 }
 
+// The engine behind every str_replace_* call: one allocation at the exact size.
+// A shrinking replacement allocates src_len and is trimmed afterwards only when
+// the slack is large, since realloc on a big block can cost more than a pass.
 static inline char* _str_replace_logic(const char* src, const char* find, const char* replace, int start_idx, int end_idx) {
     if (!src || !find || !replace) return NULL;
-    size_t find_len = strlen(find);
-    size_t replace_len = strlen(replace);
-    size_t src_len = strlen(src);
-    char* result = (char*)malloc(src_len * 10 + 1); 
-    char* p_res = result;
-    const char* p_src = src;
-    int current_occurrence = 0;
-
-    while (*p_src) {
-        const char* pos = strstr(p_src, find);
-        if (pos) {
-            current_occurrence++;
-            int should_replace = (current_occurrence >= start_idx && current_occurrence <= end_idx);
-            size_t prefix_len = pos - p_src;
-            memcpy(p_res, p_src, prefix_len);
-            p_res += prefix_len;
-            if (should_replace) {
-                memcpy(p_res, replace, replace_len);
-                p_res += replace_len;
-            } else {
-                memcpy(p_res, find, find_len);
-                p_res += find_len;
-            }
-            p_src = pos + find_len;
-        } else {
-            strcpy(p_res, p_src);
-            break;
-        }
+    size_t src_len = strlen(src), find_len = strlen(find), replace_len = strlen(replace);
+    if (find_len == 0) end_idx = 0;
+    size_t bound = _str_replace_bound(src, src_len, find, find_len, replace_len, start_idx, end_idx);
+    char* result = (char*)QOL_MALLOC(bound + 1);
+    if (!result) return NULL;
+    size_t len = _str_replace_write(result, src, src_len, find, find_len, replace, replace_len, start_idx, end_idx);
+    if (bound - len > 4096 && bound - len > bound / 8) {
+        char* trimmed = (char*)QOL_REALLOC(result, len + 1);
+        if (trimmed) result = trimmed;
     }
     return result;
 }
 
+// Caller-buffer form. Returns the full result length; dst is only written when
+// cap > that length, so a too-small buffer can be retried at the returned size + 1.
+static inline size_t _str_replace_buf(char* dst, size_t cap, const char* src, const char* find, const char* replace, int start_idx, int end_idx) {
+    if (!src || !find || !replace) return 0;
+    size_t src_len = strlen(src), find_len = strlen(find), replace_len = strlen(replace);
+    if (find_len == 0) end_idx = 0;
+    size_t bound = _str_replace_bound(src, src_len, find, find_len, replace_len, start_idx, end_idx);
+    if (dst && bound < cap) return _str_replace_write(dst, src, src_len, find, find_len, replace, replace_len, start_idx, end_idx);
+    size_t len = replace_len <= find_len ? _str_replace_size(src, src_len, find, find_len, replace_len, start_idx, end_idx) : bound;
+    if (dst && len < cap) _str_replace_write(dst, src, src_len, find, find_len, replace, replace_len, start_idx, end_idx);
+    else if (dst && cap) dst[0] = '\0';
+    return len;
+}
+
+// Builder form: appends the result to sb. Returns 0 on allocation failure.
+static inline int _str_replace_sb(qol_sb* sb, const char* src, const char* find, const char* replace, int start_idx, int end_idx) {
+    if (!src || !find || !replace) return 0;
+    size_t src_len = strlen(src), find_len = strlen(find), replace_len = strlen(replace);
+    if (find_len == 0) end_idx = 0;
+    if (!sb_reserve(sb, _str_replace_bound(src, src_len, find, find_len, replace_len, start_idx, end_idx))) return 0;
+    sb->len += _str_replace_write(sb->data + sb->len, src, src_len, find, find_len, replace, replace_len, start_idx, end_idx);
+    return 1;
+}
+
 /* --- String Replacement API --- */
 
 static inline char* str_replace_first(const char* s, const char* f, const char* r) { return _str_replace_logic(s, f, r, 1, 1); }
-static inline char* str_replace_all(const char* s, const char* f, const char* r)   { return _str_replace_logic(s, f, r, 1, 999999); }
+static inline char* str_replace_all(const char* s, const char* f, const char* r)   { return _str_replace_logic(s, f, r, 1, INT_MAX); }
 static inline char* str_replace_nth(const char* s, const char* f, const char* r, int n) { return _str_replace_logic(s, f, r, n, n); }
 static inline char* str_replace_count(const char* s, const char* f, const char* r, int c) { return _str_replace_logic(s, f, r, 1, c); }
 static inline char* str_replace_range(const char* s, const char* f, const char* r, int s_idx, int e_idx) { return _str_replace_logic(s, f, r, s_idx, e_idx); }
 
+static inline size_t str_replace_all_buf(char* dst, size_t cap, const char* s, const char* f, const char* r) { return _str_replace_buf(dst, cap, s, f, r, 1, INT_MAX); }
+static inline size_t str_replace_range_buf(char* dst, size_t cap, const char* s, const char* f, const char* r, int s_idx, int e_idx) { return _str_replace_buf(dst, cap, s, f, r, s_idx, e_idx); }
+static inline int sb_replace_all(qol_sb* sb, const char* s, const char* f, const char* r) { return _str_replace_sb(sb, s, f, r, 1, INT_MAX); }
+static inline int sb_replace_range(qol_sb* sb, const char* s, const char* f, const char* r, int s_idx, int e_idx) { return _str_replace_sb(sb, s, f, r, s_idx, e_idx); }
+
+/* --- Multi-Pattern Replace (Aho-Corasick) --- */
+
+typedef struct { const char* find; const char* replace; } qol_repl;
+
+// A compiled set of find/replace pairs. Build once with ac_build and reuse it
+// for any number of inputs; it keeps its own copies of the replacements.
+// Each state is one row of table: [depth, match, next...], where next holds row
+// offsets so a step is a single add and load.
+typedef struct {
+    unsigned short cls[256]; // byte -> transition column; 0 for bytes in no pattern
+    int stride, nstates, npairs;
+    int* table;
+    size_t* find_len;
+    size_t* rep_len;
+    char** rep;
+} qol_ac;
+
+static inline void ac_free(qol_ac* ac) {
+    if (!ac) return;
+    QOL_FREE(ac->table); QOL_FREE(ac->find_len); QOL_FREE(ac->rep_len); QOL_FREE(ac->rep);
+    QOL_FREE(ac);
+}
+
+// Builds the automaton. Empty find strings are ignored and, for duplicates,
+// the first pair wins. Returns NULL on allocation failure.
+static inline qol_ac* ac_build(const qol_repl* pairs, int n) {
+    if (!pairs || n < 0) return NULL;
+    qol_ac* ac = (qol_ac*)QOL_MALLOC(sizeof(qol_ac));
+    if (!ac) return NULL;
+    memset(ac, 0, sizeof(*ac));
+    size_t total = 1, blob = 0;
+    int nc = 1;
+    for (int i = 0; i < n; i++) {
+        const unsigned char* f = (const unsigned char*)pairs[i].find;
+        for (; *f; f++, total++) if (!ac->cls[*f]) ac->cls[*f] = (unsigned short)nc++;
+        blob += strlen(pairs[i].replace) + 1;
+    }
+    ac->stride = nc + 2; ac->npairs = n;
+
+    ac->table = (int*)QOL_MALLOC(total * ac->stride * sizeof(int));
+    ac->find_len = (size_t*)QOL_MALLOC((n + 1) * sizeof(size_t));
+    ac->rep_len = (size_t*)QOL_MALLOC((n + 1) * sizeof(size_t));
+    ac->rep = (char**)QOL_MALLOC((n + 1) * sizeof(char*) + blob);
+    int* fail = (int*)QOL_MALLOC(total * 2 * sizeof(int));
+    if (!ac->table || !ac->find_len || !ac->rep_len || !ac->rep || !fail) { QOL_FREE(fail); ac_free(ac); return NULL; }
+    int* queue = fail + total;
+    int stride = ac->stride, *t = ac->table;
+
+    // Trie first, in state numbers, with -1 marking the edges the BFS fills in.
+    memset(t, -1, total * stride * sizeof(int));
+    ac->nstates = 1; t[0] = 0;
+    char* store = (char*)(ac->rep + n + 1);
+    for (int i = 0; i < n; i++) {
+        const unsigned char* f = (const unsigned char*)pairs[i].find;
+        int s = 0;
+        for (; *f; f++) {
+            int* edge = &t[s * stride + 2 + ac->cls[*f]];
+            if (*edge < 0) {
+                *edge = ac->nstates;
+                t[ac->nstates++ * stride] = t[s * stride] + 1;
+            }
+            s = *edge;
+        }
+        ac->find_len[i] = (size_t)t[s * stride];
+        ac->rep_len[i] = strlen(pairs[i].replace);
+        ac->rep[i] = store;
+        memcpy(store, pairs[i].replace, ac->rep_len[i] + 1);
+        store += ac->rep_len[i] + 1;
+        if (s && t[s * stride + 1] < 0) t[s * stride + 1] = i;
+    }
+
+    // BFS in depth order: a missing edge borrows the fail state's edge, and the
+    // match inherits the fail state's, so scanning never walks a suffix chain.
+    int head = 0, tail = 0;
+    for (int c = 2; c < stride; c++) {
+        if (t[c] <= 0) t[c] = 0;
+        else { fail[t[c]] = 0; queue[tail++] = t[c]; }
+    }
+    while (head < tail) {
+        int s = queue[head++], *row = t + s * stride, *frow = t + fail[s] * stride;
+        if (row[1] < 0) row[1] = frow[1];
+        for (int c = 2; c < stride; c++) {
+            if (row[c] < 0) row[c] = frow[c];
+            else { fail[row[c]] = frow[c]; queue[tail++] = row[c]; }
+        }
+    }
+    for (int i = 0; i < ac->nstates; i++)
+        for (int c = 2; c < stride; c++) t[i * stride + c] *= stride;
+    QOL_FREE(fail);
+    return ac;
+}
+
+// One pass over src with leftmost-longest semantics: of all matches the one that
+// starts first wins, ties go to the longest, and scanning resumes after it.
+// A match is committed once the automaton's live prefix starts past it, since
+// no longer match from the same start can still appear.
+static inline int _ac_run(const qol_ac* ac, qol_sb* sb, const char* src, size_t len) {
+    const int* t = ac->table;
+    const unsigned short* cls = ac->cls;
+    size_t i = 0, done = 0;
+    if (!sb_reserve(sb, len)) return 0;
+    for (;;) {
+        // No match pending: step until some pattern ends.
+        int state = 0, p = -1;
+        while (i < len) {
+            state = t[state + 2 + cls[(unsigned char)src[i++]]];
+            if ((p = t[state + 1]) >= 0) break;
+        }
+        if (p < 0) break;
+
+        // Pending match: keep extending while a longer or earlier one is still possible.
+        int cand = p;
+        size_t cand_start = i - ac->find_len[p];
+        while (i < len) {
+            state = t[state + 2 + cls[(unsigned char)src[i++]]];
+            if ((p = t[state + 1]) >= 0 && i - ac->find_len[p] <= cand_start) { cand = p; cand_start = i - ac->find_len[p]; }
+            if ((size_t)t[state] < i - cand_start) break;
+        }
+
+        size_t gap = cand_start - done, rl = ac->rep_len[cand];
+        if (!sb_reserve(sb, gap + rl)) return 0;
+        memcpy(sb->data + sb->len, src + done, gap);
+        memcpy(sb->data + sb->len + gap, ac->rep[cand], rl);
+        sb->len += gap + rl;
+        done = i = cand_start + ac->find_len[cand];
+    }
+    return sb_append_n(sb, src + done, len - done);
+}
+
+// Replaces every match of the compiled pairs in one pass. Caller frees.
+static inline char* ac_replace(const qol_ac* ac, const char* src) {
+    if (!ac || !src) return NULL;
+    qol_sb sb = {0};
+    if (!_ac_run(ac, &sb, src, strlen(src))) { sb_free(&sb); return NULL; }
+    return sb.data;
+}
+
+static inline int sb_ac_replace(qol_sb* sb, const qol_ac* ac, const char* src) {
+    return ac && src ? _ac_run(ac, sb, src, strlen(src)) : 0;
+}
+
+// One-shot form: builds, runs and frees an automaton. When the same pairs are
+// applied to many inputs, keep an ac_build result instead.
+static inline char* str_replace_many(const char* src, const qol_repl* pairs, int n) {
+    qol_ac* ac = ac_build(pairs, n);
+    char* result = ac_replace(ac, src);
+    ac_free(ac);
+    return result;
+}
+
+/* --- ASCII Kernels --- */
+
+// Case, digit and whitespace tests are ASCII / C-locale only: bytes >= 0x80
+// are never changed or classified, whatever setlocale says.
+
+// 0 = scalar, 1 = SSE2 or NEON, 2 = AVX2.
+static int _tools_simd = -1;
+
+static inline int tools_simd_level() {
+    if (_tools_simd < 0) {
+        _tools_simd = 0;
+#if defined(_TOOLS_SSE2) || defined(_TOOLS_NEON)
+        _tools_simd = 1;
+#endif
+#ifdef _TOOLS_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) _tools_simd = 2;
+#endif
+    }
+    return _tools_simd;
+}
+
+// Caps the dispatch level (e.g. 0 to force the scalar kernels).
+static inline void tools_simd_limit(int level) {
+    int hw = (_tools_simd = -1, tools_simd_level());
+    _tools_simd = level < hw ? level : hw;
+}
+
+static inline int _ascii_is_digit(unsigned char c) { return (unsigned)(c - '0') < 10; }
+static inline int _ascii_is_space(unsigned char c) { return c == ' ' || (unsigned)(c - 9) < 5; }
+
+// SWAR: 0x80 in each byte of x that lies in [lo, lo + span), for lo + span <= 128.
+// Works on the low 7 bits so no add carries into the next byte.
+static inline unsigned long long _ascii_swar_in_range(unsigned long long x, unsigned char lo, unsigned char span) {
+    const unsigned long long ones = 0x0101010101010101ULL, high = ones * 0x80;
+    unsigned long long h = x & ~high;
+    return (h + ones * (unsigned char)(128 - lo)) & ~(h + ones * (unsigned char)(128 - lo - span)) & ~x & high;
+}
+
+// Flips bit 5 of every byte in [lo, lo + 26): 'A' lowers, 'a' uppers.
+static inline void _ascii_flip_scalar(char* s, size_t n, char lo) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        unsigned long long x;
+        memcpy(&x, s + i, 8);
+        x ^= _ascii_swar_in_range(x, (unsigned char)lo, 26) >> 2;
+        memcpy(s + i, &x, 8);
+    }
+    for (; i < n; i++) {
+        unsigned char c = (unsigned char)s[i];
+        s[i] = (char)(c ^ (((unsigned)(c - (unsigned char)lo) < 26) << 5));
+    }
+}
+
+#ifdef _TOOLS_SSE2
+// Byte mask of x in [lo, lo + span): bias so lo lands on -128, then one signed compare.
+static inline __m128i _sse2_in_range(__m128i x, char lo, int span) {
+    return _mm_cmplt_epi8(_mm_add_epi8(x, _mm_set1_epi8((char)(128 - lo))), _mm_set1_epi8((char)(span - 128)));
+}
+
+static inline unsigned _sse2_space_mask(const char* p) {
+    __m128i x = _mm_loadu_si128((const __m128i*)p);
+    return (unsigned)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(' ')), _sse2_in_range(x, 9, 5)));
+}
+
+static inline size_t _ascii_flip_sse2(char* s, size_t n, char lo) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(s + i));
+        x = _mm_xor_si128(x, _mm_and_si128(_sse2_in_range(x, lo, 26), _mm_set1_epi8(0x20)));
+        _mm_storeu_si128((__m128i*)(s + i), x);
+    }
+    return i;
+}
+
+static inline size_t _ascii_digits_sse2(const char* s, size_t n) {
+    for (size_t i = 0; i + 16 <= n; i += 16) {
+        unsigned ok = (unsigned)_mm_movemask_epi8(_sse2_in_range(_mm_loadu_si128((const __m128i*)(s + i)), '0', 10));
+        if (ok != 0xFFFF) return i + (size_t)__builtin_ctz(~ok);
+    }
+    return n & ~(size_t)15;
+}
+#endif
+
+#ifdef _TOOLS_X86_SIMD
+__attribute__((target("avx2")))
+static inline __m256i _avx2_in_range(__m256i x, char lo, int span) {
+    return _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(span - 128)), _mm256_add_epi8(x, _mm256_set1_epi8((char)(128 - lo))));
+}
+
+__attribute__((target("avx2")))
+static inline size_t _ascii_flip_avx2(char* s, size_t n, char lo) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(s + i));
+        x = _mm256_xor_si256(x, _mm256_and_si256(_avx2_in_range(x, lo, 26), _mm256_set1_epi8(0x20)));
+        _mm256_storeu_si256((__m256i*)(s + i), x);
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static inline size_t _ascii_digits_avx2(const char* s, size_t n) {
+    for (size_t i = 0; i + 32 <= n; i += 32) {
+        unsigned ok = (unsigned)_mm256_movemask_epi8(_avx2_in_range(_mm256_loadu_si256((const __m256i*)(s + i)), '0', 10));
+        if (ok != 0xFFFFFFFFu) return i + (size_t)__builtin_ctz(~ok);
+    }
+    return n & ~(size_t)31;
+}
+#endif
+
+#ifdef _TOOLS_NEON
+// NEON has no movemask; narrowing each byte to a nibble gives a 64-bit mask
+// with 4 bits per byte, so bit positions divide by 4.
+static inline uint64_t _neon_mask(uint8x16_t m) {
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0);
+}
+
+static inline uint8x16_t _neon_in_range(uint8x16_t x, char lo, int span) {
+    return vcltq_u8(vsubq_u8(x, vdupq_n_u8((unsigned char)lo)), vdupq_n_u8((unsigned char)span));
+}
+
+static inline uint64_t _neon_space_mask(const char* p) {
+    uint8x16_t x = vld1q_u8((const uint8_t*)p);
+    return _neon_mask(vorrq_u8(vceqq_u8(x, vdupq_n_u8(' ')), _neon_in_range(x, 9, 5)));
+}
+
+static inline size_t _ascii_flip_neon(char* s, size_t n, char lo) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t x = vld1q_u8((const uint8_t*)(s + i));
+        x = veorq_u8(x, vandq_u8(_neon_in_range(x, lo, 26), vdupq_n_u8(0x20)));
+        vst1q_u8((uint8_t*)(s + i), x);
+    }
+    return i;
+}
+
+static inline size_t _ascii_digits_neon(const char* s, size_t n) {
+    for (size_t i = 0; i + 16 <= n; i += 16) {
+        uint64_t ok = _neon_mask(_neon_in_range(vld1q_u8((const uint8_t*)(s + i)), '0', 10));
+        if (~ok) return i + (size_t)(__builtin_ctzll(~ok) >> 2);
+    }
+    return n & ~(size_t)15;
+}
+#endif
+
+static inline void _ascii_flip(char* s, size_t n, char lo) {
+    size_t i = 0;
+    int level = tools_simd_level();
+#ifdef _TOOLS_X86_SIMD
+    if (level >= 2) i = _ascii_flip_avx2(s, n, lo);
+#endif
+#ifdef _TOOLS_SSE2
+    if (level >= 1) i += _ascii_flip_sse2(s + i, n - i, lo);
+#endif
+#ifdef _TOOLS_NEON
+    if (level >= 1) i += _ascii_flip_neon(s + i, n - i, lo);
+#endif
+    (void)level;
+    _ascii_flip_scalar(s + i, n - i, lo);
+}
+
+// Number of leading bytes of s[0..n) that are digits.
+static inline size_t _ascii_digits(const char* s, size_t n) {
+    size_t i = 0;
+    int level = tools_simd_level();
+#ifdef _TOOLS_X86_SIMD
+    if (level >= 2) { i = _ascii_digits_avx2(s, n); if (i < (n & ~(size_t)31)) return i; }
+#endif
+#ifdef _TOOLS_SSE2
+    if (level >= 1) { size_t rest = n - i, k = _ascii_digits_sse2(s + i, rest); i += k; if (k < (rest & ~(size_t)15)) return i; }
+#endif
+#ifdef _TOOLS_NEON
+    if (level >= 1) { size_t rest = n - i, k = _ascii_digits_neon(s + i, rest); i += k; if (k < (rest & ~(size_t)15)) return i; }
+#endif
+    (void)level;
+    for (; i + 8 <= n; i += 8) {
+        unsigned long long x;
+        memcpy(&x, s + i, 8);
+        if (_ascii_swar_in_range(x, '0', 10) != 0x8080808080808080ULL) break;
+    }
+    while (i < n && _ascii_is_digit((unsigned char)s[i])) i++;
+    return i;
+}
+
+// Leading / trailing whitespace counts. Runs are usually short, so 16-byte
+// blocks are enough and AVX2 is not worth the dispatch.
+static inline size_t _ascii_lspace(const char* s, size_t n) {
+    size_t i = 0;
+#if defined(_TOOLS_SSE2)
+    if (tools_simd_level() >= 1)
+        for (; i + 16 <= n; i += 16) {
+            unsigned sp = _sse2_space_mask(s + i);
+            if (sp != 0xFFFF) return i + (size_t)__builtin_ctz(~sp);
+        }
+#elif defined(_TOOLS_NEON)
+    if (tools_simd_level() >= 1)
+        for (; i + 16 <= n; i += 16) {
+            uint64_t sp = _neon_space_mask(s + i);
+            if (~sp) return i + (size_t)(__builtin_ctzll(~sp) >> 2);
+        }
+#endif
+    while (i < n && _ascii_is_space((unsigned char)s[i])) i++;
+    return i;
+}
+
+static inline size_t _ascii_rspace(const char* s, size_t n) {
+    size_t end = n;
+#if defined(_TOOLS_SSE2)
+    if (tools_simd_level() >= 1)
+        for (; end >= 16; end -= 16) {
+            unsigned rest = ~_sse2_space_mask(s + end - 16) & 0xFFFF;
+            if (rest) return n - (end - 16 + 32 - (size_t)__builtin_clz(rest));
+        }
+#elif defined(_TOOLS_NEON)
+    if (tools_simd_level() >= 1)
+        for (; end >= 16; end -= 16) {
+            uint64_t rest = ~_neon_space_mask(s + end - 16);
+            if (rest) return n - (end - 16 + (size_t)((64 - __builtin_clzll(rest)) >> 2));
+        }
+#endif
+    while (end > 0 && _ascii_is_space((unsigned char)s[end - 1])) end--;
+    return n - end;
+}
+
 /* --- String Search & Logic --- */
 
 static inline int str_starts(const char* s, const char* prefix) {
@@ -96,96 +770,2997 @@ static inline int str_contains(const char* s, const char* find) {
     return (s && find) ? strstr(s, find) != NULL : 0;
 }
 
-static inline int str_is_numeric(const char* s) {
-    if (!s || *s == '\0') return 0;
-    while (*s) { if (!isdigit(*s)) return 0; s++; }
-    return 1;
-}
+static inline int str_is_numeric_n(const char* s, size_t n) { return s && n && _ascii_digits(s, n) == n; }
+static inline int str_is_numeric(const char* s) { return s && str_is_numeric_n(s, strlen(s)); }
 
 /* --- String Formatting & Case --- */
 
-static inline void str_lower(char* s) { for(; *s; ++s) *s = tolower(*s); }
-static inline void str_upper(char* s) { for(; *s; ++s) *s = toupper(*s); }
+static inline void str_lower_n(char* s, size_t n) { _ascii_flip(s, n, 'A'); }
+static inline void str_upper_n(char* s, size_t n) { _ascii_flip(s, n, 'a'); }
+static inline void str_lower(char* s) { str_lower_n(s, strlen(s)); }
+static inline void str_upper(char* s) { str_upper_n(s, strlen(s)); }
+
+// Explicit-length trim: returns the first non-space byte and stores the trimmed
+// length in *len. Nothing is written, so s need not be NUL-terminated.
+static inline char* str_trim_n(char* s, size_t* len) {
+    size_t lead = _ascii_lspace(s, *len);
+    *len -= lead;
+    *len -= _ascii_rspace(s + lead, *len);
+    return s + lead;
+}
 
 static inline char* str_trim(char* s) {
-    char* end;
-    while(isspace((unsigned char)*s)) s++;
-    if(*s == 0) return s;
-    end = s + strlen(s) - 1;
-    while(end > s && isspace((unsigned char)*end)) end--;
-    end[1] = '\0';
+    size_t len = strlen(s);
+    s = str_trim_n(s, &len);
+    s[len] = '\0';
     return s;
 }
 
 static inline char* str_format(const char* fmt, ...) {
-    char* res = (char*)malloc(MAX_HTTP_BUF);
+    qol_sb sb = {0};
     va_list args; va_start(args, fmt);
-    vsprintf(res, fmt, args);
+    int ok = sb_vappendf(&sb, fmt, args);
     va_end(args);
-    return res;
+    if (!ok) { sb_free(&sb); return NULL; }
+    return sb.data;
 }
 
-static inline char* str_url_decode(const char* src) {
-    if (!src) return NULL;
-    char *res = (char*)malloc(strlen(src) + 1);
-    char *p = res;
-    while (*src) {
-        if (*src == '%' && isxdigit(src[1]) && isxdigit(src[2])) {
-            char hex[3] = { src[1], src[2], 0 };
-            *p++ = (char)strtol(hex, NULL, 16);
-            src += 3;
-        } else if (*src == '+') {
-            *p++ = ' '; src++;
-        } else {
-            *p++ = *src++;
+/* --- String Views --- */
+
+// qol_sv itself lives in SimpleParse/qol_sv.h so both modules share one type.
+#ifndef QOL_H
+    #include "../SimpleParse/qol_sv.h"
+#endif
+
+#define SV_NPOS ((size_t)-1)
+#define SV(lit) sv_n(lit, sizeof(lit) - 1) // string literals only: length at compile time
+#define SV_FMT "%.*s"
+#define SV_ARG(v) (int)(v).len, (v).ptr
+
+static inline qol_sv sv_n(const char* p, size_t n) { qol_sv v; v.ptr = p; v.len = n; return v; }
+static inline qol_sv sv_from(const char* s) { return sv_n(s, s ? strlen(s) : 0); }
+
+// Clamped to the view: out-of-range starts give an empty view at the end.
+static inline qol_sv sv_sub(qol_sv s, size_t start, size_t len) {
+    if (start > s.len) start = s.len;
+    if (len > s.len - start) len = s.len - start;
+    return sv_n(s.ptr + start, len);
+}
+
+static inline int sv_eq(qol_sv a, qol_sv b) { return a.len == b.len && (a.len == 0 || memcmp(a.ptr, b.ptr, a.len) == 0); }
+static inline int sv_starts(qol_sv s, qol_sv prefix) { return !prefix.len || (s.len >= prefix.len && memcmp(s.ptr, prefix.ptr, prefix.len) == 0); }
+static inline int sv_ends(qol_sv s, qol_sv suffix) { return !suffix.len || (s.len >= suffix.len && memcmp(s.ptr + s.len - suffix.len, suffix.ptr, suffix.len) == 0); }
+
+// Offset of the first match, or SV_NPOS. An empty needle matches at 0.
+static inline size_t sv_find(qol_sv s, qol_sv needle) {
+    if (!needle.len) return 0;
+    const char* p = _str_find(s.ptr, s.len, needle.ptr, needle.len);
+    return p ? (size_t)(p - s.ptr) : SV_NPOS;
+}
+
+static inline size_t sv_find_byte(qol_sv s, char c) {
+    const char* p = s.len ? (const char*)memchr(s.ptr, c, s.len) : NULL;
+    return p ? (size_t)(p - s.ptr) : SV_NPOS;
+}
+
+static inline size_t sv_rfind_byte(qol_sv s, char c) {
+    for (size_t i = s.len; i-- > 0;) if (s.ptr[i] == c) return i;
+    return SV_NPOS;
+}
+
+static inline int sv_contains(qol_sv s, qol_sv needle) { return sv_find(s, needle) != SV_NPOS; }
+
+// Non-overlapping matches, i.e. how many replacements str_replace_all would make.
+static inline size_t sv_count(qol_sv s, qol_sv needle) {
+    if (!needle.len || needle.len > s.len) return 0;
+    if (needle.len == 1) return _str_count_byte(s.ptr, s.len, needle.ptr[0]);
+    size_t n = 0;
+    const char *p = s.ptr, *end = s.ptr + s.len;
+    while ((p = _str_find(p, (size_t)(end - p), needle.ptr, needle.len))) { n++; p += needle.len; }
+    return n;
+}
+
+static inline qol_sv sv_ltrim(qol_sv s) { size_t k = _ascii_lspace(s.ptr, s.len); return sv_n(s.ptr + k, s.len - k); }
+static inline qol_sv sv_rtrim(qol_sv s) { return sv_n(s.ptr, s.len - _ascii_rspace(s.ptr, s.len)); }
+static inline qol_sv sv_trim(qol_sv s) { return sv_rtrim(sv_ltrim(s)); }
+
+// Splits s at the first delim: *before / *after get the two sides (either may
+// be NULL). Returns 0 and leaves them untouched if delim does not occur.
+static inline int sv_cut(qol_sv s, qol_sv delim, qol_sv* before, qol_sv* after) {
+    size_t at = sv_find(s, delim);
+    if (at == SV_NPOS || !delim.len) return 0;
+    if (before) *before = sv_n(s.ptr, at);
+    if (after) *after = sv_n(s.ptr + at + delim.len, s.len - at - delim.len);
+    return 1;
+}
+
+// Tokenizer: stores the next field of *rest in *tok and advances *rest past the
+// delimiter. Returns 0 once the input is used up. Adjacent delimiters give
+// empty fields, and "a,b," yields "a", "b", "".
+//
+//   qol_sv rest = sv_from(csv), f;
+//   while (sv_split_next(&rest, SV(","), &f)) printf(SV_FMT "\n", SV_ARG(f));
+static inline int sv_split_next(qol_sv* rest, qol_sv delim, qol_sv* tok) {
+    if (!rest->ptr) return 0;
+    if (!sv_cut(*rest, delim, tok, rest)) {
+        *tok = *rest;
+        rest->ptr = NULL; rest->len = 0;
+    }
+    return 1;
+}
+
+// Owned, NUL-terminated copy for when a view has to outlive its buffer.
+static inline char* sv_dup(qol_sv s) {
+    char* p = (char*)QOL_MALLOC(s.len + 1);
+    if (!p) return NULL;
+    if (s.len) memcpy(p, s.ptr, s.len);
+    p[s.len] = '\0';
+    return p;
+}
+
+static inline int sb_append_sv(qol_sb* sb, qol_sv s) { return sb_append_n(sb, s.ptr, s.len); }
+
+/* --- URL Codec --- */
+
+// Hex digit value of each byte, 255 for non-hex.
+static const unsigned char _url_hexval[256] = {
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,0,1,2,3,4,5,6,7,8,9,255,255,255,255,255,255,
+    255,10,11,12,13,14,15,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,10,11,12,13,14,15,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+    255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
+};
+
+// RFC 3986 unreserved bytes: A-Z a-z 0-9 - _ . ~
+static const unsigned char _url_safe[256] = {
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,1,1,0,1,1,1,1,1,1,1,1,1,1,0,0,0,0,0,0,
+    0,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0,0,0,0,1,
+    0,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0,0,0,1,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+};
+
+typedef struct { char* key; size_t key_len; char* val; size_t val_len; } qol_url_pair;
+
+// Length of the prefix of s[0..n) that contains no '%' or '+'.
+static inline size_t _url_plain_prefix(const char* s, size_t n) {
+    size_t i = 0;
+#ifdef _TOOLS_SSE2
+    const __m128i pct = _mm_set1_epi8('%'), plus = _mm_set1_epi8('+');
+    for (; i + 16 <= n; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(s + i));
+        unsigned m = (unsigned)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(x, pct), _mm_cmpeq_epi8(x, plus)));
+        if (m) return i + (size_t)__builtin_ctz(m);
+    }
+#endif
+    while (i < n && s[i] != '%' && s[i] != '+') i++;
+    return i;
+}
+
+// Decodes src[0..n) into dst and returns the decoded length; no NUL is written.
+// "+" becomes a space and malformed escapes are copied as-is. dst may equal src
+// (the output never outgrows the input), which makes this an in-place decoder.
+static inline size_t url_decode_n(char* dst, const char* src, size_t n) {
+    size_t i = 0, o = 0;
+    while (i < n) {
+        unsigned char c = (unsigned char)src[i];
+        if (c == '%' && i + 2 < n) {
+            unsigned hi = _url_hexval[(unsigned char)src[i + 1]], lo = _url_hexval[(unsigned char)src[i + 2]];
+            if ((hi | lo) < 16) { dst[o++] = (char)(hi << 4 | lo); i += 3; continue; }
         }
+        if (c == '+') { dst[o++] = ' '; i++; continue; }
+        // A plain run (a malformed '%' counts as its first byte). Short runs
+        // are copied inline; dst never runs ahead of src, so forward copy is safe.
+        size_t run = 1 + _url_plain_prefix(src + i + 1, n - i - 1);
+        if (dst + o != src + i) {
+            if (run < 16) for (size_t k = 0; k < run; k++) dst[o + k] = src[i + k];
+            else memmove(dst + o, src + i, run);
+        }
+        i += run; o += run;
     }
-    *p = '\0';
-    return res;
+    return o;
 }
 
-/* --- Time Tools --- */
+// In-place decode of a NUL-terminated string. Returns the new length.
+static inline size_t url_decode_inplace(char* s) {
+    size_t len = url_decode_n(s, s, strlen(s));
+    s[len] = '\0';
+    return len;
+}
 
-static inline char* time_now() {
-    static char buf[32];
-    time_t now = time(NULL);
-    struct tm *t = localtime(&now);
-    strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", t);
-    return buf;
+static inline char* str_url_decode(const char* src) {
+    if (!src) return NULL;
+    size_t n = strlen(src);
+    char* res = (char*)QOL_MALLOC(n + 1);
+    if (!res) return NULL;
+    res[url_decode_n(res, src, n)] = '\0';
+    return res;
 }
 
-static inline long time_unix() { return (long)time(NULL); }
+// Percent-encodes everything outside the RFC 3986 unreserved set (spaces
+// become "+" when form is set). Returns the full encoded length; dst is only
+// written, with a NUL, when cap > that length.
+static inline size_t url_encode_n(char* dst, size_t cap, const char* src, size_t n, int form) {
+    static const char hex[] = "0123456789ABCDEF";
+    size_t len = n;
+    for (size_t i = 0; i < n; i++) len += _url_safe[(unsigned char)src[i]] ? 0 : (form && src[i] == ' ') ? 0 : 2;
+    if (!dst || len >= cap) { if (dst && cap) dst[0] = '\0'; return len; }
+    char* w = dst;
+    for (size_t i = 0; i < n; i++) {
+        unsigned char c = (unsigned char)src[i];
+        if (_url_safe[c]) *w++ = (char)c;
+        else if (form && c == ' ') *w++ = '+';
+        else { w[0] = '%'; w[1] = hex[c >> 4]; w[2] = hex[c & 15]; w += 3; }
+    }
+    *w = '\0';
+    return len;
+}
 
-/* --- JSON Builder --- */
+static inline char* str_url_encode(const char* src) {
+    if (!src) return NULL;
+    size_t n = strlen(src), len = url_encode_n(NULL, 0, src, n, 0);
+    char* res = (char*)QOL_MALLOC(len + 1);
+    if (!res) return NULL;
+    url_encode_n(res, len + 1, src, n, 0);
+    return res;
+}
 
-static inline char* json_obj(const char* fmt, ...) {
-    char* res = (char*)malloc(8192);
-    strcpy(res, "{");
-    va_list args; va_start(args, fmt);
-    char* fmt_copy = strdup(fmt);
-    char* token = strtok(fmt_copy, ", ");
-    while (token) {
-        char type = token[0];
-        char* key = strchr(token, ':');
-        if (key) {
-            key++; strcat(res, "\""); strcat(res, key); strcat(res, "\":");
-            if (type == 's') {
-                char* val = va_arg(args, char*);
-                strcat(res, "\""); strcat(res, val); strcat(res, "\"");
-            } else if (type == 'i') {
-                sprintf(res + strlen(res), "%d", va_arg(args, int));
-            } else if (type == 'f') {
-                sprintf(res + strlen(res), "%.2f", va_arg(args, double));
-            } else if (type == 'b') {
-                strcat(res, va_arg(args, int) ? "true" : "false");
-            }
+static inline int sb_url_encode(qol_sb* sb, const char* src, size_t n, int form) {
+    size_t len = url_encode_n(NULL, 0, src, n, form);
+    if (!sb_reserve(sb, len)) return 0;
+    url_encode_n(sb->data + sb->len, len + 1, src, n, form);
+    sb->len += len;
+    return 1;
+}
+
+// Splits a query string ("a=1&b=x%20y", a leading '?' and a trailing "#frag"
+// are skipped) into at most max pairs in one pass. Keys and values are decoded
+// in place and NUL-terminated, so query is modified and the pairs point into
+// it. A key without '=' gets an empty value. Returns the number of pairs.
+static inline int url_query_parse(char* query, qol_url_pair* out, int max) {
+    if (!query) return 0;
+    char* p = query + (*query == '?');
+    char* end = p + strcspn(p, "#");
+    int count = 0;
+    while (p < end && count < max) {
+        char* amp = (char*)memchr(p, '&', (size_t)(end - p));
+        char* stop = amp ? amp : end;
+        if (stop > p) {
+            char* eq = (char*)memchr(p, '=', (size_t)(stop - p));
+            char* kend = eq ? eq : stop;
+            qol_url_pair* pr = &out[count++];
+            pr->key = p;
+            pr->key_len = url_decode_n(p, p, (size_t)(kend - p));
+            pr->val = eq ? eq + 1 : kend;
+            pr->val_len = eq ? url_decode_n(eq + 1, eq + 1, (size_t)(stop - eq - 1)) : 0;
+            pr->key[pr->key_len] = '\0';
+            pr->val[pr->val_len] = '\0';
         }
-        token = strtok(NULL, ", ");
-        if (token) strcat(res, ", ");
+        p = stop + 1;
     }
-    strcat(res, "}");
-    free(fmt_copy); va_end(args);
-    return res;
+    return count;
+}
+
+/* --- Base64 & Hex Codecs --- */
+
+#define CODEC_ERROR ((size_t)-1)
+
+static const char _b64_std[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char _b64_url[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+// Sextet for each byte of either alphabet. '+' and '/' also carry 0x80, '-' and
+// '_' carry 0x40, and invalid bytes are 255 (both), so one table serves both
+// alphabets: a byte is rejected when it has the other alphabet's bit.
+static const unsigned char _b64_val[256] = {
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 190, 255, 126, 255, 191,
+    52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 255, 255, 255, 255, 255, 255,
+    255, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 255, 255, 255, 255, 127,
+    255, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255
+};
+
+// Encoded size: padded to a multiple of 4 for the standard alphabet, unpadded for URL-safe.
+static inline size_t b64_encoded_len(size_t n, int url) { return url ? n / 3 * 4 + (n % 3 ? n % 3 + 1 : 0) : (n + 2) / 3 * 4; }
+
+// Upper bound on decoded size for n input characters.
+static inline size_t b64_decoded_max(size_t n) { return (n + 3) / 4 * 3; }
+
+#ifdef _TOOLS_X86_SIMD
+// SSSE3 is not part of the x86-64 baseline, so it is checked separately; AVX2 implies it.
+static inline int _tools_ssse3() { return tools_simd_level() >= 1 && __builtin_cpu_supports("ssse3"); }
+
+// Base64 kernels after Muła and Lemire ("Faster Base64 Encoding and Decoding
+// using AVX2 Instructions"): pshufb splits 12 bytes into 16 sextets, a second
+// pshufb turns sextets into offsets for the alphabet, and decoding validates
+// with two nibble lookups before packing with two multiply-adds.
+__attribute__((target("ssse3")))
+static inline __m128i _b64_enc_ssse3_block(__m128i in, __m128i shift_lut) {
+    in = _mm_shuffle_epi8(in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+    __m128i t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+    __m128i idx = _mm_or_si128(t0, t1);
+    // 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12: the slot holding that range's offset.
+    __m128i slot = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+    slot = _mm_or_si128(slot, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), idx), _mm_set1_epi8(13)));
+    return _mm_add_epi8(_mm_shuffle_epi8(shift_lut, slot), idx);
+}
+
+__attribute__((target("ssse3")))
+static inline size_t _b64_enc_ssse3(char* dst, const unsigned char* src, size_t n, int url) {
+    const __m128i lut = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                      '0' - 52, '0' - 52, '0' - 52, (char)((url ? '-' : '+') - 62), (char)((url ? '_' : '/') - 63), 'A', 0, 0);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 12, dst += 16)
+        _mm_storeu_si128((__m128i*)dst, _b64_enc_ssse3_block(_mm_loadu_si128((const __m128i*)(src + i)), lut));
+    return i;
 }
 
+__attribute__((target("avx2")))
+static inline size_t _b64_enc_avx2(char* dst, const unsigned char* src, size_t n, int url) {
+    const __m128i lut128 = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                         '0' - 52, '0' - 52, '0' - 52, (char)((url ? '-' : '+') - 62), (char)((url ? '_' : '/') - 63), 'A', 0, 0);
+    const __m256i lut = _mm256_broadcastsi128_si256(lut128);
+    const __m256i shuf = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                          1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    size_t i = 0;
+    for (; i + 28 <= n; i += 24, dst += 32) {
+        // Two overlapping 16-byte loads put 12 input bytes at the bottom of each lane.
+        __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(src + i))),
+                                             _mm_loadu_si128((const __m128i*)(src + i + 12)), 1);
+        in = _mm256_shuffle_epi8(in, shuf);
+        __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+        __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+        __m256i idx = _mm256_or_si256(t0, t1);
+        __m256i slot = _mm256_subs_epu8(idx, _mm256_set1_epi8(51));
+        slot = _mm256_or_si256(slot, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), idx), _mm256_set1_epi8(13)));
+        _mm256_storeu_si256((__m256i*)dst, _mm256_add_epi8(_mm256_shuffle_epi8(lut, slot), idx));
+    }
+    return i;
+}
+
+// Decode LUTs: lo/hi classify each byte by its nibbles (any common bit = not in
+// the standard alphabet); roll is the offset to add, indexed by the high nibble
+// (minus one for '/').
+#define _B64_DEC_LUTS \
+    0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A
+#define _B64_DEC_LUTH \
+    0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10
+#define _B64_DEC_ROLL \
+    0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0
+
+// Returns the number of input bytes consumed (a multiple of 16); stops early at
+// the first block holding anything but alphabet characters.
+__attribute__((target("ssse3")))
+static inline size_t _b64_dec_ssse3(unsigned char* dst, const char* src, size_t n, int url) {
+    const __m128i lut_lo = _mm_setr_epi8(_B64_DEC_LUTS), lut_hi = _mm_setr_epi8(_B64_DEC_LUTH), lut_roll = _mm_setr_epi8(_B64_DEC_ROLL);
+    const __m128i m2f = _mm_set1_epi8(0x2F);
+    size_t i = 0;
+    for (; i + 24 <= n; i += 16, dst += 12) {
+        __m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+        if (url) {
+            // '-' and '_' become '+' and '/'; a real '+' or '/' is an error.
+            __m128i minus = _mm_cmpeq_epi8(s, _mm_set1_epi8('-')), under = _mm_cmpeq_epi8(s, _mm_set1_epi8('_'));
+            if (_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(s, _mm_set1_epi8('+')), _mm_cmpeq_epi8(s, _mm_set1_epi8('/'))))) break;
+            s = _mm_add_epi8(s, _mm_or_si128(_mm_and_si128(minus, _mm_set1_epi8('+' - '-')), _mm_and_si128(under, _mm_set1_epi8('/' - '_'))));
+        }
+        __m128i hi_nib = _mm_and_si128(_mm_srli_epi32(s, 4), m2f);
+        __m128i bad = _mm_and_si128(_mm_shuffle_epi8(lut_lo, _mm_and_si128(s, m2f)), _mm_shuffle_epi8(lut_hi, hi_nib));
+        if (_mm_movemask_epi8(_mm_cmpgt_epi8(bad, _mm_setzero_si128()))) break;
+        s = _mm_add_epi8(s, _mm_shuffle_epi8(lut_roll, _mm_add_epi8(_mm_cmpeq_epi8(s, m2f), hi_nib)));
+        s = _mm_madd_epi16(_mm_maddubs_epi16(s, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+        s = _mm_shuffle_epi8(s, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        _mm_storeu_si128((__m128i*)dst, s);
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static inline size_t _b64_dec_avx2(unsigned char* dst, const char* src, size_t n, int url) {
+    const __m256i lut_lo = _mm256_setr_epi8(_B64_DEC_LUTS, _B64_DEC_LUTS), lut_hi = _mm256_setr_epi8(_B64_DEC_LUTH, _B64_DEC_LUTH);
+    const __m256i lut_roll = _mm256_setr_epi8(_B64_DEC_ROLL, _B64_DEC_ROLL), m2f = _mm256_set1_epi8(0x2F);
+    const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                          2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    size_t i = 0;
+    for (; i + 48 <= n; i += 32, dst += 24) {
+        __m256i s = _mm256_loadu_si256((const __m256i*)(src + i));
+        if (url) {
+            __m256i minus = _mm256_cmpeq_epi8(s, _mm256_set1_epi8('-')), under = _mm256_cmpeq_epi8(s, _mm256_set1_epi8('_'));
+            if (_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(s, _mm256_set1_epi8('+')), _mm256_cmpeq_epi8(s, _mm256_set1_epi8('/'))))) break;
+            s = _mm256_add_epi8(s, _mm256_or_si256(_mm256_and_si256(minus, _mm256_set1_epi8('+' - '-')), _mm256_and_si256(under, _mm256_set1_epi8('/' - '_'))));
+        }
+        __m256i hi_nib = _mm256_and_si256(_mm256_srli_epi32(s, 4), m2f);
+        if (!_mm256_testz_si256(_mm256_shuffle_epi8(lut_lo, _mm256_and_si256(s, m2f)), _mm256_shuffle_epi8(lut_hi, hi_nib))) break;
+        s = _mm256_add_epi8(s, _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(_mm256_cmpeq_epi8(s, m2f), hi_nib)));
+        s = _mm256_madd_epi16(_mm256_maddubs_epi16(s, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000));
+        s = _mm256_shuffle_epi8(s, pack);
+        _mm256_storeu_si256((__m256i*)dst, _mm256_permutevar8x32_epi32(s, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7)));
+    }
+    return i;
+}
+#endif
+
+// Encodes n bytes; returns the number of characters written (no NUL).
+static inline size_t _b64_enc_run(char* dst, const unsigned char* src, size_t n, int url) {
+    const char* a = url ? _b64_url : _b64_std;
+    char* d = dst;
+    size_t i = 0;
+#ifdef _TOOLS_X86_SIMD
+    if (tools_simd_level() >= 2) i = _b64_enc_avx2(d, src, n, url);
+    else if (_tools_ssse3()) i = _b64_enc_ssse3(d, src, n, url);
+    d += i / 3 * 4;
+#endif
+    for (; i + 3 <= n; i += 3, d += 4) {
+        unsigned v = (unsigned)src[i] << 16 | (unsigned)src[i + 1] << 8 | src[i + 2];
+        d[0] = a[v >> 18]; d[1] = a[v >> 12 & 63]; d[2] = a[v >> 6 & 63]; d[3] = a[v & 63];
+    }
+    if (i < n) {
+        unsigned v = (unsigned)src[i] << 16 | (i + 1 < n ? (unsigned)src[i + 1] << 8 : 0);
+        *d++ = a[v >> 18]; *d++ = a[v >> 12 & 63];
+        if (i + 1 < n) *d++ = a[v >> 6 & 63];
+        else if (!url) *d++ = '=';
+        if (!url) *d++ = '=';
+    }
+    return (size_t)(d - dst);
+}
+
+// Decodes n characters, a multiple of 4, with no padding. Returns bytes written or CODEC_ERROR.
+static inline size_t _b64_dec_quads(unsigned char* dst, const char* src, size_t n, int url) {
+    const unsigned reject = url ? 0x80 : 0x40;
+    unsigned char* d = dst;
+    size_t i = 0;
+#ifdef _TOOLS_X86_SIMD
+    if (tools_simd_level() >= 2) i = _b64_dec_avx2(d, src, n, url);
+    if (_tools_ssse3()) i += _b64_dec_ssse3(d + i / 4 * 3, src + i, n - i, url);
+    d += i / 4 * 3;
+#endif
+    for (; i < n; i += 4, d += 3) {
+        unsigned a = _b64_val[(unsigned char)src[i]], b = _b64_val[(unsigned char)src[i + 1]];
+        unsigned c = _b64_val[(unsigned char)src[i + 2]], e = _b64_val[(unsigned char)src[i + 3]];
+        if ((a | b | c | e) & reject) return CODEC_ERROR;
+        unsigned v = (a & 63) << 18 | (b & 63) << 12 | (c & 63) << 6 | (e & 63);
+        d[0] = (unsigned char)(v >> 16); d[1] = (unsigned char)(v >> 8); d[2] = (unsigned char)v;
+    }
+    return (size_t)(d - dst);
+}
+
+// Final group of 2 or 3 characters (padding already removed).
+static inline size_t _b64_dec_tail(unsigned char* dst, const char* src, size_t n, int url) {
+    const unsigned reject = url ? 0x80 : 0x40;
+    unsigned a = _b64_val[(unsigned char)src[0]], b = _b64_val[(unsigned char)src[1]];
+    unsigned c = n > 2 ? _b64_val[(unsigned char)src[2]] : 0;
+    if (n < 2 || ((a | b | c) & reject)) return CODEC_ERROR;
+    unsigned v = (a & 63) << 18 | (b & 63) << 12 | (c & 63) << 6;
+    dst[0] = (unsigned char)(v >> 16);
+    if (n > 2) dst[1] = (unsigned char)(v >> 8);
+    return n - 1;
+}
+
+// Writes the encoding of src[0..n) and a NUL into dst (b64_encoded_len + 1 bytes).
+// url selects the URL-safe alphabet (- and _) without padding.
+static inline size_t b64_encode(char* dst, const void* src, size_t n, int url) {
+    size_t len = _b64_enc_run(dst, (const unsigned char*)src, n, url);
+    dst[len] = '\0';
+    return len;
+}
+
+// Decodes n characters into dst (b64_decoded_max(n) bytes). Padding is optional
+// in both alphabets. Returns the byte count, or CODEC_ERROR on a character
+// outside the alphabet, misplaced '=' or an impossible length.
+static inline size_t b64_decode(void* dst, const char* src, size_t n, int url) {
+    size_t body = n;
+    if (body && src[body - 1] == '=') body--;
+    if (body && src[body - 1] == '=') body--;
+    if ((body != n && n % 4) || body % 4 == 1) return CODEC_ERROR;
+    size_t full = body & ~(size_t)3;
+    size_t out = _b64_dec_quads((unsigned char*)dst, src, full, url);
+    if (out == CODEC_ERROR || full == body) return out;
+    size_t tail = _b64_dec_tail((unsigned char*)dst + out, src + full, body - full, url);
+    return tail == CODEC_ERROR ? tail : out + tail;
+}
+
+static inline char* str_b64_encode(const void* src, size_t n, int url) {
+    char* out = (char*)QOL_MALLOC(b64_encoded_len(n, url) + 1);
+    if (out) b64_encode(out, src, n, url);
+    return out;
+}
+
+static inline int sb_b64_encode(qol_sb* sb, const void* src, size_t n, int url) {
+    if (!sb_reserve(sb, b64_encoded_len(n, url))) return 0;
+    sb->len += b64_encode(sb->data + sb->len, src, n, url);
+    return 1;
+}
+
+// Streaming: feed any chunk sizes; up to 2 input bytes (encode) or 3 characters
+// (decode) are carried between calls.
+typedef struct { unsigned char carry[4]; int n; int url; int done; } qol_b64_stream;
+
+static inline void b64_stream_init(qol_b64_stream* st, int url) { memset(st, 0, sizeof(*st)); st->url = url; }
+
+// dst must hold b64_encoded_len(n + 2, 0) bytes. Returns characters written.
+static inline size_t b64_encode_update(qol_b64_stream* st, char* dst, const void* src, size_t n) {
+    const unsigned char* s = (const unsigned char*)src;
+    size_t out = 0;
+    if (st->n) {
+        while (st->n < 3 && n) { st->carry[st->n++] = *s++; n--; }
+        if (st->n < 3) return 0;
+        out = _b64_enc_run(dst, st->carry, 3, st->url);
+        st->n = 0;
+    }
+    size_t whole = n / 3 * 3;
+    out += _b64_enc_run(dst + out, s, whole, st->url);
+    for (size_t i = whole; i < n; i++) st->carry[st->n++] = s[i];
+    return out;
+}
+
+// Flushes the last 1-2 bytes (with padding for the standard alphabet) and a NUL.
+static inline size_t b64_encode_final(qol_b64_stream* st, char* dst) {
+    size_t out = _b64_enc_run(dst, st->carry, (size_t)st->n, st->url);
+    dst[out] = '\0';
+    st->n = 0;
+    return out;
+}
+
+// Decodes one complete group that may end in padding.
+static inline size_t _b64_dec_group(qol_b64_stream* st, unsigned char* dst, const char* g) {
+    if (g[3] != '=') return _b64_dec_quads(dst, g, 4, st->url);
+    st->done = 1;
+    return _b64_dec_tail(dst, g, g[2] == '=' ? 2 : 3, st->url);
+}
+
+// dst must hold b64_decoded_max(n + 3) bytes. Returns bytes written or CODEC_ERROR.
+static inline size_t b64_decode_update(qol_b64_stream* st, void* dst, const char* src, size_t n) {
+    unsigned char* d = (unsigned char*)dst;
+    size_t out = 0, r;
+    if (n && st->done) return CODEC_ERROR;
+    if (st->n) {
+        while (st->n < 4 && n) { st->carry[st->n++] = (unsigned char)*src++; n--; }
+        if (st->n < 4) return 0;
+        st->n = 0;
+        if ((r = _b64_dec_group(st, d, (const char*)st->carry)) == CODEC_ERROR) return r;
+        out = r;
+        if (n && st->done) return CODEC_ERROR;
+    }
+    size_t whole = n & ~(size_t)3;
+    if (whole) {
+        size_t body = src[whole - 1] == '=' ? whole - 4 : whole;
+        if ((r = _b64_dec_quads(d + out, src, body, st->url)) == CODEC_ERROR) return r;
+        out += r;
+        if (body != whole) {
+            if ((r = _b64_dec_group(st, d + out, src + body)) == CODEC_ERROR || n != whole) return CODEC_ERROR;
+            out += r;
+        }
+    }
+    for (size_t i = whole; i < n; i++) st->carry[st->n++] = (unsigned char)src[i];
+    return out;
+}
+
+// Decodes an unpadded final group of 2-3 characters, if any.
+static inline size_t b64_decode_final(qol_b64_stream* st, void* dst) {
+    size_t n = (size_t)st->n;
+    st->n = 0;
+    return n ? _b64_dec_tail((unsigned char*)dst, (const char*)st->carry, n, st->url) : 0;
+}
+
+#ifdef _TOOLS_SSE2
+// Nibbles to '0'-'9' / 'a'-'f'.
+static inline __m128i _hex_sse2_chars(__m128i nib) {
+    return _mm_add_epi8(nib, _mm_add_epi8(_mm_set1_epi8('0'), _mm_and_si128(_mm_cmpgt_epi8(nib, _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10))));
+}
+
+// Hex characters to nibbles; *bad collects lanes that are not hex digits.
+static inline __m128i _hex_sse2_nibbles(__m128i c, __m128i* bad) {
+    __m128i lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+    __m128i digit = _sse2_in_range(c, '0', 10), alpha = _sse2_in_range(lower, 'a', 6);
+    *bad = _mm_or_si128(*bad, _mm_andnot_si128(_mm_or_si128(digit, alpha), _mm_set1_epi8(-1)));
+    return _mm_or_si128(_mm_and_si128(digit, _mm_sub_epi8(c, _mm_set1_epi8('0'))),
+                        _mm_and_si128(alpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+}
+
+// Pairs of nibbles (first one high) in each 16-bit lane to bytes.
+static inline __m128i _hex_sse2_pack(__m128i a, __m128i b) {
+    const __m128i low = _mm_set1_epi16(0x00FF);
+    a = _mm_and_si128(_mm_or_si128(_mm_slli_epi16(a, 4), _mm_srli_epi16(a, 8)), low);
+    b = _mm_and_si128(_mm_or_si128(_mm_slli_epi16(b, 4), _mm_srli_epi16(b, 8)), low);
+    return _mm_packus_epi16(a, b);
+}
+#endif
+
+#ifdef _TOOLS_X86_SIMD
+__attribute__((target("avx2")))
+static inline size_t _hex_enc_avx2(char* dst, const unsigned char* src, size_t n) {
+    const __m256i m = _mm256_set1_epi8(0x0F), nine = _mm256_set1_epi8(9);
+    const __m256i zero = _mm256_set1_epi8('0'), gap = _mm256_set1_epi8('a' - '0' - 10);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), m), lo = _mm256_and_si256(v, m);
+        hi = _mm256_add_epi8(hi, _mm256_add_epi8(zero, _mm256_and_si256(_mm256_cmpgt_epi8(hi, nine), gap)));
+        lo = _mm256_add_epi8(lo, _mm256_add_epi8(zero, _mm256_and_si256(_mm256_cmpgt_epi8(lo, nine), gap)));
+        __m256i a = _mm256_unpacklo_epi8(hi, lo), b = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256((__m256i*)(dst + 2 * i), _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256((__m256i*)(dst + 2 * i + 32), _mm256_permute2x128_si256(a, b, 0x31));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+static inline size_t _hex_dec_avx2(unsigned char* dst, const char* src, size_t n) {
+    const __m256i low = _mm256_set1_epi16(0x00FF);
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m256i nib[2], bad = _mm256_setzero_si256();
+        for (int k = 0; k < 2; k++) {
+            __m256i c = _mm256_loadu_si256((const __m256i*)(src + i + 32 * k));
+            __m256i lower = _mm256_or_si256(c, _mm256_set1_epi8(0x20));
+            __m256i digit = _avx2_in_range(c, '0', 10), alpha = _avx2_in_range(lower, 'a', 6);
+            bad = _mm256_or_si256(bad, _mm256_andnot_si256(_mm256_or_si256(digit, alpha), _mm256_set1_epi8(-1)));
+            __m256i v = _mm256_or_si256(_mm256_and_si256(digit, _mm256_sub_epi8(c, _mm256_set1_epi8('0'))),
+                                        _mm256_and_si256(alpha, _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10))));
+            nib[k] = _mm256_and_si256(_mm256_or_si256(_mm256_slli_epi16(v, 4), _mm256_srli_epi16(v, 8)), low);
+        }
+        if (_mm256_movemask_epi8(bad)) break;
+        // packus works per lane; restore byte order with a 64-bit permute.
+        __m256i out = _mm256_permute4x64_epi64(_mm256_packus_epi16(nib[0], nib[1]), 0xD8);
+        _mm256_storeu_si256((__m256i*)(dst + i / 2), out);
+    }
+    return i;
+}
+#endif
+
+// Writes 2n lowercase hex digits and a NUL into dst. Returns 2n.
+static inline size_t hex_encode(char* dst, const void* src, size_t n) {
+    const unsigned char* s = (const unsigned char*)src;
+    size_t i = 0;
+#ifdef _TOOLS_X86_SIMD
+    if (tools_simd_level() >= 2) i = _hex_enc_avx2(dst, s, n);
+#endif
+#ifdef _TOOLS_SSE2
+    if (tools_simd_level() >= 1 && n >= 16) {
+        for (; i <= n - 16; i += 16) {
+            __m128i v = _mm_loadu_si128((const __m128i*)(s + i));
+            __m128i hi = _hex_sse2_chars(_mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0F)));
+            __m128i lo = _hex_sse2_chars(_mm_and_si128(v, _mm_set1_epi8(0x0F)));
+            _mm_storeu_si128((__m128i*)(dst + 2 * i), _mm_unpacklo_epi8(hi, lo));
+            _mm_storeu_si128((__m128i*)(dst + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+        }
+    }
+#endif
+    for (; i < n; i++) memcpy(dst + 2 * i, _hex_pairs + 2 * s[i], 2);
+    dst[2 * n] = '\0';
+    return 2 * n;
+}
+
+// Decodes n hex digits (either case) into n / 2 bytes. Returns the byte count,
+// or CODEC_ERROR for an odd length or a non-hex character.
+static inline size_t hex_decode(void* dst, const char* src, size_t n) {
+    unsigned char* d = (unsigned char*)dst;
+    if (n % 2) return CODEC_ERROR;
+    size_t i = 0;
+#ifdef _TOOLS_X86_SIMD
+    if (tools_simd_level() >= 2) i = _hex_dec_avx2(d, src, n);
+#endif
+#ifdef _TOOLS_SSE2
+    if (tools_simd_level() >= 1 && n >= 32) {
+        for (; i <= n - 32; i += 32) {
+            __m128i bad = _mm_setzero_si128();
+            __m128i a = _hex_sse2_nibbles(_mm_loadu_si128((const __m128i*)(src + i)), &bad);
+            __m128i b = _hex_sse2_nibbles(_mm_loadu_si128((const __m128i*)(src + i + 16)), &bad);
+            if (_mm_movemask_epi8(bad)) return CODEC_ERROR;
+            _mm_storeu_si128((__m128i*)(d + i / 2), _hex_sse2_pack(a, b));
+        }
+    }
+#endif
+    for (; i < n; i += 2) {
+        unsigned hi = _url_hexval[(unsigned char)src[i]], lo = _url_hexval[(unsigned char)src[i + 1]];
+        if ((hi | lo) > 15) return CODEC_ERROR;
+        d[i / 2] = (unsigned char)(hi << 4 | lo);
+    }
+    return n / 2;
+}
+
+/* --- Time Tools --- */
+
+#if defined(_MSC_VER)
+    #define _TOOLS_TLS __declspec(thread)
+#else
+    #define _TOOLS_TLS __thread
+#endif
+
+#define TIME_NOW_LEN 20 // "YYYY-MM-DD HH:MM:SS" plus the NUL
+
+// Each thread keeps the last second it formatted, so a log line only pays for
+// time() and a 20-byte copy; localtime runs at most once per second per thread.
+typedef struct { time_t sec; char text[TIME_NOW_LEN]; } _time_cache;
+
+// Formats sec as local "YYYY-MM-DD HH:MM:SS" into p (TIME_NOW_LEN bytes).
+static inline void _time_format(time_t sec, char* p) {
+    struct tm t;
+#if defined(_WIN32)
+    localtime_s(&t, &sec);
+#elif defined(_TOOLS_POSIX_TIME)
+    localtime_r(&sec, &t);
+#else
+    struct tm* lt = localtime(&sec);
+    memset(&t, 0, sizeof(t));
+    if (lt) t = *lt;
+#endif
+    int v[6] = { t.tm_year + 1900, t.tm_mon + 1, t.tm_mday, t.tm_hour, t.tm_min, t.tm_sec };
+    p[0] = (char)('0' + v[0] / 1000 % 10); p[1] = (char)('0' + v[0] / 100 % 10);
+    p[2] = (char)('0' + v[0] / 10 % 10);   p[3] = (char)('0' + v[0] % 10);
+    for (int i = 1; i < 6; i++) {
+        p[1 + i * 3] = i == 3 ? ' ' : i < 3 ? '-' : ':';
+        p[2 + i * 3] = (char)('0' + v[i] / 10);
+        p[3 + i * 3] = (char)('0' + v[i] % 10);
+    }
+    p[19] = '\0';
+}
+
+static inline const _time_cache* _time_refresh() {
+    static _TOOLS_TLS _time_cache cache = { (time_t)-1, { 0 } };
+    time_t now = time(NULL);
+    if (now != cache.sec) {
+        _time_format(now, cache.text);
+        cache.sec = now;
+    }
+    return &cache;
+}
+
+// Copies the local time as "YYYY-MM-DD HH:MM:SS" into buf (TIME_NOW_LEN bytes).
+static inline char* time_now_r(char* buf) {
+    memcpy(buf, _time_refresh()->text, TIME_NOW_LEN);
+    return buf;
+}
+
+// Same text, in a buffer owned by the calling thread (valid until its next call).
+static inline char* time_now() {
+    static _TOOLS_TLS char buf[TIME_NOW_LEN];
+    return time_now_r(buf);
+}
+
+static inline long time_unix() { return (long)time(NULL); }
+
+// Monotonic nanoseconds for measuring intervals; unrelated to wall-clock time.
+static inline unsigned long long time_mono_ns() {
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+    if (!freq.QuadPart) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (unsigned long long)(now.QuadPart / freq.QuadPart) * 1000000000ULL +
+           (unsigned long long)(now.QuadPart % freq.QuadPart) * 1000000000ULL / (unsigned long long)freq.QuadPart;
+#elif defined(_TOOLS_POSIX_TIME)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+#else
+    struct timespec ts;   // Wall clock: may step, but keeps strict ISO builds working.
+    timespec_get(&ts, TIME_UTC);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+#endif
+}
+
+// Raw cycle counter for micro-measurements: the TSC on x86 (constant rate, not
+// core clock), the virtual counter on AArch64, time_mono_ns elsewhere. Only
+// differences on the same machine are meaningful.
+static inline unsigned long long time_cycles() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    return __builtin_ia32_rdtsc();
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return __rdtsc();
+#elif defined(__GNUC__) && defined(__aarch64__)
+    unsigned long long v;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#else
+    return time_mono_ns();
+#endif
+}
+
+/* --- String Interning --- */
+
+#ifdef _WIN32
+    typedef SRWLOCK _tools_mutex;
+    #define _tools_mutex_init(m)    InitializeSRWLock(m)
+    #define _tools_mutex_destroy(m) ((void)(m))
+    #define _tools_lock(m)          AcquireSRWLockExclusive(m)
+    #define _tools_unlock(m)        ReleaseSRWLockExclusive(m)
+#else
+    typedef pthread_mutex_t _tools_mutex;
+    #define _tools_mutex_init(m)    pthread_mutex_init(m, NULL)
+    #define _tools_mutex_destroy(m) pthread_mutex_destroy(m)
+    #define _tools_lock(m)          pthread_mutex_lock(m)
+    #define _tools_unlock(m)        pthread_mutex_unlock(m)
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    #define _tools_load_ptr(p)     InterlockedCompareExchangePointer((void* volatile*)(p), NULL, NULL)
+    #define _tools_store_ptr(p, v) InterlockedExchangePointer((void* volatile*)(p), (void*)(v))
+#else
+    #define _tools_load_ptr(p)     __atomic_load_n(p, __ATOMIC_ACQUIRE)
+    #define _tools_store_ptr(p, v) __atomic_store_n(p, v, __ATOMIC_RELEASE)
+#endif
+
+#define INTERN_BLOCK 65536
+
+// Interned strings live in arena blocks and are never moved or freed before
+// intern_free, so the returned pointers are stable handles: two strings are
+// equal exactly when their pointers are. Each string is preceded by its atom
+// and length, which is what intern_atom_of / intern_len read.
+typedef struct _intern_block { struct _intern_block* next; size_t used, cap; } _intern_block;
+
+// Slots are written once: hash first, then str with a release store, so lookups
+// run without the lock. A grown table replaces the old one, which stays readable
+// (chained through prev) until intern_free.
+typedef struct { const char* str; unsigned long long hash; } _intern_slot;
+typedef struct _intern_table { struct _intern_table* prev; size_t mask; } _intern_table;
+#define _INTERN_SLOTS(t) ((_intern_slot*)(void*)((t) + 1))
+
+typedef struct {
+    _tools_mutex lock;    // serializes inserts
+    _intern_table* table;
+    unsigned count;
+    const char** strs;    // strs[atom - 1], guarded by lock
+    unsigned strs_cap;
+    _intern_block* blocks;
+} qol_intern;
+
+static inline unsigned long long _intern_hash(const char* s, size_t n) {
+    const unsigned long long k = 0x9E3779B97F4A7C15ULL;
+    unsigned long long h = n * k, w = 0;
+    unsigned lo, hi;
+    if (n >= 8) {
+        const char* end = s + n - 8;
+        for (; s < end; s += 8) {
+            memcpy(&w, s, 8);
+            h = (h ^ w) * k;
+            h ^= h >> 29;
+        }
+        memcpy(&w, end, 8); // overlaps the last full word instead of a byte loop
+    } else if (n >= 4) {
+        memcpy(&lo, s, 4); memcpy(&hi, s + n - 4, 4);
+        w = (unsigned long long)hi << 32 | lo;
+    } else if (n) {
+        w = (unsigned char)s[0] | (unsigned)(unsigned char)s[n / 2] << 8 | (unsigned)(unsigned char)s[n - 1] << 16;
+    }
+    h = (h ^ w) * k;
+    h ^= h >> 32; h *= 0xD6E8FEB86659FD93ULL; h ^= h >> 32;
+    return h;
+}
+
+static inline const unsigned* _intern_hdr(const char* p) { return (const unsigned*)(const void*)p - 2; }
+
+// Atom of an interned pointer; 0 for NULL.
+static inline unsigned intern_atom_of(const char* p) { return p ? _intern_hdr(p)[0] : 0; }
+
+// Length of an interned string without scanning it.
+static inline size_t intern_len(const char* p) { return p ? _intern_hdr(p)[1] : 0; }
+
+static inline _intern_table* _intern_table_new(size_t cap, _intern_table* prev) {
+    size_t bytes = sizeof(_intern_table) + cap * sizeof(_intern_slot);
+    _intern_table* t = (_intern_table*)QOL_MALLOC(bytes);
+    if (t) { memset(t, 0, bytes); t->prev = prev; t->mask = cap - 1; }
+    return t;
+}
+
+static inline int intern_init(qol_intern* in) {
+    memset(in, 0, sizeof(*in));
+    in->table = _intern_table_new(256, NULL);
+    if (!in->table) return 0;
+    _tools_mutex_init(&in->lock);
+    return 1;
+}
+
+static inline void intern_free(qol_intern* in) {
+    _intern_block* b = in->blocks;
+    while (b) { _intern_block* next = b->next; QOL_FREE(b); b = next; }
+    _intern_table* t = in->table;
+    while (t) { _intern_table* prev = t->prev; QOL_FREE(t); t = prev; }
+    QOL_FREE((void*)in->strs);
+    _tools_mutex_destroy(&in->lock);
+    memset(in, 0, sizeof(*in));
+}
+
+// Returns the slot holding s, or the empty slot where it would go; *found gets
+// the string seen there (NULL for the empty slot).
+static inline _intern_slot* _intern_probe(_intern_table* t, const char* s, size_t n, unsigned long long h, const char** found) {
+    _intern_slot* slots = _INTERN_SLOTS(t);
+    for (size_t i = (size_t)h & t->mask;; i = (i + 1) & t->mask) {
+        const char* p = (const char*)_tools_load_ptr(&slots[i].str);
+        if (!p || (slots[i].hash == h && _intern_hdr(p)[1] == n && memcmp(p, s, n) == 0)) {
+            *found = p;
+            return &slots[i];
+        }
+    }
+}
+
+// Copies s into the arena with its [atom, len] header. Caller holds the lock.
+static inline char* _intern_store(qol_intern* in, const char* s, size_t n, unsigned atom) {
+    size_t need = (2 * sizeof(unsigned) + n + 1 + 7) & ~(size_t)7;
+    _intern_block* b = in->blocks;
+    if (!b || b->cap - b->used < need) {
+        size_t cap = need > INTERN_BLOCK / 4 ? need : INTERN_BLOCK;
+        _intern_block* nb = (_intern_block*)QOL_MALLOC(sizeof(_intern_block) + cap);
+        if (!nb) return NULL;
+        nb->used = 0; nb->cap = cap;
+        // A dedicated block for a long string goes behind the current one so the
+        // current block keeps filling.
+        if (b && cap != INTERN_BLOCK) { nb->next = b->next; b->next = nb; }
+        else { nb->next = b; in->blocks = nb; }
+        b = nb;
+    }
+    unsigned* hdr = (unsigned*)(void*)((char*)(b + 1) + b->used);
+    b->used += need;
+    hdr[0] = atom; hdr[1] = (unsigned)n;
+    char* p = (char*)(hdr + 2);
+    memcpy(p, s, n);
+    p[n] = '\0';
+    return p;
+}
+
+// Rehashes into a table twice the size and publishes it. Caller holds the lock.
+static inline int _intern_grow(qol_intern* in) {
+    _intern_table* old = in->table;
+    _intern_table* t = _intern_table_new((old->mask + 1) * 2, old);
+    if (!t) return 0;
+    _intern_slot *from = _INTERN_SLOTS(old), *to = _INTERN_SLOTS(t);
+    for (size_t i = 0; i <= old->mask; i++) {
+        if (!from[i].str) continue;
+        size_t j = (size_t)from[i].hash & t->mask;
+        while (to[j].str) j = (j + 1) & t->mask;
+        to[j] = from[i];
+    }
+    _tools_store_ptr(&in->table, t);
+    return 1;
+}
+
+// Returns the pooled copy of s[0..n), adding it on first sight. NULL on allocation failure.
+static inline const char* intern_n(qol_intern* in, const char* s, size_t n) {
+    if (n > UINT_MAX / 2) return NULL;
+    unsigned long long h = _intern_hash(s, n);
+    const char* p;
+    _intern_slot* sl = _intern_probe((_intern_table*)_tools_load_ptr(&in->table), s, n, h, &p);
+    if (p) return p;
+
+    _tools_lock(&in->lock);
+    sl = _intern_probe(in->table, s, n, h, &p); // the table may have grown, or another thread added s
+    if (p) goto done;
+    if ((size_t)(in->count + 1) * 4 > (in->table->mask + 1) * 3) {
+        if (!_intern_grow(in)) goto done;
+        sl = _intern_probe(in->table, s, n, h, &p);
+    }
+    if (in->count == in->strs_cap) {
+        unsigned cap = in->strs_cap ? in->strs_cap * 2 : 256;
+        const char** strs = (const char**)QOL_REALLOC((void*)in->strs, cap * sizeof(*strs));
+        if (!strs) goto done;
+        in->strs = strs; in->strs_cap = cap;
+    }
+    p = _intern_store(in, s, n, in->count + 1);
+    if (p) {
+        in->strs[in->count++] = p;
+        sl->hash = h;
+        _tools_store_ptr(&sl->str, p);
+    }
+done:
+    _tools_unlock(&in->lock);
+    return p;
+}
+
+static inline const char* intern(qol_intern* in, const char* s) { return intern_n(in, s, strlen(s)); }
+
+// Looks s up without adding it; NULL if it was never interned. Use this for
+// untrusted input (request paths, header names) so it cannot grow the pool.
+static inline const char* intern_find_n(qol_intern* in, const char* s, size_t n) {
+    const char* p = NULL;
+    if (n <= UINT_MAX / 2) _intern_probe((_intern_table*)_tools_load_ptr(&in->table), s, n, _intern_hash(s, n), &p);
+    return p;
+}
+
+static inline const char* intern_find(qol_intern* in, const char* s) { return intern_find_n(in, s, strlen(s)); }
+
+// Integer handles: atoms are dense, start at 1, and 0 means failure / not found.
+static inline unsigned intern_atom_n(qol_intern* in, const char* s, size_t n) { return intern_atom_of(intern_n(in, s, n)); }
+static inline unsigned intern_atom(qol_intern* in, const char* s) { return intern_atom_of(intern(in, s)); }
+
+// String for an atom, or NULL if the atom is unknown.
+static inline const char* intern_str(qol_intern* in, unsigned atom) {
+    _tools_lock(&in->lock);
+    const char* p = atom && atom <= in->count ? in->strs[atom - 1] : NULL;
+    _tools_unlock(&in->lock);
+    return p;
+}
+
+static inline unsigned intern_count(qol_intern* in) {
+    _tools_lock(&in->lock);
+    unsigned n = in->count;
+    _tools_unlock(&in->lock);
+    return n;
+}
+
+/* --- Number Formatting & Parsing --- */
+
+// Slow paths stay out of line so the fast paths inline small.
+#if defined(__GNUC__)
+    #define _TOOLS_COLD __attribute__((noinline, cold))
+#else
+    #define _TOOLS_COLD
+#endif
+
+#define FMT_INT_MAX 21    // "-9223372036854775808" plus the NUL
+#define FMT_DOUBLE_MAX 32 // longest fmt_double output is 25 bytes plus the NUL
+
+static const char _dec_pairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static inline int _fmt_u64_len(unsigned long long v) {
+    int n = 1;
+    for (;;) {
+        if (v < 10) return n;
+        if (v < 100) return n + 1;
+        if (v < 1000) return n + 2;
+        if (v < 10000) return n + 3;
+        v /= 10000; n += 4;
+    }
+}
+
+// Writes v and a NUL into dst (FMT_INT_MAX bytes) and returns the length.
+// Digits are produced two at a time from the end.
+static inline size_t fmt_u64(char* dst, unsigned long long v) {
+    int n = _fmt_u64_len(v);
+    char* p = dst + n;
+    *p = '\0';
+    while (v >= 100) {
+        unsigned r = (unsigned)(v % 100);
+        v /= 100;
+        p -= 2; memcpy(p, _dec_pairs + 2 * r, 2);
+    }
+    if (v >= 10) { p -= 2; memcpy(p, _dec_pairs + 2 * v, 2); }
+    else *--p = (char)('0' + v);
+    return (size_t)n;
+}
+
+static inline size_t fmt_i64(char* dst, long long v) {
+    if (v >= 0) return fmt_u64(dst, (unsigned long long)v);
+    *dst = '-';
+    return 1 + fmt_u64(dst + 1, 0ULL - (unsigned long long)v);
+}
+
+// floor(2^128-normalized mantissa) of 10^q for q = -348..347, as { high, low }.
+// The binary exponent of row q is (217706 * q >> 16) - 127.
+#define _FMT_POW10_MIN -348
+#define _FMT_POW10_MAX 347
+static const unsigned long long _fmt_pow10[][2] = {
+    { 0xFA8FD5A0081C0288ULL, 0x1732C869CD60E453ULL }, { 0x9C99E58405118195ULL, 0x0E7FBD42205C8EB4ULL },
+    { 0xC3C05EE50655E1FAULL, 0x521FAC92A873B261ULL }, { 0xF4B0769E47EB5A78ULL, 0xE6A797B752909EF9ULL },
+    { 0x98EE4A22ECF3188BULL, 0x9028BED2939A635CULL }, { 0xBF29DCABA82FDEAEULL, 0x7432EE873880FC33ULL },
+    { 0xEEF453D6923BD65AULL, 0x113FAA2906A13B3FULL }, { 0x9558B4661B6565F8ULL, 0x4AC7CA59A424C507ULL },
+    { 0xBAAEE17FA23EBF76ULL, 0x5D79BCF00D2DF649ULL }, { 0xE95A99DF8ACE6F53ULL, 0xF4D82C2C107973DCULL },
+    { 0x91D8A02BB6C10594ULL, 0x79071B9B8A4BE869ULL }, { 0xB64EC836A47146F9ULL, 0x9748E2826CDEE284ULL },
+    { 0xE3E27A444D8D98B7ULL, 0xFD1B1B2308169B25ULL }, { 0x8E6D8C6AB0787F72ULL, 0xFE30F0F5E50E20F7ULL },
+    { 0xB208EF855C969F4FULL, 0xBDBD2D335E51A935ULL }, { 0xDE8B2B66B3BC4723ULL, 0xAD2C788035E61382ULL },
+    { 0x8B16FB203055AC76ULL, 0x4C3BCB5021AFCC31ULL }, { 0xADDCB9E83C6B1793ULL, 0xDF4ABE242A1BBF3DULL },
+    { 0xD953E8624B85DD78ULL, 0xD71D6DAD34A2AF0DULL }, { 0x87D4713D6F33AA6BULL, 0x8672648C40E5AD68ULL },
+    { 0xA9C98D8CCB009506ULL, 0x680EFDAF511F18C2ULL }, { 0xD43BF0EFFDC0BA48ULL, 0x0212BD1B2566DEF2ULL },
+    { 0x84A57695FE98746DULL, 0x014BB630F7604B57ULL }, { 0xA5CED43B7E3E9188ULL, 0x419EA3BD35385E2DULL },
+    { 0xCF42894A5DCE35EAULL, 0x52064CAC828675B9ULL }, { 0x818995CE7AA0E1B2ULL, 0x7343EFEBD1940993ULL },
+    { 0xA1EBFB4219491A1FULL, 0x1014EBE6C5F90BF8ULL }, { 0xCA66FA129F9B60A6ULL, 0xD41A26E077774EF6ULL },
+    { 0xFD00B897478238D0ULL, 0x8920B098955522B4ULL }, { 0x9E20735E8CB16382ULL, 0x55B46E5F5D5535B0ULL },
+    { 0xC5A890362FDDBC62ULL, 0xEB2189F734AA831DULL }, { 0xF712B443BBD52B7BULL, 0xA5E9EC7501D523E4ULL },
+    { 0x9A6BB0AA55653B2DULL, 0x47B233C92125366EULL }, { 0xC1069CD4EABE89F8ULL, 0x999EC0BB696E840AULL },
+    { 0xF148440A256E2C76ULL, 0xC00670EA43CA250DULL }, { 0x96CD2A865764DBCAULL, 0x380406926A5E5728ULL },
+    { 0xBC807527ED3E12BCULL, 0xC605083704F5ECF2ULL }, { 0xEBA09271E88D976BULL, 0xF7864A44C633682EULL },
+    { 0x93445B8731587EA3ULL, 0x7AB3EE6AFBE0211DULL }, { 0xB8157268FDAE9E4CULL, 0x5960EA05BAD82964ULL },
+    { 0xE61ACF033D1A45DFULL, 0x6FB92487298E33BDULL }, { 0x8FD0C16206306BABULL, 0xA5D3B6D479F8E056ULL },
+    { 0xB3C4F1BA87BC8696ULL, 0x8F48A4899877186CULL }, { 0xE0B62E2929ABA83CULL, 0x331ACDABFE94DE87ULL },
+    { 0x8C71DCD9BA0B4925ULL, 0x9FF0C08B7F1D0B14ULL }, { 0xAF8E5410288E1B6FULL, 0x07ECF0AE5EE44DD9ULL },
+    { 0xDB71E91432B1A24AULL, 0xC9E82CD9F69D6150ULL }, { 0x892731AC9FAF056EULL, 0xBE311C083A225CD2ULL },
+    { 0xAB70FE17C79AC6CAULL, 0x6DBD630A48AAF406ULL }, { 0xD64D3D9DB981787DULL, 0x092CBBCCDAD5B108ULL },
+    { 0x85F0468293F0EB4EULL, 0x25BBF56008C58EA5ULL }, { 0xA76C582338ED2621ULL, 0xAF2AF2B80AF6F24EULL },
+    { 0xD1476E2C07286FAAULL, 0x1AF5AF660DB4AEE1ULL }, { 0x82CCA4DB847945CAULL, 0x50D98D9FC890ED4DULL },
+    { 0xA37FCE126597973CULL, 0xE50FF107BAB528A0ULL }, { 0xCC5FC196FEFD7D0CULL, 0x1E53ED49A96272C8ULL },
+    { 0xFF77B1FCBEBCDC4FULL, 0x25E8E89C13BB0F7AULL }, { 0x9FAACF3DF73609B1ULL, 0x77B191618C54E9ACULL },
+    { 0xC795830D75038C1DULL, 0xD59DF5B9EF6A2417ULL }, { 0xF97AE3D0D2446F25ULL, 0x4B0573286B44AD1DULL },
+    { 0x9BECCE62836AC577ULL, 0x4EE367F9430AEC32ULL }, { 0xC2E801FB244576D5ULL, 0x229C41F793CDA73FULL },
+    { 0xF3A20279ED56D48AULL, 0x6B43527578C1110FULL }, { 0x9845418C345644D6ULL, 0x830A13896B78AAA9ULL },
+    { 0xBE5691EF416BD60CULL, 0x23CC986BC656D553ULL }, { 0xEDEC366B11C6CB8FULL, 0x2CBFBE86B7EC8AA8ULL },
+    { 0x94B3A202EB1C3F39ULL, 0x7BF7D71432F3D6A9ULL }, { 0xB9E08A83A5E34F07ULL, 0xDAF5CCD93FB0CC53ULL },
+    { 0xE858AD248F5C22C9ULL, 0xD1B3400F8F9CFF68ULL }, { 0x91376C36D99995BEULL, 0x23100809B9C21FA1ULL },
+    { 0xB58547448FFFFB2DULL, 0xABD40A0C2832A78AULL }, { 0xE2E69915B3FFF9F9ULL, 0x16C90C8F323F516CULL },
+    { 0x8DD01FAD907FFC3BULL, 0xAE3DA7D97F6792E3ULL }, { 0xB1442798F49FFB4AULL, 0x99CD11CFDF41779CULL },
+    { 0xDD95317F31C7FA1DULL, 0x40405643D711D583ULL }, { 0x8A7D3EEF7F1CFC52ULL, 0x482835EA666B2572ULL },
+    { 0xAD1C8EAB5EE43B66ULL, 0xDA3243650005EECFULL }, { 0xD863B256369D4A40ULL, 0x90BED43E40076A82ULL },
+    { 0x873E4F75E2224E68ULL, 0x5A7744A6E804A291ULL }, { 0xA90DE3535AAAE202ULL, 0x711515D0A205CB36ULL },
+    { 0xD3515C2831559A83ULL, 0x0D5A5B44CA873E03ULL }, { 0x8412D9991ED58091ULL, 0xE858790AFE9486C2ULL },
+    { 0xA5178FFF668AE0B6ULL, 0x626E974DBE39A872ULL }, { 0xCE5D73FF402D98E3ULL, 0xFB0A3D212DC8128FULL },
+    { 0x80FA687F881C7F8EULL, 0x7CE66634BC9D0B99ULL }, { 0xA139029F6A239F72ULL, 0x1C1FFFC1EBC44E80ULL },
+    { 0xC987434744AC874EULL, 0xA327FFB266B56220ULL }, { 0xFBE9141915D7A922ULL, 0x4BF1FF9F0062BAA8ULL },
+    { 0x9D71AC8FADA6C9B5ULL, 0x6F773FC3603DB4A9ULL }, { 0xC4CE17B399107C22ULL, 0xCB550FB4384D21D3ULL },
+    { 0xF6019DA07F549B2BULL, 0x7E2A53A146606A48ULL }, { 0x99C102844F94E0FBULL, 0x2EDA7444CBFC426DULL },
+    { 0xC0314325637A1939ULL, 0xFA911155FEFB5308ULL }, { 0xF03D93EEBC589F88ULL, 0x793555AB7EBA27CAULL },
+    { 0x96267C7535B763B5ULL, 0x4BC1558B2F3458DEULL }, { 0xBBB01B9283253CA2ULL, 0x9EB1AAEDFB016F16ULL },
+    { 0xEA9C227723EE8BCBULL, 0x465E15A979C1CADCULL }, { 0x92A1958A7675175FULL, 0x0BFACD89EC191EC9ULL },
+    { 0xB749FAED14125D36ULL, 0xCEF980EC671F667BULL }, { 0xE51C79A85916F484ULL, 0x82B7E12780E7401AULL },
+    { 0x8F31CC0937AE58D2ULL, 0xD1B2ECB8B0908810ULL }, { 0xB2FE3F0B8599EF07ULL, 0x861FA7E6DCB4AA15ULL },
+    { 0xDFBDCECE67006AC9ULL, 0x67A791E093E1D49AULL }, { 0x8BD6A141006042BDULL, 0xE0C8BB2C5C6D24E0ULL },
+    { 0xAECC49914078536DULL, 0x58FAE9F773886E18ULL }, { 0xDA7F5BF590966848ULL, 0xAF39A475506A899EULL },
+    { 0x888F99797A5E012DULL, 0x6D8406C952429603ULL }, { 0xAAB37FD7D8F58178ULL, 0xC8E5087BA6D33B83ULL },
+    { 0xD5605FCDCF32E1D6ULL, 0xFB1E4A9A90880A64ULL }, { 0x855C3BE0A17FCD26ULL, 0x5CF2EEA09A55067FULL },
+    { 0xA6B34AD8C9DFC06FULL, 0xF42FAA48C0EA481EULL }, { 0xD0601D8EFC57B08BULL, 0xF13B94DAF124DA26ULL },
+    { 0x823C12795DB6CE57ULL, 0x76C53D08D6B70858ULL }, { 0xA2CB1717B52481EDULL, 0x54768C4B0C64CA6EULL },
+    { 0xCB7DDCDDA26DA268ULL, 0xA9942F5DCF7DFD09ULL }, { 0xFE5D54150B090B02ULL, 0xD3F93B35435D7C4CULL },
+    { 0x9EFA548D26E5A6E1ULL, 0xC47BC5014A1A6DAFULL }, { 0xC6B8E9B0709F109AULL, 0x359AB6419CA1091BULL },
+    { 0xF867241C8CC6D4C0ULL, 0xC30163D203C94B62ULL }, { 0x9B407691D7FC44F8ULL, 0x79E0DE63425DCF1DULL },
+    { 0xC21094364DFB5636ULL, 0x985915FC12F542E4ULL }, { 0xF294B943E17A2BC4ULL, 0x3E6F5B7B17B2939DULL },
+    { 0x979CF3CA6CEC5B5AULL, 0xA705992CEECF9C42ULL }, { 0xBD8430BD08277231ULL, 0x50C6FF782A838353ULL },
+    { 0xECE53CEC4A314EBDULL, 0xA4F8BF5635246428ULL }, { 0x940F4613AE5ED136ULL, 0x871B7795E136BE99ULL },
+    { 0xB913179899F68584ULL, 0x28E2557B59846E3FULL }, { 0xE757DD7EC07426E5ULL, 0x331AEADA2FE589CFULL },
+    { 0x9096EA6F3848984FULL, 0x3FF0D2C85DEF7621ULL }, { 0xB4BCA50B065ABE63ULL, 0x0FED077A756B53A9ULL },
+    { 0xE1EBCE4DC7F16DFBULL, 0xD3E8495912C62894ULL }, { 0x8D3360F09CF6E4BDULL, 0x64712DD7ABBBD95CULL },
+    { 0xB080392CC4349DECULL, 0xBD8D794D96AACFB3ULL }, { 0xDCA04777F541C567ULL, 0xECF0D7A0FC5583A0ULL },
+    { 0x89E42CAAF9491B60ULL, 0xF41686C49DB57244ULL }, { 0xAC5D37D5B79B6239ULL, 0x311C2875C522CED5ULL },
+    { 0xD77485CB25823AC7ULL, 0x7D633293366B828BULL }, { 0x86A8D39EF77164BCULL, 0xAE5DFF9C02033197ULL },
+    { 0xA8530886B54DBDEBULL, 0xD9F57F830283FDFCULL }, { 0xD267CAA862A12D66ULL, 0xD072DF63C324FD7BULL },
+    { 0x8380DEA93DA4BC60ULL, 0x4247CB9E59F71E6DULL }, { 0xA46116538D0DEB78ULL, 0x52D9BE85F074E608ULL },
+    { 0xCD795BE870516656ULL, 0x67902E276C921F8BULL }, { 0x806BD9714632DFF6ULL, 0x00BA1CD8A3DB53B6ULL },
+    { 0xA086CFCD97BF97F3ULL, 0x80E8A40ECCD228A4ULL }, { 0xC8A883C0FDAF7DF0ULL, 0x6122CD128006B2CDULL },
+    { 0xFAD2A4B13D1B5D6CULL, 0x796B805720085F81ULL }, { 0x9CC3A6EEC6311A63ULL, 0xCBE3303674053BB0ULL },
+    { 0xC3F490AA77BD60FCULL, 0xBEDBFC4411068A9CULL }, { 0xF4F1B4D515ACB93BULL, 0xEE92FB5515482D44ULL },
+    { 0x991711052D8BF3C5ULL, 0x751BDD152D4D1C4AULL }, { 0xBF5CD54678EEF0B6ULL, 0xD262D45A78A0635DULL },
+    { 0xEF340A98172AACE4ULL, 0x86FB897116C87C34ULL }, { 0x9580869F0E7AAC0EULL, 0xD45D35E6AE3D4DA0ULL },
+    { 0xBAE0A846D2195712ULL, 0x8974836059CCA109ULL }, { 0xE998D258869FACD7ULL, 0x2BD1A438703FC94BULL },
+    { 0x91FF83775423CC06ULL, 0x7B6306A34627DDCFULL }, { 0xB67F6455292CBF08ULL, 0x1A3BC84C17B1D542ULL },
+    { 0xE41F3D6A7377EECAULL, 0x20CABA5F1D9E4A93ULL }, { 0x8E938662882AF53EULL, 0x547EB47B7282EE9CULL },
+    { 0xB23867FB2A35B28DULL, 0xE99E619A4F23AA43ULL }, { 0xDEC681F9F4C31F31ULL, 0x6405FA00E2EC94D4ULL },
+    { 0x8B3C113C38F9F37EULL, 0xDE83BC408DD3DD04ULL }, { 0xAE0B158B4738705EULL, 0x9624AB50B148D445ULL },
+    { 0xD98DDAEE19068C76ULL, 0x3BADD624DD9B0957ULL }, { 0x87F8A8D4CFA417C9ULL, 0xE54CA5D70A80E5D6ULL },
+    { 0xA9F6D30A038D1DBCULL, 0x5E9FCF4CCD211F4CULL }, { 0xD47487CC8470652BULL, 0x7647C3200069671FULL },
+    { 0x84C8D4DFD2C63F3BULL, 0x29ECD9F40041E073ULL }, { 0xA5FB0A17C777CF09ULL, 0xF468107100525890ULL },
+    { 0xCF79CC9DB955C2CCULL, 0x7182148D4066EEB4ULL }, { 0x81AC1FE293D599BFULL, 0xC6F14CD848405530ULL },
+    { 0xA21727DB38CB002FULL, 0xB8ADA00E5A506A7CULL }, { 0xCA9CF1D206FDC03BULL, 0xA6D90811F0E4851CULL },
+    { 0xFD442E4688BD304AULL, 0x908F4A166D1DA663ULL }, { 0x9E4A9CEC15763E2EULL, 0x9A598E4E043287FEULL },
+    { 0xC5DD44271AD3CDBAULL, 0x40EFF1E1853F29FDULL }, { 0xF7549530E188C128ULL, 0xD12BEE59E68EF47CULL },
+    { 0x9A94DD3E8CF578B9ULL, 0x82BB74F8301958CEULL }, { 0xC13A148E3032D6E7ULL, 0xE36A52363C1FAF01ULL },
+    { 0xF18899B1BC3F8CA1ULL, 0xDC44E6C3CB279AC1ULL }, { 0x96F5600F15A7B7E5ULL, 0x29AB103A5EF8C0B9ULL },
+    { 0xBCB2B812DB11A5DEULL, 0x7415D448F6B6F0E7ULL }, { 0xEBDF661791D60F56ULL, 0x111B495B3464AD21ULL },
+    { 0x936B9FCEBB25C995ULL, 0xCAB10DD900BEEC34ULL }, { 0xB84687C269EF3BFBULL, 0x3D5D514F40EEA742ULL },
+    { 0xE65829B3046B0AFAULL, 0x0CB4A5A3112A5112ULL }, { 0x8FF71A0FE2C2E6DCULL, 0x47F0E785EABA72ABULL },
+    { 0xB3F4E093DB73A093ULL, 0x59ED216765690F56ULL }, { 0xE0F218B8D25088B8ULL, 0x306869C13EC3532CULL },
+    { 0x8C974F7383725573ULL, 0x1E414218C73A13FBULL }, { 0xAFBD2350644EEACFULL, 0xE5D1929EF90898FAULL },
+    { 0xDBAC6C247D62A583ULL, 0xDF45F746B74ABF39ULL }, { 0x894BC396CE5DA772ULL, 0x6B8BBA8C328EB783ULL },
+    { 0xAB9EB47C81F5114FULL, 0x066EA92F3F326564ULL }, { 0xD686619BA27255A2ULL, 0xC80A537B0EFEFEBDULL },
+    { 0x8613FD0145877585ULL, 0xBD06742CE95F5F36ULL }, { 0xA798FC4196E952E7ULL, 0x2C48113823B73704ULL },
+    { 0xD17F3B51FCA3A7A0ULL, 0xF75A15862CA504C5ULL }, { 0x82EF85133DE648C4ULL, 0x9A984D73DBE722FBULL },
+    { 0xA3AB66580D5FDAF5ULL, 0xC13E60D0D2E0EBBAULL }, { 0xCC963FEE10B7D1B3ULL, 0x318DF905079926A8ULL },
+    { 0xFFBBCFE994E5C61FULL, 0xFDF17746497F7052ULL }, { 0x9FD561F1FD0F9BD3ULL, 0xFEB6EA8BEDEFA633ULL },
+    { 0xC7CABA6E7C5382C8ULL, 0xFE64A52EE96B8FC0ULL }, { 0xF9BD690A1B68637BULL, 0x3DFDCE7AA3C673B0ULL },
+    { 0x9C1661A651213E2DULL, 0x06BEA10CA65C084EULL }, { 0xC31BFA0FE5698DB8ULL, 0x486E494FCFF30A62ULL },
+    { 0xF3E2F893DEC3F126ULL, 0x5A89DBA3C3EFCCFAULL }, { 0x986DDB5C6B3A76B7ULL, 0xF89629465A75E01CULL },
+    { 0xBE89523386091465ULL, 0xF6BBB397F1135823ULL }, { 0xEE2BA6C0678B597FULL, 0x746AA07DED582E2CULL },
+    { 0x94DB483840B717EFULL, 0xA8C2A44EB4571CDCULL }, { 0xBA121A4650E4DDEBULL, 0x92F34D62616CE413ULL },
+    { 0xE896A0D7E51E1566ULL, 0x77B020BAF9C81D17ULL }, { 0x915E2486EF32CD60ULL, 0x0ACE1474DC1D122EULL },
+    { 0xB5B5ADA8AAFF80B8ULL, 0x0D819992132456BAULL }, { 0xE3231912D5BF60E6ULL, 0x10E1FFF697ED6C69ULL },
+    { 0x8DF5EFABC5979C8FULL, 0xCA8D3FFA1EF463C1ULL }, { 0xB1736B96B6FD83B3ULL, 0xBD308FF8A6B17CB2ULL },
+    { 0xDDD0467C64BCE4A0ULL, 0xAC7CB3F6D05DDBDEULL }, { 0x8AA22C0DBEF60EE4ULL, 0x6BCDF07A423AA96BULL },
+    { 0xAD4AB7112EB3929DULL, 0x86C16C98D2C953C6ULL }, { 0xD89D64D57A607744ULL, 0xE871C7BF077BA8B7ULL },
+    { 0x87625F056C7C4A8BULL, 0x11471CD764AD4972ULL }, { 0xA93AF6C6C79B5D2DULL, 0xD598E40D3DD89BCFULL },
+    { 0xD389B47879823479ULL, 0x4AFF1D108D4EC2C3ULL }, { 0x843610CB4BF160CBULL, 0xCEDF722A585139BAULL },
+    { 0xA54394FE1EEDB8FEULL, 0xC2974EB4EE658828ULL }, { 0xCE947A3DA6A9273EULL, 0x733D226229FEEA32ULL },
+    { 0x811CCC668829B887ULL, 0x0806357D5A3F525FULL }, { 0xA163FF802A3426A8ULL, 0xCA07C2DCB0CF26F7ULL },
+    { 0xC9BCFF6034C13052ULL, 0xFC89B393DD02F0B5ULL }, { 0xFC2C3F3841F17C67ULL, 0xBBAC2078D443ACE2ULL },
+    { 0x9D9BA7832936EDC0ULL, 0xD54B944B84AA4C0DULL }, { 0xC5029163F384A931ULL, 0x0A9E795E65D4DF11ULL },
+    { 0xF64335BCF065D37DULL, 0x4D4617B5FF4A16D5ULL }, { 0x99EA0196163FA42EULL, 0x504BCED1BF8E4E45ULL },
+    { 0xC06481FB9BCF8D39ULL, 0xE45EC2862F71E1D6ULL }, { 0xF07DA27A82C37088ULL, 0x5D767327BB4E5A4CULL },
+    { 0x964E858C91BA2655ULL, 0x3A6A07F8D510F86FULL }, { 0xBBE226EFB628AFEAULL, 0x890489F70A55368BULL },
+    { 0xEADAB0ABA3B2DBE5ULL, 0x2B45AC74CCEA842EULL }, { 0x92C8AE6B464FC96FULL, 0x3B0B8BC90012929DULL },
+    { 0xB77ADA0617E3BBCBULL, 0x09CE6EBB40173744ULL }, { 0xE55990879DDCAABDULL, 0xCC420A6A101D0515ULL },
+    { 0x8F57FA54C2A9EAB6ULL, 0x9FA946824A12232DULL }, { 0xB32DF8E9F3546564ULL, 0x47939822DC96ABF9ULL },
+    { 0xDFF9772470297EBDULL, 0x59787E2B93BC56F7ULL }, { 0x8BFBEA76C619EF36ULL, 0x57EB4EDB3C55B65AULL },
+    { 0xAEFAE51477A06B03ULL, 0xEDE622920B6B23F1ULL }, { 0xDAB99E59958885C4ULL, 0xE95FAB368E45ECEDULL },
+    { 0x88B402F7FD75539BULL, 0x11DBCB0218EBB414ULL }, { 0xAAE103B5FCD2A881ULL, 0xD652BDC29F26A119ULL },
+    { 0xD59944A37C0752A2ULL, 0x4BE76D3346F0495FULL }, { 0x857FCAE62D8493A5ULL, 0x6F70A4400C562DDBULL },
+    { 0xA6DFBD9FB8E5B88EULL, 0xCB4CCD500F6BB952ULL }, { 0xD097AD07A71F26B2ULL, 0x7E2000A41346A7A7ULL },
+    { 0x825ECC24C873782FULL, 0x8ED400668C0C28C8ULL }, { 0xA2F67F2DFA90563BULL, 0x728900802F0F32FAULL },
+    { 0xCBB41EF979346BCAULL, 0x4F2B40A03AD2FFB9ULL }, { 0xFEA126B7D78186BCULL, 0xE2F610C84987BFA8ULL },
+    { 0x9F24B832E6B0F436ULL, 0x0DD9CA7D2DF4D7C9ULL }, { 0xC6EDE63FA05D3143ULL, 0x91503D1C79720DBBULL },
+    { 0xF8A95FCF88747D94ULL, 0x75A44C6397CE912AULL }, { 0x9B69DBE1B548CE7CULL, 0xC986AFBE3EE11ABAULL },
+    { 0xC24452DA229B021BULL, 0xFBE85BADCE996168ULL }, { 0xF2D56790AB41C2A2ULL, 0xFAE27299423FB9C3ULL },
+    { 0x97C560BA6B0919A5ULL, 0xDCCD879FC967D41AULL }, { 0xBDB6B8E905CB600FULL, 0x5400E987BBC1C920ULL },
+    { 0xED246723473E3813ULL, 0x290123E9AAB23B68ULL }, { 0x9436C0760C86E30BULL, 0xF9A0B6720AAF6521ULL },
+    { 0xB94470938FA89BCEULL, 0xF808E40E8D5B3E69ULL }, { 0xE7958CB87392C2C2ULL, 0xB60B1D1230B20E04ULL },
+    { 0x90BD77F3483BB9B9ULL, 0xB1C6F22B5E6F48C2ULL }, { 0xB4ECD5F01A4AA828ULL, 0x1E38AEB6360B1AF3ULL },
+    { 0xE2280B6C20DD5232ULL, 0x25C6DA63C38DE1B0ULL }, { 0x8D590723948A535FULL, 0x579C487E5A38AD0EULL },
+    { 0xB0AF48EC79ACE837ULL, 0x2D835A9DF0C6D851ULL }, { 0xDCDB1B2798182244ULL, 0xF8E431456CF88E65ULL },
+    { 0x8A08F0F8BF0F156BULL, 0x1B8E9ECB641B58FFULL }, { 0xAC8B2D36EED2DAC5ULL, 0xE272467E3D222F3FULL },
+    { 0xD7ADF884AA879177ULL, 0x5B0ED81DCC6ABB0FULL }, { 0x86CCBB52EA94BAEAULL, 0x98E947129FC2B4E9ULL },
+    { 0xA87FEA27A539E9A5ULL, 0x3F2398D747B36224ULL }, { 0xD29FE4B18E88640EULL, 0x8EEC7F0D19A03AADULL },
+    { 0x83A3EEEEF9153E89ULL, 0x1953CF68300424ACULL }, { 0xA48CEAAAB75A8E2BULL, 0x5FA8C3423C052DD7ULL },
+    { 0xCDB02555653131B6ULL, 0x3792F412CB06794DULL }, { 0x808E17555F3EBF11ULL, 0xE2BBD88BBEE40BD0ULL },
+    { 0xA0B19D2AB70E6ED6ULL, 0x5B6ACEAEAE9D0EC4ULL }, { 0xC8DE047564D20A8BULL, 0xF245825A5A445275ULL },
+    { 0xFB158592BE068D2EULL, 0xEED6E2F0F0D56712ULL }, { 0x9CED737BB6C4183DULL, 0x55464DD69685606BULL },
+    { 0xC428D05AA4751E4CULL, 0xAA97E14C3C26B886ULL }, { 0xF53304714D9265DFULL, 0xD53DD99F4B3066A8ULL },
+    { 0x993FE2C6D07B7FABULL, 0xE546A8038EFE4029ULL }, { 0xBF8FDB78849A5F96ULL, 0xDE98520472BDD033ULL },
+    { 0xEF73D256A5C0F77CULL, 0x963E66858F6D4440ULL }, { 0x95A8637627989AADULL, 0xDDE7001379A44AA8ULL },
+    { 0xBB127C53B17EC159ULL, 0x5560C018580D5D52ULL }, { 0xE9D71B689DDE71AFULL, 0xAAB8F01E6E10B4A6ULL },
+    { 0x9226712162AB070DULL, 0xCAB3961304CA70E8ULL }, { 0xB6B00D69BB55C8D1ULL, 0x3D607B97C5FD0D22ULL },
+    { 0xE45C10C42A2B3B05ULL, 0x8CB89A7DB77C506AULL }, { 0x8EB98A7A9A5B04E3ULL, 0x77F3608E92ADB242ULL },
+    { 0xB267ED1940F1C61CULL, 0x55F038B237591ED3ULL }, { 0xDF01E85F912E37A3ULL, 0x6B6C46DEC52F6688ULL },
+    { 0x8B61313BBABCE2C6ULL, 0x2323AC4B3B3DA015ULL }, { 0xAE397D8AA96C1B77ULL, 0xABEC975E0A0D081AULL },
+    { 0xD9C7DCED53C72255ULL, 0x96E7BD358C904A21ULL }, { 0x881CEA14545C7575ULL, 0x7E50D64177DA2E54ULL },
+    { 0xAA242499697392D2ULL, 0xDDE50BD1D5D0B9E9ULL }, { 0xD4AD2DBFC3D07787ULL, 0x955E4EC64B44E864ULL },
+    { 0x84EC3C97DA624AB4ULL, 0xBD5AF13BEF0B113EULL }, { 0xA6274BBDD0FADD61ULL, 0xECB1AD8AEACDD58EULL },
+    { 0xCFB11EAD453994BAULL, 0x67DE18EDA5814AF2ULL }, { 0x81CEB32C4B43FCF4ULL, 0x80EACF948770CED7ULL },
+    { 0xA2425FF75E14FC31ULL, 0xA1258379A94D028DULL }, { 0xCAD2F7F5359A3B3EULL, 0x096EE45813A04330ULL },
+    { 0xFD87B5F28300CA0DULL, 0x8BCA9D6E188853FCULL }, { 0x9E74D1B791E07E48ULL, 0x775EA264CF55347DULL },
+    { 0xC612062576589DDAULL, 0x95364AFE032A819DULL }, { 0xF79687AED3EEC551ULL, 0x3A83DDBD83F52204ULL },
+    { 0x9ABE14CD44753B52ULL, 0xC4926A9672793542ULL }, { 0xC16D9A0095928A27ULL, 0x75B7053C0F178293ULL },
+    { 0xF1C90080BAF72CB1ULL, 0x5324C68B12DD6338ULL }, { 0x971DA05074DA7BEEULL, 0xD3F6FC16EBCA5E03ULL },
+    { 0xBCE5086492111AEAULL, 0x88F4BB1CA6BCF584ULL }, { 0xEC1E4A7DB69561A5ULL, 0x2B31E9E3D06C32E5ULL },
+    { 0x9392EE8E921D5D07ULL, 0x3AFF322E62439FCFULL }, { 0xB877AA3236A4B449ULL, 0x09BEFEB9FAD487C2ULL },
+    { 0xE69594BEC44DE15BULL, 0x4C2EBE687989A9B3ULL }, { 0x901D7CF73AB0ACD9ULL, 0x0F9D37014BF60A10ULL },
+    { 0xB424DC35095CD80FULL, 0x538484C19EF38C94ULL }, { 0xE12E13424BB40E13ULL, 0x2865A5F206B06FB9ULL },
+    { 0x8CBCCC096F5088CBULL, 0xF93F87B7442E45D3ULL }, { 0xAFEBFF0BCB24AAFEULL, 0xF78F69A51539D748ULL },
+    { 0xDBE6FECEBDEDD5BEULL, 0xB573440E5A884D1BULL }, { 0x89705F4136B4A597ULL, 0x31680A88F8953030ULL },
+    { 0xABCC77118461CEFCULL, 0xFDC20D2B36BA7C3DULL }, { 0xD6BF94D5E57A42BCULL, 0x3D32907604691B4CULL },
+    { 0x8637BD05AF6C69B5ULL, 0xA63F9A49C2C1B10FULL }, { 0xA7C5AC471B478423ULL, 0x0FCF80DC33721D53ULL },
+    { 0xD1B71758E219652BULL, 0xD3C36113404EA4A8ULL }, { 0x83126E978D4FDF3BULL, 0x645A1CAC083126E9ULL },
+    { 0xA3D70A3D70A3D70AULL, 0x3D70A3D70A3D70A3ULL }, { 0xCCCCCCCCCCCCCCCCULL, 0xCCCCCCCCCCCCCCCCULL },
+    { 0x8000000000000000ULL, 0x0000000000000000ULL }, { 0xA000000000000000ULL, 0x0000000000000000ULL },
+    { 0xC800000000000000ULL, 0x0000000000000000ULL }, { 0xFA00000000000000ULL, 0x0000000000000000ULL },
+    { 0x9C40000000000000ULL, 0x0000000000000000ULL }, { 0xC350000000000000ULL, 0x0000000000000000ULL },
+    { 0xF424000000000000ULL, 0x0000000000000000ULL }, { 0x9896800000000000ULL, 0x0000000000000000ULL },
+    { 0xBEBC200000000000ULL, 0x0000000000000000ULL }, { 0xEE6B280000000000ULL, 0x0000000000000000ULL },
+    { 0x9502F90000000000ULL, 0x0000000000000000ULL }, { 0xBA43B74000000000ULL, 0x0000000000000000ULL },
+    { 0xE8D4A51000000000ULL, 0x0000000000000000ULL }, { 0x9184E72A00000000ULL, 0x0000000000000000ULL },
+    { 0xB5E620F480000000ULL, 0x0000000000000000ULL }, { 0xE35FA931A0000000ULL, 0x0000000000000000ULL },
+    { 0x8E1BC9BF04000000ULL, 0x0000000000000000ULL }, { 0xB1A2BC2EC5000000ULL, 0x0000000000000000ULL },
+    { 0xDE0B6B3A76400000ULL, 0x0000000000000000ULL }, { 0x8AC7230489E80000ULL, 0x0000000000000000ULL },
+    { 0xAD78EBC5AC620000ULL, 0x0000000000000000ULL }, { 0xD8D726B7177A8000ULL, 0x0000000000000000ULL },
+    { 0x878678326EAC9000ULL, 0x0000000000000000ULL }, { 0xA968163F0A57B400ULL, 0x0000000000000000ULL },
+    { 0xD3C21BCECCEDA100ULL, 0x0000000000000000ULL }, { 0x84595161401484A0ULL, 0x0000000000000000ULL },
+    { 0xA56FA5B99019A5C8ULL, 0x0000000000000000ULL }, { 0xCECB8F27F4200F3AULL, 0x0000000000000000ULL },
+    { 0x813F3978F8940984ULL, 0x4000000000000000ULL }, { 0xA18F07D736B90BE5ULL, 0x5000000000000000ULL },
+    { 0xC9F2C9CD04674EDEULL, 0xA400000000000000ULL }, { 0xFC6F7C4045812296ULL, 0x4D00000000000000ULL },
+    { 0x9DC5ADA82B70B59DULL, 0xF020000000000000ULL }, { 0xC5371912364CE305ULL, 0x6C28000000000000ULL },
+    { 0xF684DF56C3E01BC6ULL, 0xC732000000000000ULL }, { 0x9A130B963A6C115CULL, 0x3C7F400000000000ULL },
+    { 0xC097CE7BC90715B3ULL, 0x4B9F100000000000ULL }, { 0xF0BDC21ABB48DB20ULL, 0x1E86D40000000000ULL },
+    { 0x96769950B50D88F4ULL, 0x1314448000000000ULL }, { 0xBC143FA4E250EB31ULL, 0x17D955A000000000ULL },
+    { 0xEB194F8E1AE525FDULL, 0x5DCFAB0800000000ULL }, { 0x92EFD1B8D0CF37BEULL, 0x5AA1CAE500000000ULL },
+    { 0xB7ABC627050305ADULL, 0xF14A3D9E40000000ULL }, { 0xE596B7B0C643C719ULL, 0x6D9CCD05D0000000ULL },
+    { 0x8F7E32CE7BEA5C6FULL, 0xE4820023A2000000ULL }, { 0xB35DBF821AE4F38BULL, 0xDDA2802C8A800000ULL },
+    { 0xE0352F62A19E306EULL, 0xD50B2037AD200000ULL }, { 0x8C213D9DA502DE45ULL, 0x4526F422CC340000ULL },
+    { 0xAF298D050E4395D6ULL, 0x9670B12B7F410000ULL }, { 0xDAF3F04651D47B4CULL, 0x3C0CDD765F114000ULL },
+    { 0x88D8762BF324CD0FULL, 0xA5880A69FB6AC800ULL }, { 0xAB0E93B6EFEE0053ULL, 0x8EEA0D047A457A00ULL },
+    { 0xD5D238A4ABE98068ULL, 0x72A4904598D6D880ULL }, { 0x85A36366EB71F041ULL, 0x47A6DA2B7F864750ULL },
+    { 0xA70C3C40A64E6C51ULL, 0x999090B65F67D924ULL }, { 0xD0CF4B50CFE20765ULL, 0xFFF4B4E3F741CF6DULL },
+    { 0x82818F1281ED449FULL, 0xBFF8F10E7A8921A4ULL }, { 0xA321F2D7226895C7ULL, 0xAFF72D52192B6A0DULL },
+    { 0xCBEA6F8CEB02BB39ULL, 0x9BF4F8A69F764490ULL }, { 0xFEE50B7025C36A08ULL, 0x02F236D04753D5B4ULL },
+    { 0x9F4F2726179A2245ULL, 0x01D762422C946590ULL }, { 0xC722F0EF9D80AAD6ULL, 0x424D3AD2B7B97EF5ULL },
+    { 0xF8EBAD2B84E0D58BULL, 0xD2E0898765A7DEB2ULL }, { 0x9B934C3B330C8577ULL, 0x63CC55F49F88EB2FULL },
+    { 0xC2781F49FFCFA6D5ULL, 0x3CBF6B71C76B25FBULL }, { 0xF316271C7FC3908AULL, 0x8BEF464E3945EF7AULL },
+    { 0x97EDD871CFDA3A56ULL, 0x97758BF0E3CBB5ACULL }, { 0xBDE94E8E43D0C8ECULL, 0x3D52EEED1CBEA317ULL },
+    { 0xED63A231D4C4FB27ULL, 0x4CA7AAA863EE4BDDULL }, { 0x945E455F24FB1CF8ULL, 0x8FE8CAA93E74EF6AULL },
+    { 0xB975D6B6EE39E436ULL, 0xB3E2FD538E122B44ULL }, { 0xE7D34C64A9C85D44ULL, 0x60DBBCA87196B616ULL },
+    { 0x90E40FBEEA1D3A4AULL, 0xBC8955E946FE31CDULL }, { 0xB51D13AEA4A488DDULL, 0x6BABAB6398BDBE41ULL },
+    { 0xE264589A4DCDAB14ULL, 0xC696963C7EED2DD1ULL }, { 0x8D7EB76070A08AECULL, 0xFC1E1DE5CF543CA2ULL },
+    { 0xB0DE65388CC8ADA8ULL, 0x3B25A55F43294BCBULL }, { 0xDD15FE86AFFAD912ULL, 0x49EF0EB713F39EBEULL },
+    { 0x8A2DBF142DFCC7ABULL, 0x6E3569326C784337ULL }, { 0xACB92ED9397BF996ULL, 0x49C2C37F07965404ULL },
+    { 0xD7E77A8F87DAF7FBULL, 0xDC33745EC97BE906ULL }, { 0x86F0AC99B4E8DAFDULL, 0x69A028BB3DED71A3ULL },
+    { 0xA8ACD7C0222311BCULL, 0xC40832EA0D68CE0CULL }, { 0xD2D80DB02AABD62BULL, 0xF50A3FA490C30190ULL },
+    { 0x83C7088E1AAB65DBULL, 0x792667C6DA79E0FAULL }, { 0xA4B8CAB1A1563F52ULL, 0x577001B891185938ULL },
+    { 0xCDE6FD5E09ABCF26ULL, 0xED4C0226B55E6F86ULL }, { 0x80B05E5AC60B6178ULL, 0x544F8158315B05B4ULL },
+    { 0xA0DC75F1778E39D6ULL, 0x696361AE3DB1C721ULL }, { 0xC913936DD571C84CULL, 0x03BC3A19CD1E38E9ULL },
+    { 0xFB5878494ACE3A5FULL, 0x04AB48A04065C723ULL }, { 0x9D174B2DCEC0E47BULL, 0x62EB0D64283F9C76ULL },
+    { 0xC45D1DF942711D9AULL, 0x3BA5D0BD324F8394ULL }, { 0xF5746577930D6500ULL, 0xCA8F44EC7EE36479ULL },
+    { 0x9968BF6ABBE85F20ULL, 0x7E998B13CF4E1ECBULL }, { 0xBFC2EF456AE276E8ULL, 0x9E3FEDD8C321A67EULL },
+    { 0xEFB3AB16C59B14A2ULL, 0xC5CFE94EF3EA101EULL }, { 0x95D04AEE3B80ECE5ULL, 0xBBA1F1D158724A12ULL },
+    { 0xBB445DA9CA61281FULL, 0x2A8A6E45AE8EDC97ULL }, { 0xEA1575143CF97226ULL, 0xF52D09D71A3293BDULL },
+    { 0x924D692CA61BE758ULL, 0x593C2626705F9C56ULL }, { 0xB6E0C377CFA2E12EULL, 0x6F8B2FB00C77836CULL },
+    { 0xE498F455C38B997AULL, 0x0B6DFB9C0F956447ULL }, { 0x8EDF98B59A373FECULL, 0x4724BD4189BD5EACULL },
+    { 0xB2977EE300C50FE7ULL, 0x58EDEC91EC2CB657ULL }, { 0xDF3D5E9BC0F653E1ULL, 0x2F2967B66737E3EDULL },
+    { 0x8B865B215899F46CULL, 0xBD79E0D20082EE74ULL }, { 0xAE67F1E9AEC07187ULL, 0xECD8590680A3AA11ULL },
+    { 0xDA01EE641A708DE9ULL, 0xE80E6F4820CC9495ULL }, { 0x884134FE908658B2ULL, 0x3109058D147FDCDDULL },
+    { 0xAA51823E34A7EEDEULL, 0xBD4B46F0599FD415ULL }, { 0xD4E5E2CDC1D1EA96ULL, 0x6C9E18AC7007C91AULL },
+    { 0x850FADC09923329EULL, 0x03E2CF6BC604DDB0ULL }, { 0xA6539930BF6BFF45ULL, 0x84DB8346B786151CULL },
+    { 0xCFE87F7CEF46FF16ULL, 0xE612641865679A63ULL }, { 0x81F14FAE158C5F6EULL, 0x4FCB7E8F3F60C07EULL },
+    { 0xA26DA3999AEF7749ULL, 0xE3BE5E330F38F09DULL }, { 0xCB090C8001AB551CULL, 0x5CADF5BFD3072CC5ULL },
+    { 0xFDCB4FA002162A63ULL, 0x73D9732FC7C8F7F6ULL }, { 0x9E9F11C4014DDA7EULL, 0x2867E7FDDCDD9AFAULL },
+    { 0xC646D63501A1511DULL, 0xB281E1FD541501B8ULL }, { 0xF7D88BC24209A565ULL, 0x1F225A7CA91A4226ULL },
+    { 0x9AE757596946075FULL, 0x3375788DE9B06958ULL }, { 0xC1A12D2FC3978937ULL, 0x0052D6B1641C83AEULL },
+    { 0xF209787BB47D6B84ULL, 0xC0678C5DBD23A49AULL }, { 0x9745EB4D50CE6332ULL, 0xF840B7BA963646E0ULL },
+    { 0xBD176620A501FBFFULL, 0xB650E5A93BC3D898ULL }, { 0xEC5D3FA8CE427AFFULL, 0xA3E51F138AB4CEBEULL },
+    { 0x93BA47C980E98CDFULL, 0xC66F336C36B10137ULL }, { 0xB8A8D9BBE123F017ULL, 0xB80B0047445D4184ULL },
+    { 0xE6D3102AD96CEC1DULL, 0xA60DC059157491E5ULL }, { 0x9043EA1AC7E41392ULL, 0x87C89837AD68DB2FULL },
+    { 0xB454E4A179DD1877ULL, 0x29BABE4598C311FBULL }, { 0xE16A1DC9D8545E94ULL, 0xF4296DD6FEF3D67AULL },
+    { 0x8CE2529E2734BB1DULL, 0x1899E4A65F58660CULL }, { 0xB01AE745B101E9E4ULL, 0x5EC05DCFF72E7F8FULL },
+    { 0xDC21A1171D42645DULL, 0x76707543F4FA1F73ULL }, { 0x899504AE72497EBAULL, 0x6A06494A791C53A8ULL },
+    { 0xABFA45DA0EDBDE69ULL, 0x0487DB9D17636892ULL }, { 0xD6F8D7509292D603ULL, 0x45A9D2845D3C42B6ULL },
+    { 0x865B86925B9BC5C2ULL, 0x0B8A2392BA45A9B2ULL }, { 0xA7F26836F282B732ULL, 0x8E6CAC7768D7141EULL },
+    { 0xD1EF0244AF2364FFULL, 0x3207D795430CD926ULL }, { 0x8335616AED761F1FULL, 0x7F44E6BD49E807B8ULL },
+    { 0xA402B9C5A8D3A6E7ULL, 0x5F16206C9C6209A6ULL }, { 0xCD036837130890A1ULL, 0x36DBA887C37A8C0FULL },
+    { 0x802221226BE55A64ULL, 0xC2494954DA2C9789ULL }, { 0xA02AA96B06DEB0FDULL, 0xF2DB9BAA10B7BD6CULL },
+    { 0xC83553C5C8965D3DULL, 0x6F92829494E5ACC7ULL }, { 0xFA42A8B73ABBF48CULL, 0xCB772339BA1F17F9ULL },
+    { 0x9C69A97284B578D7ULL, 0xFF2A760414536EFBULL }, { 0xC38413CF25E2D70DULL, 0xFEF5138519684ABAULL },
+    { 0xF46518C2EF5B8CD1ULL, 0x7EB258665FC25D69ULL }, { 0x98BF2F79D5993802ULL, 0xEF2F773FFBD97A61ULL },
+    { 0xBEEEFB584AFF8603ULL, 0xAAFB550FFACFD8FAULL }, { 0xEEAABA2E5DBF6784ULL, 0x95BA2A53F983CF38ULL },
+    { 0x952AB45CFA97A0B2ULL, 0xDD945A747BF26183ULL }, { 0xBA756174393D88DFULL, 0x94F971119AEEF9E4ULL },
+    { 0xE912B9D1478CEB17ULL, 0x7A37CD5601AAB85DULL }, { 0x91ABB422CCB812EEULL, 0xAC62E055C10AB33AULL },
+    { 0xB616A12B7FE617AAULL, 0x577B986B314D6009ULL }, { 0xE39C49765FDF9D94ULL, 0xED5A7E85FDA0B80BULL },
+    { 0x8E41ADE9FBEBC27DULL, 0x14588F13BE847307ULL }, { 0xB1D219647AE6B31CULL, 0x596EB2D8AE258FC8ULL },
+    { 0xDE469FBD99A05FE3ULL, 0x6FCA5F8ED9AEF3BBULL }, { 0x8AEC23D680043BEEULL, 0x25DE7BB9480D5854ULL },
+    { 0xADA72CCC20054AE9ULL, 0xAF561AA79A10AE6AULL }, { 0xD910F7FF28069DA4ULL, 0x1B2BA1518094DA04ULL },
+    { 0x87AA9AFF79042286ULL, 0x90FB44D2F05D0842ULL }, { 0xA99541BF57452B28ULL, 0x353A1607AC744A53ULL },
+    { 0xD3FA922F2D1675F2ULL, 0x42889B8997915CE8ULL }, { 0x847C9B5D7C2E09B7ULL, 0x69956135FEBADA11ULL },
+    { 0xA59BC234DB398C25ULL, 0x43FAB9837E699095ULL }, { 0xCF02B2C21207EF2EULL, 0x94F967E45E03F4BBULL },
+    { 0x8161AFB94B44F57DULL, 0x1D1BE0EEBAC278F5ULL }, { 0xA1BA1BA79E1632DCULL, 0x6462D92A69731732ULL },
+    { 0xCA28A291859BBF93ULL, 0x7D7B8F7503CFDCFEULL }, { 0xFCB2CB35E702AF78ULL, 0x5CDA735244C3D43EULL },
+    { 0x9DEFBF01B061ADABULL, 0x3A0888136AFA64A7ULL }, { 0xC56BAEC21C7A1916ULL, 0x088AAA1845B8FDD0ULL },
+    { 0xF6C69A72A3989F5BULL, 0x8AAD549E57273D45ULL }, { 0x9A3C2087A63F6399ULL, 0x36AC54E2F678864BULL },
+    { 0xC0CB28A98FCF3C7FULL, 0x84576A1BB416A7DDULL }, { 0xF0FDF2D3F3C30B9FULL, 0x656D44A2A11C51D5ULL },
+    { 0x969EB7C47859E743ULL, 0x9F644AE5A4B1B325ULL }, { 0xBC4665B596706114ULL, 0x873D5D9F0DDE1FEEULL },
+    { 0xEB57FF22FC0C7959ULL, 0xA90CB506D155A7EAULL }, { 0x9316FF75DD87CBD8ULL, 0x09A7F12442D588F2ULL },
+    { 0xB7DCBF5354E9BECEULL, 0x0C11ED6D538AEB2FULL }, { 0xE5D3EF282A242E81ULL, 0x8F1668C8A86DA5FAULL },
+    { 0x8FA475791A569D10ULL, 0xF96E017D694487BCULL }, { 0xB38D92D760EC4455ULL, 0x37C981DCC395A9ACULL },
+    { 0xE070F78D3927556AULL, 0x85BBE253F47B1417ULL }, { 0x8C469AB843B89562ULL, 0x93956D7478CCEC8EULL },
+    { 0xAF58416654A6BABBULL, 0x387AC8D1970027B2ULL }, { 0xDB2E51BFE9D0696AULL, 0x06997B05FCC0319EULL },
+    { 0x88FCF317F22241E2ULL, 0x441FECE3BDF81F03ULL }, { 0xAB3C2FDDEEAAD25AULL, 0xD527E81CAD7626C3ULL },
+    { 0xD60B3BD56A5586F1ULL, 0x8A71E223D8D3B074ULL }, { 0x85C7056562757456ULL, 0xF6872D5667844E49ULL },
+    { 0xA738C6BEBB12D16CULL, 0xB428F8AC016561DBULL }, { 0xD106F86E69D785C7ULL, 0xE13336D701BEBA52ULL },
+    { 0x82A45B450226B39CULL, 0xECC0024661173473ULL }, { 0xA34D721642B06084ULL, 0x27F002D7F95D0190ULL },
+    { 0xCC20CE9BD35C78A5ULL, 0x31EC038DF7B441F4ULL }, { 0xFF290242C83396CEULL, 0x7E67047175A15271ULL },
+    { 0x9F79A169BD203E41ULL, 0x0F0062C6E984D386ULL }, { 0xC75809C42C684DD1ULL, 0x52C07B78A3E60868ULL },
+    { 0xF92E0C3537826145ULL, 0xA7709A56CCDF8A82ULL }, { 0x9BBCC7A142B17CCBULL, 0x88A66076400BB691ULL },
+    { 0xC2ABF989935DDBFEULL, 0x6ACFF893D00EA435ULL }, { 0xF356F7EBF83552FEULL, 0x0583F6B8C4124D43ULL },
+    { 0x98165AF37B2153DEULL, 0xC3727A337A8B704AULL }, { 0xBE1BF1B059E9A8D6ULL, 0x744F18C0592E4C5CULL },
+    { 0xEDA2EE1C7064130CULL, 0x1162DEF06F79DF73ULL }, { 0x9485D4D1C63E8BE7ULL, 0x8ADDCB5645AC2BA8ULL },
+    { 0xB9A74A0637CE2EE1ULL, 0x6D953E2BD7173692ULL }, { 0xE8111C87C5C1BA99ULL, 0xC8FA8DB6CCDD0437ULL },
+    { 0x910AB1D4DB9914A0ULL, 0x1D9C9892400A22A2ULL }, { 0xB54D5E4A127F59C8ULL, 0x2503BEB6D00CAB4BULL },
+    { 0xE2A0B5DC971F303AULL, 0x2E44AE64840FD61DULL }, { 0x8DA471A9DE737E24ULL, 0x5CEAECFED289E5D2ULL },
+    { 0xB10D8E1456105DADULL, 0x7425A83E872C5F47ULL }, { 0xDD50F1996B947518ULL, 0xD12F124E28F77719ULL },
+    { 0x8A5296FFE33CC92FULL, 0x82BD6B70D99AAA6FULL }, { 0xACE73CBFDC0BFB7BULL, 0x636CC64D1001550BULL },
+    { 0xD8210BEFD30EFA5AULL, 0x3C47F7E05401AA4EULL }, { 0x8714A775E3E95C78ULL, 0x65ACFAEC34810A71ULL },
+    { 0xA8D9D1535CE3B396ULL, 0x7F1839A741A14D0DULL }, { 0xD31045A8341CA07CULL, 0x1EDE48111209A050ULL },
+    { 0x83EA2B892091E44DULL, 0x934AED0AAB460432ULL }, { 0xA4E4B66B68B65D60ULL, 0xF81DA84D5617853FULL },
+    { 0xCE1DE40642E3F4B9ULL, 0x36251260AB9D668EULL }, { 0x80D2AE83E9CE78F3ULL, 0xC1D72B7C6B426019ULL },
+    { 0xA1075A24E4421730ULL, 0xB24CF65B8612F81FULL }, { 0xC94930AE1D529CFCULL, 0xDEE033F26797B627ULL },
+    { 0xFB9B7CD9A4A7443CULL, 0x169840EF017DA3B1ULL }, { 0x9D412E0806E88AA5ULL, 0x8E1F289560EE864EULL },
+    { 0xC491798A08A2AD4EULL, 0xF1A6F2BAB92A27E2ULL }, { 0xF5B5D7EC8ACB58A2ULL, 0xAE10AF696774B1DBULL },
+    { 0x9991A6F3D6BF1765ULL, 0xACCA6DA1E0A8EF29ULL }, { 0xBFF610B0CC6EDD3FULL, 0x17FD090A58D32AF3ULL },
+    { 0xEFF394DCFF8A948EULL, 0xDDFC4B4CEF07F5B0ULL }, { 0x95F83D0A1FB69CD9ULL, 0x4ABDAF101564F98EULL },
+    { 0xBB764C4CA7A4440FULL, 0x9D6D1AD41ABE37F1ULL }, { 0xEA53DF5FD18D5513ULL, 0x84C86189216DC5EDULL },
+    { 0x92746B9BE2F8552CULL, 0x32FD3CF5B4E49BB4ULL }, { 0xB7118682DBB66A77ULL, 0x3FBC8C33221DC2A1ULL },
+    { 0xE4D5E82392A40515ULL, 0x0FABAF3FEAA5334AULL }, { 0x8F05B1163BA6832DULL, 0x29CB4D87F2A7400EULL },
+    { 0xB2C71D5BCA9023F8ULL, 0x743E20E9EF511012ULL }, { 0xDF78E4B2BD342CF6ULL, 0x914DA9246B255416ULL },
+    { 0x8BAB8EEFB6409C1AULL, 0x1AD089B6C2F7548EULL }, { 0xAE9672ABA3D0C320ULL, 0xA184AC2473B529B1ULL },
+    { 0xDA3C0F568CC4F3E8ULL, 0xC9E5D72D90A2741EULL }, { 0x8865899617FB1871ULL, 0x7E2FA67C7A658892ULL },
+    { 0xAA7EEBFB9DF9DE8DULL, 0xDDBB901B98FEEAB7ULL }, { 0xD51EA6FA85785631ULL, 0x552A74227F3EA565ULL },
+    { 0x8533285C936B35DEULL, 0xD53A88958F87275FULL }, { 0xA67FF273B8460356ULL, 0x8A892ABAF368F137ULL },
+    { 0xD01FEF10A657842CULL, 0x2D2B7569B0432D85ULL }, { 0x8213F56A67F6B29BULL, 0x9C3B29620E29FC73ULL },
+    { 0xA298F2C501F45F42ULL, 0x8349F3BA91B47B8FULL }, { 0xCB3F2F7642717713ULL, 0x241C70A936219A73ULL },
+    { 0xFE0EFB53D30DD4D7ULL, 0xED238CD383AA0110ULL }, { 0x9EC95D1463E8A506ULL, 0xF4363804324A40AAULL },
+    { 0xC67BB4597CE2CE48ULL, 0xB143C6053EDCD0D5ULL }, { 0xF81AA16FDC1B81DAULL, 0xDD94B7868E94050AULL },
+    { 0x9B10A4E5E9913128ULL, 0xCA7CF2B4191C8326ULL }, { 0xC1D4CE1F63F57D72ULL, 0xFD1C2F611F63A3F0ULL },
+    { 0xF24A01A73CF2DCCFULL, 0xBC633B39673C8CECULL }, { 0x976E41088617CA01ULL, 0xD5BE0503E085D813ULL },
+    { 0xBD49D14AA79DBC82ULL, 0x4B2D8644D8A74E18ULL }, { 0xEC9C459D51852BA2ULL, 0xDDF8E7D60ED1219EULL },
+    { 0x93E1AB8252F33B45ULL, 0xCABB90E5C942B503ULL }, { 0xB8DA1662E7B00A17ULL, 0x3D6A751F3B936243ULL },
+    { 0xE7109BFBA19C0C9DULL, 0x0CC512670A783AD4ULL }, { 0x906A617D450187E2ULL, 0x27FB2B80668B24C5ULL },
+    { 0xB484F9DC9641E9DAULL, 0xB1F9F660802DEDF6ULL }, { 0xE1A63853BBD26451ULL, 0x5E7873F8A0396973ULL },
+    { 0x8D07E33455637EB2ULL, 0xDB0B487B6423E1E8ULL }, { 0xB049DC016ABC5E5FULL, 0x91CE1A9A3D2CDA62ULL },
+    { 0xDC5C5301C56B75F7ULL, 0x7641A140CC7810FBULL }, { 0x89B9B3E11B6329BAULL, 0xA9E904C87FCB0A9DULL },
+    { 0xAC2820D9623BF429ULL, 0x546345FA9FBDCD44ULL }, { 0xD732290FBACAF133ULL, 0xA97C177947AD4095ULL },
+    { 0x867F59A9D4BED6C0ULL, 0x49ED8EABCCCC485DULL }, { 0xA81F301449EE8C70ULL, 0x5C68F256BFFF5A74ULL },
+    { 0xD226FC195C6A2F8CULL, 0x73832EEC6FFF3111ULL }, { 0x83585D8FD9C25DB7ULL, 0xC831FD53C5FF7EABULL },
+    { 0xA42E74F3D032F525ULL, 0xBA3E7CA8B77F5E55ULL }, { 0xCD3A1230C43FB26FULL, 0x28CE1BD2E55F35EBULL },
+    { 0x80444B5E7AA7CF85ULL, 0x7980D163CF5B81B3ULL }, { 0xA0555E361951C366ULL, 0xD7E105BCC332621FULL },
+    { 0xC86AB5C39FA63440ULL, 0x8DD9472BF3FEFAA7ULL }, { 0xFA856334878FC150ULL, 0xB14F98F6F0FEB951ULL },
+    { 0x9C935E00D4B9D8D2ULL, 0x6ED1BF9A569F33D3ULL }, { 0xC3B8358109E84F07ULL, 0x0A862F80EC4700C8ULL },
+    { 0xF4A642E14C6262C8ULL, 0xCD27BB612758C0FAULL }, { 0x98E7E9CCCFBD7DBDULL, 0x8038D51CB897789CULL },
+    { 0xBF21E44003ACDD2CULL, 0xE0470A63E6BD56C3ULL }, { 0xEEEA5D5004981478ULL, 0x1858CCFCE06CAC74ULL },
+    { 0x95527A5202DF0CCBULL, 0x0F37801E0C43EBC8ULL }, { 0xBAA718E68396CFFDULL, 0xD30560258F54E6BAULL },
+    { 0xE950DF20247C83FDULL, 0x47C6B82EF32A2069ULL }, { 0x91D28B7416CDD27EULL, 0x4CDC331D57FA5441ULL },
+    { 0xB6472E511C81471DULL, 0xE0133FE4ADF8E952ULL }, { 0xE3D8F9E563A198E5ULL, 0x58180FDDD97723A6ULL },
+    { 0x8E679C2F5E44FF8FULL, 0x570F09EAA7EA7648ULL }, { 0xB201833B35D63F73ULL, 0x2CD2CC6551E513DAULL },
+    { 0xDE81E40A034BCF4FULL, 0xF8077F7EA65E58D1ULL }, { 0x8B112E86420F6191ULL, 0xFB04AFAF27FAF782ULL },
+    { 0xADD57A27D29339F6ULL, 0x79C5DB9AF1F9B563ULL }, { 0xD94AD8B1C7380874ULL, 0x18375281AE7822BCULL },
+    { 0x87CEC76F1C830548ULL, 0x8F2293910D0B15B5ULL }, { 0xA9C2794AE3A3C69AULL, 0xB2EB3875504DDB22ULL },
+    { 0xD433179D9C8CB841ULL, 0x5FA60692A46151EBULL }, { 0x849FEEC281D7F328ULL, 0xDBC7C41BA6BCD333ULL },
+    { 0xA5C7EA73224DEFF3ULL, 0x12B9B522906C0800ULL }, { 0xCF39E50FEAE16BEFULL, 0xD768226B34870A00ULL },
+    { 0x81842F29F2CCE375ULL, 0xE6A1158300D46640ULL }, { 0xA1E53AF46F801C53ULL, 0x60495AE3C1097FD0ULL },
+    { 0xCA5E89B18B602368ULL, 0x385BB19CB14BDFC4ULL }, { 0xFCF62C1DEE382C42ULL, 0x46729E03DD9ED7B5ULL },
+    { 0x9E19DB92B4E31BA9ULL, 0x6C07A2C26A8346D1ULL }, { 0xC5A05277621BE293ULL, 0xC7098B7305241885ULL },
+    { 0xF70867153AA2DB38ULL, 0xB8CBEE4FC66D1EA7ULL }, { 0x9A65406D44A5C903ULL, 0x737F74F1DC043328ULL },
+    { 0xC0FE908895CF3B44ULL, 0x505F522E53053FF2ULL }, { 0xF13E34AABB430A15ULL, 0x647726B9E7C68FEFULL },
+    { 0x96C6E0EAB509E64DULL, 0x5ECA783430DC19F5ULL }, { 0xBC789925624C5FE0ULL, 0xB67D16413D132072ULL },
+    { 0xEB96BF6EBADF77D8ULL, 0xE41C5BD18C57E88FULL }, { 0x933E37A534CBAAE7ULL, 0x8E91B962F7B6F159ULL },
+    { 0xB80DC58E81FE95A1ULL, 0x723627BBB5A4ADB0ULL }, { 0xE61136F2227E3B09ULL, 0xCEC3B1AAA30DD91CULL },
+    { 0x8FCAC257558EE4E6ULL, 0x213A4F0AA5E8A7B1ULL }, { 0xB3BD72ED2AF29E1FULL, 0xA988E2CD4F62D19DULL },
+    { 0xE0ACCFA875AF45A7ULL, 0x93EB1B80A33B8605ULL }, { 0x8C6C01C9498D8B88ULL, 0xBC72F130660533C3ULL },
+    { 0xAF87023B9BF0EE6AULL, 0xEB8FAD7C7F8680B4ULL }, { 0xDB68C2CA82ED2A05ULL, 0xA67398DB9F6820E1ULL },
+    { 0x892179BE91D43A43ULL, 0x88083F8943A1148CULL }, { 0xAB69D82E364948D4ULL, 0x6A0A4F6B948959B0ULL },
+    { 0xD6444E39C3DB9B09ULL, 0x848CE34679ABB01CULL }, { 0x85EAB0E41A6940E5ULL, 0xF2D80E0C0C0B4E11ULL },
+    { 0xA7655D1D2103911FULL, 0x6F8E118F0F0E2195ULL }, { 0xD13EB46469447567ULL, 0x4B7195F2D2D1A9FBULL }
+};
+
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 _fmt_u128;
+#endif
+
+// High 64 bits of a * b; the low half goes to *lo.
+static inline unsigned long long _fmt_mul128(unsigned long long a, unsigned long long b, unsigned long long* lo) {
+#if defined(__SIZEOF_INT128__)
+    _fmt_u128 p = (_fmt_u128)a * b;
+    *lo = (unsigned long long)p;
+    return (unsigned long long)(p >> 64);
+#else
+    unsigned long long al = a & 0xFFFFFFFFULL, ah = a >> 32, bl = b & 0xFFFFFFFFULL, bh = b >> 32;
+    unsigned long long ll = al * bl, lh = al * bh, hl = ah * bl, hh = ah * bh;
+    unsigned long long mid = (ll >> 32) + (lh & 0xFFFFFFFFULL) + (hl & 0xFFFFFFFFULL);
+    *lo = (mid << 32) | (ll & 0xFFFFFFFFULL);
+    return hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif
+}
+
+static inline int _fmt_clz64(unsigned long long v) {
+#if defined(__GNUC__)
+    return __builtin_clzll(v);
+#else
+    int n = 0;
+    while (!(v & 0x8000000000000000ULL)) { v <<= 1; n++; }
+    return n;
+#endif
+}
+
+// Grisu3 (Loitsch, "Printing Floating-Point Numbers Quickly and Accurately"):
+// the digits of the upper boundary are generated in 64-bit fixed point and
+// trimmed while they stay inside the rounding interval. Returns 0 for the
+// ~0.5% of inputs it cannot prove shortest and closest.
+static inline int _fmt_round_weed(char* digits, int len, unsigned long long dist_high, unsigned long long unsafe,
+                                  unsigned long long rest, unsigned long long ten_kappa, unsigned long long unit) {
+    unsigned long long small_dist = dist_high - unit, big_dist = dist_high + unit;
+    while (rest < small_dist && unsafe - rest >= ten_kappa &&
+           (rest + ten_kappa < small_dist || small_dist - rest >= rest + ten_kappa - small_dist)) {
+        digits[len - 1]--;
+        rest += ten_kappa;
+    }
+    if (rest < big_dist && unsafe - rest >= ten_kappa &&
+        (rest + ten_kappa < big_dist || big_dist - rest > rest + ten_kappa - big_dist))
+        return 0;
+    return 2 * unit <= rest && rest <= unsafe - 4 * unit;
+}
+
+static inline int _fmt_grisu3(unsigned long long f, int e, int lower_closer, char* digits, int* len, int* dec_exp) {
+    // Boundaries m+ and m-, and w itself, all normalized to the exponent of m+.
+    unsigned long long mp = (f << 1) + 1, mm;
+    int shift = _fmt_clz64(mp), ew = e - 1 - shift;
+    mp <<= shift;
+    mm = lower_closer ? (f << 2) - 1 : (f << 1) - 1;
+    mm <<= shift - lower_closer;
+    unsigned long long w = f << (shift + 1);
+
+    // Pick 10^q that brings the product exponent into [-60, -32].
+    int q = ((-61 - ew) * 78913) >> 18;
+    while (((217706 * q) >> 16) - 63 + ew + 64 < -60) q++;
+    while (((217706 * q) >> 16) - 63 + ew + 64 > -32) q--;
+    const unsigned long long* c = _fmt_pow10[q - _FMT_POW10_MIN];
+    unsigned long long cf = c[0] + (c[1] >> 63), lo;
+    int one_e = -(((217706 * q) >> 16) - 63 + ew + 64);
+    unsigned long long W = _fmt_mul128(w, cf, &lo);   W += lo >> 63;
+    unsigned long long high = _fmt_mul128(mp, cf, &lo); high += lo >> 63;
+    unsigned long long low = _fmt_mul128(mm, cf, &lo); low += lo >> 63;
+
+    unsigned long long unit = 1, too_high = high + unit, unsafe = too_high - (low - unit);
+    unsigned long long one = 1ULL << one_e, frac = too_high & (one - 1);
+    unsigned ints = (unsigned)(too_high >> one_e), div = 1;
+    int kappa = 1;
+    while (div <= ints / 10) { div *= 10; kappa++; }
+    int n = 0;
+    while (kappa > 0) {
+        digits[n++] = (char)('0' + ints / div);
+        ints %= div;
+        kappa--;
+        unsigned long long rest = ((unsigned long long)ints << one_e) + frac;
+        if (rest < unsafe) {
+            *len = n; *dec_exp = kappa - q;
+            return _fmt_round_weed(digits, n, too_high - W, unsafe, rest, (unsigned long long)div << one_e, unit);
+        }
+        div /= 10;
+    }
+    for (;;) {
+        frac *= 10; unit *= 10; unsafe *= 10;
+        digits[n++] = (char)('0' + (frac >> one_e));
+        frac &= one - 1;
+        kappa--;
+        if (frac < unsafe) {
+            *len = n; *dec_exp = kappa - q;
+            return _fmt_round_weed(digits, n, (too_high - W) * unit, unsafe, frac, one, unit);
+        }
+    }
+}
+
+// Fallback for Grisu3 failures: the first precision that round-trips through
+// printf/strtod is the shortest, and printf rounds it correctly. Grisu's digit
+// count is a lower bound (its interval contains the exact one), so the search
+// starts there.
+_TOOLS_COLD static void _fmt_shortest_slow(double v, char* digits, int* len, int* dec_exp) {
+    char tmp[40];
+    for (int prec = *len > 0 && *len <= 17 ? *len : 1; prec <= 17; prec++) {
+        snprintf(tmp, sizeof(tmp), "%.*e", prec - 1, v);
+        if (prec < 17 && strtod(tmp, NULL) != v) continue;
+        int n = 0;
+        const char* p = tmp;
+        for (; *p && *p != 'e'; p++) if (*p >= '0' && *p <= '9') digits[n++] = *p;
+        while (n > 1 && digits[n - 1] == '0') n--;
+        *len = n;
+        *dec_exp = atoi(p + 1) - (n - 1);
+        return;
+    }
+}
+
+// Shortest round-trip form: "0.1", "1e+21", "5e-324". Plain notation for
+// 1e-6 <= |v| < 1e21, otherwise d.ddde+XX, as JavaScript prints numbers.
+// NaN and infinities come out as "nan", "inf", "-inf". Writes a NUL into dst
+// (FMT_DOUBLE_MAX bytes) and returns the length.
+static inline size_t fmt_double(char* dst, double v) {
+    unsigned long long bits;
+    memcpy(&bits, &v, 8);
+    char* p = dst;
+    if (bits >> 63) *p++ = '-';
+    unsigned long long f = bits & 0xFFFFFFFFFFFFFULL;
+    int be = (int)(bits >> 52 & 0x7FF);
+    if (be == 0x7FF) {
+        if (f) { memcpy(dst, "nan", 4); return 3; }
+        memcpy(p, "inf", 4); return (size_t)(p - dst) + 3;
+    }
+    if (!be && !f) { memcpy(p, "0", 2); return (size_t)(p - dst) + 1; }
+
+    char digits[20];
+    int len = 0, k = 0;
+    int e = be ? be - 1075 : -1074;
+    if (be) f |= 1ULL << 52;
+    if (!_fmt_grisu3(f, e, f == 1ULL << 52 && be > 1, digits, &len, &k))
+        _fmt_shortest_slow(bits >> 63 ? -v : v, digits, &len, &k);
+
+    int point = len + k; // digits are d1..dlen * 10^k; point is where the '.' goes
+    if (k >= 0 && point <= 21) {
+        memcpy(p, digits, (size_t)len); p += len;
+        memset(p, '0', (size_t)k); p += k;
+    } else if (point > 0 && point <= 21) {
+        memcpy(p, digits, (size_t)point); p += point;
+        *p++ = '.';
+        memcpy(p, digits + point, (size_t)(len - point)); p += len - point;
+    } else if (point > -6 && point <= 0) {
+        *p++ = '0'; *p++ = '.';
+        memset(p, '0', (size_t)-point); p += -point;
+        memcpy(p, digits, (size_t)len); p += len;
+    } else {
+        int x = point - 1;
+        *p++ = digits[0];
+        if (len > 1) { *p++ = '.'; memcpy(p, digits + 1, (size_t)(len - 1)); p += len - 1; }
+        *p++ = 'e'; *p++ = x < 0 ? '-' : '+';
+        if (x < 0) x = -x;
+        if (x >= 100) { *p++ = (char)('0' + x / 100); x %= 100; memcpy(p, _dec_pairs + 2 * x, 2); p += 2; }
+        else if (x >= 10) { memcpy(p, _dec_pairs + 2 * x, 2); p += 2; }
+        else *p++ = (char)('0' + x);
+    }
+    *p = '\0';
+    return (size_t)(p - dst);
+}
+
+static inline int sb_append_u64(qol_sb* sb, unsigned long long v) {
+    if (!sb_reserve(sb, FMT_INT_MAX)) return 0;
+    sb->len += fmt_u64(sb->data + sb->len, v);
+    return 1;
+}
+
+static inline int sb_append_i64(qol_sb* sb, long long v) {
+    if (!sb_reserve(sb, FMT_INT_MAX)) return 0;
+    sb->len += fmt_i64(sb->data + sb->len, v);
+    return 1;
+}
+
+static inline int sb_append_double(qol_sb* sb, double v) {
+    if (!sb_reserve(sb, FMT_DOUBLE_MAX)) return 0;
+    sb->len += fmt_double(sb->data + sb->len, v);
+    return 1;
+}
+
+// True when all 8 bytes are ASCII digits.
+static inline int _parse_is_8digits(unsigned long long x) {
+    return ((x & 0xF0F0F0F0F0F0F0F0ULL) | (((x + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+}
+
+// Eight ASCII digits (first digit in the lowest byte) to their value with three multiplies.
+static inline unsigned _parse_8digits(unsigned long long x) {
+    x -= 0x3030303030303030ULL;
+    x = (x * 10) + (x >> 8);
+    x = (((x & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+         (((x >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+    return (unsigned)x;
+}
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ || defined(_WIN32)
+    #define _PARSE_SWAR 1
+#endif
+
+// Reads up to max digits of s[*i..n) into *v; returns how many were read.
+static inline int _parse_digits(const char* s, size_t n, size_t* i, unsigned long long* v, int max) {
+    int count = 0;
+#ifdef _PARSE_SWAR
+    unsigned long long x;
+    while (count + 8 <= max && *i + 8 <= n) {
+        memcpy(&x, s + *i, 8);
+        if (!_parse_is_8digits(x)) break;
+        *v = *v * 100000000ULL + _parse_8digits(x);
+        *i += 8; count += 8;
+    }
+#endif
+    while (count < max && *i < n && (unsigned)(s[*i] - '0') < 10) { *v = *v * 10 + (unsigned)(s[*i] - '0'); (*i)++; count++; }
+    return count;
+}
+
+// Parses decimal digits at the start of s[0..n) into *out. Returns the number of
+// bytes consumed, or 0 if there are no digits or the value overflows.
+static inline size_t parse_u64(const char* s, size_t n, unsigned long long* out) {
+    unsigned long long v = 0;
+    size_t i = 0;
+    while (i < n && s[i] == '0') i++;   // Leading zeros do not count toward the 19-digit cap.
+    _parse_digits(s, n, &i, &v, 19);
+    if (!i) return 0;
+    if (i < n && (unsigned)(s[i] - '0') < 10) {
+        unsigned d = (unsigned)(s[i] - '0');
+        if (v > (~0ULL - d) / 10 || (i + 1 < n && (unsigned)(s[i + 1] - '0') < 10)) return 0;
+        v = v * 10 + d; i++;
+    }
+    *out = v;
+    return i;
+}
+
+// Optional sign, then digits. Returns bytes consumed, 0 on no digits or overflow.
+static inline size_t parse_i64(const char* s, size_t n, long long* out) {
+    size_t sign = n && (s[0] == '-' || s[0] == '+');
+    unsigned long long v;
+    size_t used = parse_u64(s + sign, n - sign, &v);
+    if (!used) return 0;
+    if (s[0] == '-') {
+        if (v > 0x8000000000000000ULL) return 0;
+        *out = (long long)(0ULL - v);
+    } else {
+        if (v > 0x7FFFFFFFFFFFFFFFULL) return 0;
+        *out = (long long)v;
+    }
+    return sign + used;
+}
+
+// Eisel-Lemire (as in Go's strconv): w * 10^q from one or two 64x128-bit
+// products. Returns 0 when the result is ambiguous or out of normal range.
+static inline int _parse_eisel_lemire(unsigned long long w, int q, int neg, double* out) {
+    int clz = _fmt_clz64(w);
+    w <<= clz;
+    unsigned long long exp2 = (unsigned long long)(((217706 * q) >> 16) + 64 + 1023 - clz);
+    const unsigned long long* t = _fmt_pow10[q - _FMT_POW10_MIN];
+    unsigned long long lo, hi = _fmt_mul128(w, t[0], &lo);
+    if ((hi & 0x1FF) == 0x1FF && lo + w < w) {
+        unsigned long long ylo, yhi = _fmt_mul128(w, t[1], &ylo);
+        unsigned long long mlo = lo + yhi, mhi = hi + (mlo < lo);
+        if ((mhi & 0x1FF) == 0x1FF && mlo + 1 == 0 && ylo + w < w) return 0;
+        hi = mhi; lo = mlo;
+    }
+    unsigned long long msb = hi >> 63, mant = hi >> (msb + 9);
+    exp2 -= 1 ^ msb;
+    if (lo == 0 && (hi & 0x1FF) == 0 && (mant & 3) == 1) return 0; // exactly halfway
+    mant += mant & 1;
+    mant >>= 1;
+    if (mant >> 53) { mant >>= 1; exp2++; }
+    if (exp2 - 1 >= 0x7FF - 1) return 0; // subnormal or overflow
+    unsigned long long bits = exp2 << 52 | (mant & 0xFFFFFFFFFFFFFULL) | (unsigned long long)neg << 63;
+    memcpy(out, &bits, 8);
+    return 1;
+}
+
+// strtod on a private NUL-terminated copy, since s may not be terminated.
+_TOOLS_COLD static double _parse_double_slow(const char* s, size_t n) {
+    char tmp[128];
+    char* buf = n < sizeof(tmp) ? tmp : (char*)QOL_MALLOC(n + 1);
+    if (!buf) return 0.0;
+    memcpy(buf, s, n);
+    buf[n] = '\0';
+    double v = strtod(buf, NULL);
+    if (buf != tmp) QOL_FREE(buf);
+    return v;
+}
+
+// Parses [+-]digits[.digits][(e|E)[+-]digits] at the start of s[0..n) into
+// *out. Returns the number of bytes consumed, or 0 if there is no number.
+// Up to 19 significant digits are converted directly (Clinger's exact path,
+// then Eisel-Lemire); longer inputs and the rare ambiguous cases use strtod.
+static inline size_t parse_double(const char* s, size_t n, double* out) {
+    static const double p10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+    size_t i = 0;
+    int neg = n && s[0] == '-';
+    if (n && (s[0] == '-' || s[0] == '+')) i++;
+    size_t start = i;
+
+    // Significand: w holds the first 19 significant digits, value = w * 10^q.
+    unsigned long long w = 0;
+    int sig, q = 0, exact = 1;
+    while (i < n && s[i] == '0') i++;
+    sig = _parse_digits(s, n, &i, &w, 19);
+    for (; i < n && (unsigned)(s[i] - '0') < 10; i++) { q++; exact &= s[i] == '0'; }
+    int has_digits = i > start;
+    if (i < n && s[i] == '.') {
+        size_t frac = ++i;
+        if (!sig) while (i < n && s[i] == '0') i++;
+        sig += _parse_digits(s, n, &i, &w, 19 - sig);
+        q -= (int)(i - frac);
+        for (; i < n && (unsigned)(s[i] - '0') < 10; i++) exact &= s[i] == '0';
+        has_digits |= i > frac;
+    }
+    if (!has_digits) return 0;
+
+    if (i < n && (s[i] == 'e' || s[i] == 'E')) {
+        size_t j = i + 1;
+        int eneg = j < n && s[j] == '-', x = 0;
+        if (j < n && (s[j] == '-' || s[j] == '+')) j++;
+        if (j < n && (unsigned)(s[j] - '0') < 10) {
+            for (; j < n && (unsigned)(s[j] - '0') < 10; j++) if (x < 100000) x = x * 10 + (s[j] - '0');
+            q += eneg ? -x : x;
+            i = j;
+        }
+    }
+
+    double v;
+    if (!exact) v = _parse_double_slow(s, i);
+    else if (!w) v = neg ? -0.0 : 0.0;
+    else if (w <= 9007199254740992ULL && q >= -22 && q <= 22) {
+        v = (double)w;
+        v = q < 0 ? v / p10[-q] : v * p10[q];
+        if (neg) v = -v;
+    }
+    else if (q < _FMT_POW10_MIN) v = neg ? -0.0 : 0.0;
+    else if (q > 308) { unsigned long long inf = 0x7FF0000000000000ULL | (unsigned long long)neg << 63; memcpy(&v, &inf, 8); }
+    else if (!_parse_eisel_lemire(w, q, neg, &v)) v = _parse_double_slow(s, i);
+    *out = v;
+    return i;
+}
+
+/* --- Random Numbers --- */
+// Not for keys or tokens: these generators are fast and statistically strong,
+// but predictable from their output.
+//   qol_rng     xoshiro256++: 256-bit state, period 2^256 - 1, jumps for parallel streams.
+//   qol_pcg32   PCG-XSH-RR: 128-bit state, 32-bit output, 2^63 selectable streams.
+//   qol_rng8    eight interleaved xoshiro256++ lanes for SIMD bulk fills.
+
+typedef struct { unsigned long long s[4]; } qol_rng;
+typedef struct { unsigned long long state, inc; } qol_pcg32;
+
+static inline unsigned long long _rng_rotl(unsigned long long x, int k) { return (x << k) | (x >> (64 - k)); }
+
+// splitmix64: spreads one seed word over a whole state (and never yields all-zero xoshiro state in practice).
+static inline unsigned long long _rng_splitmix(unsigned long long* x) {
+    unsigned long long z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static inline void rng_seed(qol_rng* r, unsigned long long seed) {
+    for (int i = 0; i < 4; i++) r->s[i] = _rng_splitmix(&seed);
+}
+
+static inline unsigned long long rng_next(qol_rng* r) {
+    unsigned long long* s = r->s;
+    unsigned long long out = _rng_rotl(s[0] + s[3], 23) + s[0], t = s[1] << 17;
+    s[2] ^= s[0]; s[3] ^= s[1]; s[1] ^= s[2]; s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = _rng_rotl(s[3], 45);
+    return out;
+}
+
+static inline void _rng_jump_by(qol_rng* r, const unsigned long long* poly) {
+    unsigned long long acc[4] = { 0, 0, 0, 0 };
+    for (int w = 0; w < 4; w++)
+        for (int b = 0; b < 64; b++) {
+            if (poly[w] >> b & 1) for (int i = 0; i < 4; i++) acc[i] ^= r->s[i];
+            rng_next(r);
+        }
+    memcpy(r->s, acc, sizeof(acc));
+}
+
+// Advances 2^128 steps: seed once, then jump after handing a copy to each thread
+// for up to 2^128 non-overlapping streams of 2^128 values.
+static inline void rng_jump(qol_rng* r) {
+    static const unsigned long long poly[4] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+    _rng_jump_by(r, poly);
+}
+
+// Advances 2^192 steps, for a second level of streams (e.g. per machine, then rng_jump per thread).
+static inline void rng_long_jump(qol_rng* r) {
+    static const unsigned long long poly[4] = { 0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL, 0x77710069854ee241ULL, 0x39109bb02acbe635ULL };
+    _rng_jump_by(r, poly);
+}
+
+// Uniform in [0, n) with no modulo bias (Lemire): one multiply, and a division
+// only in the rare case that the low half lands in the biased zone. n = 0 returns 0.
+static inline unsigned long long rng_below(qol_rng* r, unsigned long long n) {
+    unsigned long long lo, hi = _fmt_mul128(rng_next(r), n, &lo);
+    if (lo < n) {
+        unsigned long long t = (0 - n) % n;
+        while (lo < t) hi = _fmt_mul128(rng_next(r), n, &lo);
+    }
+    return hi;
+}
+
+// Uniform in [lo, hi], inclusive; the full long long range works.
+static inline long long rng_range(qol_rng* r, long long lo, long long hi) {
+    unsigned long long span = (unsigned long long)hi - (unsigned long long)lo + 1;
+    unsigned long long off = span ? rng_below(r, span) : rng_next(r);
+    return (long long)((unsigned long long)lo + off);
+}
+
+// [0, 1) from the top 53 bits: every value is a multiple of 2^-53.
+static inline double rng_double(qol_rng* r) { return (double)(rng_next(r) >> 11) * (1.0 / 9007199254740992.0); }
+static inline float rng_float(qol_rng* r) { return (float)(rng_next(r) >> 40) * (1.0f / 16777216.0f); }
+
+// The calling thread's generator, seeded on first use from the clock and the
+// thread's own address, so threads never share a sequence.
+static inline qol_rng* rng_local() {
+    static _TOOLS_TLS qol_rng state;
+    static _TOOLS_TLS int seeded = 0;
+    if (!seeded) {
+        unsigned long long mix = time_mono_ns() ^ time_cycles() ^ ((unsigned long long)(size_t)&state * 0x9E3779B97F4A7C15ULL);
+        rng_seed(&state, mix);
+        seeded = 1;
+    }
+    return &state;
+}
+
+/* PCG32 */
+
+#define _PCG_MULT 6364136223846793005ULL
+
+static inline unsigned int pcg32_next(qol_pcg32* p) {
+    unsigned long long old = p->state;
+    p->state = old * _PCG_MULT + p->inc;
+    unsigned int xs = (unsigned int)(((old >> 18) ^ old) >> 27), rot = (unsigned int)(old >> 59);
+    return (xs >> rot) | (xs << ((0u - rot) & 31));
+}
+
+// Generators with the same seed but different streams produce unrelated sequences.
+static inline void pcg32_seed(qol_pcg32* p, unsigned long long seed, unsigned long long stream) {
+    p->state = 0;
+    p->inc = (stream << 1) | 1;
+    pcg32_next(p);
+    p->state += seed;
+    pcg32_next(p);
+}
+
+// Skips delta outputs in O(log delta) (delta may also be "negative" to step back).
+static inline void pcg32_advance(qol_pcg32* p, unsigned long long delta) {
+    unsigned long long mult = _PCG_MULT, plus = p->inc, acc_mult = 1, acc_plus = 0;
+    for (; delta; delta >>= 1) {
+        if (delta & 1) { acc_mult *= mult; acc_plus = acc_plus * mult + plus; }
+        plus = (mult + 1) * plus;
+        mult *= mult;
+    }
+    p->state = acc_mult * p->state + acc_plus;
+}
+
+static inline unsigned int pcg32_below(qol_pcg32* p, unsigned int n) {
+    unsigned long long m = (unsigned long long)pcg32_next(p) * n;
+    if ((unsigned int)m < n) {
+        unsigned int t = (0u - n) % n;
+        while ((unsigned int)m < t) m = (unsigned long long)pcg32_next(p) * n;
+    }
+    return (unsigned int)(m >> 32);
+}
+
+static inline float pcg32_float(qol_pcg32* p) { return (float)(pcg32_next(p) >> 8) * (1.0f / 16777216.0f); }
+
+/* Bulk generation */
+
+// Eight xoshiro256++ lanes, each rng_jump'ed from the previous one, stored by
+// word: s[w][lane]. Fills write lane 0..7 values in turn, so the output is the
+// same on every dispatch level; the tail of a fill that is not a multiple of 8
+// discards the rest of its last round.
+#define RNG8_LANES 8
+
+typedef struct { unsigned long long s[4][RNG8_LANES]; } qol_rng8;
+
+static inline void rng8_init(qol_rng8* g, const qol_rng* src) {
+    qol_rng r = *src;
+    for (int k = 0; k < RNG8_LANES; k++) {
+        for (int w = 0; w < 4; w++) g->s[w][k] = r.s[w];
+        rng_jump(&r);
+    }
+}
+
+static inline void rng8_seed(qol_rng8* g, unsigned long long seed) {
+    qol_rng r;
+    rng_seed(&r, seed);
+    rng8_init(g, &r);
+}
+
+// One round: 8 outputs, for the tail of a fill.
+static inline void _rng8_round(qol_rng8* g, unsigned long long* out) {
+    for (int k = 0; k < RNG8_LANES; k++) {
+        unsigned long long s0 = g->s[0][k], s1 = g->s[1][k], s2 = g->s[2][k], s3 = g->s[3][k];
+        out[k] = _rng_rotl(s0 + s3, 23) + s0;
+        unsigned long long t = s1 << 17;
+        s2 ^= s0; s3 ^= s1; s1 ^= s2; s0 ^= s3;
+        s2 ^= t;
+        g->s[0][k] = s0; g->s[1][k] = s1; g->s[2][k] = s2; g->s[3][k] = _rng_rotl(s3, 45);
+    }
+}
+
+// 1.0 + 52 random mantissa bits, minus 1: [0, 1) in steps of 2^-52, with no int-to-float conversion.
+static inline double _rng_bits_to_double(unsigned long long x) {
+    double d;
+    x = (x >> 12) | 0x3FF0000000000000ULL;
+    memcpy(&d, &x, sizeof(d));
+    return d - 1.0;
+}
+
+#ifdef _TOOLS_X86_SIMD
+// One xoshiro256++ step on four lanes.
+__attribute__((target("avx2")))
+static inline __m256i _rng_avx2_step(__m256i* s0, __m256i* s1, __m256i* s2, __m256i* s3) {
+    __m256i sum = _mm256_add_epi64(*s0, *s3);
+    __m256i out = _mm256_add_epi64(_mm256_or_si256(_mm256_slli_epi64(sum, 23), _mm256_srli_epi64(sum, 41)), *s0);
+    __m256i t = _mm256_slli_epi64(*s1, 17);
+    *s2 = _mm256_xor_si256(*s2, *s0);
+    *s3 = _mm256_xor_si256(*s3, *s1);
+    *s1 = _mm256_xor_si256(*s1, *s2);
+    *s0 = _mm256_xor_si256(*s0, *s3);
+    *s2 = _mm256_xor_si256(*s2, t);
+    *s3 = _mm256_or_si256(_mm256_slli_epi64(*s3, 45), _mm256_srli_epi64(*s3, 19));
+    return out;
+}
+
+__attribute__((target("avx2")))
+static inline __m256i _rng_avx2_to_double(__m256i x) {
+    __m256d d = _mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(x, 12), _mm256_set1_epi64x(0x3FF0000000000000LL)));
+    return _mm256_castpd_si256(_mm256_sub_pd(d, _mm256_set1_pd(1.0)));
+}
+
+// Whole rounds, with both halves of the lanes kept in registers; returns the number of values written.
+__attribute__((target("avx2")))
+static inline size_t _rng8_fill_avx2(qol_rng8* g, void* out, size_t n, int as_double) {
+    __m256i a0 = _mm256_loadu_si256((const __m256i*)&g->s[0][0]), b0 = _mm256_loadu_si256((const __m256i*)&g->s[0][4]);
+    __m256i a1 = _mm256_loadu_si256((const __m256i*)&g->s[1][0]), b1 = _mm256_loadu_si256((const __m256i*)&g->s[1][4]);
+    __m256i a2 = _mm256_loadu_si256((const __m256i*)&g->s[2][0]), b2 = _mm256_loadu_si256((const __m256i*)&g->s[2][4]);
+    __m256i a3 = _mm256_loadu_si256((const __m256i*)&g->s[3][0]), b3 = _mm256_loadu_si256((const __m256i*)&g->s[3][4]);
+    __m256i* o = (__m256i*)out;
+    size_t i = 0;
+    if (as_double) {
+        for (; i + RNG8_LANES <= n; i += RNG8_LANES, o += 2) {
+            _mm256_storeu_si256(o, _rng_avx2_to_double(_rng_avx2_step(&a0, &a1, &a2, &a3)));
+            _mm256_storeu_si256(o + 1, _rng_avx2_to_double(_rng_avx2_step(&b0, &b1, &b2, &b3)));
+        }
+    } else {
+        for (; i + RNG8_LANES <= n; i += RNG8_LANES, o += 2) {
+            _mm256_storeu_si256(o, _rng_avx2_step(&a0, &a1, &a2, &a3));
+            _mm256_storeu_si256(o + 1, _rng_avx2_step(&b0, &b1, &b2, &b3));
+        }
+    }
+    _mm256_storeu_si256((__m256i*)&g->s[0][0], a0); _mm256_storeu_si256((__m256i*)&g->s[0][4], b0);
+    _mm256_storeu_si256((__m256i*)&g->s[1][0], a1); _mm256_storeu_si256((__m256i*)&g->s[1][4], b1);
+    _mm256_storeu_si256((__m256i*)&g->s[2][0], a2); _mm256_storeu_si256((__m256i*)&g->s[2][4], b2);
+    _mm256_storeu_si256((__m256i*)&g->s[3][0], a3); _mm256_storeu_si256((__m256i*)&g->s[3][4], b3);
+    return i;
+}
+#endif
+
+// Rounds are produced in blocks that stay in L1; within a block each lane
+// (or lane pair) runs all its rounds with the state in registers.
+#define _RNG8_BLOCK 32
+
+static inline void _rng8_block_scalar(qol_rng8* g, void* out, size_t rounds, int as_double) {
+    for (int k = 0; k < RNG8_LANES; k++) {
+        unsigned long long s0 = g->s[0][k], s1 = g->s[1][k], s2 = g->s[2][k], s3 = g->s[3][k];
+        for (size_t r = 0; r < rounds; r++) {
+            unsigned long long v = _rng_rotl(s0 + s3, 23) + s0, t = s1 << 17;
+            s2 ^= s0; s3 ^= s1; s1 ^= s2; s0 ^= s3;
+            s2 ^= t;
+            s3 = _rng_rotl(s3, 45);
+            if (as_double) ((double*)out)[r * RNG8_LANES + k] = _rng_bits_to_double(v);
+            else ((unsigned long long*)out)[r * RNG8_LANES + k] = v;
+        }
+        g->s[0][k] = s0; g->s[1][k] = s1; g->s[2][k] = s2; g->s[3][k] = s3;
+    }
+}
+
+#ifdef _TOOLS_SSE2
+static inline void _rng8_block_sse2(qol_rng8* g, void* out, size_t rounds, int as_double) {
+    const __m128i one_exp = _mm_set1_epi64x(0x3FF0000000000000LL);
+    const __m128d one = _mm_set1_pd(1.0);
+    for (int k = 0; k < RNG8_LANES; k += 2) {
+        __m128i s0 = _mm_loadu_si128((const __m128i*)&g->s[0][k]), s1 = _mm_loadu_si128((const __m128i*)&g->s[1][k]);
+        __m128i s2 = _mm_loadu_si128((const __m128i*)&g->s[2][k]), s3 = _mm_loadu_si128((const __m128i*)&g->s[3][k]);
+        for (size_t r = 0; r < rounds; r++) {
+            __m128i sum = _mm_add_epi64(s0, s3);
+            __m128i v = _mm_add_epi64(_mm_or_si128(_mm_slli_epi64(sum, 23), _mm_srli_epi64(sum, 41)), s0);
+            __m128i t = _mm_slli_epi64(s1, 17);
+            s2 = _mm_xor_si128(s2, s0); s3 = _mm_xor_si128(s3, s1);
+            s1 = _mm_xor_si128(s1, s2); s0 = _mm_xor_si128(s0, s3);
+            s2 = _mm_xor_si128(s2, t);
+            s3 = _mm_or_si128(_mm_slli_epi64(s3, 45), _mm_srli_epi64(s3, 19));
+            if (as_double) v = _mm_castpd_si128(_mm_sub_pd(_mm_castsi128_pd(_mm_or_si128(_mm_srli_epi64(v, 12), one_exp)), one));
+            _mm_storeu_si128((__m128i*)((unsigned long long*)out + r * RNG8_LANES + k), v);
+        }
+        _mm_storeu_si128((__m128i*)&g->s[0][k], s0); _mm_storeu_si128((__m128i*)&g->s[1][k], s1);
+        _mm_storeu_si128((__m128i*)&g->s[2][k], s2); _mm_storeu_si128((__m128i*)&g->s[3][k], s3);
+    }
+}
+#endif
+
+static inline void _rng8_fill(qol_rng8* g, void* out, size_t n, int as_double) {
+    unsigned long long v[RNG8_LANES];
+    size_t i = 0;
+    int level = tools_simd_level();
+#ifdef _TOOLS_X86_SIMD
+    if (level >= 2) i = _rng8_fill_avx2(g, out, n, as_double);
+#endif
+    while (n - i >= RNG8_LANES) {
+        size_t rounds = (n - i) / RNG8_LANES;
+        if (rounds > _RNG8_BLOCK) rounds = _RNG8_BLOCK;
+        void* dst = (unsigned long long*)out + i;
+#ifdef _TOOLS_SSE2
+        if (level >= 1) _rng8_block_sse2(g, dst, rounds, as_double);
+        else
+#endif
+        _rng8_block_scalar(g, dst, rounds, as_double);
+        i += rounds * RNG8_LANES;
+    }
+    (void)level;
+    if (i < n) {
+        _rng8_round(g, v);
+        for (int k = 0; i < n; k++, i++) {
+            if (as_double) ((double*)out)[i] = _rng_bits_to_double(v[k]);
+            else ((unsigned long long*)out)[i] = v[k];
+        }
+    }
+}
+
+static inline void rng8_fill_u64(qol_rng8* g, unsigned long long* out, size_t n) { _rng8_fill(g, out, n, 0); }
+
+// [0, 1) with 52 random bits per value.
+static inline void rng8_fill_double(qol_rng8* g, double* out, size_t n) { _rng8_fill(g, out, n, 1); }
+
+// Any number of random bytes.
+static inline void rng8_fill_bytes(qol_rng8* g, void* out, size_t n) {
+    unsigned long long tail;
+    size_t words = n / 8;
+    if (words) {
+        if (((size_t)out & 7) == 0) rng8_fill_u64(g, (unsigned long long*)out, words);
+        else {
+            unsigned long long buf[64];
+            for (size_t done = 0; done < words; ) {
+                size_t k = words - done < 64 ? words - done : 64;
+                rng8_fill_u64(g, buf, k);
+                memcpy((char*)out + 8 * done, buf, 8 * k);
+                done += k;
+            }
+        }
+    }
+    if (n % 8) {
+        rng8_fill_u64(g, &tail, 1);
+        memcpy((char*)out + 8 * words, &tail, n % 8);
+    }
+}
+
+/* --- JSON Writer --- */
+
+#ifndef JW_MAX_DEPTH
+#define JW_MAX_DEPTH 32
+#endif
+
+// Streaming JSON writer. Output goes to a caller buffer (jw_init, no allocation)
+// or to a qol_sb (jw_init_sb). Commas and nesting are tracked for you.
+typedef struct {
+    char* buf; size_t cap;  // caller buffer, unused with sb
+    qol_sb* sb;
+    size_t len;             // bytes produced, counted even past cap
+    int depth, error, overflow, after_key;
+    unsigned char level[JW_MAX_DEPTH + 1]; // per depth: 1 = has items, 2 = object
+} qol_jw;
+
+static inline void jw_init(qol_jw* jw, char* buf, size_t cap) {
+    memset(jw, 0, sizeof(*jw));
+    jw->buf = buf; jw->cap = cap;
+}
+
+static inline void jw_init_sb(qol_jw* jw, qol_sb* sb) {
+    memset(jw, 0, sizeof(*jw));
+    jw->sb = sb;
+}
+
+// Buffer mode stops writing at the first chunk that does not fit but keeps
+// counting, so jw_finish can report the size that was needed.
+static inline void _jw_put(qol_jw* jw, const char* s, size_t n) {
+    if (jw->sb) { if (!sb_append_n(jw->sb, s, n)) jw->error = 1; return; }
+    if (!jw->overflow && jw->len + n < jw->cap) memcpy(jw->buf + jw->len, s, n);
+    else jw->overflow = 1;
+    jw->len += n;
+}
+
+// Index of the first byte in s[0..n) that JSON needs escaped: '"', '\' or < 0x20.
+static inline size_t _jw_clean_prefix(const char* s, size_t n) {
+    size_t i = 0;
+#ifdef _TOOLS_SSE2
+    const __m128i quote = _mm_set1_epi8('"'), bslash = _mm_set1_epi8('\\'), ctl = _mm_set1_epi8(0x1F);
+    for (; i + 16 <= n; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(s + i));
+        __m128i bad = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, quote), _mm_cmpeq_epi8(x, bslash)),
+                                   _mm_cmpeq_epi8(_mm_min_epu8(x, ctl), x));
+        unsigned mask = (unsigned)_mm_movemask_epi8(bad);
+        if (mask) return i + (size_t)__builtin_ctz(mask);
+    }
+#endif
+    for (; i < n; i++) {
+        unsigned char c = (unsigned char)s[i];
+        if (c < 0x20 || c == '"' || c == '\\') break;
+    }
+    return i;
+}
+
+// Writes s as a quoted JSON string. Clean runs are copied whole; UTF-8 passes through.
+static inline void _jw_put_str(qol_jw* jw, const char* s, size_t n) {
+    static const char hex[] = "0123456789abcdef";
+    _jw_put(jw, "\"", 1);
+    while (n) {
+        size_t run = _jw_clean_prefix(s, n);
+        if (run) _jw_put(jw, s, run);
+        if (run == n) break;
+        unsigned char c = (unsigned char)s[run];
+        char esc[6] = { '\\', (char)c, 0, 0, 0, 0 };
+        size_t elen = 2;
+        switch (c) {
+            case '"': case '\\': break;
+            case '\b': esc[1] = 'b'; break;
+            case '\f': esc[1] = 'f'; break;
+            case '\n': esc[1] = 'n'; break;
+            case '\r': esc[1] = 'r'; break;
+            case '\t': esc[1] = 't'; break;
+            default:
+                esc[1] = 'u'; esc[2] = '0'; esc[3] = '0';
+                esc[4] = hex[c >> 4]; esc[5] = hex[c & 15]; elen = 6;
+        }
+        _jw_put(jw, esc, elen);
+        s += run + 1; n -= run + 1;
+    }
+    _jw_put(jw, "\"", 1);
+}
+
+// Comma and key bookkeeping before any value; is_key marks a jw_key call.
+static inline void _jw_sep(qol_jw* jw, int is_key) {
+    unsigned char* lv = &jw->level[jw->depth];
+    int in_obj = (*lv & 2) != 0;
+    if (jw->after_key) {
+        if (is_key) jw->error = 1;
+        jw->after_key = 0;
+        return;
+    }
+    if (in_obj != is_key) jw->error = 1;
+    if (*lv & 1) _jw_put(jw, ",", 1);
+    *lv |= 1;
+}
+
+static inline void _jw_open(qol_jw* jw, char c, unsigned char kind) {
+    _jw_sep(jw, 0);
+    if (jw->depth >= JW_MAX_DEPTH) { jw->error = 1; return; }
+    jw->level[++jw->depth] = kind;
+    _jw_put(jw, &c, 1);
+}
+
+static inline void _jw_close(qol_jw* jw, char c, unsigned char kind) {
+    if (jw->depth == 0 || (jw->level[jw->depth] & 2) != kind || jw->after_key) { jw->error = 1; return; }
+    jw->depth--;
+    _jw_put(jw, &c, 1);
+}
+
+static inline void jw_begin_obj(qol_jw* jw) { _jw_open(jw, '{', 2); }
+static inline void jw_end_obj(qol_jw* jw)   { _jw_close(jw, '}', 2); }
+static inline void jw_begin_arr(qol_jw* jw) { _jw_open(jw, '[', 0); }
+static inline void jw_end_arr(qol_jw* jw)   { _jw_close(jw, ']', 0); }
+
+static inline void jw_key_n(qol_jw* jw, const char* k, size_t n) {
+    _jw_sep(jw, 1);
+    _jw_put_str(jw, k, n);
+    _jw_put(jw, ":", 1);
+    jw->after_key = 1;
+}
+static inline void jw_key(qol_jw* jw, const char* k) { jw_key_n(jw, k, strlen(k)); }
+
+static inline void jw_null(qol_jw* jw) { _jw_sep(jw, 0); _jw_put(jw, "null", 4); }
+static inline void jw_bool(qol_jw* jw, int v) { _jw_sep(jw, 0); _jw_put(jw, v ? "true" : "false", v ? 4 : 5); }
+
+static inline void jw_str_n(qol_jw* jw, const char* s, size_t n) { _jw_sep(jw, 0); _jw_put_str(jw, s, n); }
+static inline void jw_str(qol_jw* jw, const char* s) { if (s) jw_str_n(jw, s, strlen(s)); else jw_null(jw); }
+
+static inline void jw_uint(qol_jw* jw, unsigned long long v) {
+    char tmp[FMT_INT_MAX];
+    size_t n = fmt_u64(tmp, v);
+    _jw_sep(jw, 0);
+    _jw_put(jw, tmp, n);
+}
+
+static inline void jw_int(qol_jw* jw, long long v) {
+    char tmp[FMT_INT_MAX];
+    size_t n = fmt_i64(tmp, v);
+    _jw_sep(jw, 0);
+    _jw_put(jw, tmp, n);
+}
+
+// NaN and infinities have no JSON form and are written as null.
+static inline void jw_double(qol_jw* jw, double v) {
+    if (v != v || v - v != 0) { jw_null(jw); return; }
+    char tmp[FMT_DOUBLE_MAX];
+    size_t n = fmt_double(tmp, v);
+    _jw_sep(jw, 0);
+    _jw_put(jw, tmp, n);
+}
+
+// Inserts already-encoded JSON as one value.
+static inline void jw_raw(qol_jw* jw, const char* json) { _jw_sep(jw, 0); _jw_put(jw, json, strlen(json)); }
+
+// NUL-terminates and returns the document length. In buffer mode a result
+// >= cap means the buffer was too small (nothing past the last whole chunk
+// was written). Returns 0 on misuse (unbalanced, value without key) or
+// allocation failure.
+static inline size_t jw_finish(qol_jw* jw) {
+    if (jw->error || jw->depth || jw->after_key) return 0;
+    if (jw->sb) {
+        if (!sb_reserve(jw->sb, 0)) return 0;
+        jw->sb->data[jw->sb->len] = '\0';
+        return jw->sb->len;
+    }
+    if (!jw->overflow && jw->len < jw->cap) jw->buf[jw->len] = '\0';
+    else if (jw->cap) jw->buf[0] = '\0';
+    return jw->len;
+}
+
+/* --- JSON Builder --- */
+
+// Keeps its original output shape ("k":v pairs joined by ", ", floats as %.2f)
+// but escapes string values and walks fmt in place instead of strtok'ing a copy.
+static inline char* json_obj(const char* fmt, ...) {
+    qol_sb sb = {0};
+    qol_jw jw;
+    jw_init_sb(&jw, &sb);
+    sb_reserve(&sb, 2 * strlen(fmt) + 64);
+    sb_appendc(&sb, '{');
+    va_list args; va_start(args, fmt);
+    const char* p = fmt;
+    int first = 1;
+    for (;;) {
+        while (*p == ',' || *p == ' ') p++;
+        if (!*p) break;
+        const char* tok = p;
+        while (*p && *p != ',' && *p != ' ') p++;
+        const char* key = (const char*)memchr(tok, ':', (size_t)(p - tok));
+        if (!first) sb_append_n(&sb, ", ", 2);
+        first = 0;
+        if (!key) continue;
+        key++;
+        _jw_put_str(&jw, key, (size_t)(p - key));
+        sb_appendc(&sb, ':');
+        if (tok[0] == 's') {
+            const char* val = va_arg(args, const char*);
+            if (val) _jw_put_str(&jw, val, strlen(val)); else sb_append_n(&sb, "null", 4);
+        } else if (tok[0] == 'i') {
+            sb_append_i64(&sb, va_arg(args, int));
+        } else if (tok[0] == 'f') {
+            sb_appendf(&sb, "%.2f", va_arg(args, double));
+        } else if (tok[0] == 'b') {
+            sb_append(&sb, va_arg(args, int) ? "true" : "false");
+        }
+    }
+    sb_appendc(&sb, '}');
+    va_end(args);
+    return sb.data;
+}
+
+/* --- Async Logger --- */
+
+// Each thread that logs gets its own single-producer ring, so a call takes no
+// lock and never touches the output: it checks the level, then copies a
+// timestamp, the call site and the raw arguments into the ring. A writer thread
+// formats the records, merges the rings in time order and hands the text to
+// write() in large batches.
+//
+// Formats must be string literals. Each call site parses its conversions once
+// and caches them; %s arguments are copied (up to QLOG_MAX_STR bytes), never
+// kept by pointer. A format the cache cannot describe (%n, %ls, more than
+// QLOG_MAX_ARGS arguments) is formatted on the calling thread instead.
+
+#define QLOG_TRACE 1
+#define QLOG_DEBUG 2
+#define QLOG_INFO  3
+#define QLOG_WARN  4
+#define QLOG_ERROR 5
+#define QLOG_FATAL 6
+#define QLOG_OFF   7
+
+// Calls below this level compile to nothing; their arguments are not evaluated.
+#ifndef QLOG_MIN_LEVEL
+#define QLOG_MIN_LEVEL QLOG_TRACE
+#endif
+
+#ifndef QLOG_RING
+#define QLOG_RING (64 * 1024)  // bytes per thread, a power of two
+#endif
+#ifndef QLOG_BATCH
+#define QLOG_BATCH (64 * 1024) // formatted bytes per write() call
+#endif
+#ifndef QLOG_IDLE_US
+#define QLOG_IDLE_US 1000      // writer sleep while every ring is empty
+#endif
+#define QLOG_MAX_ARGS 16
+#define QLOG_MAX_STR 1024
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    #define _tools_load_int(p)      InterlockedCompareExchange((volatile long*)(p), 0, 0)
+    #define _tools_store_int(p, v)  InterlockedExchange((volatile long*)(p), (long)(v))
+    #define _tools_add_int(p, v)    (InterlockedExchangeAdd((volatile long*)(p), (long)(v)) + (v))
+    #define _tools_cas_int(p, e, v) (InterlockedCompareExchange((volatile long*)(p), (long)(v), (long)(e)) == (long)(e))
+    #define _tools_load_u64(p)      ((unsigned long long)InterlockedCompareExchange64((volatile long long*)(p), 0, 0))
+    #define _tools_store_u64(p, v)  InterlockedExchange64((volatile long long*)(p), (long long)(v))
+    #define _tools_add_u64(p, v)    ((unsigned long long)InterlockedExchangeAdd64((volatile long long*)(p), (long long)(v)) + (v))
+#else
+    #define _tools_load_int(p)      __atomic_load_n(p, __ATOMIC_ACQUIRE)
+    #define _tools_store_int(p, v)  __atomic_store_n(p, v, __ATOMIC_RELEASE)
+    #define _tools_add_int(p, v)    __atomic_add_fetch(p, v, __ATOMIC_ACQ_REL)
+    #define _tools_cas_int(p, e, v) __extension__ ({ int _e = (e); __atomic_compare_exchange_n(p, &_e, v, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE); })
+    #define _tools_load_u64(p)      __atomic_load_n(p, __ATOMIC_ACQUIRE)
+    #define _tools_store_u64(p, v)  __atomic_store_n(p, v, __ATOMIC_RELEASE)
+    #define _tools_add_u64(p, v)    __atomic_add_fetch(p, v, __ATOMIC_ACQ_REL)
+#endif
+
+// One step of a compiled format: lit bytes of text, then a conversion of len
+// bytes. kind: d/u/s/c written directly, f through snprintf, % a literal '%'.
+typedef struct { unsigned short lit, len; char kind, stars; } _qlog_op;
+
+// One per call site (a static inside QLOG). state: 0 new, 1 being parsed,
+// 2 compiled, 3 formatted by the caller.
+typedef struct {
+    const char* fmt;
+    int level, state, n_args, n_ops, tail;
+    char types[QLOG_MAX_ARGS]; // how each argument is read, see _qlog_type
+    short prec[QLOG_MAX_ARGS]; // %s: byte limit, -1 none, -2 from the preceding '*'
+    _qlog_op ops[QLOG_MAX_ARGS];
+} qol_log_site;
+
+// Written by its thread (head), read by the writer (tail). Freed when both the
+// thread and the logger have let go of it (refs).
+typedef struct _qlog_ring {
+    unsigned long long head, tail_seen, dropped;
+    struct _qlog_ring* thread_next; // the owning thread's list
+    const void* log;
+    char _gap[64];                  // keeps the writer's fields off the producer's cache line
+    unsigned long long tail, end, reported;
+    struct _qlog_ring* next;        // the logger's list
+    int orphaned, detached, refs;
+} _qlog_ring;
+#define _QLOG_DATA(r) ((unsigned char*)(void*)((r) + 1))
+
+// A record: this header, one 8-byte slot per argument (a %s slot holds the
+// length), then the string bytes, each NUL-terminated and padded to 8.
+typedef struct { unsigned size; const qol_log_site* site; unsigned long long stamp; } _qlog_rec;
+#define _QLOG_REC_SIZE ((sizeof(_qlog_rec) + 7) & ~(size_t)7)
+#define _QLOG_WRAP 0xFFFFFFFFu // in place of a size: the rest of the ring is unused
+
+typedef struct {
+    int level;              // runtime threshold, read by every call
+    int block;              // 1 (default): a full ring makes the caller wait; 0: drop and count
+    int running, fd;
+    _tools_mutex lock;      // guards the ring list
+    _qlog_ring* rings;
+    unsigned long long flush_req, flush_done, dropped;
+    unsigned long long cyc0, mono0, cyc_at, real_at; // writer: time_cycles() to wall clock
+    double ns_per_cyc;
+    qol_sb out;             // writer only
+    time_t tsec;
+    char ttext[TIME_NOW_LEN];
+#ifdef _WIN32
+    HANDLE thread;
+#else
+    pthread_t thread;
+#endif
+} qol_log;
+
+static inline void _qlog_yield() {
+#ifdef _WIN32
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+static inline void _qlog_sleep_us(unsigned us) {
+#if defined(_WIN32)
+    Sleep(us / 1000 ? us / 1000 : 1);
+#elif defined(_TOOLS_POSIX_TIME)
+    struct timespec ts = { (time_t)(us / 1000000), (long)(us % 1000000) * 1000 };
+    nanosleep(&ts, NULL);
+#else
+    (void)us; _qlog_yield();
+#endif
+}
+
+// Wall-clock nanoseconds since 1970.
+static inline unsigned long long _qlog_clock_ns() {
+#ifdef _WIN32
+    FILETIME ft;
+    GetSystemTimePreciseAsFileTime(&ft);
+    return (((unsigned long long)ft.dwHighDateTime << 32 | ft.dwLowDateTime) - 116444736000000000ULL) * 100;
+#elif defined(_TOOLS_POSIX_TIME)
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+#else
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+#endif
+}
+
+typedef struct { int stars, star_prec, prec, plain; char len, conv; } _qlog_spec;
+
+// Reads one conversion after its '%'; returns the character after it.
+static inline const char* _qlog_parse_spec(const char* f, _qlog_spec* sp) {
+    int decor = 0;
+    sp->stars = sp->star_prec = 0; sp->prec = -1; sp->len = 0;
+    while (*f == '-' || *f == '+' || *f == ' ' || *f == '#' || *f == '0' || *f == '\'') { f++; decor = 1; }
+    if (*f == '*') { sp->stars++; f++; decor = 1; }
+    else while (*f >= '0' && *f <= '9') { f++; decor = 1; }
+    if (*f == '.') {
+        f++; decor = 1;
+        if (*f == '*') { sp->stars++; sp->star_prec = 1; f++; }
+        else for (sp->prec = 0; *f >= '0' && *f <= '9'; f++) sp->prec = sp->prec < 100000 ? sp->prec * 10 + (*f - '0') : sp->prec;
+    }
+    if (*f == 'h') { f++; sp->len = 'h'; if (*f == 'h') { f++; sp->len = 'H'; } }
+    else if (*f == 'l') { f++; sp->len = 'l'; if (*f == 'l') { f++; sp->len = 'q'; } }
+    else if (*f == 'z' || *f == 't' || *f == 'j' || *f == 'L') sp->len = *f++;
+    sp->conv = *f;
+    if (*f) f++;
+    sp->plain = !decor && sp->len != 'h' && sp->len != 'H';
+    return f;
+}
+
+// Argument type codes: i/I int/unsigned, l/L long, q/Q long long, z size_t,
+// t ptrdiff_t, j/J intmax_t, d double, D long double, p pointer, s string.
+// 0 means the cache cannot handle the conversion.
+static inline char _qlog_type(char len, char conv) {
+    switch (conv) {
+    case 'd': case 'i':
+        return len == 'l' ? 'l' : len == 'q' ? 'q' : len == 'z' ? 'z' : len == 't' ? 't' : len == 'j' ? 'j' : len == 'L' ? 0 : 'i';
+    case 'u': case 'o': case 'x': case 'X':
+        return len == 'l' ? 'L' : len == 'q' ? 'Q' : len == 'z' ? 'z' : len == 't' ? 't' : len == 'j' ? 'J' : len == 'L' ? 0 : 'I';
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+        return len == 'L' ? 'D' : len == 0 || len == 'l' ? 'd' : 0;
+    case 'c': return len ? 0 : 'i';
+    case 's': return len ? 0 : 's';
+    case 'p': return len ? 0 : 'p';
+    }
+    return 0;
+}
+
+// Compiles the format once, so the writer never scans it again.
+_TOOLS_COLD static void _qlog_parse(qol_log_site* s) {
+    if (!_tools_cas_int(&s->state, 0, 1)) {
+        while (_tools_load_int(&s->state) == 1) _qlog_yield();
+        return;
+    }
+    const char *f = s->fmt, *last = f;
+    int n = 0, ops = 0, state = 2;
+    while ((f = strchr(f, '%')) != NULL) {
+        _qlog_op* op = &s->ops[ops];
+        const char* spec = f;
+        if (ops == QLOG_MAX_ARGS || spec - last > 0xFFFF) { state = 3; break; }
+        op->lit = (unsigned short)(spec - last);
+        op->stars = 0;
+        if (f[1] == '%') { op->kind = '%'; f += 2; }
+        else {
+            _qlog_spec sp;
+            f = _qlog_parse_spec(f + 1, &sp);
+            char t = _qlog_type(sp.len, sp.conv);
+            if (!t || n + sp.stars + 1 > QLOG_MAX_ARGS || f - spec > 31) { state = 3; break; }
+            for (int k = 0; k < sp.stars; k++) { s->types[n] = 'i'; s->prec[n++] = -1; }
+            s->prec[n] = (short)(t != 's' ? -1 : sp.star_prec ? -2 : sp.prec > QLOG_MAX_STR ? QLOG_MAX_STR : sp.prec);
+            s->types[n++] = t;
+            op->stars = (char)sp.stars;
+            op->kind = !sp.plain ? 'f' : t == 's' ? 's' : sp.conv == 'd' || sp.conv == 'i' ? 'd' : sp.conv == 'u' ? 'u' : sp.conv == 'c' ? 'c' : 'f';
+        }
+        op->len = (unsigned short)(f - spec);
+        ops++;
+        last = f;
+    }
+    s->n_ops = ops;
+    s->tail = (int)strlen(last);
+    s->n_args = state == 2 ? n : 1;
+    _tools_store_int(&s->state, state);
+}
+
+static inline void _qlog_release(_qlog_ring* r) {
+    if (_tools_add_int(&r->refs, -1) == 0) free(r);
+}
+
+// This thread's rings, most recently used first.
+static _TOOLS_TLS _qlog_ring* _qlog_mine;
+
+// Thread exit: the writer frees each ring once it has drained it.
+static inline void _qlog_thread_exit(void* head) {
+    _qlog_ring* next;
+    for (_qlog_ring* r = (_qlog_ring*)head; r; r = next) {
+        next = r->thread_next;
+        _tools_store_int(&r->orphaned, 1);
+        _qlog_release(r);
+    }
+}
+
+#ifdef _WIN32
+static DWORD _qlog_key = FLS_OUT_OF_INDEXES;
+static INIT_ONCE _qlog_once = INIT_ONCE_STATIC_INIT;
+static inline VOID WINAPI _qlog_fls_exit(PVOID head) { if (head) _qlog_thread_exit(head); }
+static inline BOOL CALLBACK _qlog_key_init(PINIT_ONCE o, PVOID a, PVOID* c) {
+    (void)o; (void)a; (void)c;
+    _qlog_key = FlsAlloc(_qlog_fls_exit);
+    return TRUE;
+}
+static inline void _qlog_set_mine(_qlog_ring* head) {
+    InitOnceExecuteOnce(&_qlog_once, _qlog_key_init, NULL, NULL);
+    _qlog_mine = head;
+    FlsSetValue(_qlog_key, head);
+}
+#else
+static pthread_key_t _qlog_key;
+static pthread_once_t _qlog_once = PTHREAD_ONCE_INIT;
+static inline void _qlog_key_init() { pthread_key_create(&_qlog_key, _qlog_thread_exit); }
+static inline void _qlog_set_mine(_qlog_ring* head) {
+    pthread_once(&_qlog_once, _qlog_key_init);
+    _qlog_mine = head;
+    pthread_setspecific(_qlog_key, head);
+}
+#endif
+
+// First call of a thread on lg: drops rings of stopped loggers and registers a new one.
+_TOOLS_COLD static _qlog_ring* _qlog_ring_slow(qol_log* lg) {
+    _qlog_ring *head = _qlog_mine, **pp = &head, *found = NULL;
+    while (*pp) {
+        _qlog_ring* r = *pp;
+        if (_tools_load_int(&r->detached)) { *pp = r->thread_next; _qlog_release(r); continue; }
+        if (r->log == lg && !found) { found = r; *pp = r->thread_next; continue; }
+        pp = &r->thread_next;
+    }
+    // Rings stay on the C heap: they outlive the calling thread's allocator scope
+    // and are released by the writer thread.
+    if (!found && (found = (_qlog_ring*)calloc(1, sizeof(_qlog_ring) + QLOG_RING)) != NULL) {
+        int ok;
+        found->log = lg;
+        found->refs = 2;
+        _tools_lock(&lg->lock);
+        ok = lg->running;
+        if (ok) { found->next = lg->rings; lg->rings = found; }
+        _tools_unlock(&lg->lock);
+        if (!ok) { free(found); found = NULL; }
+    }
+    if (found) { found->thread_next = head; head = found; }
+    _qlog_set_mine(head);
+    return found;
+}
+
+static inline _qlog_ring* _qlog_ring_for(qol_log* lg) {
+    _qlog_ring* r = _qlog_mine;
+    if (r && r->log == lg && !_tools_load_int(&r->detached)) return r;
+    return _qlog_ring_slow(lg);
+}
+
+// The hot path: reads the arguments the site describes and copies them into
+// the ring. Waits (or drops, without blocking) when the ring is full.
+static inline void _qlog_push(qol_log* lg, _qlog_ring* r, const qol_log_site* s, va_list ap) {
+    unsigned long long stamp = time_cycles(), a[QLOG_MAX_ARGS];
+    const char* str[QLOG_MAX_ARGS];
+    char pre[QLOG_MAX_STR + 1];
+    const char* types = s->types;
+    int n = s->n_args;
+    size_t size = _QLOG_REC_SIZE + (size_t)n * 8;
+    if (s->state == 3) {
+        int len = vsnprintf(pre, sizeof(pre), s->fmt, ap);
+        a[0] = len < 0 ? 0 : len > QLOG_MAX_STR ? QLOG_MAX_STR : (unsigned long long)len;
+        str[0] = pre;
+        types = "s";
+        size += (a[0] + 8) & ~7ULL;
+    } else {
+        for (int i = 0; i < n; i++) {
+            switch (types[i]) {
+            case 'i': a[i] = (unsigned long long)(long long)va_arg(ap, int); break;
+            case 'I': a[i] = va_arg(ap, unsigned); break;
+            case 'l': a[i] = (unsigned long long)(long long)va_arg(ap, long); break;
+            case 'L': a[i] = va_arg(ap, unsigned long); break;
+            case 'q': a[i] = (unsigned long long)va_arg(ap, long long); break;
+            case 'Q': a[i] = va_arg(ap, unsigned long long); break;
+            case 'z': a[i] = va_arg(ap, size_t); break;
+            case 't': a[i] = (unsigned long long)(long long)va_arg(ap, ptrdiff_t); break;
+            case 'j': a[i] = (unsigned long long)(long long)va_arg(ap, intmax_t); break;
+            case 'J': a[i] = (unsigned long long)va_arg(ap, uintmax_t); break;
+            case 'p': a[i] = (unsigned long long)(uintptr_t)va_arg(ap, void*); break;
+            case 'd': { double d = va_arg(ap, double); memcpy(&a[i], &d, 8); break; }
+            case 'D': { double d = (double)va_arg(ap, long double); memcpy(&a[i], &d, 8); break; }
+            case 's': {
+                const char* v = va_arg(ap, const char*);
+                size_t cap = QLOG_MAX_STR;
+                if (s->prec[i] >= 0) cap = (size_t)s->prec[i];
+                else if (s->prec[i] == -2 && i > 0 && (int)a[i - 1] >= 0 && (int)a[i - 1] < QLOG_MAX_STR) cap = (size_t)(int)a[i - 1];
+                if (!v) v = "(null)";
+                const char* end = (const char*)memchr(v, 0, cap);
+                a[i] = end ? (unsigned long long)(end - v) : cap;
+                str[i] = v;
+                size += (a[i] + 8) & ~7ULL;
+                break;
+            }
+            }
+        }
+    }
+    if (size > QLOG_RING / 2) { _tools_store_u64(&r->dropped, r->dropped + 1); return; }
+
+    unsigned long long head = r->head;
+    size_t idx = (size_t)(head & (QLOG_RING - 1));
+    size_t need = idx + size > QLOG_RING ? QLOG_RING - idx + size : size;
+    while (QLOG_RING - (head - r->tail_seen) < need) {
+        r->tail_seen = _tools_load_u64(&r->tail);
+        if (QLOG_RING - (head - r->tail_seen) >= need) break;
+        // FATAL lines always wait: the process may be about to die.
+        if ((!_tools_load_int(&lg->block) && s->level < QLOG_FATAL) || _tools_load_int(&r->detached)) {
+            _tools_store_u64(&r->dropped, r->dropped + 1);
+            return;
+        }
+        _qlog_yield();
+    }
+
+    unsigned char* d = _QLOG_DATA(r);
+    if (need != size) { *(unsigned*)(void*)(d + idx) = _QLOG_WRAP; idx = 0; }
+    _qlog_rec* h = (_qlog_rec*)(void*)(d + idx);
+    h->size = (unsigned)size; h->site = s; h->stamp = stamp;
+    unsigned long long* slot = (unsigned long long*)(void*)(d + idx + _QLOG_REC_SIZE);
+    char* out = (char*)(slot + n);
+    for (int i = 0; i < n; i++) {
+        slot[i] = a[i];
+        if (types[i] == 's') {
+            memcpy(out, str[i], (size_t)a[i]);
+            out[a[i]] = '\0';
+            out += (a[i] + 8) & ~7ULL;
+        }
+    }
+    _tools_store_u64(&r->head, head + need);
+}
+
+// Returns once everything logged before the call has been written.
+static inline void qlog_flush(qol_log* lg) {
+    if (!_tools_load_int(&lg->running)) return;
+    unsigned long long req = _tools_add_u64(&lg->flush_req, 1);
+    while (_tools_load_u64(&lg->flush_done) < req && _tools_load_int(&lg->running)) _qlog_yield();
+}
+
+#if defined(__GNUC__)
+__attribute__((format(printf, 3, 4)))
+#endif
+static inline void _qlog_write(qol_log* lg, qol_log_site* s, const char* fmt, ...) {
+    if (_tools_load_int(&s->state) < 2) _qlog_parse(s);
+    _qlog_ring* r = _qlog_ring_for(lg);
+    if (r) {
+        va_list ap;
+        va_start(ap, fmt);
+        _qlog_push(lg, r, s, ap);
+        va_end(ap);
+    }
+    if (s->level >= QLOG_FATAL) qlog_flush(lg);
+}
+
+// One conversion that needs printf (flags, width, precision, floats, hex...).
+_TOOLS_COLD static void _qlog_snprintf(qol_sb* out, const char* spec, int stars, const int* star,
+                                       char t, unsigned long long v, const char* sv) {
+    size_t room = 64;
+    double d;
+    memcpy(&d, &v, 8);
+    for (;;) {
+        if (!sb_reserve(out, room)) return;
+        char* b = out->data + out->len;
+        int n = 0;
+#define _QLOG_SNP(x) (stars == 0 ? snprintf(b, room + 1, spec, x) : stars == 1 ? snprintf(b, room + 1, spec, star[0], x) \
+                                 : snprintf(b, room + 1, spec, star[0], star[1], x))
+        switch (t) {
+        case 'i': n = _QLOG_SNP((int)v); break;
+        case 'I': n = _QLOG_SNP((unsigned)v); break;
+        case 'l': n = _QLOG_SNP((long)v); break;
+        case 'L': n = _QLOG_SNP((unsigned long)v); break;
+        case 'q': n = _QLOG_SNP((long long)v); break;
+        case 'Q': n = _QLOG_SNP(v); break;
+        case 'z': n = _QLOG_SNP((size_t)v); break;
+        case 't': n = _QLOG_SNP((ptrdiff_t)v); break;
+        case 'j': n = _QLOG_SNP((intmax_t)v); break;
+        case 'J': n = _QLOG_SNP((uintmax_t)v); break;
+        case 'p': n = _QLOG_SNP((void*)(uintptr_t)v); break;
+        case 'd': n = _QLOG_SNP(d); break;
+        case 'D': n = _QLOG_SNP((long double)d); break;
+        case 's': n = _QLOG_SNP(sv); break;
+        }
+#undef _QLOG_SNP
+        if (n < 0) return;
+        if ((size_t)n <= room) { out->len += (size_t)n; return; }
+        room = (size_t)n;
+    }
+}
+
+// Replays the site's compiled format over the slots of one record.
+static inline void _qlog_format(qol_sb* out, const qol_log_site* s, const unsigned long long* slot) {
+    const char* str = (const char*)(slot + s->n_args);
+    const char* f = s->fmt;
+    char spec[32];
+    int i = 0;
+    for (int k = 0; k < s->n_ops; k++) {
+        const _qlog_op* op = &s->ops[k];
+        int star[2] = { 0, 0 };
+        if (!sb_reserve(out, (size_t)op->lit + FMT_INT_MAX)) return; // the text and any number fit
+        memcpy(out->data + out->len, f, op->lit);
+        out->len += op->lit;
+        f += op->lit + op->len;
+        if (op->kind == '%') { out->data[out->len++] = '%'; continue; }
+        for (int j = 0; j < op->stars; j++) star[j] = (int)slot[i++];
+        char t = s->types[i];
+        unsigned long long v = slot[i++];
+        switch (op->kind) {
+        case 'd': out->len += fmt_i64(out->data + out->len, t == 'z' ? (long long)(ptrdiff_t)(size_t)v : (long long)v); break;
+        case 'u': out->len += fmt_u64(out->data + out->len, v); break;
+        case 'c': out->data[out->len++] = (char)v; break;
+        case 's': sb_append_n(out, str, (size_t)v); break;
+        default:
+            memcpy(spec, f - op->len, op->len);
+            spec[op->len] = '\0';
+            _qlog_snprintf(out, spec, op->stars, star, t, v, str);
+        }
+        if (t == 's') str += (v + 8) & ~7ULL;
+    }
+    sb_append_n(out, f, (size_t)s->tail);
+}
+
+// "YYYY-MM-DD HH:MM:SS.mmm LEVEL message\n"
+static inline void _qlog_line(qol_log* lg, const _qlog_rec* h) {
+    static const char names[] = "TRACEDEBUGINFO WARN ERRORFATAL";
+    unsigned long long ns = lg->real_at + (unsigned long long)(long long)((double)(long long)(h->stamp - lg->cyc_at) * lg->ns_per_cyc);
+    time_t sec = (time_t)(ns / 1000000000ULL);
+    unsigned ms = (unsigned)(ns / 1000000ULL % 1000);
+    char pre[32];
+    if (sec != lg->tsec) { _time_format(sec, lg->ttext); lg->tsec = sec; }
+    memcpy(pre, lg->ttext, 19);
+    pre[19] = '.';
+    pre[20] = (char)('0' + ms / 100); pre[21] = (char)('0' + ms / 10 % 10); pre[22] = (char)('0' + ms % 10);
+    pre[23] = ' ';
+    memcpy(pre + 24, names + 5 * (h->site->level - 1), 5);
+    pre[29] = ' ';
+    sb_append_n(&lg->out, pre, 30);
+    const unsigned long long* slot = (const unsigned long long*)(const void*)((const char*)h + _QLOG_REC_SIZE);
+    if (h->site->state == 3) sb_append_n(&lg->out, (const char*)(slot + 1), (size_t)slot[0]);
+    else _qlog_format(&lg->out, h->site, slot);
+    sb_appendc(&lg->out, '\n');
+}
+
+static inline void _qlog_output(qol_log* lg) {
+    const char* p = lg->out.data;
+    size_t n = lg->out.len;
+    while (n) {
+#ifdef _WIN32
+        int w = _write(lg->fd, p, n > (1u << 30) ? (1u << 30) : (unsigned)n);
+#else
+        ssize_t w = write(lg->fd, p, n);
+#endif
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) break; // a failing output loses the batch rather than stalling every thread
+        p += w; n -= (size_t)w;
+    }
+    lg->out.len = 0;
+}
+
+// Skips a wrap marker; returns the next record or NULL if the ring is drained.
+static inline const _qlog_rec* _qlog_peek(_qlog_ring* r) {
+    if (r->tail == r->end) return NULL;
+    size_t idx = (size_t)(r->tail & (QLOG_RING - 1));
+    if (*(const unsigned*)(const void*)(_QLOG_DATA(r) + idx) == _QLOG_WRAP) {
+        _tools_store_u64(&r->tail, r->tail + (QLOG_RING - idx));
+        if (r->tail == r->end) return NULL;
+        idx = 0;
+    }
+    return (const _qlog_rec*)(const void*)(_QLOG_DATA(r) + idx);
+}
+
+// Records carry time_cycles(). The rate is measured against the monotonic clock
+// over the logger's whole life (so clock steps do not skew it), and each pass
+// anchors it to the current wall-clock time.
+static inline void _qlog_calibrate(qol_log* lg) {
+    unsigned long long cyc = time_cycles(), mono = time_mono_ns();
+    if (cyc != lg->cyc0) lg->ns_per_cyc = (double)(mono - lg->mono0) / (double)(cyc - lg->cyc0);
+    lg->cyc_at = cyc;
+    lg->real_at = _qlog_clock_ns();
+}
+
+// Formats what every ring holds right now, oldest record first across rings.
+static inline size_t _qlog_drain(qol_log* lg) {
+    size_t count = 0;
+    int orphans = 0;
+    _qlog_calibrate(lg);
+    _tools_lock(&lg->lock);
+    _qlog_ring* first = lg->rings; // rings are only added at the front, so the rest of the list is stable
+    _tools_unlock(&lg->lock);
+    for (_qlog_ring* r = first; r; r = r->next) {
+        unsigned long long dropped = _tools_load_u64(&r->dropped);
+        if (dropped != r->reported) {
+            static qol_log_site site = { "qlog: %llu messages dropped (ring full)", QLOG_WARN, 0, 0, 0, 0, { 0 }, { 0 }, { { 0, 0, 0, 0 } } };
+            unsigned long long rec[(sizeof(_qlog_rec) + 7) / 8 + 1];
+            _qlog_rec* h = (_qlog_rec*)(void*)rec;
+            if (site.state < 2) _qlog_parse(&site);
+            h->site = &site; h->stamp = time_cycles();
+            rec[_QLOG_REC_SIZE / 8] = dropped - r->reported;
+            _qlog_line(lg, h);
+            _tools_store_u64(&lg->dropped, lg->dropped + (dropped - r->reported));
+            r->reported = dropped;
+        }
+        if (_tools_load_int(&r->orphaned)) orphans = 1; // before reading head: an orphan's head is final
+        r->end = _tools_load_u64(&r->head);
+    }
+    for (;;) {
+        _qlog_ring* best = NULL;
+        const _qlog_rec* bh = NULL;
+        for (_qlog_ring* r = first; r; r = r->next) {
+            const _qlog_rec* h = _qlog_peek(r);
+            if (h && (!bh || h->stamp < bh->stamp)) { best = r; bh = h; }
+        }
+        if (!best) break;
+        _qlog_line(lg, bh);
+        _tools_store_u64(&best->tail, best->tail + bh->size);
+        count++;
+        if (lg->out.len >= QLOG_BATCH) _qlog_output(lg);
+    }
+    if (orphans) {
+        _tools_lock(&lg->lock);
+        for (_qlog_ring** pp = &lg->rings; *pp; ) {
+            _qlog_ring* r = *pp;
+            if (_tools_load_int(&r->orphaned) && r->tail == _tools_load_u64(&r->head)) { *pp = r->next; _qlog_release(r); }
+            else pp = &r->next;
+        }
+        _tools_unlock(&lg->lock);
+    }
+    return count;
+}
+
+static inline void _qlog_loop(qol_log* lg) {
+    unsigned idle = 0;
+    _qlog_sleep_us(1000); // a millisecond of counter before the first rate estimate
+    for (;;) {
+        int stopping = !_tools_load_int(&lg->running);
+        unsigned long long req = _tools_load_u64(&lg->flush_req);
+        size_t n = _qlog_drain(lg);
+        if (lg->out.len) _qlog_output(lg);
+        _tools_store_u64(&lg->flush_done, req);
+        if (stopping) return;
+        if (n) idle = 0;
+        else if (++idle < 16) _qlog_yield();
+        else _qlog_sleep_us(QLOG_IDLE_US);
+    }
+}
+
+#ifdef _WIN32
+static inline DWORD WINAPI _qlog_thread(LPVOID lg) { _qlog_loop((qol_log*)lg); return 0; }
+#else
+static inline void* _qlog_thread(void* lg) { _qlog_loop((qol_log*)lg); return NULL; }
+#endif
+
+// Starts the writer thread; lines go to fd (1 for stdout, or an open file).
+// Returns 0 if the thread could not be created.
+static inline int qlog_start(qol_log* lg, int fd, int level) {
+    memset(lg, 0, sizeof(*lg));
+    lg->fd = fd; lg->level = level; lg->block = 1; lg->running = 1;
+    lg->tsec = (time_t)-1;
+    lg->cyc0 = time_cycles(); lg->mono0 = time_mono_ns();
+    _tools_mutex_init(&lg->lock);
+#ifdef _WIN32
+    lg->thread = CreateThread(NULL, 0, _qlog_thread, lg, 0, NULL);
+    if (lg->thread) return 1;
+#else
+    if (pthread_create(&lg->thread, NULL, _qlog_thread, lg) == 0) return 1;
+#endif
+    _tools_mutex_destroy(&lg->lock);
+    lg->running = 0; lg->level = QLOG_OFF;
+    return 0;
+}
+
+// Writes everything still queued and joins the writer. Call it once the other
+// threads have stopped logging; later calls on lg are ignored.
+static inline void qlog_stop(qol_log* lg) {
+    if (!_tools_load_int(&lg->running)) return;
+    _tools_store_int(&lg->level, QLOG_OFF);
+    _tools_lock(&lg->lock);
+    _tools_store_int(&lg->running, 0);
+    _tools_unlock(&lg->lock);
+#ifdef _WIN32
+    WaitForSingleObject(lg->thread, INFINITE);
+    CloseHandle(lg->thread);
+#else
+    pthread_join(lg->thread, NULL);
+#endif
+    _tools_lock(&lg->lock);
+    _qlog_ring* next;
+    for (_qlog_ring* r = lg->rings; r; r = next) {
+        next = r->next;
+        _tools_store_int(&r->detached, 1);
+        _qlog_release(r);
+    }
+    lg->rings = NULL;
+    _tools_unlock(&lg->lock);
+    _tools_mutex_destroy(&lg->lock);
+    sb_free(&lg->out);
+}
+
+static inline void qlog_set_level(qol_log* lg, int level) { _tools_store_int(&lg->level, level); }
+
+// 1: a thread whose ring is full waits for the writer (nothing is lost).
+// 0: the message is dropped and counted, and the writer reports the count.
+//    FATAL messages still wait.
+static inline void qlog_set_blocking(qol_log* lg, int block) { _tools_store_int(&lg->block, block); }
+
+// Messages dropped so far, as reported by the writer.
+static inline unsigned long long qlog_dropped(qol_log* lg) { return _tools_load_u64(&lg->dropped); }
+
+#define _QLOG_FMT(f, ...) "" f
+
+// lvl must be a constant. The format is checked like printf's by GCC and Clang.
+#define QLOG(lg, lvl, ...) do { \
+    static qol_log_site _qlog_site = { _QLOG_FMT(__VA_ARGS__, 0), lvl, 0, 0, 0, 0, { 0 }, { 0 }, { { 0, 0, 0, 0 } } }; \
+    if ((lvl) >= _tools_load_int(&(lg)->level)) _qlog_write((lg), &_qlog_site, __VA_ARGS__); \
+} while (0)
+
+#if QLOG_MIN_LEVEL <= QLOG_TRACE
+#define qlog_trace(lg, ...) QLOG(lg, QLOG_TRACE, __VA_ARGS__)
+#else
+#define qlog_trace(lg, ...) ((void)0)
+#endif
+#if QLOG_MIN_LEVEL <= QLOG_DEBUG
+#define qlog_debug(lg, ...) QLOG(lg, QLOG_DEBUG, __VA_ARGS__)
+#else
+#define qlog_debug(lg, ...) ((void)0)
+#endif
+#if QLOG_MIN_LEVEL <= QLOG_INFO
+#define qlog_info(lg, ...) QLOG(lg, QLOG_INFO, __VA_ARGS__)
+#else
+#define qlog_info(lg, ...) ((void)0)
+#endif
+#if QLOG_MIN_LEVEL <= QLOG_WARN
+#define qlog_warn(lg, ...) QLOG(lg, QLOG_WARN, __VA_ARGS__)
+#else
+#define qlog_warn(lg, ...) ((void)0)
+#endif
+#if QLOG_MIN_LEVEL <= QLOG_ERROR
+#define qlog_error(lg, ...) QLOG(lg, QLOG_ERROR, __VA_ARGS__)
+#else
+#define qlog_error(lg, ...) ((void)0)
+#endif
+// Also waits for the line to be written, so it is not lost if the process dies next.
+#define qlog_fatal(lg, ...) QLOG(lg, QLOG_FATAL, __VA_ARGS__)
+
 #endif
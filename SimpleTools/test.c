@@ -0,0 +1,206 @@
+#include "simple_tools.h"
+
+int main() {
+    printf("================================\n");
+    printf("      SIMPLE_TOOLS TESTS        \n");
+    printf("================================\n\n");
+
+    printf("--- STRING REPLACE CHECK ---\n");
+    const char* src = "one two one two one";
+    char* s;
+    s = str_replace_first(src, "one", "1");      printf("first:  %s\n", s); free(s);
+    s = str_replace_all(src, "one", "1");        printf("all:    %s\n", s); free(s);
+    s = str_replace_nth(src, "one", "1", 2);     printf("nth(2): %s\n", s); free(s);
+    s = str_replace_range(src, "one", "1", 2, 3); printf("2..3:   %s\n", s); free(s);
+
+    // Expansion well past 10x used to overflow the old fixed-ratio buffer.
+    s = str_replace_all("a.b.c", ".", "<---------------------->");
+    printf("expand: %s\n", s); free(s);
+
+    char small[8], big[64];
+    size_t need = str_replace_all_buf(small, sizeof(small), src, "two", "2");
+    printf("buf too small: need %zu, got \"%s\"\n", need, small);
+    str_replace_all_buf(big, sizeof(big), src, "two", "2");
+    printf("buf: %s\n", big);
+
+    qol_sb sb = {0};
+    sb_append_n(&sb, "path=", 5);
+    sb_replace_all(&sb, "a%20b%20c", "%20", " ");
+    printf("builder: %s (len %zu)\n\n", sb.data, sb.len);
+    sb_free(&sb);
+
+    printf("--- MULTI REPLACE CHECK ---\n");
+    qol_repl rules[] = { {"<", "&lt;"}, {">", "&gt;"}, {"&", "&amp;"}, {"he", "HE"}, {"hello", "HI"} };
+    s = str_replace_many("<b>hello & help</b>", rules, 5);
+    printf("many:   %s\n", s); free(s); // longest match wins: "hello" over "he"
+
+    qol_ac* ac = ac_build(rules, 5);
+    for (int i = 0; i < 2; i++) {
+        s = ac_replace(ac, i ? "x<y" : "a>b");
+        printf("cached: %s\n", s); free(s);
+    }
+    ac_free(ac);
+    printf("\n");
+
+    printf("--- STRING BUILDER CHECK ---\n");
+    qol_sb b = {0};
+    for (int i = 0; i < 3; i++) sb_appendf(&b, "%s%d", i ? "," : "", i * 10);
+    sb_appendc(&b, ';');
+    printf("sb:     %s (len %zu)\n", b.data, b.len);
+    sb_reset(&b);
+    sb_appendf(&b, "%0300d", 7); // longer than the current capacity: grows, then formats once more
+    printf("long:   len %zu, last '%c'\n", b.len, b.data[b.len - 1]);
+    sb_free(&b);
+
+    s = str_format("User ID: %d", 101);  printf("format: %s\n", s); free(s);
+    s = json_obj("s:name, i:age, b:active", "Ted", 21, 1); printf("json:   %s\n\n", s); free(s);
+
+    printf("--- JSON WRITER CHECK ---\n");
+    char out[256];
+    qol_jw jw;
+    jw_init(&jw, out, sizeof(out));
+    jw_begin_obj(&jw);
+    jw_key(&jw, "user"); jw_str(&jw, "Ted \"T\"\n");
+    jw_key(&jw, "ratio"); jw_double(&jw, 0.1);
+    jw_key(&jw, "tags"); jw_begin_arr(&jw); jw_str(&jw, "a"); jw_int(&jw, -3); jw_null(&jw); jw_end_arr(&jw);
+    jw_end_obj(&jw);
+    size_t jlen = jw_finish(&jw);
+    printf("jw:     %s (len %zu)\n", out, jlen);
+
+    jw_init(&jw, out, 8);
+    jw_begin_arr(&jw); jw_str(&jw, "too long for 8 bytes"); jw_end_arr(&jw);
+    jlen = jw_finish(&jw);
+    printf("small:  need %zu, got \"%s\"\n", jlen, out);
+
+    jw_init(&jw, out, sizeof(out));
+    jw_begin_obj(&jw); jw_int(&jw, 1); // value without a key
+    printf("misuse: %zu\n\n", jw_finish(&jw));
+
+    printf("--- ASCII CHECK ---\n");
+    char text[] = "  Content-Type: TEXT/html; charset=\xc3\x89  \t";
+    char* t = str_trim(text);
+    printf("trim:   [%s]\n", t);
+    str_lower(t); printf("lower:  [%s]\n", t); // the UTF-8 bytes are left alone
+    str_upper(t); printf("upper:  [%s]\n", t);
+    printf("numeric: %d %d %d\n", str_is_numeric("0123456789012345678901234567890123"), str_is_numeric("12a"), str_is_numeric(""));
+    char field[] = "  42  |rest";
+    size_t flen = 6;
+    char* f = str_trim_n(field, &flen);
+    printf("trim_n: [%.*s] numeric %d (simd level %d)\n\n", (int)flen, f, str_is_numeric_n(f, flen), tools_simd_level());
+
+    printf("--- HEXDUMP CHECK ---\n");
+    const char pkt[] = "GET /index.html HTTP/1.1\r\nHost: x\r\n";
+    hexdmp((void*)pkt, (int)sizeof(pkt) - 1);
+    qol_hex_opts hopt = {0};
+    hopt.width = 8; hopt.no_ascii = 1; hopt.base = 0x400;
+    hexdump_file(stdout, pkt, 12, &hopt);
+    qol_sb dump = {0};
+    sb_hexdump(&dump, "\x00\x01 ok", 5, NULL);
+    printf("sb:     %s\n", dump.data);
+    sb_free(&dump);
+
+    printf("--- URL CHECK ---\n");
+    const char* plain = "caf\xc3\xa9 & cr\xc3\xa8me/1";
+    char enc[128];
+    url_encode_n(enc, sizeof(enc), plain, strlen(plain), 0);
+    printf("encode: %s\n", enc);
+    s = str_url_decode(enc);
+    printf("decode: %s\n", s);
+    free(s);
+    char query[] = "?user=t%C3%A9d&q=a+b%26c&flag&page=2#top";
+    qol_url_pair qp[8];
+    int qn = url_query_parse(query, qp, 8);
+    for (int i = 0; i < qn; i++) printf("param:  %s = \"%s\"\n", qp[i].key, qp[i].val);
+    printf("\n");
+
+    printf("--- TIME CHECK ---\n");
+    char stamp[TIME_NOW_LEN];
+    printf("now:    %s / %s\n", time_now_r(stamp), time_now());
+    unsigned long long t0 = time_mono_ns(), c0 = time_cycles();
+    while (time_mono_ns() - t0 < 20000000ULL) {}
+    printf("spin:   ~%llu ms, %llu cycles\n\n", (time_mono_ns() - t0) / 1000000ULL, time_cycles() - c0);
+
+    printf("--- INTERN CHECK ---\n");
+    qol_intern pool;
+    intern_init(&pool);
+    char hdr[] = "Content-Type";
+    const char* a1 = intern(&pool, "Content-Type");
+    const char* a2 = intern_n(&pool, hdr, strlen(hdr));
+    printf("same ptr: %s, atom %u, len %zu\n", a1 == a2 ? "yes" : "no", intern_atom_of(a1), intern_len(a1));
+    printf("atom 1:   %s\n", intern_str(&pool, 1));
+    printf("find:     %s / %s\n", intern_find(&pool, "Content-Type") ? "hit" : "miss", intern_find(&pool, "X-Unknown") ? "hit" : "miss");
+    intern_free(&pool);
+    printf("\n");
+
+    printf("--- VIEW CHECK ---\n");
+    const char* req = "Host:  example.com \r\nAccept: */*\r\nX-Id: 42\r\n";
+    qol_sv rest = sv_from(req), line, key, val;
+    while (sv_split_next(&rest, SV("\r\n"), &line)) {
+        if (sv_cut(line, SV(":"), &key, &val)) printf("[" SV_FMT "] = [" SV_FMT "]\n", SV_ARG(key), SV_ARG(sv_trim(val)));
+    }
+    printf("count \\r\\n: %zu, find X-Id at %zu, ends with \\r\\n: %d\n\n",
+        sv_count(sv_from(req), SV("\r\n")), sv_find(sv_from(req), SV("X-Id")), sv_ends(sv_from(req), SV("\r\n")));
+
+    printf("--- NUMBER CHECK ---\n");
+    char num[FMT_DOUBLE_MAX];
+    fmt_i64(num, -9223372036854775807LL - 1); printf("fmt_i64:      %s\n", num);
+    fmt_u64(num, 18446744073709551615ULL);   printf("fmt_u64:      %s\n", num);
+    const double reals[] = { 0.1, 1.0 / 3, 1234.5, 1e21, 5e-324, -0.0 };
+    for (int i = 0; i < 6; i++) { fmt_double(num, reals[i]); printf("fmt_double:   %s\n", num); }
+    unsigned long long uv = 0; double dv = 0;
+    size_t used = parse_u64("8080/path", 9, &uv);
+    printf("parse_u64:    %llu (%zu bytes)\n", uv, used);
+    used = parse_u64("000000000000000000000018446744073709551615", 42, &uv);
+    printf("zero-padded:  %llu (%zu bytes)\n", uv, used);
+    used = parse_double("-2.5e-3,next", 12, &dv);
+    printf("parse_double: %g (%zu bytes)\n\n", dv, used);
+
+    printf("--- CODEC CHECK ---\n");
+    char b64[64];
+    unsigned char raw[48];
+    b64_encode(b64, "hello?>", 7, 0); printf("b64:          %s\n", b64);
+    b64_encode(b64, "hello?>", 7, 1); printf("b64url:       %s\n", b64);
+    size_t got = b64_decode(raw, "aGVsbG8_Pg", 10, 1);
+    printf("b64 decode:   %.*s (%zu bytes)\n", (int)got, (char*)raw, got);
+    printf("bad input:    %s\n", b64_decode(raw, "aGV*", 4, 0) == CODEC_ERROR ? "CODEC_ERROR" : "accepted");
+    qol_b64_stream bst;
+    b64_stream_init(&bst, 0);
+    size_t bn = b64_encode_update(&bst, b64, "stre", 4);
+    bn += b64_encode_update(&bst, b64 + bn, "amed", 4);
+    b64_encode_final(&bst, b64 + bn);
+    printf("streamed:     %s\n", b64);
+    hex_encode(b64, "\x01\xAB\xff", 3); printf("hex:          %s\n", b64);
+    got = hex_decode(raw, "DEADbeef", 8);
+    printf("hex decode:   %zu bytes, %02x%02x%02x%02x\n\n", got, raw[0], raw[1], raw[2], raw[3]);
+
+    printf("--- RANDOM CHECK ---\n");
+    qol_rng rg;
+    rng_seed(&rg, 42);
+    printf("rng_next:     %016llx\n", rng_next(&rg));
+    printf("rng_range:    %lld (1..6)\n", rng_range(&rg, 1, 6));
+    printf("rng_double:   %.6f\n", rng_double(&rg));
+    qol_pcg32 pcg;
+    pcg32_seed(&pcg, 42, 54);
+    printf("pcg32:        %08x (reference a15c02b7)\n", pcg32_next(&pcg));
+    pcg32_advance(&pcg, (unsigned long long)-1);
+    printf("pcg32 rewind: %08x\n", pcg32_next(&pcg));
+    qol_rng8 g8;
+    double dv8[10];
+    rng8_seed(&g8, 42);
+    rng8_fill_double(&g8, dv8, 10);
+    printf("rng8 doubles: %.4f %.4f ... %.4f\n\n", dv8[0], dv8[1], dv8[9]);
+
+    printf("--- LOGGER CHECK ---\n");
+    fflush(stdout); // the logger writes to fd 1 directly
+    qol_log lg;
+    qlog_start(&lg, 1, QLOG_INFO);
+    qlog_info(&lg, "user %s logged in from %s (attempt %d)", "ted", "10.0.0.7", 2);
+    qlog_warn(&lg, "disk %.1f%% full", 91.5);
+    qlog_debug(&lg, "not shown: below the runtime level");
+    qlog_set_level(&lg, QLOG_DEBUG);
+    qlog_debug(&lg, "shown after qlog_set_level");
+    qlog_stop(&lg);
+    printf("\n");
+
+    return 0;
+}
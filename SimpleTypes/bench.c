@@ -0,0 +1,498 @@
+#include "simple_types.h"
+#include <time.h>
+
+// Build: gcc -O2 bench.c -o bench            (single thread)
+//        gcc -O2 -DSBIG_THREADS bench.c -o bench -lpthread
+
+static double now_ms() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static u32 rng_state = 0x9E3779B9;
+static u32 rng() { rng_state ^= rng_state << 13; rng_state ^= rng_state >> 17; rng_state ^= rng_state << 5; return rng_state; }
+
+// Runs fn until at least 50ms have passed and returns ms per call.
+#define TIME_MS(result, stmt) { \
+    int _reps = 0; double _t0 = now_ms(), _t1; \
+    do { stmt; _reps++; _t1 = now_ms(); } while (_t1 - _t0 < 50.0); \
+    result = (_t1 - _t0) / _reps; \
+}
+
+static void bench_mul_crossover() {
+    printf("[Multiplication crossover: n x n limbs, ms per product]\n");
+    printf("%8s %12s %12s %12s   %s\n", "limbs", "schoolbook", "karatsuba", "ntt", "fastest");
+    int sizes[] = { 16, 32, 48, 64, 96, 128, 256, 384, 512, 768, 1024, 1536, 2048, 4096, 8192, 16384, 65536 };
+    for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+        int n = sizes[s];
+        u32* a = (u32*)malloc(n * sizeof(u32));
+        u32* b = (u32*)malloc(n * sizeof(u32));
+        u32* out = (u32*)malloc(2 * n * sizeof(u32));
+        u32* scratch = (u32*)malloc(_SBIG_KARA_SCRATCH(n) * sizeof(u32));
+        for (int i = 0; i < n; i++) { a[i] = rng(); b[i] = rng(); }
+
+        double t_school = -1, t_kara, t_ntt;
+        if (n <= 8192) TIME_MS(t_school, { memset(out, 0, 2 * n * sizeof(u32)); _sbig_mul_raw(out, a, n, b, n); });
+        TIME_MS(t_kara, _sbig_mul_karatsuba(out, a, b, n, scratch));
+        TIME_MS(t_ntt, _sbig_mul_ntt(out, a, n, b, n, &sbig_heap));
+
+        const char* best = t_kara < t_ntt ? "karatsuba" : "ntt";
+        if (t_school >= 0 && t_school < t_kara && t_school < t_ntt) best = "schoolbook";
+        if (t_school >= 0) printf("%8d %12.4f %12.4f %12.4f   %s\n", n, t_school, t_kara, t_ntt, best);
+        else printf("%8d %12s %12.4f %12.4f   %s\n", n, "-", t_kara, t_ntt, best);
+        free(a); free(b); free(out); free(scratch);
+    }
+    printf("Cutoffs in use: SBIG_KARATSUBA_CUTOFF=%d SBIG_NTT_CUTOFF=%d\n\n", SBIG_KARATSUBA_CUTOFF, SBIG_NTT_CUTOFF);
+}
+
+static void bench_mul_full() {
+    static suint8192 a8, b8;
+    static suint12288 a12, b12;
+    for (int i = 0; i < 256; i++) { a8.limbs[i] = rng(); b8.limbs[i] = rng(); }
+    for (int i = 0; i < 384; i++) { a12.limbs[i] = rng(); b12.limbs[i] = rng(); }
+    sbig res; sbig_init(&res, NULL);
+    double t8, t12;
+    TIME_MS(t8, suint8192_mul_full(&res, a8, b8));
+    TIME_MS(t12, suint12288_mul_full(&res, a12, b12));
+    printf("[Widening products]\n");
+    printf("suint8192  x suint8192  -> 16384 bits: %.4f ms\n", t8);
+    printf("suint12288 x suint12288 -> 24576 bits: %.4f ms\n\n", t12);
+    sbig_free(&res);
+}
+
+// Looping the by-value scalar function over an AoS array vs. the SoA batch kernels.
+#define BENCH_BATCH(BITS, COUNT, N) { \
+    size_t n = N; \
+    suint##BITS* xa = (suint##BITS*)malloc(n * sizeof(suint##BITS)); \
+    suint##BITS* xb = (suint##BITS*)malloc(n * sizeof(suint##BITS)); \
+    suint##BITS* xo = (suint##BITS*)malloc(n * sizeof(suint##BITS)); \
+    int* cmp = (int*)malloc(n * sizeof(int)); \
+    suint##BITS##_soa sa, sb, so; \
+    suint##BITS##_soa_alloc(&sa, n); suint##BITS##_soa_alloc(&sb, n); suint##BITS##_soa_alloc(&so, n); \
+    for (size_t i = 0; i < n; i++) { \
+        for (int k = 0; k < COUNT; k++) { xa[i].limbs[k] = rng(); xb[i].limbs[k] = rng(); } \
+        suint##BITS##_soa_set(&sa, i, xa[i]); suint##BITS##_soa_set(&sb, i, xb[i]); \
+    } \
+    double t_add, t_cmp, t_mul, t; \
+    TIME_MS(t_add, for (size_t i = 0; i < n; i++) suint##BITS##_add(&xo[i], xa[i], xb[i])); \
+    TIME_MS(t_cmp, for (size_t i = 0; i < n; i++) cmp[i] = suint##BITS##_cmp(xa[i], xb[i])); \
+    TIME_MS(t_mul, for (size_t i = 0; i < n; i++) suint##BITS##_mul(&xo[i], xa[i], xb[i])); \
+    printf("suint" #BITS " x %zu: scalar loop add %.1f / cmp %.1f / mul %.1f Melem/s\n", n, n / t_add / 1e3, n / t_cmp / 1e3, n / t_mul / 1e3); \
+    const char* names[] = { "scalar", "avx2", "avx512" }; \
+    int hw = types_simd_level(); \
+    for (int lvl = 0; lvl <= hw; lvl++) { \
+        types_simd_limit(lvl); \
+        TIME_MS(t, suint##BITS##_add_many(&so, &sa, &sb, n)); \
+        printf("  %-7s add_many %8.1f Melem/s (%.2fx)", names[lvl], n / t / 1e3, t_add / t); \
+        TIME_MS(t, suint##BITS##_cmp_many(cmp, &sa, &sb, n)); \
+        printf("  cmp_many %8.1f (%.2fx)", n / t / 1e3, t_cmp / t); \
+        TIME_MS(t, suint##BITS##_mul_many(&so, &sa, &sb, n)); \
+        printf("  mul_many %8.1f (%.2fx)\n", n / t / 1e3, t_mul / t); \
+    } \
+    types_simd_limit(hw); \
+    free(xa); free(xb); free(xo); free(cmp); \
+    suint##BITS##_soa_free(&sa); suint##BITS##_soa_free(&sb); suint##BITS##_soa_free(&so); \
+}
+
+static void bench_batch() {
+    printf("[Batch kernels vs. looping the scalar function]\n");
+    BENCH_BATCH(256, 8, 1 << 18)
+    BENCH_BATCH(512, 16, 1 << 17)
+    printf("\n");
+}
+
+// Summation of ill-conditioned data: large terms that cancel plus small ones.
+// Reference is an sfloat2048 accumulator, wide enough to be exact here.
+static void bench_float_accuracy() {
+    int n = 100000;
+    double* xs = (double*)malloc(n * sizeof(double));
+    for (int i = 0; i < n; i += 2) {
+        double big = (double)rng() * (double)(1u << 20), small = (double)rng() / 4294967296.0;
+        xs[i] = big + small;
+        xs[i + 1] = -big + small * 1e-9;
+    }
+    double d = 0, kahan = 0, comp = 0;
+    long double ld = 0;
+    sfloat128 f128 = {0};
+    sfloat256 f256 = {0};
+    static sfloat2048 ref;
+    memset(&ref, 0, sizeof(ref));
+    for (int i = 0; i < n; i++) {
+        d += xs[i];
+        double y = xs[i] - comp, t = kahan + y; comp = (t - kahan) - y; kahan = t;
+        ld += xs[i];
+        sfloat128_add(&f128, f128, sfloat128_from_double(xs[i]));
+        sfloat256_add(&f256, f256, sfloat256_from_double(xs[i]));
+        sfloat2048_add(&ref, ref, sfloat2048_from_double(xs[i]));
+    }
+    long double exact = sfloat2048_to_ldouble(ref);
+    #define REL(x) (double)(((long double)(x) - exact) / exact)
+    printf("[Float accuracy: sum of %d cancelling terms, relative error]\n", n);
+    printf("double       %+.3e\n", REL(d));
+    printf("double kahan %+.3e\n", REL(kahan));
+    printf("long double  %+.3e\n", REL(ld));
+    printf("sfloat128    %+.3e\n", REL(sfloat128_to_ldouble(f128)));
+    printf("sfloat256    %+.3e\n", REL(sfloat256_to_ldouble(f256)));
+    #undef REL
+
+    // Division and square root are correctly rounded: check x/y*y and sqrt(x)^2 residuals.
+    sfloat256 x = sfloat256_from_double(2.0), y = sfloat256_from_double(3.0), q, back, diff;
+    sfloat256_div(&q, x, y); sfloat256_mul(&back, q, y); sfloat256_sub(&diff, back, x);
+    printf("sfloat256 2/3*3 - 2      = %.3e\n", sfloat256_to_double(diff));
+    sfloat256_sqrt(&q, x); sfloat256_mul(&back, q, q); sfloat256_sub(&diff, back, x);
+    printf("sfloat256 sqrt(2)^2 - 2  = %.3e\n\n", sfloat256_to_double(diff));
+    free(xs);
+}
+
+#define BENCH_FLOAT(BITS) { \
+    sfloat##BITS a = sfloat##BITS##_from_double(1.2345678901234567), b = sfloat##BITS##_from_double(-7.654321e-3), r; \
+    sfloat##BITS##_div(&a, a, sfloat##BITS##_from_double(3.0)); \
+    int reps = 10000; double t_add, t_mul, t_div, t_sqrt, t_conv; volatile double sink = 0; \
+    TIME_MS(t_add, for (int i = 0; i < reps; i++) sfloat##BITS##_add(&r, a, b)); \
+    TIME_MS(t_mul, for (int i = 0; i < reps; i++) sfloat##BITS##_mul(&r, a, b)); \
+    TIME_MS(t_div, for (int i = 0; i < reps / 10; i++) sfloat##BITS##_div(&r, a, b)); \
+    TIME_MS(t_sqrt, for (int i = 0; i < reps / 10; i++) sfloat##BITS##_sqrt(&r, a)); \
+    TIME_MS(t_conv, for (int i = 0; i < reps; i++) sink += sfloat##BITS##_to_double(sfloat##BITS##_from_double(i))); \
+    printf("sfloat%-4d add %7.1f  mul %7.1f  div %8.1f  sqrt %8.1f  from+to double %7.1f\n", BITS, \
+        t_add * 1e6 / reps, t_mul * 1e6 / reps, t_div * 1e7 / reps, t_sqrt * 1e7 / reps, t_conv * 1e6 / reps); \
+    (void)sink; \
+}
+
+static void bench_float_throughput() {
+    printf("[Float throughput, ns per op]\n");
+    BENCH_FLOAT(128)
+    BENCH_FLOAT(256)
+    BENCH_FLOAT(1024)
+    printf("\n");
+}
+
+// Naive Euclid on the bit-serial suintN_mod vs. binary and Lehmer GCD.
+#define DEF_NAIVE_GCD(BITS) \
+    static void naive_gcd##BITS(suint##BITS *res, suint##BITS x, suint##BITS y) { \
+        suint##BITS t, zero = {0}; \
+        while (suint##BITS##_cmp(y, zero) != 0) { suint##BITS##_mod(&t, x, y); x = y; y = t; } \
+        *res = x; \
+    }
+DEF_NAIVE_GCD(256) DEF_NAIVE_GCD(1024) DEF_NAIVE_GCD(2048) DEF_NAIVE_GCD(4096)
+
+#define BENCH_GCD(BITS, COUNT) { \
+    suint##BITS a, b, g; \
+    for (int k = 0; k < COUNT; k++) { a.limbs[k] = rng(); b.limbs[k] = rng(); } \
+    b.limbs[0] |= 1; \
+    double t_naive, t_bin, t_lehmer, t_inv; \
+    TIME_MS(t_naive, naive_gcd##BITS(&g, a, b)); \
+    TIME_MS(t_bin, suint##BITS##_gcd_binary(&g, a, b)); \
+    TIME_MS(t_lehmer, suint##BITS##_gcd(&g, a, b)); \
+    TIME_MS(t_inv, suint##BITS##_modinv(&g, a, b)); \
+    printf("suint%-5d %10.1f %10.1f (%5.0fx) %10.1f (%5.0fx) %10.1f\n", BITS, t_naive * 1e3, \
+        t_bin * 1e3, t_naive / t_bin, t_lehmer * 1e3, t_naive / t_lehmer, t_inv * 1e3); \
+}
+
+static void bench_gcd() {
+    printf("[GCD, us per call]\n");
+    printf("%-10s %10s %18s %18s %10s\n", "width", "euclid/mod", "binary", "lehmer", "modinv");
+    BENCH_GCD(256, 8)
+    BENCH_GCD(1024, 32)
+    BENCH_GCD(2048, 64)
+    BENCH_GCD(4096, 128)
+    printf("\n");
+}
+
+// Separate chaining, as a map is usually written by hand: a node per entry,
+// doubling the bucket array at load 1. Uses the same hash functions as DEF_MAP.
+typedef struct chain_node { struct chain_node* next; u64 hash; const void* key; u64 val; } chain_node;
+typedef struct { chain_node** buckets; size_t nb, len; } chain_map;
+
+static void chain_put(chain_map* m, const void* key, u64 h, u64 val, int (*eq)(const void*, const void*)) {
+    if (m->len >= m->nb) {
+        size_t nb = m->nb ? m->nb * 2 : 16;
+        chain_node** b = (chain_node**)calloc(nb, sizeof(chain_node*));
+        for (size_t i = 0; i < m->nb; i++)
+            for (chain_node *n = m->buckets[i], *next; n; n = next) { next = n->next; n->next = b[n->hash & (nb - 1)]; b[n->hash & (nb - 1)] = n; }
+        free(m->buckets);
+        m->buckets = b; m->nb = nb;
+    }
+    for (chain_node* n = m->buckets[h & (m->nb - 1)]; n; n = n->next)
+        if (n->hash == h && eq(n->key, key)) { n->val = val; return; }
+    chain_node* n = (chain_node*)malloc(sizeof(chain_node));
+    n->hash = h; n->key = key; n->val = val;
+    n->next = m->buckets[h & (m->nb - 1)];
+    m->buckets[h & (m->nb - 1)] = n;
+    m->len++;
+}
+
+static u64* chain_get(const chain_map* m, const void* key, u64 h, int (*eq)(const void*, const void*)) {
+    if (!m->nb) return NULL;
+    for (chain_node* n = m->buckets[h & (m->nb - 1)]; n; n = n->next)
+        if (n->hash == h && eq(n->key, key)) return &n->val;
+    return NULL;
+}
+
+static void chain_free(chain_map* m) {
+    for (size_t i = 0; i < m->nb; i++)
+        for (chain_node *n = m->buckets[i], *next; n; n = next) { next = n->next; free(n); }
+    free(m->buckets);
+    memset(m, 0, sizeof(*m));
+}
+
+static int chain_eq_u64(const void* a, const void* b) { return (u64)(uintptr_t)a == (u64)(uintptr_t)b; }
+static int chain_eq_str(const void* a, const void* b) { return strcmp((const char*)a, (const char*)b) == 0; }
+
+DEF_MAP_U64(bench_umap, u64)
+DEF_MAP_STR(bench_smap, u64)
+
+// ns per operation: inserts into an empty map (growing as it goes), hits, and misses.
+static void bench_map() {
+    enum { N = 1 << 20, NS = 1 << 18 };
+    u64* keys = (u64*)malloc(N * sizeof(u64));
+    u64* miss = (u64*)malloc(N * sizeof(u64));
+    for (int i = 0; i < N; i++) { keys[i] = (u64)rng() << 32 | rng(); miss[i] = (u64)rng() << 32 | rng(); }
+    char (*skeys)[24] = (char (*)[24])malloc(NS * 24);
+    char (*smiss)[24] = (char (*)[24])malloc(NS * 24);
+    for (int i = 0; i < NS; i++) { snprintf(skeys[i], 24, "user:%u:%d", rng() % 100000, i); snprintf(smiss[i], 24, "user:%u:x%d", rng() % 100000, i); }
+    // Hits are looked up in shuffled order: in insertion order, chained nodes would be read sequentially.
+    u64* hits = (u64*)malloc(N * sizeof(u64));
+    const char** shits = (const char**)malloc(NS * sizeof(char*));
+    for (int i = 0; i < N; i++) hits[i] = keys[i];
+    for (int i = 0; i < NS; i++) shits[i] = skeys[i];
+    for (int i = N - 1; i > 0; i--) { int j = (int)(rng() % (u32)(i + 1)); u64 x = hits[i]; hits[i] = hits[j]; hits[j] = x; }
+    for (int i = NS - 1; i > 0; i--) { int j = (int)(rng() % (u32)(i + 1)); const char* x = shits[i]; shits[i] = shits[j]; shits[j] = x; }
+    volatile u64 sink = 0;
+    double t[2][4];
+
+    printf("[Hash map, ns per op: 1M u64 keys / 256K string keys]\n");
+    printf("%-26s %10s %10s %10s %10s\n", "", "insert", "reserved", "hit", "miss");
+    {
+        bench_umap m; bench_umap_init(&m);
+        TIME_MS(t[0][0], { bench_umap_free(&m); for (int i = 0; i < N; i++) bench_umap_put(&m, keys[i], (u64)i); });
+        TIME_MS(t[0][1], { bench_umap_free(&m); bench_umap_reserve(&m, N); for (int i = 0; i < N; i++) bench_umap_put(&m, keys[i], (u64)i); });
+        TIME_MS(t[0][2], for (int i = 0; i < N; i++) sink += *bench_umap_get(&m, hits[i]));
+        TIME_MS(t[0][3], for (int i = 0; i < N; i++) sink += bench_umap_get(&m, miss[i]) != NULL);
+        bench_umap_free(&m);
+        chain_map c = {0};
+        TIME_MS(t[1][0], { chain_free(&c); for (int i = 0; i < N; i++) chain_put(&c, (const void*)(uintptr_t)keys[i], map_hash_u64(keys[i]), (u64)i, chain_eq_u64); });
+        t[1][1] = t[1][0];
+        TIME_MS(t[1][2], for (int i = 0; i < N; i++) sink += *chain_get(&c, (const void*)(uintptr_t)hits[i], map_hash_u64(hits[i]), chain_eq_u64));
+        TIME_MS(t[1][3], for (int i = 0; i < N; i++) sink += chain_get(&c, (const void*)(uintptr_t)miss[i], map_hash_u64(miss[i]), chain_eq_u64) != NULL);
+        chain_free(&c);
+        printf("%-26s %10.1f %10.1f %10.1f %10.1f\n", "u64: DEF_MAP", t[0][0] * 1e6 / N, t[0][1] * 1e6 / N, t[0][2] * 1e6 / N, t[0][3] * 1e6 / N);
+        printf("%-26s %10.1f %10s %10.1f %10.1f\n", "u64: chained", t[1][0] * 1e6 / N, "-", t[1][2] * 1e6 / N, t[1][3] * 1e6 / N);
+    }
+    {
+        bench_smap m; bench_smap_init(&m);
+        TIME_MS(t[0][0], { bench_smap_free(&m); for (int i = 0; i < NS; i++) bench_smap_put(&m, skeys[i], (u64)i); });
+        TIME_MS(t[0][1], { bench_smap_free(&m); bench_smap_reserve(&m, NS); for (int i = 0; i < NS; i++) bench_smap_put(&m, skeys[i], (u64)i); });
+        TIME_MS(t[0][2], for (int i = 0; i < NS; i++) sink += *bench_smap_get(&m, shits[i]));
+        TIME_MS(t[0][3], for (int i = 0; i < NS; i++) sink += bench_smap_get(&m, smiss[i]) != NULL);
+        bench_smap_free(&m);
+        chain_map c = {0};
+        TIME_MS(t[1][0], { chain_free(&c); for (int i = 0; i < NS; i++) chain_put(&c, skeys[i], map_hash_str(skeys[i]), (u64)i, chain_eq_str); });
+        TIME_MS(t[1][2], for (int i = 0; i < NS; i++) sink += *chain_get(&c, shits[i], map_hash_str(shits[i]), chain_eq_str));
+        TIME_MS(t[1][3], for (int i = 0; i < NS; i++) sink += chain_get(&c, smiss[i], map_hash_str(smiss[i]), chain_eq_str) != NULL);
+        chain_free(&c);
+        printf("%-26s %10.1f %10.1f %10.1f %10.1f\n", "string: DEF_MAP", t[0][0] * 1e6 / NS, t[0][1] * 1e6 / NS, t[0][2] * 1e6 / NS, t[0][3] * 1e6 / NS);
+        printf("%-26s %10.1f %10s %10.1f %10.1f\n", "string: chained", t[1][0] * 1e6 / NS, "-", t[1][2] * 1e6 / NS, t[1][3] * 1e6 / NS);
+    }
+    printf("\n");
+    (void)sink;
+    free(keys); free(miss); free(hits); free(skeys); free(smiss); free(shits);
+}
+
+#ifdef SBIG_THREADS
+static void bench_ntt_threads() {
+    int n = 1 << 20;
+    u32* a = (u32*)malloc(n * sizeof(u32));
+    u32* b = (u32*)malloc(n * sizeof(u32));
+    u32* out = (u32*)malloc(2 * n * sizeof(u32));
+    for (int i = 0; i < n; i++) { a[i] = rng(); b[i] = rng(); }
+    printf("[NTT threads: %d x %d limbs]\n", n, n);
+    for (int t = 1; t <= 16; t *= 2) {
+        double ms;
+        sbig_set_threads(t);
+        TIME_MS(ms, _sbig_mul_ntt(out, a, n, b, n, &sbig_heap));
+        printf("%2d threads: %.2f ms\n", t, ms);
+    }
+    sbig_set_threads(1);
+    printf("\n");
+    free(a); free(b); free(out);
+}
+#endif
+
+// One "request": 256 small allocations (16-271 bytes) that all die together.
+// malloc/free each one vs. an arena reset, directly and through qol_malloc.
+// Then a pool against malloc for churn of one object size.
+static void bench_alloc() {
+    enum { PER_REQ = 256, OBJS = 4096 };
+    static size_t sizes[PER_REQ];
+    static void* ptrs[OBJS];
+    volatile size_t sink = 0;
+    for (int i = 0; i < PER_REQ; i++) sizes[i] = 16 + rng() % 256;
+    double t_malloc, t_arena, t_scoped;
+    TIME_MS(t_malloc, {
+        for (int i = 0; i < PER_REQ; i++) { ptrs[i] = malloc(sizes[i]); ((char*)ptrs[i])[0] = (char)i; }
+        for (int i = 0; i < PER_REQ; i++) { sink += ((char*)ptrs[i])[0]; free(ptrs[i]); }
+    });
+    qol_arena arena;
+    arena_init(&arena, 0);
+    TIME_MS(t_arena, {
+        for (int i = 0; i < PER_REQ; i++) { ptrs[i] = arena_alloc(&arena, sizes[i]); ((char*)ptrs[i])[0] = (char)i; }
+        for (int i = 0; i < PER_REQ; i++) sink += ((char*)ptrs[i])[0];
+        arena_reset(&arena);
+    });
+    TIME_MS(t_scoped, {
+        const qol_alloc* prev = qol_alloc_use(&arena.al);
+        for (int i = 0; i < PER_REQ; i++) { ptrs[i] = qol_malloc(sizes[i]); ((char*)ptrs[i])[0] = (char)i; }
+        for (int i = 0; i < PER_REQ; i++) { sink += ((char*)ptrs[i])[0]; qol_free(ptrs[i]); }
+        qol_alloc_use(prev);
+        arena_reset(&arena);
+    });
+    arena_free(&arena);
+    printf("[Allocation: request of %d blocks, ns per block]\n", PER_REQ);
+    printf("%-28s %9.1f\n", "malloc + free", t_malloc * 1e6 / PER_REQ);
+    printf("%-28s %9.1f (%.1fx)\n", "arena_alloc + reset", t_arena * 1e6 / PER_REQ, t_malloc / t_arena);
+    printf("%-28s %9.1f (%.1fx)\n", "qol_malloc on arena", t_scoped * 1e6 / PER_REQ, t_malloc / t_scoped);
+
+    // Fill, then free every other object and refill, as a connection table would.
+    double t_m, t_p;
+    TIME_MS(t_m, {
+        for (int i = 0; i < OBJS; i++) ptrs[i] = malloc(48);
+        for (int i = 0; i < OBJS; i += 2) free(ptrs[i]);
+        for (int i = 0; i < OBJS; i += 2) ptrs[i] = malloc(48);
+        for (int i = 0; i < OBJS; i++) free(ptrs[i]);
+    });
+    qol_pool pool;
+    pool_init(&pool, 48, 0);
+    TIME_MS(t_p, {
+        for (int i = 0; i < OBJS; i++) ptrs[i] = pool_get(&pool);
+        for (int i = 0; i < OBJS; i += 2) pool_put(&pool, ptrs[i]);
+        for (int i = 0; i < OBJS; i += 2) ptrs[i] = pool_get(&pool);
+        for (int i = 0; i < OBJS; i++) pool_put(&pool, ptrs[i]);
+    });
+    pool_free(&pool);
+    printf("%-28s %9.1f\n", "malloc/free, 48 B churn", t_m * 1e6 / (OBJS * 3));
+    printf("%-28s %9.1f (%.1fx)\n\n", "pool_get/put, 48 B churn", t_p * 1e6 / (OBJS * 3), t_m / t_p);
+    (void)sink;
+}
+
+// Sorting against qsort, which calls its comparator through a pointer.
+// Each timing includes copying the unsorted input back; that copy is measured
+// on its own and subtracted.
+typedef struct { u64 key; u32 id; char name[20]; } bench_rec;
+#define BENCH_REC_LESS(a, b) ((a).key < (b).key)
+#define BENCH_REC_KEY(r) ((r).key)
+DEF_SORT_NUM(bench_u32, u32)
+DEF_SORT(bench_recs, bench_rec, BENCH_REC_LESS)
+DEF_SORT_STR(bench_strs)
+DEF_RADIX(bench_u32r, u32, SORT_KEY_SELF)
+DEF_RADIX(bench_recr, bench_rec, BENCH_REC_KEY)
+DEF_RADIX_STR(bench_strr, const char*, SORT_STR_SELF)
+
+static int cmp_u32(const void* a, const void* b) { u32 x = *(const u32*)a, y = *(const u32*)b; return (x > y) - (x < y); }
+static int cmp_rec(const void* a, const void* b) { u64 x = ((const bench_rec*)a)->key, y = ((const bench_rec*)b)->key; return (x > y) - (x < y); }
+static int cmp_strp(const void* a, const void* b) { return strcmp(*(const char* const*)a, *(const char* const*)b); }
+
+#define BENCH_SORT(LABEL, BASE, COPY, SORT) { \
+    double _t; \
+    TIME_MS(_t, { COPY; SORT; }); \
+    _t -= BASE; \
+    printf("%-28s %9.1f", LABEL, _t * 1e6 / n); \
+    if (t_qsort > 0) printf(" (%.1fx)", t_qsort / _t); else t_qsort = _t; \
+    printf("\n"); \
+}
+
+static void bench_sort() {
+    size_t n = 1000000;
+    u32* src = (u32*)malloc(n * sizeof(u32));
+    u32* a = (u32*)malloc(n * sizeof(u32));
+    for (size_t i = 0; i < n; i++) src[i] = rng();
+    double t_copy, t_qsort = 0;
+    TIME_MS(t_copy, memcpy(a, src, n * sizeof(u32)));
+    printf("[Sort: 1M random u32, ns per element]\n");
+    BENCH_SORT("qsort", t_copy, memcpy(a, src, n * sizeof(u32)), qsort(a, n, sizeof(u32), cmp_u32));
+    BENCH_SORT("DEF_SORT (pdqsort)", t_copy, memcpy(a, src, n * sizeof(u32)), bench_u32_sort(a, n));
+    BENCH_SORT("DEF_RADIX", t_copy, memcpy(a, src, n * sizeof(u32)), bench_u32r_radix_sort(a, n));
+#ifdef SBIG_THREADS
+    BENCH_SORT("sort_parallel, 4 threads", t_copy, memcpy(a, src, n * sizeof(u32)), bench_u32_sort_parallel(a, n, 4));
+#endif
+    t_qsort = 0;
+    for (size_t i = 0; i < n; i++) src[i] = (u32)i + (rng() % 100 == 0 ? rng() % 1000 : 0);
+    printf("[Sort: 1M nearly sorted u32]\n");
+    BENCH_SORT("qsort", t_copy, memcpy(a, src, n * sizeof(u32)), qsort(a, n, sizeof(u32), cmp_u32));
+    BENCH_SORT("DEF_SORT (pdqsort)", t_copy, memcpy(a, src, n * sizeof(u32)), bench_u32_sort(a, n));
+    BENCH_SORT("DEF_RADIX", t_copy, memcpy(a, src, n * sizeof(u32)), bench_u32r_radix_sort(a, n));
+
+    // Branchless lower bound against bsearch and a plain branching loop.
+    for (size_t i = 0; i < n; i++) src[i] = rng();
+    bench_u32_sort(src, n);
+    enum { Q = 1 << 20 };
+    u32* keys = (u32*)malloc(Q * sizeof(u32));
+    for (int i = 0; i < Q; i++) keys[i] = rng();
+    volatile size_t sink = 0;
+    double t_bs, t_branchy, t_lb;
+    TIME_MS(t_bs, for (int i = 0; i < Q; i++) sink += (size_t)bsearch(&keys[i], src, n, sizeof(u32), cmp_u32));
+    TIME_MS(t_branchy, for (int i = 0; i < Q; i++) {
+        size_t lo = 0; size_t hi = n;
+        while (lo < hi) { size_t mid = lo + (hi - lo) / 2; if (src[mid] < keys[i]) lo = mid + 1; else hi = mid; }
+        sink += lo;
+    });
+    TIME_MS(t_lb, for (int i = 0; i < Q; i++) sink += bench_u32_lower_bound(src, n, keys[i]));
+    printf("[Search: 1M random lookups in 1M u32, ns per lookup]\n");
+    printf("%-28s %9.1f\n", "bsearch", t_bs * 1e6 / Q);
+    printf("%-28s %9.1f\n", "branching lower bound", t_branchy * 1e6 / Q);
+    printf("%-28s %9.1f (%.1fx)\n", "DEF_SORT lower_bound", t_lb * 1e6 / Q, t_branchy / t_lb);
+    (void)sink;
+    free(keys); free(a); free(src);
+
+    n = 500000;
+    bench_rec* rs = (bench_rec*)malloc(n * sizeof(bench_rec));
+    bench_rec* ra = (bench_rec*)malloc(n * sizeof(bench_rec));
+    for (size_t i = 0; i < n; i++) { rs[i].key = ((u64)rng() << 32) | rng(); rs[i].id = (u32)i; rs[i].name[0] = 0; }
+    TIME_MS(t_copy, memcpy(ra, rs, n * sizeof(bench_rec)));
+    t_qsort = 0;
+    printf("[Sort: 500k 32-byte records by u64 key]\n");
+    BENCH_SORT("qsort", t_copy, memcpy(ra, rs, n * sizeof(bench_rec)), qsort(ra, n, sizeof(bench_rec), cmp_rec));
+    BENCH_SORT("DEF_SORT (pdqsort)", t_copy, memcpy(ra, rs, n * sizeof(bench_rec)), bench_recs_sort(ra, n));
+    BENCH_SORT("DEF_RADIX", t_copy, memcpy(ra, rs, n * sizeof(bench_rec)), bench_recr_radix_sort(ra, n));
+    free(rs); free(ra);
+
+    // Path-like names sharing long prefixes, as in a directory listing.
+    n = 200000;
+    char* text = (char*)malloc(n * 48);
+    const char** ss = (const char**)malloc(n * sizeof(char*));
+    const char** sa = (const char**)malloc(n * sizeof(char*));
+    for (size_t i = 0; i < n; i++) {
+        char* p = text + i * 48;
+        int m = snprintf(p, 48, "/srv/data/%s/file_", rng() % 2 ? "logs" : "cache");
+        for (int k = 0; k < 8; k++) p[m++] = (char)('a' + rng() % 26);
+        p[m] = 0;
+        ss[i] = p;
+    }
+    TIME_MS(t_copy, memcpy(sa, ss, n * sizeof(char*)));
+    t_qsort = 0;
+    printf("[Sort: 200k path strings]\n");
+    BENCH_SORT("qsort + strcmp", t_copy, memcpy(sa, ss, n * sizeof(char*)), qsort(sa, n, sizeof(char*), cmp_strp));
+    BENCH_SORT("DEF_SORT_STR (pdqsort)", t_copy, memcpy(sa, ss, n * sizeof(char*)), bench_strs_sort(sa, n));
+    BENCH_SORT("DEF_RADIX_STR (MSD)", t_copy, memcpy(sa, ss, n * sizeof(char*)), bench_strr_radix_sort(sa, n));
+    printf("\n");
+    free(text); free(ss); free(sa);
+}
+
+int main() {
+    printf("================================\n");
+    printf("   SIMPLE_TYPES BENCHMARKS      \n");
+    printf("================================\n\n");
+    bench_mul_crossover();
+    bench_mul_full();
+    bench_batch();
+    bench_float_accuracy();
+    bench_float_throughput();
+    bench_gcd();
+    bench_map();
+    bench_alloc();
+    bench_sort();
+#ifdef SBIG_THREADS
+    bench_ntt_threads();
+#endif
+    return 0;
+}
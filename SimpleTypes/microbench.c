@@ -0,0 +1,151 @@
+#include "simple_types.h"
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    #define HAVE_TSC 1
+#endif
+
+// Per-width microbenchmarks: add/mul/mod/shl/print/parse from suint32 to suint12288.
+//
+// Build: gcc -O2 microbench.c -o microbench
+// Usage: ./microbench [--json out.json] [--baseline base.json] [--threshold 10]
+//                     [--filter mul] [--min-ms 10]
+//
+// --json writes one record per line so the file doubles as a baseline later.
+// With --baseline, each result is compared by ns/op and the exit code is 1 if
+// anything got slower than the threshold (percent).
+// Cycles come from the TSC (reference cycles, not core clock) and read 0 elsewhere.
+
+typedef struct { char name[32]; double ns, cycles; } result;
+
+// Every width benched, and the MEASURE count per width in BENCH_WIDTH; results
+// is sized from both.
+#define WIDTHS(X) \
+    X(32, 1)    X(64, 2)    X(128, 4)   X(256, 8)    X(512, 16) \
+    X(1024, 32) X(2048, 64) X(4096, 128) X(8192, 256) X(12288, 384)
+#define COUNT_WIDTH(BITS, COUNT) + 1
+#define OPS_PER_WIDTH 6
+
+static result results[(0 WIDTHS(COUNT_WIDTH)) * OPS_PER_WIDTH];
+static int n_results = 0;
+static double min_ms = 10.0;
+static const char* filter = NULL;
+
+static double now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static u64 cycles() {
+#ifdef HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static u32 rng_state = 0x2545F491;
+static u32 rng() { rng_state ^= rng_state << 13; rng_state ^= rng_state >> 17; rng_state ^= rng_state << 5; return rng_state; }
+
+// Keeps the compiler from hoisting or dropping work on x.
+#define CLOBBER(x) __asm__ volatile("" : : "g"(&(x)) : "memory")
+
+// Doubles the repetition count until one batch takes min_ms, then keeps the
+// fastest of RUNS batches so scheduler noise does not read as a regression.
+#define RUNS 5
+#define MEASURE(NAME, ...) { \
+    if (n_results == (int)(sizeof(results) / sizeof(results[0]))) \
+        fprintf(stderr, "results full, skipping %s (raise OPS_PER_WIDTH)\n", NAME); \
+    else if (!filter || strstr(NAME, filter)) { \
+        long _reps = 1; double _t0, _t1, _best_ns = 0, _best_cyc = 0; u64 _c0, _c1; \
+        for (int _run = -1; _run < RUNS; _run++) { \
+            _t0 = now_ns(); _c0 = cycles(); \
+            for (long _i = 0; _i < _reps; _i++) { __VA_ARGS__; } \
+            _c1 = cycles(); _t1 = now_ns(); \
+            if (_run < 0 && _t1 - _t0 < min_ms * 1e6) { _reps *= 2; _run--; continue; } \
+            if (_run < 0) continue; \
+            if (_run == 0 || _t1 - _t0 < _best_ns) { _best_ns = _t1 - _t0; _best_cyc = (double)(_c1 - _c0); } \
+        } \
+        result* _r = &results[n_results++]; \
+        snprintf(_r->name, sizeof(_r->name), "%s", NAME); \
+        _r->ns = _best_ns / _reps; \
+        _r->cycles = _best_cyc / _reps; \
+    } \
+}
+
+#define BENCH_WIDTH(BITS, COUNT) { \
+    static suint##BITS a, b, r; \
+    static char buf[COUNT * 10 + 2]; \
+    for (int k = 0; k < COUNT; k++) { a.limbs[k] = rng(); b.limbs[k] = k < COUNT / 2 || COUNT == 1 ? rng() : 0; } \
+    suint##BITS##_to_dec(a, buf, sizeof(buf)); \
+    MEASURE("add/" #BITS,   suint##BITS##_add(&r, a, b); CLOBBER(r); CLOBBER(a)) \
+    MEASURE("mul/" #BITS,   suint##BITS##_mul(&r, a, b); CLOBBER(r); CLOBBER(a)) \
+    MEASURE("mod/" #BITS,   suint##BITS##_mod(&r, a, b); CLOBBER(r); CLOBBER(a)) \
+    MEASURE("shl/" #BITS,   r = a; suint##BITS##_shl(&r, 13); CLOBBER(r)) \
+    MEASURE("print/" #BITS, suint##BITS##_to_dec(a, buf, sizeof(buf)); CLOBBER(buf)) \
+    MEASURE("parse/" #BITS, suint##BITS##_from_dec(&r, buf); CLOBBER(r)) \
+}
+
+// Reads the ns/op for name from a file written by --json. Returns -1 if absent.
+static double baseline_ns(FILE* f, const char* name) {
+    char line[256], key[32];
+    double ns;
+    rewind(f);
+    while (fgets(line, sizeof(line), f))
+        if (sscanf(line, " {\"name\": \"%31[^\"]\", \"ns\": %lf", key, &ns) == 2 && strcmp(key, name) == 0)
+            return ns;
+    return -1;
+}
+
+static void write_json(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (!f) { fprintf(stderr, "cannot write %s\n", path); return; }
+    fprintf(f, "{\n  \"benchmarks\": [\n");
+    for (int i = 0; i < n_results; i++)
+        fprintf(f, "    {\"name\": \"%s\", \"ns\": %.3f, \"cycles\": %.1f}%s\n",
+            results[i].name, results[i].ns, results[i].cycles, i + 1 < n_results ? "," : "");
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+}
+
+int main(int argc, char** argv) {
+    const char *json = NULL, *baseline = NULL;
+    double threshold = 10.0;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--json") && i + 1 < argc) json = argv[++i];
+        else if (!strcmp(argv[i], "--baseline") && i + 1 < argc) baseline = argv[++i];
+        else if (!strcmp(argv[i], "--threshold") && i + 1 < argc) threshold = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--filter") && i + 1 < argc) filter = argv[++i];
+        else if (!strcmp(argv[i], "--min-ms") && i + 1 < argc) min_ms = atof(argv[++i]);
+        else { fprintf(stderr, "usage: %s [--json out] [--baseline file] [--threshold pct] [--filter str] [--min-ms ms]\n", argv[0]); return 2; }
+    }
+
+    WIDTHS(BENCH_WIDTH)
+
+    FILE* base = baseline ? fopen(baseline, "r") : NULL;
+    if (baseline && !base) fprintf(stderr, "cannot read %s, skipping comparison\n", baseline);
+    int regressions = 0;
+
+    printf("%-12s %14s %14s", "benchmark", "ns/op", "cycles/op");
+    if (base) printf(" %14s %9s", "baseline ns", "delta");
+    printf("\n");
+    for (int i = 0; i < n_results; i++) {
+        result* r = &results[i];
+        printf("%-12s %14.2f %14.1f", r->name, r->ns, r->cycles);
+        double old = base ? baseline_ns(base, r->name) : -1;
+        if (old > 0) {
+            double delta = (r->ns - old) / old * 100.0;
+            printf(" %14.2f %+8.1f%%", old, delta);
+            if (delta > threshold) { printf("  REGRESSED"); regressions++; }
+            else if (delta < -threshold) printf("  improved");
+        } else if (base) printf(" %14s %9s", "-", "-");
+        printf("\n");
+    }
+    if (base) {
+        printf("\n%d regression(s) above %.1f%%\n", regressions, threshold);
+        fclose(base);
+    }
+    if (json) write_json(json);
+    return regressions ? 1 : 0;
+}
@@ -2,9 +2,58 @@
 #define SIMPLE_TYPES_H
 
 #include <stdint.h>
+#include <limits.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(SIMPLE_TYPES_NO_SIMD)
+    #define _TYPES_X86_SIMD 1
+    #include <immintrin.h>
+#endif
+
+#ifdef SBIG_THREADS
+    #ifdef _WIN32
+        #include <windows.h>
+    #else
+        #include <pthread.h>
+    #endif
+#endif
+
+// --- Allocation Hooks ---
+// Every allocation the library makes goes through these. Define QOL_MALLOC,
+// QOL_REALLOC and QOL_FREE (QOL_CALLOC is optional) before including to use
+// another heap, or define QOL_USE_ALLOC to route them through qol_malloc below,
+// which serves them from the calling thread's qol_alloc. The other modules only
+// fall back to libc, so with QOL_USE_ALLOC include this header first (and list
+// SimpleTypes first when amalgamating with build.sh).
+#if defined(QOL_USE_ALLOC) && !defined(QOL_MALLOC)
+    static inline void* qol_malloc(size_t size);
+    static inline void* qol_realloc(void* ptr, size_t size);
+    static inline void qol_free(void* ptr);
+    #define QOL_ALLOC_ROUTED 1
+    #define QOL_MALLOC(n) qol_malloc(n)
+    #define QOL_REALLOC(p, n) qol_realloc(p, n)
+    #define QOL_FREE(p) qol_free(p)
+#endif
+#ifndef QOL_MALLOC
+    #define QOL_MALLOC(n) malloc(n)
+    #define QOL_REALLOC(p, n) realloc(p, n)
+    #define QOL_FREE(p) free(p)
+    #ifndef QOL_CALLOC
+        #define QOL_CALLOC(count, n) calloc(count, n)
+    #endif
+#endif
+#ifndef QOL_CALLOC
+    #define QOL_CALLOC(count, n) _qol_calloc(count, n)
+#endif
+static inline void* _qol_calloc(size_t count, size_t size) {
+    if (size && count > (size_t)-1 / size) return NULL;
+    void* p = QOL_MALLOC(count * size);
+    if (p) memset(p, 0, count * size);
+    return p;
+}
+
 // --- Base Types ---
 typedef uint8_t u8;   typedef uint16_t u16; typedef uint32_t u32; typedef uint64_t u64;
 typedef int8_t s8;    typedef int16_t s16;  typedef int32_t s32;  typedef int64_t s64;
@@ -13,7 +62,7 @@ typedef int8_t s8;    typedef int16_t s16;  typedef int32_t s32;  typedef int64_
 #define DEF_STRUCTS(BITS, LIMBS) \
     typedef struct { u32 limbs[LIMBS]; } suint##BITS; \
     typedef struct { s32 limbs[LIMBS]; } sint##BITS; \
-    typedef struct { suint##BITS mantissa; s32 exponent; } sfloat##BITS;
+    typedef struct { suint##BITS mantissa; s32 exponent; s32 sign; } sfloat##BITS;
 
 DEF_STRUCTS(32, 1)    DEF_STRUCTS(64, 2)    DEF_STRUCTS(128, 4)
 DEF_STRUCTS(256, 8)   DEF_STRUCTS(512, 16)  DEF_STRUCTS(1024, 32)
@@ -33,26 +82,77 @@ static inline void _internal_raw_hex(u32* limbs, int count) {
     }
 }
 
-static inline void _internal_dec_ascii(u32* limbs, int count) {
+// Writes the decimal form of limbs into out (NUL-terminated), optionally with
+// thousands separators. Peels nine digits per pass over the limbs.
+// Returns the length, or 0 if cap is too small.
+static inline size_t _internal_dec_str(const u32* limbs, int count, char* out, size_t cap, int commas) {
     u32 temp[count];
     memcpy(temp, limbs, count * sizeof(u32));
-    char digits[5000]; 
-    int pos = 0, digit_count = 0;
-    while (1) {
+    int len = count;
+    while (len > 0 && temp[len - 1] == 0) len--;
+    char digits[count * 14 + 2];
+    size_t pos = 0;
+    int digit_count = 0;
+    do {
         u64 remainder = 0;
-        int all_zero = 1;
-        for (int i = count - 1; i >= 0; i--) {
-            u64 val = temp[i] + (remainder << 32);
-            temp[i] = (u32)(val / 10);
-            remainder = val % 10;
-            if (temp[i] > 0) all_zero = 0;
+        for (int i = len - 1; i >= 0; i--) {
+            u64 val = (remainder << 32) | temp[i];
+            temp[i] = (u32)(val / 1000000000u);
+            remainder = val % 1000000000u;
+        }
+        while (len > 0 && temp[len - 1] == 0) len--;
+        // Inner chunks keep their leading zeros; the last one stops at its top digit.
+        for (int d = 0; d < 9; d++) {
+            if (len == 0 && remainder == 0 && d > 0) break;
+            if (commas && digit_count > 0 && digit_count % 3 == 0) digits[pos++] = ',';
+            digits[pos++] = (char)('0' + remainder % 10);
+            remainder /= 10;
+            digit_count++;
+        }
+    } while (len > 0);
+    if (pos + 1 > cap) { if (cap) out[0] = '\0'; return 0; }
+    for (size_t i = 0; i < pos; i++) out[i] = digits[pos - 1 - i];
+    out[pos] = '\0';
+    return pos;
+}
+
+static inline void _internal_dec_ascii(u32* limbs, int count) {
+    char digits[count * 14 + 2];
+    _internal_dec_str(limbs, count, digits, sizeof(digits), 1);
+    fputs(digits, stdout);
+}
+
+// limbs = limbs * scale + add. Returns 0 on overflow.
+static inline int _internal_muladd(u32* limbs, int count, u32 scale, u32 add) {
+    u64 carry = add;
+    for (int i = 0; i < count; i++) {
+        u64 cur = (u64)limbs[i] * scale + carry;
+        limbs[i] = (u32)cur;
+        carry = cur >> 32;
+    }
+    return carry == 0;
+}
+
+// Parses decimal digits into limbs, nine at a time; ',' and '_' separators
+// are skipped. Returns 0 on an empty or invalid string or when the value overflows.
+static inline int _internal_dec_parse(u32* limbs, int count, const char* s) {
+    memset(limbs, 0, count * sizeof(u32));
+    u32 chunk = 0, scale = 1;
+    int any = 0;
+    for (;; s++) {
+        char c = *s;
+        if (c == ',' || c == '_') continue;
+        if (c < '0' || c > '9') { if (c) return 0; break; }
+        chunk = chunk * 10 + (u32)(c - '0');
+        scale *= 10;
+        any = 1;
+        if (scale == 1000000000u) {
+            if (!_internal_muladd(limbs, count, scale, chunk)) return 0;
+            chunk = 0; scale = 1;
         }
-        if (digit_count > 0 && digit_count % 3 == 0) digits[pos++] = ',';
-        digits[pos++] = (char)('0' + remainder);
-        digit_count++;
-        if (all_zero) break;
     }
-    for (int i = pos - 1; i >= 0; i--) putchar(digits[i]);
+    if (scale > 1 && !_internal_muladd(limbs, count, scale, chunk)) return 0;
+    return any;
 }
 
 // --- Shift Operations ---
@@ -132,8 +232,8 @@ DEF_MOD(12288, 384)
     static inline void _f_u##BITS(suint##BITS v)  { _internal_dec_ascii(v.limbs, COUNT); } \
     static inline void _nf_s##BITS(sint##BITS v)  { printf("(S)"); _internal_raw_hex((u32*)v.limbs, COUNT); } \
     static inline void _f_s##BITS(sint##BITS v)   { if(v.limbs[COUNT-1] < 0) printf("-"); _internal_dec_ascii((u32*)v.limbs, COUNT); } \
-    static inline void _nf_flt##BITS(sfloat##BITS v) { _internal_raw_hex(v.mantissa.limbs, COUNT); printf(" E%d", v.exponent); } \
-    static inline void _f_flt##BITS(sfloat##BITS v)  { _internal_dec_ascii(v.mantissa.limbs, COUNT); printf(" * 2^%d", v.exponent); }
+    static inline void _nf_flt##BITS(sfloat##BITS v) { if (v.sign) printf("-"); _internal_raw_hex(v.mantissa.limbs, COUNT); printf(" E%d", v.exponent); } \
+    static inline void _f_flt##BITS(sfloat##BITS v)  { if (v.sign) printf("-"); _internal_dec_ascii(v.mantissa.limbs, COUNT); printf(" * 2^%d", v.exponent); }
 
 DEF_PRINTERS(32, 1)    DEF_PRINTERS(64, 2)    DEF_PRINTERS(128, 4)
 DEF_PRINTERS(256, 8)   DEF_PRINTERS(512, 16)  DEF_PRINTERS(1024, 32)
@@ -146,7 +246,8 @@ DEF_PRINTERS(12288, 384)
     sint32: _nf_s32, sint64: _nf_s64, sint128: _nf_s128, sint256: _nf_s256, sint512: _nf_s512, \
     sint1024: _nf_s1024, sint2048: _nf_s2048, sint4096: _nf_s4096, sint8192: _nf_s8192, sint12288: _nf_s12288, \
     sfloat32: _nf_flt32, sfloat64: _nf_flt64, sfloat128: _nf_flt128, sfloat256: _nf_flt256, sfloat512: _nf_flt512, \
-    sfloat1024: _nf_flt1024, sfloat2048: _nf_flt2048, sfloat4096: _nf_flt4096, sfloat8192: _nf_flt8192, sfloat12288: _nf_flt12288 \
+    sfloat1024: _nf_flt1024, sfloat2048: _nf_flt2048, sfloat4096: _nf_flt4096, sfloat8192: _nf_flt8192, sfloat12288: _nf_flt12288, \
+    sbig: _nf_big \
 )(val)
 
 #define slibprint(val) _Generic((val), \
@@ -155,8 +256,26 @@ DEF_PRINTERS(12288, 384)
     sint32: _f_s32, sint64: _f_s64, sint128: _f_s128, sint256: _f_s256, sint512: _f_s512, \
     sint1024: _f_s1024, sint2048: _f_s2048, sint4096: _f_s4096, sint8192: _f_s8192, sint12288: _f_s12288, \
     sfloat32: _f_flt32, sfloat64: _f_flt64, sfloat128: _f_flt128, sfloat256: _f_flt256, sfloat512: _f_flt512, \
-    sfloat1024: _f_flt1024, sfloat2048: _f_flt2048, sfloat4096: _f_flt4096, sfloat8192: _f_flt8192, sfloat12288: _f_flt12288 \
+    sfloat1024: _f_flt1024, sfloat2048: _f_flt2048, sfloat4096: _f_flt4096, sfloat8192: _f_flt8192, sfloat12288: _f_flt12288, \
+    sbig: _f_big \
 )(val)
+
+// --- Decimal Conversion ---
+#define DEF_DEC(BITS, COUNT) \
+    /* Plain digits, no separators. Returns the length, or 0 if cap is too small. */ \
+    static inline size_t suint##BITS##_to_dec(suint##BITS v, char* out, size_t cap) { return _internal_dec_str(v.limbs, COUNT, out, cap, 0); } \
+    /* Returns 0 (res untouched) on invalid input or overflow. */ \
+    static inline int suint##BITS##_from_dec(suint##BITS *res, const char* s) { \
+        suint##BITS tmp; \
+        if (!_internal_dec_parse(tmp.limbs, COUNT, s)) return 0; \
+        *res = tmp; return 1; \
+    }
+
+DEF_DEC(32, 1)    DEF_DEC(64, 2)    DEF_DEC(128, 4)
+DEF_DEC(256, 8)   DEF_DEC(512, 16)  DEF_DEC(1024, 32)
+DEF_DEC(2048, 64) DEF_DEC(4096, 128) DEF_DEC(8192, 256)
+DEF_DEC(12288, 384)
+
 // --- Addition ---
 #define DEF_ADD(BITS, COUNT) \
     static inline u32 suint##BITS##_add(suint##BITS *res, suint##BITS a, suint##BITS b) { \
@@ -185,8 +304,29 @@ DEF_PRINTERS(12288, 384)
         *res = out; \
     }
 
+// --- Comparison ---
+// Returns -1, 0 or 1.
+#define DEF_CMP(BITS, COUNT) \
+    static inline int suint##BITS##_cmp(suint##BITS a, suint##BITS b) { \
+        for (int i = COUNT - 1; i >= 0; i--) \
+            if (a.limbs[i] != b.limbs[i]) return a.limbs[i] < b.limbs[i] ? -1 : 1; \
+        return 0; \
+    }
+
+DEF_ADD(32, 1)    DEF_ADD(64, 2)    DEF_ADD(128, 4)
+DEF_ADD(256, 8)   DEF_ADD(512, 16)  DEF_ADD(1024, 32)
+DEF_ADD(2048, 64) DEF_ADD(4096, 128) DEF_ADD(8192, 256)
 DEF_ADD(12288, 384)
+
+DEF_MUL(32, 1)    DEF_MUL(64, 2)    DEF_MUL(128, 4)
+DEF_MUL(256, 8)   DEF_MUL(512, 16)  DEF_MUL(1024, 32)
+DEF_MUL(2048, 64) DEF_MUL(4096, 128) DEF_MUL(8192, 256)
 DEF_MUL(12288, 384)
+
+DEF_CMP(32, 1)    DEF_CMP(64, 2)    DEF_CMP(128, 4)
+DEF_CMP(256, 8)   DEF_CMP(512, 16)  DEF_CMP(1024, 32)
+DEF_CMP(2048, 64) DEF_CMP(4096, 128) DEF_CMP(8192, 256)
+DEF_CMP(12288, 384)
 // Power function: res = base ^ exp
 static inline void suint12288_pow(suint12288 *res, u32 base_val, u32 exp) {
     suint12288 b = {0}; b.limbs[0] = base_val;
@@ -216,4 +356,2422 @@ static inline void suint12288_tetrate(suint12288 *res, u32 base, u32 height) {
     }
     *res = current_val;
 }
+
+// --- Allocators ---
+// qol_alloc is the allocator interface shared by the library: sbig takes one for
+// its limbs, and qol_alloc_use makes one the target of QOL_MALLOC when built
+// with QOL_USE_ALLOC. qol_arena bump-allocates and frees everything at once;
+// qol_pool recycles fixed-size objects. Neither locks: keep one per thread.
+typedef struct {
+    void* (*alloc)(void* ctx, size_t size);
+    void* (*resize)(void* ctx, void* ptr, size_t old_size, size_t new_size);
+    void  (*release)(void* ctx, void* ptr, size_t size);
+    void* ctx;
+} qol_alloc;
+
+#if defined(_MSC_VER)
+    #define _TYPES_TLS __declspec(thread)
+#else
+    #define _TYPES_TLS __thread
+#endif
+
+// Backing memory for arenas and pools. Calls the hooks unless they lead back to
+// qol_malloc, which could land in the very arena asking for a block.
+#ifdef QOL_ALLOC_ROUTED
+    #define _QOL_SYS_MALLOC(n) malloc(n)
+    #define _QOL_SYS_REALLOC(p, n) realloc(p, n)
+    #define _QOL_SYS_FREE(p) free(p)
+#else
+    #define _QOL_SYS_MALLOC(n) QOL_MALLOC(n)
+    #define _QOL_SYS_REALLOC(p, n) QOL_REALLOC(p, n)
+    #define _QOL_SYS_FREE(p) QOL_FREE(p)
+#endif
+
+#define _QOL_ALIGN(n) (((n) + 15) & ~(size_t)15)
+
+static inline void* _qol_heap_alloc(void* ctx, size_t size) { (void)ctx; return _QOL_SYS_MALLOC(size); }
+static inline void* _qol_heap_resize(void* ctx, void* ptr, size_t old_size, size_t new_size) { (void)ctx; (void)old_size; return _QOL_SYS_REALLOC(ptr, new_size); }
+static inline void _qol_heap_release(void* ctx, void* ptr, size_t size) { (void)ctx; (void)size; _QOL_SYS_FREE(ptr); }
+static const qol_alloc qol_heap = { _qol_heap_alloc, _qol_heap_resize, _qol_heap_release, NULL };
+
+// --- Bump Arena ---
+typedef struct _qol_arena_block {
+    struct _qol_arena_block* next;
+    size_t size, used;
+    size_t pad;   // Keeps data 16-byte aligned.
+    unsigned char data[];
+} _qol_arena_block;
+
+typedef struct {
+    _qol_arena_block* head;
+    _qol_arena_block* cur;
+    size_t block_size;
+    qol_alloc al;   // Pass &arena.al to qol_alloc_use or sbig_init; the arena must not move.
+} qol_arena;
+
+static inline void* arena_alloc(qol_arena* a, size_t size) {
+    _qol_arena_block* c = a->cur;
+    size = _QOL_ALIGN(size);
+    if (c && c->size - c->used >= size) {
+        void* p = c->data + c->used;
+        c->used += size;
+        return p;
+    }
+    while (c && c->next) {
+        c = a->cur = c->next;
+        c->used = 0;
+        if (c->size >= size) { c->used = size; return c->data; }
+    }
+    size_t bsize = size > a->block_size ? size : a->block_size;
+    _qol_arena_block* blk = (_qol_arena_block*)_QOL_SYS_MALLOC(sizeof(_qol_arena_block) + bsize);
+    if (!blk) return NULL;
+    blk->size = bsize; blk->used = size; blk->next = NULL;
+    if (c) { blk->next = c->next; c->next = blk; }
+    else a->head = blk;
+    a->cur = blk;
+    return blk->data;
+}
+
+static inline void* _qol_arena_alloc(void* ctx, size_t size) { return arena_alloc((qol_arena*)ctx, size); }
+
+static inline void* _qol_arena_resize(void* ctx, void* ptr, size_t old_size, size_t new_size) {
+    qol_arena* a = (qol_arena*)ctx;
+    if (!ptr) return arena_alloc(a, new_size);
+    old_size = _QOL_ALIGN(old_size);
+    _qol_arena_block* c = a->cur;
+    // Grow in place when ptr is the most recent allocation of the current block.
+    if (c && (unsigned char*)ptr + old_size == c->data + c->used &&
+        c->used - old_size + _QOL_ALIGN(new_size) <= c->size) {
+        c->used = c->used - old_size + _QOL_ALIGN(new_size);
+        return ptr;
+    }
+    void* p = arena_alloc(a, new_size);
+    if (p) memcpy(p, ptr, old_size < new_size ? old_size : new_size);
+    return p;
+}
+
+// Only the most recent allocation is given back (stack-like temporaries);
+// everything else comes back on arena_reset.
+static inline void _qol_arena_release(void* ctx, void* ptr, size_t size) {
+    qol_arena* a = (qol_arena*)ctx;
+    _qol_arena_block* c = a->cur;
+    size = _QOL_ALIGN(size);
+    if (c && (unsigned char*)ptr + size == c->data + c->used) c->used -= size;
+}
+
+static inline void arena_init(qol_arena* a, size_t block_size) {
+    a->head = a->cur = NULL;
+    a->block_size = block_size ? block_size : 65536;
+    a->al.alloc = _qol_arena_alloc;
+    a->al.resize = _qol_arena_resize;
+    a->al.release = _qol_arena_release;
+    a->al.ctx = a;
+}
+
+// Drops every allocation at once, e.g. at the end of a request. Blocks are kept.
+static inline void arena_reset(qol_arena* a) {
+    if (a->head) a->head->used = 0;
+    a->cur = a->head;
+}
+
+// Bytes handed out since the last reset, including alignment padding.
+static inline size_t arena_used(const qol_arena* a) {
+    size_t n = 0;
+    for (_qol_arena_block* b = a->head; b; b = b->next) {
+        n += b->used;
+        if (b == a->cur) break;
+    }
+    return n;
+}
+
+static inline void arena_free(qol_arena* a) {
+    _qol_arena_block* b = a->head;
+    while (b) { _qol_arena_block* n = b->next; _QOL_SYS_FREE(b); b = n; }
+    a->head = a->cur = NULL;
+}
+
+// --- Object Pool ---
+// Fixed-size objects carved from chunks and recycled through a free list.
+// As a qol_alloc, larger requests fall through to the heap.
+typedef struct _qol_pool_chunk {
+    struct _qol_pool_chunk* next;
+    size_t pad;   // Keeps objects 16-byte aligned.
+} _qol_pool_chunk;
+
+typedef struct {
+    size_t size;        // Object size, rounded up to 16.
+    size_t per_chunk;
+    void* free_list;
+    unsigned char *fresh, *fresh_end;   // Untouched tail of the newest chunk.
+    _qol_pool_chunk* chunks;
+    qol_alloc al;       // Pass &pool.al to qol_alloc_use; the pool must not move.
+} qol_pool;
+
+static inline void* pool_get(qol_pool* p) {
+    void* obj = p->free_list;
+    if (obj) { p->free_list = *(void**)obj; return obj; }
+    if (p->fresh == p->fresh_end) {
+        _qol_pool_chunk* c = (_qol_pool_chunk*)_QOL_SYS_MALLOC(sizeof(_qol_pool_chunk) + p->per_chunk * p->size);
+        if (!c) return NULL;
+        c->next = p->chunks; p->chunks = c;
+        p->fresh = (unsigned char*)(c + 1);
+        p->fresh_end = p->fresh + p->per_chunk * p->size;
+    }
+    obj = p->fresh;
+    p->fresh += p->size;
+    return obj;
+}
+
+static inline void pool_put(qol_pool* p, void* obj) {
+    if (!obj) return;
+    *(void**)obj = p->free_list;
+    p->free_list = obj;
+}
+
+static inline void* _qol_pool_alloc(void* ctx, size_t size) {
+    qol_pool* p = (qol_pool*)ctx;
+    return size <= p->size ? pool_get(p) : _QOL_SYS_MALLOC(size);
+}
+
+static inline void _qol_pool_release(void* ctx, void* ptr, size_t size) {
+    qol_pool* p = (qol_pool*)ctx;
+    if (size <= p->size) pool_put(p, ptr); else _QOL_SYS_FREE(ptr);
+}
+
+static inline void* _qol_pool_resize(void* ctx, void* ptr, size_t old_size, size_t new_size) {
+    qol_pool* p = (qol_pool*)ctx;
+    if (!ptr) return _qol_pool_alloc(ctx, new_size);
+    if (old_size > p->size && new_size > p->size) return _QOL_SYS_REALLOC(ptr, new_size);
+    if (old_size <= p->size && new_size <= p->size) return ptr;
+    void* n = _qol_pool_alloc(ctx, new_size);
+    if (!n) return NULL;
+    memcpy(n, ptr, old_size < new_size ? old_size : new_size);
+    _qol_pool_release(ctx, ptr, old_size);
+    return n;
+}
+
+// per_chunk of 0 picks about 64 KB worth of objects.
+static inline void pool_init(qol_pool* p, size_t object_size, size_t per_chunk) {
+    p->size = _QOL_ALIGN(object_size ? object_size : 1);
+    p->per_chunk = per_chunk ? per_chunk : (65536 / p->size ? 65536 / p->size : 1);
+    p->free_list = NULL;
+    p->fresh = p->fresh_end = NULL;
+    p->chunks = NULL;
+    p->al.alloc = _qol_pool_alloc;
+    p->al.resize = _qol_pool_resize;
+    p->al.release = _qol_pool_release;
+    p->al.ctx = p;
+}
+
+// Frees every chunk; objects still out become invalid.
+static inline void pool_free(qol_pool* p) {
+    _qol_pool_chunk* c = p->chunks;
+    while (c) { _qol_pool_chunk* n = c->next; _QOL_SYS_FREE(c); c = n; }
+    p->chunks = NULL; p->free_list = NULL;
+    p->fresh = p->fresh_end = NULL;
+}
+
+// --- Scoped Allocation ---
+// qol_malloc serves from the calling thread's current allocator (the heap until
+// qol_alloc_use). Each block records its owner, so qol_free and qol_realloc
+// return it there even after the scope has ended. Arenas and pools do not lock:
+// their blocks must be freed on the thread that owns them. The current allocator
+// is per thread and, being static, per translation unit.
+static _TYPES_TLS const qol_alloc* _qol_current;
+
+typedef struct { const qol_alloc* al; size_t size; } _qol_tag;
+#define _QOL_TAG_SIZE _QOL_ALIGN(sizeof(_qol_tag))
+
+// Makes al (NULL for the heap) current on this thread; returns the previous one.
+static inline const qol_alloc* qol_alloc_use(const qol_alloc* al) {
+    const qol_alloc* prev = _qol_current;
+    _qol_current = al;
+    return prev;
+}
+
+static inline void* qol_malloc(size_t size) {
+    const qol_alloc* al = _qol_current;
+    if (size > (size_t)-1 - _QOL_TAG_SIZE) return NULL;
+    _qol_tag* t = (_qol_tag*)(al ? al->alloc(al->ctx, size + _QOL_TAG_SIZE) : malloc(size + _QOL_TAG_SIZE));
+    if (!t) return NULL;
+    t->al = al; t->size = size;
+    return (unsigned char*)t + _QOL_TAG_SIZE;
+}
+
+static inline void qol_free(void* ptr) {
+    if (!ptr) return;
+    _qol_tag* t = (_qol_tag*)(void*)((unsigned char*)ptr - _QOL_TAG_SIZE);
+    if (t->al) t->al->release(t->al->ctx, t, t->size + _QOL_TAG_SIZE);
+    else free(t);
+}
+
+// Stays with the allocator that made ptr, whichever is current now.
+static inline void* qol_realloc(void* ptr, size_t size) {
+    if (!ptr) return qol_malloc(size);
+    if (size > (size_t)-1 - _QOL_TAG_SIZE) return NULL;
+    _qol_tag* t = (_qol_tag*)(void*)((unsigned char*)ptr - _QOL_TAG_SIZE);
+    const qol_alloc* al = t->al;
+    t = (_qol_tag*)(al ? al->resize(al->ctx, t, t->size + _QOL_TAG_SIZE, size + _QOL_TAG_SIZE)
+                       : realloc(t, size + _QOL_TAG_SIZE));
+    if (!t) return NULL;
+    t->size = size;
+    return (unsigned char*)t + _QOL_TAG_SIZE;
+}
+
+// --- Dynamic Big Integers (sbig) ---
+// Unsigned integer whose limb storage grows as needed. Storage comes from an
+// sbig_allocator, so temporaries can be bump-allocated from an sbig_arena.
+typedef qol_alloc sbig_allocator;
+
+typedef struct {
+    u32* limbs;
+    int len;   // Significant limbs; 0 means the value is zero.
+    int cap;
+    const sbig_allocator* al;
+} sbig;
+
+// sbig's names for the shared heap and arena (see Allocators above).
+#define sbig_heap qol_heap
+typedef qol_arena sbig_arena;
+
+static inline void sbig_arena_init(sbig_arena* a, size_t block_size) { arena_init(a, block_size); }
+// Drops every allocation at once; blocks are kept for reuse.
+static inline void sbig_arena_reset(sbig_arena* a) { arena_reset(a); }
+static inline void sbig_arena_free(sbig_arena* a) { arena_free(a); }
+
+// --- sbig Core ---
+static inline void sbig_init(sbig* v, const sbig_allocator* al) {
+    v->limbs = NULL; v->len = 0; v->cap = 0;
+    v->al = al ? al : &sbig_heap;
+}
+
+static inline void sbig_free(sbig* v) {
+    if (v->limbs) v->al->release(v->al->ctx, v->limbs, (size_t)v->cap * sizeof(u32));
+    v->limbs = NULL; v->len = 0; v->cap = 0;
+}
+
+static inline int _sbig_reserve(sbig* v, int n) {
+    if (n <= v->cap) return 1;
+    int cap = v->cap ? v->cap : 4;
+    while (cap < n) cap = cap > INT_MAX / 2 ? n : cap * 2;
+    u32* p = v->limbs
+        ? (u32*)v->al->resize(v->al->ctx, v->limbs, (size_t)v->cap * sizeof(u32), (size_t)cap * sizeof(u32))
+        : (u32*)v->al->alloc(v->al->ctx, (size_t)cap * sizeof(u32));
+    if (!p) return 0;
+    v->limbs = p; v->cap = cap;
+    return 1;
+}
+
+static inline void _sbig_trim(sbig* v) { while (v->len > 0 && v->limbs[v->len - 1] == 0) v->len--; }
+
+// Replaces dst's storage with tmp's. Both must share an allocator.
+static inline void _sbig_adopt(sbig* dst, sbig* tmp) {
+    sbig_free(dst);
+    *dst = *tmp;
+    tmp->limbs = NULL; tmp->len = tmp->cap = 0;
+}
+
+static inline int sbig_is_zero(const sbig* v) { return v->len == 0; }
+
+static inline int sbig_set_u64(sbig* v, u64 x) {
+    if (!_sbig_reserve(v, 2)) return 0;
+    v->limbs[0] = (u32)x; v->limbs[1] = (u32)(x >> 32);
+    v->len = 2; _sbig_trim(v);
+    return 1;
+}
+
+static inline int sbig_copy(sbig* dst, const sbig* src) {
+    if (dst == src) return 1;
+    if (!_sbig_reserve(dst, src->len)) return 0;
+    if (src->len) memcpy(dst->limbs, src->limbs, (size_t)src->len * sizeof(u32));
+    dst->len = src->len;
+    return 1;
+}
+
+static inline int _sbig_cmp_raw(const u32* a, int an, const u32* b, int bn) {
+    if (an != bn) return an < bn ? -1 : 1;
+    for (int i = an - 1; i >= 0; i--)
+        if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+    return 0;
+}
+
+static inline int sbig_cmp(const sbig* a, const sbig* b) { return _sbig_cmp_raw(a->limbs, a->len, b->limbs, b->len); }
+
+// --- sbig Arithmetic ---
+// All functions allow res to alias an operand and return 1 on success, 0 on allocation failure.
+static inline int sbig_add(sbig* res, const sbig* a, const sbig* b) {
+    int n = a->len > b->len ? a->len : b->len;
+    if (!_sbig_reserve(res, n + 1)) return 0;
+    u64 carry = 0;
+    for (int i = 0; i < n; i++) {
+        u64 sum = (u64)(i < a->len ? a->limbs[i] : 0) + (i < b->len ? b->limbs[i] : 0) + carry;
+        res->limbs[i] = (u32)sum;
+        carry = sum >> 32;
+    }
+    res->limbs[n] = (u32)carry;
+    res->len = n + 1; _sbig_trim(res);
+    return 1;
+}
+
+// res = |a - b|. Returns 0 normally, 1 if b > a (borrow), -1 on allocation failure.
+static inline int sbig_sub(sbig* res, const sbig* a, const sbig* b) {
+    int borrowed = 0;
+    if (sbig_cmp(a, b) < 0) { const sbig* t = a; a = b; b = t; borrowed = 1; }
+    if (!_sbig_reserve(res, a->len)) return -1;
+    u64 borrow = 0;
+    for (int i = 0; i < a->len; i++) {
+        u64 sub = (u64)a->limbs[i] - (i < b->len ? b->limbs[i] : 0) - borrow;
+        res->limbs[i] = (u32)sub;
+        borrow = (sub >> 63) & 1;
+    }
+    res->len = a->len; _sbig_trim(res);
+    return borrowed;
+}
+
+// out[0 .. an+bn) = a * b. out must be zeroed and must not overlap a or b.
+static inline void _sbig_mul_raw(u32* out, const u32* a, int an, const u32* b, int bn) {
+    for (int i = 0; i < an; i++) {
+        if (a[i] == 0) continue;
+        u64 carry = 0;
+        for (int j = 0; j < bn; j++) {
+            u64 cur = out[i + j] + (u64)a[i] * b[j] + carry;
+            out[i + j] = (u32)cur;
+            carry = cur >> 32;
+        }
+        out[i + bn] = (u32)carry;
+    }
+}
+
+// --- Parallel Helper ---
+// Splits [0, n) across sbig_set_threads() workers when built with -DSBIG_THREADS.
+typedef void (*_sbig_range_fn)(void* ctx, int lo, int hi);
+
+#ifdef SBIG_THREADS
+static int _sbig_threads = 1;
+static inline void sbig_set_threads(int n) { _sbig_threads = n < 1 ? 1 : (n > 64 ? 64 : n); }
+
+typedef struct { _sbig_range_fn fn; void* ctx; int lo, hi; } _sbig_job;
+
+#ifdef _WIN32
+static DWORD WINAPI _sbig_job_entry(LPVOID p) {
+#else
+static void* _sbig_job_entry(void* p) {
+#endif
+    _sbig_job* j = (_sbig_job*)p;
+    j->fn(j->ctx, j->lo, j->hi);
+    return 0;
+}
+#endif
+
+// Only ranges of at least min_n items are split. A worker that cannot be
+// started has its chunk run on the calling thread instead.
+static inline void _sbig_parallel_for(_sbig_range_fn fn, void* ctx, int n, int min_n) {
+#ifdef SBIG_THREADS
+    int t = _sbig_threads;
+    if (t > 1 && n >= min_n) {
+        _sbig_job jobs[64];
+        int started[64] = {0};
+    #ifdef _WIN32
+        HANDLE th[64];
+    #else
+        pthread_t th[64];
+    #endif
+        int chunk = (n + t - 1) / t, spawned = 0;
+        for (int i = 1; i < t && i * chunk < n; i++, spawned++) {
+            jobs[i].fn = fn; jobs[i].ctx = ctx;
+            jobs[i].lo = i * chunk; jobs[i].hi = (i + 1) * chunk < n ? (i + 1) * chunk : n;
+    #ifdef _WIN32
+            started[i] = (th[i] = CreateThread(NULL, 0, _sbig_job_entry, &jobs[i], 0, NULL)) != NULL;
+    #else
+            started[i] = pthread_create(&th[i], NULL, _sbig_job_entry, &jobs[i]) == 0;
+    #endif
+            if (!started[i]) fn(ctx, jobs[i].lo, jobs[i].hi);
+        }
+        fn(ctx, 0, chunk < n ? chunk : n);
+        for (int i = 1; i <= spawned; i++) {
+            if (!started[i]) continue;
+    #ifdef _WIN32
+            WaitForSingleObject(th[i], INFINITE); CloseHandle(th[i]);
+    #else
+            pthread_join(th[i], NULL);
+    #endif
+        }
+        return;
+    }
+#endif
+    (void)min_n;
+    fn(ctx, 0, n);
+}
+
+// Power-of-two number of slices a transform of length n is cut into: one per
+// worker, or 1 when it is too small to be worth threads.
+static inline int _sbig_slices(int n) {
+    int p = 1;
+#ifdef SBIG_THREADS
+    if (n >= 8192) while (p * 2 <= _sbig_threads && p * 2 <= n / 2) p *= 2;
+#else
+    (void)n;
+#endif
+    return p;
+}
+
+// --- Number-Theoretic Transform ---
+// Three NTT-friendly primes; their product (~2^86) bounds each convolution
+// coefficient (min(an, bn) * 2^64), so 32-bit limbs are transformed directly.
+#ifndef SBIG_KARATSUBA_CUTOFF
+#define SBIG_KARATSUBA_CUTOFF 48
+#endif
+#if SBIG_KARATSUBA_CUTOFF < 4
+    #error "SBIG_KARATSUBA_CUTOFF must be at least 4: Karatsuba recurses on (n + 1) / 2 + 1 limbs"
+#endif
+#ifndef SBIG_NTT_CUTOFF
+#define SBIG_NTT_CUTOFF 3072
+#endif
+#define _NTT_P1 998244353u
+#define _NTT_P2 167772161u
+#define _NTT_P3 469762049u
+#define _NTT_MAX_LEN (1 << 22)
+
+static inline u32 _ntt_pow(u64 b, u64 e, u32 p) {
+    u64 r = 1; b %= p;
+    while (e) { if (e & 1) r = r * b % p; b = b * b % p; e >>= 1; }
+    return (u32)r;
+}
+
+static inline void _ntt_bitrev(u32* a, int n) {
+    for (int i = 1, j = 0; i < n; i++) {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) { u32 t = a[i]; a[i] = a[j]; a[j] = t; }
+    }
+}
+
+typedef struct { u32* a; u32* b; const u32* w; int half; } _ntt_ctx;
+
+// Per-prime kernels so every "% P" is by a compile-time constant.
+#define DEF_NTT(ID, P, G) \
+    /* w[half + j] = (primitive 2*half-th root)^j for every level. */ \
+    static inline void _ntt_roots_##ID(u32* w, int n) { \
+        for (int half = 1; half < n; half <<= 1) { \
+            u64 step = _ntt_pow(G, (P - 1) / (2 * (u64)half), P), cur = 1; \
+            for (int j = 0; j < half; j++) { w[half + j] = (u32)cur; cur = cur * step % P; } \
+        } \
+    } \
+    static inline void _ntt_level_##ID(void* c, int lo, int hi) { \
+        _ntt_ctx* x = (_ntt_ctx*)c; \
+        u32* a = x->a; const u32* w = x->w + x->half; int half = x->half; \
+        int blk = lo / half, j = lo % half; \
+        for (int k = lo; k < hi; k++) { \
+            int i = blk * 2 * half + j; \
+            u32 u = a[i], v = (u32)((u64)a[i + half] * w[j] % P); \
+            a[i] = u + v >= P ? u + v - P : u + v; \
+            a[i + half] = u >= v ? u - v : u + P - v; \
+            if (++j == half) { j = 0; blk++; } \
+        } \
+    } \
+    /* Every level whose butterflies stay inside one slice of x->half elements. */ \
+    static inline void _ntt_slices_##ID(void* c, int lo, int hi) { \
+        _ntt_ctx* x = (_ntt_ctx*)c; \
+        for (int s = lo; s < hi; s++) { \
+            for (int half = 1; half < x->half; half <<= 1) { \
+                _ntt_ctx y = { x->a + (size_t)s * x->half, NULL, x->w, half }; \
+                _ntt_level_##ID(&y, 0, x->half / 2); \
+            } \
+        } \
+    } \
+    static inline void _ntt_pointwise_##ID(void* c, int lo, int hi) { \
+        _ntt_ctx* x = (_ntt_ctx*)c; \
+        for (int i = lo; i < hi; i++) x->a[i] = (u32)((u64)x->a[i] * x->b[i] % P); \
+    } \
+    static inline void _ntt_##ID(u32* a, const u32* w, int n, int invert) { \
+        /* One parallel pass for the levels local to a slice, then one per level above. */ \
+        int slices = _sbig_slices(n); \
+        _ntt_ctx local = { a, NULL, w, n / slices }; \
+        _ntt_bitrev(a, n); \
+        _sbig_parallel_for(_ntt_slices_##ID, &local, slices, 2); \
+        for (int half = n / slices; half < n; half <<= 1) { \
+            _ntt_ctx x = { a, NULL, w, half }; \
+            _sbig_parallel_for(_ntt_level_##ID, &x, n / 2, 8192); \
+        } \
+        if (invert) { \
+            /* Inverse = forward transform with indices 1..n-1 reversed, scaled by 1/n. */ \
+            for (int i = 1, j = n - 1; i < j; i++, j--) { u32 t = a[i]; a[i] = a[j]; a[j] = t; } \
+            u64 ninv = _ntt_pow((u64)n, P - 2, P); \
+            for (int i = 0; i < n; i++) a[i] = (u32)(a[i] * ninv % P); \
+        } \
+    } \
+    /* fa = (a * b) mod P as a cyclic convolution of length n. fb and w are scratch. */ \
+    static inline void _ntt_conv_##ID(u32* fa, u32* fb, u32* w, const u32* a, int an, const u32* b, int bn, int n) { \
+        for (int i = 0; i < n; i++) fa[i] = i < an ? a[i] % P : 0; \
+        for (int i = 0; i < n; i++) fb[i] = i < bn ? b[i] % P : 0; \
+        _ntt_roots_##ID(w, n); \
+        _ntt_##ID(fa, w, n, 0); \
+        _ntt_##ID(fb, w, n, 0); \
+        _ntt_ctx x = { fa, fb, w, 0 }; \
+        _sbig_parallel_for(_ntt_pointwise_##ID, &x, n, 8192); \
+        _ntt_##ID(fa, w, n, 1); \
+    }
+
+DEF_NTT(1, _NTT_P1, 3)
+DEF_NTT(2, _NTT_P2, 3)
+DEF_NTT(3, _NTT_P3, 3)
+
+// out[0 .. an+bn) = a * b via three-prime NTT and Garner CRT.
+// Returns 0 (out untouched) if the operands exceed the transform limits or memory runs out.
+static inline int _sbig_mul_ntt(u32* out, const u32* a, int an, const u32* b, int bn, const sbig_allocator* al) {
+    int need = an + bn, n = 1;
+    while (n < need) n <<= 1;
+    if (n > _NTT_MAX_LEN || (an < bn ? an : bn) > _NTT_MAX_LEN / 2) return 0;
+    size_t bytes = (size_t)n * 5 * sizeof(u32);
+    u32* buf = (u32*)al->alloc(al->ctx, bytes);
+    if (!buf) return 0;
+    u32 *r1 = buf, *r2 = buf + n, *r3 = buf + 2 * (size_t)n, *fb = buf + 3 * (size_t)n, *w = buf + 4 * (size_t)n;
+    _ntt_conv_1(r1, fb, w, a, an, b, bn, n);
+    _ntt_conv_2(r2, fb, w, a, an, b, bn, n);
+    _ntt_conv_3(r3, fb, w, a, an, b, bn, n);
+
+    const u64 p1 = _NTT_P1, p2 = _NTT_P2, p3 = _NTT_P3, p12 = p1 * p2;
+    const u64 inv_p1 = _ntt_pow(p1, p2 - 2, _NTT_P2);
+    const u64 inv_p12 = _ntt_pow(p12 % p3, p3 - 2, _NTT_P3);
+    u64 carry = 0;
+    for (int i = 0; i < need; i++) {
+        // Garner: x = r1 + p1*t2 + p1*p2*t3, assembled as three 32-bit words.
+        u64 t2 = (r2[i] + p2 - r1[i] % p2) % p2 * inv_p1 % p2;
+        u64 lo = r1[i] + p1 * t2;
+        u64 t3 = (r3[i] + p3 - lo % p3) % p3 * inv_p12 % p3;
+        u64 b_lo = (p12 & 0xFFFFFFFFu) * t3, b_hi = (p12 >> 32) * t3;
+        u64 s0 = (lo & 0xFFFFFFFFu) + (b_lo & 0xFFFFFFFFu);
+        u64 s1 = (lo >> 32) + (b_lo >> 32) + (b_hi & 0xFFFFFFFFu) + (s0 >> 32);
+        u64 w2 = (b_hi >> 32) + (s1 >> 32);
+        u64 sum = (s0 & 0xFFFFFFFFu) + (carry & 0xFFFFFFFFu);
+        out[i] = (u32)sum;
+        carry = (carry >> 32) + (sum >> 32) + (s1 & 0xFFFFFFFFu) + (w2 << 32);
+    }
+    al->release(al->ctx, buf, bytes);
+    return 1;
+}
+
+// --- Karatsuba ---
+#define _SBIG_KARA_SCRATCH(n) (4 * (size_t)(n) + 512)
+
+// out[0 .. 2n) = a * b for equal-length operands.
+static inline void _sbig_mul_karatsuba(u32* out, const u32* a, const u32* b, int n, u32* scratch) {
+    if (n < SBIG_KARATSUBA_CUTOFF) {
+        memset(out, 0, 2 * (size_t)n * sizeof(u32));
+        _sbig_mul_raw(out, a, n, b, n);
+        return;
+    }
+    int l = (n + 1) / 2, h = n - l;
+    u32 *sa = scratch, *sb = sa + l + 1, *z1 = sb + l + 1, *next = z1 + 2 * (l + 1);
+    _sbig_mul_karatsuba(out, a, b, l, next);                 // z0 = a0*b0
+    _sbig_mul_karatsuba(out + 2 * l, a + l, b + l, h, next); // z2 = a1*b1
+    u64 ca = 0, cb = 0;
+    for (int i = 0; i < l; i++) {
+        ca += (u64)a[i] + (i < h ? a[l + i] : 0); sa[i] = (u32)ca; ca >>= 32;
+        cb += (u64)b[i] + (i < h ? b[l + i] : 0); sb[i] = (u32)cb; cb >>= 32;
+    }
+    sa[l] = (u32)ca; sb[l] = (u32)cb;
+    _sbig_mul_karatsuba(z1, sa, sb, l + 1, next);            // (a0+a1)(b0+b1)
+    // z1 -= z0 + z2
+    s64 br = 0;
+    for (int i = 0; i < 2 * (l + 1); i++) {
+        s64 t = (s64)z1[i] - (i < 2 * l ? out[i] : 0) - (i < 2 * h ? out[2 * l + i] : 0) + br;
+        z1[i] = (u32)t;
+        br = t >> 32;
+    }
+    // out += z1 << (32 * l); the middle term always fits below 2n limbs.
+    u64 c = 0;
+    int zn = 2 * (l + 1) < 2 * n - l ? 2 * (l + 1) : 2 * n - l;
+    for (int i = 0; i < zn || (c && l + i < 2 * n); i++) {
+        c += (u64)out[l + i] + (i < zn ? z1[i] : 0);
+        out[l + i] = (u32)c;
+        c >>= 32;
+    }
+}
+
+// out[0 .. an+bn) = a * b, picking schoolbook, Karatsuba or NTT from operand size.
+// out must be zeroed and must not overlap a or b.
+static inline void _sbig_mul_any(u32* out, const u32* a, int an, const u32* b, int bn, const sbig_allocator* al) {
+    if (an < bn) { const u32* t = a; a = b; b = t; int tn = an; an = bn; bn = tn; }
+    if (bn < SBIG_KARATSUBA_CUTOFF) { _sbig_mul_raw(out, a, an, b, bn); return; }
+    if (bn >= SBIG_NTT_CUTOFF && _sbig_mul_ntt(out, a, an, b, bn, al)) return;
+    size_t bytes = (_SBIG_KARA_SCRATCH(bn) + 2 * (size_t)bn) * sizeof(u32);
+    u32* scratch = (u32*)al->alloc(al->ctx, bytes);
+    if (!scratch) { _sbig_mul_raw(out, a, an, b, bn); return; }
+    u32* prod = scratch + _SBIG_KARA_SCRATCH(bn);
+    // Unbalanced operands: multiply bn-sized slices of a and accumulate.
+    for (int off = 0; off < an; off += bn) {
+        int len = an - off < bn ? an - off : bn;
+        if (len == bn) _sbig_mul_karatsuba(prod, a + off, b, bn, scratch);
+        else { memset(prod, 0, (size_t)(len + bn) * sizeof(u32)); _sbig_mul_any(prod, b, bn, a + off, len, al); }
+        u64 c = 0;
+        for (int i = 0; i < len + bn || (c && off + i < an + bn); i++) {
+            c += (u64)out[off + i] + (i < len + bn ? prod[i] : 0);
+            out[off + i] = (u32)c;
+            c >>= 32;
+        }
+    }
+    al->release(al->ctx, scratch, bytes);
+}
+
+static inline int sbig_mul(sbig* res, const sbig* a, const sbig* b) {
+    if (a->len == 0 || b->len == 0) { res->len = 0; return 1; }
+    if (a->len < 0 || b->len < 0 || (size_t)a->len + (size_t)b->len > (size_t)INT_MAX) return 0;
+    sbig tmp; sbig_init(&tmp, res->al);
+    if (!_sbig_reserve(&tmp, a->len + b->len)) return 0;
+    memset(tmp.limbs, 0, ((size_t)a->len + (size_t)b->len) * sizeof(u32));
+    _sbig_mul_any(tmp.limbs, a->limbs, a->len, b->limbs, b->len, res->al);
+    tmp.len = a->len + b->len; _sbig_trim(&tmp);
+    _sbig_adopt(res, &tmp);
+    return 1;
+}
+
+// Knuth Algorithm D on raw limbs: q[an - n + 1] = a / b, r[n] = a % b.
+// Needs an >= n >= 2 and b[n - 1] != 0; un[an + 1] and vn[n] are scratch. q may be NULL.
+static inline void _sbig_divmod_raw(u32* q, u32* r, const u32* a, int an, const u32* b, int n, u32* un, u32* vn) {
+    int m = an - n;
+    // Normalize so the divisor's top bit is set.
+    int s = __builtin_clz(b[n - 1]);
+    for (int i = n - 1; i > 0; i--)
+        vn[i] = (b[i] << s) | (s ? b[i - 1] >> (32 - s) : 0);
+    vn[0] = b[0] << s;
+    un[an] = s ? a[an - 1] >> (32 - s) : 0;
+    for (int i = an - 1; i > 0; i--)
+        un[i] = (a[i] << s) | (s ? a[i - 1] >> (32 - s) : 0);
+    un[0] = a[0] << s;
+
+    for (int j = m; j >= 0; j--) {
+        u64 num = ((u64)un[j + n] << 32) | un[j + n - 1];
+        u64 qhat = num / vn[n - 1], rhat = num % vn[n - 1];
+        while (qhat >> 32 || qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2])) {
+            qhat--; rhat += vn[n - 1];
+            if (rhat >> 32) break;
+        }
+        // Multiply and subtract.
+        s64 k = 0, t;
+        for (int i = 0; i < n; i++) {
+            u64 p = qhat * vn[i];
+            t = (s64)un[i + j] - k - (s64)(p & 0xFFFFFFFFu);
+            un[i + j] = (u32)t;
+            k = (s64)(p >> 32) - (t >> 32);
+        }
+        t = (s64)un[j + n] - k;
+        un[j + n] = (u32)t;
+        // Add back when qhat was one too large.
+        if (t < 0) {
+            qhat--;
+            u64 c = 0;
+            for (int i = 0; i < n; i++) {
+                u64 sum = (u64)un[i + j] + vn[i] + c;
+                un[i + j] = (u32)sum;
+                c = sum >> 32;
+            }
+            un[j + n] += (u32)c;
+        }
+        if (q) q[j] = (u32)qhat;
+    }
+    for (int i = 0; i < n; i++)
+        r[i] = (un[i] >> s) | (s ? un[i + 1] << (32 - s) : 0);
+}
+
+// q = a / b, r = a % b (Knuth Algorithm D). Either output may be NULL.
+// Returns 0 on division by zero or allocation failure.
+static inline int sbig_divmod(sbig* q, sbig* r, const sbig* a, const sbig* b) {
+    if (b->len == 0) return 0;
+    const sbig_allocator* al = q ? q->al : (r ? r->al : a->al);
+    sbig qt, rt; sbig_init(&qt, q ? q->al : al); sbig_init(&rt, r ? r->al : al);
+    int n = b->len, m = a->len - b->len, ok = 0;
+
+    if (m < 0) {
+        if (!sbig_copy(&rt, a)) goto done;
+    } else if (n == 1) {
+        if (!_sbig_reserve(&qt, a->len) || !_sbig_reserve(&rt, 1)) goto done;
+        u64 rem = 0, d = b->limbs[0];
+        for (int i = a->len - 1; i >= 0; i--) {
+            u64 cur = (rem << 32) | a->limbs[i];
+            qt.limbs[i] = (u32)(cur / d);
+            rem = cur % d;
+        }
+        qt.len = a->len; _sbig_trim(&qt);
+        rt.limbs[0] = (u32)rem; rt.len = 1; _sbig_trim(&rt);
+    } else {
+        size_t un_bytes = (size_t)(a->len + 1) * sizeof(u32), vn_bytes = (size_t)n * sizeof(u32);
+        u32* un = (u32*)al->alloc(al->ctx, un_bytes);
+        u32* vn = un ? (u32*)al->alloc(al->ctx, vn_bytes) : NULL;
+        if (!vn || !_sbig_reserve(&qt, m + 1) || !_sbig_reserve(&rt, n)) {
+            if (vn) al->release(al->ctx, vn, vn_bytes);
+            if (un) al->release(al->ctx, un, un_bytes);
+            goto done;
+        }
+        _sbig_divmod_raw(qt.limbs, rt.limbs, a->limbs, a->len, b->limbs, n, un, vn);
+        qt.len = m + 1; _sbig_trim(&qt);
+        rt.len = n; _sbig_trim(&rt);
+        al->release(al->ctx, vn, vn_bytes);
+        al->release(al->ctx, un, un_bytes);
+    }
+    ok = 1;
+    if (r) _sbig_adopt(r, &rt);
+    if (q) _sbig_adopt(q, &qt);
+done:
+    sbig_free(&qt); sbig_free(&rt);
+    return ok;
+}
+
+// res = base ^ exp by square-and-multiply.
+static inline int sbig_pow(sbig* res, const sbig* base, u64 exp) {
+    sbig acc, sq; sbig_init(&acc, res->al); sbig_init(&sq, res->al);
+    int ok = sbig_set_u64(&acc, 1) && sbig_copy(&sq, base);
+    while (ok && exp) {
+        if (exp & 1) ok = sbig_mul(&acc, &acc, &sq);
+        exp >>= 1;
+        if (ok && exp) ok = sbig_mul(&sq, &sq, &sq);
+    }
+    if (ok) _sbig_adopt(res, &acc);
+    sbig_free(&sq); sbig_free(&acc);
+    return ok;
+}
+
+// --- sbig Printing ---
+// Returns QOL_MALLOC'd plain decimal digits. Caller must QOL_FREE.
+static inline char* sbig_to_dec(const sbig* v) {
+    int n = v->len;
+    u32* t = (u32*)QOL_MALLOC((size_t)(n ? n : 1) * sizeof(u32));
+    // Each limb holds at most 9.64 decimal digits; peel 9 at a time.
+    char* out = (char*)QOL_MALLOC((size_t)n * 10 + 2);
+    if (!t || !out) { QOL_FREE(t); QOL_FREE(out); return NULL; }
+    if (n) memcpy(t, v->limbs, (size_t)n * sizeof(u32));
+    int pos = 0;
+    while (n > 0) {
+        u64 rem = 0;
+        for (int i = n - 1; i >= 0; i--) {
+            u64 cur = (rem << 32) | t[i];
+            t[i] = (u32)(cur / 1000000000u);
+            rem = cur % 1000000000u;
+        }
+        while (n > 0 && t[n - 1] == 0) n--;
+        for (int d = 0; d < 9 && (n > 0 || rem); d++) { out[pos++] = (char)('0' + rem % 10); rem /= 10; }
+    }
+    if (pos == 0) out[pos++] = '0';
+    for (int i = 0; i < pos / 2; i++) { char c = out[i]; out[i] = out[pos - 1 - i]; out[pos - 1 - i] = c; }
+    out[pos] = '\0';
+    QOL_FREE(t);
+    return out;
+}
+
+static inline void _nf_big(sbig v) {
+    if (v.len == 0) { printf("0x0"); return; }
+    _internal_raw_hex(v.limbs, v.len);
+}
+
+static inline void _f_big(sbig v) {
+    char* d = sbig_to_dec(&v);
+    if (!d) return;
+    int len = (int)strlen(d);
+    for (int i = 0; i < len; i++) {
+        putchar(d[i]);
+        if ((len - 1 - i) % 3 == 0 && i != len - 1) putchar(',');
+    }
+    QOL_FREE(d);
+}
+
+static inline void sbig_print(const sbig* v) { _f_big(*v); }
+
+// --- Fixed-Width Conversions ---
+#define DEF_BIG_CONV(BITS, COUNT) \
+    static inline int sbig_from_suint##BITS(sbig *res, suint##BITS v) { \
+        if (!_sbig_reserve(res, COUNT)) return 0; \
+        memcpy(res->limbs, v.limbs, sizeof(v.limbs)); \
+        res->len = COUNT; _sbig_trim(res); \
+        return 1; \
+    } \
+    /* Returns 1 if the value fit, 0 if it was truncated to BITS. */ \
+    static inline int sbig_to_suint##BITS(suint##BITS *res, const sbig *v) { \
+        int n = v->len < COUNT ? v->len : COUNT; \
+        memset(res->limbs, 0, sizeof(res->limbs)); \
+        if (n) memcpy(res->limbs, v->limbs, (size_t)n * sizeof(u32)); \
+        return v->len <= COUNT; \
+    }
+
+DEF_BIG_CONV(32, 1)    DEF_BIG_CONV(64, 2)    DEF_BIG_CONV(128, 4)
+DEF_BIG_CONV(256, 8)   DEF_BIG_CONV(512, 16)  DEF_BIG_CONV(1024, 32)
+DEF_BIG_CONV(2048, 64) DEF_BIG_CONV(4096, 128) DEF_BIG_CONV(8192, 256)
+DEF_BIG_CONV(12288, 384)
+
+// --- Widening Multiplication ---
+// res = a * b without truncation (2 * BITS result bits).
+#define DEF_MUL_FULL(BITS, COUNT) \
+    static inline int suint##BITS##_mul_full(sbig *res, suint##BITS a, suint##BITS b) { \
+        sbig x = { a.limbs, COUNT, COUNT, res->al }, y = { b.limbs, COUNT, COUNT, res->al }; \
+        _sbig_trim(&x); _sbig_trim(&y); \
+        return sbig_mul(res, &x, &y); \
+    }
+
+DEF_MUL_FULL(32, 1)    DEF_MUL_FULL(64, 2)    DEF_MUL_FULL(128, 4)
+DEF_MUL_FULL(256, 8)   DEF_MUL_FULL(512, 16)  DEF_MUL_FULL(1024, 32)
+DEF_MUL_FULL(2048, 64) DEF_MUL_FULL(4096, 128) DEF_MUL_FULL(8192, 256)
+DEF_MUL_FULL(12288, 384)
+
+// --- Batch Arithmetic (Struct-of-Arrays) ---
+// limb[k][i] is limb k of element i, so each limb row is a contiguous vector.
+// Kernels pick AVX-512, AVX2 or scalar code at runtime; carries out of the
+// top limb are dropped (results wrap mod 2^BITS, like suintBITS_mul).
+
+// 0 = scalar, 1 = AVX2, 2 = AVX-512.
+static int _types_simd = -1;
+
+static inline int types_simd_level() {
+    if (_types_simd < 0) {
+        _types_simd = 0;
+#ifdef _TYPES_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) _types_simd = 1;
+        if (__builtin_cpu_supports("avx512f")) _types_simd = 2;
+#endif
+    }
+    return _types_simd;
+}
+
+// Caps the dispatch level (e.g. 0 to force the scalar kernels).
+static inline void types_simd_limit(int level) {
+    int hw = (_types_simd = -1, types_simd_level());
+    _types_simd = level < hw ? level : hw;
+}
+
+#define DEF_BATCH(BITS, COUNT) \
+    typedef struct { u32* limb[COUNT]; size_t n; } suint##BITS##_soa; \
+    \
+    static inline int suint##BITS##_soa_alloc(suint##BITS##_soa *s, size_t n) { \
+        u32* base = (u32*)QOL_CALLOC(n ? n * COUNT : 1, sizeof(u32)); \
+        if (!base) return 0; \
+        for (int k = 0; k < COUNT; k++) s->limb[k] = base + (size_t)k * n; \
+        s->n = n; \
+        return 1; \
+    } \
+    static inline void suint##BITS##_soa_free(suint##BITS##_soa *s) { QOL_FREE(s->limb[0]); memset(s, 0, sizeof(*s)); } \
+    static inline void suint##BITS##_soa_set(suint##BITS##_soa *s, size_t i, suint##BITS v) { \
+        for (int k = 0; k < COUNT; k++) s->limb[k][i] = v.limbs[k]; \
+    } \
+    static inline suint##BITS suint##BITS##_soa_get(const suint##BITS##_soa *s, size_t i) { \
+        suint##BITS v; \
+        for (int k = 0; k < COUNT; k++) v.limbs[k] = s->limb[k][i]; \
+        return v; \
+    } \
+    \
+    /* Row-by-row over 64-element blocks so each limb row streams contiguously. */ \
+    static inline void _suint##BITS##_add_many_scalar(suint##BITS##_soa *out, const suint##BITS##_soa *a, const suint##BITS##_soa *b, size_t lo, size_t n) { \
+        u32 carry[64]; \
+        for (size_t i = lo; i < n; i += 64) { \
+            size_t m = n - i < 64 ? n - i : 64; \
+            memset(carry, 0, sizeof(carry)); \
+            for (int k = 0; k < COUNT; k++) { \
+                const u32 *x = a->limb[k] + i, *y = b->limb[k] + i; \
+                u32 *o = out->limb[k] + i; \
+                for (size_t j = 0; j < m; j++) { \
+                    u64 sum = (u64)x[j] + y[j] + carry[j]; \
+                    o[j] = (u32)sum; \
+                    carry[j] = (u32)(sum >> 32); \
+                } \
+            } \
+        } \
+    } \
+    static inline void _suint##BITS##_cmp_many_scalar(int *out, const suint##BITS##_soa *a, const suint##BITS##_soa *b, size_t lo, size_t n) { \
+        out += lo; \
+        for (size_t i = lo; i < n; i++, out++) { \
+            int k = COUNT - 1; \
+            while (k > 0 && a->limb[k][i] == b->limb[k][i]) k--; \
+            *out = (a->limb[k][i] > b->limb[k][i]) - (a->limb[k][i] < b->limb[k][i]); \
+        } \
+    } \
+    static inline void _suint##BITS##_mul_many_scalar(suint##BITS##_soa *out, const suint##BITS##_soa *a, const suint##BITS##_soa *b, size_t lo, size_t n) { \
+        for (size_t i = lo; i < n; i++) { \
+            u32 r[COUNT] = {0}, bl[COUNT]; \
+            for (int k = 0; k < COUNT; k++) bl[k] = b->limb[k][i]; \
+            for (int x = 0; x < COUNT; x++) { \
+                u64 carry = 0, ax = a->limb[x][i]; \
+                for (int y = 0; x + y < COUNT; y++) { \
+                    u64 cur = r[x + y] + ax * bl[y] + carry; \
+                    r[x + y] = (u32)cur; \
+                    carry = cur >> 32; \
+                } \
+            } \
+            for (int k = 0; k < COUNT; k++) out->limb[k][i] = r[k]; \
+        } \
+    }
+
+#ifdef _TYPES_X86_SIMD
+#define DEF_BATCH_SIMD(BITS, COUNT) \
+    __attribute__((target("avx2"))) \
+    static void _suint##BITS##_add_many_avx2(suint##BITS##_soa *out, const suint##BITS##_soa *a, const suint##BITS##_soa *b, size_t n) { \
+        const __m256i sign = _mm256_set1_epi32((int)0x80000000); \
+        size_t i = 0; \
+        for (; i + 8 <= n; i += 8) { \
+            __m256i carry = _mm256_setzero_si256(); /* 0 or all-ones per lane */ \
+            for (int k = 0; k < COUNT; k++) { \
+                __m256i x = _mm256_loadu_si256((const __m256i*)(a->limb[k] + i)); \
+                __m256i y = _mm256_loadu_si256((const __m256i*)(b->limb[k] + i)); \
+                __m256i s = _mm256_add_epi32(x, y); \
+                __m256i s2 = _mm256_sub_epi32(s, carry); \
+                __m256i c1 = _mm256_cmpgt_epi32(_mm256_xor_si256(x, sign), _mm256_xor_si256(s, sign)); \
+                __m256i c2 = _mm256_cmpgt_epi32(_mm256_xor_si256(s, sign), _mm256_xor_si256(s2, sign)); \
+                carry = _mm256_or_si256(c1, c2); \
+                _mm256_storeu_si256((__m256i*)(out->limb[k] + i), s2); \
+            } \
+        } \
+        _suint##BITS##_add_many_scalar(out, a, b, i, n); \
+    } \
+    __attribute__((target("avx2"))) \
+    static void _suint##BITS##_cmp_many_avx2(int *out, const suint##BITS##_soa *a, const suint##BITS##_soa *b, size_t n) { \
+        const __m256i sign = _mm256_set1_epi32((int)0x80000000); \
+        size_t i = 0; \
+        for (; i + 8 <= n; i += 8) { \
+            __m256i res = _mm256_setzero_si256(); \
+            for (int k = COUNT - 1; k >= 0; k--) { \
+                __m256i x = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(a->limb[k] + i)), sign); \
+                __m256i y = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(b->limb[k] + i)), sign); \
+                __m256i v = _mm256_sub_epi32(_mm256_cmpgt_epi32(y, x), _mm256_cmpgt_epi32(x, y)); \
+                __m256i open = _mm256_cmpeq_epi32(res, _mm256_setzero_si256()); \
+                res = _mm256_or_si256(res, _mm256_and_si256(open, v)); \
+                if (!_mm256_movemask_epi8(_mm256_cmpeq_epi32(res, _mm256_setzero_si256()))) break; \
+            } \
+            _mm256_storeu_si256((__m256i*)(out + i), res); \
+        } \
+        _suint##BITS##_cmp_many_scalar(out, a, b, i, n); \
+    } \
+    /* 4 elements per pass in 64-bit lanes; column sums keep low and high product halves apart. */ \
+    __attribute__((target("avx2"))) \
+    static void _suint##BITS##_mul_many_avx2(suint##BITS##_soa *out, const suint##BITS##_soa *a, const suint##BITS##_soa *b, size_t n) { \
+        const __m256i lo32 = _mm256_set1_epi64x(0xFFFFFFFF); \
+        const __m256i pack = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6); \
+        size_t i = 0; \
+        for (; i + 4 <= n; i += 4) { \
+            __m256i A[COUNT], B[COUNT], carry = _mm256_setzero_si256(); \
+            for (int k = 0; k < COUNT; k++) { \
+                A[k] = _mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i*)(a->limb[k] + i))); \
+                B[k] = _mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i*)(b->limb[k] + i))); \
+            } \
+            for (int c = 0; c < COUNT; c++) { \
+                __m256i lo = carry, hi = _mm256_setzero_si256(); \
+                for (int j = 0; j <= c; j++) { \
+                    __m256i p = _mm256_mul_epu32(A[j], B[c - j]); \
+                    lo = _mm256_add_epi64(lo, _mm256_and_si256(p, lo32)); \
+                    hi = _mm256_add_epi64(hi, _mm256_srli_epi64(p, 32)); \
+                } \
+                __m256i packed = _mm256_permutevar8x32_epi32(lo, pack); \
+                _mm_storeu_si128((__m128i*)(out->limb[c] + i), _mm256_castsi256_si128(packed)); \
+                carry = _mm256_add_epi64(_mm256_srli_epi64(lo, 32), hi); \
+            } \
+        } \
+        _suint##BITS##_mul_many_scalar(out, a, b, i, n); \
+    } \
+    __attribute__((target("avx512f"))) \
+    static void _suint##BITS##_add_many_avx512(suint##BITS##_soa *out, const suint##BITS##_soa *a, const suint##BITS##_soa *b, size_t n) { \
+        const __m512i one = _mm512_set1_epi32(1); \
+        size_t i = 0; \
+        for (; i + 16 <= n; i += 16) { \
+            __mmask16 carry = 0; \
+            for (int k = 0; k < COUNT; k++) { \
+                __m512i x = _mm512_loadu_si512(a->limb[k] + i); \
+                __m512i s = _mm512_add_epi32(x, _mm512_loadu_si512(b->limb[k] + i)); \
+                __mmask16 c1 = _mm512_cmplt_epu32_mask(s, x); \
+                s = _mm512_mask_add_epi32(s, carry, s, one); \
+                carry = c1 | (carry & _mm512_cmpeq_epi32_mask(s, _mm512_setzero_si512())); \
+                _mm512_storeu_si512(out->limb[k] + i, s); \
+            } \
+        } \
+        _suint##BITS##_add_many_scalar(out, a, b, i, n); \
+    } \
+    __attribute__((target("avx512f"))) \
+    static void _suint##BITS##_cmp_many_avx512(int *out, const suint##BITS##_soa *a, const suint##BITS##_soa *b, size_t n) { \
+        const __m512i one = _mm512_set1_epi32(1), neg = _mm512_set1_epi32(-1); \
+        size_t i = 0; \
+        for (; i + 16 <= n; i += 16) { \
+            __m512i res = _mm512_setzero_si512(); \
+            __mmask16 open = 0xFFFF; \
+            for (int k = COUNT - 1; k >= 0 && open; k--) { \
+                __m512i x = _mm512_loadu_si512(a->limb[k] + i), y = _mm512_loadu_si512(b->limb[k] + i); \
+                __mmask16 lt = _mm512_mask_cmplt_epu32_mask(open, x, y), gt = _mm512_mask_cmpgt_epu32_mask(open, x, y); \
+                res = _mm512_mask_mov_epi32(_mm512_mask_mov_epi32(res, lt, neg), gt, one); \
+                open &= (__mmask16)~(lt | gt); \
+            } \
+            _mm512_storeu_si512(out + i, res); \
+        } \
+        _suint##BITS##_cmp_many_scalar(out, a, b, i, n); \
+    } \
+    __attribute__((target("avx512f"))) \
+    static void _suint##BITS##_mul_many_avx512(suint##BITS##_soa *out, const suint##BITS##_soa *a, const suint##BITS##_soa *b, size_t n) { \
+        const __m512i lo32 = _mm512_set1_epi64(0xFFFFFFFF); \
+        size_t i = 0; \
+        for (; i + 8 <= n; i += 8) { \
+            __m512i A[COUNT], B[COUNT], carry = _mm512_setzero_si512(); \
+            for (int k = 0; k < COUNT; k++) { \
+                A[k] = _mm512_cvtepu32_epi64(_mm256_loadu_si256((const __m256i*)(a->limb[k] + i))); \
+                B[k] = _mm512_cvtepu32_epi64(_mm256_loadu_si256((const __m256i*)(b->limb[k] + i))); \
+            } \
+            for (int c = 0; c < COUNT; c++) { \
+                __m512i lo = carry, hi = _mm512_setzero_si512(); \
+                for (int j = 0; j <= c; j++) { \
+                    __m512i p = _mm512_mul_epu32(A[j], B[c - j]); \
+                    lo = _mm512_add_epi64(lo, _mm512_and_si512(p, lo32)); \
+                    hi = _mm512_add_epi64(hi, _mm512_srli_epi64(p, 32)); \
+                } \
+                _mm256_storeu_si256((__m256i*)(out->limb[c] + i), _mm512_cvtepi64_epi32(lo)); \
+                carry = _mm512_add_epi64(_mm512_srli_epi64(lo, 32), hi); \
+            } \
+        } \
+        _suint##BITS##_mul_many_scalar(out, a, b, i, n); \
+    }
+
+#define _BATCH_CALL(BITS, OP, ...) { \
+        int _lvl = types_simd_level(); \
+        if (_lvl >= 2) _suint##BITS##_##OP##_avx512(__VA_ARGS__, n); \
+        else if (_lvl == 1) _suint##BITS##_##OP##_avx2(__VA_ARGS__, n); \
+        else _suint##BITS##_##OP##_scalar(__VA_ARGS__, 0, n); \
+    }
+#else
+#define DEF_BATCH_SIMD(BITS, COUNT)
+#define _BATCH_CALL(BITS, OP, ...) { _suint##BITS##_##OP##_scalar(__VA_ARGS__, 0, n); }
+#endif
+
+#define DEF_BATCH_API(BITS, COUNT) \
+    /* out[i] = a[i] + b[i] for i < n. out may alias a or b. */ \
+    static inline void suint##BITS##_add_many(suint##BITS##_soa *out, const suint##BITS##_soa *a, const suint##BITS##_soa *b, size_t n) \
+        _BATCH_CALL(BITS, add_many, out, a, b) \
+    /* out[i] = -1, 0 or 1 as a[i] <, ==, > b[i]. */ \
+    static inline void suint##BITS##_cmp_many(int *out, const suint##BITS##_soa *a, const suint##BITS##_soa *b, size_t n) \
+        _BATCH_CALL(BITS, cmp_many, out, a, b) \
+    /* out[i] = a[i] * b[i] (low BITS bits). out may alias a or b. */ \
+    static inline void suint##BITS##_mul_many(suint##BITS##_soa *out, const suint##BITS##_soa *a, const suint##BITS##_soa *b, size_t n) \
+        _BATCH_CALL(BITS, mul_many, out, a, b)
+
+DEF_BATCH(256, 8)   DEF_BATCH_SIMD(256, 8)   DEF_BATCH_API(256, 8)
+DEF_BATCH(512, 16)  DEF_BATCH_SIMD(512, 16)  DEF_BATCH_API(512, 16)
+
+// --- Float Engine ---
+// sfloatBITS = (-1)^sign * mantissa * 2^exponent. Normalized values keep the
+// mantissa's top bit set (zero is all-zero). Results round to nearest, ties
+// to even. The generic helpers below work on a view of n limbs so Newton
+// iterations can run one limb wider than the target type. Working buffers come
+// from a tmp array the DEF_FLOAT wrappers size with a constant COUNT:
+// _SF_TMP(n) limbs for the basic operations, _SF_TMP_WIDE(n) for div and sqrt.
+typedef struct { u32* m; s64 e; int s; int n; } _sf_t;
+
+#define _SF_KARA(n) ((n) < SBIG_KARATSUBA_CUTOFF ? 0 : _SBIG_KARA_SCRATCH(n))
+#define _SF_TMP(n) (6 * (size_t)(n) + 8 + _SF_KARA(n))
+#define _SF_TMP_WIDE(n) (19 * (size_t)(n) + 28 + _SF_KARA((n) + 1))
+
+static inline int _sf_bitlen(const u32* a, int n) {
+    for (int i = n - 1; i >= 0; i--)
+        if (a[i]) return i * 32 + 32 - __builtin_clz(a[i]);
+    return 0;
+}
+
+static inline int _sf_bit(const u32* a, int n, s64 bit) {
+    return (bit >= 0 && bit / 32 < n) ? (a[bit / 32] >> (bit % 32)) & 1 : 0;
+}
+
+// Any of bits [0, bit) set?
+static inline int _sf_any_below(const u32* a, int n, s64 bit) {
+    s64 limbs = bit / 32;
+    for (s64 i = 0; i < limbs && i < n; i++) if (a[i]) return 1;
+    if (bit % 32 && limbs < n) return (a[limbs] & ((1u << (bit % 32)) - 1)) != 0;
+    return 0;
+}
+
+// out[count] = a[n] >> s. Safe in place.
+static inline void _sf_shr(u32* out, int count, const u32* a, int n, s64 s) {
+    s64 ls = s / 32; int bs = (int)(s % 32);
+    for (int i = 0; i < count; i++) {
+        s64 j = i + ls;
+        u32 lo = j < n ? a[j] : 0, hi = j + 1 < n ? a[j + 1] : 0;
+        out[i] = bs ? (lo >> bs) | (hi << (32 - bs)) : lo;
+    }
+}
+
+// out[count] = a[n] << s. Safe in place.
+static inline void _sf_shl(u32* out, int count, const u32* a, int n, s64 s) {
+    s64 ls = s / 32; int bs = (int)(s % 32);
+    for (int i = count - 1; i >= 0; i--) {
+        s64 j = i - ls;
+        u32 cur = (j >= 0 && j < n) ? a[j] : 0, prev = (j - 1 >= 0 && j - 1 < n) ? a[j - 1] : 0;
+        out[i] = bs ? (cur << bs) | (prev >> (32 - bs)) : cur;
+    }
+}
+
+static inline int _sf_cmp_n(const u32* a, const u32* b, int n) {
+    for (int i = n - 1; i >= 0; i--) if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+    return 0;
+}
+
+static inline u32 _sf_add_n(u32* a, const u32* b, int n) {
+    u64 c = 0;
+    for (int i = 0; i < n; i++) { c += (u64)a[i] + b[i]; a[i] = (u32)c; c >>= 32; }
+    return (u32)c;
+}
+
+static inline u32 _sf_sub_n(u32* a, const u32* b, int n) {
+    u64 br = 0;
+    for (int i = 0; i < n; i++) { u64 d = (u64)a[i] - b[i] - br; a[i] = (u32)d; br = (d >> 63) & 1; }
+    return (u32)br;
+}
+
+static inline void _sf_zero(_sf_t* v) { memset(v->m, 0, (size_t)v->n * sizeof(u32)); v->e = 0; v->s = 0; }
+
+static inline void _sf_copy(_sf_t* dst, const _sf_t* src) {
+    if (dst->m != src->m) memcpy(dst->m, src->m, (size_t)dst->n * sizeof(u32));
+    dst->e = src->e; dst->s = src->s;
+}
+
+static inline void _sf_normalize(_sf_t* v) {
+    int len = _sf_bitlen(v->m, v->n);
+    if (!len) { v->e = 0; v->s = 0; return; }
+    int sh = 32 * v->n - len;
+    if (sh) { _sf_shl(v->m, v->n, v->m, v->n, sh); v->e -= sh; }
+}
+
+// r = ext[len] * 2^e rounded to r->n limbs; sticky marks nonzero bits below ext.
+static inline void _sf_pack(_sf_t* r, const u32* ext, int len, s64 e, int sticky) {
+    int bits = _sf_bitlen(ext, len), n = r->n;
+    if (!bits) { _sf_zero(r); return; }
+    s64 shift = (s64)bits - 32 * n;
+    if (shift <= 0) { _sf_shl(r->m, n, ext, len, -shift); r->e = e + shift; return; }
+    _sf_shr(r->m, n, ext, len, shift);
+    int round = _sf_bit(ext, len, shift - 1);
+    sticky |= _sf_any_below(ext, len, shift - 1);
+    if (round && (sticky || (r->m[0] & 1))) {
+        int i = 0;
+        while (i < n && ++r->m[i] == 0) i++;
+        if (i == n) { r->m[n - 1] = 0x80000000u; shift++; }
+    }
+    r->e = e + shift;
+}
+
+// Copies src into a wider (or equal) view, keeping the value.
+static inline void _sf_widen(_sf_t* dst, const _sf_t* src) {
+    int pad = dst->n - src->n;
+    memset(dst->m, 0, (size_t)pad * sizeof(u32));
+    memcpy(dst->m + pad, src->m, (size_t)src->n * sizeof(u32));
+    dst->e = src->e - 32 * (s64)pad; dst->s = src->s;
+}
+
+static inline void _sf_from_double(_sf_t* r, double d) {
+    u64 bits; memcpy(&bits, &d, sizeof(bits));
+    int ex = (int)((bits >> 52) & 0x7FF);
+    u64 man = bits & ((1ull << 52) - 1);
+    if (ex == 0x7FF || (ex == 0 && man == 0)) { _sf_zero(r); return; } // Inf/NaN are not representable.
+    if (ex == 0) ex = 1; else man |= 1ull << 52;
+    u32 ext[2] = { (u32)man, (u32)(man >> 32) };
+    _sf_pack(r, ext, 2, (s64)ex - 1075, 0);
+    r->s = (int)(bits >> 63);
+}
+
+static inline void _sf_add(_sf_t* r, const _sf_t* a, const _sf_t* b, int negate_b, u32* tmp);
+
+// Splits a long double into up to three exact double parts, scaled into double range.
+static inline void _sf_from_ldouble(_sf_t* r, long double x, u32* tmp) {
+    if (x != x || x - x != 0 || x == 0) { _sf_zero(r); return; }
+    s64 scale = 0;
+    while (x > 0x1p1000L || x < -0x1p1000L) { x *= 0x1p-1000L; scale += 1000; }
+    while (x < 0x1p-900L && x > -0x1p-900L) { x *= 0x1p900L; scale -= 900; }
+    int n = r->n;
+    _sf_t part = { tmp, 0, 0, n };
+    _sf_zero(r);
+    for (int i = 0; i < 3 && x != 0; i++) {
+        double d = (double)x;
+        x -= d;
+        _sf_from_double(&part, d);
+        _sf_add(r, r, &part, 0, tmp + n);
+    }
+    if (r->m[n - 1]) r->e += scale;
+}
+
+static inline double _sf_pow2(int k) { u64 bits = (u64)(k + 1023) << 52; double d; memcpy(&d, &bits, sizeof(d)); return d; }
+
+static inline double _sf_to_double(const _sf_t* v, u32* m) {
+    int n = v->n;
+    _sf_t x = { m, v->e, v->s, n };
+    memcpy(m, v->m, (size_t)n * sizeof(u32));
+    _sf_normalize(&x);
+    if (!m[n - 1]) return 0.0;
+    u64 top = (u64)m[n - 1] << 32 | (n > 1 ? m[n - 2] : 0);
+    int sticky = n > 2 && _sf_any_below(m, n, 32 * (s64)n - 64);
+    s64 E = x.e + 32 * (s64)n - 64 + 63 + 1023;   // Biased exponent of top's leading bit.
+    u64 sign = (u64)x.s << 63, bits;
+    if (E >= 2047) bits = sign | 0x7FF0000000000000ull;
+    else {
+        int shift = E >= 1 ? 11 : (int)(12 - E);   // Subnormals drop extra bits.
+        if (shift > 64) return x.s ? -0.0 : 0.0;
+        u64 mant = shift == 64 ? 0 : top >> shift;
+        u64 rem = shift == 64 ? top : top & ((1ull << shift) - 1), half = 1ull << (shift - 1);
+        if (rem > half || (rem == half && (sticky || (mant & 1)))) mant++;
+        if (E >= 1) {
+            if (mant >> 53) { mant >>= 1; E++; }
+            bits = E >= 2047 ? sign | 0x7FF0000000000000ull : sign | (u64)E << 52 | (mant & ((1ull << 52) - 1));
+        } else bits = sign | mant;   // Carry into bit 52 yields the smallest normal.
+    }
+    double d; memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
+static inline long double _sf_to_ldouble(const _sf_t* v, u32* m) {
+    int n = v->n;
+    _sf_t x = { m, v->e, v->s, n };
+    memcpy(m, v->m, (size_t)n * sizeof(u32));
+    _sf_normalize(&x);
+    if (!m[n - 1]) return 0.0L;
+    u64 top = (u64)m[n - 1] << 32 | (n > 1 ? m[n - 2] : 0);
+    if (n > 2 && _sf_any_below(m, n, 32 * (s64)n - 64)) top |= 1;
+    long double r = (long double)top;
+    s64 e = x.e + 32 * (s64)n - 64;
+    while (e > 0) { int k = e > 1000 ? 1000 : (int)e; r *= _sf_pow2(k); e -= k; if (r - r != 0) break; }
+    while (e < 0) { int k = e < -1000 ? -1000 : (int)e; r *= _sf_pow2(k); e -= k; if (r == 0) break; }
+    return x.s ? -r : r;
+}
+
+static inline int _sf_cmp(const _sf_t* a, const _sf_t* b, u32* tmp) {
+    int n = a->n;
+    u32 *am = tmp, *bm = tmp + n;
+    _sf_t x = { am, a->e, a->s, n }, y = { bm, b->e, b->s, n };
+    memcpy(am, a->m, (size_t)n * sizeof(u32)); memcpy(bm, b->m, (size_t)n * sizeof(u32));
+    _sf_normalize(&x); _sf_normalize(&y);
+    int xz = !am[n - 1], yz = !bm[n - 1];
+    if (xz && yz) return 0;
+    if (xz) return y.s ? 1 : -1;
+    if (yz) return x.s ? -1 : 1;
+    if (x.s != y.s) return x.s ? -1 : 1;
+    int mag = x.e != y.e ? (x.e < y.e ? -1 : 1) : _sf_cmp_n(am, bm, n);
+    return x.s ? -mag : mag;
+}
+
+// r = a + b (or a - b). 64 guard bits plus a sticky bit give exact rounding.
+static inline void _sf_add(_sf_t* r, const _sf_t* a, const _sf_t* b, int negate_b, u32* tmp) {
+    int n = r->n;
+    s64 P = 32 * (s64)n;
+    u32 *am = tmp, *bm = am + n;
+    _sf_t x = { am, a->e, a->s, n }, y = { bm, b->e, b->s ^ negate_b, n };
+    memcpy(am, a->m, (size_t)n * sizeof(u32)); memcpy(bm, b->m, (size_t)n * sizeof(u32));
+    _sf_normalize(&x); _sf_normalize(&y);
+    if (!bm[n - 1]) { _sf_copy(r, &x); return; }
+    if (!am[n - 1]) { _sf_copy(r, &y); return; }
+    if (y.e > x.e || (y.e == x.e && _sf_cmp_n(bm, am, n) > 0)) { _sf_t t = x; x = y; y = t; }
+
+    int L = n + 3;
+    u32 *ext = bm + n, *yy = ext + L, *sh = yy + L;
+    ext[0] = ext[1] = 0; memcpy(ext + 2, x.m, (size_t)n * sizeof(u32)); ext[L - 1] = 0;
+    sh[0] = sh[1] = 0; memcpy(sh + 2, y.m, (size_t)n * sizeof(u32));
+    s64 d = x.e - y.e;
+    int sticky;
+    if (d >= P + 64) { memset(yy, 0, (size_t)L * sizeof(u32)); sticky = 1; }
+    else { _sf_shr(yy, L, sh, n + 2, d); sticky = _sf_any_below(sh, n + 2, d); }
+    yy[0] |= (u32)sticky;
+    if (x.s == y.s) _sf_add_n(ext, yy, L); else _sf_sub_n(ext, yy, L);
+    int sign = x.s;
+    _sf_pack(r, ext, L, x.e - 64, 0);
+    r->s = r->m[n - 1] ? sign : 0;
+}
+
+// The product goes through Karatsuba directly so its scratch stays in tmp.
+static inline void _sf_mul(_sf_t* r, const _sf_t* a, const _sf_t* b, u32* tmp) {
+    int n = r->n;
+    u32 *am = tmp, *bm = am + n, *prod = bm + n;
+    _sf_t x = { am, a->e, a->s, n }, y = { bm, b->e, b->s, n };
+    memcpy(am, a->m, (size_t)n * sizeof(u32)); memcpy(bm, b->m, (size_t)n * sizeof(u32));
+    _sf_normalize(&x); _sf_normalize(&y);
+    if (!am[n - 1] || !bm[n - 1]) { _sf_zero(r); return; }
+    _sbig_mul_karatsuba(prod, am, bm, n, prod + 2 * n);
+    _sf_pack(r, prod, 2 * n, x.e + y.e, 0);
+    r->s = x.s ^ y.s;
+}
+
+// Double-precision seed for 1/sqrt(m), m in [0.5, 2), without libm.
+static inline double _sf_rsqrt_seed(double m) {
+    double y = 1.0 / m < 1.0 ? 0.85 : 1.2;
+    for (int i = 0; i < 6; i++) y = y * (1.5 - 0.5 * m * y * y);
+    return y;
+}
+
+// Top 64 mantissa bits of a normalized view as a double in [0.5, 1).
+static inline double _sf_top_unit(const _sf_t* v) {
+    int n = v->n;
+    u64 top = (u64)v->m[n - 1] << 32 | (n > 1 ? v->m[n - 2] : 0);
+    return (double)top * 0x1p-64;
+}
+
+// r = a / b. Newton reciprocal at n+1 limbs, then an exact integer fix-up so the
+// quotient is correctly rounded. Returns 0 on division by zero.
+static inline int _sf_div(_sf_t* r, const _sf_t* a, const _sf_t* b, u32* tmp) {
+    int n = r->n, w = n + 1;
+    s64 P = 32 * (s64)n;
+    u32 *A = tmp, *B = A + n;
+    _sf_t xa = { A, a->e, a->s, n }, xb = { B, b->e, b->s, n };
+    memcpy(A, a->m, (size_t)n * sizeof(u32)); memcpy(B, b->m, (size_t)n * sizeof(u32));
+    _sf_normalize(&xa); _sf_normalize(&xb);
+    if (!B[n - 1]) return 0;
+    if (!A[n - 1]) { _sf_zero(r); return 1; }
+
+    // x ~ 1/B for the integer B; each step x += x * (1 - B*x) doubles the correct bits.
+    u32 *bm = B + n, *xm = bm + w, *tm = xm + w, *om = tm + w, *am = om + w, *wk = am + w;
+    _sf_t bw = { bm, 0, 0, w }, x = { xm, 0, 0, w }, t = { tm, 0, 0, w }, one = { om, 0, 0, w }, aw = { am, 0, 0, w };
+    _sf_t B0 = { B, 0, 0, n }, A0 = { A, 0, 0, n };
+    _sf_widen(&bw, &B0); _sf_widen(&aw, &A0);
+    _sf_from_double(&one, 1.0);
+    _sf_from_double(&x, 1.0 / _sf_top_unit(&B0));
+    x.e -= P;
+    for (s64 bits = 48; bits < 32 * (s64)w; bits *= 2) {
+        _sf_mul(&t, &bw, &x, wk);
+        _sf_add(&t, &one, &t, 1, wk);
+        _sf_mul(&t, &x, &t, wk);
+        _sf_add(&x, &x, &t, 0, wk);
+    }
+    _sf_mul(&t, &aw, &x, wk);   // t ~ A / B
+
+    // Q = floor(A * 2^(P+1) / B): take the estimate, then fix it up exactly.
+    // The Newton buffers are done with, so the fix-up reuses wk.
+    int L = 2 * n + 2;
+    size_t LB = (size_t)L * sizeof(u32);
+    u32 *Q = wk, *T = Q + L, *U = T + L, *R = U + L, *Bx = R + L, *one_l = Bx + L;
+    s64 sh = t.e + P + 1;
+    if (sh >= 0) _sf_shl(Q, L, tm, w, sh); else _sf_shr(Q, L, tm, w, -sh);
+    _sf_shl(U, L, A, n, P + 1);
+    memset(Bx, 0, LB); memcpy(Bx, B, (size_t)n * sizeof(u32));
+    _sbig_mul_karatsuba(T, Q, Bx, n + 1, one_l + L);   // Fills all L = 2(n+1) limbs.
+    memset(one_l, 0, LB); one_l[0] = 1;
+    while (_sf_cmp_n(T, U, L) > 0) { _sf_sub_n(T, Bx, L); _sf_sub_n(Q, one_l, L); }
+    for (;;) {
+        memcpy(R, U, LB); _sf_sub_n(R, T, L);
+        if (_sf_cmp_n(R, Bx, L) < 0) break;
+        _sf_add_n(T, Bx, L); _sf_add_n(Q, one_l, L);
+    }
+    int sticky = _sf_bitlen(R, L) != 0;
+    _sf_pack(r, Q, n + 1, xa.e - xb.e - (P + 1), sticky);
+    r->s = xa.s ^ xb.s;
+    return 1;
+}
+
+// r = sqrt(a). Newton inverse square root at n+1 limbs, then an exact integer
+// fix-up. Returns 0 for negative input.
+static inline int _sf_sqrt(_sf_t* r, const _sf_t* a, u32* tmp) {
+    int n = r->n, w = n + 1;
+    s64 P = 32 * (s64)n;
+    u32* A = tmp;
+    _sf_t xa = { A, a->e, a->s, n };
+    memcpy(A, a->m, (size_t)n * sizeof(u32));
+    _sf_normalize(&xa);
+    if (!A[n - 1]) { _sf_zero(r); return 1; }
+    if (xa.s) return 0;
+
+    // N = A * 2^k with k >= P + 2 and (e - k) even, so sqrt(a) = sqrt(N) * 2^((e - k) / 2).
+    s64 k = P + 2 + ((xa.e - (P + 2)) & 1);
+    u32 *nm = A + n, *ym = nm + w, *tm = ym + w, *th = tm + w, *wk = th + w;
+    _sf_t xn = { nm, 0, 0, w }, y = { ym, 0, 0, w }, t = { tm, 0, 0, w }, three = { th, 0, 0, w };
+    _sf_t A0 = { A, k, 0, n };
+    _sf_widen(&xn, &A0);
+    _sf_from_double(&three, 3.0);
+    double m = _sf_top_unit(&A0);
+    s64 E = P + k;                      // N ~ m * 2^E
+    if (E & 1) { m *= 2; E--; }
+    _sf_from_double(&y, _sf_rsqrt_seed(m));
+    y.e -= E / 2;
+    for (s64 bits = 48; bits < 32 * (s64)w; bits *= 2) {
+        _sf_mul(&t, &y, &y, wk);
+        _sf_mul(&t, &xn, &t, wk);
+        _sf_add(&t, &three, &t, 1, wk);
+        _sf_mul(&y, &y, &t, wk);
+        y.e--;
+    }
+    _sf_mul(&t, &xn, &y, wk);   // t ~ sqrt(N)
+
+    int L = 2 * n + 4;
+    size_t LB = (size_t)L * sizeof(u32);
+    u32 *S = wk, *T = S + L, *Nn = T + L, *D = Nn + L, *G = D + L, *one_l = G + L;
+    if (t.e >= 0) _sf_shl(S, L, tm, w, t.e); else _sf_shr(S, L, tm, w, -t.e);
+    _sf_shl(Nn, L, A, n, k);
+    memset(T, 0, LB);
+    _sbig_mul_karatsuba(T, S, S, n + 1, one_l + L);
+    memset(one_l, 0, LB); one_l[0] = 1;
+    // While S^2 > N: S^2 -= 2S - 1, S--.
+    while (_sf_cmp_n(T, Nn, L) > 0) {
+        _sf_shl(G, L, S, L, 1); _sf_sub_n(G, one_l, L);
+        _sf_sub_n(T, G, L); _sf_sub_n(S, one_l, L);
+    }
+    // While (S+1)^2 <= N: S^2 += 2S + 1, S++.
+    for (;;) {
+        _sf_shl(G, L, S, L, 1); _sf_add_n(G, one_l, L);
+        memcpy(D, Nn, LB); _sf_sub_n(D, T, L);
+        if (_sf_cmp_n(D, G, L) < 0) break;
+        _sf_add_n(T, G, L); _sf_add_n(S, one_l, L);
+    }
+    int sticky = _sf_cmp_n(T, Nn, L) != 0;
+    _sf_pack(r, S, n + 1, (xa.e - k) / 2, sticky);
+    r->s = 0;
+    return 1;
+}
+
+#define _SF_VIEW(v, COUNT) { (v).mantissa.limbs, (v).exponent, (v).sign, COUNT }
+
+// Writes a view's exponent and sign back. The stored exponent is an s32: results
+// at or above 2^(INT32_MAX + 32n) saturate to the largest finite value, and ones
+// with an exponent below INT32_MIN shift right into range, flushing to zero.
+static inline void _sf_store(s32* exponent, s32* sign, _sf_t* v) {
+    if (!_sf_bitlen(v->m, v->n)) v->e = v->s = 0;
+    else if (v->e > INT32_MAX) { memset(v->m, 0xFF, (size_t)v->n * sizeof(u32)); v->e = INT32_MAX; }
+    else if (v->e < INT32_MIN) {
+        _sf_shr(v->m, v->n, v->m, v->n, (s64)INT32_MIN - v->e);
+        v->e = INT32_MIN;
+        if (!_sf_bitlen(v->m, v->n)) v->e = v->s = 0;
+    }
+    *exponent = (s32)v->e; *sign = v->s;
+}
+#define _SF_STORE(dst, view) _sf_store(&(dst)->exponent, &(dst)->sign, &(view))
+
+#define DEF_FLOAT(BITS, COUNT) \
+    static inline void sfloat##BITS##_normalize(sfloat##BITS *v) { \
+        _sf_t x = _SF_VIEW(*v, COUNT); _sf_normalize(&x); _SF_STORE(v, x); \
+    } \
+    static inline sfloat##BITS sfloat##BITS##_from_double(double d) { \
+        sfloat##BITS r = {0}; _sf_t x = _SF_VIEW(r, COUNT); _sf_from_double(&x, d); _SF_STORE(&r, x); return r; \
+    } \
+    static inline sfloat##BITS sfloat##BITS##_from_ldouble(long double d) { \
+        sfloat##BITS r = {0}; _sf_t x = _SF_VIEW(r, COUNT); u32 tmp[_SF_TMP(COUNT)]; \
+        _sf_from_ldouble(&x, d, tmp); _SF_STORE(&r, x); return r; \
+    } \
+    static inline double sfloat##BITS##_to_double(sfloat##BITS v) { \
+        _sf_t x = _SF_VIEW(v, COUNT); u32 tmp[COUNT]; return _sf_to_double(&x, tmp); \
+    } \
+    static inline long double sfloat##BITS##_to_ldouble(sfloat##BITS v) { \
+        _sf_t x = _SF_VIEW(v, COUNT); u32 tmp[COUNT]; return _sf_to_ldouble(&x, tmp); \
+    } \
+    static inline int sfloat##BITS##_cmp(sfloat##BITS a, sfloat##BITS b) { \
+        _sf_t x = _SF_VIEW(a, COUNT), y = _SF_VIEW(b, COUNT); u32 tmp[2 * COUNT]; return _sf_cmp(&x, &y, tmp); \
+    } \
+    static inline void sfloat##BITS##_add(sfloat##BITS *res, sfloat##BITS a, sfloat##BITS b) { \
+        _sf_t x = _SF_VIEW(a, COUNT), y = _SF_VIEW(b, COUNT), r = _SF_VIEW(*res, COUNT); \
+        u32 tmp[_SF_TMP(COUNT)]; _sf_add(&r, &x, &y, 0, tmp); _SF_STORE(res, r); \
+    } \
+    static inline void sfloat##BITS##_sub(sfloat##BITS *res, sfloat##BITS a, sfloat##BITS b) { \
+        _sf_t x = _SF_VIEW(a, COUNT), y = _SF_VIEW(b, COUNT), r = _SF_VIEW(*res, COUNT); \
+        u32 tmp[_SF_TMP(COUNT)]; _sf_add(&r, &x, &y, 1, tmp); _SF_STORE(res, r); \
+    } \
+    static inline void sfloat##BITS##_mul(sfloat##BITS *res, sfloat##BITS a, sfloat##BITS b) { \
+        _sf_t x = _SF_VIEW(a, COUNT), y = _SF_VIEW(b, COUNT), r = _SF_VIEW(*res, COUNT); \
+        u32 tmp[_SF_TMP(COUNT)]; _sf_mul(&r, &x, &y, tmp); _SF_STORE(res, r); \
+    } \
+    /* Returns 0 on division by zero (res untouched). */ \
+    static inline int sfloat##BITS##_div(sfloat##BITS *res, sfloat##BITS a, sfloat##BITS b) { \
+        _sf_t x = _SF_VIEW(a, COUNT), y = _SF_VIEW(b, COUNT), r = _SF_VIEW(*res, COUNT); \
+        u32 tmp[_SF_TMP_WIDE(COUNT)]; \
+        if (!_sf_div(&r, &x, &y, tmp)) return 0; \
+        _SF_STORE(res, r); return 1; \
+    } \
+    /* Returns 0 for negative input (res untouched). */ \
+    static inline int sfloat##BITS##_sqrt(sfloat##BITS *res, sfloat##BITS a) { \
+        _sf_t x = _SF_VIEW(a, COUNT), r = _SF_VIEW(*res, COUNT); \
+        u32 tmp[_SF_TMP_WIDE(COUNT)]; \
+        if (!_sf_sqrt(&r, &x, tmp)) return 0; \
+        _SF_STORE(res, r); return 1; \
+    }
+
+DEF_FLOAT(32, 1)    DEF_FLOAT(64, 2)    DEF_FLOAT(128, 4)
+DEF_FLOAT(256, 8)   DEF_FLOAT(512, 16)  DEF_FLOAT(1024, 32)
+DEF_FLOAT(2048, 64) DEF_FLOAT(4096, 128) DEF_FLOAT(8192, 256)
+DEF_FLOAT(12288, 384)
+
+// --- GCD & Modular Inverse ---
+// The limb helpers take the width so each DEF_GCD wrapper inlines them with a
+// constant COUNT. Lengths are tracked so shrinking remainders get cheaper.
+static inline int _gcd_len(const u32* a, int n) { while (n > 0 && !a[n - 1]) n--; return n; }
+
+static inline s64 _gcd_ctz(const u32* a, int n) {
+    for (int i = 0; i < n; i++) if (a[i]) return (s64)i * 32 + __builtin_ctz(a[i]);
+    return 0;
+}
+
+static inline int _gcd_cmp(const u32* a, int al, const u32* b, int bl) {
+    if (al != bl) return al < bl ? -1 : 1;
+    return _sf_cmp_n(a, b, al);
+}
+
+// a[al] -= b[bl], requires a >= b.
+static inline void _gcd_sub(u32* a, int al, const u32* b, int bl) {
+    u64 br = 0;
+    for (int i = 0; i < al; i++) {
+        u64 d = (u64)a[i] - (i < bl ? b[i] : 0) - br;
+        a[i] = (u32)d; br = (d >> 63) & 1;
+        if (i >= bl && !br) break;
+    }
+}
+
+static inline u64 _gcd_u64(u64 x, u64 y) {   // Both odd.
+    while (x != y) {
+        if (x > y) { x -= y; x >>= __builtin_ctzll(x); }
+        else { y -= x; y >>= __builtin_ctzll(y); }
+    }
+    return x;
+}
+
+// Binary GCD (Stein): strip the common twos, then subtract and shift.
+// Once both values fit in 64 bits the loop finishes in registers.
+static inline void _gcd_binary(u32* r, const u32* a, const u32* b, int n) {
+    u32 ub[n], vb[n];
+    u32 *u = ub, *v = vb;
+    memcpy(ub, a, (size_t)n * sizeof(u32)); memcpy(vb, b, (size_t)n * sizeof(u32));
+    int ul = _gcd_len(u, n), vl = _gcd_len(v, n);
+    if (!ul || !vl) { memcpy(r, ul ? a : b, (size_t)n * sizeof(u32)); return; }
+    s64 zu = _gcd_ctz(u, ul), zv = _gcd_ctz(v, vl), k = zu < zv ? zu : zv;
+    _sf_shr(u, ul, u, ul, zu); ul = _gcd_len(u, ul);
+    _sf_shr(v, vl, v, vl, zv); vl = _gcd_len(v, vl);
+    for (;;) {
+        if (ul <= 2 && vl <= 2) {
+            u64 x = _gcd_u64((u64)(ul > 1 ? u[1] : 0) << 32 | u[0], (u64)(vl > 1 ? v[1] : 0) << 32 | v[0]);
+            u[0] = (u32)x; ul = 1;
+            if (n > 1) { u[1] = (u32)(x >> 32); ul = 2; }
+            break;
+        }
+        int c = _gcd_cmp(u, ul, v, vl);
+        if (c == 0) break;
+        if (c < 0) { u32* t = u; u = v; v = t; int tl = ul; ul = vl; vl = tl; }
+        _gcd_sub(u, ul, v, vl);
+        ul = _gcd_len(u, ul);
+        _sf_shr(u, ul, u, ul, _gcd_ctz(u, ul));
+        ul = _gcd_len(u, ul);
+    }
+    memset(r, 0, (size_t)n * sizeof(u32));
+    memcpy(r, u, (size_t)ul * sizeof(u32));
+    _sf_shl(r, n, r, n, k);
+}
+
+// out[n] = A * a + B * b for a Lehmer cofactor pair of opposite signs; the caller
+// knows the result is non-negative and fits. With add set, out = |A| a + |B| b.
+static inline void _gcd_lincomb(u32* out, const u32* a, s64 A, const u32* b, s64 B, int n, int add) {
+    u64 ma = A < 0 ? 0 - (u64)A : (u64)A, mb = B < 0 ? 0 - (u64)B : (u64)B;
+    u32 fa[2] = { (u32)ma, (u32)(ma >> 32) }, fb[2] = { (u32)mb, (u32)(mb >> 32) };
+    u32 x[n + 2], y[n + 2];
+    memset(x, 0, sizeof(x)); memset(y, 0, sizeof(y));
+    _sbig_mul_raw(x, a, n, fa, 2);
+    _sbig_mul_raw(y, b, n, fb, 2);
+    if (add) _sf_add_n(x, y, n);
+    else if (B <= 0) _sf_sub_n(x, y, n);
+    else { _sf_sub_n(y, x, n); memcpy(x, y, (size_t)n * sizeof(u32)); }
+    memcpy(out, x, (size_t)n * sizeof(u32));
+}
+
+// q[n], r[n] = a / b, a % b for b != 0, with stack scratch.
+static inline void _gcd_divmod(u32* q, u32* r, const u32* a, const u32* b, int n) {
+    int al = _gcd_len(a, n), bl = _gcd_len(b, n);
+    if (q) memset(q, 0, (size_t)n * sizeof(u32));
+    if (al < bl) { memmove(r, a, (size_t)n * sizeof(u32)); return; }
+    if (bl == 1) {
+        u64 rem = 0, d = b[0];
+        for (int i = al - 1; i >= 0; i--) {
+            u64 cur = (rem << 32) | a[i];
+            if (q) q[i] = (u32)(cur / d);
+            rem = cur % d;
+        }
+        memset(r, 0, (size_t)n * sizeof(u32)); r[0] = (u32)rem;
+        return;
+    }
+    u32 un[al + 1], vn[bl], rr[bl];
+    _sbig_divmod_raw(q, rr, a, al, b, bl, un, vn);
+    memset(r, 0, (size_t)n * sizeof(u32));
+    memcpy(r, rr, (size_t)bl * sizeof(u32));
+}
+
+// Top 62 bits of r0 and the matching bits of r1 (same shift).
+static inline void _gcd_lead(const u32* r0, const u32* r1, int len, u64* x, u64* y) {
+    s64 bits = _sf_bitlen(r0, len), sh = bits > 62 ? bits - 62 : 0;
+    u32 t[2];
+    _sf_shr(t, 2, r0, len, sh); *x = (u64)t[1] << 32 | t[0];
+    _sf_shr(t, 2, r1, len, sh); *y = (u64)t[1] << 32 | t[0];
+}
+
+// Lehmer's GCD on r0 >= r1 (both n limbs, overwritten); r0 ends as the gcd.
+// When t0/t1 are given they hold cofactor magnitudes: t_next = t_prev + q * t_cur.
+// Returns the number of Euclid steps taken, whose parity fixes the cofactor signs.
+static inline s64 _gcd_lehmer(u32* r0, u32* r1, u32* t0, u32* t1, int n) {
+    u32 na[n], nb[n];
+    s64 steps = 0;
+    int len = _gcd_len(r0, n);
+    while (_gcd_len(r1, len)) {
+        u64 x, y;
+        _gcd_lead(r0, r1, len, &x, &y);
+        // Knuth's Algorithm L: run Euclid on the leading bits while the
+        // quotient is the same for both ends of the uncertainty interval.
+        s64 A = 1, B = 0, C = 0, D = 1, k = 0, sx = (s64)x, sy = (s64)y;
+        while (sy + C > 0 && sy + D > 0) {
+            s64 q = (sx + A) / (sy + C);
+            if (q != (sx + B) / (sy + D)) break;
+            s64 T = A - q * C; A = C; C = T;
+            T = B - q * D; B = D; D = T;
+            T = sx - q * sy; sx = sy; sy = T;
+            k++;
+        }
+        if (B == 0) {
+            // No usable digit: take one full division step.
+            u32 q[n];
+            _gcd_divmod(t0 ? q : NULL, na, r0, r1, n);
+            memcpy(r0, r1, (size_t)n * sizeof(u32));
+            memcpy(r1, na, (size_t)n * sizeof(u32));
+            if (t0) {
+                u32 p[2 * n];
+                memset(p, 0, sizeof(p));
+                int ql = _gcd_len(q, n), tl = _gcd_len(t1, n);
+                if (ql && tl) _sbig_mul_raw(p, q, ql, t1, tl);
+                _sf_add_n(p, t0, n);
+                memcpy(t0, t1, (size_t)n * sizeof(u32));
+                memcpy(t1, p, (size_t)n * sizeof(u32));
+            }
+            steps++;
+        } else {
+            _gcd_lincomb(na, r0, A, r1, B, len, 0);
+            _gcd_lincomb(nb, r0, C, r1, D, len, 0);
+            memcpy(r0, na, (size_t)len * sizeof(u32));
+            memcpy(r1, nb, (size_t)len * sizeof(u32));
+            if (t0) {
+                _gcd_lincomb(na, t0, A, t1, B, n, 1);
+                _gcd_lincomb(nb, t0, C, t1, D, n, 1);
+                memcpy(t0, na, (size_t)n * sizeof(u32));
+                memcpy(t1, nb, (size_t)n * sizeof(u32));
+            }
+            steps += k;
+        }
+        len = _gcd_len(r0, len);
+    }
+    return steps;
+}
+
+static inline void _gcd_lehmer_gcd(u32* r, const u32* a, const u32* b, int n) {
+    u32 r0[n], r1[n];
+    int swap = _gcd_cmp(a, n, b, n) < 0;
+    memcpy(r0, swap ? b : a, (size_t)n * sizeof(u32));
+    memcpy(r1, swap ? a : b, (size_t)n * sizeof(u32));
+    _gcd_lehmer(r0, r1, NULL, NULL, n);
+    memcpy(r, r0, (size_t)n * sizeof(u32));
+}
+
+// r = a^-1 mod m. Extended Lehmer on (m, a mod m) tracking only a's cofactor.
+static inline int _gcd_modinv(u32* r, const u32* a, const u32* m, int n) {
+    int ml = _gcd_len(m, n);
+    if (!ml) return 0;
+    if (ml == 1 && m[0] == 1) { memset(r, 0, (size_t)n * sizeof(u32)); return 1; }
+    u32 r0[n], r1[n], t0[n], t1[n];
+    memcpy(r0, m, (size_t)n * sizeof(u32));
+    _gcd_divmod(NULL, r1, a, m, n);
+    memset(t0, 0, sizeof(t0)); memset(t1, 0, sizeof(t1)); t1[0] = 1;
+    // r0 has index 0 (cofactor 0), r1 index 1 (cofactor +1); signs alternate from there.
+    s64 steps = _gcd_lehmer(r0, r1, t0, t1, n);
+    if (_gcd_len(r0, n) != 1 || r0[0] != 1) return 0;
+    // The gcd sits at index `steps`; odd indices carry positive cofactors.
+    if (steps & 1) memcpy(r, t0, (size_t)n * sizeof(u32));
+    else { memcpy(r, m, (size_t)n * sizeof(u32)); _sf_sub_n(r, t0, n); }
+    return 1;
+}
+
+#define DEF_GCD(BITS, COUNT) \
+    static inline void suint##BITS##_gcd_binary(suint##BITS *res, suint##BITS a, suint##BITS b) { _gcd_binary(res->limbs, a.limbs, b.limbs, COUNT); } \
+    static inline void suint##BITS##_gcd(suint##BITS *res, suint##BITS a, suint##BITS b) { _gcd_lehmer_gcd(res->limbs, a.limbs, b.limbs, COUNT); } \
+    /* Returns 0 (res untouched) when gcd(a, m) != 1 or m == 0. */ \
+    static inline int suint##BITS##_modinv(suint##BITS *res, suint##BITS a, suint##BITS m) { return _gcd_modinv(res->limbs, a.limbs, m.limbs, COUNT); }
+
+DEF_GCD(32, 1)    DEF_GCD(64, 2)    DEF_GCD(128, 4)
+DEF_GCD(256, 8)   DEF_GCD(512, 16)  DEF_GCD(1024, 32)
+DEF_GCD(2048, 64) DEF_GCD(4096, 128) DEF_GCD(8192, 256)
+DEF_GCD(12288, 384)
+
+// --- Hash Map (Swiss Table) ---
+// DEF_MAP(NAME, K, V, HASH, EQ) defines NAME, an open-addressing map from K to
+// V. HASH(key) returns a u64 and EQ(a, b) is nonzero for equal keys. Each slot
+// has a control byte: EMPTY, DELETED, or 7 bits of the key's hash. A probe
+// compares 16 control bytes at once and reads keys only on a hash match. The
+// first 16 control bytes are mirrored after the last, so a group can start at
+// any slot. Tables have a power-of-two capacity and grow at 7/8 load.
+
+#define MAP_EMPTY   ((s8)-128)
+#define MAP_DELETED ((s8)-2)
+#define MAP_GROUP   16
+
+#if defined(_TYPES_X86_SIMD) && defined(__SSE2__)
+    #define _MAP_SSE2 1
+#endif
+
+// Bit i is set when g[i] == h.
+static inline u32 _map_match(const s8* g, s8 h) {
+#ifdef _MAP_SSE2
+    return (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)g), _mm_set1_epi8(h)));
+#else
+    u32 m = 0;
+    for (int i = 0; i < MAP_GROUP; i++) m |= (u32)(g[i] == h) << i;
+    return m;
+#endif
+}
+
+// EMPTY or DELETED: the only control values with the sign bit set.
+static inline u32 _map_match_free(const s8* g) {
+#ifdef _MAP_SSE2
+    return (u32)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)g));
+#else
+    u32 m = 0;
+    for (int i = 0; i < MAP_GROUP; i++) m |= (u32)(g[i] < 0) << i;
+    return m;
+#endif
+}
+
+static inline size_t _map_max_load(size_t cap) { return cap - cap / 8; }
+
+// Smallest capacity that holds n entries without growing.
+static inline size_t _map_cap_for(size_t n) {
+    size_t cap = MAP_GROUP;
+    while (_map_max_load(cap) < n) cap *= 2;
+    return cap;
+}
+
+// Key hashes. Integers go through the murmur3 finalizer so that keys sharing
+// low bits (pointers, multiples of 2^k) still spread over slots and control bytes.
+static inline u64 map_hash_u64(u64 k) {
+    k ^= k >> 33; k *= 0xFF51AFD7ED558CCDULL;
+    k ^= k >> 33; k *= 0xC4CEB9FE1A85EC53ULL;
+    return k ^ (k >> 33);
+}
+
+static inline int map_eq_u64(u64 a, u64 b) { return a == b; }
+
+static inline u64 _map_mix(u64 a, u64 b) {
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef unsigned __int128 _map_u128;
+    _map_u128 r = (_map_u128)a * b;
+    return (u64)r ^ (u64)(r >> 64);
+#else
+    u64 ll = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF), lh = (a & 0xFFFFFFFF) * (b >> 32);
+    u64 hl = (a >> 32) * (b & 0xFFFFFFFF), hh = (a >> 32) * (b >> 32);
+    u64 mid = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+    return ((ll & 0xFFFFFFFF) | (mid << 32)) ^ (hh + (lh >> 32) + (hl >> 32) + (mid >> 32));
+#endif
+}
+
+static inline u64 _map_r64(const u8* p) { u64 v; memcpy(&v, p, 8); return v; }
+static inline u64 _map_r32(const u8* p) { u32 v; memcpy(&v, p, 4); return v; }
+
+// Byte strings, 16 bytes per multiply (wyhash-style).
+static inline u64 map_hash_bytes(const void* data, size_t n) {
+    const u8* p = (const u8*)data;
+    const u64 s0 = 0xA0761D6478BD642FULL, s1 = 0xE7037ED1A0B428DBULL;
+    u64 h = s0, a, b;
+    if (n <= 16) {
+        if (n >= 4) {
+            size_t q = (n >> 3) << 2;
+            a = _map_r32(p) << 32 | _map_r32(p + q);
+            b = _map_r32(p + n - 4) << 32 | _map_r32(p + n - 4 - q);
+        } else if (n) {
+            a = (u64)p[0] << 16 | (u64)p[n >> 1] << 8 | p[n - 1];
+            b = 0;
+        } else a = b = 0;
+    } else {
+        size_t i = n;
+        for (; i > 16; i -= 16, p += 16) h = _map_mix(_map_r64(p) ^ s1, _map_r64(p + 8) ^ h);
+        a = _map_r64(p + i - 16);
+        b = _map_r64(p + i - 8);
+    }
+    return _map_mix(s1 ^ n, _map_mix(a ^ s1, b ^ h));
+}
+
+static inline u64 map_hash_str(const char* s) { return map_hash_bytes(s, strlen(s)); }
+static inline int map_eq_str(const char* a, const char* b) { return strcmp(a, b) == 0; }
+
+#define DEF_MAP(NAME, K, V, HASH, EQ) \
+    typedef struct { K key; V val; } NAME##_entry; \
+    typedef struct { \
+        s8* ctrl;             /* cap + MAP_GROUP control bytes, then the slots, in one allocation */ \
+        NAME##_entry* slots; \
+        size_t cap, len; \
+        size_t growth_left;   /* EMPTY slots that may still be filled before a rehash */ \
+    } NAME; \
+    \
+    static inline void NAME##_init(NAME* m) { memset(m, 0, sizeof(*m)); } \
+    static inline void NAME##_free(NAME* m) { QOL_FREE(m->ctrl); memset(m, 0, sizeof(*m)); } \
+    static inline void NAME##_clear(NAME* m) { \
+        if (!m->cap) return; \
+        memset(m->ctrl, MAP_EMPTY, m->cap + MAP_GROUP); \
+        m->len = 0; \
+        m->growth_left = _map_max_load(m->cap); \
+    } \
+    static inline void _##NAME##_set_ctrl(NAME* m, size_t i, s8 c) { \
+        m->ctrl[i] = c; \
+        if (i < MAP_GROUP) m->ctrl[m->cap + i] = c; \
+    } \
+    /* Slot index of key, or (size_t)-1. Probes groups at triangular offsets until one has an EMPTY. */ \
+    static inline size_t _##NAME##_find(const NAME* m, K key, u64 h) { \
+        if (!m->cap) return (size_t)-1; \
+        size_t mask = m->cap - 1, pos = (size_t)(h >> 7) & mask, step = 0; \
+        for (;;) { \
+            const s8* g = m->ctrl + pos; \
+            for (u32 hit = _map_match(g, (s8)(h & 0x7F)); hit; hit &= hit - 1) { \
+                size_t i = (pos + (size_t)__builtin_ctz(hit)) & mask; \
+                if (EQ(m->slots[i].key, key)) return i; \
+            } \
+            if (_map_match(g, MAP_EMPTY)) return (size_t)-1; \
+            step += MAP_GROUP; \
+            pos = (pos + step) & mask; \
+        } \
+    } \
+    static inline size_t _##NAME##_free_slot(const NAME* m, u64 h) { \
+        size_t mask = m->cap - 1, pos = (size_t)(h >> 7) & mask, step = 0; \
+        for (;;) { \
+            u32 f = _map_match_free(m->ctrl + pos); \
+            if (f) return (pos + (size_t)__builtin_ctz(f)) & mask; \
+            step += MAP_GROUP; \
+            pos = (pos + step) & mask; \
+        } \
+    } \
+    /* Moves every entry into a fresh table of cap slots, dropping tombstones. */ \
+    static inline int _##NAME##_rehash(NAME* m, size_t cap) { \
+        NAME t; \
+        size_t ctrl_bytes = _QOL_ALIGN(cap + MAP_GROUP); \
+        u8* mem = (u8*)QOL_MALLOC(ctrl_bytes + cap * sizeof(NAME##_entry)); \
+        if (!mem) return 0; \
+        t.ctrl = (s8*)mem; \
+        t.slots = (NAME##_entry*)(mem + ctrl_bytes); \
+        t.cap = cap; \
+        t.len = m->len; \
+        t.growth_left = _map_max_load(cap) - m->len; \
+        memset(t.ctrl, MAP_EMPTY, cap + MAP_GROUP); \
+        for (size_t g = 0; g < m->cap; g += MAP_GROUP) { \
+            for (u32 full = ~_map_match_free(m->ctrl + g) & 0xFFFF; full; full &= full - 1) { \
+                size_t i = g + (size_t)__builtin_ctz(full); \
+                u64 h = HASH(m->slots[i].key); \
+                size_t j = _##NAME##_free_slot(&t, h); \
+                _##NAME##_set_ctrl(&t, j, (s8)(h & 0x7F)); \
+                t.slots[j] = m->slots[i]; \
+            } \
+        } \
+        QOL_FREE(m->ctrl); \
+        *m = t; \
+        return 1; \
+    } \
+    /* Makes room for n entries in total. Returns 0 on allocation failure. */ \
+    static inline int NAME##_reserve(NAME* m, size_t n) { \
+        size_t cap = _map_cap_for(n); \
+        return cap <= m->cap || _##NAME##_rehash(m, cap); \
+    } \
+    static inline V* NAME##_get(const NAME* m, K key) { \
+        size_t i = _##NAME##_find(m, key, HASH(key)); \
+        return i == (size_t)-1 ? NULL : &m->slots[i].val; \
+    } \
+    static inline int NAME##_has(const NAME* m, K key) { return _##NAME##_find(m, key, HASH(key)) != (size_t)-1; } \
+    /* Value slot for key, adding the key if absent (its value is then uninitialized and *inserted = 1). */ \
+    /* NULL on allocation failure. */ \
+    static inline V* NAME##_emplace(NAME* m, K key, int* inserted) { \
+        u64 h = HASH(key); \
+        size_t i = _##NAME##_find(m, key, h); \
+        if (inserted) *inserted = 0; \
+        if (i != (size_t)-1) return &m->slots[i].val; \
+        if (!m->growth_left) { \
+            /* Full of live entries: double. Mostly tombstones: rebuild at the same size. */ \
+            size_t cap = m->cap ? m->cap : MAP_GROUP; \
+            if (m->len >= _map_max_load(cap) / 2) cap *= 2; \
+            if (!_##NAME##_rehash(m, cap)) return NULL; \
+        } \
+        i = _##NAME##_free_slot(m, h); \
+        if (m->ctrl[i] == MAP_EMPTY) m->growth_left--; \
+        _##NAME##_set_ctrl(m, i, (s8)(h & 0x7F)); \
+        m->slots[i].key = key; \
+        m->len++; \
+        if (inserted) *inserted = 1; \
+        return &m->slots[i].val; \
+    } \
+    /* Inserts or overwrites. Returns 0 on allocation failure. */ \
+    static inline int NAME##_put(NAME* m, K key, V val) { \
+        V* v = NAME##_emplace(m, key, NULL); \
+        if (!v) return 0; \
+        *v = val; \
+        return 1; \
+    } \
+    /* Returns 1 if key was present. A slot that no probe can have passed over */ \
+    /* (an EMPTY within 16 slots on both sides) becomes EMPTY again, not DELETED. */ \
+    static inline int NAME##_erase(NAME* m, K key) { \
+        size_t i = _##NAME##_find(m, key, HASH(key)); \
+        if (i == (size_t)-1) return 0; \
+        u32 before = _map_match(m->ctrl + ((i - MAP_GROUP) & (m->cap - 1)), MAP_EMPTY); \
+        u32 after = _map_match(m->ctrl + i, MAP_EMPTY); \
+        if (before && after && (__builtin_clz(before) - 16) + __builtin_ctz(after) < MAP_GROUP) { \
+            _##NAME##_set_ctrl(m, i, MAP_EMPTY); \
+            m->growth_left++; \
+        } else _##NAME##_set_ctrl(m, i, MAP_DELETED); \
+        m->len--; \
+        return 1; \
+    } \
+    /* Iteration: size_t it = 0; NAME##_entry* e; while ((e = NAME##_next(&m, &it))) ... */ \
+    /* Erasing during iteration is fine; inserting may rehash and invalidate it. */ \
+    static inline NAME##_entry* NAME##_next(NAME* m, size_t* it) { \
+        for (size_t i = *it; i < m->cap; i += MAP_GROUP) { \
+            u32 full = ~_map_match_free(m->ctrl + i) & 0xFFFF; \
+            if (m->cap - i < MAP_GROUP) full &= (1u << (m->cap - i)) - 1; \
+            if (full) { \
+                i += (size_t)__builtin_ctz(full); \
+                *it = i + 1; \
+                return &m->slots[i]; \
+            } \
+        } \
+        *it = m->cap; \
+        return NULL; \
+    }
+
+// Integer keys, and NUL-terminated string keys. String keys are stored as
+// pointers, not copied: they must stay valid while they are in the map.
+#define DEF_MAP_U64(NAME, V) DEF_MAP(NAME, u64, V, map_hash_u64, map_eq_u64)
+#define DEF_MAP_STR(NAME, V) DEF_MAP(NAME, const char*, V, map_hash_str, map_eq_str)
+
+// --- Sorting & Search ---
+// DEF_SORT(NAME, T, LESS) defines NAME_sort, a pattern-defeating quicksort
+// (pdqsort) with LESS(a, b) inlined instead of called through a pointer, plus
+// branchless binary searches and a parallel sample sort. DEF_RADIX and
+// DEF_RADIX_STR add radix sorts for integer and string keys.
+
+#ifndef SORT_INSERTION
+#define SORT_INSERTION 24        // Ranges below this are insertion sorted.
+#endif
+#ifndef SORT_NINTHER
+#define SORT_NINTHER 128         // Ranges above this take a median of medians as pivot.
+#endif
+#ifndef SORT_PARALLEL_MIN
+#define SORT_PARALLEL_MIN 65536  // Smaller arrays are not worth spawning threads for.
+#endif
+#define SORT_BLOCK 64            // Elements classified per side before swapping.
+#define SORT_OVERSAMPLE 32       // Samples per bucket when choosing splitters.
+
+#if defined(__GNUC__)
+    #define _SORT_PREFETCH(p) __builtin_prefetch(p)
+#else
+    #define _SORT_PREFETCH(p) ((void)0)
+#endif
+
+#ifdef SBIG_THREADS
+    #define _SORT_THREADED 1
+#else
+    #define _SORT_THREADED 0
+#endif
+
+// Runs fn(ctx, j, j + 1) for each j < jobs (at most 64), one thread per job
+// when built with -DSBIG_THREADS.
+static inline void _sort_jobs(_sbig_range_fn fn, void* ctx, int jobs) {
+#ifdef SBIG_THREADS
+    _sbig_job job[64];
+    int started[64] = {0};
+    #ifdef _WIN32
+    HANDLE th[64];
+    #else
+    pthread_t th[64];
+    #endif
+    for (int i = 1; i < jobs; i++) {
+        job[i].fn = fn; job[i].ctx = ctx; job[i].lo = i; job[i].hi = i + 1;
+    #ifdef _WIN32
+        started[i] = (th[i] = CreateThread(NULL, 0, _sbig_job_entry, &job[i], 0, NULL)) != NULL;
+    #else
+        started[i] = pthread_create(&th[i], NULL, _sbig_job_entry, &job[i]) == 0;
+    #endif
+        if (!started[i]) fn(ctx, i, i + 1);
+    }
+    fn(ctx, 0, 1);
+    for (int i = 1; i < jobs; i++) {
+        if (!started[i]) continue;
+    #ifdef _WIN32
+        WaitForSingleObject(th[i], INFINITE); CloseHandle(th[i]);
+    #else
+        pthread_join(th[i], NULL);
+    #endif
+    }
+#else
+    fn(ctx, 0, jobs);
+#endif
+}
+
+#define DEF_SORT(NAME, T, LESS) \
+    /* Insertion sorts. The unguarded one relies on an element before a that is */ \
+    /* not greater than any in [a, a + n), which pdqsort guarantees off the left edge. */ \
+    static inline void _##NAME##_insertion(T* a, size_t n) { \
+        for (size_t i = 1; i < n; i++) { \
+            if (!LESS(a[i], a[i - 1])) continue; \
+            T tmp = a[i]; \
+            size_t j = i; \
+            do { a[j] = a[j - 1]; j--; } while (j > 0 && LESS(tmp, a[j - 1])); \
+            a[j] = tmp; \
+        } \
+    } \
+    static inline void _##NAME##_insertion_unguarded(T* a, size_t n) { \
+        for (size_t i = 1; i < n; i++) { \
+            if (!LESS(a[i], a[i - 1])) continue; \
+            T tmp = a[i]; \
+            T* p = a + i; \
+            do { *p = p[-1]; p--; } while (LESS(tmp, p[-1])); \
+            *p = tmp; \
+        } \
+    } \
+    /* Gives up (returns 0) after moving more than 8 elements. */ \
+    static inline int _##NAME##_insertion_partial(T* a, size_t n) { \
+        size_t moved = 0; \
+        for (size_t i = 1; i < n; i++) { \
+            if (moved > 8) return 0; \
+            if (!LESS(a[i], a[i - 1])) continue; \
+            T tmp = a[i]; \
+            size_t j = i; \
+            do { a[j] = a[j - 1]; j--; } while (j > 0 && LESS(tmp, a[j - 1])); \
+            a[j] = tmp; \
+            moved += i - j; \
+        } \
+        return 1; \
+    } \
+    static inline void _##NAME##_swap(T* x, T* y) { T t = *x; *x = *y; *y = t; } \
+    static inline void _##NAME##_sort2(T* x, T* y) { if (LESS(*y, *x)) _##NAME##_swap(x, y); } \
+    static inline void _##NAME##_sort3(T* x, T* y, T* z) { \
+        _##NAME##_sort2(x, y); _##NAME##_sort2(y, z); _##NAME##_sort2(x, y); \
+    } \
+    static inline void _##NAME##_sift(T* a, size_t i, size_t n) { \
+        T v = a[i]; \
+        for (size_t c; (c = 2 * i + 1) < n; i = c) { \
+            if (c + 1 < n && LESS(a[c], a[c + 1])) c++; \
+            if (!LESS(v, a[c])) break; \
+            a[i] = a[c]; \
+        } \
+        a[i] = v; \
+    } \
+    static inline void _##NAME##_heapsort(T* a, size_t n) { \
+        for (size_t i = n / 2; i-- > 0;) _##NAME##_sift(a, i, n); \
+        for (size_t i = n; i-- > 1;) { _##NAME##_swap(a, a + i); _##NAME##_sift(a, 0, i); } \
+    } \
+    /* Elements equal to the pivot a[0] go left; returns the pivot's final index. */ \
+    /* Used when the pivot equals the element before the range, so it cannot recur. */ \
+    static inline size_t _##NAME##_partition_left(T* a, size_t n) { \
+        T pivot = a[0]; \
+        T* first = a; T* last = a + n; \
+        while (LESS(pivot, *--last)); \
+        if (last + 1 == a + n) while (first < last && !LESS(pivot, *++first)); \
+        else while (!LESS(pivot, *++first)); \
+        while (first < last) { \
+            _##NAME##_swap(first, last); \
+            while (LESS(pivot, *--last)); \
+            while (!LESS(pivot, *++first)); \
+        } \
+        a[0] = *last; \
+        *last = pivot; \
+        return (size_t)(last - a); \
+    } \
+    /* Elements less than the pivot a[0] go left. Out-of-place elements are found */ \
+    /* a block at a time into offset buffers with no data-dependent branch, then */ \
+    /* swapped in pairs. Sets *sorted when no element had to move. */ \
+    static inline size_t _##NAME##_partition_right(T* a, size_t n, int* sorted) { \
+        T pivot = a[0]; \
+        T* first = a; T* last = a + n; \
+        while (LESS(*++first, pivot)); \
+        if (first - 1 == a) while (first < last && !LESS(*--last, pivot)); \
+        else while (!LESS(*--last, pivot)); \
+        *sorted = first >= last; \
+        if (!*sorted) { \
+            unsigned char off_l[SORT_BLOCK], off_r[SORT_BLOCK]; \
+            T* base_l; T* base_r; \
+            size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0; \
+            _##NAME##_swap(first, last); \
+            first++; \
+            base_l = first; base_r = last; \
+            while (first < last) { \
+                size_t unknown = (size_t)(last - first); \
+                size_t split_l = num_l == 0 ? (num_r == 0 ? unknown / 2 : unknown) : 0; \
+                size_t split_r = num_r == 0 ? unknown - split_l : 0; \
+                if (split_l > SORT_BLOCK) split_l = SORT_BLOCK; \
+                if (split_r > SORT_BLOCK) split_r = SORT_BLOCK; \
+                for (size_t i = 0; i < split_l; i++) { \
+                    off_l[num_l] = (unsigned char)i; \
+                    num_l += !LESS(*first, pivot); \
+                    first++; \
+                } \
+                for (size_t i = 0; i < split_r;) { \
+                    off_r[num_r] = (unsigned char)++i; \
+                    num_r += LESS(*--last, pivot); \
+                } \
+                size_t num = num_l < num_r ? num_l : num_r; \
+                if (num) { \
+                    /* A cycle through both sides moves each element once instead of swapping. */ \
+                    T* l = base_l + off_l[start_l]; \
+                    T* r = base_r - off_r[start_r]; \
+                    T tmp = *l; \
+                    *l = *r; \
+                    for (size_t i = 1; i < num; i++) { \
+                        l = base_l + off_l[start_l + i]; *r = *l; \
+                        r = base_r - off_r[start_r + i]; *l = *r; \
+                    } \
+                    *r = tmp; \
+                } \
+                num_l -= num; num_r -= num; \
+                start_l += num; start_r += num; \
+                if (num_l == 0) { start_l = 0; base_l = first; } \
+                if (num_r == 0) { start_r = 0; base_r = last; } \
+            } \
+            if (num_l) { \
+                while (num_l--) _##NAME##_swap(base_l + off_l[start_l + num_l], --last); \
+                first = last; \
+            } \
+            if (num_r) { \
+                while (num_r--) { _##NAME##_swap(base_r - off_r[start_r + num_r], first); first++; } \
+            } \
+        } \
+        T* pos = first - 1; \
+        a[0] = *pos; \
+        *pos = pivot; \
+        return (size_t)(pos - a); \
+    } \
+    static inline void _##NAME##_pdq(T* a, size_t n, int bad_allowed, int leftmost) { \
+        for (;;) { \
+            if (n < SORT_INSERTION) { \
+                if (leftmost) _##NAME##_insertion(a, n); \
+                else _##NAME##_insertion_unguarded(a, n); \
+                return; \
+            } \
+            size_t h = n / 2; \
+            if (n > SORT_NINTHER) { \
+                _##NAME##_sort3(a, a + h, a + n - 1); \
+                _##NAME##_sort3(a + 1, a + h - 1, a + n - 2); \
+                _##NAME##_sort3(a + 2, a + h + 1, a + n - 3); \
+                _##NAME##_sort3(a + h - 1, a + h, a + h + 1); \
+                _##NAME##_swap(a, a + h); \
+            } else _##NAME##_sort3(a + h, a, a + n - 1); \
+            /* Pivot equal to the element before the range: everything equal to it */ \
+            /* is in place, so skip past the run instead of recursing on it. */ \
+            if (!leftmost && !LESS(a[-1], a[0])) { \
+                size_t p = _##NAME##_partition_left(a, n) + 1; \
+                a += p; n -= p; \
+                continue; \
+            } \
+            int sorted; \
+            size_t p = _##NAME##_partition_right(a, n, &sorted); \
+            size_t ln = p, rn = n - p - 1; \
+            if (ln < n / 8 || rn < n / 8) { \
+                /* Bad split: fall back to heapsort after log2(n) of them, */ \
+                /* otherwise break up the pattern that caused it. */ \
+                if (--bad_allowed == 0) { _##NAME##_heapsort(a, n); return; } \
+                T* piv = a + p; \
+                if (ln >= SORT_INSERTION) { \
+                    _##NAME##_swap(a, a + ln / 4); \
+                    _##NAME##_swap(piv - 1, piv - ln / 4); \
+                    if (ln > SORT_NINTHER) { \
+                        _##NAME##_swap(a + 1, a + ln / 4 + 1); \
+                        _##NAME##_swap(a + 2, a + ln / 4 + 2); \
+                        _##NAME##_swap(piv - 2, piv - (ln / 4 + 1)); \
+                        _##NAME##_swap(piv - 3, piv - (ln / 4 + 2)); \
+                    } \
+                } \
+                if (rn >= SORT_INSERTION) { \
+                    _##NAME##_swap(piv + 1, piv + 1 + rn / 4); \
+                    _##NAME##_swap(a + n - 1, a + n - rn / 4); \
+                    if (rn > SORT_NINTHER) { \
+                        _##NAME##_swap(piv + 2, piv + 2 + rn / 4); \
+                        _##NAME##_swap(piv + 3, piv + 3 + rn / 4); \
+                        _##NAME##_swap(a + n - 2, a + n - (1 + rn / 4)); \
+                        _##NAME##_swap(a + n - 3, a + n - (2 + rn / 4)); \
+                    } \
+                } \
+            } else if (sorted && _##NAME##_insertion_partial(a, ln) && \
+                       _##NAME##_insertion_partial(a + p + 1, rn)) return; \
+            _##NAME##_pdq(a, ln, bad_allowed, leftmost); \
+            a += p + 1; n = rn; \
+            leftmost = 0; \
+        } \
+    } \
+    /* Unstable, O(n log n) worst case, linear on sorted or reversed input. */ \
+    static inline void NAME##_sort(T* a, size_t n) { \
+        int bad = 1; \
+        for (size_t m = n; m > 1; m >>= 1) bad++; \
+        _##NAME##_pdq(a, n, bad, 1); \
+    } \
+    /* First index whose element is not less than key (n if none). a must be sorted. */ \
+    /* The loop has no data-dependent branch; both possible next probes are prefetched. */ \
+    static inline size_t NAME##_lower_bound(T const* a, size_t n, T key) { \
+        if (n == 0) return 0; \
+        T const* base = a; \
+        while (n > 1) { \
+            size_t half = n / 2; \
+            _SORT_PREFETCH(base + half / 2); \
+            _SORT_PREFETCH(base + half + half / 2); \
+            base = LESS(base[half], key) ? base + half : base; \
+            n -= half; \
+        } \
+        return (size_t)(base - a) + (size_t)LESS(*base, key); \
+    } \
+    /* First index whose element is greater than key (n if none). */ \
+    static inline size_t NAME##_upper_bound(T const* a, size_t n, T key) { \
+        if (n == 0) return 0; \
+        T const* base = a; \
+        while (n > 1) { \
+            size_t half = n / 2; \
+            _SORT_PREFETCH(base + half / 2); \
+            _SORT_PREFETCH(base + half + half / 2); \
+            base = LESS(key, base[half]) ? base : base + half; \
+            n -= half; \
+        } \
+        return (size_t)(base - a) + (size_t)!LESS(key, *base); \
+    } \
+    /* Parallel sample sort: splitters from an oversampled, sorted sample cut the */ \
+    /* array into one bucket per thread; threads count, scatter, then sort their bucket. */ \
+    typedef struct { \
+        T* a; T* tmp; \
+        size_t n; \
+        int p; \
+        T* split; \
+        unsigned char* bucket; \
+        size_t* pos;   /* [job * p + bucket]: counts, then scatter positions. */ \
+        size_t* start; /* p + 1 bucket boundaries. */ \
+    } _##NAME##_ss; \
+    static inline void _##NAME##_ss_count(void* ctx, int job, int job_end) { \
+        _##NAME##_ss* s = (_##NAME##_ss*)ctx; \
+        for (; job < job_end; job++) { \
+            size_t lo = s->n * (size_t)job / (size_t)s->p, hi = s->n * (size_t)(job + 1) / (size_t)s->p; \
+            size_t* cnt = s->pos + (size_t)job * (size_t)s->p; \
+            for (size_t i = lo; i < hi; i++) { \
+                size_t b = NAME##_upper_bound(s->split, (size_t)s->p - 1, s->a[i]); \
+                s->bucket[i] = (unsigned char)b; \
+                cnt[b]++; \
+            } \
+        } \
+    } \
+    static inline void _##NAME##_ss_scatter(void* ctx, int job, int job_end) { \
+        _##NAME##_ss* s = (_##NAME##_ss*)ctx; \
+        for (; job < job_end; job++) { \
+            size_t lo = s->n * (size_t)job / (size_t)s->p, hi = s->n * (size_t)(job + 1) / (size_t)s->p; \
+            size_t* pos = s->pos + (size_t)job * (size_t)s->p; \
+            for (size_t i = lo; i < hi; i++) s->tmp[pos[s->bucket[i]]++] = s->a[i]; \
+        } \
+    } \
+    static inline void _##NAME##_ss_sort(void* ctx, int job, int job_end) { \
+        _##NAME##_ss* s = (_##NAME##_ss*)ctx; \
+        for (; job < job_end; job++) { \
+            size_t lo = s->start[job], len = s->start[job + 1] - lo; \
+            NAME##_sort(s->tmp + lo, len); \
+            memcpy(s->a + lo, s->tmp + lo, len * sizeof(T)); \
+        } \
+    } \
+    /* Sorts on up to threads threads (at most 64) with -DSBIG_THREADS; otherwise, */ \
+    /* for small arrays, or if scratch memory cannot be had, same as NAME##_sort. */ \
+    static inline void NAME##_sort_parallel(T* a, size_t n, int threads) { \
+        _##NAME##_ss s; \
+        int p = threads > 64 ? 64 : threads; \
+        if (!_SORT_THREADED || p < 2 || n < SORT_PARALLEL_MIN) { NAME##_sort(a, n); return; } \
+        size_t per = SORT_OVERSAMPLE, k = per * (size_t)p; \
+        s.a = a; s.n = n; s.p = p; \
+        s.tmp = (T*)QOL_MALLOC(n * sizeof(T)); \
+        s.split = (T*)QOL_MALLOC(k * sizeof(T)); \
+        s.bucket = (unsigned char*)QOL_MALLOC(n); \
+        s.pos = (size_t*)QOL_CALLOC((size_t)p * (size_t)p, sizeof(size_t)); \
+        s.start = (size_t*)QOL_MALLOC(((size_t)p + 1) * sizeof(size_t)); \
+        if (!s.tmp || !s.split || !s.bucket || !s.pos || !s.start) { \
+            QOL_FREE(s.tmp); QOL_FREE(s.split); QOL_FREE(s.bucket); QOL_FREE(s.pos); QOL_FREE(s.start); \
+            NAME##_sort(a, n); \
+            return; \
+        } \
+        for (size_t i = 0; i < k; i++) s.split[i] = a[(i * 2 + 1) * (n / (2 * k))]; \
+        NAME##_sort(s.split, k); \
+        for (int i = 1; i < p; i++) s.split[i - 1] = s.split[(size_t)i * per]; \
+        _sort_jobs(_##NAME##_ss_count, &s, p); \
+        size_t at = 0; \
+        for (int b = 0; b < p; b++) { \
+            s.start[b] = at; \
+            for (int j = 0; j < p; j++) { \
+                size_t c = s.pos[(size_t)j * (size_t)p + (size_t)b]; \
+                s.pos[(size_t)j * (size_t)p + (size_t)b] = at; \
+                at += c; \
+            } \
+        } \
+        s.start[p] = at; \
+        _sort_jobs(_##NAME##_ss_scatter, &s, p); \
+        _sort_jobs(_##NAME##_ss_sort, &s, p); \
+        QOL_FREE(s.tmp); QOL_FREE(s.split); QOL_FREE(s.bucket); QOL_FREE(s.pos); QOL_FREE(s.start); \
+    }
+
+#define DEF_RADIX(NAME, T, KEY) \
+    /* Stable LSD radix sort on the unsigned integer KEY(x), one byte per pass. */ \
+    /* Byte histograms come from a single read, and passes where every key has */ \
+    /* the same byte are skipped. Returns 0 if the scratch buffer cannot be had. */ \
+    static inline int NAME##_radix_sort(T* a, size_t n) { \
+        enum { _BYTES = sizeof(KEY(a[0])) }; \
+        if (n < SORT_INSERTION) { \
+            for (size_t i = 1; i < n; i++) { \
+                T tmp = a[i]; \
+                size_t j = i; \
+                while (j > 0 && KEY(tmp) < KEY(a[j - 1])) { a[j] = a[j - 1]; j--; } \
+                a[j] = tmp; \
+            } \
+            return 1; \
+        } \
+        size_t cnt[_BYTES][256]; \
+        memset(cnt, 0, sizeof(cnt)); \
+        for (size_t i = 0; i < n; i++) { \
+            u64 k = (u64)KEY(a[i]); \
+            for (int b = 0; b < _BYTES; b++) cnt[b][(k >> (8 * b)) & 255]++; \
+        } \
+        T* tmp = (T*)QOL_MALLOC(n * sizeof(T)); \
+        if (!tmp) return 0; \
+        T* src = a; T* dst = tmp; \
+        for (int b = 0; b < _BYTES; b++) { \
+            size_t* c = cnt[b]; \
+            if (c[((u64)KEY(src[0]) >> (8 * b)) & 255] == n) continue; \
+            size_t at = 0; \
+            for (int d = 0; d < 256; d++) { size_t t = c[d]; c[d] = at; at += t; } \
+            for (size_t i = 0; i < n; i++) dst[c[((u64)KEY(src[i]) >> (8 * b)) & 255]++] = src[i]; \
+            T* t = src; src = dst; dst = t; \
+        } \
+        if (src != a) memcpy(a, src, n * sizeof(T)); \
+        QOL_FREE(tmp); \
+        return 1; \
+    }
+
+#define DEF_RADIX_STR(NAME, T, STR) \
+    /* MSD radix sort on the NUL-terminated string STR(x), byte order as strcmp. */ \
+    /* Each level buckets by the byte at depth d; a level where all strings share */ \
+    /* the byte just moves on, so long common prefixes do not recurse. */ \
+    static inline void _##NAME##_msd(T* a, T* tmp, unsigned char* bytes, size_t n, size_t d) { \
+        while (n >= SORT_INSERTION) { \
+            size_t cnt[256] = {0}, end[256], at = 0; \
+            int big = 0; \
+            for (size_t i = 0; i < n; i++) cnt[bytes[i] = (unsigned char)STR(a[i])[d]]++; \
+            if (cnt[bytes[0]] == n) { \
+                if (bytes[0] == 0) return; \
+                d++; \
+                continue; \
+            } \
+            for (int c = 0; c < 256; c++) { \
+                end[c] = at; at += cnt[c]; \
+                if (cnt[c] > cnt[big]) big = c; \
+            } \
+            for (size_t i = 0; i < n; i++) tmp[end[bytes[i]]++] = a[i]; \
+            memcpy(a, tmp, n * sizeof(T)); \
+            /* Bucket 0 holds the finished strings. Recursing on all but the biggest */ \
+            /* bucket and looping on that one keeps the depth under log2(n). */ \
+            for (int c = 1; c < 256; c++) \
+                if (c != big && cnt[c] > 1) _##NAME##_msd(a + end[c] - cnt[c], tmp, bytes, cnt[c], d + 1); \
+            if (big == 0) return; \
+            a += end[big] - cnt[big]; \
+            n = cnt[big]; \
+            d++; \
+        } \
+        for (size_t i = 1; i < n; i++) { \
+            T v = a[i]; \
+            size_t j = i; \
+            while (j > 0 && strcmp(STR(v) + d, STR(a[j - 1]) + d) < 0) { a[j] = a[j - 1]; j--; } \
+            a[j] = v; \
+        } \
+    } \
+    /* Stable. Returns 0 if the scratch buffers cannot be had. */ \
+    static inline int NAME##_radix_sort(T* a, size_t n) { \
+        if (n < 2) return 1; \
+        T* tmp = (T*)QOL_MALLOC(n * sizeof(T)); \
+        unsigned char* bytes = (unsigned char*)QOL_MALLOC(n); \
+        if (!tmp || !bytes) { QOL_FREE(tmp); QOL_FREE(bytes); return 0; } \
+        _##NAME##_msd(a, tmp, bytes, n, 0); \
+        QOL_FREE(tmp); QOL_FREE(bytes); \
+        return 1; \
+    }
+
+// Ready-made comparisons for numbers and NUL-terminated strings.
+#define SORT_LESS_NUM(a, b) ((a) < (b))
+#define SORT_LESS_STR(a, b) (strcmp((a), (b)) < 0)
+#define SORT_KEY_SELF(x) (x)
+#define SORT_STR_SELF(x) (x)
+#define DEF_SORT_NUM(NAME, T) DEF_SORT(NAME, T, SORT_LESS_NUM)
+#define DEF_SORT_STR(NAME) DEF_SORT(NAME, const char*, SORT_LESS_STR)
+
 #endif
@@ -1,5 +1,17 @@
 #include "simple_types.h"
 
+DEF_MAP_STR(word_map, int)
+DEF_MAP_U64(id_map, double)
+
+typedef struct { const char* name; u32 size; } file_entry;
+#define FILE_BY_SIZE(a, b) ((a).size < (b).size)
+#define FILE_NAME(f) ((f).name)
+#define FILE_SIZE(f) ((f).size)
+DEF_SORT(files, file_entry, FILE_BY_SIZE)
+DEF_RADIX(files_by_size, file_entry, FILE_SIZE)
+DEF_RADIX_STR(files_by_name, file_entry, FILE_NAME)
+DEF_SORT_NUM(nums, u32)
+
 int main() {
     printf("================================\n");
     printf("   TESTS 32-BIT TO 12288-BIT    \n");
@@ -39,11 +51,234 @@ int main() {
     suint12288 u12288_v = {0}; u12288_v.limbs[0] = 12288;
     slibprint(u12288_v); printf(" | "); slibnfprint(u12288_v); printf("\n\n");
 
+    printf("--- DECIMAL PARSE CHECK ---\n");
+    suint256 parsed; char dec[100];
+    suint256_from_dec(&parsed, "115,792,089,237,316,195,423,570,985,008,687,907,853,269,984,665,640,564,039,457,584,007,913,129,639,935");
+    suint256_to_dec(parsed, dec, sizeof(dec));
+    printf("2^256 - 1 round trip: %s\n", dec);
+    printf("2^256 fits suint256: %d\n\n", suint256_from_dec(&parsed, "115792089237316195423570985008687907853269984665640564039457584007913129639936"));
+
     printf("--- FLOAT POINT CHECK ---\n");
     sfloat256 f_v = {0}; 
     f_v.mantissa.limbs[0] = 123456789; 
     f_v.exponent = -50;
-    slibprint(f_v); printf(" | "); slibnfprint(f_v); printf("\n\n");
+    slibprint(f_v); printf(" | "); slibnfprint(f_v); printf("\n");
+    sfloat256_normalize(&f_v);
+    printf("normalized back to double: %.17g\n", sfloat256_to_double(f_v));
+    sfloat256 third, f_three = sfloat256_from_double(3.0), sum = {0};
+    sfloat256_div(&third, sfloat256_from_double(1.0), f_three);
+    for (int i = 0; i < 3; i++) sfloat256_add(&sum, sum, third);
+    printf("1/3 + 1/3 + 1/3 = %.17g (cmp 1.0: %d)\n", sfloat256_to_double(sum), sfloat256_cmp(sum, sfloat256_from_double(1.0)));
+    sfloat256 root;
+    sfloat256_sqrt(&root, sfloat256_from_double(2.0));
+    printf("sqrt(2) = %.17g\n", sfloat256_to_double(root));
+    sfloat128 tiny = sfloat128_from_double(1e-30), one = sfloat128_from_double(1.0), d128;
+    sfloat128_add(&d128, one, tiny); sfloat128_sub(&d128, d128, one);
+    printf("(1 + 1e-30) - 1 in sfloat128 = %.17g\n", sfloat128_to_double(d128));
+    sfloat128 edge = one; edge.exponent = INT32_MAX - 200;
+    sfloat128_mul(&d128, edge, edge);
+    printf("huge * huge saturates: exponent %d, to_double %g\n", d128.exponent, sfloat128_to_double(d128));
+    edge.exponent = INT32_MIN + 200;
+    sfloat128_mul(&d128, edge, edge);
+    printf("tiny * tiny flushes to zero: %d\n\n", sfloat128_cmp(d128, sfloat128_from_double(0.0)) == 0);
+
+    printf("--- SBIG (DYNAMIC) CHECK ---\n");
+    // 2^12000 * 2^12000 no longer fits any fixed width.
+    sbig_arena arena; sbig_arena_init(&arena, 0);
+    sbig huge, q, r; sbig_init(&huge, &arena.al); sbig_init(&q, &arena.al); sbig_init(&r, &arena.al);
+    sbig_from_suint12288(&huge, big_val);
+    sbig_mul(&huge, &huge, &huge);
+    printf("2^24000 limbs: %d\n", huge.len);
+    sbig wide; sbig_init(&wide, &arena.al);
+    suint12288_mul_full(&wide, big_val, big_val);
+    printf("suint12288_mul_full matches: %d\n", sbig_cmp(&wide, &huge) == 0);
+    sbig_divmod(&q, &r, &huge, &huge);
+    printf("2^24000 / 2^24000 = "); slibprint(q); printf(" rem "); slibprint(r); printf("\n");
+
+    sbig three; sbig_init(&three, &arena.al); sbig_set_u64(&three, 3);
+    sbig_pow(&huge, &three, 100);
+    printf("3^100 = "); slibprint(huge); printf("\n");
+    suint128 small;
+    printf("3^100 fits suint128: %d\n", sbig_to_suint128(&small, &huge));
+    printf("3^100 fits suint256: %d\n\n", sbig_to_suint256(&u256_v, &huge));
+    sbig_arena_free(&arena);
+
+    printf("--- BATCH (SOA) CHECK ---\n");
+    // 37 lanes: whole AVX2 (8) and AVX-512 (16) groups plus a scalar tail, checked
+    // lane by lane against the scalar ops at every dispatch level the CPU has.
+    enum { NB = 37 };
+    suint256_soa ba, bb, bo; int order[NB];
+    suint256_soa_alloc(&ba, NB); suint256_soa_alloc(&bb, NB); suint256_soa_alloc(&bo, NB);
+    u32 seed = 12345;
+    for (int i = 0; i < NB; i++) {
+        suint256 x, y;
+        for (int k = 0; k < 8; k++) {
+            seed = seed * 1664525u + 1013904223u; x.limbs[k] = seed;
+            seed = seed * 1664525u + 1013904223u; y.limbs[k] = i % 5 == 0 ? x.limbs[k] : seed;
+        }
+        if (i % 3 == 0) for (int k = 0; k < 7; k++) x.limbs[k] = 0xFFFFFFFF;   // Long carry chains
+        if (i % 5 == 0 && i % 3 != 0) y = x;                                    // Equal pairs
+        suint256_soa_set(&ba, i, x); suint256_soa_set(&bb, i, y);
+    }
+    int top = types_simd_level();
+    for (int lvl = 0; lvl <= top; lvl++) {
+        int add_ok = 1, cmp_ok = 1, mul_ok = 1;
+        types_simd_limit(lvl);
+        suint256_add_many(&bo, &ba, &bb, NB);
+        for (int i = 0; i < NB; i++) {
+            suint256 want; suint256_add(&want, suint256_soa_get(&ba, i), suint256_soa_get(&bb, i));
+            add_ok &= suint256_cmp(want, suint256_soa_get(&bo, i)) == 0;
+        }
+        suint256_mul_many(&bo, &ba, &bb, NB);
+        for (int i = 0; i < NB; i++) {
+            suint256 want; suint256_mul(&want, suint256_soa_get(&ba, i), suint256_soa_get(&bb, i));
+            mul_ok &= suint256_cmp(want, suint256_soa_get(&bo, i)) == 0;
+        }
+        suint256_cmp_many(order, &ba, &bb, NB);
+        for (int i = 0; i < NB; i++) cmp_ok &= order[i] == suint256_cmp(suint256_soa_get(&ba, i), suint256_soa_get(&bb, i));
+        printf("SIMD level %d: add_many %s, mul_many %s, cmp_many %s\n", lvl,
+            add_ok ? "ok" : "FAILED", mul_ok ? "ok" : "FAILED", cmp_ok ? "ok" : "FAILED");
+    }
+    printf("a[5] * b[5] = "); slibnfprint(suint256_soa_get(&bo, 5)); printf("\n");
+    printf("cmp(a[i], b[i]) for i < 6 = %d %d %d %d %d %d\n\n", order[0], order[1], order[2], order[3], order[4], order[5]);
+    suint256_soa_free(&ba); suint256_soa_free(&bb); suint256_soa_free(&bo);
+
+    printf("--- GCD CHECK ---\n");
+    suint2048 ga = {0}, gb = {0}, gg, ginv, gprod;
+    ga.limbs[0] = 2 * 3 * 5 * 7 * 11; ga.limbs[40] = 210;   // gcd is 42
+    gb.limbs[0] = 6 * 13;             gb.limbs[63] = 6;
+    suint2048_gcd_binary(&gg, ga, gb); printf("gcd_binary = "); slibprint(gg); printf("\n");
+    suint2048_gcd(&gg, ga, gb);        printf("gcd (lehmer) = "); slibprint(gg); printf("\n");
+    printf("modinv with common factor: %d\n", suint2048_modinv(&ginv, ga, gb));
+    suint2048 p = {0}; p.limbs[0] = 1000000007;
+    suint2048 x = {0}; x.limbs[0] = 123456789;
+    suint2048_modinv(&ginv, x, p);
+    suint2048_mul(&gprod, x, ginv); suint2048_mod(&gprod, gprod, p);
+    printf("123456789^-1 mod 1e9+7 = "); slibprint(ginv); printf(" (check: "); slibprint(gprod); printf(")\n\n");
+
+    printf("--- HASH MAP CHECK ---\n");
+    const char* words[] = { "get", "put", "get", "head", "get", "put", "delete" };
+    word_map wm;
+    word_map_init(&wm);
+    for (int i = 0; i < 7; i++) {
+        int fresh;
+        int* n = word_map_emplace(&wm, words[i], &fresh);
+        *n = fresh ? 1 : *n + 1;
+    }
+    printf("get x%d, put x%d, patch %s\n", *word_map_get(&wm, "get"), *word_map_get(&wm, "put"), word_map_has(&wm, "patch") ? "found" : "missing");
+    word_map_erase(&wm, "head");
+    size_t it = 0;
+    word_map_entry* e;
+    printf("entries (%zu):", wm.len);
+    while ((e = word_map_next(&wm, &it))) printf(" %s=%d", e->key, e->val);
+    printf("\n");
+    word_map_free(&wm);
+    id_map im;
+    id_map_init(&im);
+    id_map_reserve(&im, 1000);
+    for (u64 i = 0; i < 1000; i++) id_map_put(&im, i * 4096, (double)i / 2);
+    printf("1000 ids: len %zu, cap %zu, [409600] = %.1f\n\n", im.len, im.cap, *id_map_get(&im, 409600));
+    id_map_free(&im);
+
+    printf("--- ALLOCATOR CHECK ---\n");
+    qol_arena req;
+    arena_init(&req, 1024);
+    char* first = (char*)arena_alloc(&req, 10);
+    char* second = (char*)arena_alloc(&req, 10);
+    printf("arena: 16-byte steps %s, used %zu\n", second - first == 16 ? "yes" : "no", arena_used(&req));
+    for (int i = 0; i < 200; i++) arena_alloc(&req, 100);   // Spills into more blocks
+    arena_reset(&req);
+    size_t used = arena_used(&req);
+    printf("after reset: used %zu, first block reused %s\n", used, (char*)arena_alloc(&req, 10) == first ? "yes" : "no");
+    const qol_alloc* prev = qol_alloc_use(&req.al);
+    char* grown = (char*)qol_malloc(8);
+    strcpy(grown, "arena");
+    char* same = (char*)qol_realloc(grown, 200);   // Last allocation: grows in place
+    qol_alloc_use(prev);
+    char* heap = (char*)qol_malloc(16);            // Heap again
+    printf("qol_realloc in place %s, kept \"%s\"\n", same == grown ? "yes" : "no", same);
+    qol_free(same);
+    qol_free(heap);
+    arena_free(&req);
+    qol_pool pool;
+    pool_init(&pool, 40, 4);
+    void* a1 = pool_get(&pool);
+    void* a2 = pool_get(&pool);
+    pool_put(&pool, a1);
+    printf("pool: object size %zu, freed slot reused %s, neighbours %td apart\n",
+        pool.size, pool_get(&pool) == a1 ? "yes" : "no", (char*)a2 - (char*)a1);
+    sbig pb;
+    sbig_init(&pb, &pool.al);   // Limbs bigger than an object fall through to the heap
+    sbig_set_u64(&pb, 1000000007ULL);
+    sbig_pow(&pb, &pb, 20);
+    char* pd = sbig_to_dec(&pb);
+    printf("sbig on a pool: %.20s... (%zu digits)\n\n", pd, strlen(pd));
+    QOL_FREE(pd);
+    sbig_free(&pb);
+    pool_free(&pool);
+
+    printf("--- SORT CHECK ---\n");
+    file_entry listing[] = { {"notes.txt", 700}, {"a.out", 16384}, {"Makefile", 900}, {"main.c", 4200},
+                             {"README", 900}, {"lib.so", 65536}, {"main.h", 300} };
+    size_t nf = sizeof(listing) / sizeof(listing[0]);
+    files_sort(listing, nf);
+    printf("by size (pdqsort):");
+    for (size_t i = 0; i < nf; i++) printf(" %s=%u", listing[i].name, listing[i].size);
+    files_by_name_radix_sort(listing, nf);
+    printf("\nby name (radix):");
+    for (size_t i = 0; i < nf; i++) printf(" %s", listing[i].name);
+    files_by_size_radix_sort(listing, nf);   // Stable: equal sizes keep name order
+    printf("\nby size (radix, stable):");
+    for (size_t i = 0; i < nf; i++) printf(" %s=%u", listing[i].name, listing[i].size);
+    printf("\n");
+
+    // Large enough to leave the insertion-sort fallback: pdqsort partitions, LSD
+    // passes and the MSD bucket scatter. Names share long prefixes; sizes repeat.
+    enum { NR = 600 };
+    static char names[NR][32];
+    file_entry recs[NR];
+    u32 size_sum = 0, check_sum = 0;
+    for (int i = 0; i < NR; i++) {
+        snprintf(names[i], sizeof(names[i]), "src/mod%d/file%d.c", (i * 37) % 23, (i * 7919) % 1000);
+        recs[i].name = names[i];
+        recs[i].size = (u32)((i * 7919) % 97) * 512;
+        size_sum += recs[i].size;
+    }
+    int sorted_ok = 1, names_ok = 1, stable_ok = 1;
+    files_sort(recs, NR);
+    for (int i = 0; i < NR; i++) check_sum += recs[i].size;
+    for (int i = 1; i < NR; i++) sorted_ok &= recs[i - 1].size <= recs[i].size;
+    files_by_name_radix_sort(recs, NR);
+    for (int i = 1; i < NR; i++) names_ok &= strcmp(recs[i - 1].name, recs[i].name) <= 0;
+    files_by_size_radix_sort(recs, NR);
+    for (int i = 1; i < NR; i++) {
+        sorted_ok &= recs[i - 1].size <= recs[i].size;
+        if (recs[i - 1].size == recs[i].size) stable_ok &= strcmp(recs[i - 1].name, recs[i].name) <= 0;
+    }
+    printf("%d records: pdqsort %s, radix by name %s, radix by size %s and stable %s\n", NR,
+        sorted_ok && check_sum == size_sum ? "ok" : "FAILED", names_ok ? "ok" : "FAILED",
+        sorted_ok ? "ok" : "FAILED", stable_ok ? "ok" : "FAILED");
+
+    // The sample sort runs threads only when built with -DSBIG_THREADS (and -lpthread);
+    // otherwise nums_sort_parallel is nums_sort.
+    size_t nn = 100000;
+    u32* nv = (u32*)malloc(nn * sizeof(u32));
+    u32* ref = (u32*)malloc(nn * sizeof(u32));
+    for (size_t i = 0; i < nn; i++) nv[i] = ref[i] = (u32)((i * 2654435761u) % 50000) * 2;   // Even values, each twice
+    nums_sort_parallel(nv, nn, 4);
+    nums_sort(ref, nn);
+    size_t below = 0;
+    for (size_t i = 0; i < nn; i++) below += nv[i] < 777;
+#ifdef SBIG_THREADS
+    const char* mode = "threaded";
+#else
+    const char* mode = "sequential";
+#endif
+    printf("%zu values sorted (%s): %s; 777 at [%zu, %zu) expected %zu, 778 at [%zu, %zu)\n\n", nn, mode, memcmp(nv, ref, nn * sizeof(u32)) == 0 ? "yes" : "no",
+        nums_lower_bound(nv, nn, 777), nums_upper_bound(nv, nn, 777), below,
+        nums_lower_bound(nv, nn, 778), nums_upper_bound(nv, nn, 778));
+    free(nv);
+    free(ref);
 
     return 0;
 }